@@ -40,6 +40,7 @@
 //#define INIT_DEFAULT          // used to write hotel controller default value to eeprom
 //#define USE_CONSTANT_IP       // use constant define ip addresse when first time initialize hotel controller dragon hardware
 //#define USE_WATCHDOG          // enable watchdog timer
+//#define USE_TRACE             // enable DWT trace of interrupts and scheduler tasks (trace.h)
 //#define OW_DS18B20            // enable Dallas DS18B20 onewire temperature sensor 
 //#define GARAGE_ACCESS         // configure room controller as garage access controller
 
@@ -396,6 +397,8 @@ typedef enum
 #define RT_LOGO_SIZE                            0x00080000 // logo image max. size 144,000‬ bytes    (360px x 100px x 32bpp)
 #define RT_DSPIMG_SIZE                          0x00080000 // display image max. size 524,288‬ bytes (480px x 272px x 16bpp)
 #define RT_BLDR_BKP_ADDR                        0x90E00000 // room thermostat bootloader backup start address
+#define RT_EVLOG_ADDR                           0x90E10000 // room thermostat event log (eventlog.c), free space after bootloader backup
+#define RT_EVLOG_SIZE                           0x00010000 // event log size 64kB, 16 subsectors of 4kB, ends at application backup
 #define RT_APPL_BKP_ADDR                        0x90E20000 // room thermostat application backup start address
 #define RT_NEW_FILE_ADDR                        0x90F00000 // room thermostat new file storage start address
 #define RT_DEF_BLDR_ADDR                        RT_BLDR_BKP_ADDR    // copy of first programmed bootloader for last recovery option
@@ -1117,10 +1120,10 @@ typedef enum
 /** ============================================================================*/
 /** S I S T E M S K I       K A P A C I T E T I                         */
 /** ============================================================================*/
-#define LIGHTS_MODBUS_SIZE                  6       /**< Maksimalan broj svjetala koje sistem može konfigurisati. */
-#define CURTAINS_SIZE                       16      /**< Maksimalan broj roletni koje sistem podržava. */
-#define GATE_MAX_COUNT                      6       /**< Maksimalan broj kapija/garažnih vrata koje sistem podržava. */
-#define SCENE_MAX_COUNT                     6       /**< Maksimalan broj scena koje sistem podržava. */
+#define LIGHTS_MODBUS_SIZE                  32      /**< Maksimalan broj svjetala koje sistem može konfigurisati (bit u `Scene_t::lights_mask`). */
+#define CURTAINS_SIZE                       32      /**< Maksimalan broj roletni koje sistem podržava (bit u `Scene_t::curtains_mask`). */
+#define GATE_MAX_COUNT                      16      /**< Maksimalan broj kapija/garažnih vrata koje sistem podržava. */
+#define SCENE_MAX_COUNT                     9       /**< Maksimalan broj scena; svaka ima svoj izgled iz `scene_appearance_table`. */
 #define SCENE_MAX_TRIGGERS                  8       /**< Maksimalan broj automatskih okidača za "Povratak" scenu. */
 
 /* Exported type  ----------------------------------------------------- */
@@ -53,6 +53,20 @@
 
 #define TS_I2C_ADDRESS                          ((uint16_t)0x70)
 
+/* Touch screen FT5336 interrupt line (INT, active low, EXTI falling edge).
+   PG13 is assumed (a spare input in MX_GPIO_Init) and has not been checked
+   against the board schematic, so the INT path is disabled by default and
+   TS_Service polls every TS_UPDATE_TIME. Set TS_USE_INT_PIN to 1 only after
+   the FT5336 INT routing is confirmed on the schematic. */
+#ifndef TS_USE_INT_PIN
+ #define TS_USE_INT_PIN                         0
+#endif /* TS_USE_INT_PIN */
+#define TS_INT_PIN                              ((uint32_t)GPIO_PIN_13)
+#define TS_INT_GPIO_PORT                        ((GPIO_TypeDef*)GPIOG)
+#define TS_INT_GPIO_CLK_ENABLE()                __HAL_RCC_GPIOG_CLK_ENABLE()
+#define TS_INT_GPIO_CLK_DISABLE()               __HAL_RCC_GPIOG_CLK_DISABLE()
+#define TS_INT_EXTI_IRQn                        EXTI15_10_IRQn
+
 /* I2C clock speed configuration (in Hz) 
    WARNING: 
    Make sure that this define is not already declared in other files (ie. 
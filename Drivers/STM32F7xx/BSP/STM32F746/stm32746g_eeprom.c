@@ -102,10 +102,77 @@ EndDependencies */
 /* Imported Types  -----------------------------------------------------------*/
 /* Imported Variables --------------------------------------------------------*/
 /* Imported Functions    -----------------------------------------------------*/
+/* Private Types  ------------------------------------------------------------*/
+#pragma pack(push, 1)
+/** Blok roletni iz rasporeda verzije 1 (`EE_LEGACY_CURTAINS_SIZE` roletni). */
+typedef struct {
+    uint16_t magic_number;
+    uint8_t  upDownDurationSeconds;
+    Curtain_EepromConfig_t curtains[EE_LEGACY_CURTAINS_SIZE];
+    uint16_t crc;
+} EE_LegacyCurtains_t;
+
+/** Scena iz rasporeda verzije 1: uze maske i nizovi za 6 svjetala i 16 roletni. */
+typedef struct {
+    uint8_t  appearance_id;
+    bool     is_configured;
+    uint8_t  lights_mask;
+    uint16_t curtains_mask;
+    uint8_t  thermostat_mask;
+    uint8_t  light_values[EE_LEGACY_LIGHTS_SIZE];
+    uint8_t  light_brightness[EE_LEGACY_LIGHTS_SIZE];
+    uint32_t light_colors[EE_LEGACY_LIGHTS_SIZE];
+    uint8_t  curtain_states[EE_LEGACY_CURTAINS_SIZE];
+    uint8_t  thermostat_setpoint;
+    SceneType_e scene_type;
+    int8_t   wakeup_hour;
+    uint8_t  wakeup_minute;
+    uint8_t  security_partitions_to_arm;
+    bool     activate_wakeup_scene;
+    int8_t   wakeup_scene_index;
+    bool     use_buzzer_alarm;
+    uint8_t  exit_delay_s;
+    bool     presence_simulation_enabled;
+    uint16_t homecoming_triggers[SCENE_MAX_TRIGGERS];
+} EE_LegacyScene_t;
+
+/** Blok svih scena iz rasporeda verzije 1 (jedan CRC za sve scene). */
+typedef struct {
+    uint16_t magic_number;
+    EE_LegacyScene_t scenes[EE_LEGACY_SCENE_COUNT];
+    uint16_t crc;
+} EE_LegacySceneBlock_t;
+#pragma pack(pop)
 /* Private Variables  --------------------------------------------------------*/
+/* Stari raspored se cita cijeli prije prvog upisa jer se stari i novi blokovi
+   preklapaju. Oba bafera su u SDRAM-u (`.sdram_ram`) i koriste se samo u
+   EE_MigrateLayout(). */
+static uint8_t ee_legacy[EE_LEGACY_END - EE_LEGACY_CURTAINS] __attribute__((section(".sdram_ram")));
+static union {
+    Curtains_EepromData_t curtains;
+    Scene_EepromRecord_t  scene;
+} ee_convert __attribute__((section(".sdram_ram")));
 /* Private Macros    ---------------------------------------------------------*/
+/* Provjera EEPROM mape: niz negativne duzine ako se sekcije preklapaju */
+typedef char EE_ConfigFitsBeforeQr_t[(EE_CONFIG_END <= EE_QR_CODE1) ? 1 : -1];
+typedef char EE_DevicesFitInEeprom_t[(EE_DEVICES_END <= EE_MAXSIZE) ? 1 : -1];
+/* Provjera zamrznutog starog rasporeda: lanac je poceo gdje je sada EE_TIMER,
+   a svaki blok mora imati velicinu koju je imao u verziji 1 */
+typedef char EE_LegacyChainStart_t[(EE_LEGACY_CURTAINS == EE_TIMER) ? 1 : -1];
+typedef char EE_LegacyCurtainsSize_t[(sizeof(EE_LegacyCurtains_t) == (EE_LEGACY_LIGHTS_MODBUS - EE_LEGACY_CURTAINS)) ? 1 : -1];
+typedef char EE_LegacyLightsSize_t[((sizeof(LIGHT_EepromConfig_t) * EE_LEGACY_LIGHTS_SIZE) == (EE_LEGACY_SCENES - EE_LEGACY_LIGHTS_MODBUS)) ? 1 : -1];
+typedef char EE_LegacyScenesSize_t[(sizeof(EE_LegacySceneBlock_t) == (EE_LEGACY_GATES - EE_LEGACY_SCENES)) ? 1 : -1];
+typedef char EE_LegacyGatesSize_t[((sizeof(Gate_EepromConfig_t) * EE_LEGACY_GATE_COUNT) == (EE_LEGACY_TIMER - EE_LEGACY_GATES)) ? 1 : -1];
+typedef char EE_LegacyTimerSize_t[(sizeof(Timer_EepromConfig_t) == (EE_LEGACY_SECURITY - EE_LEGACY_TIMER)) ? 1 : -1];
+typedef char EE_LegacySecuritySize_t[(sizeof(Security_Settings_t) == (EE_LEGACY_TIMER_EXT - EE_LEGACY_SECURITY)) ? 1 : -1];
+typedef char EE_LegacyTimerExtSize_t[((sizeof(Timer_EepromConfig_t) * (TIMER_MAX_COUNT - 1)) == (EE_LEGACY_THERMOSTAT_CTRL - EE_LEGACY_TIMER_EXT)) ? 1 : -1];
+typedef char EE_LegacyCtrlSize_t[(sizeof(THERMOSTAT_CtrlConfig_t) == (EE_LEGACY_END - EE_LEGACY_THERMOSTAT_CTRL)) ? 1 : -1];
 /* Private Prototypes    -----------------------------------------------------*/
 uint32_t EE_WritePage (uint8_t *pBuffer, uint16_t WriteAddr, uint16_t NumByteToWrite);
+static bool EE_LegacyBlockValid(uint8_t *block, uint16_t size);
+static void EE_MigrateBlock(uint16_t legacy_addr, uint16_t new_addr, uint16_t size);
+static void EE_MigrateCurtains(void);
+static void EE_MigrateScenes(void);
 /* Program code   ------------------------------------------------------------*/
 /**
   * @brief
@@ -304,4 +371,152 @@ uint32_t EE_WritePage(uint8_t *pBuffer, uint16_t WriteAddr, uint16_t NumByteToWr
     status = EE_IsDeviceReady(EE_ADDR, EE_MAX_TRIALS);
     return status;
 }
+/**
+  * @brief  Jednom prepisuje blokove iz starog rasporeda (verzija 1) na adrese
+  *         iz trenutne mape i upisuje EE_LAYOUT_VERSION na EE_LAYOUT_VER.
+  * @note   Poziva se poslije EE_Init(), a prije Init funkcija modula. Prenose
+  *         se samo blokovi sa ispravnim magicnim brojem i CRC-om; ostale
+  *         blokove moduli zamijene podrazumijevanim kao i do sada. Cijeli stari
+  *         raspored se prvo procita u `ee_legacy`, pa redoslijed upisa nije
+  *         bitan. Ako napajanje nestane prije upisa verzije, migracija se
+  *         ponavlja: blokovi koje su novi upisi vec prebrisali ne prolaze
+  *         provjeru i ostaju kako su prvi put prepisani.
+  * @param  None
+  * @retval None
+  */
+void EE_MigrateLayout(void)
+{
+    uint8_t version = 0;
+    uint8_t i;
+
+    EE_ReadBuffer(&version, EE_LAYOUT_VER, 1);
+    if (version == EE_LAYOUT_VERSION) return;
+
+    EE_ReadBuffer(ee_legacy, EE_LEGACY_CURTAINS, sizeof(ee_legacy));
+
+    // Blokovi cija se struktura nije mijenjala prelaze bajt za bajt, CRC ostaje isti
+    EE_MigrateBlock(EE_LEGACY_TIMER, EE_TIMER, sizeof(Timer_EepromConfig_t));
+    EE_MigrateBlock(EE_LEGACY_SECURITY, EE_SECURITY, sizeof(Security_Settings_t));
+    for (i = 0; i < (TIMER_MAX_COUNT - 1); i++)
+    {
+        EE_MigrateBlock(EE_LEGACY_TIMER_EXT + (i * sizeof(Timer_EepromConfig_t)),
+                        EE_TIMER_EXT + (i * sizeof(Timer_EepromConfig_t)), sizeof(Timer_EepromConfig_t));
+    }
+    EE_MigrateBlock(EE_LEGACY_THERMOSTAT_CTRL, EE_THERMOSTAT_CTRL, sizeof(THERMOSTAT_CtrlConfig_t));
+    for (i = 0; i < EE_LEGACY_LIGHTS_SIZE; i++)
+    {
+        EE_MigrateBlock(EE_LEGACY_LIGHTS_MODBUS + (i * sizeof(LIGHT_EepromConfig_t)),
+                        EE_LIGHTS_MODBUS + (i * sizeof(LIGHT_EepromConfig_t)), sizeof(LIGHT_EepromConfig_t));
+    }
+    for (i = 0; i < EE_LEGACY_GATE_COUNT; i++)
+    {
+        EE_MigrateBlock(EE_LEGACY_GATES + (i * sizeof(Gate_EepromConfig_t)),
+                        EE_GATES + (i * sizeof(Gate_EepromConfig_t)), sizeof(Gate_EepromConfig_t));
+    }
+    // Roletne i scene su u verziji 2 vece, pa se prepakuju
+    EE_MigrateCurtains();
+    EE_MigrateScenes();
+
+    version = EE_LAYOUT_VERSION;
+    EE_WriteBuffer(&version, EE_LAYOUT_VER, 1);
+}
+/**
+  * @brief  Provjerava magicni broj i CRC bloka iz `ee_legacy`.
+  * @note   Svi EEPROM blokovi modula imaju `magic_number` na pocetku i `crc`
+  *         na kraju, a CRC se racuna sa nuliranim poljem `crc`. Blok se
+  *         vraca neizmijenjen.
+  * @param  block: pocetak bloka u `ee_legacy`.
+  * @param  size: velicina bloka u bajtovima.
+  * @retval true ako je blok ispravan.
+  */
+static bool EE_LegacyBlockValid(uint8_t *block, uint16_t size)
+{
+    uint16_t magic, crc, calculated_crc;
+
+    memcpy(&magic, block, sizeof(magic));
+    memcpy(&crc, &block[size - sizeof(crc)], sizeof(crc));
+    if (magic != EEPROM_MAGIC_NUMBER) return false;
+
+    memset(&block[size - sizeof(crc)], 0, sizeof(crc));
+    calculated_crc = (uint16_t)HAL_CRC_Calculate(&hcrc, (uint32_t*)block, size);
+    memcpy(&block[size - sizeof(crc)], &crc, sizeof(crc));
+    return (calculated_crc == crc);
+}
+/**
+  * @brief  Prepisuje ispravan blok nepromijenjene strukture na novu adresu.
+  * @param  legacy_addr: adresa bloka u rasporedu verzije 1.
+  * @param  new_addr: adresa bloka u trenutnoj mapi.
+  * @param  size: velicina bloka u bajtovima.
+  * @retval None
+  */
+static void EE_MigrateBlock(uint16_t legacy_addr, uint16_t new_addr, uint16_t size)
+{
+    uint8_t *block = &ee_legacy[legacy_addr - EE_LEGACY_CURTAINS];
+
+    if (EE_LegacyBlockValid(block, size)) EE_WriteBuffer(block, new_addr, size);
+}
+/**
+  * @brief  Prepakuje blok roletni iz verzije 1 u `Curtains_EepromData_t`.
+  * @note   Stare roletne su na pocetku niza, ostale su prazne (relej 0).
+  * @param  None
+  * @retval None
+  */
+static void EE_MigrateCurtains(void)
+{
+    EE_LegacyCurtains_t *legacy = (EE_LegacyCurtains_t*)ee_legacy;    // prvi blok lanca
+
+    if (!EE_LegacyBlockValid((uint8_t*)legacy, sizeof(EE_LegacyCurtains_t))) return;
+
+    memset(&ee_convert.curtains, 0, sizeof(Curtains_EepromData_t));
+    ee_convert.curtains.magic_number = EEPROM_MAGIC_NUMBER;
+    ee_convert.curtains.upDownDurationSeconds = legacy->upDownDurationSeconds;
+    memcpy(ee_convert.curtains.curtains, legacy->curtains, sizeof(legacy->curtains));
+    ee_convert.curtains.crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&ee_convert.curtains, sizeof(Curtains_EepromData_t));
+    EE_WriteBuffer((uint8_t*)&ee_convert.curtains, EE_CURTAINS, sizeof(Curtains_EepromData_t));
+}
+/**
+  * @brief  Prepakuje blok scena iz verzije 1 u po jedan `Scene_EepromRecord_t`.
+  * @note   Maske se prosiruju na 32 bita, a nizovi svjetala i roletni se
+  *         dopunjavaju nulama. Scene od EE_LEGACY_SCENE_COUNT nadalje
+  *         postavlja Scene_Init().
+  * @param  None
+  * @retval None
+  */
+static void EE_MigrateScenes(void)
+{
+    EE_LegacySceneBlock_t *legacy = (EE_LegacySceneBlock_t*)&ee_legacy[EE_LEGACY_SCENES - EE_LEGACY_CURTAINS];
+    Scene_t *scene = &ee_convert.scene.scene;
+
+    if (!EE_LegacyBlockValid((uint8_t*)legacy, sizeof(EE_LegacySceneBlock_t))) return;
+
+    for (uint8_t i = 0; i < EE_LEGACY_SCENE_COUNT; i++)
+    {
+        const EE_LegacyScene_t *old = &legacy->scenes[i];
+
+        memset(&ee_convert.scene, 0, sizeof(Scene_EepromRecord_t));
+        ee_convert.scene.magic_number       = EEPROM_MAGIC_NUMBER;
+        scene->appearance_id                = old->appearance_id;
+        scene->is_configured                = old->is_configured;
+        scene->lights_mask                  = old->lights_mask;
+        scene->curtains_mask                = old->curtains_mask;
+        scene->thermostat_mask              = old->thermostat_mask;
+        memcpy(scene->light_values, old->light_values, sizeof(old->light_values));
+        memcpy(scene->light_brightness, old->light_brightness, sizeof(old->light_brightness));
+        memcpy(scene->light_colors, old->light_colors, sizeof(old->light_colors));
+        memcpy(scene->curtain_states, old->curtain_states, sizeof(old->curtain_states));
+        scene->thermostat_setpoint          = old->thermostat_setpoint;
+        scene->scene_type                   = old->scene_type;
+        scene->wakeup_hour                  = old->wakeup_hour;
+        scene->wakeup_minute                = old->wakeup_minute;
+        scene->security_partitions_to_arm   = old->security_partitions_to_arm;
+        scene->activate_wakeup_scene        = old->activate_wakeup_scene;
+        scene->wakeup_scene_index           = old->wakeup_scene_index;
+        scene->use_buzzer_alarm             = old->use_buzzer_alarm;
+        scene->exit_delay_s                 = old->exit_delay_s;
+        scene->presence_simulation_enabled  = old->presence_simulation_enabled;
+        memcpy(scene->homecoming_triggers, old->homecoming_triggers, sizeof(old->homecoming_triggers));
+        ee_convert.scene.crc = (uint16_t)HAL_CRC_Calculate(&hcrc, (uint32_t*)&ee_convert.scene, sizeof(Scene_EepromRecord_t));
+        EE_WriteBuffer((uint8_t*)&ee_convert.scene, EE_SCENES + (i * sizeof(Scene_EepromRecord_t)), sizeof(Scene_EepromRecord_t));
+    }
+}
 /************************ (C) COPYRIGHT JUBERA D.O.O Sarajevo ************************/
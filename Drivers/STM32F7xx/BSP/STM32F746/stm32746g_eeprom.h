@@ -38,6 +38,7 @@
 #define EE_MAXSIZE                          0x4000 /* 64Kbit */
 #define EE_ADDR                             0xA0
 #define EEPROM_MAGIC_NUMBER                 0xABCD // Definiemo jedinstven "magicni broj" za cijeli projekat
+#define EE_LAYOUT_VERSION                   2      // 1 = svi blokovi u jednom lancu iza EE_DEFROSTER (Sekcija 5), 2 = Sekcija 4
 
 // =================================================================================
 // === FLEKSIBILNA EEPROM MAPA ===
@@ -54,6 +55,7 @@
 #define EE_TFIFA			                0x04	// 1 bajt:  Adresa uredaja na RS485 busu (TinyFrame).
 #define EE_SYSID			                0x05	// 2 bajta: Jedinstveni ID sistema.
 #define EE_SYSTEM_PIN                       0x08    // 5 bajtova: Sistemski PIN kod (npr. "1234\0")
+#define EE_LAYOUT_VER                       0x10    // 1 bajt:  Verzija rasporeda mape (EE_LAYOUT_VERSION), postavlja EE_MigrateLayout().
 /**
  * @brief  Sekcija 2: Struktuirani Blokovi Podataka
  * @note   Ovo je glavni dio konfiguracije. Svaki modul ima svoj blok podataka
@@ -67,12 +69,11 @@
 #define EE_THERMOSTAT                       (EE_DISPLAY_SETTINGS + sizeof(Display_EepromSettings_t))
 #define EE_VENTILATOR                       (EE_THERMOSTAT + sizeof(THERMOSTAT_EepromConfig_t))
 #define EE_DEFROSTER                        (EE_VENTILATOR + sizeof(Ventilator_EepromConfig_t))
-#define EE_CURTAINS                         (EE_DEFROSTER + sizeof(Defroster_EepromConfig_t))
-#define EE_LIGHTS_MODBUS                    (EE_CURTAINS + sizeof(Curtains_EepromData_t))
-#define EE_SCENES                           (EE_LIGHTS_MODBUS + (sizeof(LIGHT_EepromConfig_t) * LIGHTS_MODBUS_SIZE))
-#define EE_GATES                            (EE_SCENES + sizeof(Scene_EepromBlock_t))
-#define EE_TIMER                            (EE_GATES + (sizeof(Gate_EepromConfig_t) * GATE_MAX_COUNT))
+#define EE_TIMER                            (EE_DEFROSTER + sizeof(Defroster_EepromConfig_t))
 #define EE_SECURITY                         (EE_TIMER + sizeof(Timer_EepromConfig_t))
+#define EE_TIMER_EXT                        (EE_SECURITY + sizeof(Security_Settings_t))    // Tajmeri 1..TIMER_MAX_COUNT-1
+#define EE_THERMOSTAT_CTRL                  (EE_TIMER_EXT + (sizeof(Timer_EepromConfig_t) * (TIMER_MAX_COUNT - 1)))  // Regulator fan-coila
+#define EE_CONFIG_END                       (EE_THERMOSTAT_CTRL + sizeof(THERMOSTAT_CtrlConfig_t))
 
 
 /**
@@ -83,11 +84,49 @@
 #define EE_QR_CODE1                         0x400       // Rezervisano 64 bajta za WiFi QR kod.
 #define EE_QR_CODE2                         0x440       // Rezervisano 64 bajta za App QR kod.
 
+/**
+ * @brief  Sekcija 4: Blokovi Uredaja
+ * @note   Konfiguracije svjetala, roletni, kapija i scena rastu sa kapacitetima
+ * iz common.h, pa su iza QR kodova, do kraja EEPROM-a. Scene imaju po
+ * jedan zapis (`Scene_EepromRecord_t`) za svaku scenu. Preklapanje
+ * sekcija provjerava stm32746g_eeprom.c u toku prevodenja.
+ */
+#define EE_DEVICES                          (EE_QR_CODE2 + 0x40)
+#define EE_CURTAINS                         EE_DEVICES
+#define EE_LIGHTS_MODBUS                    (EE_CURTAINS + sizeof(Curtains_EepromData_t))
+#define EE_GATES                            (EE_LIGHTS_MODBUS + (sizeof(LIGHT_EepromConfig_t) * LIGHTS_MODBUS_SIZE))
+#define EE_SCENES                           (EE_GATES + (sizeof(Gate_EepromConfig_t) * GATE_MAX_COUNT))
+#define EE_DEVICES_END                      (EE_SCENES + (sizeof(Scene_EepromRecord_t) * SCENE_MAX_COUNT))
+
+/**
+ * @brief  Sekcija 5: Stari Raspored (verzija 1)
+ * @note   Adrese blokova prije uvodenja Sekcije 4, kada su svi blokovi bili u
+ * jednom lancu iza EE_DEFROSTER, sa 6 svjetala, 16 roletni, 6 kapija i 6
+ * scena. Vrijednosti su zamrznute i ne smiju se racunati iz trenutnih
+ * struktura: EE_MigrateLayout() sa ovih adresa jednom prepisuje ispravne
+ * blokove na nove adrese. Velicine starih blokova provjerava
+ * stm32746g_eeprom.c u toku prevodenja.
+ */
+#define EE_LEGACY_CURTAINS                  0x06A   // Blok roletni sa 16 roletni
+#define EE_LEGACY_LIGHTS_MODBUS             0x0CF   // 6 x LIGHT_EepromConfig_t
+#define EE_LEGACY_SCENES                    0x1D1   // Jedan blok sa svih 6 scena
+#define EE_LEGACY_GATES                     0x3DF   // 6 x Gate_EepromConfig_t
+#define EE_LEGACY_TIMER                     0x529   // Timer_EepromConfig_t
+#define EE_LEGACY_SECURITY                  0x533   // Security_Settings_t
+#define EE_LEGACY_TIMER_EXT                 0x5A6   // Tajmeri 1..TIMER_MAX_COUNT-1
+#define EE_LEGACY_THERMOSTAT_CTRL           0x5C4   // THERMOSTAT_CtrlConfig_t
+#define EE_LEGACY_END                       0x5D6
+#define EE_LEGACY_LIGHTS_SIZE               6
+#define EE_LEGACY_CURTAINS_SIZE             16
+#define EE_LEGACY_GATE_COUNT                6
+#define EE_LEGACY_SCENE_COUNT               6
+
 
 /* Link function for I2C EEPROM peripheral */
 void     EE_Init         (void);
 uint32_t EE_ReadBuffer   (uint8_t *pBuffer, uint16_t ReadAddr,  uint16_t NumByteToRead);
 uint32_t EE_WriteBuffer  (uint8_t *pBuffer, uint16_t WriteAddr, uint16_t NumByteToWrite);
+void     EE_MigrateLayout(void);
 
 
 #ifdef __cplusplus
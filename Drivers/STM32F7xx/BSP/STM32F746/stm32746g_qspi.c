@@ -373,6 +373,118 @@ uint8_t QSPI_MemMapMode(void)
     }
     return QSPI_OK;
 }
+/**
+  * @brief  Leaves memory-mapped mode so that commands can be sent to the memory.
+  * @note   Memory-mapped reads are not possible until QSPI_MemMapMode is called.
+  * @retval QSPI memory status
+  */
+uint8_t QSPI_IndirectMode(void)
+{
+    if (MemMapModeState != 0U)
+    {
+        if (HAL_QSPI_Abort(&hqspi) != HAL_OK)
+        {
+            return QSPI_ERROR;
+        }
+        MemMapModeState = 0U;
+    }
+    return QSPI_OK;
+}
+/**
+  * @brief  Starts programming of one page and returns without waiting for the end.
+  * @note   Data must not cross a QSPI_PAGE_SIZE boundary. End of program is
+  *         checked with QSPI_GetStatus; memory-mapped mode must be left first.
+  * @param  pbuf: Pointer to data to be written
+  * @param  wraddr: Write start address
+  * @param  size: Number of bytes to write
+  * @retval QSPI memory status
+  */
+uint8_t QSPI_WritePageStart(uint8_t *pbuf, uint32_t wraddr, uint32_t size)
+{
+    QSPI_CommandTypeDef s_command;
+
+    s_command.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
+    s_command.Instruction       = EXT_QUAD_IN_FAST_PROG_CMD;
+    s_command.AddressMode       = QSPI_ADDRESS_4_LINES;
+    s_command.AddressSize       = QSPI_ADDRESS_24_BITS;
+    s_command.Address           = wraddr & 0x0FFFFFFFU;
+    s_command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+    s_command.DataMode          = QSPI_DATA_4_LINES;
+    s_command.DummyCycles       = 0;
+    s_command.NbData            = size;
+    s_command.DdrMode           = QSPI_DDR_MODE_DISABLE;
+    s_command.DdrHoldHalfCycle  = QSPI_DDR_HHC_ANALOG_DELAY;
+    s_command.SIOOMode          = QSPI_SIOO_INST_EVERY_CMD;
+
+    /* Enable write operations */
+    if (QSPI_WriteEnable() != QSPI_OK)
+    {
+        return QSPI_ERROR;
+    }
+
+    /* Configure the command */
+    if (HAL_QSPI_Command(&hqspi, &s_command, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return QSPI_ERROR;
+    }
+
+    /* Transmission of the data */
+    if (HAL_QSPI_Transmit(&hqspi, pbuf, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return QSPI_ERROR;
+    }
+
+    return QSPI_OK;
+}
+/**
+  * @brief  Starts erase of one 4kB subsector and returns without waiting for the end.
+  * @note   End of erase is checked with QSPI_GetStatus (typ. 250ms,
+  *         N25Q128A_SUBSECTOR_ERASE_MAX_TIME max.); memory-mapped mode must be left first.
+  * @param  addr: Any address inside the subsector
+  * @retval QSPI memory status
+  */
+uint8_t QSPI_EraseSubsectorStart(uint32_t addr)
+{
+    QSPI_CommandTypeDef s_command;
+
+    s_command.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
+    s_command.Instruction       = SUBSECTOR_ERASE_CMD;
+    s_command.AddressMode       = QSPI_ADDRESS_1_LINE;
+    s_command.AddressSize       = QSPI_ADDRESS_24_BITS;
+    s_command.Address           = (addr - (addr % N25Q128A_SUBSECTOR_SIZE)) & 0x0FFFFFFFU;
+    s_command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+    s_command.DataMode          = QSPI_DATA_NONE;
+    s_command.DummyCycles       = 0;
+    s_command.DdrMode           = QSPI_DDR_MODE_DISABLE;
+    s_command.DdrHoldHalfCycle  = QSPI_DDR_HHC_ANALOG_DELAY;
+    s_command.SIOOMode          = QSPI_SIOO_INST_EVERY_CMD;
+
+    /* Enable write operations */
+    if (QSPI_WriteEnable() != QSPI_OK)
+    {
+        return QSPI_ERROR;
+    }
+
+    /* Send the command */
+    if (HAL_QSPI_Command(&hqspi, &s_command, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    {
+        return QSPI_ERROR;
+    }
+
+    return QSPI_OK;
+}
+/**
+  * @brief  Invalidates D-cache lines of a memory-mapped range after program or erase.
+  * @param  addr: Memory-mapped start address
+  * @param  size: Number of bytes
+  * @retval None
+  */
+void QSPI_InvalidateCache(uint32_t addr, uint32_t size)
+{
+    uint32_t start = addr & ~31U;
+
+    SCB_InvalidateDCache_by_Addr((uint32_t*)start, (int32_t)((addr + size) - start));
+}
 /**
   * @} if this function fail, qspi interface will stay in indirect mode
   */
@@ -786,37 +898,7 @@ static uint8_t QSPI_AutoPollMemRdy(uint32_t Timeout)
   */
 static uint8_t QSPI_WritePage (uint32_t addr, uint32_t size, uint8_t *buff)
 {
-
-    QSPI_CommandTypeDef s_command;
-    
-    s_command.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
-    s_command.Instruction       = EXT_QUAD_IN_FAST_PROG_CMD;
-    s_command.AddressMode       = QSPI_ADDRESS_4_LINES;
-    s_command.AddressSize       = QSPI_ADDRESS_24_BITS;
-    s_command.Address           = addr & 0x0FFFFFFFU;
-    s_command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
-    s_command.DataMode          = QSPI_DATA_4_LINES;
-    s_command.DummyCycles       = 0;
-    s_command.NbData            = size;
-    s_command.DdrMode           = QSPI_DDR_MODE_DISABLE;
-    s_command.DdrHoldHalfCycle  = QSPI_DDR_HHC_ANALOG_DELAY;
-    s_command.SIOOMode          = QSPI_SIOO_INST_EVERY_CMD;
-
-
-    /* Enable write operations */
-    if (QSPI_WriteEnable() != QSPI_OK)
-    {
-        return QSPI_ERROR;
-    }
-
-    /* Configure the command */
-    if (HAL_QSPI_Command(&hqspi, &s_command, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
-    {
-        return QSPI_ERROR;
-    }
-
-    /* Transmission of the data */
-    if (HAL_QSPI_Transmit(&hqspi, buff, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+    if (QSPI_WritePageStart(buff, addr, size) != QSPI_OK)
     {
         return QSPI_ERROR;
     }
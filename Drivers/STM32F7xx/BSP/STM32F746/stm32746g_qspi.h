@@ -103,6 +103,10 @@ uint8_t QSPI_EraseChip  (uint32_t staddr);
 uint8_t QSPI_Erase      (uint32_t staddr, uint32_t enaddr);
 uint8_t QSPI_Read       (uint8_t   *pbuf, uint32_t rdaddr, uint32_t size);
 uint8_t QSPI_Write      (uint8_t   *pbuf, uint32_t wraddr, uint32_t size);
+uint8_t QSPI_IndirectMode       (void);
+uint8_t QSPI_WritePageStart     (uint8_t   *pbuf, uint32_t wraddr, uint32_t size);
+uint8_t QSPI_EraseSubsectorStart(uint32_t addr);
+void    QSPI_InvalidateCache    (uint32_t addr, uint32_t size);
 uint8_t FLASH2QSPI_Copy (uint32_t rdaddr, uint32_t wraddr, uint32_t size);
 uint8_t QSPI2QSPI_Copy  (uint32_t rdaddr, uint32_t wraddr, uint32_t size);
 uint8_t QSPI2FLASH_Copy (uint32_t rdaddr, uint32_t wraddr, uint32_t size);
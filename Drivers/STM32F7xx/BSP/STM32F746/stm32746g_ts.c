@@ -196,6 +196,39 @@ uint8_t BSP_TS_DeInit(void)
 }
 
 
+/**
+  * @brief  Configures and enables the touch screen interrupts.
+  * @note   The FT5336 is switched to interrupt trigger mode and its INT line
+  *         is routed to TS_INT_EXTI_IRQn on the falling edge. The user EXTI
+  *         callback is then called on every new touch event.
+  * @retval TS_OK if all initializations are OK. Other value if error.
+  */
+uint8_t BSP_TS_ITConfig(void)
+{
+  GPIO_InitTypeDef gpio_init_structure;
+
+  if(tsDriver == NULL)
+  {
+    return TS_DEVICE_NOT_FOUND;
+  }
+
+  /* Configure Interrupt mode for TS detection pin */
+  TS_INT_GPIO_CLK_ENABLE();
+  gpio_init_structure.Pin = TS_INT_PIN;
+  gpio_init_structure.Pull = GPIO_PULLUP;
+  gpio_init_structure.Speed = GPIO_SPEED_FREQ_LOW;
+  gpio_init_structure.Mode = GPIO_MODE_IT_FALLING;
+  HAL_GPIO_Init(TS_INT_GPIO_PORT, &gpio_init_structure);
+
+  /* Enable and set Touch screen EXTI Interrupt to the lowest priority */
+  HAL_NVIC_SetPriority((IRQn_Type)(TS_INT_EXTI_IRQn), 0x0F, 0x00);
+  HAL_NVIC_EnableIRQ((IRQn_Type)(TS_INT_EXTI_IRQn));
+
+  /* Enable the TS ITs */
+  tsDriver->EnableIT(I2cAddress);
+
+  return TS_OK;
+}
 
 /**
   * @brief  Gets the touch screen interrupt status.
@@ -182,6 +182,7 @@ uint8_t BSP_TS_GetState(TS_StateTypeDef *TS_State);
 uint8_t BSP_TS_Get_GestureId(TS_StateTypeDef *TS_State);
 #endif /* TS_MULTI_TOUCH_SUPPORTED == 1 */
 
+uint8_t BSP_TS_ITConfig(void);
 uint8_t BSP_TS_ITGetStatus(void);
 void    BSP_TS_ITClear(void);
 uint8_t BSP_TS_ResetTouchData(TS_StateTypeDef *TS_State);
@@ -0,0 +1,1120 @@
+/**
+ ******************************************************************************
+ * @file    bus_sim.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Virtuelni RS485 bus sa simuliranim LuxNET čvorovima.
+ *
+ * @note    Prevodi se samo u host build. Model busa:
+ * - Svaki predajnik (kontroler, čvor, šum, pseudo-terminal) dodaje prenos
+ *   sa poznatim početkom; bajt `i` je na busu u intervalu
+ *   `[start + i*T, start + (i+1)*T)`, gdje je `T` trajanje 10 bita.
+ * - U svakoj simuliranoj milisekundi se, hronološki po kraju bajta,
+ *   predaju svi bajtovi koji su do tada preneseni: kontroleru preko
+ *   `HostShim_UartRx`, čvorovima u njihove parsere, i pseudo-terminalu.
+ * - Dva prenosa koja se vremenski preklope označavaju prozor kolizije;
+ *   bajtovi unutar prozora stižu oštećeni kod svih prijemnika.
+ * - Kontroler ne osluškuje bus prije slanja (kao `TF_WriteImpl`), a čvorovi
+ *   odgovaraju nakon fiksnog kašnjenja bez osluškivanja. Spontana poruka
+ *   čvora kreće u slučajnom trenutku unutar milisekunde u kojoj je zadana
+ *   i, ako je bus tada zauzet, čeka kraj prenosa uz kratak slučajni odmak.
+ *
+ * Termostat čvor prati stanje grupe na dva načina: stari uređaj iz odgovora
+ * kontrolera na svoj `THERMOSTAT_INFO`, a novi (`BusSim_SetNodeSync`) iz
+ * broadcast okvira `THERMOSTAT_SYNC` mastera, uz provjeru rednih brojeva i
+ * zahtjev za ključni okvir kada u nizu uoči prazninu. Za svaki TF tip se
+ * broje okviri, bajtovi i vrijeme na busu, bez obzira na predajnika.
+ *
+ * Okviri su u formatu iz `TF_Config.h`: SOF, ID, LEN (2), TYPE, CRC16
+ * zaglavlja, podaci i CRC16 podataka (samo kada je LEN > 0), višebajtna
+ * polja big-endian. Čvorovi imaju vlastiti parser i sastavljač okvira jer
+ * `TF_WriteImpl` postoji samo jednom, za kontroler iz `rs485.c`.
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "rs485.h"
+#include "thermostat_sync.h"
+#include "host_shim.h"
+#include "bus_sim.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define BUS_SIM_NS_PER_MS               1000000ULL
+#define BUS_SIM_NS_PER_US               1000ULL
+#define BUS_SIM_BITS_PER_BYTE           10U     ///< Start, 8 podataka, stop
+#define BUS_SIM_HEAD_LEN                7U      ///< SOF, ID, LEN (2), TYPE, CRC16
+#define BUS_SIM_CKSUM_LEN               2U
+#define BUS_SIM_ID_PEERBIT              0x80U   ///< `TF_ID_PEERBIT` za 1-bajtni ID
+#define BUS_SIM_ID_MASK                 0x7FU
+#define BUS_SIM_PARSER_TIMEOUT_NS       ((uint64_t)TF_PARSER_TIMEOUT_TICKS * BUS_SIM_NS_PER_MS)
+#define BUS_SIM_REPLY_MAX               32U     ///< Najduži odgovor čvora (podaci)
+#define BUS_SIM_PENDING_DATA            32U     ///< Kao `Command.data` u `rs485.h`
+#define BUS_SIM_LBT_BACKOFF_BYTES       4U      ///< Maksimalan odmak spontane poruke, u bajtovima
+#define BUS_SIM_NOISE_MAX_BYTES         3U
+#define BUS_SIM_PTY_CHUNK               64U
+#define BUS_SIM_PPM                     1000000U
+
+/** @name Podrazumijevane vrijednosti u odgovorima čvorova
+ *  @{
+ */
+#define BUS_SIM_DIMMER_RAMP             10U     ///< Rampa dimera, ms
+#define BUS_SIM_DIMMER_TEMP             35U     ///< Temperatura dimera, °C
+#define BUS_SIM_DIMMER_TEMP_LIMIT       85U
+#define BUS_SIM_DIMMER_SCALE_MAX        1000U
+#define BUS_SIM_DIMMER_SCALE_MIN        10U
+#define BUS_SIM_DIMMER_RUNNING          1U
+#define BUS_SIM_CURTAIN_TIMER           60U     ///< Timeout žaluzine, s
+#define BUS_SIM_THERMO_INFO_LEN         7U      ///< `thermo_info_t` bez poravnanja
+#define BUS_SIM_THERMO_ACK_POS          18U     ///< `THE_ACK_POZICIJA` u `rs485.c`
+#define BUS_SIM_THERMO_MV_TEMP          210     ///< 21.0 °C
+#define BUS_SIM_THERMO_SP_TEMP          22U
+#define BUS_SIM_THERMO_REQ_JITTER_US    50000U  ///< Slučajni odmak zahtjeva za ključni okvir, kao obrada u petlji uređaja
+/** @} */
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+/**
+ * @brief Prijemnik okvira jednog učesnika na busu.
+ */
+typedef struct
+{
+    uint8_t  buf[BUS_SIM_MAX_FRAME];
+    uint16_t pos;           ///< Broj primljenih bajtova tekućeg okvira
+    uint16_t need;          ///< Očekivana dužina okvira (poznata nakon zaglavlja)
+    uint64_t start_ns;      ///< Vrijeme prvog bajta tekućeg okvira
+    uint64_t last_ns;       ///< Vrijeme zadnjeg bajta, za timeout parsera
+} BusParser_t;
+
+/**
+ * @brief Dekodirani okvir; `data` pokazuje u bafer parsera.
+ */
+typedef struct
+{
+    uint8_t  id;
+    uint8_t  type;
+    uint16_t len;
+    const uint8_t* data;
+    uint64_t start_ns;
+} BusFrame_t;
+
+/**
+ * @brief Jedan prenos na busu (okvir ili komad okvira jednog predajnika).
+ */
+typedef struct
+{
+    bool     used;
+    bool     reply;         ///< Odgovor čvora na zahtjev kontrolera `id`
+    bool     damaged;       ///< Barem jedan bajt izgubljen ili oštećen
+    int      src;           ///< Indeks čvora ili `BUS_SIM_SRC_xxx`
+    uint8_t  id;
+    uint16_t len;
+    uint16_t done;          ///< Broj već predatih bajtova
+    uint64_t start_ns;
+    uint64_t col_start_ns;  ///< Prozor kolizije; `col_end_ns == 0` znači bez kolizije
+    uint64_t col_end_ns;
+    uint8_t  data[BUS_SIM_MAX_FRAME];
+} BusTx_t;
+
+/**
+ * @brief Simulirani čvor: javno stanje i interni prijemnik.
+ */
+typedef struct
+{
+    BusSim_Node_t pub;
+    BusParser_t parser;
+    uint8_t  next_id;
+    bool     wait;          ///< Čeka odgovor kontrolera na `wait_id`
+    uint8_t  wait_id;
+    uint64_t wait_start_ns;
+    bool     ev_pending;    ///< Spontana poruka čeka svoj trenutak slanja
+    uint16_t ev_len;
+    uint64_t ev_start_ns;
+    uint8_t  ev_frame[BUS_SIM_HEAD_LEN + BUS_SIM_THERMO_INFO_LEN + BUS_SIM_CKSUM_LEN];
+    uint8_t  th_seq;        ///< Redni broj posljednjeg `THERMOSTAT_SYNC` mastera
+    bool     th_seq_valid;
+    uint8_t  th_tx_seq;     ///< Redni broj vlastitih `THERMOSTAT_SYNC` okvira
+    bool     th_req;        ///< Čeka ključni okvir; zahtjev se ponavlja
+    uint64_t th_req_ns;     ///< Trenutak sljedećeg zahtjeva
+} BusNode_t;
+
+/**
+ * @brief Posljednji zahtjev kontrolera koji čeka odgovor čvora.
+ */
+typedef struct
+{
+    bool     active;
+    bool     answered;
+    uint8_t  id;
+    uint8_t  type;
+    uint16_t len;
+    uint8_t  data[BUS_SIM_PENDING_DATA];
+    uint64_t start_ns;
+} BusPending_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static BusSim_Config_t cfg;
+static uint64_t byte_ns;                    ///< Trajanje jednog bajta na busu
+static uint32_t rng;                        ///< Stanje xorshift32 generatora
+static BusTx_t tx[BUS_SIM_MAX_TX];
+static BusNode_t nodes[BUS_SIM_MAX_NODES];
+static int node_count;
+static BusParser_t ctrl_sniffer;            ///< Prati okvire kontrolera u trenutku slanja
+static uint64_t ctrl_end_ns;                ///< Kraj zadnjeg bajta koji je kontroler poslao
+static uint64_t busy_mark_ns;               ///< Do kada je zauzetost već uračunata
+static BusPending_t pending;
+static BusSim_Stats_t stats;
+static BusSim_TypeStats_t type_stats[256];
+static int pty_fd = -1;
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE - POMOCNE                                                */
+/*============================================================================*/
+static uint32_t BusSim_Rand(void)
+{
+    uint32_t x = rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng = x;
+    return x;
+}
+
+static bool BusSim_Chance(uint32_t ppm)
+{
+    return (ppm != 0U) && ((BusSim_Rand() % BUS_SIM_PPM) < ppm);
+}
+
+static uint64_t BusSim_Now(void)
+{
+    return (uint64_t)HAL_GetTick() * BUS_SIM_NS_PER_MS;
+}
+
+/**
+ * @brief CRC-16/ARC kao `TF_CKSUM_CRC16` (polinom 0xA001 reflektovan, početna 0).
+ */
+static uint16_t BusSim_Crc16(const uint8_t* p, uint32_t n)
+{
+    uint16_t crc = 0U;
+
+    while (n--)
+    {
+        crc ^= *p++;
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0xA001U) : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t BusSim_Compose(uint8_t* out, uint8_t id, uint8_t type, const uint8_t* data, uint16_t len)
+{
+    uint16_t pos = 0U;
+    uint16_t ck;
+
+    out[pos++] = TF_SOF_BYTE;
+    out[pos++] = id;
+    out[pos++] = (uint8_t)(len >> 8);
+    out[pos++] = (uint8_t)len;
+    out[pos++] = type;
+    ck = BusSim_Crc16(out, pos);
+    out[pos++] = (uint8_t)(ck >> 8);
+    out[pos++] = (uint8_t)ck;
+    if (len != 0U)
+    {
+        memcpy(&out[pos], data, len);
+        pos += len;
+        ck = BusSim_Crc16(data, len);
+        out[pos++] = (uint8_t)(ck >> 8);
+        out[pos++] = (uint8_t)ck;
+    }
+    return pos;
+}
+
+/**
+ * @brief Predaje jedan bajt parseru.
+ * @retval 1 = okvir kompletan u `f`, 0 = okvir u toku, -1 = greška checksum-a.
+ */
+static int BusSim_ParserAccept(BusParser_t* p, uint8_t b, uint64_t t_ns, BusFrame_t* f)
+{
+    uint16_t len;
+
+    if ((p->pos != 0U) && ((t_ns - p->last_ns) >= BUS_SIM_PARSER_TIMEOUT_NS))
+    {
+        p->pos = 0U; // kao `TF_PARSER_TIMEOUT_TICKS` u TinyFrame
+    }
+    p->last_ns = t_ns;
+
+    if (p->pos == 0U)
+    {
+        if (b != TF_SOF_BYTE) return 0;
+        p->start_ns = t_ns;
+        p->need = BUS_SIM_HEAD_LEN;
+    }
+    p->buf[p->pos++] = b;
+    if (p->pos < p->need) return 0;
+
+    len = (uint16_t)((p->buf[2] << 8) | p->buf[3]);
+    if (p->pos == BUS_SIM_HEAD_LEN)
+    {
+        if (BusSim_Crc16(p->buf, BUS_SIM_HEAD_LEN - BUS_SIM_CKSUM_LEN) != (uint16_t)((p->buf[5] << 8) | p->buf[6]) ||
+            ((uint32_t)len + BUS_SIM_HEAD_LEN + BUS_SIM_CKSUM_LEN) > BUS_SIM_MAX_FRAME)
+        {
+            p->pos = 0U;
+            return -1;
+        }
+        if (len != 0U)
+        {
+            p->need = (uint16_t)(BUS_SIM_HEAD_LEN + len + BUS_SIM_CKSUM_LEN);
+            return 0;
+        }
+    }
+    else if (BusSim_Crc16(&p->buf[BUS_SIM_HEAD_LEN], len) !=
+             (uint16_t)((p->buf[BUS_SIM_HEAD_LEN + len] << 8) | p->buf[BUS_SIM_HEAD_LEN + len + 1U]))
+    {
+        p->pos = 0U;
+        return -1;
+    }
+
+    f->id = p->buf[1];
+    f->type = p->buf[4];
+    f->len = len;
+    f->data = &p->buf[BUS_SIM_HEAD_LEN];
+    f->start_ns = p->start_ns;
+    p->pos = 0U;
+    return 1;
+}
+
+static uint64_t BusSim_TxEnd(const BusTx_t* t)
+{
+    return t->start_ns + ((uint64_t)t->len * byte_ns);
+}
+
+static void BusSim_MarkCollision(BusTx_t* t, uint64_t from_ns, uint64_t to_ns)
+{
+    if (t->col_end_ns == 0U)
+    {
+        stats.collisions++;
+        t->col_start_ns = from_ns;
+        t->col_end_ns = to_ns;
+        return;
+    }
+    if (from_ns < t->col_start_ns) t->col_start_ns = from_ns;
+    if (to_ns > t->col_end_ns) t->col_end_ns = to_ns;
+}
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE - PRENOS NA BUSU                                         */
+/*============================================================================*/
+static BusTx_t* BusSim_Schedule(int src, const uint8_t* data, uint16_t len, uint64_t start_ns, bool reply, uint8_t id);
+
+/**
+ * @brief Sa vjerovatnoćom `noise_ppm` ubacuje kratak strani prenos
+ * na slučajnom mjestu unutar prenosa `t`.
+ */
+static void BusSim_MaybeNoise(const BusTx_t* t)
+{
+    uint8_t burst[BUS_SIM_NOISE_MAX_BYTES];
+    uint16_t len;
+    uint64_t offset;
+
+    if (!BusSim_Chance(cfg.noise_ppm)) return;
+
+    len = (uint16_t)(1U + (BusSim_Rand() % BUS_SIM_NOISE_MAX_BYTES));
+    for (uint16_t i = 0U; i < len; i++) burst[i] = (uint8_t)BusSim_Rand();
+    offset = (uint64_t)(BusSim_Rand() % (uint32_t)(t->len * byte_ns));
+    if (BusSim_Schedule(BUS_SIM_SRC_NOISE, burst, len, t->start_ns + offset, false, 0U) != NULL)
+    {
+        stats.noise_bursts++;
+    }
+}
+
+/**
+ * @brief Dodaje prenos na bus i označava kolizije sa prenosima u toku.
+ * @retval Prenos ili NULL ako je tabela prenosa puna.
+ */
+static BusTx_t* BusSim_Schedule(int src, const uint8_t* data, uint16_t len, uint64_t start_ns, bool reply, uint8_t id)
+{
+    BusTx_t* t = NULL;
+    uint64_t end_ns;
+
+    for (uint32_t i = 0U; i < BUS_SIM_MAX_TX; i++)
+    {
+        if (!tx[i].used)
+        {
+            t = &tx[i];
+            break;
+        }
+    }
+    if ((t == NULL) || (len == 0U)) return NULL;
+
+    memset(t, 0, sizeof(*t));
+    t->used = true;
+    t->src = src;
+    t->reply = reply;
+    t->id = id;
+    t->len = (len > BUS_SIM_MAX_FRAME) ? (uint16_t)BUS_SIM_MAX_FRAME : len;
+    t->start_ns = start_ns;
+    memcpy(t->data, data, t->len);
+    end_ns = BusSim_TxEnd(t);
+
+    for (uint32_t i = 0U; i < BUS_SIM_MAX_TX; i++)
+    {
+        BusTx_t* o = &tx[i];
+        uint64_t o_end;
+
+        if (!o->used || (o == t)) continue;
+        o_end = BusSim_TxEnd(o);
+        if ((o->start_ns < end_ns) && (start_ns < o_end))
+        {
+            uint64_t from_ns = (o->start_ns > start_ns) ? o->start_ns : start_ns;
+            uint64_t to_ns = (o_end < end_ns) ? o_end : end_ns;
+            BusSim_MarkCollision(t, from_ns, to_ns);
+            BusSim_MarkCollision(o, from_ns, to_ns);
+        }
+    }
+
+    if (src != BUS_SIM_SRC_NOISE) BusSim_MaybeNoise(t);
+    return t;
+}
+
+/**
+ * @brief Okvir koji je kontroler poslao; prati ponavljanja i zahtjeve bez odgovora.
+ */
+static void BusSim_CtrlFrame(const BusFrame_t* f)
+{
+    BusSim_TypeStats_t* ts = &type_stats[f->type];
+
+    if ((f->id & BUS_SIM_ID_PEERBIT) == 0U)
+    {
+        stats.ctrl_responses++;
+        return;
+    }
+    stats.ctrl_frames++;
+
+    // Sinhronizacija grupe je broadcast bez odgovora i ne zatvara zahtjev
+    if (f->type == THERMOSTAT_SYNC)
+    {
+        ts->sent++;
+        return;
+    }
+
+    if (pending.active && !pending.answered)
+    {
+        type_stats[pending.type].unanswered++;
+        if ((pending.type == f->type) && (pending.len == f->len) &&
+            (memcmp(pending.data, f->data, (f->len < BUS_SIM_PENDING_DATA) ? f->len : BUS_SIM_PENDING_DATA) == 0))
+        {
+            ts->retries++;
+        }
+    }
+
+    pending.active = true;
+    pending.answered = false;
+    pending.id = f->id;
+    pending.type = f->type;
+    pending.len = f->len;
+    memcpy(pending.data, f->data, (f->len < BUS_SIM_PENDING_DATA) ? f->len : BUS_SIM_PENDING_DATA);
+    pending.start_ns = f->start_ns;
+    ts->sent++;
+}
+
+/**
+ * @brief Prenos je završen; uračunava vrijeme na busu po tipu okvira, a
+ * neoštećen odgovor čvora zatvara zahtjev kontrolera.
+ */
+static void BusSim_TxDone(const BusTx_t* t)
+{
+    BusSim_TypeStats_t* ts;
+    uint32_t lat;
+
+    if ((t->src != BUS_SIM_SRC_NOISE) && (t->src != BUS_SIM_SRC_PTY) && (t->len >= BUS_SIM_HEAD_LEN) &&
+        (t->data[0] == TF_SOF_BYTE))
+    {
+        ts = &type_stats[t->data[4]];
+        ts->frames++;
+        ts->bytes += t->len;
+        ts->airtime_ns += (uint64_t)t->len * byte_ns;
+    }
+
+    if (!t->reply || t->damaged || !pending.active || pending.answered || (t->id != pending.id)) return;
+
+    pending.answered = true;
+    ts = &type_stats[pending.type];
+    lat = (uint32_t)(BusSim_TxEnd(t) - pending.start_ns);
+    ts->answered++;
+    ts->latency_sum_ns += lat;
+    if ((ts->answered == 1U) || (lat < ts->latency_min_ns)) ts->latency_min_ns = lat;
+    if (lat > ts->latency_max_ns) ts->latency_max_ns = lat;
+}
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE - MODELI CVOROVA                                         */
+/*============================================================================*/
+/**
+ * @brief Odgovor čvora na zahtjev mastera, prema `LUX protokoli`.
+ * @retval Dužina podataka odgovora, 0 ako čvor ne odgovara.
+ */
+static uint16_t BusSim_NodeAnswer(BusNode_t* n, const BusFrame_t* f, uint8_t* out)
+{
+    BusSim_Node_t* p = &n->pub;
+    uint16_t addr = (f->len >= 2U) ? (uint16_t)((f->data[0] << 8) | f->data[1]) : 0U;
+    uint16_t idx = (uint16_t)(addr - p->first_addr);
+    bool in_range = (f->len >= 2U) && (addr >= p->first_addr) && (idx < p->count);
+
+    if (p->kind == BUS_NODE_THERMOSTAT)
+    {
+        uint16_t len;
+
+        // Info mastera za ovu grupu: potvrda sa ACK na poziciji koju čeka SendCommand
+        if ((f->type != THERMOSTAT_INFO) || (f->len < 1U) || (f->data[0] != (uint8_t)p->first_addr)) return 0U;
+        len = (f->len < BUS_SIM_THERMO_ACK_POS) ? f->len : (uint16_t)BUS_SIM_THERMO_ACK_POS;
+        memset(out, 0, BUS_SIM_THERMO_ACK_POS);
+        memcpy(out, f->data, len);
+        out[BUS_SIM_THERMO_ACK_POS] = ACK;
+        return BUS_SIM_THERMO_ACK_POS + 1U;
+    }
+    if (!in_range) return 0U;
+
+    out[0] = f->data[0];
+    out[1] = f->data[1];
+    switch (p->kind)
+    {
+    case BUS_NODE_RELAY:
+        if ((f->type == BINARY_SET) && (f->len >= 3U))
+        {
+            p->state[idx] = f->data[2];
+            out[2] = p->state[idx];
+            out[3] = ACK;
+            return 4U;
+        }
+        if (f->type == BINARY_GET)
+        {
+            out[2] = p->state[idx];
+            return 3U;
+        }
+        if (f->type == BINARY_RESET)
+        {
+            out[2] = ACK;
+            return 3U;
+        }
+        break;
+
+    case BUS_NODE_DIMMER:
+        if ((f->type == DIMMER_SET) && (f->len >= 3U))
+        {
+            p->state[idx] = (f->data[2] > 100U) ? 100U : f->data[2];
+            out[2] = p->state[idx];
+            out[3] = ACK;
+            return 4U;
+        }
+        if (f->type == DIMMER_GET)
+        {
+            out[2] = p->state[idx];
+            out[3] = BUS_SIM_DIMMER_RAMP;
+            out[4] = BUS_SIM_DIMMER_TEMP;
+            out[5] = BUS_SIM_DIMMER_TEMP_LIMIT;
+            out[6] = (uint8_t)(BUS_SIM_DIMMER_SCALE_MAX >> 8);
+            out[7] = (uint8_t)BUS_SIM_DIMMER_SCALE_MAX;
+            out[8] = (uint8_t)(BUS_SIM_DIMMER_SCALE_MIN >> 8);
+            out[9] = (uint8_t)BUS_SIM_DIMMER_SCALE_MIN;
+            out[10] = BUS_SIM_DIMMER_RUNNING;
+            return 11U;
+        }
+        break;
+
+    case BUS_NODE_CURTAIN:
+        if ((f->type == JALOUSIE_SET) && (f->len >= 3U))
+        {
+            p->state[idx] = (f->data[2] > 2U) ? 0U : f->data[2];
+            out[2] = p->state[idx];
+            out[3] = ACK;
+            return 4U;
+        }
+        if (f->type == JALOUSIE_GET)
+        {
+            out[2] = p->state[idx];
+            out[3] = BUS_SIM_CURTAIN_TIMER;
+            return 4U;
+        }
+        break;
+
+    case BUS_NODE_DIN:
+        if (f->type == DIN_GET)
+        {
+            out[2] = p->state[idx];
+            return 3U;
+        }
+        break;
+
+    default:
+        break;
+    }
+    return 0U;
+}
+
+/**
+ * @brief Priprema spontanu poruku čvora u slučajnom trenutku tekuće milisekunde.
+ * @retval false ako prethodna poruka još čeka.
+ */
+static bool BusSim_QueueEvent(BusNode_t* n, uint8_t type, const uint8_t* data, uint16_t len)
+{
+    uint8_t id;
+
+    if (n->ev_pending) return false;
+    id = (uint8_t)(n->next_id++ & BUS_SIM_ID_MASK);
+    n->ev_len = BusSim_Compose(n->ev_frame, id, type, data, len);
+    n->ev_start_ns = BusSim_Now() + (BusSim_Rand() % BUS_SIM_NS_PER_MS);
+    n->ev_pending = true;
+    return true;
+}
+
+/**
+ * @brief `THERMOSTAT_SYNC` okvir slave uređaja: prazan je zahtjev za ključni
+ * okvir, a `setpoint` != 0 korisnička promjena zadate temperature.
+ */
+static bool BusSim_ThermoSync(BusNode_t* n, uint8_t setpoint)
+{
+    uint8_t data[THST_SYNC_HEADER_LEN + 1U];
+    uint16_t len = THST_SYNC_HEADER_LEN;
+
+    data[THST_SYNC_POS_GROUP] = (uint8_t)n->pub.first_addr;
+    data[THST_SYNC_POS_SEQ] = n->th_tx_seq;
+    data[THST_SYNC_POS_FLAGS] = 0U;
+    if (setpoint != 0U)
+    {
+        data[THST_SYNC_POS_FLAGS] = THST_SYNC_F_SETPOINT;
+        data[len++] = setpoint;
+    }
+    if (!BusSim_QueueEvent(n, THERMOSTAT_SYNC, data, len)) return false;
+    n->th_tx_seq++;
+    if (setpoint == 0U) n->pub.th_requests++;
+    return true;
+}
+
+/**
+ * @brief Zahtjev za ključni okvir nakon slučajnog odmaka, da se čvorovi koji
+ * su uočili isti izgubljen okvir ne sudare.
+ */
+static void BusSim_ThermoRequest(BusNode_t* n, uint64_t now_ns)
+{
+    if (n->th_req) return;
+    n->th_req = true;
+    n->th_req_ns = now_ns + ((uint64_t)(BusSim_Rand() % BUS_SIM_THERMO_REQ_JITTER_US) * BUS_SIM_NS_PER_US);
+}
+
+/**
+ * @brief Stanje grupe za termostat čvor: odgovor kontrolera na vlastiti
+ * `THERMOSTAT_INFO` (stari uređaj) ili `THERMOSTAT_SYNC` mastera.
+ */
+static void BusSim_ThermoFrame(BusNode_t* n, int src, const BusFrame_t* f, uint64_t end_ns)
+{
+    BusSim_Node_t* p = &n->pub;
+    const uint8_t* d = f->data;
+    uint16_t need = THST_SYNC_HEADER_LEN;
+    uint16_t pos = THST_SYNC_HEADER_LEN;
+    uint8_t flags;
+
+    if ((src != BUS_SIM_SRC_CTRL) || (f->len < 3U) || (d[0] != (uint8_t)p->first_addr)) return;
+
+    if (!p->sync)
+    {
+        // Odgovor mastera: grupa, uloga, mod, stanje, temperatura (2), zadata...
+        if ((f->type == THERMOSTAT_INFO) && ((f->id & BUS_SIM_ID_PEERBIT) == 0U) && n->wait &&
+            (f->id == n->wait_id) && (f->len >= BUS_SIM_THERMO_INFO_LEN))
+        {
+            p->th_mode = d[2];
+            p->th_temp = (int16_t)((d[4] << 8) | d[5]);
+            p->th_setpoint = d[6];
+            p->th_valid = true;
+        }
+        return;
+    }
+
+    flags = d[THST_SYNC_POS_FLAGS];
+    if ((f->type != THERMOSTAT_SYNC) || !(flags & THST_SYNC_F_MASTER)) return;
+    if (flags & THST_SYNC_F_TEMP)     need += 2U;
+    if (flags & THST_SYNC_F_SETPOINT) need += 1U;
+    if (flags & THST_SYNC_F_MODE)     need += 1U;
+    if (flags & THST_SYNC_F_FAN)      need += 1U;
+    if (flags & THST_SYNC_F_STATE)    need += 1U;
+    if (flags & THST_SYNC_F_LIMITS)   need += 3U;
+    if (f->len < need) return;
+
+    if (!(flags & THST_SYNC_F_KEY))
+    {
+        if (n->th_seq_valid && (d[THST_SYNC_POS_SEQ] == n->th_seq)) return; // Ponovljen okvir
+        if (n->th_seq_valid && (d[THST_SYNC_POS_SEQ] != (uint8_t)(n->th_seq + 1U)))
+        {
+            p->th_lost += (uint8_t)(d[THST_SYNC_POS_SEQ] - n->th_seq - 1U);
+            BusSim_ThermoRequest(n, end_ns);
+        }
+        else if (!p->th_valid)
+        {
+            BusSim_ThermoRequest(n, end_ns); // Delta bez početnog stanja
+        }
+    }
+    n->th_seq = d[THST_SYNC_POS_SEQ];
+    n->th_seq_valid = true;
+
+    if (flags & THST_SYNC_F_TEMP)
+    {
+        p->th_temp = (int16_t)((d[pos] << 8) | d[pos + 1U]);
+        pos += 2U;
+    }
+    if (flags & THST_SYNC_F_SETPOINT) p->th_setpoint = d[pos++];
+    if (flags & THST_SYNC_F_MODE)     p->th_mode = d[pos];
+    if (flags & THST_SYNC_F_KEY)
+    {
+        p->th_valid = true;
+        n->th_req = false;
+    }
+}
+
+/**
+ * @brief Neoštećen okvir koji je čvor primio sa busa.
+ */
+static void BusSim_NodeFrame(int index, int src, const BusFrame_t* f, uint64_t end_ns)
+{
+    BusNode_t* n = &nodes[index];
+    uint8_t data[BUS_SIM_REPLY_MAX];
+    uint8_t frame[BUS_SIM_HEAD_LEN + BUS_SIM_REPLY_MAX + BUS_SIM_CKSUM_LEN];
+    uint16_t len;
+    uint64_t delay_ns;
+
+    n->pub.rx_frames++;
+    if (n->pub.kind == BUS_NODE_THERMOSTAT) BusSim_ThermoFrame(n, src, f, end_ns);
+
+    // Okvir bez master bita je odgovor kontrolera ili poruka drugog čvora
+    if ((f->id & BUS_SIM_ID_PEERBIT) == 0U)
+    {
+        if (n->wait && (src == BUS_SIM_SRC_CTRL) && (f->id == n->wait_id))
+        {
+            uint32_t lat = (uint32_t)(end_ns - n->wait_start_ns);
+            n->wait = false;
+            stats.node_requests_answered++;
+            stats.node_latency_sum_ns += lat;
+            if (lat > stats.node_latency_max_ns) stats.node_latency_max_ns = lat;
+        }
+        return;
+    }
+
+    len = BusSim_NodeAnswer(n, f, data);
+    if (len == 0U) return;
+
+    delay_ns = (uint64_t)n->pub.latency_us * BUS_SIM_NS_PER_US;
+    if (n->pub.jitter_us != 0U) delay_ns += (uint64_t)(BusSim_Rand() % (n->pub.jitter_us + 1U)) * BUS_SIM_NS_PER_US;
+
+    len = BusSim_Compose(frame, f->id, f->type, data, len);
+    if (BusSim_Schedule(index, frame, len, end_ns + delay_ns, true, f->id) != NULL)
+    {
+        n->pub.replies++;
+        stats.node_frames++;
+    }
+}
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE - ISPORUKA I PSEUDO-TERMINAL                             */
+/*============================================================================*/
+static void BusSim_PtyWrite(uint8_t b)
+{
+    if (pty_fd < 0) return;
+    // Bez čitaoca na slave strani bafer se napuni, višak se odbacuje
+    if (write(pty_fd, &b, 1) < 0) { }
+}
+
+static void BusSim_PtyPoll(uint64_t now_ns)
+{
+    uint8_t buf[BUS_SIM_PTY_CHUNK];
+    ssize_t n;
+
+    if (pty_fd < 0) return;
+    n = read(pty_fd, buf, sizeof(buf));
+    if (n <= 0) return;
+    if (BusSim_Schedule(BUS_SIM_SRC_PTY, buf, (uint16_t)n, now_ns, false, 0U) != NULL)
+    {
+        stats.pty_bytes += (uint32_t)n;
+    }
+}
+
+/**
+ * @brief Predaje sljedeći bajt prenosa `t`, koji je na busu završio u `end_ns`.
+ */
+static void BusSim_DeliverByte(BusTx_t* t, uint64_t end_ns)
+{
+    uint64_t start_ns = end_ns - byte_ns;
+    uint8_t b = t->data[t->done++];
+    BusFrame_t f;
+
+    stats.busy_ns += end_ns - ((start_ns > busy_mark_ns) ? start_ns : busy_mark_ns);
+    busy_mark_ns = end_ns;
+
+    if (BusSim_Chance(cfg.loss_ppm))
+    {
+        stats.bytes_lost++;
+        t->damaged = true;
+        return;
+    }
+    if ((t->col_end_ns != 0U) && (start_ns < t->col_end_ns) && (t->col_start_ns < end_ns))
+    {
+        b ^= (uint8_t)(1U + (BusSim_Rand() % 255U));
+        stats.bytes_corrupted++;
+        t->damaged = true;
+    }
+
+    BusSim_PtyWrite(b);
+    if (t->src != BUS_SIM_SRC_CTRL) HostShim_UartRx(&b, 1U);
+    for (int i = 0; i < node_count; i++)
+    {
+        int r;
+
+        if (i == t->src) continue;
+        r = BusSim_ParserAccept(&nodes[i].parser, b, end_ns, &f);
+        if (r > 0) BusSim_NodeFrame(i, t->src, &f, end_ns);
+        else if (r < 0) stats.crc_errors++;
+    }
+}
+
+/**
+ * @brief Predaje hronološki sve bajtove koji su do `now_ns` preneseni.
+ * @note  Odgovori koje prijem pokrene (kontroler preko `TF_Respond` ili
+ * čvor) dodaju nove prenose, pa se tabela pretražuje iznova za svaki bajt.
+ */
+static void BusSim_Deliver(uint64_t now_ns)
+{
+    for (;;)
+    {
+        BusTx_t* next = NULL;
+        uint64_t next_end = UINT64_MAX;
+
+        for (uint32_t i = 0U; i < BUS_SIM_MAX_TX; i++)
+        {
+            BusTx_t* t = &tx[i];
+            uint64_t e;
+
+            if (!t->used) continue;
+            e = t->start_ns + ((uint64_t)(t->done + 1U) * byte_ns);
+            if ((e <= now_ns) && (e < next_end))
+            {
+                next = t;
+                next_end = e;
+            }
+        }
+        if (next == NULL) break;
+
+        BusSim_DeliverByte(next, next_end);
+        if (next->done == next->len)
+        {
+            BusSim_TxDone(next);
+            next->used = false;
+        }
+    }
+}
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE - HOOK-OVI HOST SHIM-A                                   */
+/*============================================================================*/
+/**
+ * @brief Šalje spontane poruke čvorova čiji je trenutak do `now_ns` došao.
+ * @note  Do tada su poznati svi prenosi koji počinju prije tog trenutka,
+ * pa čvor može provjeriti da li je bus slobodan (osluškivanje nosioca).
+ */
+static void BusSim_NodeEvents(uint64_t now_ns)
+{
+    for (int i = 0; i < node_count; i++)
+    {
+        BusNode_t* n = &nodes[i];
+        uint64_t start_ns;
+        bool busy = true;
+
+        if (n->th_req && (n->th_req_ns <= now_ns) && BusSim_ThermoSync(n, 0U))
+        {
+            n->th_req_ns = now_ns + ((uint64_t)THST_SYNC_REQUEST_RETRY_MS * BUS_SIM_NS_PER_MS);
+        }
+        if (!n->ev_pending || (n->ev_start_ns > now_ns)) continue;
+
+        start_ns = n->ev_start_ns;
+        while (busy)
+        {
+            busy = false;
+            for (uint32_t k = 0U; k < BUS_SIM_MAX_TX; k++)
+            {
+                if (tx[k].used && (tx[k].start_ns <= start_ns) && (start_ns < BusSim_TxEnd(&tx[k])))
+                {
+                    start_ns = BusSim_TxEnd(&tx[k]) +
+                               ((uint64_t)(BusSim_Rand() % (BUS_SIM_LBT_BACKOFF_BYTES + 1U)) * byte_ns);
+                    busy = true;
+                }
+            }
+        }
+        if (BusSim_Schedule(i, n->ev_frame, n->ev_len, start_ns, false, n->ev_frame[1]) == NULL) continue;
+
+        n->ev_pending = false;
+        n->pub.events++;
+        stats.node_frames++;
+        if (n->ev_frame[4] == THERMOSTAT_INFO)
+        {
+            n->wait = true;
+            n->wait_id = n->ev_frame[1];
+            n->wait_start_ns = start_ns;
+            stats.node_requests++;
+        }
+    }
+}
+
+/**
+ * @brief Bajtovi iz `TF_WriteImpl`; kontroler šalje čim je njegov UART slobodan.
+ */
+static void BusSim_TxHook(const uint8_t* data, uint16_t len)
+{
+    uint64_t start_ns = BusSim_Now();
+    BusFrame_t f;
+
+    if (ctrl_end_ns > start_ns) start_ns = ctrl_end_ns;
+    while (len != 0U)
+    {
+        uint16_t chunk = (len > BUS_SIM_MAX_FRAME) ? (uint16_t)BUS_SIM_MAX_FRAME : len;
+
+        (void)BusSim_Schedule(BUS_SIM_SRC_CTRL, data, chunk, start_ns, false, 0U);
+        for (uint16_t i = 0U; i < chunk; i++)
+        {
+            if (BusSim_ParserAccept(&ctrl_sniffer, data[i], start_ns + ((uint64_t)i * byte_ns), &f) > 0)
+            {
+                BusSim_CtrlFrame(&f);
+            }
+        }
+        start_ns += (uint64_t)chunk * byte_ns;
+        data += chunk;
+        len = (uint16_t)(len - chunk);
+    }
+    ctrl_end_ns = start_ns;
+}
+
+static void BusSim_TickHook(uint32_t tick)
+{
+    uint64_t now_ns = (uint64_t)tick * BUS_SIM_NS_PER_MS;
+
+    BusSim_PtyPoll(now_ns);
+    BusSim_NodeEvents(now_ns);
+    BusSim_Deliver(now_ns);
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Briše bus i čvorove i kači simulator na host shim.
+ * @note  Poziva se nakon `HostShim_Init`. `cfg` može biti NULL.
+ */
+void BusSim_Init(const BusSim_Config_t* config)
+{
+    BusSim_ClosePty();
+    memset(&cfg, 0, sizeof(cfg));
+    if (config != NULL) cfg = *config;
+    if (cfg.baud == 0U) cfg.baud = BUS_SIM_DEFAULT_BAUD;
+
+    byte_ns = ((uint64_t)BUS_SIM_BITS_PER_BYTE * 1000000000ULL) / cfg.baud;
+    rng = (cfg.seed != 0U) ? cfg.seed : 1U;
+    memset(tx, 0, sizeof(tx));
+    memset(nodes, 0, sizeof(nodes));
+    memset(&ctrl_sniffer, 0, sizeof(ctrl_sniffer));
+    memset(&pending, 0, sizeof(pending));
+    node_count = 0;
+    ctrl_end_ns = 0U;
+    busy_mark_ns = 0U;
+    BusSim_ResetStats();
+
+    HostShim_SetTxHook(BusSim_TxHook);
+    HostShim_SetTickHook(BusSim_TickHook);
+}
+
+/**
+ * @brief Dodaje čvor koji odgovara na `count` adresa od `first_addr`.
+ * @note  Za termostat je `first_addr` grupa (`th_id`), a `count` se ignoriše.
+ * @retval Indeks čvora ili -1 ako nema mjesta.
+ */
+int BusSim_AddNode(BusSim_NodeKind_e kind, uint16_t first_addr, uint16_t count, uint32_t latency_us, uint32_t jitter_us)
+{
+    BusNode_t* n;
+
+    if (node_count >= (int)BUS_SIM_MAX_NODES) return -1;
+
+    n = &nodes[node_count];
+    memset(n, 0, sizeof(*n));
+    n->pub.kind = kind;
+    n->pub.first_addr = first_addr;
+    n->pub.count = (kind == BUS_NODE_THERMOSTAT) ? 1U : ((count > BUS_SIM_MAX_NODE_ADDR) ? (uint16_t)BUS_SIM_MAX_NODE_ADDR : count);
+    n->pub.latency_us = latency_us;
+    n->pub.jitter_us = jitter_us;
+    if (kind == BUS_NODE_RELAY) memset(n->pub.state, BINARY_OFF, sizeof(n->pub.state));
+    n->next_id = (uint8_t)node_count; // različit početni ID po čvoru
+
+    return node_count++;
+}
+
+/**
+ * @brief Termostat čvor prati grupu preko `THERMOSTAT_SYNC` (novi uređaj)
+ * umjesto preko odgovora na vlastiti `THERMOSTAT_INFO`.
+ */
+void BusSim_SetNodeSync(int node, bool sync)
+{
+    if ((node < 0) || (node >= node_count)) return;
+    nodes[node].pub.sync = sync;
+}
+
+/**
+ * @brief Otvara pseudo-terminal na koji se preslikava sav saobraćaj busa.
+ * @note  Bajtovi upisani na slave stranu (`name`) idu na bus u sljedećoj
+ * simuliranoj milisekundi, kao od još jednog uređaja. Pokretanje sa
+ * otvorenim terminalom nije ponovljivo, jer zavisi od stvarnog vremena.
+ */
+bool BusSim_OpenPty(char* name, size_t size)
+{
+    struct termios tio;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (fd < 0) return false;
+    if ((grantpt(fd) != 0) || (unlockpt(fd) != 0) || (ptsname_r(fd, name, size) != 0))
+    {
+        close(fd);
+        return false;
+    }
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        (void)tcsetattr(fd, TCSANOW, &tio);
+    }
+    (void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    BusSim_ClosePty();
+    pty_fd = fd;
+    return true;
+}
+
+void BusSim_ClosePty(void)
+{
+    if (pty_fd >= 0) close(pty_fd);
+    pty_fd = -1;
+}
+
+/**
+ * @brief Spontana poruka čvora (lokalna promjena stanja), u trenutnom
+ * simuliranom vremenu.
+ * @note  Relej, dimer i žaluzine javljaju novo stanje na svom SET kanalu,
+ * ulazi šalju DIN_EVENT, a termostat THERMOSTAT_INFO svoje grupe
+ * (`value` = 0 je prazan info, zahtjev za sinhronizaciju) na koji
+ * kontroler kao master termostat odgovara. Termostat sa `sync` umjesto
+ * toga šalje THERMOSTAT_SYNC: prazan zahtjev za ključni okvir ili, za
+ * `value` != 0, novu zadatu temperaturu. Poruka kreće u slučajnom
+ * trenutku tekuće milisekunde, kada bus bude slobodan.
+ * @retval false ako adresa ne pripada čvoru ili prethodna poruka još čeka.
+ */
+bool BusSim_NodeEvent(int node, uint16_t addr, uint8_t value)
+{
+    BusNode_t* n;
+    BusSim_Node_t* p;
+    uint8_t data[BUS_SIM_THERMO_INFO_LEN] = {0};
+    uint8_t type;
+    uint16_t len = 3U;
+    uint16_t idx;
+
+    if ((node < 0) || (node >= node_count)) return false;
+    n = &nodes[node];
+    p = &n->pub;
+    idx = (uint16_t)(addr - p->first_addr);
+    if (n->ev_pending) return false;
+    if ((p->kind != BUS_NODE_THERMOSTAT) && ((addr < p->first_addr) || (idx >= p->count))) return false;
+    if ((p->kind == BUS_NODE_THERMOSTAT) && p->sync) return BusSim_ThermoSync(n, value);
+
+    data[0] = (uint8_t)(addr >> 8);
+    data[1] = (uint8_t)addr;
+    data[2] = value;
+    switch (p->kind)
+    {
+    case BUS_NODE_RELAY:
+        type = BINARY_SET;
+        data[3] = ACK;
+        len = 4U;
+        break;
+    case BUS_NODE_DIMMER:
+        type = DIMMER_SET;
+        data[3] = ACK;
+        len = 4U;
+        break;
+    case BUS_NODE_CURTAIN:
+        type = JALOUSIE_SET;
+        break;
+    case BUS_NODE_DIN:
+        type = DIN_EVENT;
+        break;
+    case BUS_NODE_THERMOSTAT:
+    default:
+        type = THERMOSTAT_INFO;
+        memset(data, 0, sizeof(data));
+        data[0] = (uint8_t)p->first_addr;
+        if (value != 0U)
+        {
+            data[2] = value;    // th_ctrl
+            data[4] = (uint8_t)((uint16_t)BUS_SIM_THERMO_MV_TEMP >> 8);
+            data[5] = (uint8_t)BUS_SIM_THERMO_MV_TEMP;
+            data[6] = BUS_SIM_THERMO_SP_TEMP;
+        }
+        len = BUS_SIM_THERMO_INFO_LEN;
+        idx = 0U;
+        break;
+    }
+    if (p->kind != BUS_NODE_THERMOSTAT) p->state[idx] = value;
+
+    return BusSim_QueueEvent(n, type, data, len);
+}
+
+const BusSim_Stats_t* BusSim_GetStats(void)
+{
+    return &stats;
+}
+
+const BusSim_TypeStats_t* BusSim_GetTypeStats(uint8_t type)
+{
+    return &type_stats[type];
+}
+
+const BusSim_Node_t* BusSim_GetNode(int node)
+{
+    return ((node >= 0) && (node < node_count)) ? &nodes[node].pub : NULL;
+}
+
+int BusSim_GetNodeCount(void)
+{
+    return node_count;
+}
+
+/**
+ * @brief Briše statistiku busa, tipova i brojače čvorova (stanje čvorova ostaje).
+ */
+void BusSim_ResetStats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    memset(type_stats, 0, sizeof(type_stats));
+    for (int i = 0; i < node_count; i++)
+    {
+        nodes[i].pub.rx_frames = 0U;
+        nodes[i].pub.replies = 0U;
+        nodes[i].pub.events = 0U;
+        nodes[i].pub.th_lost = 0U;
+        nodes[i].pub.th_requests = 0U;
+    }
+}
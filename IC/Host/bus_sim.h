@@ -0,0 +1,154 @@
+/**
+ ******************************************************************************
+ * @file    bus_sim.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Javni API virtuelnog RS485 busa sa simuliranim LuxNET čvorovima.
+ *
+ * @note    Bus se kači na host shim (`HostShim_SetTxHook` i
+ * `HostShim_SetTickHook`) i radi u istom simuliranom vremenu kao aplikacija.
+ * Svaki bajt zauzima bus 10 bita pri podešenom baudrate-u, a svi prijemnici
+ * (kontroler i čvorovi) ga dobijaju tek kada je cijeli prenesen. Čvorovi
+ * implementiraju komande iz `LUX protokoli` (relej, dimer, žaluzine,
+ * termostat, digitalni ulazi) i odgovaraju sa podešenim kašnjenjem.
+ * Preklapanje dva predajnika oštećuje bajtove oba okvira (kolizija), a
+ * gubitak bajtova i strani šum se biraju vjerovatnoćom iz ponovljivog
+ * generatora slučajnih brojeva, pa je svako pokretanje sa istim `seed`
+ * identično. Opcionalno se cijeli saobraćaj preslikava na pseudo-terminal,
+ * a bajtovi upisani u njega idu na bus kao od još jednog uređaja.
+ ******************************************************************************
+ */
+
+#ifndef __BUS_SIM_H__
+#define __BUS_SIM_H__
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Konfiguracija simulatora
+ *  @{
+ */
+#define BUS_SIM_MAX_NODES               16U     ///< Maksimalan broj simuliranih čvorova
+#define BUS_SIM_MAX_NODE_ADDR           64U     ///< Maksimalan broj adresa (izlaza) po čvoru
+#define BUS_SIM_MAX_TX                  32U     ///< Maksimalan broj prenosa u toku na busu
+#define BUS_SIM_MAX_FRAME               256U    ///< Najduži okvir koji bus prenosi u komadu
+#define BUS_SIM_DEFAULT_BAUD            115200U ///< Isti baudrate kao `MX_USART1_UART_Init`
+/** @} */
+
+/** @name Izvori prenosa na busu (indeks čvora >= 0)
+ *  @{
+ */
+#define BUS_SIM_SRC_CTRL                (-1)    ///< Kontroler (aplikacija)
+#define BUS_SIM_SRC_NOISE               (-2)    ///< Strani šum / nepoznati predajnik
+#define BUS_SIM_SRC_PTY                 (-3)    ///< Bajtovi upisani u pseudo-terminal
+/** @} */
+
+/**
+ * @brief Vrsta simuliranog čvora i komande na koje odgovara.
+ */
+typedef enum
+{
+    BUS_NODE_RELAY = 0,     /**< BINARY_SET / BINARY_GET / BINARY_RESET */
+    BUS_NODE_DIMMER,        /**< DIMMER_SET / DIMMER_GET */
+    BUS_NODE_CURTAIN,       /**< JALOUSIE_SET / JALOUSIE_GET */
+    BUS_NODE_THERMOSTAT,    /**< THERMOSTAT_INFO / THERMOSTAT_SYNC, slave termostat grupe `first_addr` */
+    BUS_NODE_DIN            /**< DIN_GET, šalje DIN_EVENT */
+} BusSim_NodeKind_e;
+
+/**
+ * @brief Parametri busa. Nule daju podrazumijevane vrijednosti.
+ */
+typedef struct
+{
+    uint32_t baud;          /**< Baudrate, 10 bita po bajtu. */
+    uint32_t seed;          /**< Početno stanje generatora slučajnih brojeva. */
+    uint32_t loss_ppm;      /**< Vjerovatnoća gubitka bajta (na milion bajtova). */
+    uint32_t noise_ppm;     /**< Vjerovatnoća stranog šuma preko okvira (na milion okvira). */
+} BusSim_Config_t;
+
+/**
+ * @brief Statistika zahtjeva kontrolera za jedan TF tip.
+ */
+typedef struct
+{
+    uint32_t sent;              /**< Okvira koje je kontroler poslao (uključujući ponavljanja). */
+    uint32_t answered;          /**< Zahtjeva na koje je stigao neoštećen odgovor čvora. */
+    uint32_t unanswered;        /**< Zahtjeva bez odgovora do sljedećeg okvira kontrolera. */
+    uint32_t retries;           /**< Ponovljenih okvira (isti tip i podaci nakon neodgovorenog). */
+    uint64_t latency_sum_ns;    /**< Zbir vremena od početka zahtjeva do kraja odgovora. */
+    uint32_t latency_min_ns;
+    uint32_t latency_max_ns;
+    uint32_t frames;            /**< Svi okviri ovog tipa na busu, od svih predajnika. */
+    uint32_t bytes;             /**< Njihovi bajtovi, sa zaglavljem i checksum-om. */
+    uint64_t airtime_ns;        /**< Njihovo vrijeme na busu. */
+} BusSim_TypeStats_t;
+
+/**
+ * @brief Ukupna statistika busa.
+ */
+typedef struct
+{
+    uint64_t busy_ns;               /**< Vrijeme u kojem je bus bio zauzet. */
+    uint32_t ctrl_frames;           /**< Zahtjeva kontrolera (ID sa master bitom). */
+    uint32_t ctrl_responses;        /**< Odgovora kontrolera na zahtjeve čvorova. */
+    uint32_t node_frames;           /**< Okvira koje su poslali čvorovi. */
+    uint32_t noise_bursts;          /**< Ubačenih prenosa šuma. */
+    uint32_t pty_bytes;             /**< Bajtova primljenih sa pseudo-terminala. */
+    uint32_t collisions;            /**< Prenosa koji su se preklopili sa drugim prenosom. */
+    uint32_t bytes_lost;            /**< Izgubljenih bajtova. */
+    uint32_t bytes_corrupted;       /**< Bajtova oštećenih kolizijom. */
+    uint32_t crc_errors;            /**< Okvira koje su čvorovi odbacili zbog checksum-a. */
+    uint32_t node_requests;         /**< Zahtjeva čvorova koji čekaju odgovor kontrolera. */
+    uint32_t node_requests_answered;/**< Od toga odgovorenih (neoštećen odgovor kontrolera). */
+    uint64_t node_latency_sum_ns;
+    uint32_t node_latency_max_ns;
+} BusSim_Stats_t;
+
+/**
+ * @brief Brojači i stanje jednog simuliranog čvora.
+ */
+typedef struct
+{
+    BusSim_NodeKind_e kind;
+    uint16_t first_addr;        /**< Prva adresa (za termostat: grupa). */
+    uint16_t count;             /**< Broj uzastopnih adresa. */
+    uint32_t latency_us;        /**< Kašnjenje odgovora od kraja zahtjeva. */
+    uint32_t jitter_us;         /**< Slučajni dodatak kašnjenju, 0..jitter_us. */
+    uint32_t rx_frames;         /**< Neoštećenih okvira primljenih sa busa. */
+    uint32_t replies;           /**< Poslanih odgovora. */
+    uint32_t events;            /**< Poslanih spontanih poruka. */
+    uint8_t  state[BUS_SIM_MAX_NODE_ADDR]; /**< Stanje / vrijednost po adresi. */
+
+    bool     sync;              /**< Termostat prati grupu preko `THERMOSTAT_SYNC`, inače preko odgovora na `THERMOSTAT_INFO`. */
+    bool     th_valid;          /**< Termostat ima stanje grupe od mastera. */
+    int16_t  th_temp;           /**< Izmjerena temperatura grupe, desetinke °C. */
+    uint8_t  th_setpoint;       /**< Zadata temperatura grupe, °C. */
+    uint8_t  th_mode;           /**< Mod grupe (th_ctrl). */
+    uint32_t th_lost;           /**< Okvira mastera koji nedostaju u nizu rednih brojeva. */
+    uint32_t th_requests;       /**< Poslanih zahtjeva za ključni okvir. */
+} BusSim_Node_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija i konfiguracija ---
+void BusSim_Init(const BusSim_Config_t* cfg);
+int  BusSim_AddNode(BusSim_NodeKind_e kind, uint16_t first_addr, uint16_t count, uint32_t latency_us, uint32_t jitter_us);
+void BusSim_SetNodeSync(int node, bool sync);
+bool BusSim_OpenPty(char* name, size_t size);
+void BusSim_ClosePty(void);
+
+// --- Grupa 2: Spontane poruke čvorova ---
+bool BusSim_NodeEvent(int node, uint16_t addr, uint8_t value);
+
+// --- Grupa 3: Statistika i stanje ---
+const BusSim_Stats_t* BusSim_GetStats(void);
+const BusSim_TypeStats_t* BusSim_GetTypeStats(uint8_t type);
+const BusSim_Node_t* BusSim_GetNode(int node);
+int  BusSim_GetNodeCount(void);
+void BusSim_ResetStats(void);
+
+#endif // __BUS_SIM_H__
@@ -0,0 +1,707 @@
+/**
+ ******************************************************************************
+ * @file    bus_sim_main.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Simulacija kontrolera na virtuelnom RS485 busu (`ic_bus_sim`).
+ *
+ * @note    Vrti aplikacijski dio glavne petlje kao `ic_host_loop`, a bus i
+ * čvorove opisuje scenarij u tekstualnom fajlu. Akcije scenarija pune redove
+ * komandi kontrolera (`AddCommand`), pozivaju `GetState` (ili `GetStateAsync`
+ * sa `async=1`) ili pokreću spontane
+ * poruke čvorova, pa se propusnost, kašnjenje i ponavljanja kontrolera pod
+ * opterećenjem mjere ponovljivo, bez uređaja.
+ *
+ * Upotreba: `ic_bus_sim <scenarij> [simulirane_ms]`
+ *
+ * Format scenarija (jedna naredba po liniji, `#` je komentar, parametri
+ * su `kljuc=vrijednost`):
+ * - `bus baud= seed= loss_ppm= noise_ppm=`
+ * - `node kind=relay|dimmer|curtain|thermostat|din addr= count= latency_us= jitter_us= sync=`
+ * - `thermostat group= master= mode=` (postavke termostata kontrolera)
+ * - `cmd type=binary|dimmer|curtain|thinfo addr= span= value= alt= at= every= times=`
+ * - `get type=binary|dimmer|curtain|din addr= span= at= every= times= async=`
+ * - `event node= addr= span= value= alt= at= every= times=`
+ * - `temp value= span= at= every= times=` (izmjerena temperatura kontrolera)
+ * - `setpoint value= alt= at= every= times=` (zadata temperatura kontrolera)
+ * - `light index= addr= type=1|2|3` (svjetlo kontrolera: binarno, dimer, RGB)
+ * - `curtain index= up= down=` (roletna kontrolera, isti relej = JALOUSIE_SET)
+ * - `scene index= lights= brightness= curtains=` (scena sa svim
+ *   konfigurisanim svjetlima i roletnama: stanje, svjetlina, smjer)
+ * - `activate value= alt= at= every= times=` (`Scene_Activate`)
+ * - `pty` (preslikava bus na pseudo-terminal, ispisuje njegovo ime)
+ *
+ * `span` vrti adresu kroz `addr..addr+span-1`, a `alt` naizmjenično
+ * mijenja `value` (npr. `value=1 alt=2` pali i gasi relej). `temp` pri
+ * svakom izvršavanju pomjera temperaturu za 0,1 °C, trouglasto između
+ * `value` i `value+span` (desetinke °C). Termostat čvor sa `sync=1` prati
+ * grupu preko `THERMOSTAT_SYNC`, a bez toga preko odgovora na vlastiti
+ * `THERMOSTAT_INFO`; za oba se broji vrijeme u kojem se njihov pogled na
+ * grupu razlikuje od stanja kontrolera. Za scene se ispisuju trajanje
+ * primjene, broj komandi i izgubljene komande (`Scene_GetApplyStats`).
+ * Greške, ponavljanja i odbačene komande na busu se broje i u dnevniku
+ * događaja (`EventLog_GetStats`).
+ * Izvještaj navodi i najduži prolaz
+ * glavne petlje u simuliranim ms, tj. koliko je dugo petlja bila blokirana.
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "thermostat.h"
+#include "ventilator.h"
+#include "defroster.h"
+#include "curtain.h"
+#include "lights.h"
+#include "gate.h"
+#include "scene.h"
+#include "timer.h"
+#include "security.h"
+#include "buzzer.h"
+#include "rs485.h"
+#include "thermostat_sync.h"
+#include "timer_wheel.h"
+#include "devreg.h"
+#include "history.h"
+#include "eventlog.h"
+#include "host_shim.h"
+#include "bus_sim.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define SIM_DEFAULT_RUN_MS              10000U  ///< Podrazumijevano trajanje simulacije
+#define SIM_MAX_ACTIONS                 32U
+#define SIM_MAX_TOKENS                  12U
+#define SIM_LINE_LEN                    256U
+#define SIM_RESPONSE_LEN                COMMAND_QUEUE_SIZE  ///< Kao `GetResponseBuffer.data`
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+typedef enum
+{
+    SIM_ACT_CMD = 0,    ///< `AddCommand` u red kontrolera
+    SIM_ACT_GET,        ///< `GetState` kontrolera (blokira do odgovora) ili `GetStateAsync`
+    SIM_ACT_EVENT,      ///< Spontana poruka čvora
+    SIM_ACT_TEMP,       ///< Izmjerena temperatura termostata kontrolera
+    SIM_ACT_SETPOINT,   ///< Zadata temperatura termostata kontrolera
+    SIM_ACT_SCENE       ///< Aktivacija scene kontrolera
+} SimActionKind_e;
+
+/**
+ * @brief Periodična akcija iz scenarija.
+ */
+typedef struct
+{
+    SimActionKind_e kind;
+    uint8_t  type;          ///< TF tip (za `cmd` i `get`)
+    CommandQueue* queue;    ///< Red kontrolera (za `cmd`)
+    int      node;          ///< Čvor (za `event`)
+    uint16_t addr;
+    uint16_t span;
+    uint16_t value;
+    uint16_t alt;
+    bool     has_alt;
+    uint32_t at;
+    uint32_t every;
+    uint32_t times;
+    uint32_t next;          ///< Sljedeće izvršavanje, ms
+    uint32_t done;
+    uint32_t failed;        ///< Pun red, GET bez odgovora ili odbijen događaj
+    uint32_t replies;       ///< Odgovora na `GetStateAsync` upite akcije
+    bool     async;         ///< `get` bez čekanja odgovora
+} SimAction_t;
+
+/**
+ * @brief Svjetlo, roletna ili scena kontrolera iz scenarija; postavlja se
+ * nakon inicijalizacije modula.
+ */
+typedef struct
+{
+    uint8_t  index;
+    uint16_t a;             ///< Adresa svjetla / relej gore / stanje svjetala scene
+    uint16_t b;             ///< Tip svjetla / relej dolje / svjetlina scene
+    uint16_t c;             ///< Smjer roletni scene
+} SimDevice_t;
+
+/**
+ * @brief Parametar naredbe scenarija `kljuc=vrijednost`.
+ */
+typedef struct
+{
+    const char* key;
+    const char* val;
+} SimToken_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static SimAction_t actions[SIM_MAX_ACTIONS];
+static uint32_t action_count;
+static BusSim_Config_t bus_cfg;
+static bool bus_started;
+static bool pty_requested;
+static int thst_group = -1;
+static int thst_master = -1;
+static int thst_mode = -1;
+static uint32_t th_mismatch_ms[BUS_SIM_MAX_NODES]; ///< Pogled čvora na grupu različit od kontrolera
+static uint32_t max_pass_ms;                    ///< Najduži prolaz glavne petlje
+static SimDevice_t sim_lights[LIGHTS_MODBUS_SIZE];
+static SimDevice_t sim_curtains[CURTAINS_SIZE];
+static SimDevice_t sim_scenes[SCENE_MAX_COUNT];
+static uint8_t sim_light_count, sim_curtain_count, sim_scene_count;
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE - SCENARIJ                                               */
+/*============================================================================*/
+static const char* Sim_Get(const SimToken_t* tok, int n, const char* key)
+{
+    for (int i = 0; i < n; i++)
+    {
+        if (strcmp(tok[i].key, key) == 0) return tok[i].val;
+    }
+    return NULL;
+}
+
+static uint32_t Sim_GetNum(const SimToken_t* tok, int n, const char* key, uint32_t def)
+{
+    const char* v = Sim_Get(tok, n, key);
+    return (v != NULL) ? (uint32_t)strtoul(v, NULL, 0) : def;
+}
+
+static void Sim_StartBus(void)
+{
+    if (!bus_started)
+    {
+        BusSim_Init(&bus_cfg);
+        bus_started = true;
+    }
+}
+
+/**
+ * @brief TF tip i red kontrolera za `cmd` / `get` naziv tipa.
+ */
+static bool Sim_ParseType(const char* name, bool get, uint8_t* type, CommandQueue** queue)
+{
+    if (name == NULL) return false;
+    if (strcmp(name, "binary") == 0)       { *type = get ? BINARY_GET : BINARY_SET;     *queue = &binaryQueue; }
+    else if (strcmp(name, "dimmer") == 0)  { *type = get ? DIMMER_GET : DIMMER_SET;     *queue = &dimmerQueue; }
+    else if (strcmp(name, "curtain") == 0) { *type = get ? JALOUSIE_GET : JALOUSIE_SET; *queue = &curtainQueue; }
+    else if (strcmp(name, "thinfo") == 0 && !get) { *type = THERMOSTAT_INFO;            *queue = &thermoQueue; }
+    else if (strcmp(name, "din") == 0 && get)     { *type = DIN_GET;                    *queue = NULL; }
+    else return false;
+    return true;
+}
+
+static bool Sim_ParseNodeKind(const char* name, BusSim_NodeKind_e* kind)
+{
+    static const char* const names[] = { "relay", "dimmer", "curtain", "thermostat", "din" };
+
+    for (uint32_t i = 0U; (name != NULL) && (i < (sizeof(names) / sizeof(names[0]))); i++)
+    {
+        if (strcmp(name, names[i]) == 0)
+        {
+            *kind = (BusSim_NodeKind_e)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Izvršava jednu liniju scenarija.
+ * @retval false ako je naredba neispravna.
+ */
+static bool Sim_ParseLine(char* line)
+{
+    SimToken_t tok[SIM_MAX_TOKENS];
+    int n = 0;
+    char* verb;
+    char* save = NULL;
+    char* word;
+
+    line[strcspn(line, "#\r\n")] = '\0';
+    verb = strtok_r(line, " \t", &save);
+    if (verb == NULL) return true;
+
+    while ((word = strtok_r(NULL, " \t", &save)) != NULL)
+    {
+        char* eq = strchr(word, '=');
+        if ((eq == NULL) || (n >= (int)SIM_MAX_TOKENS)) return false;
+        *eq = '\0';
+        tok[n].key = word;
+        tok[n].val = eq + 1;
+        n++;
+    }
+
+    if (strcmp(verb, "bus") == 0)
+    {
+        if (bus_started) return false; // mora biti prije čvorova
+        bus_cfg.baud = Sim_GetNum(tok, n, "baud", BUS_SIM_DEFAULT_BAUD);
+        bus_cfg.seed = Sim_GetNum(tok, n, "seed", 1U);
+        bus_cfg.loss_ppm = Sim_GetNum(tok, n, "loss_ppm", 0U);
+        bus_cfg.noise_ppm = Sim_GetNum(tok, n, "noise_ppm", 0U);
+        return true;
+    }
+    if (strcmp(verb, "node") == 0)
+    {
+        BusSim_NodeKind_e kind;
+        int node;
+
+        if (!Sim_ParseNodeKind(Sim_Get(tok, n, "kind"), &kind)) return false;
+        Sim_StartBus();
+        node = BusSim_AddNode(kind, (uint16_t)Sim_GetNum(tok, n, "addr", 1U), (uint16_t)Sim_GetNum(tok, n, "count", 1U),
+                              Sim_GetNum(tok, n, "latency_us", 1000U), Sim_GetNum(tok, n, "jitter_us", 0U));
+        BusSim_SetNodeSync(node, Sim_GetNum(tok, n, "sync", 0U) != 0U);
+        return node >= 0;
+    }
+    if (strcmp(verb, "thermostat") == 0)
+    {
+        thst_group = (int)Sim_GetNum(tok, n, "group", 0U);
+        thst_master = (int)Sim_GetNum(tok, n, "master", 1U);
+        if (Sim_Get(tok, n, "mode") != NULL) thst_mode = (int)Sim_GetNum(tok, n, "mode", 0U);
+        return true;
+    }
+    if (strcmp(verb, "pty") == 0)
+    {
+        pty_requested = true;
+        return true;
+    }
+    if (strcmp(verb, "light") == 0)
+    {
+        SimDevice_t* d = &sim_lights[sim_light_count];
+        if (sim_light_count >= LIGHTS_MODBUS_SIZE) return false;
+        d->index = (uint8_t)Sim_GetNum(tok, n, "index", sim_light_count);
+        d->a = (uint16_t)Sim_GetNum(tok, n, "addr", 0U);
+        d->b = (uint16_t)Sim_GetNum(tok, n, "type", 1U);
+        if ((d->index >= LIGHTS_MODBUS_SIZE) || (d->a == 0U)) return false;
+        sim_light_count++;
+        return true;
+    }
+    if (strcmp(verb, "curtain") == 0)
+    {
+        SimDevice_t* d = &sim_curtains[sim_curtain_count];
+        if (sim_curtain_count >= CURTAINS_SIZE) return false;
+        d->index = (uint8_t)Sim_GetNum(tok, n, "index", sim_curtain_count);
+        d->a = (uint16_t)Sim_GetNum(tok, n, "up", 0U);
+        d->b = (uint16_t)Sim_GetNum(tok, n, "down", d->a);
+        if ((d->index >= CURTAINS_SIZE) || (d->a == 0U)) return false;
+        sim_curtain_count++;
+        return true;
+    }
+    if (strcmp(verb, "scene") == 0)
+    {
+        SimDevice_t* d = &sim_scenes[sim_scene_count];
+        if (sim_scene_count >= SCENE_MAX_COUNT) return false;
+        d->index = (uint8_t)Sim_GetNum(tok, n, "index", sim_scene_count);
+        d->a = (uint16_t)Sim_GetNum(tok, n, "lights", 0U);
+        d->b = (uint16_t)Sim_GetNum(tok, n, "brightness", 100U);
+        d->c = (uint16_t)Sim_GetNum(tok, n, "curtains", CURTAIN_STOP);
+        if (d->index >= SCENE_MAX_COUNT) return false;
+        sim_scene_count++;
+        return true;
+    }
+    if ((strcmp(verb, "cmd") == 0) || (strcmp(verb, "get") == 0) || (strcmp(verb, "event") == 0) ||
+        (strcmp(verb, "temp") == 0) || (strcmp(verb, "setpoint") == 0) || (strcmp(verb, "activate") == 0))
+    {
+        SimAction_t* a;
+
+        if (action_count >= SIM_MAX_ACTIONS) return false;
+        a = &actions[action_count];
+        memset(a, 0, sizeof(*a));
+        if (verb[0] == 'c')      a->kind = SIM_ACT_CMD;
+        else if (verb[0] == 'g') a->kind = SIM_ACT_GET;
+        else if (verb[0] == 'e') a->kind = SIM_ACT_EVENT;
+        else if (verb[0] == 't') a->kind = SIM_ACT_TEMP;
+        else if (verb[0] == 'a') a->kind = SIM_ACT_SCENE;
+        else                     a->kind = SIM_ACT_SETPOINT;
+        if (((a->kind == SIM_ACT_CMD) || (a->kind == SIM_ACT_GET)) &&
+            !Sim_ParseType(Sim_Get(tok, n, "type"), a->kind == SIM_ACT_GET, &a->type, &a->queue))
+        {
+            return false;
+        }
+        a->node = (int)Sim_GetNum(tok, n, "node", 0U);
+        a->addr = (uint16_t)Sim_GetNum(tok, n, "addr", 1U);
+        a->span = (uint16_t)Sim_GetNum(tok, n, "span", 1U);
+        a->value = (uint16_t)Sim_GetNum(tok, n, "value", 0U);
+        a->has_alt = (Sim_Get(tok, n, "alt") != NULL);
+        a->alt = (uint16_t)Sim_GetNum(tok, n, "alt", 0U);
+        a->at = Sim_GetNum(tok, n, "at", 0U);
+        a->every = Sim_GetNum(tok, n, "every", 0U);
+        a->times = Sim_GetNum(tok, n, "times", 1U);
+        a->async = (Sim_GetNum(tok, n, "async", 0U) != 0U);
+        a->next = a->at;
+        if (a->span == 0U) a->span = 1U;
+        action_count++;
+        return true;
+    }
+    return false;
+}
+
+static bool Sim_LoadScenario(const char* path)
+{
+    char line[SIM_LINE_LEN];
+    uint32_t line_no = 0U;
+    FILE* f = fopen(path, "r");
+
+    if (f == NULL)
+    {
+        fprintf(stderr, "Scenarij %s se ne može otvoriti\n", path);
+        return false;
+    }
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        line_no++;
+        if (!Sim_ParseLine(line))
+        {
+            fprintf(stderr, "%s:%lu: neispravna naredba\n", path, (unsigned long)line_no);
+            fclose(f);
+            return false;
+        }
+    }
+    fclose(f);
+    Sim_StartBus();
+    return true;
+}
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE - IZVRSAVANJE                                            */
+/*============================================================================*/
+/**
+ * @brief `GetStateCallback` za `get async=1`; `index` je redni broj akcije.
+ */
+static void Sim_AsyncReply(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len)
+{
+    if (index < action_count) actions[index].replies++;
+}
+
+/**
+ * @brief Izvršava akciju ako je do `now` došla na red.
+ * @note  Poziva se iz glavnog konteksta, nikad iz tick hook-a. `SendCommand`
+ * i `GetState` troše simulirano vrijeme kroz `HAL_Delay`, pa akcija koja
+ * zakasni ide odmah, a sljedeća ostaje na svom periodu.
+ */
+static void Sim_RunAction(SimAction_t* a, uint32_t now)
+{
+    uint16_t addr;
+    uint16_t value;
+    uint32_t phase;
+    uint8_t buf[SIM_RESPONSE_LEN];
+    bool ok = true;
+
+    if ((a->done >= a->times) || (now < a->next)) return;
+    a->next += (a->every != 0U) ? a->every : 1U;
+
+    addr = (uint16_t)(a->addr + (a->done % a->span));
+    value = (a->has_alt && (a->done & 1U)) ? a->alt : a->value;
+    phase = a->done % (2U * a->span);
+    a->done++;
+
+    switch (a->kind)
+    {
+    case SIM_ACT_CMD:
+        memset(buf, 0, sizeof(buf));
+        if (a->type == THERMOSTAT_INFO)
+        {
+            // Isti format koji šalje THSTAT_Service: grupa, uloga, kontrola...
+            buf[0] = (uint8_t)addr;
+            buf[1] = 1U;
+            buf[2] = (uint8_t)value;
+            ok = AddCommand(a->queue, a->type, buf, 7U);
+        }
+        else
+        {
+            buf[0] = (uint8_t)(addr >> 8);
+            buf[1] = (uint8_t)addr;
+            buf[2] = (uint8_t)value;
+            ok = AddCommand(a->queue, a->type, buf, 3U);
+        }
+        break;
+    case SIM_ACT_GET:
+        if (a->async) ok = GetStateAsync(a->type, addr, Sim_AsyncReply, (uint16_t)(a - actions));
+        else          ok = GetState(a->type, addr, buf);
+        break;
+    case SIM_ACT_TEMP:
+        // Trougao value..value+span: span koraka gore pa span dolje
+        Thermostat_SetMeasuredTemp(Thermostat_GetInstance(),
+                                   (int16_t)(a->value + ((phase < a->span) ? phase : (2U * a->span - phase))));
+        break;
+    case SIM_ACT_SETPOINT:
+        Thermostat_SP_Temp_Set(Thermostat_GetInstance(), (uint8_t)value);
+        break;
+    case SIM_ACT_SCENE:
+        Scene_Activate((uint8_t)value);
+        break;
+    case SIM_ACT_EVENT:
+    default:
+        ok = BusSim_NodeEvent(a->node, addr, (uint8_t)value);
+        break;
+    }
+    if (!ok) a->failed++;
+}
+
+/**
+ * @brief Postavlja svjetla, roletne i scene iz scenarija nakon inicijalizacije modula.
+ * @note  Scena uključuje sva svjetla i roletne iz scenarija; termostat ne.
+ */
+static void Sim_SetupDevices(void)
+{
+    for (uint8_t i = 0U; i < sim_light_count; i++)
+    {
+        LIGHT_Handle* h = LIGHTS_GetInstance(sim_lights[i].index);
+        LIGHT_SetRelay(h, sim_lights[i].a);
+        LIGHT_SetCommunicationType(h, (uint8_t)sim_lights[i].b);
+    }
+    for (uint8_t i = 0U; i < sim_curtain_count; i++)
+    {
+        Curtain_Handle* h = Curtain_GetInstanceByIndex(sim_curtains[i].index);
+        Curtain_setRelayUp(h, sim_curtains[i].a);
+        Curtain_setRelayDown(h, sim_curtains[i].b);
+    }
+    for (uint8_t i = 0U; i < sim_scene_count; i++)
+    {
+        Scene_t* sc = Scene_GetInstance(sim_scenes[i].index);
+
+        memset(sc, 0, sizeof(*sc));
+        sc->is_configured = true;
+        sc->scene_type = SCENE_TYPE_STANDARD;
+        sc->wakeup_hour = -1;
+        sc->wakeup_scene_index = -1;
+        for (uint8_t k = 0U; k < sim_light_count; k++)
+        {
+            uint8_t li = sim_lights[k].index;
+            sc->lights_mask |= (uint8_t)(1U << li);
+            sc->light_values[li] = (sim_scenes[i].a != 0U);
+            sc->light_brightness[li] = (uint8_t)sim_scenes[i].b;
+            sc->light_colors[li] = sim_scenes[i].a ? 0x00FFC080UL : 0UL;
+        }
+        for (uint8_t k = 0U; k < sim_curtain_count; k++)
+        {
+            uint8_t ci = sim_curtains[k].index;
+            sc->curtains_mask |= (uint16_t)(1U << ci);
+            sc->curtain_states[ci] = (uint8_t)sim_scenes[i].c;
+        }
+    }
+}
+
+/**
+ * @brief Jedan prolaz aplikacijskog dijela glavne petlje, kao u `ic_host_loop`.
+ */
+static void Sim_LoopPass(THERMOSTAT_TypeDef* pThst, Ventilator_Handle* pVen)
+{
+    Timer_Service();
+    TimerWheel_Service();
+    LIGHT_Service();
+    Curtain_Service();
+    THSTAT_Service(pThst);
+    Ventilator_Service(pVen);
+    Scene_Service();
+    Timer_Service();
+    RS485_Service();
+    Buzzer_Service();
+    History_Service();
+    EventLog_Service();
+}
+
+/**
+ * @brief Broji milisekunde u kojima se pogled termostat čvora na grupu
+ * razlikuje od termostata kontrolera (temperatura preko mrtve zone sinhronizacije).
+ */
+static void Sim_TrackThermostats(THERMOSTAT_TypeDef* pThst)
+{
+    for (int i = 0; i < BusSim_GetNodeCount(); i++)
+    {
+        const BusSim_Node_t* nd = BusSim_GetNode(i);
+
+        if (nd->kind != BUS_NODE_THERMOSTAT) continue;
+        if (!nd->th_valid ||
+            (abs(nd->th_temp - Thermostat_GetMeasuredTemp(pThst)) >= THST_SYNC_TEMP_DEADBAND) ||
+            (nd->th_setpoint != Thermostat_GetSetpoint(pThst)) ||
+            (nd->th_mode != Thermostat_GetControlMode(pThst)))
+        {
+            th_mismatch_ms[i]++;
+        }
+    }
+}
+
+static const char* Sim_TypeName(uint8_t type)
+{
+    switch (type)
+    {
+    case BINARY_GET:      return "BINARY_GET";
+    case BINARY_SET:      return "BINARY_SET";
+    case DIMMER_GET:      return "DIMMER_GET";
+    case DIMMER_SET:      return "DIMMER_SET";
+    case JALOUSIE_GET:    return "JALOUSIE_GET";
+    case JALOUSIE_SET:    return "JALOUSIE_SET";
+    case THERMOSTAT_INFO: return "THERMOSTAT_INFO";
+    case THERMOSTAT_SYNC: return "THERMOSTAT_SYNC";
+    case DIN_GET:         return "DIN_GET";
+    case DIN_EVENT:       return "DIN_EVENT";
+    default:              return "?";
+    }
+}
+
+static void Sim_PrintReport(uint32_t run_ms)
+{
+    static const char* const kinds[] = { "relay", "dimmer", "curtain", "thermostat", "din" };
+    const BusSim_Stats_t* st = BusSim_GetStats();
+    uint32_t answered = 0U;
+
+    printf("Simulirano %lu ms, zauzetost busa %.2f %%\n", (unsigned long)run_ms,
+           (run_ms != 0U) ? (100.0 * (double)st->busy_ns / ((double)run_ms * 1e6)) : 0.0);
+    printf("%-16s %8s %8s %8s %8s %10s %10s %10s\n",
+           "TIP", "POSLANO", "ODGOVOR", "BEZ ODG.", "PONOVL.", "MIN us", "AVG us", "MAX us");
+    for (uint32_t type = 0U; type < 256U; type++)
+    {
+        const BusSim_TypeStats_t* ts = BusSim_GetTypeStats((uint8_t)type);
+        if (ts->sent == 0U) continue;
+        answered += ts->answered;
+        printf("%-16s %8lu %8lu %8lu %8lu %10.1f %10.1f %10.1f\n", Sim_TypeName((uint8_t)type),
+               (unsigned long)ts->sent, (unsigned long)ts->answered, (unsigned long)ts->unanswered,
+               (unsigned long)ts->retries, ts->latency_min_ns / 1e3,
+               ts->answered ? ((double)ts->latency_sum_ns / ts->answered / 1e3) : 0.0, ts->latency_max_ns / 1e3);
+    }
+    printf("Propusnost: %.1f odgovorenih zahtjeva/s\n", (run_ms != 0U) ? (answered * 1000.0 / run_ms) : 0.0);
+    printf("Najduži prolaz petlje: %lu ms\n", (unsigned long)max_pass_ms);
+    printf("%-16s %8s %10s %10s %8s\n", "TIP", "OKVIRA", "BAJTOVA", "BUS ms", "BUS %");
+    for (uint32_t type = 0U; type < 256U; type++)
+    {
+        const BusSim_TypeStats_t* ts = BusSim_GetTypeStats((uint8_t)type);
+        if (ts->frames == 0U) continue;
+        printf("%-16s %8lu %10lu %10.1f %8.3f\n", Sim_TypeName((uint8_t)type), (unsigned long)ts->frames,
+               (unsigned long)ts->bytes, ts->airtime_ns / 1e6,
+               (run_ms != 0U) ? (100.0 * (double)ts->airtime_ns / ((double)run_ms * 1e6)) : 0.0);
+    }
+    printf("Okviri: kontroler %lu zahtjeva + %lu odgovora, čvorovi %lu, šum %lu, pty %lu bajtova\n",
+           (unsigned long)st->ctrl_frames, (unsigned long)st->ctrl_responses, (unsigned long)st->node_frames,
+           (unsigned long)st->noise_bursts, (unsigned long)st->pty_bytes);
+    printf("Greške: %lu kolizija, %lu izgubljenih i %lu oštećenih bajtova, %lu CRC grešaka kod čvorova\n",
+           (unsigned long)st->collisions, (unsigned long)st->bytes_lost,
+           (unsigned long)st->bytes_corrupted, (unsigned long)st->crc_errors);
+    printf("Zahtjevi čvorova: %lu, odgovoreno %lu, avg %.1f us, max %.1f us\n",
+           (unsigned long)st->node_requests, (unsigned long)st->node_requests_answered,
+           st->node_requests_answered ? ((double)st->node_latency_sum_ns / st->node_requests_answered / 1e3) : 0.0,
+           st->node_latency_max_ns / 1e3);
+    for (int i = 0; i < BusSim_GetNodeCount(); i++)
+    {
+        const BusSim_Node_t* nd = BusSim_GetNode(i);
+        printf("Čvor %d %-10s adr %u..%u: primio %lu, odgovorio %lu, poslao %lu\n", i, kinds[nd->kind],
+               nd->first_addr, (unsigned)(nd->first_addr + nd->count - 1U), (unsigned long)nd->rx_frames,
+               (unsigned long)nd->replies, (unsigned long)nd->events);
+        if (nd->kind == BUS_NODE_THERMOSTAT)
+        {
+            printf("    %s: temp %d, zadata %u, mod %u, neusklađen %lu ms (%.2f %%), izgubljeno %lu, zahtjeva %lu\n",
+                   nd->sync ? "SYNC" : "INFO", nd->th_temp, nd->th_setpoint, nd->th_mode,
+                   (unsigned long)th_mismatch_ms[i], (run_ms != 0U) ? (100.0 * th_mismatch_ms[i] / run_ms) : 0.0,
+                   (unsigned long)nd->th_lost, (unsigned long)nd->th_requests);
+        }
+    }
+    if (thst_group > 0)
+    {
+        const ThstSync_Stats_t* ss = ThstSync_GetStats();
+        printf("Sinhronizacija grupe %d: poslano %lu delta, %lu ključnih, %lu zahtjeva; primljeno %lu, "
+               "izgubljeno %lu, odbačeno %lu\n", thst_group, (unsigned long)ss->tx_delta, (unsigned long)ss->tx_key,
+               (unsigned long)ss->tx_request, (unsigned long)ss->rx_frames, (unsigned long)ss->rx_lost,
+               (unsigned long)ss->rx_dropped);
+    }
+    for (uint8_t i = 0U; i < sim_scene_count; i++)
+    {
+        const Scene_ApplyStats_t* sa = Scene_GetApplyStats(sim_scenes[i].index);
+        printf("Scena %u: %u aktivacija, %u neuspješnih; zadnja: %u uređaja (%u bez promjene), %u komandi, "
+               "%lu ms; max %lu ms; odbačeno %lu, bez ACK %lu\n", sim_scenes[i].index, sa->activations, sa->failures,
+               sa->devices, sa->skipped, sa->commands, (unsigned long)sa->last_ms, (unsigned long)sa->max_ms,
+               (unsigned long)sa->dropped, (unsigned long)sa->unacked);
+    }
+    const EventLog_Stats_t* ev = EventLog_GetStats();
+    printf("Dnevnik događaja: %lu zapisa, u RAM-u %u, izgubljeno %lu; %lu programiranja, %lu brisanja\n",
+           (unsigned long)(ev->next_seq - 1U), ev->pending, (unsigned long)ev->lost,
+           (unsigned long)ev->programs, (unsigned long)ev->erases);
+    for (uint32_t i = 0U; i < action_count; i++)
+    {
+        if (actions[i].failed != 0U)
+        {
+            printf("Akcija %lu: %lu od %lu neuspješno\n", (unsigned long)i,
+                   (unsigned long)actions[i].failed, (unsigned long)actions[i].done);
+        }
+        if (actions[i].async)
+        {
+            printf("Akcija %lu: %lu upita bez čekanja, %lu odgovora\n", (unsigned long)i,
+                   (unsigned long)actions[i].done, (unsigned long)actions[i].replies);
+        }
+    }
+}
+
+/*============================================================================*/
+/* GLAVNI PROGRAM                                                             */
+/*============================================================================*/
+int main(int argc, char** argv)
+{
+    uint32_t run_ms;
+    char pty_name[64];
+
+    THERMOSTAT_TypeDef* pThst = Thermostat_GetInstance();
+    Ventilator_Handle* pVen = Ventilator_GetInstance();
+    Defroster_Handle* pDef = Defroster_GetInstance();
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Upotreba: %s <scenarij> [simulirane_ms]\n", argv[0]);
+        return 2;
+    }
+    run_ms = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : SIM_DEFAULT_RUN_MS;
+
+    HostShim_Init();
+    if (!Sim_LoadScenario(argv[1])) return 1;
+    if (pty_requested)
+    {
+        if (!BusSim_OpenPty(pty_name, sizeof(pty_name))) return 1;
+        printf("Bus je na %s\n", pty_name);
+        fflush(stdout);
+    }
+
+    // Isti redoslijed kao u main() na uređaju, bez periferija i ekrana
+    TimerWheel_Init();
+    DevReg_Init();
+    History_Init();
+    EventLog_Init();
+    RS485_Init();
+    LIGHTS_Init();
+    Curtains_Init();
+    Gate_Init();
+    Scene_Init();
+    Defroster_Init(pDef);
+    Buzzer_Init();
+    THSTAT_Init(pThst);
+    Ventilator_Init(pVen);
+    Timer_Init();
+    Security_Init();
+    Sim_SetupDevices();
+    if (thst_group >= 0)
+    {
+        Thermostat_SetGroup(pThst, (uint8_t)thst_group);
+        Thermostat_SetMaster(pThst, thst_master != 0);
+        if (thst_mode >= 0) Thermostat_SetControlMode(pThst, (uint8_t)thst_mode);
+    }
+    BusSim_ResetStats();
+
+    while (HAL_GetTick() < run_ms)
+    {
+        uint32_t pass_start = HAL_GetTick();
+
+        for (uint32_t i = 0U; i < action_count; i++)
+        {
+            Sim_RunAction(&actions[i], HAL_GetTick());
+        }
+        Sim_LoopPass(pThst, pVen);
+        Sim_TrackThermostats(pThst);
+        if ((HAL_GetTick() - pass_start) > max_pass_ms) max_pass_ms = HAL_GetTick() - pass_start;
+        HostShim_Advance(1U);
+    }
+    Sim_PrintReport(run_ms);
+    BusSim_ClosePty();
+
+    return 0;
+}
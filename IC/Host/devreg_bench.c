@@ -0,0 +1,246 @@
+/**
+ ******************************************************************************
+ * @file    devreg_bench.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Benchmark i provjera registra uređaja (`ic_devreg_bench`).
+ *
+ * @note    Za 6 do `DEVREG_MAX_ROUTES` uređaja i tri rasporeda adresa
+ * (uzastopne, sa korakom 0x100 kao adrese modula, slučajne) gradi registar,
+ * mjeri vrijeme `DevReg_Dispatch` za pogotke i promašaje i poredi ga sa
+ * linearnom pretragom kakvu su imali `FindLightByRelayAddress`,
+ * `FindCurtainByRelay` i `Gate_FindByFeedbackSensor`:
+ *
+ *   ic_devreg_bench
+ *
+ * Sa `--check` izlazni kod je 1 ako događaj ne stigne tačno jednom do
+ * pretplatnika sa tačnim indeksom, ako promašaj ili drugi tip poruke pozove
+ * pretplatnika, ako je niz probanja duži od `DEVREG_CHECK_MAX_PROBE`, ako
+ * dva pretplatnika istog ključa nisu pozvana redom prijave, ako se ista
+ * pretplata upiše dvaput ili ako pretplata preko kapaciteta nije odbačena.
+ * Vremena se samo ispisuju.
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "devreg.h"
+#include "host_shim.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define DEVREG_CHECK_MAX_PROBE          8U      ///< Najduži dozvoljeni niz probanja
+#define BENCH_LOOKUPS                   2000000UL
+#define BENCH_PATTERNS                  3U
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static uint16_t bench_addr[DEVREG_MAX_ROUTES + 1U];
+static uint16_t bench_count;
+static uint32_t bench_rand = 0x2545F491UL;
+static volatile int32_t bench_sink;
+static uint16_t bench_last;             ///< Indeks iz posljednjeg poziva pretplatnika
+static uint32_t bench_calls;
+static uint8_t bench_order[4];          ///< Redoslijed poziva u provjeri više pretplatnika
+static uint8_t bench_order_len;
+static const char* const pattern_name[BENCH_PATTERNS] = { "uzastopne", "korak 0x100", "slucajne" };
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+static bool Bench_Used(uint16_t addr, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (bench_addr[i] == addr) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Puni `bench_addr` sa `count` različitih adresa datog rasporeda.
+ */
+static void Bench_Fill(uint8_t pattern, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint16_t a;
+        switch (pattern)
+        {
+        case 0:  a = (uint16_t)(0x0101U + i); break;
+        case 1:  a = (uint16_t)(((i + 1U) << 8) | 0x01U); break;
+        default:
+            do { a = (uint16_t)HostShim_Rand(&bench_rand); } while ((a == 0U) || Bench_Used(a, i));
+            break;
+        }
+        bench_addr[i] = a;
+    }
+    bench_count = count;
+}
+
+static void Bench_Handler(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len)
+{
+    bench_last = index;
+    bench_calls++;
+}
+
+static void Bench_HandlerA(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len)
+{
+    if (bench_order_len < sizeof(bench_order)) bench_order[bench_order_len++] = 'A';
+}
+
+static void Bench_HandlerB(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len)
+{
+    if (bench_order_len < sizeof(bench_order)) bench_order[bench_order_len++] = 'B';
+}
+
+static void Bench_Builder(void)
+{
+    for (uint16_t i = 0; i < bench_count; i++)
+    {
+        DevReg_Subscribe(BINARY_SET, bench_addr[i], Bench_Handler, i);
+    }
+}
+
+/**
+ * @brief Isti ključ: dva modula, i ponovljena pretplata prvog.
+ */
+static void Bench_SharedBuilder(void)
+{
+    DevReg_Subscribe(DIN_EVENT, 0x0A01U, Bench_HandlerA, 0U);
+    DevReg_Subscribe(DIN_EVENT, 0x0A01U, Bench_HandlerB, 0U);
+    DevReg_Subscribe(DIN_EVENT, 0x0A01U, Bench_HandlerA, 0U);
+}
+
+static int16_t Bench_Linear(uint16_t addr)
+{
+    for (uint16_t i = 0; i < bench_count; i++)
+    {
+        if (bench_addr[i] == addr) return (int16_t)i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Adresa koja sigurno nije u registru (za mjerenje promašaja).
+ */
+static uint16_t Bench_Miss(uint32_t n)
+{
+    uint16_t a;
+    do { a = (uint16_t)(n * 40503U + 7U); n++; } while ((a == 0U) || Bench_Used(a, bench_count));
+    return a;
+}
+
+/**
+ * @brief Gradi registar za jedan raspored i broj uređaja i ispisuje red tabele.
+ * @retval uint32_t Broj grešaka.
+ */
+static uint32_t Bench_Run(uint8_t pattern, uint16_t count)
+{
+    uint32_t errors = 0;
+    uint16_t miss[64];
+    const uint8_t state = 1U;
+
+    Bench_Fill(pattern, count);
+    DevReg_Rebuild();
+    const DevReg_Stats_t* st = DevReg_GetStats();
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        bench_calls = 0;
+        if (DevReg_Dispatch(BINARY_SET, bench_addr[i], &state, 1) != 1U) errors++;
+        if ((bench_calls != 1U) || (bench_last != i)) errors++;
+        if (DevReg_Dispatch(JALOUSIE_SET, bench_addr[i], &state, 1) != 0U) errors++;
+    }
+    for (uint16_t i = 0; i < 64U; i++)
+    {
+        miss[i] = Bench_Miss(i * 977U + count);
+        if (DevReg_Dispatch(BINARY_SET, miss[i], &state, 1) != 0U) errors++;
+    }
+    if ((st->routes != count) || (st->max_probe > DEVREG_CHECK_MAX_PROBE)) errors++;
+
+    int32_t sink = 0;
+    uint64_t t0 = HostShim_NowNs();
+    for (uint32_t n = 0; n < BENCH_LOOKUPS; n++) sink += DevReg_Dispatch(BINARY_SET, bench_addr[n % count], &state, 1);
+    uint64_t t1 = HostShim_NowNs();
+    for (uint32_t n = 0; n < BENCH_LOOKUPS; n++) sink += DevReg_Dispatch(BINARY_SET, miss[n & 63U], &state, 1);
+    uint64_t t2 = HostShim_NowNs();
+    for (uint32_t n = 0; n < BENCH_LOOKUPS; n++) sink += Bench_Linear(bench_addr[n % count]);
+    uint64_t t3 = HostShim_NowNs();
+    for (uint32_t n = 0; n < BENCH_LOOKUPS; n++) sink += Bench_Linear(miss[n & 63U]);
+    uint64_t t4 = HostShim_NowNs();
+    bench_sink = sink;
+
+    printf("%-12s %4u %6u %10.1f %10.1f %10.1f %10.1f%s\n", pattern_name[pattern], count, st->max_probe,
+           (double)(t1 - t0) / BENCH_LOOKUPS, (double)(t2 - t1) / BENCH_LOOKUPS,
+           (double)(t3 - t2) / BENCH_LOOKUPS, (double)(t4 - t3) / BENCH_LOOKUPS,
+           errors ? "  GRESKA" : "");
+    return errors;
+}
+
+/**
+ * @brief Više pretplatnika istog ključa, ponovljena pretplata i kapacitet.
+ * @retval uint32_t Broj grešaka.
+ */
+static uint32_t Bench_Limits(void)
+{
+    uint32_t errors = 0;
+    const uint8_t state = 1U;
+
+    Bench_Fill(0, 8U);
+    DevReg_Register(Bench_SharedBuilder);
+    bench_order_len = 0;
+    if (DevReg_Dispatch(DIN_EVENT, 0x0A01U, &state, 1) != 2U) errors++;
+    if ((bench_order_len != 2U) || (bench_order[0] != 'A') || (bench_order[1] != 'B')) errors++;
+    if (DevReg_GetStats()->routes != 10U) errors++;
+
+    Bench_Fill(0, (uint16_t)(DEVREG_MAX_ROUTES + 1U));
+    DevReg_Rebuild();
+    if (DevReg_GetStats()->routes != DEVREG_MAX_ROUTES) errors++;
+    if (DevReg_GetStats()->overflow != 4U) errors++;   // 129. adresa i tri pretplate iz Bench_SharedBuilder
+    bench_calls = 0;
+    DevReg_Dispatch(BINARY_SET, bench_addr[DEVREG_MAX_ROUTES], &state, 1);
+    if (bench_calls != 0U) errors++;
+
+    printf("Vise pretplatnika i kapacitet (%u pretplata): %s\n", (unsigned)DEVREG_MAX_ROUTES, errors ? "GRESKA" : "OK");
+    return errors;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+int main(int argc, char** argv)
+{
+    static const uint16_t counts[] = { 6U, 16U, 32U, 64U, DEVREG_MAX_ROUTES };
+    bool check = (argc > 1) && (strcmp(argv[1], "--check") == 0);
+    uint32_t errors = 0;
+
+    if ((argc > 1) && !check)
+    {
+        fprintf(stderr, "Upotreba: %s [--check]\n", argv[0]);
+        return 1;
+    }
+
+    DevReg_Init();
+    DevReg_Register(Bench_Builder);
+
+    printf("Registar: %u slotova, najvise %u pretplata; vremena u ns po dogadaju\n",
+           (unsigned)DEVREG_SLOTS, (unsigned)DEVREG_MAX_ROUTES);
+    printf("%-12s %4s %6s %10s %10s %10s %10s\n", "adrese", "N", "proba", "hash ns", "hash miss", "lin ns", "lin miss");
+    for (uint8_t p = 0; p < BENCH_PATTERNS; p++)
+    {
+        for (uint8_t c = 0; c < (sizeof(counts) / sizeof(counts[0])); c++)
+        {
+            errors += Bench_Run(p, counts[c]);
+        }
+    }
+    errors += Bench_Limits();
+
+    if (check && errors) fprintf(stderr, "devreg: %lu gresaka\n", (unsigned long)errors);
+    return (check && errors) ? 1 : 0;
+}
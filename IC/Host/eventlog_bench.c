@@ -0,0 +1,482 @@
+/**
+ ******************************************************************************
+ * @file    eventlog_bench.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Benchmark i provjera dnevnika događaja (`ic_eventlog_bench`).
+ *
+ * @note    Na simuliranom QSPI flash-u iz `host_shim.c` puni dnevnik
+ * nekoliko puta preko kruga segmenata, sa naletom koji prepuni RAM bafer,
+ * i preuzima ga kao klijent preko `DIAG_LOG_READ`. Zatim ponavlja cikluse
+ * nasumičnog rada i nestanka napajanja u nasumičnom trenutku, i usred
+ * programiranja i brisanja (`HostShim_QspiPowerCut`), nakon čega radi isto
+ * što i `main()`: `MX_QSPI_Init`, `QSPI_MemMapMode`, `EventLog_Init`.
+ * Screensaver se naizmjenično pali i gasi (`BENCH_SCRNSVR_MS`). Na kraju
+ * FW agent iz listenera preuzima QSPI (`EventLog_Suspend`) dok flash
+ * programira ili briše, ili dok glavna petlja provjerava završenu
+ * operaciju, prima pakete i prekida prenos (`EventLog_Resume`). Ispisuje
+ * vrijeme upisa, indeksiranog i punog čitanja, najduži period u kojem QSPI
+ * nije mapiran (GUI ne crta bitmape) i kada su pokrenuta brisanja:
+ *
+ *   ic_eventlog_bench
+ *
+ * Sa `--check` izlazni kod je 1 ako nakon bilo kojeg nestanka napajanja
+ * nedostaje ili se razlikuje zapis koji je prije toga bio potvrđen
+ * (`durable_seq`), osim najstarijeg segmenta koji je dnevnik upravo
+ * odbacivao, ako redni brojevi pročitanih zapisa nisu strogo rastući, ako
+ * novi zapis ne dobije veći redni broj od svih postojećih, ako preuzimanje
+ * preko `DIAG_LOG_READ` ne da iste zapise, ako QSPI ostane nemapiran
+ * duže od jednog brisanja podsektora, ako brisanje počne bez
+ * screensavera prije pola aktivnog segmenta, ili ako agentov `MX_QSPI_Init`
+ * prekine operaciju dnevnika, dnevnik pokrene operaciju tokom prenosa ili
+ * zapis iz tog vremena nedostaje. Vremena se samo ispisuju.
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "eventlog.h"
+#include "display.h"
+#include "host_shim.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define BENCH_MAX_SEQ                   1000000U
+#define BENCH_SERVICE_MS                10U     ///< TASK_IO_PERIOD
+#define BENCH_FILL_MS                   (30U * 60U * 1000U)
+#define BENCH_FILL_RATE                 25U     ///< Prosječno ms između događaja pri punjenju
+#define BENCH_BURST                     (EVLOG_RAM_RECORDS + 36U)
+#define BENCH_BURST_TAIL_MS             10000U  ///< Nalet je pred kraj punjenja, pa `EVLOG_LOST` ostaje u dnevniku
+#define BENCH_CUTS                      2000U
+#define BENCH_CUT_MAX_MS                3000U
+#define BENCH_READS                     20000U
+#define BENCH_READ_COUNT                8U
+#define BENCH_ALL                       (EVLOG_SEGMENTS * EVLOG_SLOTS + EVLOG_RAM_RECORDS)
+#define BENCH_SCRNSVR_MS                45000U  ///< Screensaver se naizmjenično pali i gasi
+#define BENCH_AGENT_STARTS              400U
+#define BENCH_AGENT_ERASE_MAX_MS        2000U   ///< Brisanje staging prostora u listeneru
+#define BENCH_AGENT_RX_MAX_MS           3000U   ///< Prijem paketa prije prekida prenosa
+#define BENCH_AGENT_PACKET_MS           20U     ///< Razmak DATA paketa (upis u QSPI iz listenera)
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static EventLog_Record_t bench_ref[BENCH_MAX_SEQ];   ///< Po rednom broju, `code` 0 = nikad upisan
+static EventLog_Record_t bench_buf[BENCH_ALL];
+static uint32_t bench_rand = 0x6A09E667UL;
+static uint32_t bench_busy_ms, bench_busy_run, bench_busy_max;
+static uint64_t bench_write_ns, bench_service_ns, bench_service_max;
+static uint32_t bench_writes, bench_services;
+static uint32_t bench_erases_seen, bench_erases_idle, bench_erases_ahead, bench_erases_early;
+static bool bench_agent_armed;          ///< Sljedeći `QSPI_InvalidateCache` je prekid sa START zahtjevom
+static uint32_t bench_agent_busy, bench_agent_nested, bench_agent_wait_max, bench_agent_errors;
+static volatile uint32_t bench_sink;
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+static uint32_t Bench_Get32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief Upisuje nasumičan događaj i pamti ga u referenci pod dodijeljenim rednim brojem.
+ * @retval uint32_t Greška (1) ako redni broj nije veći od `floor`.
+ */
+static uint32_t Bench_Event(uint32_t floor)
+{
+    uint8_t code = (uint8_t)(EVLOG_RESET + (HostShim_Rand(&bench_rand) % (EVLOG_SCENE - EVLOG_RESET + 1U)));
+    uint8_t arg = (uint8_t)HostShim_Rand(&bench_rand);
+    uint32_t value = HostShim_Rand(&bench_rand);
+
+    uint64_t t0 = HostShim_NowNs();
+    bool ok = EventLog_Write(code, arg, value);
+    bench_write_ns += HostShim_NowNs() - t0;
+    bench_writes++;
+    if (!ok) return 0U;
+
+    uint32_t seq = EventLog_GetStats()->next_seq - 1U;
+    if ((seq >= BENCH_MAX_SEQ) || (seq <= floor)) return 1U;
+    bench_ref[seq].seq = seq;
+    bench_ref[seq].time = HAL_GetTick() / 1000U;
+    bench_ref[seq].value = value;
+    bench_ref[seq].code = code;
+    bench_ref[seq].arg = arg;
+    return 0U;
+}
+
+/**
+ * @brief Zapis je jednak referenci; `EVLOG_LOST` upisuje sam dnevnik.
+ */
+static bool Bench_Match(const EventLog_Record_t* r)
+{
+    const EventLog_Record_t* ref;
+
+    if (r->seq >= BENCH_MAX_SEQ) return false;
+    ref = &bench_ref[r->seq];
+    if (ref->code == 0U) return (r->code == EVLOG_LOST);
+    return (ref->time == r->time) && (ref->value == r->value) && (ref->code == r->code) && (ref->arg == r->arg);
+}
+
+/**
+ * @brief Razvrstava upravo pokrenuto brisanje: uz screensaver, unaprijed od
+ * pola aktivnog segmenta, ili prerano (dok se ekran koristi).
+ */
+static void Bench_CountErase(void)
+{
+    const EventLog_Stats_t* st = EventLog_GetStats();
+
+    if (st->erases > bench_erases_seen)
+    {
+        if (IsScrnsvrActiv()) bench_erases_idle++;
+        else if ((st->segment == EVLOG_SEGMENTS) || (st->write_slot >= (EVLOG_SLOTS / 2U))) bench_erases_ahead++;
+        else bench_erases_early++;
+    }
+    bench_erases_seen = st->erases;     // EventLog_Init nakon nestanka napajanja briše brojače
+}
+
+/**
+ * @brief Glavna petlja `ms` milisekundi: događaji prosječno svakih `rate` ms
+ * (0 = bez događaja), `EventLog_Service` svakih `BENCH_SERVICE_MS`.
+ */
+static uint32_t Bench_Run(uint32_t ms, uint32_t rate, uint32_t floor)
+{
+    uint32_t errors = 0U;
+
+    while (ms--)
+    {
+        if ((rate != 0U) && ((HostShim_Rand(&bench_rand) % rate) == 0U)) errors += Bench_Event(floor);
+        if ((HAL_GetTick() % BENCH_SCRNSVR_MS) == 0U)
+        {
+            if (IsScrnsvrActiv()) ScrnsvrReset();
+            else ScrnsvrSet();
+        }
+        if ((HAL_GetTick() % BENCH_SERVICE_MS) == 0U)
+        {
+            uint64_t t0 = HostShim_NowNs();
+            EventLog_Service();
+            uint64_t dt = HostShim_NowNs() - t0;
+            bench_service_ns += dt;
+            if (dt > bench_service_max) bench_service_max = dt;
+            bench_services++;
+            Bench_CountErase();
+        }
+        if (EventLog_IsFlashBusy())
+        {
+            bench_busy_ms++;
+            if (++bench_busy_run > bench_busy_max) bench_busy_max = bench_busy_run;
+        }
+        else
+        {
+            bench_busy_run = 0U;
+        }
+        HostShim_Advance(1U);
+    }
+    return errors;
+}
+
+/**
+ * @brief Čeka da dnevnik upiše RAM bafer i završi operaciju u toku.
+ */
+static void Bench_Settle(void)
+{
+    const EventLog_Stats_t* st = EventLog_GetStats();
+    while ((st->pending != 0U) || EventLog_IsFlashBusy())
+    {
+        Bench_Run(BENCH_SERVICE_MS, 0U, 0U);
+        st = EventLog_GetStats();
+    }
+}
+
+/**
+ * @brief Čita cijeli dnevnik od `from`; zapisi moraju biti strogo rastući i
+ * jednaki referenci, a svi u [`from`, `to`) prisutni.
+ * @retval uint32_t Broj grešaka; `last` je najveći pročitani redni broj.
+ */
+static uint32_t Bench_Verify(uint32_t from, uint32_t to, uint32_t* last, uint32_t* count)
+{
+    uint32_t errors = 0U;
+    uint32_t want = from;
+    uint16_t n = EventLog_Read(from, bench_buf, BENCH_ALL);
+
+    *last = 0U;
+    for (uint16_t i = 0U; i < n; i++)
+    {
+        const EventLog_Record_t* r = &bench_buf[i];
+        if ((i != 0U) && (r->seq <= *last)) errors++;
+        if (!Bench_Match(r)) errors++;
+        if ((r->seq < to) && (r->seq != want)) errors++;    // rupa u potvrđenim zapisima
+        want = r->seq + 1U;
+        *last = r->seq;
+    }
+    if (want < to) errors++;
+    *count = n;
+    return errors;
+}
+
+/**
+ * @brief Preuzima cijeli dnevnik kao klijent preko `DIAG_LOG_READ`.
+ * @retval uint32_t Broj grešaka u odnosu na `EventLog_Read`.
+ */
+static uint32_t Bench_Export(uint32_t from, uint32_t expected, uint32_t* frames)
+{
+    static uint8_t resp[120];
+    uint32_t errors = 0U, got = 0U;
+    uint8_t more = 1U;
+
+    if (EventLog_Serialize(DIAG_LOG_STATUS, 0U, 0U, resp, sizeof(resp)) != (4U + 37U)) errors++;
+    if (Bench_Get32(&resp[4]) != EventLog_GetStats()->first_seq) errors++;
+
+    *frames = 0U;
+    while (more)
+    {
+        uint16_t len = EventLog_Serialize(DIAG_LOG_READ, 0U, from, resp, sizeof(resp));
+        (*frames)++;
+        if ((len < 4U) || (len != (uint16_t)(4U + resp[3] * 14U)) || (resp[3] == 0U && resp[2] != 0U)) { errors++; break; }
+        more = resp[2];
+        for (uint8_t i = 0U; i < resp[3]; i++)
+        {
+            const uint8_t* p = &resp[4U + i * 14U];
+            EventLog_Record_t r;
+            r.seq = Bench_Get32(p);
+            r.time = Bench_Get32(p + 4);
+            r.value = Bench_Get32(p + 8);
+            r.code = p[12];
+            r.arg = p[13];
+            if ((r.seq < from) || !Bench_Match(&r)) errors++;
+            from = r.seq + 1U;
+            got++;
+        }
+    }
+    if (got != expected) errors++;
+    return errors;
+}
+
+/**
+ * @brief Nestanak napajanja i start kao u `main()`.
+ */
+static void Bench_Reboot(void)
+{
+    HostShim_QspiPowerCut();
+    bench_busy_run = 0U;
+    MX_QSPI_Init();
+    QSPI_MemMapMode();
+    EventLog_Init();
+}
+
+/**
+ * @brief START zahtjev u listeneru, kao `HandleMessage_Idle`: dnevnik predaje
+ * QSPI, agent briše staging prostor i vraća mapiran režim.
+ * @note  Greška ako agentov `MX_QSPI_Init` prekine operaciju dnevnika.
+ */
+static void Bench_AgentStart(void)
+{
+    uint32_t cuts = HostShim_GetStats()->qspi_cuts;
+    uint32_t t0 = HAL_GetTick();
+
+    if (EventLog_IsFlashBusy()) bench_agent_busy++;
+    EventLog_Suspend();
+    if ((HAL_GetTick() - t0) > bench_agent_wait_max) bench_agent_wait_max = HAL_GetTick() - t0;
+    MX_QSPI_Init();
+    HostShim_Advance(HostShim_Rand(&bench_rand) % BENCH_AGENT_ERASE_MAX_MS);  // staging je van prostora dnevnika
+    MX_QSPI_Init();
+    QSPI_MemMapMode();
+    if (HostShim_GetStats()->qspi_cuts != cuts) bench_agent_errors++;
+}
+
+/**
+ * @brief Prekid koji zatekne provjeru završene operacije u `EventLog_Service`.
+ */
+static void Bench_AgentHook(void)
+{
+    if (!bench_agent_armed) return;
+    bench_agent_armed = false;
+    bench_agent_nested++;
+    Bench_AgentStart();
+}
+
+/**
+ * @brief Prenos nakon START-a: DATA paketi upisuju QSPI iz listenera, a
+ * dnevnik za to vrijeme ne smije pokrenuti ni prekinuti operaciju.
+ */
+static uint32_t Bench_AgentReceive(uint32_t ms)
+{
+    const EventLog_Stats_t* st = EventLog_GetStats();
+    uint32_t cuts = HostShim_GetStats()->qspi_cuts;
+    uint32_t ops = st->programs + st->erases;
+    uint32_t errors = 0U;
+
+    while (ms--)
+    {
+        if ((HostShim_Rand(&bench_rand) % 100U) == 0U) errors += Bench_Event(0U);
+        if ((HAL_GetTick() % BENCH_SERVICE_MS) == 0U) EventLog_Service();
+        if ((HAL_GetTick() % BENCH_AGENT_PACKET_MS) == 0U)
+        {
+            MX_QSPI_Init();
+            QSPI_MemMapMode();
+        }
+        if (EventLog_IsFlashBusy()) errors++;
+        HostShim_Advance(1U);
+    }
+    if (((st->programs + st->erases) != ops) || (HostShim_GetStats()->qspi_cuts != cuts)) errors++;
+    return errors;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+int main(int argc, char** argv)
+{
+    bool check = (argc > 1) && (strcmp(argv[1], "--check") == 0);
+    uint32_t errors = 0U, last, count, frames;
+    const EventLog_Stats_t* st;
+
+    if ((argc > 1) && !check)
+    {
+        fprintf(stderr, "Upotreba: %s [--check]\n", argv[0]);
+        return 1;
+    }
+
+    HostShim_Init();
+    EventLog_Init();
+
+    // --- Punjenje preko kruga segmenata, sa naletom koji prepuni RAM bafer ---
+    errors += Bench_Run(BENCH_FILL_MS - BENCH_BURST_TAIL_MS, BENCH_FILL_RATE, 0U);
+    for (uint32_t i = 0U; i < BENCH_BURST; i++) errors += Bench_Event(0U);
+    errors += Bench_Run(BENCH_BURST_TAIL_MS, BENCH_FILL_RATE, 0U);
+    Bench_Settle();
+
+    st = EventLog_GetStats();
+    uint32_t fill_errors = Bench_Verify(st->first_seq, st->next_seq, &last, &count);
+    uint32_t lost_logged = 0U;
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if (bench_buf[i].code == EVLOG_LOST) lost_logged += bench_buf[i].value;
+    }
+    if ((st->lost < (BENCH_BURST - EVLOG_RAM_RECORDS)) || (lost_logged != st->lost)) fill_errors++;
+    if ((st->segments != EVLOG_SEGMENTS - 1U) || (last != st->next_seq - 1U)) fill_errors++;
+    uint32_t export_errors = Bench_Export(st->first_seq, count, &frames);
+
+    printf("Dnevnik: %u segmenata x %u zapisa po %u B u QSPI, %u zapisa u RAM-u\n", (unsigned)EVLOG_SEGMENTS,
+           (unsigned)(EVLOG_SLOTS - 1U), (unsigned)EVLOG_RECORD_SIZE, (unsigned)EVLOG_RAM_RECORDS);
+    printf("Punjenje %u min: %lu zapisa, sačuvano %lu (%lu..%lu), izgubljeno u naletu %lu, "
+           "%lu programiranja, %lu brisanja: %s\n", BENCH_FILL_MS / 60000U, (unsigned long)(st->next_seq - 1U),
+           (unsigned long)count, (unsigned long)st->first_seq, (unsigned long)last, (unsigned long)st->lost,
+           (unsigned long)st->programs, (unsigned long)st->erases, fill_errors ? "GRESKA" : "OK");
+    printf("Preuzimanje DIAG_LOG_READ: %lu zapisa u %lu odgovora: %s\n", (unsigned long)count,
+           (unsigned long)frames, export_errors ? "GRESKA" : "OK");
+    errors += fill_errors + export_errors;
+
+    // --- Vremena: upis, indeksirano čitanje od nasumičnog rednog broja, cijeli dnevnik ---
+    uint32_t span = st->next_seq - st->first_seq;
+    uint32_t first = st->first_seq;
+    uint32_t sink = 0U;
+    uint64_t t0 = HostShim_NowNs();
+    for (uint32_t i = 0U; i < BENCH_READS; i++)
+    {
+        uint32_t from = first + (HostShim_Rand(&bench_rand) % span);
+        uint16_t n = EventLog_Read(from, bench_buf, BENCH_READ_COUNT);
+        if ((n == 0U) || (bench_buf[0].seq != from)) errors++;
+        sink += n;
+    }
+    uint64_t t1 = HostShim_NowNs();
+    for (uint32_t i = 0U; i < 100U; i++) sink += EventLog_Read(first, bench_buf, BENCH_ALL);
+    uint64_t t2 = HostShim_NowNs();
+    bench_sink = sink;
+
+    printf("EventLog_Write: %.1f ns prosjek; EventLog_Service: %.1f ns prosjek, %llu ns max\n",
+           (double)bench_write_ns / bench_writes, (double)bench_service_ns / bench_services,
+           (unsigned long long)bench_service_max);
+    printf("Čitanje %u zapisa od nasumičnog rednog broja: %.2f us; cijeli dnevnik (%lu): %.1f us\n",
+           BENCH_READ_COUNT, (double)(t1 - t0) / BENCH_READS / 1000.0, (unsigned long)span,
+           (double)(t2 - t1) / 100.0 / 1000.0);
+
+    // --- Nestanci napajanja u nasumičnom trenutku ---
+    uint32_t cut_errors = 0U, rotated = 0U;
+    uint64_t init_ns = 0U;
+    for (uint32_t c = 0U; c < BENCH_CUTS; c++)
+    {
+        uint32_t rate = ((HostShim_Rand(&bench_rand) % 8U) == 0U) ? 4U : (5U + (HostShim_Rand(&bench_rand) % 60U));
+        cut_errors += Bench_Run(1U + (HostShim_Rand(&bench_rand) % BENCH_CUT_MAX_MS), rate, 0U);
+
+        st = EventLog_GetStats();
+        uint32_t pre_first = st->first_seq;
+        uint32_t pre_durable = st->durable_seq;
+
+        uint64_t i0 = HostShim_NowNs();
+        Bench_Reboot();
+        init_ns += HostShim_NowNs() - i0;
+
+        // Najstariji segment smije nestati samo ako je upravo otvoren novi
+        st = EventLog_GetStats();
+        uint32_t from = st->first_seq;
+        if (from < pre_first) from = pre_first;
+        if (from != pre_first) rotated++;
+        if ((from - pre_first) >= EVLOG_SLOTS) cut_errors++;
+
+        cut_errors += Bench_Verify(from, pre_durable, &last, &count);
+        if ((count != 0U) && (st->next_seq <= last)) cut_errors++;
+        cut_errors += Bench_Event(last);   // novi zapis je iza svih postojećih
+    }
+    Bench_Settle();
+
+    const HostShim_Stats_t* hs = HostShim_GetStats();
+    st = EventLog_GetStats();
+    printf("Nestanak napajanja %u puta (%lu usred programiranja ili brisanja, %lu uz odbacivanje najstarijeg "
+           "segmenta): EventLog_Init %.1f us, zadnji redni broj %lu: %s\n", BENCH_CUTS,
+           (unsigned long)hs->qspi_cuts, (unsigned long)rotated, (double)init_ns / BENCH_CUTS / 1000.0,
+           (unsigned long)(st->next_seq - 1U), cut_errors ? "GRESKA" : "OK");
+    errors += cut_errors;
+
+    // --- FW agent preuzima QSPI usred upisa, brisanja i provjere dnevnika ---
+    uint32_t agent_errors = 0U;
+    HostShim_SetQspiHook(Bench_AgentHook);
+    for (uint32_t a = 0U; a < BENCH_AGENT_STARTS; a++)
+    {
+        uint32_t from = EventLog_GetStats()->next_seq;
+        agent_errors += Bench_Run(1U + (HostShim_Rand(&bench_rand) % BENCH_CUT_MAX_MS), 5U + (HostShim_Rand(&bench_rand) % 60U), 0U);
+        if ((a & 1U) != 0U)
+        {
+            bench_agent_armed = true;
+            for (uint32_t ms = 0U; bench_agent_armed && (ms < BENCH_CUT_MAX_MS); ms++) agent_errors += Bench_Run(1U, 5U, 0U);
+            if (bench_agent_armed) agent_errors++;
+            bench_agent_armed = false;
+        }
+        else
+        {
+            // Između prolaza petlje, nasumično duboko u programiranje ili brisanje
+            for (uint32_t ms = 0U; !EventLog_IsFlashBusy() && (ms < BENCH_CUT_MAX_MS); ms++) agent_errors += Bench_Run(1U, 5U, 0U);
+            agent_errors += Bench_Run(HostShim_Rand(&bench_rand) % HOST_QSPI_ERASE_MS, 0U, 0U);
+            Bench_AgentStart();
+        }
+        agent_errors += Bench_AgentReceive(1U + (HostShim_Rand(&bench_rand) % BENCH_AGENT_RX_MAX_MS));
+        EventLog_Resume();      // prenos prekinut (`Agent_HandleFailure`)
+        Bench_Settle();
+        agent_errors += Bench_Verify(from, EventLog_GetStats()->next_seq, &last, &count);
+    }
+    HostShim_SetQspiHook(NULL);
+    agent_errors += bench_agent_errors;
+    if ((bench_agent_busy == 0U) || (bench_agent_nested == 0U) || (bench_agent_wait_max > HOST_QSPI_ERASE_MS)) agent_errors++;
+    printf("FW agent preuzeo QSPI %u puta (%lu uz operaciju dnevnika u toku, %lu usred provjere u "
+           "EventLog_Service), najduže čekanje %lu ms: %s\n", BENCH_AGENT_STARTS, (unsigned long)bench_agent_busy,
+           (unsigned long)bench_agent_nested, (unsigned long)bench_agent_wait_max, agent_errors ? "GRESKA" : "OK");
+    errors += agent_errors;
+
+    bool gui_ok = bench_busy_max <= (HOST_QSPI_ERASE_MS + BENCH_SERVICE_MS);
+    printf("QSPI nemapiran (GUI bez bitmapa): %.2f %% vremena, najduže %lu ms: %s\n",
+           100.0 * bench_busy_ms / HAL_GetTick(), (unsigned long)bench_busy_max, gui_ok ? "OK" : "GRESKA");
+    if (!gui_ok) errors++;
+
+    printf("Brisanja: %lu uz screensaver, %lu od pola segmenta, %lu prerano: %s\n",
+           (unsigned long)bench_erases_idle, (unsigned long)bench_erases_ahead,
+           (unsigned long)bench_erases_early, bench_erases_early ? "GRESKA" : "OK");
+    errors += bench_erases_early;
+
+    if (check && errors) fprintf(stderr, "eventlog: %lu gresaka\n", (unsigned long)errors);
+    return (check && errors) ? 1 : 0;
+}
@@ -0,0 +1,337 @@
+/**
+ ******************************************************************************
+ * @file    history_bench.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Benchmark i provjera istorije mjerenja (`ic_history_bench`).
+ *
+ * @note    Puni istoriju sa osam dana sintetičkih uzoraka nivoa 0 (dnevni
+ * hod temperature sa šumom, promjene zadate temperature, ventilator i
+ * svjetla uveče, sa polusatnim prekidom trećeg dana), mjeri vrijeme
+ * `History_Push` i `History_Query` za grafik od 440 kolona i ispisuje
+ * bajtove po uzorku:
+ *
+ *   ic_history_bench
+ *
+ * Sa `--check` izlazni kod je 1 ako se kolone upita za 1 h, 24 h i 7 dana
+ * razlikuju od referentnog sažimanja istih uzoraka, ako upit ne uzme
+ * očekivani nivo, ako blokovi preuzeti preko `DIAG_HIST_READ` ne
+ * dekodiraju tačno referentne uzorke, ili ako stranice `DIAG_HIST_STATUS`
+ * ne pokrivaju sve kanale sa tačnim brojem blokova. Vremena se samo
+ * ispisuju.
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "history.h"
+#include "host_shim.h"
+#include <math.h>
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define BENCH_DAYS                      8U
+#define BENCH_SAMPLES                   (BENCH_DAYS * 86400U / HIST_TIER0_PERIOD_S)
+#define BENCH_GAP_START                 (3U * 86400U + 7200U)   ///< Prekid upisa trećeg dana
+#define BENCH_GAP_LEN                   1800U
+#define BENCH_COLUMNS                   440U    ///< Širina grafika na ekranu istorije
+#define BENCH_QUERIES                   1000U
+#define BENCH_REF_CHANNELS              2U      ///< Provjeravaju se temperatura i prvo svjetlo
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+/**
+ * @brief Referentni uzorci jednog nivoa jednog kanala.
+ */
+typedef struct
+{
+    uint32_t time[BENCH_SAMPLES];
+    int16_t  value[BENCH_SAMPLES];
+    uint32_t count;
+    int32_t  acc_sum;           /**< Grupa koja se sažima u sljedeći nivo. */
+    uint32_t acc_start;
+    uint8_t  acc_n;
+} BenchRef_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static BenchRef_t bench_ref[BENCH_REF_CHANNELS][HIST_TIERS];
+static const uint8_t bench_ref_channel[BENCH_REF_CHANNELS] = { HIST_CH_TEMP, HIST_CH_LIGHT };
+static History_Column_t bench_cols[BENCH_COLUMNS];
+static History_Column_t bench_ref_cols[BENCH_COLUMNS];
+static uint32_t bench_rand = 0x1234567UL;
+static volatile int32_t bench_sink;
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+static int16_t Bench_Reduce(uint8_t channel, int32_t sum, uint8_t n)
+{
+    if (channel >= HIST_CH_LIGHT) return (int16_t)sum;
+    return (int16_t)((sum + ((sum < 0) ? -(int32_t)(n / 2U) : (int32_t)(n / 2U))) / (int32_t)n);
+}
+
+/**
+ * @brief Isto sažimanje kao `History_Push`, nezavisno napisano.
+ */
+static void Bench_RefPush(uint8_t r, int16_t value, uint32_t time_s)
+{
+    for (uint8_t t = 0U; t < HIST_TIERS; t++)
+    {
+        BenchRef_t* ref = &bench_ref[r][t];
+        ref->time[ref->count] = time_s;
+        ref->value[ref->count] = value;
+        ref->count++;
+        if (t == (HIST_TIERS - 1U)) return;
+
+        uint8_t group = (uint8_t)(History_GetPeriod(t + 1U) / History_GetPeriod(t));
+        if ((ref->acc_n != 0U) && (time_s != ref->acc_start + (ref->acc_n * History_GetPeriod(t)))) ref->acc_n = 0U;
+        if (ref->acc_n == 0U)
+        {
+            ref->acc_sum = 0;
+            ref->acc_start = time_s;
+        }
+        ref->acc_sum += value;
+        if (++ref->acc_n < group) return;
+        value = Bench_Reduce(bench_ref_channel[r], ref->acc_sum, group);
+        time_s = ref->acc_start;
+        ref->acc_n = 0U;
+    }
+}
+
+/**
+ * @brief Puni istoriju i referencu; vraća prosjek i maksimum upisa svih kanala u ns.
+ */
+static void Bench_Fill(uint32_t* end_s, double* avg_ns, uint64_t* max_ns)
+{
+    uint64_t total = 0U, worst = 0U;
+    uint32_t pushes = 0U;
+    int16_t setpoint = 220;
+    uint32_t t = 0U;
+
+    for (uint32_t i = 0U; i < BENCH_SAMPLES; i++, t += HIST_TIER0_PERIOD_S)
+    {
+        if ((t >= BENCH_GAP_START) && (t < BENCH_GAP_START + BENCH_GAP_LEN)) continue;
+
+        uint32_t tod = t % 86400U;
+        double day = sin(2.0 * 3.14159265358979 * (double)tod / 86400.0);
+        int16_t temp = (int16_t)(setpoint - 15 + (int16_t)(30.0 * day) + (int16_t)(HostShim_Rand(&bench_rand) % 7U) - 3);
+        if ((HostShim_Rand(&bench_rand) % 4000U) == 0U) setpoint = (int16_t)(190 + (HostShim_Rand(&bench_rand) % 8U) * 10);
+        int16_t fan = (temp < setpoint - 10) ? 30 : ((temp < setpoint) ? 10 : 0);
+        int16_t light = ((tod >= 64800U) && (tod < 82800U)) ? (int16_t)HIST_TIER0_PERIOD_S :
+                        (((HostShim_Rand(&bench_rand) % 50U) == 0U) ? (int16_t)(HostShim_Rand(&bench_rand) % HIST_TIER0_PERIOD_S) : 0);
+
+        uint64_t t0 = HostShim_NowNs();
+        History_Push(HIST_CH_TEMP, temp, t);
+        History_Push(HIST_CH_SETPOINT, setpoint, t);
+        History_Push(HIST_CH_FAN, fan, t);
+        History_Push(HIST_CH_LIGHT, light, t);
+        for (uint8_t l = 1U; l < LIGHTS_MODBUS_SIZE; l++) History_Push((uint8_t)(HIST_CH_LIGHT + l), 0, t);
+        uint64_t dt = HostShim_NowNs() - t0;
+        total += dt;
+        if (dt > worst) worst = dt;
+        pushes++;
+
+        Bench_RefPush(0U, temp, t);
+        Bench_RefPush(1U, light, t);
+    }
+
+    *end_s = t;
+    *avg_ns = (double)total / pushes;
+    *max_ns = worst;
+}
+
+/**
+ * @brief Referentne kolone nivoa `tier` za [from, to).
+ */
+static void Bench_RefQuery(uint8_t r, uint8_t tier, uint32_t from, uint32_t to)
+{
+    const BenchRef_t* ref = &bench_ref[r][tier];
+
+    for (uint16_t c = 0U; c < BENCH_COLUMNS; c++)
+    {
+        bench_ref_cols[c].min = INT16_MAX;
+        bench_ref_cols[c].max = INT16_MIN;
+        bench_ref_cols[c].sum = 0;
+        bench_ref_cols[c].count = 0U;
+    }
+    for (uint32_t i = 0U; i < ref->count; i++)
+    {
+        if ((ref->time[i] < from) || (ref->time[i] >= to)) continue;
+        History_Column_t* col = &bench_ref_cols[((uint64_t)(ref->time[i] - from) * BENCH_COLUMNS) / (to - from)];
+        int16_t v = ref->value[i];
+        if (v < col->min) col->min = v;
+        if (v > col->max) col->max = v;
+        col->sum += v;
+        col->count++;
+    }
+}
+
+/**
+ * @brief Upit za posljednjih `span_s` sekundi: poređenje sa referencom i vrijeme.
+ * @retval uint32_t Broj grešaka.
+ */
+static uint32_t Bench_Query(const char* name, uint8_t r, uint32_t end_s, uint32_t span_s, uint8_t expected_tier)
+{
+    uint32_t errors = 0U;
+    uint32_t from = end_s - span_s;
+    History_Summary_t sum;
+
+    uint16_t filled = History_Query(bench_ref_channel[r], from, end_s, bench_cols, BENCH_COLUMNS, &sum);
+    if ((sum.samples == 0U) || (sum.tier != expected_tier)) errors++;
+    Bench_RefQuery(r, sum.tier, from, end_s);
+    for (uint16_t c = 0U; c < BENCH_COLUMNS; c++)
+    {
+        if ((bench_cols[c].count != bench_ref_cols[c].count) || (bench_cols[c].sum != bench_ref_cols[c].sum) ||
+            (bench_cols[c].count && ((bench_cols[c].min != bench_ref_cols[c].min) || (bench_cols[c].max != bench_ref_cols[c].max))))
+        {
+            errors++;
+        }
+    }
+
+    int32_t sink = 0;
+    uint64_t t0 = HostShim_NowNs();
+    for (uint32_t n = 0U; n < BENCH_QUERIES; n++)
+    {
+        sink += History_Query(bench_ref_channel[r], from, end_s, bench_cols, BENCH_COLUMNS, NULL);
+    }
+    uint64_t t1 = HostShim_NowNs();
+    bench_sink = sink;
+
+    printf("%-22s nivo %u (%4u s) %7lu uzoraka %4u kolona %8.1f us%s\n", name, sum.tier, sum.period_s,
+           (unsigned long)sum.samples, filled, (double)(t1 - t0) / BENCH_QUERIES / 1000.0, errors ? "  GRESKA" : "");
+    return errors;
+}
+
+/**
+ * @brief Preuzima sve blokove jednog nivoa kao preko RS485 i dekodira ih.
+ * @retval uint32_t Broj grešaka.
+ */
+static uint32_t Bench_Export(uint8_t r, uint8_t tier)
+{
+    static uint8_t resp[120];
+    const BenchRef_t* ref = &bench_ref[r][tier];
+    uint32_t errors = 0U, samples = 0U, bytes = 0U, ri = 0U;
+    uint8_t pages = 1U;
+
+    for (uint8_t page = 0U; page < pages; page++)
+    {
+        uint16_t len = History_Serialize(DIAG_HIST_READ, page, bench_ref_channel[r], tier, resp, sizeof(resp));
+        pages = resp[2];
+        if ((len < 14U) || (resp[3] != 1U)) { errors++; break; }
+
+        const uint8_t* p = &resp[4];
+        uint32_t t = ((uint32_t)p[2] << 24) | ((uint32_t)p[3] << 16) | ((uint32_t)p[4] << 8) | p[5];
+        int32_t v = (int16_t)(((uint16_t)p[6] << 8) | p[7]);
+        uint8_t count = p[8], used = p[9], pos = 0U;
+        const uint8_t* data = &p[10];
+        if (len != (uint16_t)(14U + used)) errors++;
+        bytes += HIST_BLOCK_HEADER + used;
+
+        for (uint8_t i = 0U; i < count; i++, t += History_GetPeriod(tier))
+        {
+            if (i != 0U)
+            {
+                uint32_t zz = 0U;
+                uint8_t shift = 0U, c;
+                do { c = data[pos++]; zz |= (uint32_t)(c & 0x7FU) << shift; shift += 7U; } while ((c & 0x80U) && (pos < used));
+                v += (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1U);
+            }
+            while ((ri < ref->count) && (ref->time[ri] < t)) ri++;
+            if ((ri >= ref->count) || (ref->time[ri] != t) || (ref->value[ri] != v)) errors++;
+            samples++;
+        }
+    }
+    if (ri != (ref->count - 1U)) errors++;    // posljednji preuzeti uzorak je posljednji upisani
+
+    printf("Preuzimanje kanal %u nivo %u: %u blokova, %lu uzoraka, %.2f bajta/uzorku: %s\n", bench_ref_channel[r], tier,
+           pages, (unsigned long)samples, samples ? (double)bytes / samples : 0.0, errors ? "GRESKA" : "OK");
+    return errors;
+}
+
+/**
+ * @brief Preuzima sve stranice `DIAG_HIST_STATUS` kao preko RS485.
+ * @note  Stranice moraju pokriti svaki kanal tačno jednom, redom, a broj
+ * popunjenih blokova svakog nivoa mora biti broj stranica `DIAG_HIST_READ`.
+ * @retval uint32_t Broj grešaka.
+ */
+static uint32_t Bench_Status(void)
+{
+    static uint8_t resp[120];   // Kao `DIAG_GET_Listener`
+    static uint8_t read[120];
+    uint32_t errors = 0U;
+    uint8_t pages = 1U, next = 0U, longest = 0U;
+
+    for (uint8_t page = 0U; page < pages; page++)
+    {
+        uint16_t len = History_Serialize(DIAG_HIST_STATUS, page, 0U, 0U, resp, sizeof(resp));
+        pages = resp[2];
+        if ((len < 22U) || (resp[3] != 1U) || (resp[4] != HIST_CHANNELS) || (resp[5] != HIST_TIERS)) { errors++; break; }
+
+        const uint8_t* p = &resp[14U + (2U * HIST_TIERS)];
+        uint8_t first = p[0];
+        uint8_t count = (uint8_t)((len - (15U + (2U * HIST_TIERS))) / HIST_TIERS);
+        if ((first != next) || (count == 0U)) errors++;
+        for (uint8_t ch = first; (ch < first + count) && (ch < HIST_CHANNELS); ch++)
+        {
+            for (uint8_t t = 0U; t < HIST_TIERS; t++)
+            {
+                (void)History_Serialize(DIAG_HIST_READ, 0U, ch, t, read, sizeof(read));
+                if (p[1U + ((ch - first) * HIST_TIERS) + t] != read[2]) errors++;
+            }
+        }
+        next = first + count;
+        if (len > longest) longest = (uint8_t)len;
+    }
+    if (next != HIST_CHANNELS) errors++;
+    if (History_Serialize(DIAG_HIST_STATUS, pages, 0U, 0U, resp, sizeof(resp)) != 4U) errors++;
+
+    printf("Status: %u kanala na %u stranica, najduzi odgovor %u B: %s\n", (unsigned)next, pages, longest,
+           errors ? "GRESKA" : "OK");
+    return errors;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+int main(int argc, char** argv)
+{
+    bool check = (argc > 1) && (strcmp(argv[1], "--check") == 0);
+    uint32_t errors = 0U;
+    uint32_t end_s;
+    double avg_ns;
+    uint64_t max_ns;
+
+    if ((argc > 1) && !check)
+    {
+        fprintf(stderr, "Upotreba: %s [--check]\n", argv[0]);
+        return 1;
+    }
+
+    History_Init();
+    Bench_Fill(&end_s, &avg_ns, &max_ns);
+
+    printf("Istorija: %u kanala x %u nivoa x %u blokova po %u B = %lu KB SDRAM\n", (unsigned)HIST_CHANNELS,
+           (unsigned)HIST_TIERS, (unsigned)HIST_BLOCKS, (unsigned)HIST_BLOCK_SIZE,
+           (unsigned long)(HIST_CHANNELS * HIST_TIERS * HIST_BLOCKS * HIST_BLOCK_SIZE / 1024U));
+    printf("Upis %u dana: %.1f ns prosjek, %llu ns max za svih %u kanala\n", BENCH_DAYS, avg_ns,
+           (unsigned long long)max_ns, (unsigned)HIST_CHANNELS);
+
+    errors += Bench_Query("temperatura 1 h", 0U, end_s, 3600U, 0U);
+    errors += Bench_Query("temperatura 24 h", 0U, end_s, 86400U, 1U);
+    errors += Bench_Query("temperatura 7 dana", 0U, end_s, 7U * 86400U, 2U);
+    errors += Bench_Query("svjetlo 24 h", 1U, end_s, 86400U, 1U);
+    errors += Bench_Query("svjetlo 7 dana (prekid)", 1U, end_s, 7U * 86400U, 2U);
+    errors += Bench_Export(0U, 1U);
+    errors += Bench_Export(1U, 2U);
+    errors += Bench_Status();
+
+    if (check && errors) fprintf(stderr, "history: %lu gresaka\n", (unsigned long)errors);
+    return (check && errors) ? 1 : 0;
+}
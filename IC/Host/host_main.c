@@ -0,0 +1,185 @@
+/**
+ ******************************************************************************
+ * @file    host_main.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Host izvršna verzija glavne petlje aplikacije (`ic_host_loop`).
+ *
+ * @note    Inicijalizuje module istim redoslijedom kao `main()` na uređaju
+ * i vrti aplikacijski dio `while(1)` petlje nad simuliranim vremenom.
+ * Za svaki servis mjeri stvarno trajanje poziva na host procesoru
+ * (`CLOCK_MONOTONIC`) i na kraju ispisuje broj poziva, prosjek i maksimum,
+ * te saobraćaj na RS485 i broj upisa u EEPROM.
+ *
+ * Upotreba: `ic_host_loop [simulirane_ms] [prolaza_po_ms]`
+ * (podrazumijevano 60000 ms i 1 prolaz petlje po milisekundi).
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "thermostat.h"
+#include "ventilator.h"
+#include "defroster.h"
+#include "curtain.h"
+#include "lights.h"
+#include "gate.h"
+#include "scene.h"
+#include "timer.h"
+#include "security.h"
+#include "buzzer.h"
+#include "rs485.h"
+#include "timer_wheel.h"
+#include "devreg.h"
+#include "history.h"
+#include "eventlog.h"
+#include "host_shim.h"
+#include <time.h>
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define HOST_DEFAULT_RUN_MS             60000U  ///< Podrazumijevano trajanje simulacije
+#define HOST_MEASURE(stat, call)        do { uint64_t t0 = Host_Now(); call; Host_Account(&(stat), Host_Now() - t0); } while (0)
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+/**
+ * @brief Zbirna statistika za jedan servis glavne petlje.
+ */
+typedef struct
+{
+    const char* name;
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} HostServiceStat_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+enum { SVC_TIMER, SVC_TIMER_WHEEL, SVC_LIGHT, SVC_CURTAIN, SVC_THSTAT, SVC_VENTILATOR,
+       SVC_SCENE, SVC_RS485, SVC_BUZZER, SVC_HISTORY, SVC_EVENTLOG, SVC_COUNT };
+
+static HostServiceStat_t service_stats[SVC_COUNT] =
+{
+    [SVC_TIMER]      = { "Timer_Service" },
+    [SVC_TIMER_WHEEL] = { "TimerWheel_Service" },
+    [SVC_LIGHT]      = { "LIGHT_Service" },
+    [SVC_CURTAIN]    = { "Curtain_Service" },
+    [SVC_THSTAT]     = { "THSTAT_Service" },
+    [SVC_VENTILATOR] = { "Ventilator_Service" },
+    [SVC_SCENE]      = { "Scene_Service" },
+    [SVC_RS485]      = { "RS485_Service" },
+    [SVC_BUZZER]     = { "Buzzer_Service" },
+    [SVC_HISTORY]    = { "History_Service" },
+    [SVC_EVENTLOG]   = { "EventLog_Service" },
+};
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static uint64_t Host_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void Host_Account(HostServiceStat_t* stat, uint64_t ns)
+{
+    stat->calls++;
+    stat->total_ns += ns;
+    if (ns > stat->max_ns) stat->max_ns = ns;
+}
+
+/**
+ * @brief Jedan prolaz aplikacijskog dijela glavne petlje iz `main.c`.
+ * @note  Izostavljeni su ADC, dodir, ekran, RTC provjera i FW agent, koji
+ * zavise od periferija bez host zamjene. `Timer_Service` se, kao i na
+ * uređaju, poziva dva puta.
+ */
+static void Host_LoopPass(THERMOSTAT_TypeDef* pThst, Ventilator_Handle* pVen)
+{
+    HOST_MEASURE(service_stats[SVC_TIMER], Timer_Service());
+    HOST_MEASURE(service_stats[SVC_TIMER_WHEEL], TimerWheel_Service());
+    HOST_MEASURE(service_stats[SVC_LIGHT], LIGHT_Service());
+    HOST_MEASURE(service_stats[SVC_CURTAIN], Curtain_Service());
+    HOST_MEASURE(service_stats[SVC_THSTAT], THSTAT_Service(pThst));
+    HOST_MEASURE(service_stats[SVC_VENTILATOR], Ventilator_Service(pVen));
+    HOST_MEASURE(service_stats[SVC_SCENE], Scene_Service());
+    HOST_MEASURE(service_stats[SVC_TIMER], Timer_Service());
+    HOST_MEASURE(service_stats[SVC_RS485], RS485_Service());
+    HOST_MEASURE(service_stats[SVC_BUZZER], Buzzer_Service());
+    HOST_MEASURE(service_stats[SVC_HISTORY], History_Service());
+    HOST_MEASURE(service_stats[SVC_EVENTLOG], EventLog_Service());
+}
+
+static void Host_PrintReport(uint32_t run_ms, uint64_t wall_ns)
+{
+    const HostShim_Stats_t* st = HostShim_GetStats();
+
+    printf("Simulirano %lu ms, stvarno %.3f ms\n", (unsigned long)run_ms, (double)wall_ns / 1e6);
+    printf("%-20s %12s %12s %12s\n", "SERVIS", "POZIVA", "AVG ns", "MAX ns");
+    for (int i = 0; i < SVC_COUNT; i++)
+    {
+        const HostServiceStat_t* s = &service_stats[i];
+        printf("%-20s %12llu %12llu %12llu\n", s->name, (unsigned long long)s->calls,
+               (unsigned long long)(s->calls ? (s->total_ns / s->calls) : 0U),
+               (unsigned long long)s->max_ns);
+    }
+    printf("RS485 tx: %lu poziva, %lu bajtova; rx: %lu bajtova, %lu odbačeno\n",
+           (unsigned long)st->uart_tx_calls, (unsigned long)st->uart_tx_bytes,
+           (unsigned long)st->uart_rx_bytes, (unsigned long)st->uart_rx_dropped);
+    printf("EEPROM: %lu čitanja, %lu upisa (%lu bajtova); HAL_Delay: %lu ms\n",
+           (unsigned long)st->ee_reads, (unsigned long)st->ee_writes,
+           (unsigned long)st->ee_write_bytes, (unsigned long)st->delay_ms);
+}
+
+/*============================================================================*/
+/* GLAVNI PROGRAM                                                             */
+/*============================================================================*/
+int main(int argc, char** argv)
+{
+    uint32_t run_ms = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : HOST_DEFAULT_RUN_MS;
+    uint32_t passes = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 1U;
+
+    THERMOSTAT_TypeDef* pThst = Thermostat_GetInstance();
+    Ventilator_Handle* pVen = Ventilator_GetInstance();
+    Defroster_Handle* pDef = Defroster_GetInstance();
+
+    HostShim_Init();
+
+    // Isti redoslijed kao u main() na uređaju, bez periferija i ekrana
+    TimerWheel_Init();
+    DevReg_Init();
+    History_Init();
+    EventLog_Init();
+    RS485_Init();
+    LIGHTS_Init();
+    Curtains_Init();
+    Gate_Init();
+    Scene_Init();
+    Defroster_Init(pDef);
+    Buzzer_Init();
+    THSTAT_Init(pThst);
+    Ventilator_Init(pVen);
+    Timer_Init();
+    Security_Init();
+    HostShim_ResetStats();
+
+    uint64_t start = Host_Now();
+    for (uint32_t ms = 0; ms < run_ms; ms++)
+    {
+        for (uint32_t p = 0; p < passes; p++)
+        {
+            Host_LoopPass(pThst, pVen);
+        }
+        HostShim_Advance(1U);
+    }
+    Host_PrintReport(run_ms, Host_Now() - start);
+
+    return 0;
+}
@@ -0,0 +1,630 @@
+/**
+ ******************************************************************************
+ * @file    host_shim.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Host implementacija HAL/BSP poziva koje koriste moduli aplikacije.
+ *
+ * @note    Prevodi se samo u host build (`IC/Host/CMakeLists.txt`), nikad u
+ * Keil projekat. Funkcije imaju iste potpise kao u HAL-u, pa se moduli
+ * aplikacije prevode bez izmjena:
+ * - `HAL_GetTick`/`HAL_Delay`: simulirani brojač, pomjera ga samo
+ *   `HostShim_Advance` (i `HAL_Delay`, koji troši simulirano vrijeme).
+ * - GPIO: stanje pinova u nizu, indeksirano portom iz adrese periferije.
+ * - RTC: kalendar izveden iz simuliranog vremena.
+ * - CRC: softverski CRC-32 sa istom konfiguracijom kao `MX_CRC_Init`
+ *   (polinom 0x04C11DB7, početna vrijednost 0xFFFFFFFF, ulaz u bajtovima,
+ *   bez inverzije), pa se EEPROM blokovi validiraju isto kao na uređaju.
+ * - I2C EEPROM: RAM slika od `HOST_EEPROM_SIZE` bajtova.
+ * - UART: predaja ide u tx hook, prijem preko `HostShim_UartRx`.
+ * - ADC: `HAL_ADC_Start_DMA` ne radi ništa i DMA prekidi se ne
+ *   simuliraju, pa petlja ne dobija NTC očitanja. Filter se provjerava
+ *   zasebno, `ic_ntc_filter` poziva `NTC_FilterBlock` sa sintetičkim blokovima.
+ * - QSPI: NOR flash dnevnika događaja, mapiran (`mmap`) na `RT_EVLOG_ADDR`.
+ *   Programiranje samo briše bitove (AND), brisanje vraća podsektor na 0xFF,
+ *   a operacija traje `HOST_QSPI_PROGRAM_MS` / `HOST_QSPI_ERASE_MS`
+ *   simuliranog vremena. Van memorijski mapiranog režima stranice su bez
+ *   prava pristupa, kao bus fault na uređaju.
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "rs485.h"
+#include "host_shim.h"
+#include <time.h>
+#include <sys/mman.h>
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define HOST_GPIO_PORT_STEP             0x400U  ///< Razmak adresa GPIO portova (GPIOA_BASE, GPIOB_BASE, ...)
+#define HOST_RTC_DEFAULT_EPOCH          1767225600LL ///< 01.01.2026 00:00:00, početno stanje RTC-a
+#define HOST_QSPI_ERASE_SIZE            0x1000U ///< Podsektor N25Q128A
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+typedef enum
+{
+    HOST_QSPI_IDLE = 0,
+    HOST_QSPI_PROGRAM,
+    HOST_QSPI_ERASE
+} HostShim_QspiOp_e;
+
+/**
+ * @brief Operacija QSPI flash-a u toku; efekat se primjenjuje na kraju.
+ */
+typedef struct
+{
+    uint8_t  op;                            /**< `HostShim_QspiOp_e`. */
+    uint32_t offset;                        /**< Od `RT_EVLOG_ADDR`. */
+    uint32_t len;
+    uint32_t done;                          /**< `sim_tick` završetka. */
+    uint8_t  data[QSPI_PAGE_SIZE];
+} HostShim_Qspi_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static volatile uint32_t sim_tick;          ///< Simulirani `HAL_GetTick()`
+static uint16_t gpio_odr[HOST_GPIO_PORTS];  ///< Stanje pinova po portu
+static uint8_t eeprom[HOST_EEPROM_SIZE];    ///< Slika I2C EEPROM-a
+static int64_t rtc_epoch;                   ///< Unix vrijeme u trenutku `rtc_epoch_tick`
+static uint32_t rtc_epoch_tick;             ///< `sim_tick` kada je RTC zadnji put postavljen
+static uint8_t* uart_rx_ptr;                ///< Bafer iz posljednjeg `HAL_UART_Receive_IT`
+static bool uart_rx_armed;
+static HostShim_TxHook_t tx_hook;
+static HostShim_TickHook_t tick_hook;
+static HostShim_QspiHook_t qspi_hook;
+static HostShim_Stats_t stats;
+static uint8_t* qspi_flash;                 ///< Prostor dnevnika, na adresi `RT_EVLOG_ADDR`
+static bool qspi_mapped;                    ///< Memorijski mapiran režim
+static HostShim_Qspi_t qspi;
+static uint32_t qspi_rand = 0x2545F491U;    ///< xorshift32 za djelimične upise
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static int HostShim_GpioPort(const GPIO_TypeDef* GPIOx)
+{
+    uintptr_t offset = (uintptr_t)GPIOx - (uintptr_t)GPIOA_BASE;
+    uint32_t port = (uint32_t)(offset / HOST_GPIO_PORT_STEP);
+
+    return (port < HOST_GPIO_PORTS) ? (int)port : -1;
+}
+
+static uint8_t HostShim_ToBcd(uint8_t value)
+{
+    return (uint8_t)(((value / 10U) << 4) | (value % 10U));
+}
+
+static uint8_t HostShim_FromBcd(uint8_t value)
+{
+    return (uint8_t)(((value >> 4) * 10U) + (value & 0x0FU));
+}
+
+/**
+ * @brief Trenutno simulirano vrijeme kalendara, u sekundama od 1970.
+ */
+static int64_t HostShim_RtcNow(void)
+{
+    return rtc_epoch + (int64_t)((sim_tick - rtc_epoch_tick) / 1000U);
+}
+
+static void HostShim_RtcSet(const struct tm* t)
+{
+    struct tm tmp = *t;
+
+    // Ostatak tekuće sekunde se zadržava, kao kod upisa u RTC registre
+    rtc_epoch_tick = sim_tick - ((sim_tick - rtc_epoch_tick) % 1000U);
+    rtc_epoch = (int64_t)timegm(&tmp);
+}
+
+static void HostShim_RtcGet(struct tm* t)
+{
+    time_t now = (time_t)HostShim_RtcNow();
+    gmtime_r(&now, t);
+}
+
+static uint8_t HostShim_QspiRand(void)
+{
+    return (uint8_t)(HostShim_Rand(&qspi_rand) >> 24);
+}
+
+/**
+ * @brief Mapira prostor dnevnika na istu adresu kao na uređaju (jednom).
+ */
+static void HostShim_QspiMap(void)
+{
+    void* want = (void*)(uintptr_t)RT_EVLOG_ADDR;
+    void* got;
+
+    if (qspi_flash != NULL) return;
+    got = mmap(want, RT_EVLOG_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (got != want)
+    {
+        fprintf(stderr, "QSPI: adresa 0x%08X nije slobodna za simulirani flash\n", (unsigned)RT_EVLOG_ADDR);
+        exit(1);
+    }
+    qspi_flash = (uint8_t*)got;
+}
+
+static void HostShim_QspiAccess(bool readable)
+{
+    mprotect(qspi_flash, RT_EVLOG_SIZE, readable ? PROT_READ : PROT_NONE);
+}
+
+/**
+ * @brief Primjenjuje operaciju u toku; `cut` ostavlja nasumično djelimičan
+ * efekat (dio bitova programiran ili obrisan), kao nestanak napajanja.
+ */
+static void HostShim_QspiApply(bool cut)
+{
+    uint8_t* p = &qspi_flash[qspi.offset];
+
+    mprotect(qspi_flash, RT_EVLOG_SIZE, PROT_READ | PROT_WRITE);
+    for (uint32_t i = 0U; i < qspi.len; i++)
+    {
+        if (qspi.op == HOST_QSPI_PROGRAM) p[i] &= cut ? (uint8_t)(qspi.data[i] | HostShim_QspiRand()) : qspi.data[i];
+        else p[i] = cut ? (uint8_t)(p[i] | HostShim_QspiRand()) : 0xFFU;
+    }
+    if (cut) stats.qspi_cuts++;
+    else if (qspi.op == HOST_QSPI_PROGRAM) stats.qspi_programs++;
+    else stats.qspi_erases++;
+    qspi.op = HOST_QSPI_IDLE;
+    HostShim_QspiAccess(qspi_mapped);
+}
+
+/**
+ * @brief Pokreće operaciju ako je flash slobodan i adresa u prostoru dnevnika.
+ */
+static uint8_t HostShim_QspiStart(uint8_t op, uint32_t addr, uint32_t len, uint32_t ms)
+{
+    if (qspi_mapped || (qspi.op != HOST_QSPI_IDLE) || (addr < RT_EVLOG_ADDR) ||
+        ((addr - RT_EVLOG_ADDR + len) > RT_EVLOG_SIZE)) return QSPI_ERROR;
+    qspi.op = op;
+    qspi.offset = addr - RT_EVLOG_ADDR;
+    qspi.len = len;
+    qspi.done = sim_tick + ms;
+    return QSPI_OK;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE - SHIM API                                                  */
+/*============================================================================*/
+
+/**
+ * @brief Vraća shim u početno stanje: vrijeme 0, EEPROM obrisan (0xFF),
+ * svi pinovi na 0 i RTC na `HOST_RTC_DEFAULT_EPOCH`.
+ */
+void HostShim_Init(void)
+{
+    sim_tick = 0U;
+    memset(gpio_odr, 0, sizeof(gpio_odr));
+    HostShim_EepromErase();
+    rtc_epoch = HOST_RTC_DEFAULT_EPOCH;
+    rtc_epoch_tick = 0U;
+    uart_rx_ptr = NULL;
+    uart_rx_armed = false;
+    tx_hook = NULL;
+    tick_hook = NULL;
+    qspi_hook = NULL;
+    HostShim_ResetStats();
+    HostShim_QspiMap();
+    HostShim_QspiErase();
+
+    huart1.Instance = USART1;
+    hcrc.Instance = CRC;
+}
+
+void HostShim_SetTxHook(HostShim_TxHook_t hook)
+{
+    tx_hook = hook;
+}
+
+void HostShim_SetTickHook(HostShim_TickHook_t hook)
+{
+    tick_hook = hook;
+}
+
+void HostShim_SetQspiHook(HostShim_QspiHook_t hook)
+{
+    qspi_hook = hook;
+}
+
+/**
+ * @brief Pomjera simulirano vrijeme za `ms` milisekundi.
+ * @note  Za svaku milisekundu radi isto što i `SysTick_Handler` na uređaju.
+ */
+void HostShim_Advance(uint32_t ms)
+{
+    while (ms--)
+    {
+        HAL_IncTick();
+        RS485_Tick();
+        if (tick_hook != NULL) tick_hook(sim_tick);
+    }
+}
+
+void HostShim_SetDateTime(uint16_t year, uint8_t month, uint8_t date, uint8_t hours, uint8_t minutes, uint8_t seconds)
+{
+    struct tm t = {0};
+
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = date;
+    t.tm_hour = hours;
+    t.tm_min = minutes;
+    t.tm_sec = seconds;
+    HostShim_RtcSet(&t);
+}
+
+/**
+ * @brief Predaje primljene bajtove aplikaciji, bajt po bajt, kao UART prekid.
+ * @note  Bajt se odbacuje ako aplikacija nije naoružala prijem, isto kao
+ * overrun na uređaju.
+ */
+void HostShim_UartRx(const uint8_t* data, uint16_t len)
+{
+    while (len--)
+    {
+        if (!uart_rx_armed)
+        {
+            stats.uart_rx_dropped++;
+            data++;
+            continue;
+        }
+        uart_rx_armed = false;
+        *uart_rx_ptr = *data++;
+        stats.uart_rx_bytes++;
+        HAL_UART_RxCpltCallback(&huart1);
+    }
+}
+
+void HostShim_GpioSet(uint8_t port, uint16_t pin, bool state)
+{
+    if (port >= HOST_GPIO_PORTS) return;
+    if (state) gpio_odr[port] |= pin;
+    else       gpio_odr[port] &= (uint16_t)~pin;
+}
+
+bool HostShim_GpioGet(uint8_t port, uint16_t pin)
+{
+    if (port >= HOST_GPIO_PORTS) return false;
+    return (gpio_odr[port] & pin) != 0U;
+}
+
+uint8_t* HostShim_Eeprom(void)
+{
+    return eeprom;
+}
+
+void HostShim_EepromErase(void)
+{
+    memset(eeprom, 0xFF, sizeof(eeprom));
+}
+
+/**
+ * @brief Briše simulirani flash (0xFF) i ostavlja ga memorijski mapiranog,
+ * kao nakon `MX_QSPI_Init` i `QSPI_MemMapMode` u `main()`.
+ */
+void HostShim_QspiErase(void)
+{
+    qspi.op = HOST_QSPI_IDLE;
+    qspi_mapped = true;
+    mprotect(qspi_flash, RT_EVLOG_SIZE, PROT_READ | PROT_WRITE);
+    memset(qspi_flash, 0xFF, RT_EVLOG_SIZE);
+    HostShim_QspiAccess(true);
+}
+
+/**
+ * @brief Nestanak napajanja: operacija u toku ostaje djelimična ako nije
+ * stigla do kraja, a QSPI ostaje nemapiran dok ga ne pokrene `MX_QSPI_Init`
+ * i `QSPI_MemMapMode`.
+ */
+void HostShim_QspiPowerCut(void)
+{
+    if (qspi.op != HOST_QSPI_IDLE) HostShim_QspiApply((int32_t)(sim_tick - qspi.done) < 0);
+    qspi_mapped = false;
+    HostShim_QspiAccess(false);
+}
+
+const HostShim_Stats_t* HostShim_GetStats(void)
+{
+    return &stats;
+}
+
+void HostShim_ResetStats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * @brief Pseudo-slučajan broj (xorshift32) iz stanja koje drži pozivalac.
+ * @note  Svaki bench ima svoje početno stanje, pa je svako pokretanje ponovljivo.
+ * @param state Stanje generatora, ne smije biti 0.
+ */
+uint32_t HostShim_Rand(uint32_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * @brief Stvarno (ne simulirano) vrijeme u nanosekundama, za mjerenje trajanja.
+ */
+uint64_t HostShim_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE - HAL ZAMJENE                                               */
+/*============================================================================*/
+void HAL_IncTick(void)
+{
+    sim_tick++;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return sim_tick;
+}
+
+/**
+ * @brief Blokirajuće čekanje troši simulirano vrijeme, uz sve tick događaje.
+ */
+void HAL_Delay(__IO uint32_t Delay)
+{
+    stats.delay_ms += Delay;
+    HostShim_Advance(Delay);
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+    return HOST_HCLK_FREQ;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    int port = HostShim_GpioPort(GPIOx);
+    if (port >= 0) HostShim_GpioSet((uint8_t)port, GPIO_Pin, PinState == GPIO_PIN_SET);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    int port = HostShim_GpioPort(GPIOx);
+    if (port < 0) return GPIO_PIN_RESET;
+    return HostShim_GpioGet((uint8_t)port, GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format)
+{
+    struct tm t;
+
+    (void)hrtc;
+    HostShim_RtcGet(&t);
+    t.tm_hour = (Format == RTC_FORMAT_BCD) ? HostShim_FromBcd(sTime->Hours) : sTime->Hours;
+    t.tm_min = (Format == RTC_FORMAT_BCD) ? HostShim_FromBcd(sTime->Minutes) : sTime->Minutes;
+    t.tm_sec = (Format == RTC_FORMAT_BCD) ? HostShim_FromBcd(sTime->Seconds) : sTime->Seconds;
+    HostShim_RtcSet(&t);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format)
+{
+    struct tm t;
+
+    (void)hrtc;
+    HostShim_RtcGet(&t);
+    sTime->Hours = (uint8_t)t.tm_hour;
+    sTime->Minutes = (uint8_t)t.tm_min;
+    sTime->Seconds = (uint8_t)t.tm_sec;
+    sTime->SubSeconds = 0U;
+    if (Format == RTC_FORMAT_BCD)
+    {
+        sTime->Hours = HostShim_ToBcd(sTime->Hours);
+        sTime->Minutes = HostShim_ToBcd(sTime->Minutes);
+        sTime->Seconds = HostShim_ToBcd(sTime->Seconds);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format)
+{
+    struct tm t;
+
+    (void)hrtc;
+    HostShim_RtcGet(&t);
+    t.tm_year = 100 + ((Format == RTC_FORMAT_BCD) ? HostShim_FromBcd(sDate->Year) : sDate->Year);
+    t.tm_mon = ((Format == RTC_FORMAT_BCD) ? HostShim_FromBcd(sDate->Month) : sDate->Month) - 1;
+    t.tm_mday = (Format == RTC_FORMAT_BCD) ? HostShim_FromBcd(sDate->Date) : sDate->Date;
+    HostShim_RtcSet(&t);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format)
+{
+    struct tm t;
+
+    (void)hrtc;
+    HostShim_RtcGet(&t);
+    sDate->Year = (uint8_t)(t.tm_year - 100);
+    sDate->Month = (uint8_t)(t.tm_mon + 1);
+    sDate->Date = (uint8_t)t.tm_mday;
+    sDate->WeekDay = (uint8_t)((t.tm_wday == 0) ? RTC_WEEKDAY_SUNDAY : t.tm_wday);
+    if (Format == RTC_FORMAT_BCD)
+    {
+        sDate->Year = HostShim_ToBcd(sDate->Year);
+        sDate->Month = HostShim_ToBcd(sDate->Month);
+        sDate->Date = HostShim_ToBcd(sDate->Date);
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief RTC alarmi se na hostu ne okidaju; `Timer_Service` i dalje
+ * osvježava keširano vrijeme svoje periodične rezervne provjere.
+ */
+HAL_StatusTypeDef HAL_RTC_SetAlarm_IT(RTC_HandleTypeDef *hrtc, RTC_AlarmTypeDef *sAlarm, uint32_t Format)
+{
+    (void)hrtc;
+    (void)sAlarm;
+    (void)Format;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_DeactivateAlarm(RTC_HandleTypeDef *hrtc, uint32_t Alarm)
+{
+    (void)hrtc;
+    (void)Alarm;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef* hadc, uint32_t* pData, uint32_t Length)
+{
+    (void)hadc;
+    (void)pData;
+    (void)Length;
+    return HAL_OK;
+}
+
+uint8_t Bcd2Dec(uint8_t val)
+{
+    return HostShim_FromBcd(val);
+}
+
+/**
+ * @brief Softverski CRC-32 sa konfiguracijom iz `MX_CRC_Init`.
+ * @note  `BufferLength` je u bajtovima (`CRC_INPUTDATA_FORMAT_BYTES`).
+ */
+uint32_t HAL_CRC_Calculate(CRC_HandleTypeDef *hcrc, uint32_t pBuffer[], uint32_t BufferLength)
+{
+    const uint8_t* p = (const uint8_t*)pBuffer;
+    uint32_t crc = 0xFFFFFFFFU;
+
+    (void)hcrc;
+    while (BufferLength--)
+    {
+        crc ^= (uint32_t)(*p++) << 24;
+        for (uint8_t bit = 0; bit < 8U; bit++)
+        {
+            crc = (crc & 0x80000000U) ? ((crc << 1) ^ 0x04C11DB7U) : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)huart;
+    (void)Timeout;
+    stats.uart_tx_calls++;
+    stats.uart_tx_bytes += Size;
+    if (tx_hook != NULL) tx_hook(pData, Size);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    (void)huart;
+    (void)Size;
+    uart_rx_ptr = pData;
+    uart_rx_armed = true;
+    return HAL_OK;
+}
+
+/**
+ * @brief Isto rutiranje kao `HAL_UART_RxCpltCallback` u `main.c`.
+ */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef* huart)
+{
+    if (huart->Instance == USART1)
+    {
+        RS485_RxCpltCallback();
+    }
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE - BSP ZAMJENE                                               */
+/*============================================================================*/
+uint32_t EE_ReadBuffer(uint8_t *pBuffer, uint16_t ReadAddr, uint16_t NumByteToRead)
+{
+    stats.ee_reads++;
+    if (((uint32_t)ReadAddr + NumByteToRead) > HOST_EEPROM_SIZE) return 1U;
+    memcpy(pBuffer, &eeprom[ReadAddr], NumByteToRead);
+    return 0U;
+}
+
+uint32_t EE_WriteBuffer(uint8_t *pBuffer, uint16_t WriteAddr, uint16_t NumByteToWrite)
+{
+    stats.ee_writes++;
+    if (((uint32_t)WriteAddr + NumByteToWrite) > HOST_EEPROM_SIZE) return 1U;
+    memcpy(&eeprom[WriteAddr], pBuffer, NumByteToWrite);
+    stats.ee_write_bytes += NumByteToWrite;
+    return 0U;
+}
+
+/**
+ * @brief Reset memorije prekida operaciju u toku (djelimičan efekat).
+ */
+void MX_QSPI_Init(void)
+{
+    if (qspi.op != HOST_QSPI_IDLE) HostShim_QspiApply((int32_t)(sim_tick - qspi.done) < 0);
+    qspi_mapped = false;
+    HostShim_QspiAccess(false);
+}
+
+uint8_t QSPI_MemMapMode(void)
+{
+    if (qspi.op != HOST_QSPI_IDLE) return QSPI_ERROR;   // upis konfiguracije ne prolazi dok je flash zauzet
+    qspi_mapped = true;
+    HostShim_QspiAccess(true);
+    return QSPI_OK;
+}
+
+uint8_t QSPI_IndirectMode(void)
+{
+    qspi_mapped = false;
+    HostShim_QspiAccess(false);
+    return QSPI_OK;
+}
+
+uint8_t QSPI_GetStatus(void)
+{
+    if (qspi_mapped) return QSPI_ERROR;
+    if (qspi.op == HOST_QSPI_IDLE) return QSPI_OK;
+    if ((int32_t)(sim_tick - qspi.done) < 0) return QSPI_BUSY;
+    HostShim_QspiApply(false);
+    return QSPI_OK;
+}
+
+uint8_t QSPI_WritePageStart(uint8_t* pbuf, uint32_t wraddr, uint32_t size)
+{
+    if ((size == 0U) || (size > QSPI_PAGE_SIZE) || (((wraddr % QSPI_PAGE_SIZE) + size) > QSPI_PAGE_SIZE)) return QSPI_ERROR;
+    if (HostShim_QspiStart(HOST_QSPI_PROGRAM, wraddr, size, HOST_QSPI_PROGRAM_MS) != QSPI_OK) return QSPI_ERROR;
+    memcpy(qspi.data, pbuf, size);
+    return QSPI_OK;
+}
+
+uint8_t QSPI_EraseSubsectorStart(uint32_t addr)
+{
+    addr -= addr % HOST_QSPI_ERASE_SIZE;
+    return HostShim_QspiStart(HOST_QSPI_ERASE, addr, HOST_QSPI_ERASE_SIZE, HOST_QSPI_ERASE_MS);
+}
+
+/**
+ * @brief Host nema keš ispred simuliranog flash-a; poziva se samo hook.
+ */
+void QSPI_InvalidateCache(uint32_t addr, uint32_t size)
+{
+    (void)addr;
+    (void)size;
+    if (qspi_hook != NULL) qspi_hook();
+}
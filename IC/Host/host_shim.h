@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file    host_shim.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Javni API host shim sloja za prevođenje aplikacije na Linux-u.
+ *
+ * @note    Shim zamjenjuje HAL/BSP pozive koje koriste moduli aplikacije
+ * (`HAL_GetTick`, GPIO, RTC, CRC, I2C EEPROM, UART) simulacijom u RAM-u.
+ * Vrijeme teče samo kroz `HostShim_Advance`, pa je svako pokretanje
+ * ponovljivo. Svaka simulirana milisekunda radi isto što i `SysTick_Handler`
+ * na uređaju (`HAL_IncTick` + `RS485_Tick`) i poziva opcionalni tick hook.
+ *
+ * QSPI NOR flash je simuliran samo u prostoru dnevnika događaja
+ * (`RT_EVLOG_ADDR`, `RT_EVLOG_SIZE`), mapiranom na istu adresu kao na
+ * uređaju. Dok QSPI nije memorijski mapiran prostor je nečitljiv, pa svaki
+ * pristup u tom stanju ruši program. `HostShim_QspiPowerCut` prekida
+ * programiranje ili brisanje u toku i ostavlja djelimično upisane bitove.
+ ******************************************************************************
+ */
+
+#ifndef __HOST_SHIM_H__
+#define __HOST_SHIM_H__
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Konfiguracija shim sloja
+ *  @{
+ */
+#define HOST_HCLK_FREQ                  216000000U  ///< Takt koji vraća `HAL_RCC_GetHCLKFreq` (kao na uređaju)
+#define HOST_GPIO_PORTS                 11U         ///< GPIOA..GPIOK
+#define HOST_EEPROM_SIZE                0x10000U    ///< Pokriva cijeli 16-bitni adresni prostor `EE_xxx` funkcija
+#define HOST_QSPI_PROGRAM_MS            1U          ///< Trajanje programiranja stranice
+#define HOST_QSPI_ERASE_MS              250U        ///< Trajanje brisanja podsektora (tipično za N25Q128A)
+/** @} */
+
+/**
+ * @brief Callback za bajtove koje aplikacija šalje na RS485 (`HAL_UART_Transmit`).
+ */
+typedef void (*HostShim_TxHook_t)(const uint8_t* data, uint16_t len);
+
+/**
+ * @brief Callback koji se poziva nakon svake simulirane milisekunde.
+ */
+typedef void (*HostShim_TickHook_t)(uint32_t tick);
+
+/**
+ * @brief Callback iz `QSPI_InvalidateCache`. Dnevnik ga poziva kada vrati
+ * mapiran režim, prvi put van kritične sekcije, pa benchmark tu simulira
+ * prekid koji na uređaju zatekne provjeru u `EventLog_Service`.
+ */
+typedef void (*HostShim_QspiHook_t)(void);
+
+/**
+ * @brief Brojači shim sloja, za mjerenje saobraćaja i pristupa EEPROM-u.
+ */
+typedef struct
+{
+    uint32_t uart_tx_calls;     /**< Broj `HAL_UART_Transmit` poziva. */
+    uint32_t uart_tx_bytes;     /**< Ukupno poslanih bajtova. */
+    uint32_t uart_rx_bytes;     /**< Bajtova predatih aplikaciji preko `HostShim_UartRx`. */
+    uint32_t uart_rx_dropped;   /**< Bajtova odbačenih jer prijem nije bio naoružan. */
+    uint32_t ee_reads;          /**< Broj `EE_ReadBuffer` poziva. */
+    uint32_t ee_writes;         /**< Broj `EE_WriteBuffer` poziva. */
+    uint32_t ee_write_bytes;    /**< Ukupno upisanih bajtova u EEPROM. */
+    uint32_t delay_ms;          /**< Ukupno simuliranih ms potrošenih u `HAL_Delay`. */
+    uint32_t qspi_programs;     /**< Završenih programiranja stranice. */
+    uint32_t qspi_erases;       /**< Završenih brisanja podsektora. */
+    uint32_t qspi_cuts;         /**< Operacija prekinutih resetom ili nestankom napajanja. */
+} HostShim_Stats_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija ---
+void HostShim_Init(void);
+void HostShim_SetTxHook(HostShim_TxHook_t hook);
+void HostShim_SetTickHook(HostShim_TickHook_t hook);
+void HostShim_SetQspiHook(HostShim_QspiHook_t hook);
+
+// --- Grupa 2: Simulirano vrijeme ---
+void HostShim_Advance(uint32_t ms);
+void HostShim_SetDateTime(uint16_t year, uint8_t month, uint8_t date, uint8_t hours, uint8_t minutes, uint8_t seconds);
+
+// --- Grupa 3: Periferije ---
+void HostShim_UartRx(const uint8_t* data, uint16_t len);
+void HostShim_GpioSet(uint8_t port, uint16_t pin, bool state);
+bool HostShim_GpioGet(uint8_t port, uint16_t pin);
+uint8_t* HostShim_Eeprom(void);
+void HostShim_EepromErase(void);
+void HostShim_QspiErase(void);
+void HostShim_QspiPowerCut(void);
+
+// --- Grupa 4: Statistika ---
+const HostShim_Stats_t* HostShim_GetStats(void);
+void HostShim_ResetStats(void);
+
+// --- Grupa 5: Pomoćne funkcije za benchmark-ove ---
+uint32_t HostShim_Rand(uint32_t* state);
+uint64_t HostShim_NowNs(void);
+
+#endif // __HOST_SHIM_H__
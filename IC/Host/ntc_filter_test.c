@@ -0,0 +1,238 @@
+/**
+ ******************************************************************************
+ * @file    ntc_filter_test.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Provjera NTC filtera sa sintetičkim ADC blokovima (`ic_ntc_filter`).
+ *
+ * @note    Poziva `NTC_FilterBlock` isto kao DMA prekid u `ntc.c`, blok po
+ * blok od `NTC_BLOCK_SAMPLES` 12-bitnih uzoraka, i čita rezultat preko
+ * `NTC_Read`. Scenariji:
+ * - skok ulaza: filter prati skok bez preskoka i tačno dostiže novu
+ *   vrijednost, a 63 % skoka prelazi za približno 2^`NTC_EMA_SHIFT` blokova;
+ * - pojedinačni uzorci punog opsega (smetnje) u inače mirnom signalu;
+ * - puni opseg, odspojen senzor i kratak spoj, uključujući same pragove
+ *   `NTC_OPEN_LOW` i `NTC_OPEN_HIGH`, i ponovno spajanje senzora;
+ * - objava očitanja svakih `NTC_BLOCKS_PER_REPORT` blokova.
+ *
+ *   ic_ntc_filter
+ *
+ * Bez argumenata ispisuje odziv na skok. Sa `--check` izlazni kod je 1 ako
+ * bilo koja provjera ne prođe; neuspjele provjere se ispisuju.
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "ntc.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define TEST_LEVEL_A                    2048U   ///< 12-bitni ulaz prije skoka (oko 25 °C)
+#define TEST_LEVEL_B                    2560U   ///< 12-bitni ulaz nakon skoka
+#define TEST_TAU                        (1U << NTC_EMA_SHIFT)   ///< Vremenska konstanta u blokovima
+#define TEST_SETTLE_BLOCKS              (12U * TEST_TAU)        ///< Najviše blokova do tačne vrijednosti
+#define TEST_SPIKE_MAX_X16              32U     ///< Najveći otklon izlaza od jedne smetnje (2 koraka ADC-a)
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static uint16_t test_block[NTC_BLOCK_SAMPLES];
+static uint32_t test_failures;
+static uint32_t test_reports;
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+static void Test_Expect(bool ok, const char* what, uint32_t got, uint32_t want)
+{
+    if (ok) return;
+    fprintf(stderr, "GREŠKA: %s (dobijeno %lu, očekivano %lu)\n", what, (unsigned long)got, (unsigned long)want);
+    test_failures++;
+}
+
+/**
+ * @brief Predaje filteru blok sa svim uzorcima jednakim `level`, osim
+ * `spikes` uzoraka na vrijednosti `spike`.
+ */
+static void Test_Block(uint16_t level, uint16_t spikes, uint16_t spike)
+{
+    for (uint16_t i = 0U; i < NTC_BLOCK_SAMPLES; i++) test_block[i] = level;
+    for (uint16_t i = 0U; i < spikes; i++) test_block[(i * 7U + 3U) % NTC_BLOCK_SAMPLES] = spike;
+    if (NTC_FilterBlock(test_block, NTC_BLOCK_SAMPLES)) test_reports++;
+}
+
+/**
+ * @brief Predaje blokove dok ne stigne objava, pa je preuzima.
+ */
+static void Test_Report(uint16_t level, uint16_t spikes, uint16_t spike, NTC_Sample_t* s)
+{
+    uint32_t reports = test_reports;
+
+    while (reports == test_reports) Test_Block(level, spikes, spike);
+    Test_Expect(NTC_Read(s), "NTC_Read ne vidi novu objavu", 0U, 1U);
+}
+
+static void Test_Restart(void)
+{
+    NTC_Sample_t s;
+
+    NTC_FilterReset();
+    test_reports = 0U;
+    (void)NTC_Read(&s);
+}
+
+/**
+ * @brief Skok ulaza: monotono, bez preskoka, 63 % oko `TEST_TAU`, tačno na kraju.
+ */
+static void Test_Step(bool print)
+{
+    const uint16_t a = TEST_LEVEL_A * 16U;
+    const uint16_t b = TEST_LEVEL_B * 16U;
+    const uint16_t mark63 = (uint16_t)(a + ((uint32_t)(b - a) * 632U) / 1000U);
+    uint16_t last = a;
+    uint32_t blocks = 0U, at63 = 0U, settled = 0U;
+    NTC_Sample_t s;
+
+    Test_Restart();
+    Test_Report(TEST_LEVEL_A, 0U, 0U, &s);
+    Test_Expect((s.raw == a) && (s.filtered == a), "prvi blok ne postavlja filter", s.filtered, a);
+    Test_Expect(!s.open, "ispravan signal prijavljen kao odspojen", 1U, 0U);
+
+    if (print) printf("%8s %8s %8s %8s\n", "BLOK", "RAW", "FILTER", "°C/10");
+    while (blocks < TEST_SETTLE_BLOCKS)
+    {
+        Test_Report(TEST_LEVEL_B, 0U, 0U, &s);
+        blocks += NTC_BLOCKS_PER_REPORT;
+        if (print) printf("%8lu %8u %8u %8d\n", (unsigned long)blocks, s.raw, s.filtered, NTC_ToDeciCelsius(s.filtered));
+        Test_Expect((s.filtered >= last) && (s.filtered <= b), "odziv na skok nije monoton ili ima preskok", s.filtered, b);
+        if ((at63 == 0U) && (s.filtered >= mark63)) at63 = blocks;
+        if ((settled == 0U) && (s.filtered == b)) settled = blocks;
+        last = s.filtered;
+    }
+    if (print) printf("63 %% skoka za %lu blokova, tačna vrijednost za %lu blokova\n",
+                      (unsigned long)at63, (unsigned long)settled);
+    // Objava je svakih NTC_BLOCKS_PER_REPORT blokova, pa je i mjerenje u tim koracima
+    Test_Expect((at63 >= TEST_TAU - NTC_BLOCKS_PER_REPORT) && (at63 <= TEST_TAU + NTC_BLOCKS_PER_REPORT),
+                "63 % skoka nije oko 2^NTC_EMA_SHIFT blokova", at63, TEST_TAU);
+    Test_Expect(settled != 0U, "filter ne dostiže novu vrijednost", last, b);
+
+    // Skok naniže se isto tačno završava
+    for (blocks = 0U; blocks < TEST_SETTLE_BLOCKS; blocks += NTC_BLOCKS_PER_REPORT) Test_Report(TEST_LEVEL_A, 0U, 0U, &s);
+    Test_Expect(s.filtered == a, "filter ne dostiže vrijednost nakon skoka naniže", s.filtered, a);
+}
+
+/**
+ * @brief Smetnje: jedan uzorak punog opsega ili nule u bloku jedva pomjera izlaz.
+ */
+static void Test_Spikes(void)
+{
+    const uint16_t a = TEST_LEVEL_A * 16U;
+    uint16_t worst = 0U;
+    NTC_Sample_t s;
+
+    Test_Restart();
+    Test_Report(TEST_LEVEL_A, 0U, 0U, &s);
+    for (uint32_t i = 0U; i < 64U; i++)
+    {
+        Test_Block(TEST_LEVEL_A, 1U, ((i & 1U) != 0U) ? 4095U : 0U);
+        (void)NTC_Read(&s);
+        Test_Expect(!s.open, "smetnja prijavljena kao odspojen senzor", 1U, 0U);
+        uint16_t dev = (s.filtered > a) ? (s.filtered - a) : (a - s.filtered);
+        if (dev > worst) worst = dev;
+    }
+    Test_Expect(worst <= TEST_SPIKE_MAX_X16, "smetnja previše pomjera izlaz filtera", worst, TEST_SPIKE_MAX_X16);
+
+    // Uzastopne smetnje naviše nagomilavaju otklon, ali se filter vraća
+    for (uint32_t i = 0U; i < 16U; i++) Test_Block(TEST_LEVEL_A, 4U, 4095U);
+    for (uint32_t i = 0U; i < TEST_SETTLE_BLOCKS; i += NTC_BLOCKS_PER_REPORT) Test_Report(TEST_LEVEL_A, 0U, 0U, &s);
+    Test_Expect(s.filtered == a, "filter se ne vraća nakon niza smetnji", s.filtered, a);
+}
+
+/**
+ * @brief Puni opseg, odspojen senzor, kratak spoj i pragovi.
+ */
+static void Test_Faults(void)
+{
+    static const struct
+    {
+        uint16_t level;
+        bool open;
+    } cases[] =
+    {
+        { 4095U,                true  },    // puni opseg
+        { NTC_OPEN_HIGH + 1U,   true  },    // odspojen senzor
+        { NTC_OPEN_HIGH,        false },
+        { NTC_OPEN_LOW,         false },
+        { NTC_OPEN_LOW - 1U,    true  },    // kratak spoj
+        { 0U,                   true  },
+    };
+    const uint16_t a = TEST_LEVEL_A * 16U;
+    NTC_Sample_t s;
+
+    for (uint32_t i = 0U; i < (sizeof(cases) / sizeof(cases[0])); i++)
+    {
+        Test_Restart();
+        Test_Report(TEST_LEVEL_A, 0U, 0U, &s);
+        Test_Report(cases[i].level, 0U, 0U, &s);
+        Test_Expect(s.raw == (uint16_t)(cases[i].level * 16U), "raw nije prosjek bloka x16", s.raw, cases[i].level * 16U);
+        Test_Expect(s.open == cases[i].open, "pogrešna procjena odspojenog senzora", cases[i].level, cases[i].open);
+        if (cases[i].open)
+        {
+            // Greška zadržava posljednji ispravan izlaz ...
+            Test_Expect(s.filtered == a, "greška senzora mijenja izlaz filtera", s.filtered, a);
+            // ... a prvi ispravan blok nakon nje odmah postavlja filter
+            Test_Report(TEST_LEVEL_B, 0U, 0U, &s);
+            Test_Expect(!s.open && (s.filtered == TEST_LEVEL_B * 16U), "ponovno spajanje ne postavlja filter",
+                        s.filtered, TEST_LEVEL_B * 16U);
+        }
+    }
+
+    Test_Restart();
+    Test_Report(4095U, 0U, 0U, &s);
+    Test_Expect(s.raw == NTC_FULL_SCALE, "puni opseg nije NTC_FULL_SCALE", s.raw, NTC_FULL_SCALE);
+    Test_Expect(NTC_ToDeciCelsius(s.raw) == NTC_TEMP_MIN, "puni opseg nije NTC_TEMP_MIN", (uint32_t)NTC_ToDeciCelsius(s.raw), (uint32_t)NTC_TEMP_MIN);
+}
+
+/**
+ * @brief Objava svakih `NTC_BLOCKS_PER_REPORT` blokova, `NTC_Read` jednom po objavi.
+ */
+static void Test_Reports(void)
+{
+    NTC_Sample_t s;
+
+    Test_Restart();
+    for (uint32_t i = 1U; i <= 10U * NTC_BLOCKS_PER_REPORT; i++)
+    {
+        uint32_t before = test_reports;
+        Test_Block(TEST_LEVEL_A, 0U, 0U);
+        bool reported = (test_reports != before);
+        Test_Expect(reported == ((i % NTC_BLOCKS_PER_REPORT) == 0U), "objava van NTC_BLOCKS_PER_REPORT", i, NTC_BLOCKS_PER_REPORT);
+        Test_Expect(NTC_Read(&s) == reported, "NTC_Read ne odgovara objavama", i, reported);
+    }
+}
+
+/*============================================================================*/
+/* GLAVNI PROGRAM                                                             */
+/*============================================================================*/
+int main(int argc, char** argv)
+{
+    bool check = (argc > 1) && (strcmp(argv[1], "--check") == 0);
+
+    if ((argc > 1) && !check)
+    {
+        fprintf(stderr, "Upotreba: %s [--check]\n", argv[0]);
+        return 1;
+    }
+
+    Test_Step(!check);
+    Test_Spikes();
+    Test_Faults();
+    Test_Reports();
+
+    if (check && (test_failures != 0U)) fprintf(stderr, "ntc_filter: %lu grešaka\n", (unsigned long)test_failures);
+    return (check && (test_failures != 0U)) ? 1 : 0;
+}
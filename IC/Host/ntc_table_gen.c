@@ -0,0 +1,131 @@
+/**
+ ******************************************************************************
+ * @file    ntc_table_gen.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Generator i provjera tabele NTC konverzije (`ic_ntc_table`).
+ *
+ * @note    Referenca je beta jednačina iz nekadašnjeg `ROOM_GetTemperature`
+ * (ista zaokruženja 298,1 K i 273,1 K), računata u double preciznosti.
+ * Bez argumenata alat ispisuje `ntc_table.c` za parametre iz `ntc.h`:
+ *
+ *   ic_ntc_table > IC/Src/ntc_table.c
+ *
+ * Sa `--check` poredi prevedenu tabelu sa novo izračunatom i
+ * `NTC_ToDeciCelsius` sa referencom za svaku vrijednost x16 između pragova
+ * `NTC_OPEN_LOW` i `NTC_OPEN_HIGH`. Izlazni kod je 1 ako se tabela ne slaže
+ * sa parametrima ili je greška veća od `NTC_CHECK_MAX_ERROR` desetinki °C.
+ * Tabela nema `#error` zaštitu od promjene parametara, jer se alat povezuje
+ * sa postojećom tabelom; zastarjelu tabelu prijavljuje `--check`.
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "ntc.h"
+#include <math.h>
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define NTC_CHECK_MAX_ERROR             1.0     ///< Dozvoljena greška u desetinkama °C
+#define NTC_VALUES_PER_LINE             12U
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Referentna temperatura u desetinkama °C, ograničena na opseg tabele.
+ */
+static double Gen_Reference(uint32_t adc_x16)
+{
+    double r, den, t;
+
+    if (adc_x16 >= NTC_FULL_SCALE) return NTC_TEMP_MIN;
+    r = (double)NTC_PULLUP * ((double)NTC_FULL_SCALE / ((double)NTC_FULL_SCALE - adc_x16) - 1.0);
+    if (r <= 0.0) return NTC_TEMP_MAX;
+    den = NTC_B_VALUE + 298.1 * log(r / NTC_RREF);
+    if (den <= 0.0) return NTC_TEMP_MAX;
+    t = ((NTC_B_VALUE * 298.1) / den - 273.1) * 10.0;
+    if (t < NTC_TEMP_MIN) t = NTC_TEMP_MIN;
+    if (t > NTC_TEMP_MAX) t = NTC_TEMP_MAX;
+    return t;
+}
+
+static int16_t Gen_Entry(uint32_t index)
+{
+    return (int16_t)lround(Gen_Reference(index << NTC_TABLE_SHIFT));
+}
+
+static void Gen_Print(void)
+{
+    printf("/**\n");
+    printf(" ******************************************************************************\n");
+    printf(" * @file    ntc_table.c\n");
+    printf(" * @author  Gemini & [Vaše Ime]\n");
+    printf(" * @brief   Tabela konverzije NTC senzora (generisano, ne mijenjati ručno).\n");
+    printf(" *\n");
+    printf(" * @note    Generiše je `ic_ntc_table > IC/Src/ntc_table.c` iz parametara u\n");
+    printf(" * `ntc.h`: R25 = %u, B = %u, otpornik djelitelja %u. Stavka `i` je\n",
+           (unsigned)NTC_RREF, (unsigned)NTC_B_VALUE, (unsigned)NTC_PULLUP);
+    printf(" * temperatura u desetinkama °C za vrijednost x16 jednaku `i << %u`.\n", (unsigned)NTC_TABLE_SHIFT);
+    printf(" ******************************************************************************\n");
+    printf(" */\n\n");
+    printf("#include \"main.h\"\n");
+    printf("#include \"ntc.h\"\n\n");
+    printf("const int16_t ntc_table[NTC_TABLE_SIZE] =\n{");
+    for (uint32_t i = 0U; i < NTC_TABLE_SIZE; i++)
+    {
+        if ((i % NTC_VALUES_PER_LINE) == 0U) printf("\n   ");
+        printf(" %5d%s", Gen_Entry(i), (i + 1U < NTC_TABLE_SIZE) ? "," : "");
+    }
+    printf("\n};\n");
+}
+
+static int Gen_Check(void)
+{
+    double worst = 0.0;
+    uint32_t worst_at = 0U;
+    int mismatches = 0;
+
+    for (uint32_t i = 0U; i < NTC_TABLE_SIZE; i++)
+    {
+        if (ntc_table[i] != Gen_Entry(i))
+        {
+            if (mismatches++ == 0) fprintf(stderr, "Tabela ne odgovara parametrima iz ntc.h (stavka %lu: %d, treba %d)\n",
+                                            (unsigned long)i, ntc_table[i], Gen_Entry(i));
+        }
+    }
+
+    for (uint32_t x = NTC_OPEN_LOW * 16U; x <= NTC_OPEN_HIGH * 16U; x++)
+    {
+        double err = fabs(NTC_ToDeciCelsius((uint16_t)x) - Gen_Reference(x));
+        if (err > worst)
+        {
+            worst = err;
+            worst_at = x;
+        }
+    }
+
+    printf("Najveća greška: %.3f desetinki °C na x16 = %lu (ADC %.1f), dozvoljeno %.1f\n",
+           worst, (unsigned long)worst_at, worst_at / 16.0, NTC_CHECK_MAX_ERROR);
+    printf("Tabela: %lu stavki, %lu bajta\n", (unsigned long)NTC_TABLE_SIZE, (unsigned long)sizeof(ntc_table));
+    return ((mismatches == 0) && (worst <= NTC_CHECK_MAX_ERROR)) ? 0 : 1;
+}
+
+/*============================================================================*/
+/* GLAVNI PROGRAM                                                             */
+/*============================================================================*/
+int main(int argc, char** argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "--check") == 0)) return Gen_Check();
+    if (argc > 1)
+    {
+        fprintf(stderr, "Upotreba: %s [--check]\n", argv[0]);
+        return 1;
+    }
+    Gen_Print();
+    return 0;
+}
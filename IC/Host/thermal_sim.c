@@ -0,0 +1,276 @@
+/**
+ ******************************************************************************
+ * @file    thermal_sim.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Simulator sobe sa fan-coilom za poređenje algoritama termostata (`ic_thermal_sim`).
+ *
+ * @note    Prevodi se samo u host build. Pravi `THSTAT_Service` upravlja
+ * simuliranom sobom preko istih GPIO pinova ventilatora kao na uređaju, a
+ * ventil prati `Thermostat_GetState`. Model sobe (korak 1 s):
+ * - vazduh i masa zidova su dva toplotna kapaciteta, vezana međusobno i
+ *   prema spoljnoj temperaturi;
+ * - snaga fan-coila je `SIM_COIL_POWER_W` puta udio brzine, a termoelektrični
+ *   pogon ventila i izmjenjivač kasne za komandom (prvi red);
+ * - senzor u zidnoj kutiji kasni za vazduhom i daje desetinke °C uz mali šum.
+ *
+ * Za grijanje i hlađenje, i za svaki algoritam, soba kreće od temperature
+ * udaljene od zadate. Do `SIM_STEP_WINDOW_H` se mjere vrijeme smirivanja
+ * (posljednji izlaz iz ±`SIM_SETTLE_BAND`) i preskok, oba na srednjoj
+ * temperaturi vazduha u prozoru `SIM_AVERAGE_S`, dužem od jednog ciklusa
+ * releja, da talasanje releja ne bi izgledalo kao preskok. Od tada do kraja, uz skok
+ * unutrašnjeg opterećenja u `SIM_DISTURBANCE_H`, mjere se broj promjena
+ * releja (tri brzine i ventil) po satu i RMS greška stvarne temperature.
+ * Adaptivni regulator se pokreće dva puta: prvi put uči (relejni test je dio
+ * odziva), a drugi put kreće sa parametrima naučenim u prvom.
+ *
+ * Upotreba: `ic_thermal_sim [--check] [sati]` (podrazumijevano 12 h).
+ * Sa `--check` izlazni kod je 1 ako se PI ili naučeni adaptivni regulator ne
+ * smire, imaju preskok veći od `SIM_CHECK_OVERSHOOT`, ili RMS grešku ili
+ * broj promjena releja na sat veći od histereznih traka.
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "thermostat.h"
+#include "fancoil.h"
+#include "host_shim.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define SIM_DEFAULT_HOURS               12U
+#define SIM_STEP_WINDOW_H               6U      ///< Do ovoga se mjeri odziv na početni skok
+#define SIM_DISTURBANCE_H               8U      ///< Skok unutrašnjeg opterećenja
+#define SIM_SERVICE_MS                  100U    ///< Kao `TASK_HVAC_PERIOD`
+#define SIM_SENSOR_MS                   1000U   ///< Novo očitanje senzora
+#define SIM_SETTLE_BAND                 0.5     ///< °C
+#define SIM_AVERAGE_S                   3600U   ///< Prozor srednje temperature, s
+#define SIM_CHECK_OVERSHOOT             0.5     ///< °C
+
+#define SIM_AIR_CAPACITY                300e3   ///< J/K, vazduh i namještaj
+#define SIM_MASS_CAPACITY               6e6     ///< J/K, unutrašnji sloj zidova
+#define SIM_UA_AIR_OUT                  30.0    ///< W/K, prozori i provjetravanje
+#define SIM_UA_AIR_MASS                 150.0   ///< W/K
+#define SIM_UA_MASS_OUT                 40.0    ///< W/K
+#define SIM_COIL_POWER_W                2500.0  ///< Snaga na brzini 3
+#define SIM_VALVE_TAU_S                 150.0   ///< Termoelektrični pogon ventila
+#define SIM_COIL_TAU_S                  60.0    ///< Izmjenjivač
+#define SIM_SENSOR_TAU_S                120.0   ///< Zidna kutija
+#define SIM_SENSOR_NOISE                0.04    ///< °C, vrh
+
+#define SIM_FAN_PORT                    2U      ///< GPIOC
+#define SIM_OUTPUTS                     4U      ///< Tri brzine i ventil
+#define SIM_RUNS                        (FANC_ALGO_COUNT + 1U)  ///< Adaptivni i nakon učenja
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+/**
+ * @brief Radna tačka za jedan mod rada.
+ */
+typedef struct
+{
+    const char* name;
+    uint8_t mode;               ///< THST_HEATING ili THST_COOLING
+    double outdoor;             ///< °C
+    double start;               ///< Početna temperatura sobe i zidova, °C
+    uint8_t setpoint;           ///< °C
+    double gain_w;              ///< Unutrašnje opterećenje (sunce, ljudi), W
+    double disturbance_w;       ///< Dodatno opterećenje od `SIM_DISTURBANCE_H`, W
+} SimCase_t;
+
+/**
+ * @brief Rezultat jednog pokretanja.
+ */
+typedef struct
+{
+    double settling_min;        ///< < 0 ako se soba nije smirila
+    double overshoot;           ///< °C srednje temperature preko zadate (grijanje) ili ispod (hlađenje)
+    double switches_per_hour;
+    double rms_error;           ///< °C, od kraja prozora odziva do kraja
+    FanCoil_Params_t params;
+    bool tuned;
+} SimResult_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static const SimCase_t sim_cases[] =
+{
+    { "grijanje", THST_HEATING,  0.0, 17.0, 22,   0.0, 400.0 },
+    { "hladenje", THST_COOLING, 32.0, 27.0, 24, 500.0, 400.0 },
+};
+
+static const char* const run_names[SIM_RUNS] = { "trake", "PI", "PID", "adaptivni", "adapt. (2)" };
+static const uint16_t fan_pins[3] = { GPIO_PIN_10, GPIO_PIN_11, GPIO_PIN_8 };
+static const double speed_share[4] = { 0.0, 0.55, 0.8, 1.0 };
+static uint32_t noise_state;
+static double average_ring[SIM_AVERAGE_S];
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static double Sim_Noise(void)
+{
+    noise_state = noise_state * 1664525U + 1013904223U;
+    return ((double)(noise_state >> 8) / (double)(1U << 24) - 0.5) * 2.0 * SIM_SENSOR_NOISE;
+}
+
+/**
+ * @brief Gasi termostat i pušta servis da isključi releje.
+ * @param keep_learned false za početak iz čistog EEPROM-a (bez naučenih parametara).
+ */
+static void Sim_ResetThermostat(THERMOSTAT_TypeDef* pThst, bool keep_learned)
+{
+    Thermostat_TurnOff(pThst);
+    for (uint32_t t = 0U; t < 2000U; t += SIM_SERVICE_MS)
+    {
+        THSTAT_Service(pThst);
+        HostShim_Advance(SIM_SERVICE_MS);
+    }
+    if (!keep_learned) HostShim_EepromErase();
+    THSTAT_Init(pThst);
+}
+
+static SimResult_t Sim_Run(THERMOSTAT_TypeDef* pThst, const SimCase_t* sc, uint8_t run, uint32_t hours)
+{
+    const uint8_t algo = (run < FANC_ALGO_COUNT) ? run : FANC_ALGO_ADAPTIVE;
+    const double sign = (sc->mode == THST_HEATING) ? 1.0 : -1.0;
+    const uint32_t run_s = hours * 3600U;
+    SimResult_t res = { -1.0, 0.0, 0.0, 0.0, { 0U, 0U, 0U }, false };
+    double air = sc->start, mass = sc->start, sensor = sc->start;
+    double valve = 0.0, coil = 0.0, sq_sum = 0.0, average_sum = 0.0;
+    uint32_t last_outside = 0U, switches = 0U, sq_count = 0U;
+    bool outputs[SIM_OUTPUTS] = { false };
+
+    Sim_ResetThermostat(pThst, run >= FANC_ALGO_COUNT);
+    for (uint32_t i = 0U; i < SIM_AVERAGE_S; i++) average_ring[i] = sc->start;
+    average_sum = sc->start * SIM_AVERAGE_S;
+    noise_state = 12345U;
+    Thermostat_SetFanControlMode(pThst, 1U);
+    Thermostat_SetControlAlgorithm(pThst, algo);
+    Thermostat_SP_Temp_Set(pThst, sc->setpoint);
+    Thermostat_SetMeasuredTemp(pThst, (int16_t)lround(sensor * 10.0));
+    Thermostat_SetControlMode(pThst, sc->mode);
+
+    for (uint32_t s = 0U; s < run_s; s++)
+    {
+        const double gain = sc->gain_w + ((s >= (SIM_DISTURBANCE_H * 3600U)) ? sc->disturbance_w : 0.0);
+        const double error = air - sc->setpoint;
+        double average_error;
+        uint8_t speed = 0U;
+        bool now[SIM_OUTPUTS];
+        double q_air;
+
+        for (uint32_t ms = 0U; ms < SIM_SENSOR_MS; ms += SIM_SERVICE_MS)
+        {
+            THSTAT_Service(pThst);
+            HostShim_Advance(SIM_SERVICE_MS);
+        }
+
+        for (uint8_t i = 0U; i < 3U; i++)
+        {
+            now[i] = HostShim_GpioGet(SIM_FAN_PORT, fan_pins[i]);
+            if (now[i]) speed = i + 1U;
+        }
+        now[3] = (Thermostat_GetState(pThst) != 0U);
+        for (uint8_t i = 0U; i < SIM_OUTPUTS; i++)
+        {
+            if ((s >= (SIM_STEP_WINDOW_H * 3600U)) && (now[i] != outputs[i])) switches++;
+            outputs[i] = now[i];
+        }
+
+        // Ventil i izmjenjivač kasne, ventilator određuje udio snage
+        valve += ((now[3] ? 1.0 : 0.0) - valve) / SIM_VALVE_TAU_S;
+        coil += (valve * speed_share[speed] * SIM_COIL_POWER_W - coil) / SIM_COIL_TAU_S;
+
+        q_air = sign * coil + gain - SIM_UA_AIR_MASS * (air - mass) - SIM_UA_AIR_OUT * (air - sc->outdoor);
+        mass += (SIM_UA_AIR_MASS * (air - mass) - SIM_UA_MASS_OUT * (mass - sc->outdoor)) / SIM_MASS_CAPACITY;
+        air += q_air / SIM_AIR_CAPACITY;
+        sensor += (air - sensor) / SIM_SENSOR_TAU_S;
+        Thermostat_SetMeasuredTemp(pThst, (int16_t)lround((sensor + Sim_Noise()) * 10.0));
+
+        average_sum += air - average_ring[s % SIM_AVERAGE_S];
+        average_ring[s % SIM_AVERAGE_S] = air;
+        average_error = average_sum / SIM_AVERAGE_S - sc->setpoint;
+
+        if (s < (SIM_STEP_WINDOW_H * 3600U))
+        {
+            if (fabs(average_error) > SIM_SETTLE_BAND) last_outside = s + 1U;
+            if ((s >= SIM_AVERAGE_S) && ((sign * average_error) > res.overshoot)) res.overshoot = sign * average_error;
+        }
+        else
+        {
+            sq_sum += error * error;
+            sq_count++;
+        }
+    }
+
+    if (last_outside < (SIM_STEP_WINDOW_H * 3600U)) res.settling_min = last_outside / 60.0;
+    res.switches_per_hour = switches / (double)(hours - SIM_STEP_WINDOW_H);
+    res.rms_error = (sq_count != 0U) ? sqrt(sq_sum / sq_count) : 0.0;
+    res.tuned = Thermostat_GetControlParams(pThst, sc->mode, &res.params);
+    return res;
+}
+
+/*============================================================================*/
+/* GLAVNI PROGRAM                                                             */
+/*============================================================================*/
+int main(int argc, char** argv)
+{
+    THERMOSTAT_TypeDef* pThst = Thermostat_GetInstance();
+    uint32_t hours = SIM_DEFAULT_HOURS;
+    bool check = false;
+    int failed = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--check") == 0) check = true;
+        else hours = (uint32_t)strtoul(argv[i], NULL, 0);
+    }
+    if (hours <= SIM_DISTURBANCE_H)
+    {
+        fprintf(stderr, "Upotreba: %s [--check] [sati > %u]\n", argv[0], SIM_DISTURBANCE_H);
+        return 2;
+    }
+
+    HostShim_Init();
+    for (uint32_t c = 0U; c < (sizeof(sim_cases) / sizeof(sim_cases[0])); c++)
+    {
+        const SimCase_t* sc = &sim_cases[c];
+        SimResult_t res[SIM_RUNS];
+
+        printf("%s: spolja %.0f °C, start %.0f °C, zadato %u °C, %u h\n",
+               sc->name, sc->outdoor, sc->start, sc->setpoint, (unsigned)hours);
+        printf("  %-10s %12s %10s %12s %10s  %s\n", "algoritam", "smirenje", "preskok", "promjena/h", "RMS", "parametri");
+        for (uint8_t a = 0U; a < SIM_RUNS; a++)
+        {
+            res[a] = Sim_Run(pThst, sc, a, hours);
+            if (res[a].settling_min >= 0.0) printf("  %-10s %8.0f min", run_names[a], res[a].settling_min);
+            else                            printf("  %-10s %12s", run_names[a], "nije");
+            printf(" %7.2f °C %12.1f %7.2f °C", res[a].overshoot, res[a].switches_per_hour, res[a].rms_error);
+            if (a != FANC_ALGO_BANDS)
+            {
+                printf("  Kp %u, Ti %u s, Td %u s%s", res[a].params.kp, res[a].params.ti,
+                       (a == FANC_ALGO_PID) ? res[a].params.td : 0U, res[a].tuned ? " (naučeni)" : "");
+            }
+            printf("\n");
+        }
+
+        for (uint8_t a = FANC_ALGO_PI; a < SIM_RUNS; a++)
+        {
+            if ((a == FANC_ALGO_PID) || (a == FANC_ALGO_ADAPTIVE)) continue;
+            if ((res[a].settling_min < 0.0) || (res[a].overshoot > SIM_CHECK_OVERSHOOT)
+             || (res[a].rms_error > res[FANC_ALGO_BANDS].rms_error)
+             || (res[a].switches_per_hour > res[FANC_ALGO_BANDS].switches_per_hour))
+            {
+                printf("  %s ne zadovoljava kriterije\n", run_names[a]);
+                failed = 1;
+            }
+        }
+    }
+    return check ? failed : 0;
+}
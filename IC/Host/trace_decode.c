@@ -0,0 +1,272 @@
+/**
+ ******************************************************************************
+ * @file    trace_decode.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Pretvara `DIAG_TRACE_xxx` odgovore u vremensku liniju (`ic_trace_decode`).
+ *
+ * @note    Ulaz je tekstualni fajl sa jednim `DIAG_GET` odgovorom po liniji,
+ * kao niz heksadecimalnih bajtova (razmaci su dozvoljeni, `#` je komentar).
+ * Očekuje se odgovor na `DIAG_TRACE_STATUS` (za takt procesora) i zatim
+ * sve stranice `DIAG_TRACE_READ`. Ispis sadrži svaki događaj sa vremenom od
+ * prvog zapisa i trajanjem za izlaze, uvučen po dubini ugniježđenja, pa
+ * zbirnu statistiku po izvoru. Zadaci planera su označeni indeksom iz
+ * tabele u `main.c` (isti kao u `DIAG_SCHED_TASKS`).
+ *
+ * Upotreba: `ic_trace_decode <dump.txt>`
+ ******************************************************************************
+ */
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "trace.h"
+#include <ctype.h>
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define DECODE_MAX_EVENTS               8192U
+#define DECODE_MAX_DEPTH                16U
+#define DECODE_ID_COUNT                 256U
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+typedef struct
+{
+    uint32_t cycles;
+    uint16_t seq;
+    uint8_t  id;
+    uint8_t  kind;
+} Decode_Event_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint64_t sum;
+    uint32_t min;
+    uint32_t max;
+} Decode_Stats_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static Decode_Event_t events[DECODE_MAX_EVENTS];
+static uint32_t event_count;
+static Decode_Stats_t stats[DECODE_ID_COUNT];
+static uint32_t cpu_mhz;
+
+static const char* const isr_names[] =
+{
+    [TRACE_ID_SYSTICK]    = "SysTick",
+    [TRACE_ID_USART1]     = "USART1",
+    [TRACE_ID_USART2]     = "USART2",
+    [TRACE_ID_LTDC]       = "LTDC",
+    [TRACE_ID_DMA2D]      = "DMA2D",
+    [TRACE_ID_EXTI_TOUCH] = "EXTI touch",
+    [TRACE_ID_QSPI]       = "QUADSPI",
+    [TRACE_ID_RTC_ALARM]  = "RTC alarm",
+    [TRACE_ID_ADC_DMA]    = "ADC3 DMA",
+};
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static const char* Decode_Name(uint8_t id, char* buf, size_t size)
+{
+    if (id >= TRACE_ID_TASK) snprintf(buf, size, "zadatak %u", (unsigned)(id - TRACE_ID_TASK));
+    else if ((id < sizeof(isr_names) / sizeof(isr_names[0])) && (isr_names[id] != NULL)) snprintf(buf, size, "%s", isr_names[id]);
+    else snprintf(buf, size, "id %u", (unsigned)id);
+    return buf;
+}
+
+/**
+ * @brief Pretvara liniju heksadecimalnih cifara u bajtove.
+ * @retval Broj bajtova, -1 za neispravnu liniju.
+ */
+static int Decode_ParseHex(const char* line, uint8_t* out, int max)
+{
+    int n = 0, half = -1;
+
+    for (; (*line != '\0') && (*line != '#'); line++)
+    {
+        int v;
+        if (isspace((unsigned char)*line) || (*line == ',')) continue;
+        if (!isxdigit((unsigned char)*line)) return -1;
+        v = isdigit((unsigned char)*line) ? (*line - '0') : (tolower((unsigned char)*line) - 'a' + 10);
+        if (half < 0)
+        {
+            half = v;
+        }
+        else
+        {
+            if (n >= max) return -1;
+            out[n++] = (uint8_t)((half << 4) | v);
+            half = -1;
+        }
+    }
+    return (half < 0) ? n : -1;
+}
+
+static uint32_t Decode_Get32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief Obrađuje jedan `DIAG_GET` odgovor.
+ */
+static void Decode_Response(const uint8_t* r, int len, int line_no)
+{
+    if (len < 4) return;
+
+    switch (r[0])
+    {
+    case DIAG_TRACE_STATUS:
+        if ((len >= 15) && (r[3] == 1U))
+        {
+            cpu_mhz = ((uint32_t)r[11] << 8) | r[12];
+            printf("Takt: %lu MHz, zapisa u baferu: %u, ukupno upisano: %lu\n", (unsigned long)cpu_mhz,
+                   (unsigned)(((uint32_t)r[5] << 8) | r[6]), (unsigned long)Decode_Get32(&r[7]));
+        }
+        break;
+
+    case DIAG_TRACE_READ:
+        for (int i = 0; (i < r[3]) && (4 + (i + 1) * 8 <= len); i++)
+        {
+            const uint8_t* p = &r[4 + i * 8];
+            if (event_count >= DECODE_MAX_EVENTS) break;
+            events[event_count].cycles = Decode_Get32(p);
+            events[event_count].seq = (uint16_t)((p[4] << 8) | p[5]);
+            events[event_count].id = p[6];
+            events[event_count].kind = p[7];
+            event_count++;
+        }
+        break;
+
+    default:
+        fprintf(stderr, "linija %d: preskočen odgovor pod-komande %u\n", line_no, (unsigned)r[0]);
+        break;
+    }
+}
+
+/**
+ * @brief Ispisuje vremensku liniju i skuplja statistiku trajanja.
+ */
+static void Decode_Timeline(void)
+{
+    uint64_t now = 0U;
+    uint64_t open_at[DECODE_MAX_DEPTH];
+    uint8_t open_id[DECODE_MAX_DEPTH];
+    uint32_t depth = 0U;
+    char name[32];
+
+    printf("%12s %10s  %s\n", "t [us]", "trajanje", "događaj");
+    for (uint32_t i = 0U; i < event_count; i++)
+    {
+        const Decode_Event_t* e = &events[i];
+
+        if (i > 0U)
+        {
+            uint16_t gap = (uint16_t)(e->seq - events[i - 1U].seq);
+            now += (uint32_t)(e->cycles - events[i - 1U].cycles);
+            if (gap != 1U)
+            {
+                printf("%12s %10s  --- nedostaje %u zapisa ---\n", "", "", (unsigned)(gap - 1U));
+                depth = 0U;
+            }
+        }
+
+        if (e->kind == TRACE_KIND_ENTER)
+        {
+            printf("%12.3f %10s  %*s> %s\n", (double)now / cpu_mhz, "", (int)(depth * 2U), "",
+                   Decode_Name(e->id, name, sizeof(name)));
+            if (depth < DECODE_MAX_DEPTH)
+            {
+                open_at[depth] = now;
+                open_id[depth] = e->id;
+                depth++;
+            }
+        }
+        else
+        {
+            // Izlaz zatvara posljednji otvoreni ulaz istog izvora
+            int32_t d = (int32_t)depth - 1;
+            while ((d >= 0) && (open_id[d] != e->id)) d--;
+            if (d >= 0)
+            {
+                uint64_t cycles = now - open_at[d];
+                Decode_Stats_t* s = &stats[e->id];
+                depth = (uint32_t)d;
+                if ((s->count == 0U) || (cycles < s->min)) s->min = (uint32_t)cycles;
+                if (cycles > s->max) s->max = (uint32_t)cycles;
+                s->sum += cycles;
+                s->count++;
+                printf("%12.3f %10.3f  %*s< %s\n", (double)now / cpu_mhz, (double)cycles / cpu_mhz,
+                       (int)(depth * 2U), "", Decode_Name(e->id, name, sizeof(name)));
+            }
+            else
+            {
+                printf("%12.3f %10s  < %s (bez ulaza)\n", (double)now / cpu_mhz, "",
+                       Decode_Name(e->id, name, sizeof(name)));
+            }
+        }
+    }
+}
+
+static void Decode_Summary(void)
+{
+    char name[32];
+
+    printf("\n%-14s %8s %10s %10s %10s\n", "IZVOR", "BROJ", "MIN us", "AVG us", "MAX us");
+    for (uint32_t id = 0U; id < DECODE_ID_COUNT; id++)
+    {
+        const Decode_Stats_t* s = &stats[id];
+        if (s->count == 0U) continue;
+        printf("%-14s %8lu %10.3f %10.3f %10.3f\n", Decode_Name((uint8_t)id, name, sizeof(name)),
+               (unsigned long)s->count, (double)s->min / cpu_mhz,
+               (double)s->sum / s->count / cpu_mhz, (double)s->max / cpu_mhz);
+    }
+}
+
+/*============================================================================*/
+/* GLAVNI PROGRAM                                                             */
+/*============================================================================*/
+int main(int argc, char** argv)
+{
+    FILE* f;
+    char line[1024];
+    uint8_t resp[256];
+    int line_no = 0;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Upotreba: %s <dump.txt>\n", argv[0]);
+        return 1;
+    }
+    f = fopen(argv[1], "r");
+    if (f == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        int len = Decode_ParseHex(line, resp, (int)sizeof(resp));
+        line_no++;
+        if (len < 0) fprintf(stderr, "linija %d: neispravan heks zapis\n", line_no);
+        else if (len > 0) Decode_Response(resp, len, line_no);
+    }
+    fclose(f);
+
+    if (cpu_mhz == 0U)
+    {
+        fprintf(stderr, "Nema DIAG_TRACE_STATUS odgovora, pretpostavljam 216 MHz\n");
+        cpu_mhz = 216U;
+    }
+    Decode_Timeline();
+    Decode_Summary();
+    return 0;
+}
@@ -63,7 +63,33 @@ typedef struct
 }
 LCD_LayerPropTypedef;
 
+#define LCD_BKG_CACHE_SLOTS     6   // number of pre-rendered screen backgrounds kept in SDRAM
+
+typedef struct
+{
+  uint32_t     shown;                // frames made visible at vertical sync
+  uint32_t     skipped;              // frames replaced in the queue before they were shown
+  uint32_t     deferred;             // due renders postponed because a swap was still pending
+  uint32_t     service_deferred;     // screen service passes postponed because a swap was still pending
+  uint32_t     late;                 // frames shown more than one refresh after their render started
+  uint32_t     vsync;                // vertical syncs since start
+  uint32_t     input_latency_last;   // ms from touch input to the next visible frame
+  uint32_t     input_latency_max;
+}
+LCD_PacerStatsTypedef;
+
 void LCD_LL_DeInit(void);
+int  LCD_BkgCache_Store(int LayerIndex, int Slot);
+int  LCD_BkgCache_Restore(int LayerIndex, int Slot);
+void LCD_BkgCache_Invalidate(int Slot);
+int  LCD_Pacer_IsSwapPending(void);
+void LCD_Pacer_FrameBegin(void);
+void LCD_Pacer_Defer(void);
+void LCD_Pacer_DeferService(void);
+void LCD_Pacer_MarkInput(void);
+int  LCD_Pacer_TakeInput(void);
+void LCD_Pacer_GetStats(LCD_PacerStatsTypedef *pStats);
+void LCD_Pacer_ResetStats(void);
 
 #endif /* LCDCONF_H */
 
@@ -271,13 +271,6 @@ void Curtains_MoveSignalAll(const uint8_t direction);
  */
 void Curtain_HandleTouchLogic(const uint8_t direction);
 
-/**
- * @brief  Aurira stanje roletne na osnovu eksterne komande (npr. sa RS485).
- * @param  relay Adresa releja koji je promijenio stanje.
- * @param  state Novo stanje (`CURTAIN_UP`, `CURTAIN_DOWN`, `CURTAIN_STOP`).
- */
-void Curtain_Update_External(uint16_t relay, uint8_t state);
-
 
 // --- Grupa 6: Provjera Stanja (Runtime Getters) ---
 
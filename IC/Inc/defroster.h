@@ -83,13 +83,6 @@ void Defroster_Save(Defroster_Handle* const handle);
  */
 void Defroster_SetDefault(Defroster_Handle* const handle);
 
-/**
- * @brief  Glavna servisna petlja za odmrzivac.
- * @note   Upravlja ciklusima i stanjem. Poziva se periodicno iz `main()`.
- * @param  handle Pointer na instancu modula.
- */
-void Defroster_Service(Defroster_Handle* const handle);
-
 /**
  * @brief  Provjerava da li je odmrzivac trenutno aktivan.
  * @param  handle Pointer na instancu modula.
@@ -0,0 +1,89 @@
+/**
+ ******************************************************************************
+ * @file    devreg.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Registar uređaja: rutiranje bus događaja (tip poruke, adresa) ->
+ *          pretplatnici.
+ *
+ * @note    Događaji sa busa (`BINARY_SET`, `DIMMER_SET`, `JALOUSIE_SET`,
+ * `DIN_EVENT`) nose samo TF adresu releja ili ulaza. Umjesto da listener
+ * proslijedi događaj svakom modulu i da svaki modul linearno pretraži svoju
+ * konfiguraciju, registar drži jednu heš tabelu otvorenog adresiranja
+ * (linearno probanje) sa ključem (tip poruke, adresa). Svaki ključ ima listu
+ * pretplatnika (funkcija modula i indeks uređaja), pa `DevReg_Dispatch`
+ * poziva tačno zainteresovane module, a cijena ne zavisi od broja uređaja.
+ *
+ * Svaki modul pri inicijalizaciji prijavi funkciju (`DevReg_Builder_t`) koja
+ * pozivima `DevReg_Subscribe` upiše pretplate svih svojih konfigurisanih
+ * uređaja. Nakon promjene adrese ili brisanja uređaja modul poziva
+ * `DevReg_Rebuild`, koji tabelu odmah gradi ispočetka u drugom baferu i
+ * zatim ga atomski aktivira. `DevReg_Dispatch` se zato smije pozvati iz
+ * listenera (prekid) dok glavna petlja gradi novu tabelu. Pretplatnici
+ * jednog ključa se pozivaju redom prijave.
+ *
+ * Tabele su u SDRAM-u (sekcija `.sdram_ram`, `UNINIT` region u `db.sct`)
+ * i brišu se u `DevReg_Init`.
+ ******************************************************************************
+ */
+
+#ifndef __DEVREG_H__
+#define __DEVREG_H__                            FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Kapacitet registra
+ *  @{
+ */
+#define DEVREG_MAX_ROUTES               254U    ///< Najviše pretplata (i različitih ključeva), `route.next` je bajt
+#define DEVREG_SLOTS_LOG2               9U      ///< 512 slotova, popunjenost najviše 50 %
+#define DEVREG_SLOTS                    (1U << DEVREG_SLOTS_LOG2)
+#define DEVREG_MAX_BUILDERS             8U      ///< Modula koji upisuju pretplate
+/** @} */
+
+/**
+ * @brief Funkcija pretplatnika; poziva je `DevReg_Dispatch`, iz listenera.
+ * @param index   Indeks uređaja koji je modul naveo u `DevReg_Subscribe`.
+ * @param address Adresa iz okvira.
+ * @param data    Podaci okvira iza adrese.
+ * @param len     Dužina `data`.
+ */
+typedef void (*DevReg_Handler_t)(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len);
+
+/**
+ * @brief Funkcija modula koja upisuje sve njegove pretplate pozivima `DevReg_Subscribe`.
+ */
+typedef void (*DevReg_Builder_t)(void);
+
+/**
+ * @brief Stanje registra (dijagnostika i host benchmark).
+ */
+typedef struct
+{
+    uint16_t keys;              /**< Različitih (tip, adresa) u aktivnoj tabeli. */
+    uint16_t routes;            /**< Pretplata u aktivnoj tabeli. */
+    uint16_t max_probe;         /**< Najduži niz probanja u aktivnoj tabeli. */
+    uint16_t overflow;          /**< Pretplata odbačenih jer je registar pun. */
+    uint32_t rebuilds;          /**< Broj izgradnji tabele. */
+} DevReg_Stats_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija i izgradnja ---
+void DevReg_Init(void);
+void DevReg_Register(DevReg_Builder_t builder);
+void DevReg_Rebuild(void);
+bool DevReg_Subscribe(uint8_t type, uint16_t address, DevReg_Handler_t handler, uint16_t index);
+
+// --- Grupa 2: Rutiranje ---
+uint8_t DevReg_Dispatch(uint8_t type, uint16_t address, const uint8_t* data, uint8_t len);
+
+// --- Grupa 3: Dijagnostika ---
+const DevReg_Stats_t* DevReg_GetStats(void);
+
+#endif // __DEVREG_H__
@@ -424,7 +424,9 @@ typedef enum{
     SCREEN_LANGUAGE_SELECT,         // << NOVO
     SCREEN_THEME_SELECT,            // << NOVO
     SCREEN_OUTDOOR_TIMER,           // << NOVO
-    SCREEN_OUTDOOR_SETTINGS         // << NOVO (za adrese vanjske rasvjete)
+    SCREEN_OUTDOOR_SETTINGS,        // << NOVO (za adrese vanjske rasvjete)
+    SCREEN_PROFILER,                /**< Skriveni dijagnosticki ekran profilera iscrtavanja (dupli dodir na SCREEN_SETTINGS_1). */
+    SCREEN_HISTORY                  /**< Grafici istorije mjerenja (dupli dodir na SCREEN_THERMOSTAT). */
 }eScreen;
 
 typedef enum{
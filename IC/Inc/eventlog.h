@@ -0,0 +1,138 @@
+/**
+ ******************************************************************************
+ * @file    eventlog.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Trajni dnevnik događaja u QSPI flash-u: greške i ponavljanja na
+ *          busu, reseti, ishodi ažuriranja firmvera, naoružavanje alarma i
+ *          aktivacije scena.
+ *
+ * @note    Dnevnik zauzima `RT_EVLOG_SIZE` na `RT_EVLOG_ADDR` (slobodan
+ * prostor između kopije bootloadera i kopije aplikacije), podijeljen u
+ * `EVLOG_SEGMENTS` segmenata veličine jednog podsektora (4 KB). Prvi slot
+ * segmenta je zaglavlje sa rednim brojem segmenta i rednim brojem prvog
+ * zapisa, ostali slotovi su zapisi od 16 bajtova sa CRC-om. Upis je samo
+ * dopisivanje: zapis se nikad ne mijenja, a kada se segment napuni otvara
+ * se sljedeći, već obrisan, i odmah se briše onaj iza njega (najstariji).
+ *
+ * `EventLog_Write` samo upisuje zapis u RAM bafer i smije se pozvati iz
+ * glavne petlje i iz listenera (prekid). `EventLog_Service` upisuje bafer u
+ * QSPI po stranicama i podsektor briše unaprijed; programiranje i brisanje
+ * se samo pokreću, a kraj se provjerava u sljedećim prolazima, pa petlja
+ * nikad ne čeka flash. Dok je operacija u toku QSPI nije memorijski mapiran
+ * i GUI odgađa samo iscrtavanje bitmapa (`EventLog_IsFlashBusy`); dugo
+ * brisanje se zato radi dok je screensaver aktivan. Svaki upis se nakon
+ * završetka provjeri čitanjem, a zapisi koji se ne poklope se upisuju
+ * ponovo u sljedeće slotove.
+ *
+ * FW agent iz listenera poziva `EventLog_Suspend` prije nego što dira QSPI:
+ * operacija u toku se završi, a nova se ne pokreće do `EventLog_Resume`, pa
+ * zapisi za to vrijeme čekaju u RAM baferu.
+ *
+ * Nakon nestanka napajanja `EventLog_Init` pregleda zaglavlja, uzima lanac
+ * segmenata od najnovijeg unazad i nastavlja iza posljednjeg korištenog
+ * slota; poluupisani zapisi padaju na CRC-u i preskaču se. Redni broj
+ * zapisa raste i preko reseta. Čitanje (`EventLog_Read`, `DIAG_LOG_READ`)
+ * nalazi početni zapis preko rednih brojeva segmenata u RAM-u i binarne
+ * pretrage u segmentu.
+ ******************************************************************************
+ */
+
+#ifndef __EVENTLOG_H__
+#define __EVENTLOG_H__                          FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Raspored u QSPI i kapacitet
+ *  @{
+ */
+#define EVLOG_RECORD_SIZE               16U     ///< Bajtova po zapisu i po zaglavlju segmenta
+#define EVLOG_SEGMENT_SIZE              N25Q128A_SUBSECTOR_SIZE
+#define EVLOG_SEGMENTS                  (RT_EVLOG_SIZE / EVLOG_SEGMENT_SIZE)
+#define EVLOG_SLOTS                     (EVLOG_SEGMENT_SIZE / EVLOG_RECORD_SIZE) ///< Slot 0 je zaglavlje
+#define EVLOG_RAM_RECORDS               64U     ///< Zapisa u RAM baferu (stepen broja 2)
+#define EVLOG_FLUSH_DELAY_MS            200U    ///< Najduže čekanje zapisa u RAM-u prije upisa
+/** @} */
+
+/** @name DIAG_GET pod-komande (nastavak na `DIAG_HIST_xxx`)
+ *  @{
+ */
+#define DIAG_LOG_STATUS                 14U     ///< Redni brojevi, brojači i raspored
+#define DIAG_LOG_READ                   15U     ///< Zapisi od rednog broja: [broj zapisa, redni broj (32 bita)]
+/** @} */
+
+/** @name Argument `EVLOG_FW_UPDATE` zapisa (greške su razlog NACK-a agenta)
+ *  @{
+ */
+#define EVLOG_FW_START                  0xF0U   ///< Prihvaćen početak, vrijednost je veličina
+#define EVLOG_FW_DONE                   0xF1U   ///< Fajl provjeren, slijedi restart
+/** @} */
+
+/**
+ * @brief Vrste događaja; značenje `arg` i `value` za svaku vrstu.
+ */
+typedef enum
+{
+    EVLOG_RESET = 1,            /**< arg: izvor reseta (`PIN_RESET`...), value: 0. */
+    EVLOG_BUS_FAIL,             /**< arg: tip komande, value: adresa; bez potvrde ni nakon ponavljanja. */
+    EVLOG_BUS_RETRY,            /**< arg: tip komande, value: adresa | (ponavljanja << 16); potvrđena tek iz ponovljenog slanja. */
+    EVLOG_BUS_DROP,             /**< arg: tip komande, value: adresa (za `THERMOSTAT_SYNC` grupa); red komandi je bio pun. */
+    EVLOG_FW_UPDATE,            /**< arg: `EVLOG_FW_xxx` ili razlog greške, value: veličina ili primljeni bajtovi. */
+    EVLOG_SECURITY,             /**< arg: particija ili `SECURITY_SYSTEM_INDEX`, value: 1 naoružano / alarm, 0 ne. */
+    EVLOG_SCENE,                /**< arg: scena, value: komandi | (odbačenih i nepotvrđenih << 16) | (neuspjeh << 31). */
+    EVLOG_LOST                  /**< arg: 0, value: zapisa izgubljenih jer je RAM bafer bio pun. */
+} EventLog_Code_e;
+
+/**
+ * @brief Zapis, isti u RAM-u i u QSPI (little-endian); prazan slot je 0xFF.
+ */
+typedef struct
+{
+    uint32_t seq;               /**< Redni broj, raste i preko reseta. */
+    uint32_t time;              /**< Sekundi od uključenja. */
+    uint32_t value;
+    uint8_t  code;              /**< `EventLog_Code_e`. */
+    uint8_t  arg;
+    uint16_t crc;               /**< CRC-16/CCITT prvih 14 bajtova. */
+} EventLog_Record_t;
+
+/**
+ * @brief Stanje dnevnika (dijagnostika i host provjera).
+ */
+typedef struct
+{
+    uint32_t first_seq;         /**< Prvi redni broj najstarijeg segmenta u QSPI. */
+    uint32_t next_seq;          /**< Redni broj sljedećeg zapisa. */
+    uint32_t durable_seq;       /**< Svi zapisi prije ovog su upisani i provjereni u QSPI. */
+    uint32_t lost;              /**< Zapisa odbačenih jer je RAM bafer bio pun. */
+    uint32_t programs;          /**< Pokrenutih programiranja stranice. */
+    uint32_t erases;            /**< Pokrenutih brisanja podsektora. */
+    uint32_t retries;           /**< Upisa i brisanja koja provjera nije potvrdila. */
+    uint16_t pending;           /**< Zapisa u RAM-u koji čekaju upis. */
+    uint16_t write_slot;        /**< Sljedeći slot u aktivnom segmentu. */
+    uint8_t  segment;           /**< Aktivni segment, `EVLOG_SEGMENTS` ako ga nema. */
+    uint8_t  segments;          /**< Segmenata sa zapisima. */
+} EventLog_Stats_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija i upis ---
+void EventLog_Init(void);
+void EventLog_Service(void);
+bool EventLog_Write(uint8_t code, uint8_t arg, uint32_t value);
+bool EventLog_Flush(uint32_t timeout_ms);
+bool EventLog_IsFlashBusy(void);
+void EventLog_Suspend(void);
+void EventLog_Resume(void);
+
+// --- Grupa 2: Čitanje ---
+uint16_t EventLog_Read(uint32_t from_seq, EventLog_Record_t* records, uint16_t count);
+const EventLog_Stats_t* EventLog_GetStats(void);
+uint16_t EventLog_Serialize(uint8_t subcmd, uint8_t count, uint32_t from_seq, uint8_t* buf, uint16_t size);
+
+#endif // __EVENTLOG_H__
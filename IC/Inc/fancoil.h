@@ -0,0 +1,144 @@
+/**
+ ******************************************************************************
+ * @file    fancoil.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   PI/PID regulator i samopodešavanje za fan-coil termostata.
+ *
+ * @note    Modul je čista cjelobrojna logika bez HAL-a (prevodi se i u host
+ * simulator `ic_thermal_sim`). `THSTAT_Service` ga poziva svakih
+ * `FANC_SAMPLE_MS` sa zadatom i izmjerenom temperaturom, a on vraća
+ * zahtjev u promilima (0..`FANC_DEMAND_MAX`). `FanCoil_Output` pretvara
+ * zahtjev u stepen ventilatora (0..3) i stanje ventila, uvijek sa
+ * histerezom i najkraćim zadržavanjem stepena `FANC_STAGE_DWELL_MS`, da
+ * releji ne bi prebacivali češće nego sa histereznim trakama:
+ * - ventil i brzina 1 se uključuju kada zahtjev dostigne `FANC_VALVE_ON`,
+ *   a isključuju kada padne ispod `FANC_VALVE_OFF`; integrator tako drži
+ *   srednju temperaturu na zadatoj bez stalnog prebacivanja;
+ * - brzine 2 i 3 bira samo P član (trenutna greška), ne integrator, pa
+ *   opterećenje malo iznad snage brzine 1 ne izaziva stalno prebacivanje
+ *   između brzina, nego ostaje mala greška dok ne poraste do praga.
+ *
+ * Integrator ima zaštitu od zasićenja (uslovna integracija i ograničenje na
+ * opseg izlaza), a derivacija se računa iz mjerenja, ne iz greške, pa skok
+ * zadate vrijednosti ne daje udar. Samopodešavanje je relejni test
+ * (Åström-Hägglund): izlaz se prebacuje između 0 i punog zahtjeva oko zadate
+ * vrijednosti, iz amplitude i perioda oscilacije sobe se dobija kritično
+ * pojačanje i period, a parametri PI regulatora po Tyreus-Luyben pravilu.
+ ******************************************************************************
+ */
+
+#ifndef __FANCOIL_H__
+#define __FANCOIL_H__                           FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Algoritmi regulacije (`Thermostat_SetControlAlgorithm`)
+ *  @{
+ */
+#define FANC_ALGO_BANDS                 0U      ///< Histerezne trake `fan_loband`/`fan_hiband`/`fan_diff`
+#define FANC_ALGO_PI                    1U      ///< PI sa zadatim parametrima
+#define FANC_ALGO_PID                   2U      ///< PID sa zadatim parametrima
+#define FANC_ALGO_ADAPTIVE              3U      ///< PI sa parametrima iz samopodešavanja
+#define FANC_ALGO_COUNT                 4U
+/** @} */
+
+/** @name Regulator
+ *  @{
+ */
+#define FANC_DEMAND_MAX                 1000    ///< Puni zahtjev, promili
+#define FANC_SAMPLE_MS                  10000U  ///< Period regulatora
+#define FANC_DERIV_FILTER_SHIFT         2U      ///< Filter derivacije: y += (x - y) / 4 po periodu
+#define FANC_DEFAULT_KP                 400U    ///< Promila po °C (puni zahtjev na 2,5 °C greške)
+#define FANC_DEFAULT_TI                 1800U   ///< Integralno vrijeme, s
+#define FANC_DEFAULT_TD                 60U     ///< Derivaciono vrijeme za PID, s
+/** @} */
+
+/** @name Preslikavanje zahtjeva na ventil i brzine ventilatora
+ *  @{
+ */
+#define FANC_VALVE_ON                   450     ///< Zahtjev za otvaranje ventila (brzina 1)
+#define FANC_VALVE_OFF                  100     ///< Ispod ovoga se ventil zatvara (histereza oko 0,9 °C uz Kp 400)
+#define FANC_SPEED2_ON                  800     ///< P član za brzinu 2 (2 °C greške uz Kp 400)
+#define FANC_SPEED3_ON                  950     ///< P član za brzinu 3
+#define FANC_SPEED_HYST                 150     ///< Histereza za spuštanje brzine
+#define FANC_STAGE_DWELL_MS             300000U ///< Najkraće zadržavanje stepena (i ventila) prije promjene
+/** @} */
+
+/** @name Samopodešavanje (relejni test)
+ *  @{
+ */
+#define FANC_TUNE_HYST                  2       ///< Histereza releja, desetinke °C
+#define FANC_TUNE_CYCLES                2U      ///< Mjerenih perioda (nakon jednog za ustaljivanje)
+#define FANC_TUNE_TIMEOUT_MS            (6UL * 3600UL * 1000UL)  ///< Prekid testa
+#define FANC_TUNE_MIN_AMPLITUDE         2       ///< Najmanja amplituda za valjan rezultat, desetinke °C
+/** @} */
+
+/**
+ * @brief Parametri regulatora.
+ */
+typedef struct
+{
+    uint16_t kp;                /**< Pojačanje, promila zahtjeva po °C greške. */
+    uint16_t ti;                /**< Integralno vrijeme, s (0 isključuje I). */
+    uint16_t td;                /**< Derivaciono vrijeme, s (0 isključuje D). */
+} FanCoil_Params_t;
+
+/**
+ * @brief Stanje samopodešavanja.
+ */
+typedef enum
+{
+    FANC_TUNE_IDLE = 0,
+    FANC_TUNE_RUNNING,
+    FANC_TUNE_DONE,
+    FANC_TUNE_FAILED
+} FanCoil_TuneState_t;
+
+/**
+ * @brief Stanje jednog regulatora (ugrađuje se u strukturu termostata).
+ */
+typedef struct
+{
+    FanCoil_Params_t params;
+    int32_t  integral;          /**< I član, promili << 8. */
+    int32_t  deriv;             /**< Filtrirani D član, promili. */
+    int16_t  last_pv;           /**< Prethodno mjerenje (sa predznakom smjera). */
+    bool     primed;            /**< `last_pv` je važeće. */
+    int16_t  demand;            /**< Posljednji zahtjev, promili. */
+    int16_t  boost;             /**< P član zahtjeva, 0..`FANC_DEMAND_MAX`; bira brzine 2 i 3. */
+
+    uint32_t speed_since;       /**< Trenutak posljednje promjene stepena (i ventila). */
+    uint8_t  speed;             /**< Posljednji stepen, 0..3. */
+
+    FanCoil_TuneState_t tune;
+    bool     relay_on;
+    uint8_t  tune_switches;     /**< Broj uključenja releja od početka testa. */
+    uint32_t tune_start;
+    uint32_t tune_last_on;      /**< Trenutak posljednjeg uključenja releja. */
+    uint32_t tune_period_sum;   /**< Zbir mjerenih perioda, ms. */
+    int32_t  tune_amp_sum;      /**< Zbir mjerenih razlika vrh-dno, desetinke °C. */
+    int16_t  tune_max;
+    int16_t  tune_min;
+} FanCoil_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija ---
+void FanCoil_Init(FanCoil_t* fc, const FanCoil_Params_t* params, uint32_t now);
+void FanCoil_Reset(FanCoil_t* fc, uint32_t now);
+
+// --- Grupa 2: Regulacija ---
+int16_t FanCoil_Update(FanCoil_t* fc, int16_t sp, int16_t pv, bool heating, bool use_d);
+uint8_t FanCoil_Output(FanCoil_t* fc, int16_t demand, uint8_t max_speed, uint32_t now);
+
+// --- Grupa 3: Samopodešavanje ---
+void FanCoil_TuneStart(FanCoil_t* fc, uint32_t now);
+int16_t FanCoil_TuneStep(FanCoil_t* fc, int16_t sp, int16_t pv, bool heating, uint32_t now);
+
+#endif // __FANCOIL_H__
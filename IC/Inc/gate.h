@@ -80,7 +80,8 @@ typedef enum {
 /**
  ******************************************************************************
  * @brief Definiše tip aktivnog tajmera unutar gate modula.
- * @note  Koristi se za upravljanje logikom u `Gate_Service` funkciji.
+ * @note  Određuje trajanje tajmera i šta se radi po njegovom isteku
+ * (`Gate_TimerExpired`, poziva ga `TimerWheel_Service`).
  ******************************************************************************
  */
 typedef enum {
@@ -208,7 +209,6 @@ typedef struct Gate_s Gate_Handle;
 
 // --- Glavne funkcije ---
 void Gate_Init(void);
-void Gate_Service(void);
 void Gate_Save(void);
 Gate_Handle* Gate_GetInstance(uint8_t index);
 uint8_t Gate_GetCount(void);
@@ -222,7 +222,6 @@ void Gate_TriggerStop(Gate_Handle* handle);
 void Gate_TriggerUnlock(Gate_Handle* handle);
 
 // --- Obrada događaja ---
-void GATE_BusEvent(uint16_t address, uint8_t command, uint8_t* data, uint8_t len);
 void Gate_AcknowledgeFault(Gate_Handle* handle);
 
 /*============================================================================*/
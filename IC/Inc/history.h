@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @file    history.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Istorija mjerenja u SDRAM-u: temperatura, zadata temperatura,
+ *          brzina ventilatora i vrijeme uključenosti svjetala.
+ *
+ * @note    Svaki kanal ima tri nivoa rezolucije (`HIST_TIER0_PERIOD_S`,
+ * `HIST_TIER1_PERIOD_S`, `HIST_TIER2_PERIOD_S`). Nivo 0 dobija uzorak iz
+ * `History_Service`, a svaki sljedeći nivo srednju vrijednost (ili zbir, za
+ * vrijeme uključenosti) grupe uzoraka prethodnog nivoa. Nivo je kružni niz
+ * blokova fiksne veličine: blok nosi vrijeme i apsolutnu vrijednost prvog
+ * uzorka, a ostali uzorci su razlike od prethodnog, zigzag/varint kodirane
+ * (najčešće 1 bajt po uzorku). Kada se blok napuni, počinje sljedeći i
+ * prepisuje najstariji, pa je upis O(1), memorija fiksna, a svaki blok se
+ * može dekodirati sam. Vrijeme je u sekundama od uključenja (`HAL_GetTick`).
+ *
+ * `History_Query` za grafik sažima traženi interval u kolone (min, max,
+ * zbir) iz najfinijeg nivoa koji pokriva početak intervala. Blokovi se
+ * preuzimaju neizmijenjeni preko `DIAG_GET` (`DIAG_HIST_xxx`).
+ *
+ * Nizovi su u SDRAM-u (sekcija `.sdram_ram`, `UNINIT` region u `db.sct`)
+ * i brišu se u `History_Init`.
+ ******************************************************************************
+ */
+
+#ifndef __HISTORY_H__
+#define __HISTORY_H__                           FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Nivoi rezolucije i kapacitet
+ *  @{
+ */
+#define HIST_TIERS                      3U
+#define HIST_TIER0_PERIOD_S             10U     ///< Nivo 0: uzorak svakih 10 s
+#define HIST_TIER1_PERIOD_S             60U     ///< Nivo 1: 6 uzoraka nivoa 0
+#define HIST_TIER2_PERIOD_S             900U    ///< Nivo 2: 15 uzoraka nivoa 1
+#define HIST_BLOCK_SIZE                 64U     ///< Bajtova po bloku, sa zaglavljem
+#define HIST_BLOCK_HEADER               8U      ///< Vrijeme (4), vrijednost (2), broj uzoraka, bajtova podataka
+#define HIST_BLOCK_DATA                 (HIST_BLOCK_SIZE - HIST_BLOCK_HEADER)
+#define HIST_BLOCKS                     64U     ///< Blokova po nivou i kanalu (4 KB)
+/** @} */
+
+/** @name DIAG_GET pod-komande (nastavak na `DIAG_WDG_xxx`)
+ *  @{
+ */
+#define DIAG_HIST_STATUS                12U     ///< Kanali, nivoi, periodi i broj blokova
+#define DIAG_HIST_READ                  13U     ///< Blok od najstarijeg: [stranica, kanal, nivo]
+/** @} */
+
+/**
+ * @brief Kanali istorije; svjetla su `HIST_CH_LIGHT + indeks`.
+ */
+typedef enum
+{
+    HIST_CH_TEMP = 0,           /**< Izmjerena temperatura, desetinke °C (srednja vrijednost). */
+    HIST_CH_SETPOINT,           /**< Zadata temperatura, desetinke °C (srednja vrijednost). */
+    HIST_CH_FAN,                /**< Brzina ventilatora x10 (srednja vrijednost). */
+    HIST_CH_LIGHT,              /**< Sekundi uključenosti svjetla u periodu (zbir). */
+    HIST_CHANNELS = HIST_CH_LIGHT + LIGHTS_MODBUS_SIZE
+} History_Channel_e;
+
+/**
+ * @brief Jedna kolona grafika; `count` 0 znači da u koloni nema uzoraka.
+ */
+typedef struct
+{
+    int16_t  min;
+    int16_t  max;
+    int32_t  sum;
+    uint16_t count;
+} History_Column_t;
+
+/**
+ * @brief Sažetak upita za cijeli interval.
+ */
+typedef struct
+{
+    uint8_t  tier;              /**< Nivo iz kojeg su uzorci. */
+    uint16_t period_s;          /**< Period uzorka tog nivoa. */
+    int16_t  min;
+    int16_t  max;
+    int32_t  sum;
+    uint32_t samples;           /**< 0 ako u intervalu nema uzoraka. */
+} History_Summary_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija i upis ---
+void History_Init(void);
+void History_Service(void);
+void History_Push(uint8_t channel, int16_t value, uint32_t time_s);
+
+// --- Grupa 2: Čitanje ---
+uint32_t History_Now(void);
+uint16_t History_Query(uint8_t channel, uint32_t from_s, uint32_t to_s,
+                       History_Column_t* columns, uint16_t count, History_Summary_t* summary);
+uint16_t History_GetPeriod(uint8_t tier);
+
+// --- Grupa 3: Preuzimanje ---
+uint16_t History_Serialize(uint8_t subcmd, uint8_t page, uint8_t channel, uint8_t tier, uint8_t* buf, uint16_t size);
+
+#endif // __HISTORY_H__
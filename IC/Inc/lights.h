@@ -109,7 +109,8 @@ typedef struct
 
     /**
      * @brief Vrijeme odgode u minutama za "delayed-on" tajmer.
-     * Koristi se u `HandleOnDelayTimers` da odloi paljenje svjetla nakon
+     * Samo se cuva i podesava na ekranu; odgodjeno paljenje jos ne koristi
+     * ovu vrijednost. Namjena: odloi paljenje svjetla nakon
      * to je primljena eksterna komanda.
      */
     uint8_t  controllerID_on_delay;
@@ -261,11 +262,7 @@ bool LIGHT_isRGB(const LIGHT_Handle* const handle);
 // --- Grupa 6: Funkcije koje ne zavise od instance ---
 bool LIGHTS_isAnyLightOn(void);
 
-// --- Grupa 7: Funkcije za RS485 i eksterne module ---
-void LIGHTS_UpdateExternalState(uint16_t relay_address, uint8_t state);
-void LIGHTS_UpdateExternalBrightness(uint16_t relay_address, uint8_t brightness);
-
-// --- Grupa 8: API za Nocni Tajmer ---
+// --- Grupa 7: API za Nocni Tajmer ---
 void    LIGHTS_StartNightTimer(void);
 void    LIGHTS_StopNightTimer(void);
 bool    LIGHTS_IsNightTimerActive(void);
@@ -46,6 +46,19 @@ typedef struct{
 	uint8_t year;        	/*!< Year parameter, 00 to 99, 00 is 2000 and 99 is 2099 */
 	uint32_t unix;       	/*!< Seconds from 01.01.1970 00:00:00 */	
 } RTC_t;
+/**
+ * @brief Gestovi koje prepoznaje `TS_Service` iz niza ocitanja touch kontrolera.
+ */
+typedef enum {
+    TS_GESTURE_NONE = 0,        ///< Nema novog gesta
+    TS_GESTURE_LONG_PRESS,      ///< Prst miruje na ekranu duze od 1 s
+    TS_GESTURE_LONG_HOLD,       ///< Prst miruje na ekranu duze od 2 s
+    TS_GESTURE_DOUBLE_TAP,      ///< Dva kratka dodira na istom mjestu
+    TS_GESTURE_SWIPE_LEFT,      ///< Brzi pokret ulijevo
+    TS_GESTURE_SWIPE_RIGHT,     ///< Brzi pokret udesno
+    TS_GESTURE_SWIPE_UP,        ///< Brzi pokret prema gore
+    TS_GESTURE_SWIPE_DOWN       ///< Brzi pokret prema dolje
+} TS_GestureTypeDef;
 /* Exported constants --------------------------------------------------------*/
 /* Exported variable  --------------------------------------------------------*/
 extern char system_pin[8]; // << NOVO: Globalni bafer za sistemski PIN
@@ -145,6 +158,7 @@ extern DMA2D_HandleTypeDef hdma2d;
 void SYSRestart(void);
 void SetDefault(void);
 void TS_Service(void);
+TS_GestureTypeDef TS_GetGesture(void);
 void SetPin(uint8_t pin, uint8_t pinVal);
 void RTC_GetDateTime(RTC_t* data, uint32_t format);
 void ErrorHandler(uint8_t function, uint8_t driver);
@@ -0,0 +1,87 @@
+/**
+ ******************************************************************************
+ * @file    ntc.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Javni API za mjerenje sobne temperature sa NTC senzora (ADC3).
+ *
+ * @note    TIM6 okida ADC3 konverziju `NTC_SAMPLE_RATE_HZ` puta u sekundi, a
+ * DMA upisuje rezultate u kružni bafer od dvije polovine. Kada se polovina
+ * napuni, prekid DMA-a sabere njene uzorke (oversampling, 4 bita više
+ * rezolucije) i provuče rezultat kroz cjelobrojni eksponencijalni filter.
+ * Svakih `NTC_BLOCKS_PER_REPORT` blokova se postavlja zastavica spremnosti i
+ * podiže `SCHED_EVT_ADC`, pa glavna petlja samo preuzima gotovu vrijednost.
+ * Vrijednosti su u jedinicama 12-bitnog ADC-a pomnoženim sa 16.
+ * `NTC_ToDeciCelsius` ih pretvara u desetinke °C cjelobrojnom interpolacijom
+ * iz tabele `ntc_table.c`, koju generiše host alat `ic_ntc_table` iz
+ * parametara senzora i djelitelja ispod.
+ ******************************************************************************
+ */
+
+#ifndef __NTC_H__
+#define __NTC_H__                               FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Konfiguracija akvizicije
+ *  @{
+ */
+#define NTC_SAMPLE_RATE_HZ              1000U   ///< Frekvencija okidanja ADC3 (TIM6 TRGO)
+#define NTC_BLOCK_SAMPLES               64U     ///< Uzoraka u jednoj polovini DMA bafera
+#define NTC_OVERSAMPLE_SHIFT            2U      ///< Suma bloka >> ovo = vrijednost x16
+#define NTC_EMA_SHIFT                   5U      ///< Filter: y += (x - y) / 32 po bloku (oko 2 s)
+#define NTC_BLOCKS_PER_REPORT           4U      ///< Zastavica spremnosti svakih ~256 ms
+#define NTC_OPEN_LOW                    100U    ///< Ispod ovoga (12 bita) senzor je u kratkom spoju
+#define NTC_OPEN_HIGH                   4000U   ///< Iznad ovoga (12 bita) senzor je odspojen
+#define NTC_FULL_SCALE                  (4095U * 16U)   ///< Najveća vrijednost x16
+/** @} */
+
+/** @name Senzor i djelitelj (NTC prema masi, otpornik prema referenci)
+ *  @{
+ */
+#define NTC_RREF                        10000U  ///< Otpor NTC-a na 25 °C
+#define NTC_B_VALUE                     3977U   ///< Beta parametar
+#define NTC_PULLUP                      10000U  ///< Otpornik djelitelja prema referenci
+/** @} */
+
+/** @name Tabela konverzije (`ntc_table.c`)
+ *  @{
+ */
+#define NTC_TABLE_SHIFT                 6U      ///< Širina segmenta je 2^6 jedinica x16 (4 koraka ADC-a)
+#define NTC_TABLE_SIZE                  ((65536UL >> NTC_TABLE_SHIFT) + 1U)
+#define NTC_TEMP_MIN                    (-600)  ///< Donja granica tabele, desetinke °C (ispod pragova odspojenog senzora)
+#define NTC_TEMP_MAX                    1500    ///< Gornja granica tabele, desetinke °C (iznad pragova kratkog spoja)
+/** @} */
+
+/**
+ * @brief Jedno očitanje za termostat.
+ */
+typedef struct
+{
+    uint16_t raw;               /**< Prosjek posljednjeg bloka, x16. */
+    uint16_t filtered;          /**< Izlaz eksponencijalnog filtera, x16. */
+    bool open;                  /**< Senzor odspojen ili u kratkom spoju. */
+} NTC_Sample_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Pokretanje ---
+void NTC_Start(ADC_HandleTypeDef* hadc);
+
+// --- Grupa 2: Rezultat ---
+bool NTC_Read(NTC_Sample_t* sample);
+
+// --- Grupa 3: Filter i konverzija (bez HAL-a) ---
+void NTC_FilterReset(void);
+bool NTC_FilterBlock(const uint16_t* samples, uint16_t count);
+int16_t NTC_ToDeciCelsius(uint16_t adc_x16);
+
+/** Generisana tabela: temperatura u desetinkama °C na početku svakog segmenta. */
+extern const int16_t ntc_table[NTC_TABLE_SIZE];
+
+#endif // __NTC_H__
@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * @file    profiler.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Javni API za profiler iscrtavanja ekrana.
+ *
+ * @note    Profiler mjeri vrijeme pomoću DWT brojača ciklusa. Za svaki ekran
+ * (`eScreen`) vodi zbirnu statistiku trajanja `Service_XxxScreen` funkcije,
+ * vremena koje DMA2D provede u radu, trajanja `GUI_Exec` i broja punih
+ * iscrtavanja. Pojedinačni "skupi" frejmovi se upisuju u kružni bafer.
+ * Podaci se prikazuju na skrivenom dijagnostičkom ekranu i mogu se
+ * preuzeti preko RS485 (`DIAG_GET`).
+ ******************************************************************************
+ */
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__                          FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Konfiguracija profilera
+ *  @{
+ */
+#define PROFILER_SCREEN_COUNT           64U     ///< Broj praćenih ekrana (mora biti veći od zadnjeg `eScreen`)
+#define PROFILER_RING_SIZE              64U     ///< Broj frejmova u kružnom baferu
+#define PROFILER_RECORD_MIN_US          500U    ///< Frejm se upisuje u bafer ako crtanje traje duže od ovoga
+/** @} */
+
+/** @name DIAG_GET pod-komande (drugi bajt zahtjeva)
+ *  @{
+ */
+#define DIAG_PROFILER_SCREENS           1U      ///< Zbirna statistika po ekranima, stranica po stranica
+#define DIAG_PROFILER_FRAMES            2U      ///< Sadržaj kružnog bafera frejmova, stranica po stranica
+#define DIAG_PROFILER_RESET             3U      ///< Brisanje svih mjerenja
+/** @} */
+
+/**
+ * @brief Zbirna statistika za jedan ekran.
+ * @note  Vremena su u ciklusima procesora; za mikrosekunde koristiti
+ * `Profiler_CyclesToUs`.
+ */
+typedef struct
+{
+    uint32_t frames;            /**< Broj poziva `Service_XxxScreen` funkcije. */
+    uint32_t redraws;           /**< Broj poziva sa postavljenim `shouldDrawScreen` (puno iscrtavanje). */
+    uint64_t draw_cycles;       /**< Ukupno trajanje `Service_XxxScreen` poziva. */
+    uint32_t draw_max;          /**< Najduži pojedinačni poziv. */
+    uint64_t dma_cycles;        /**< Ukupno vrijeme čekanja na DMA2D tokom crtanja i `GUI_Exec`. */
+    uint32_t exec_count;        /**< Broj `GUI_Exec` poziva dok je ekran bio aktivan. */
+    uint64_t exec_cycles;       /**< Ukupno trajanje `GUI_Exec` poziva. */
+    uint32_t exec_max;          /**< Najduži pojedinačni `GUI_Exec`. */
+} Profiler_ScreenStats_t;
+
+/**
+ * @brief Jedan zapis u kružnom baferu frejmova.
+ */
+typedef struct
+{
+    uint32_t tick;              /**< `HAL_GetTick()` na kraju frejma. */
+    uint8_t  screen;            /**< Aktivni ekran (`eScreen`). */
+    uint8_t  redraw;            /**< 1 ako je frejm bio puno iscrtavanje. */
+    uint16_t draw_us;           /**< Trajanje `Service_XxxScreen` u us (zasićeno na 65535). */
+    uint16_t dma_us;            /**< DMA2D vrijeme u us. */
+    uint16_t exec_us;           /**< Trajanje `GUI_Exec` u us, 0 ako nije pozvan. */
+} Profiler_Frame_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija ---
+void Profiler_Init(void);
+void Profiler_Reset(void);
+
+// --- Grupa 2: Tačke mjerenja (poziva display.c / LCDConf.c) ---
+void Profiler_GuiExecBegin(void);
+void Profiler_GuiExecEnd(void);
+void Profiler_FrameBegin(uint8_t screen, bool redraw);
+void Profiler_FrameEnd(void);
+void Profiler_Dma2dAdd(uint32_t cycles);
+
+// --- Grupa 3: Čitanje rezultata ---
+const Profiler_ScreenStats_t* Profiler_GetScreenStats(uint8_t screen);
+uint8_t Profiler_GetFrameCount(void);
+const Profiler_Frame_t* Profiler_GetFrame(uint8_t index);
+uint32_t Profiler_CyclesToUs(uint64_t cycles);
+uint16_t Profiler_Serialize(uint8_t subcmd, uint8_t page, uint8_t* buf, uint16_t size);
+
+/**
+ * @brief Trenutna vrijednost DWT brojača ciklusa.
+ */
+#define Profiler_Cycles()               (DWT->CYCCNT)
+
+#endif // __PROFILER_H__
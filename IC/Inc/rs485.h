@@ -17,6 +17,7 @@
 #define COMMAND_QUEUE_SIZE (32)   // Maksimalan broj komandi u redu
 #define BINARY_ON          0x01   // Novo stanje za binarni izlaz: UKLJUCENO 
 #define BINARY_OFF         0x02   // Novo stanje za binarni izlaz: ISKLJUCENO
+#define GET_QUEUE_SIZE     (8)    // Maksimalan broj upita stanja na cekanju (GetStateAsync)
 /* Exported Type  ------------------------------------------------------------*/
 // Definicija komande
 typedef struct {
@@ -40,6 +41,17 @@ typedef struct {
     uint8_t data[COMMAND_QUEUE_SIZE];  // Dovoljno velik bafer za razne GET odgovore
     uint8_t length;
 } GetResponseBuffer;
+
+// Funkcija koju RS485_Service poziva kada stigne odgovor na GetStateAsync upit;
+// data pokazuje na odgovor iza adrese, kao kod DevReg_Handler_t
+typedef void (*GetStateCallback)(uint16_t index, uint16_t address, const uint8_t *data, uint8_t length);
+
+// Brojaci komandi iz redova (dijagnostika, pracenje aktivacije scena)
+typedef struct {
+    uint32_t sent;      // komandi skinutih iz redova (poslanih)
+    uint32_t failed;    // komandi bez ACK ni nakon MAX_RETRIES pokusaja
+    uint32_t dropped;   // komandi koje AddCommand nije primio jer je red bio pun
+} CommandStats;
 /* Exported variables  -------------------------------------------------------*/
 extern uint8_t  rec;
 extern uint8_t  tfifa;
@@ -63,6 +75,8 @@ void RS485_RxCpltCallback(void);
 void RS485_TxCpltCallback(void);
 void RS485_ErrorCallback(void);
 bool GetState(uint8_t commandType, uint16_t address, uint8_t *response);
+bool GetStateAsync(uint8_t commandType, uint16_t address, GetStateCallback callback, uint16_t index);
 bool AddCommand(CommandQueue *queue, uint8_t commandType, uint8_t *data, uint8_t length);
+const CommandStats* GetCommandStats(void);
 #endif
 /************************ (C) COPYRIGHT JUBERA D.O.O Sarajevo ************************/
@@ -9,6 +9,13 @@
  * jednim dodirom postavi stanja više različitih uređaja (svjetla, roletne,
  * kapije, termostati) u unaprijed definisane pozicije.
  * Modul također upravlja globalnim stanjem sistema (npr. "Away Mode").
+ *
+ * Aktivacija je transakcija: `Scene_Activate` poredi memorisana stanja sa
+ * trenutnim i pravi plan samo od uređaja koje treba promijeniti, a
+ * `Scene_Service` ih primjenjuje postepeno, samo dok redovi komandi u
+ * `rs485` imaju mjesta. Scena je primijenjena kada su sve njene komande
+ * poslane; `Scene_GetApplyStats` daje ishod, trajanje i broj izgubljenih
+ * komandi.
  ******************************************************************************
  */
 
@@ -43,6 +50,32 @@ typedef enum {
     SYSTEM_STATE_AWAY_ACTIVE    /**< Sistem je u "Away" modu, aktivna je simulacija prisustva i čekaju se "Homecoming" okidači. */
 } SystemState_e;
 
+/**
+ * @brief Ishod posljednje aktivacije scene.
+ */
+typedef enum {
+    SCENE_APPLY_IDLE,           /**< Scena još nije aktivirana. */
+    SCENE_APPLY_RUNNING,        /**< Uređaji se postavljaju ili komande još čekaju u redovima. */
+    SCENE_APPLY_DONE,           /**< Sve komande scene su poslane i potvrđene. */
+    SCENE_APPLY_FAILED          /**< Komanda je odbačena (pun red), nije potvrđena ili je isteklo vrijeme. */
+} SceneApplyState_e;
+
+/**
+ * @brief Mjerenja aktivacija jedne scene (runtime, ne čuva se u EEPROM-u).
+ */
+typedef struct {
+    SceneApplyState_e state;    /**< Ishod posljednje aktivacije. */
+    uint16_t activations;       /**< Broj završenih aktivacija. */
+    uint16_t failures;          /**< Aktivacija koje su završile sa `SCENE_APPLY_FAILED`. */
+    uint8_t  devices;           /**< Uređaja promijenjenih u posljednjoj aktivaciji. */
+    uint8_t  skipped;           /**< Uređaja scene koji su već bili u traženom stanju. */
+    uint16_t commands;          /**< Komandi poslanih na bus tokom posljednje aktivacije. */
+    uint32_t last_ms;           /**< Trajanje posljednje aktivacije (do slanja zadnje komande). */
+    uint32_t max_ms;            /**< Najduže trajanje aktivacije. */
+    uint32_t dropped;           /**< Komandi odbačenih zbog punog reda, ukupno. */
+    uint32_t unacked;           /**< Komandi bez ACK-a, ukupno. */
+} Scene_ApplyStats_t;
+
 /**
  ******************************************************************************
  * @brief       Struktura koja definiše vizuelni izgled jedne scene.
@@ -78,8 +111,8 @@ typedef enum {
  ******************************************************************************
  * @brief       Glavna struktura koja čuva kompletnu konfiguraciju i stanje JEDNE scene.
  * @author      Gemini & [Vaše Ime]
- * @note        Niz ovih struktura se čuva unutar `Scene_EepromBlock_t` omotača,
- * što omogućava efikasno snimanje i čitanje iz EEPROM-a.
+ * @note        Svaka scena se čuva u svom `Scene_EepromRecord_t` omotaču,
+ * pa se u EEPROM upisuju samo izmijenjene scene.
  * Sadrži maske za uključene uređaje i polja za njihove
  * memorisane vrijednosti.
  ******************************************************************************
@@ -108,14 +141,14 @@ typedef struct
      * to znači da je svjetlo sa indeksom 0 uključeno u ovu scenu i da će
      * njegovo stanje biti promijenjeno kada se scena aktivira.
      */
-    uint8_t  lights_mask;
+    uint32_t lights_mask;
 
     /**
      * @brief Bitmaska koja definiše koje roletne su uključene u scenu.
-     * @note  Funkcioniše na isti način kao `lights_mask`, ali za 16 roletni.
+     * @note  Funkcioniše na isti način kao `lights_mask`, ali za roletne.
      * Bit 0 odgovara roletni 0, Bit 1 roletni 1, itd.
      */
-    uint16_t curtains_mask;
+    uint32_t curtains_mask;
     
     /**
      * @brief Bitmaska koja definiše koji termostati su uključeni u scenu.
@@ -189,7 +222,7 @@ typedef struct
     bool activate_wakeup_scene;
 
     /**
-     * @brief Indeks scene (0-5) koja će biti aktivirana kao scena buđenja.
+     * @brief Indeks scene (0 do `SCENE_MAX_COUNT` - 1) koja će biti aktivirana kao scena buđenja.
      * @note Vrijednost -1 označava da nijedna scena nije odabrana.
      */
     int8_t wakeup_scene_index;
@@ -224,21 +257,20 @@ typedef struct
 
 /**
  ******************************************************************************
- * @brief       "Omot" struktura za snimanje svih scena u EEPROM.
- * @author      Gemini (po specifikaciji korisnika)
- * @note        Ova struktura objedinjuje sve podatke vezane za scene u jedan
- * blok koji se atomarno upisuje i čita iz EEPROM-a.
- * Zahvaljujući `#pragma pack`, raspored u memoriji je kompaktan i
- * pouzdan, a `magic_number` i `crc` osiguravaju integritet
- * podataka nakon restarta ili gubitka napajanja.
+ * @brief       "Omot" struktura za snimanje jedne scene u EEPROM.
+ * @author      Gemini & [Vaše Ime]
+ * @note        `SCENE_MAX_COUNT` ovih zapisa je u EEPROM-u jedan iza drugog
+ * od adrese `EE_SCENES`. Svaki zapis ima svoj `magic_number` i `crc`,
+ * pa oštećen zapis vraća na fabričke postavke samo svoju scenu, a
+ * `Scene_Save` upisuje samo scene koje su se promijenile.
  ******************************************************************************
  */
 typedef struct 
 {
     uint16_t magic_number;              /**< "Potpis" za validaciju podataka u EEPROM-u. Služi za detekciju da li su podaci validni ili je potrebno učitati fabričke postavke. */
-    Scene_t  scenes[SCENE_MAX_COUNT];   /**< Niz koji sadrži podatke za sve scene koje sistem podržava. */
-    uint16_t crc;                       /**< CRC za provjeru integriteta cijelog bloka. Računa se preko svih članova strukture prije upisa u EEPROM. */
-} Scene_EepromBlock_t;
+    Scene_t  scene;                     /**< Podaci jedne scene. */
+    uint16_t crc;                       /**< CRC za provjeru integriteta zapisa. Računa se preko svih članova strukture prije upisa u EEPROM. */
+} Scene_EepromRecord_t;
 
 #pragma pack(pop)
 
@@ -256,5 +288,7 @@ Scene_t* Scene_GetInstance(uint8_t scene_index);
 uint8_t Scene_GetCount(void);
 void Scene_SetSystemState(SystemState_e state);
 SystemState_e Scene_GetSystemState(void);
+const Scene_ApplyStats_t* Scene_GetApplyStats(uint8_t scene_index);
+int8_t Scene_GetLastActivated(void);
 
 #endif // __SCENE_CTRL_H__
@@ -0,0 +1,96 @@
+/**
+ ******************************************************************************
+ * @file    scheduler.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Javni API kooperativnog planera servisa glavne petlje.
+ *
+ * @note    Svaki servis je zadatak koji se izvršava do kraja (run-to-completion)
+ * kada mu istekne period ili kada prekid podigne neki od događaja na koje
+ * čeka. Zadaci se obilaze redoslijedom iz tabele, pa redoslijed iz stare
+ * `while(1)` petlje ostaje sačuvan. Kada nijedan zadatak nije spreman,
+ * procesor spava na `__WFI` do sljedećeg prekida (najkasnije SysTick za 1 ms).
+ * Za svaki zadatak se vodi broj izvršavanja, kašnjenje u odnosu na rok i
+ * trajanje (DWT), a statistika se preuzima preko RS485 (`DIAG_GET`).
+ * Najduži prolaz kroz tabelu je najduži razmak između dva osvježavanja
+ * IWDG-a i treba ga porediti sa njegovim periodom. Zadatak koji prekorači
+ * svoj budžet trajanja, i prolaz koji potroši veliki dio IWDG perioda,
+ * upisuju se u trajni log (`watchdog.h`).
+ ******************************************************************************
+ */
+
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__                         FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Događaji koje podižu prekidi (`Sched_SetEvent`)
+ *  @{
+ */
+#define SCHED_EVT_RS485_RX              (1UL << 0)  ///< TinyFrame parser je završio okvir (USART1 RX)
+#define SCHED_EVT_TOUCH                 (1UL << 1)  ///< FT5336 INT linija (EXTI)
+#define SCHED_EVT_ADC                   (1UL << 2)  ///< ADC3 DMA ima novo NTC očitanje (`ntc.h`)
+#define SCHED_EVT_RTC_ALARM             (1UL << 3)  ///< RTC alarm
+/** @} */
+
+/** @name DIAG_GET pod-komande (nastavak na `DIAG_PROFILER_xxx`)
+ *  @{
+ */
+#define DIAG_SCHED_TASKS                4U      ///< Statistika po zadacima, stranica po stranica
+#define DIAG_SCHED_SUMMARY              5U      ///< Ukupno opterećenje procesora i broj buđenja
+#define DIAG_SCHED_RESET                6U      ///< Brisanje statistike planera
+/** @} */
+
+/**
+ * @brief Popunjava stavku tabele zadataka; statistika počinje od nule.
+ * @note  `budget_us` je najduže očekivano trajanje jednog izvršavanja,
+ * 0 = bez provjere.
+ */
+#define SCHED_TASK(fn, period_ms, events, budget_us) { #fn, (fn), (period_ms), (events), (budget_us) }
+
+/**
+ * @brief Jedan zadatak planera.
+ * @note  Prvih pet polja su konfiguracija (`SCHED_TASK`), ostalo vodi
+ * planer. Vremena izvršavanja su u ciklusima procesora.
+ */
+typedef struct
+{
+    const char* name;           /**< Ime servisa (za dijagnostiku). */
+    void (*fn)(void);           /**< Servisna funkcija. */
+    uint32_t period;            /**< Period u ms; 0 = samo na događaj. */
+    uint32_t events;            /**< Maska `SCHED_EVT_xxx` događaja koji pokreću zadatak. */
+    uint32_t budget;            /**< Budžet trajanja u us; 0 = bez provjere. */
+    uint32_t budget_cycles;     /**< Budžet preračunat u cikluse (`Sched_Init`). */
+    uint32_t next_due;          /**< `HAL_GetTick()` sljedećeg periodičnog izvršavanja. */
+    uint32_t runs;              /**< Ukupan broj izvršavanja. */
+    uint32_t event_runs;        /**< Od toga pokrenutih događajem prije roka. */
+    uint32_t late_max;          /**< Najveće kašnjenje periodičnog izvršavanja iza roka, ms. */
+    uint32_t skipped;           /**< Propuštenih perioda (zadatak kasnio više od jednog perioda). */
+    uint64_t exec_cycles;       /**< Ukupno trajanje svih izvršavanja. */
+    uint32_t exec_min;          /**< Najkraće pojedinačno izvršavanje. */
+    uint32_t exec_max;          /**< Najduže pojedinačno izvršavanje. */
+    uint32_t overruns;          /**< Broj izvršavanja dužih od budžeta. */
+} Sched_Task_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija i izvršavanje ---
+void Sched_Init(Sched_Task_t* tasks, uint8_t count);
+void Sched_Run(void);
+
+// --- Grupa 2: Događaji (sigurno iz prekida) ---
+void Sched_SetEvent(uint32_t events);
+
+// --- Grupa 3: Statistika ---
+uint8_t Sched_GetTaskCount(void);
+const Sched_Task_t* Sched_GetTask(uint8_t index);
+uint16_t Sched_GetLoadPermille(void);
+void Sched_ResetStats(void);
+uint16_t Sched_Serialize(uint8_t subcmd, uint8_t page, uint8_t* buf, uint16_t size);
+
+#endif // __SCHEDULER_H__
@@ -156,7 +156,7 @@ void Security_TriggerSilentAlarm(void);
  * @brief       Dohvata posljednje poznato stanje (naoružana/razoružana) particije.
  * @author      Gemini & [Vaše Ime]
  * @note        Funkcija čita stanje iz interne `runtime` varijable koju ažurira
- * `Security_UpdateExternalState` kada stigne `DIN_EVENT` poruka.
+ * registar uređaja (`devreg.h`) kada stigne `DIN_EVENT` poruka.
  * @param       partition_index Indeks particije (0-2).
  * @retval      bool          Vraća `true` ako je particija naoružana, inače `false`.
  ******************************************************************************/
@@ -170,28 +170,12 @@ bool Security_GetPartitionState(uint8_t partition_index);
  ******************************************************************************/
 bool Security_GetSystemAlarmState(void);
 
-/******************************************************************************
- * @brief       Procesira događaj primljen sa RS485 bus-a.
- * @author      Gemini & [Vaše Ime]
- * @note        Ovo je jedina ulazna tačka za događaje sa bus-a. Poziva je
- * isključivo `DIN_EVENT_Listener` iz `rs485.c`. Funkcija brzo
- * provjerava da li je adresa iz događaja relevantna za ovaj modul
- * i ako jeste, prosljeđuje ga na internu obradu. Ako nije,
- * odmah se završava.
- * @param       address Adresa izvora događaja (npr. adresa digitalnog ulaza).
- * @param       command Tip komande (očekuje se DIN_EVENT).
- * @param       data    Pokazivač na podatke iz poruke.
- * @param       len     Dužina podataka.
- * @retval      None
- ******************************************************************************/
-void SECURITY_BusEvent(uint16_t address, uint8_t command, uint8_t* data, uint8_t len);
-
 /******************************************************************************
  * @brief       Eksplicitno osvježava sva interna stanja čitanjem sa bus-a.
  * @author      Gemini & [Vaše Ime]
- * @note        Ovu funkciju poziva `display.c` neposredno prije iscrtavanja
- * kontrolnog ekrana kako bi osigurao da GUI prikazuje najsvježije
- * podatke direktno sa hardvera.
+ * @note        Ovu funkciju poziva `display.c` pri otvaranju i iscrtavanju
+ * kontrolnog ekrana. Samo stavlja `DIN_GET` upite u red i odmah se vraća;
+ * stanja se ažuriraju kako odgovori stižu, a ekran se tada ponovo iscrtava.
  * @param       None
  * @retval      None
  ******************************************************************************/
@@ -17,6 +17,7 @@
 
 #include "main.h"
 #include "stm32f7xx.h"
+#include "fancoil.h"
 
 /*============================================================================*/
 /* JAVNE DEFINICIJE I KONSTANTE                                               */
@@ -58,8 +59,28 @@ typedef struct {
     uint8_t  fan_hiband;
     uint16_t crc;
 } THERMOSTAT_EepromConfig_t;
+
+/**
+ * @brief Postavke regulatora ventilatora i ventila (blok `EE_THERMOSTAT_CTRL`).
+ * @note  Odvojeni blok na kraju EEPROM mape, da se postojeci blokovi ne pomjere.
+ * Parametri se cuvaju posebno za grijanje i hladenje jer je dinamika sobe
+ * razlicita; samopodesavanje prepisuje `kp` i `ti` za mod u kojem je radilo.
+ */
+typedef struct {
+    uint16_t magic_number;
+    uint8_t  algo;              // FANC_ALGO_xxx
+    uint8_t  tuned;             // THST_TUNED_HEATING | THST_TUNED_COOLING
+    FanCoil_Params_t params[2]; // [THST_PARAMS_HEATING], [THST_PARAMS_COOLING]
+    uint16_t crc;
+} THERMOSTAT_CtrlConfig_t;
 #pragma pack(pop)
 
+#define THST_PARAMS_HEATING                         0U
+#define THST_PARAMS_COOLING                         1U
+#define THST_TUNED_HEATING                          (1U << THST_PARAMS_HEATING)
+#define THST_TUNED_COOLING                          (1U << THST_PARAMS_COOLING)
+#define THST_CTRL_DEFAULT_ALGO                      FANC_ALGO_BANDS   // PI/PID/adaptivni samo na zahtjev
+
 
 /*============================================================================*/
 /* OPAQUE TIP PODATAKA                                                        */
@@ -380,6 +401,59 @@ uint8_t Thermostat_GetSetpointDifference(THERMOSTAT_TypeDef* const handle);
  */
 void Thermostat_SetSetpointDifference(THERMOSTAT_TypeDef* const handle, uint8_t value);
 
+// --- Grupa 7: Regulator ventilatora i ventila ---
+
+/**
+ * @brief  Dobija algoritam regulacije.
+ * @param  handle Pointer na instancu termostata.
+ * @retval uint8_t FANC_ALGO_xxx.
+ */
+uint8_t Thermostat_GetControlAlgorithm(THERMOSTAT_TypeDef* const handle);
+
+/**
+ * @brief  Postavlja algoritam regulacije (histerezne trake, PI, PID ili adaptivni PI).
+ * @note   Nepoznata vrijednost se ignorise. Promjena se odmah snima u EEPROM.
+ * @param  handle Pointer na instancu termostata.
+ * @param  algo FANC_ALGO_xxx.
+ * @retval None
+ */
+void Thermostat_SetControlAlgorithm(THERMOSTAT_TypeDef* const handle, uint8_t algo);
+
+/**
+ * @brief  Brise naucene parametre; adaptivni mod ponovo pokrece relejni test.
+ * @param  handle Pointer na instancu termostata.
+ * @retval None
+ */
+void Thermostat_StartAutotune(THERMOSTAT_TypeDef* const handle);
+
+/**
+ * @brief  Dobija parametre regulatora za grijanje ili hladenje.
+ * @param  handle Pointer na instancu termostata.
+ * @param  mode THST_HEATING ili THST_COOLING.
+ * @param  params Odrediste.
+ * @retval bool True ako su parametri nauceni samopodesavanjem.
+ */
+bool Thermostat_GetControlParams(THERMOSTAT_TypeDef* const handle, uint8_t mode, FanCoil_Params_t* params);
+
+/**
+ * @brief  Dobija trenutni zahtjev regulatora.
+ * @param  handle Pointer na instancu termostata.
+ * @retval int16_t Zahtjev u promilima (0..FANC_DEMAND_MAX), 0 za histerezne trake.
+ */
+int16_t Thermostat_GetDemand(THERMOSTAT_TypeDef* const handle);
+
+// --- Grupa 8: Sinhronizacija grupe ---
+
+/**
+ * @brief  Postavlja brzinu ventilatora i stanje ventila koje je objavio master grupe.
+ * @note   Samo za clana grupe (grupa != 0), koji nema lokalnu regulaciju.
+ * @param  handle Pointer na instancu termostata.
+ * @param  fan_speed Brzina ventilatora (0-3).
+ * @param  state Stanje ventila (0/1).
+ * @retval None
+ */
+void Thermostat_SetGroupOutputs(THERMOSTAT_TypeDef* const handle, uint8_t fan_speed, uint8_t state);
+
 /**
  * @brief  setovanje flaga hasInfoChanged
  * @param  handle Pointer na instancu termostata.
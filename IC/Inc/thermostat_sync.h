@@ -0,0 +1,104 @@
+/**
+ ******************************************************************************
+ * @file    thermostat_sync.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Sinhronizacija grupe termostata preko RS485 (`THERMOSTAT_SYNC`).
+ *
+ * @note    Članovi grupe (`Thermostat_GetGroup` != 0) ne prozivaju mastera,
+ * nego svaki uređaj šalje broadcast okvir bez odgovora kada se njegovo
+ * stanje promijeni. Okvir nosi samo promijenjena polja:
+ *
+ *   [0] grupa  [1] redni broj  [2] zastavice i maska polja  [3..] polja
+ *
+ * Polja idu redom bitova maske: izmjerena temperatura (int16, desetinke °C,
+ * big-endian), zadata temperatura, mod, brzina ventilatora, stanje ventila i
+ * granice (sp_min, sp_max, sp_diff). Master šalje sva polja koja su se
+ * promijenila od posljednjeg poslanog stanja, najčešće jednom u
+ * `THST_SYNC_MIN_INTERVAL_MS`; temperatura ulazi u delta okvir tek kada
+ * odstupi `THST_SYNC_TEMP_DEADBAND` ili kada se okvir ionako šalje. Bez
+ * promjena master svakih `THST_SYNC_IDLE_MS` šalje okvir bez polja (samo
+ * redni broj), da slave brzo uoči izgubljen okvir. Svakih
+ * `THST_SYNC_KEYFRAME_MS`, nakon uključenja i nakon `THERMOSTAT_SETUP`
+ * master šalje ključni okvir sa svim poljima. Slave šalje samo korisničke
+ * promjene (zadata temperatura, mod); master ih primjenjuje i objavljuje
+ * kao svoju promjenu, pa se grupa usklađuje preko mastera.
+ *
+ * Redni broj raste za svaki okvir pošiljaoca. Slave koji u nizu mastera
+ * uoči prazninu traži ključni okvir praznim okvirom (maska 0, bez
+ * zastavica), kao što je prazan `THERMOSTAT_INFO` tražio sinhronizaciju, i
+ * ponavlja zahtjev svakih `THST_SYNC_REQUEST_RETRY_MS` dok ga ne dobije.
+ * Listener samo kopira okvir u red; polja se primjenjuju u
+ * `ThstSync_Service`, u glavnoj petlji.
+ ******************************************************************************
+ */
+
+#ifndef __THERMOSTAT_SYNC_H__
+#define __THERMOSTAT_SYNC_H__                   FW_BUILD // verzija
+
+#include "main.h"
+#include "thermostat.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Okvir `THERMOSTAT_SYNC`
+ *  @{
+ */
+#define THST_SYNC_POS_GROUP             0U
+#define THST_SYNC_POS_SEQ               1U
+#define THST_SYNC_POS_FLAGS             2U
+#define THST_SYNC_HEADER_LEN            3U
+#define THST_SYNC_FRAME_MAX             (THST_SYNC_HEADER_LEN + 9U)  ///< Ključni okvir
+
+#define THST_SYNC_F_TEMP                (1U << 0)   ///< Izmjerena temperatura, 2 bajta
+#define THST_SYNC_F_SETPOINT            (1U << 1)   ///< Zadata temperatura, °C
+#define THST_SYNC_F_MODE                (1U << 2)   ///< th_ctrl
+#define THST_SYNC_F_FAN                 (1U << 3)   ///< Brzina ventilatora 0..3
+#define THST_SYNC_F_STATE               (1U << 4)   ///< Ventil (th_state)
+#define THST_SYNC_F_LIMITS              (1U << 5)   ///< sp_min, sp_max, sp_diff, 3 bajta
+#define THST_SYNC_F_MASTER              (1U << 6)   ///< Pošiljalac je master grupe
+#define THST_SYNC_F_KEY                 (1U << 7)   ///< Ključni okvir (sva polja)
+#define THST_SYNC_FIELDS                0x3FU
+/** @} */
+
+/** @name Ograničenje saobraćaja
+ *  @{
+ */
+#define THST_SYNC_MIN_INTERVAL_MS       1000U   ///< Najmanji razmak okvira jednog uređaja
+#define THST_SYNC_IDLE_MS               5000U   ///< Prazan okvir mastera kada nema promjena
+#define THST_SYNC_KEYFRAME_MS           60000U  ///< Period ključnog okvira mastera
+#define THST_SYNC_REQUEST_RETRY_MS      3000U   ///< Ponavljanje zahtjeva slave uređaja bez ključnog okvira
+#define THST_SYNC_TEMP_DEADBAND         5       ///< Desetinke °C za samostalan delta okvir
+#define THST_SYNC_RX_SLOTS              4U      ///< Okvira u redu između listenera i servisa
+/** @} */
+
+/**
+ * @brief Brojači sinhronizacije (dijagnostika i `ic_bus_sim`).
+ */
+typedef struct
+{
+    uint32_t tx_delta;          /**< Poslanih delta okvira. */
+    uint32_t tx_key;            /**< Poslanih ključnih okvira. */
+    uint32_t tx_request;        /**< Poslanih zahtjeva za ključni okvir. */
+    uint32_t rx_frames;         /**< Primljenih okvira vlastite grupe. */
+    uint32_t rx_lost;           /**< Okvira mastera koji nedostaju u nizu. */
+    uint32_t rx_dropped;        /**< Okvira odbačenih zbog punog reda. */
+} ThstSync_Stats_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija i servis ---
+void ThstSync_Init(void);
+void ThstSync_Service(THERMOSTAT_TypeDef* const handle);
+
+// --- Grupa 2: Prijem i zahtjevi ---
+void ThstSync_Receive(const uint8_t* data, uint16_t len);
+void ThstSync_RequestKeyframe(void);
+
+// --- Grupa 3: Dijagnostika ---
+const ThstSync_Stats_t* ThstSync_GetStats(void);
+
+#endif // __THERMOSTAT_SYNC_H__
@@ -4,9 +4,13 @@
  * @author  Gemini & [Vaše Ime]
  * @brief   Javni API za modul "Pametni Alarm".
  *
- * @note    Ovaj modul implementira jedan, centralizovan i autonoman sistemski
- * servis za alarm. Pošto postoji samo jedna instanca tajmera u sistemu
- * (singleton), funkcije u API-ju ne zahtijevaju prosljeđivanje handle-a.
+ * @note    Ovaj modul implementira centralizovan i autonoman sistemski servis
+ * za alarm sa `TIMER_MAX_COUNT` nezavisnih tajmera. Getteri i setteri rade
+ * nad trenutno odabranim tajmerom (`Timer_Select`, podrazumijevano 0), pa
+ * funkcije u API-ju ne zahtijevaju prosljeđivanje handle-a.
+ * Modul ne čita RTC u svakom prolazu: za najbliži okidač svih tajmera
+ * programira RTC Alarm A, a Alarm B svake sekunde osvježava keširano vrijeme
+ * koje ostatak programa čita preko `Timer_GetWallClock`.
  ******************************************************************************
  */
 
@@ -52,6 +56,13 @@ typedef struct
 #define TIMER_WEEKEND   (TIMER_SATURDAY | TIMER_SUNDAY)
 #define TIMER_EVERY_DAY (0x7F)
 
+/**
+ * @brief Broj nezavisnih tajmera.
+ * @note  Tajmer 0 je na adresi `EE_TIMER` (kompatibilno sa ranijim verzijama),
+ * ostali su u bloku `EE_TIMER_EXT`.
+ */
+#define TIMER_MAX_COUNT     4
+
 /*============================================================================*/
 /* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
 /*============================================================================*/
@@ -61,6 +72,11 @@ void Timer_Init(void);
 void Timer_Save(void);
 void Timer_SetDefault(void);
 void Timer_Service(void);
+void Timer_Resync(void);
+void Timer_GetWallClock(RTC_TimeTypeDef* time, RTC_DateTypeDef* date);
+
+void Timer_Select(uint8_t index);
+uint8_t Timer_GetSelected(void);
 
 // --- Grupa 2: Getteri i Setteri za Konfiguraciju ---
 void Timer_SetState(bool isActive);
@@ -0,0 +1,78 @@
+/**
+ ******************************************************************************
+ * @file    timer_wheel.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Javni API hijerarhijskog točka softverskih tajmera.
+ *
+ * @note    Moduli (svjetla, roletne, kapije, ventilator, odmrzivač, scene)
+ * umjesto da u svakom prolazu porede `HAL_GetTick()` sa početkom tajmera za
+ * svaki uređaj, pokreću tajmer u trenutku promjene stanja i dobijaju poziv
+ * funkcije po isteku. Pokretanje i zaustavljanje su O(1), a cijena
+ * `TimerWheel_Service` ne zavisi od broja uređaja. Tajmer je dio strukture
+ * uređaja; nulirana struktura je neaktivan tajmer. API se koristi samo iz
+ * glavne petlje, ne iz prekida.
+ ******************************************************************************
+ */
+
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__                       FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Konfiguracija točka
+ *  @{
+ */
+#define TIMER_WHEEL_MAX_TIMEOUT         0x7FFFFFFFUL    ///< Najduže trajanje tajmera u ms
+/** @} */
+
+/**
+ * @brief Funkcija koja se poziva po isteku tajmera, iz `TimerWheel_Service`.
+ * @note  Smije ponovo pokrenuti ili zaustaviti bilo koji tajmer.
+ */
+typedef void (*TimerWheel_Callback_t)(void* arg);
+
+/**
+ * @brief Veza u dvostruko povezanoj listi jednog slota točka.
+ */
+typedef struct TimerWheel_Link_s
+{
+    struct TimerWheel_Link_s* next;
+    struct TimerWheel_Link_s* prev;
+} TimerWheel_Link_t;
+
+/**
+ * @brief Jedan softverski tajmer.
+ * @note  Polja popunjava `TimerWheel_Start`; `link.next == NULL` znači da
+ * tajmer nije aktivan.
+ */
+typedef struct
+{
+    TimerWheel_Link_t link;         /**< Mora biti prvo polje. */
+    uint32_t expires;               /**< `HAL_GetTick()` isteka. */
+    TimerWheel_Callback_t callback; /**< Poziva se po isteku. */
+    void* arg;                      /**< Argument za `callback` (obično handle uređaja). */
+} TimerWheel_Timer_t;
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija i servis ---
+void TimerWheel_Init(void);
+void TimerWheel_Service(void);
+
+// --- Grupa 2: Upravljanje tajmerima ---
+void TimerWheel_Start(TimerWheel_Timer_t* timer, uint32_t timeout_ms, TimerWheel_Callback_t callback, void* arg);
+void TimerWheel_Stop(TimerWheel_Timer_t* timer);
+void TimerWheel_Relocate(TimerWheel_Timer_t* timer, void* arg);
+bool TimerWheel_IsActive(const TimerWheel_Timer_t* timer);
+uint32_t TimerWheel_Remaining(const TimerWheel_Timer_t* timer);
+
+// --- Grupa 3: Statistika ---
+uint16_t TimerWheel_GetActiveCount(void);
+
+#endif // __TIMER_WHEEL_H__
@@ -0,0 +1,90 @@
+/**
+ ******************************************************************************
+ * @file    trace.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Javni API za praćenje ulaza i izlaza prekida i zadataka planera.
+ *
+ * @note    Uključuje se definicijom `USE_TRACE` (vidi `common.h`). Svaki
+ * `TRACE_ENTER`/`TRACE_EXIT` upisuje DWT vremensku oznaku u kružni bafer u
+ * DTCM RAM-u. Upis ne zabranjuje prekide: mjesto u baferu se rezerviše
+ * LDREX/STREX parom, pa prekid koji upadne usred upisa dobija sljedeće
+ * mjesto. Bez `USE_TRACE` makroi ne generišu kod, a `DIAG_GET` pod-komande
+ * odgovaraju sa NAK. Sadržaj bafera se preuzima preko RS485, a host alat
+ * `ic_trace_decode` od njega pravi vremensku liniju.
+ ******************************************************************************
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__                             FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Konfiguracija
+ *  @{
+ */
+#define TRACE_RING_SIZE                 1024U   ///< Broj zapisa u baferu (stepen broja 2, 8 KB DTCM)
+/** @} */
+
+/** @name DIAG_GET pod-komande (nastavak na `DIAG_SCHED_xxx`)
+ *  @{
+ */
+#define DIAG_TRACE_STATUS               7U      ///< Zamrzava bafer i vraća broj zapisa i takt procesora
+#define DIAG_TRACE_READ                 8U      ///< Zapisi od najstarijeg, stranica po stranica
+#define DIAG_TRACE_RESET                9U      ///< Briše bafer i ponovo pokreće praćenje
+/** @} */
+
+/**
+ * @brief Izvori događaja; zadaci planera su `TRACE_ID_TASK + indeks`.
+ */
+typedef enum
+{
+    TRACE_ID_SYSTICK = 0,
+    TRACE_ID_USART1,
+    TRACE_ID_USART2,
+    TRACE_ID_LTDC,
+    TRACE_ID_DMA2D,
+    TRACE_ID_EXTI_TOUCH,
+    TRACE_ID_QSPI,
+    TRACE_ID_RTC_ALARM,
+    TRACE_ID_ADC_DMA,
+    TRACE_ID_TASK = 32
+} Trace_Id_e;
+
+#define TRACE_KIND_ENTER                0U
+#define TRACE_KIND_EXIT                 1U
+
+/**
+ * @brief Jedan zapis u kružnom baferu.
+ */
+typedef struct
+{
+    uint32_t cycles;            /**< DWT->CYCCNT u trenutku događaja. */
+    uint16_t seq;               /**< Niža 16 bita rednog broja zapisa. */
+    uint8_t  id;                /**< `Trace_Id_e`. */
+    uint8_t  kind;              /**< `TRACE_KIND_ENTER` ili `TRACE_KIND_EXIT`. */
+} Trace_Event_t;
+
+#ifdef USE_TRACE
+#define TRACE_ENTER(id)                 Trace_Record((uint8_t)(id), TRACE_KIND_ENTER)
+#define TRACE_EXIT(id)                  Trace_Record((uint8_t)(id), TRACE_KIND_EXIT)
+#else
+#define TRACE_ENTER(id)                 ((void)0)
+#define TRACE_EXIT(id)                  ((void)0)
+#endif
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija i upis ---
+void Trace_Init(void);
+void Trace_Record(uint8_t id, uint8_t kind);
+
+// --- Grupa 2: Preuzimanje ---
+uint16_t Trace_Serialize(uint8_t subcmd, uint8_t page, uint8_t* buf, uint16_t size);
+
+#endif // __TRACE_H__
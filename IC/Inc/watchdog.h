@@ -0,0 +1,80 @@
+/**
+ ******************************************************************************
+ * @file    watchdog.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Javni API detektora izgladnjivanja IWDG-a i trajnog loga prekoračenja.
+ *
+ * @note    Planer za svaki zadatak ima budžet trajanja (`SCHED_TASK`). Kada
+ * zadatak potroši više od budžeta, ili kada jedan prolaz planera potroši
+ * veliki dio IWDG perioda, prekoračenje se upisuje u RTC backup registre:
+ * koliko puta se desilo i najgori slučaj, po zadatku. Prije svakog zadatka
+ * se u RAM-u pamti koji se zadatak izvršava; kada IWDG predugo nije
+ * osvježen, SysTick ga upisuje u backup registar, pa se nakon IWDG reseta
+ * zna ko ga je izazvao. Backup registri preživljavaju reset,
+ * pa se log čita nakon ponovnog pokretanja preko RS485 (`DIAG_GET`).
+ * Detektor radi i bez `USE_WATCHDOG`, kao rano upozorenje za zadatke koji
+ * su postali sporiji.
+ ******************************************************************************
+ */
+
+#ifndef __WATCHDOG_H__
+#define __WATCHDOG_H__                          FW_BUILD // verzija
+
+#include "main.h"
+
+/*============================================================================*/
+/* JAVNE DEFINICIJE, STRUKTURE I MAKROI                                       */
+/*============================================================================*/
+
+/** @name Konfiguracija IWDG-a (koristi je `MX_IWDG_Init`)
+ *  @{
+ */
+#define WATCHDOG_PRESCALER              IWDG_PRESCALER_256
+#define WATCHDOG_PRESCALER_DIV          256U
+#define WATCHDOG_RELOAD                 4095U
+#define WATCHDOG_LSI_HZ                 32000U  ///< Nominalna frekvencija LSI oscilatora
+#define WATCHDOG_LSI_MAX_HZ             47000U  ///< Najveća frekvencija LSI oscilatora (datasheet)
+/** Nominalni period IWDG-a: 4096 * 256 / 32 kHz = 32768 ms. */
+#define WATCHDOG_TIMEOUT_MS             (((WATCHDOG_RELOAD + 1U) * WATCHDOG_PRESCALER_DIV * 1000U) / WATCHDOG_LSI_HZ)
+/** Najkraći period IWDG-a, uz najbrži LSI: 4096 * 256 / 47 kHz = 22310 ms. */
+#define WATCHDOG_TIMEOUT_MIN_MS         (((WATCHDOG_RELOAD + 1U) * WATCHDOG_PRESCALER_DIV * 1000U) / WATCHDOG_LSI_MAX_HZ)
+/** Prolaz planera duži od ovoga (2788 ms) se upisuje u log kao rano upozorenje. */
+#define WATCHDOG_PASS_WARN_MS           (WATCHDOG_TIMEOUT_MIN_MS / 8U)
+/** @} */
+
+/** @name Oznake u registru tekućeg zadatka (zadatak `i` je `i + 1`)
+ *  @{
+ */
+#define WATCHDOG_MARK_SCHED             0x00U   ///< Planer, između zadataka ili spavanje
+#define WATCHDOG_MARK_INIT              0xFEU   ///< Inicijalizacija prije `Sched_Init`
+#define WATCHDOG_MARK_NONE              0xFFU   ///< Nema zabilježenog IWDG reseta
+/** @} */
+
+#define WATCHDOG_LOG_TASKS              16U     ///< Broj zadataka sa trajnim brojačima
+
+/** @name DIAG_GET pod-komande (nastavak na `DIAG_TRACE_xxx`)
+ *  @{
+ */
+#define DIAG_WDG_LOG                    10U     ///< Trajni log prekoračenja i posljednjeg IWDG reseta
+#define DIAG_WDG_CLEAR                  11U     ///< Brisanje trajnog loga
+/** @} */
+
+/*============================================================================*/
+/* JAVNI API - PROTOTIPOVI FUNKCIJA                                           */
+/*============================================================================*/
+
+// --- Grupa 1: Inicijalizacija ---
+void Watchdog_Init(uint8_t reset_source);
+void Watchdog_Clear(void);
+
+// --- Grupa 2: Tačke mjerenja (poziva planer) ---
+void Watchdog_Mark(uint8_t mark);
+void Watchdog_Kick(void);
+void Watchdog_Tick(void);
+void Watchdog_TaskOverrun(uint8_t index, uint32_t us);
+void Watchdog_PassOverrun(uint32_t ms);
+
+// --- Grupa 3: Preuzimanje ---
+uint16_t Watchdog_Serialize(uint8_t subcmd, uint8_t page, uint8_t* buf, uint16_t size);
+
+#endif // __WATCHDOG_H__
@@ -16,6 +16,7 @@
 #include "GUI_Private.h"
 #include "GUIDRV_Lin.h"
 #include "LCDConf.h"
+#include "profiler.h"
 #include "GUI.h"
 /*********************************************************************
 *
@@ -97,6 +98,12 @@
 // DMA2D Buffer Address
 //
 #define DMA2D_BUFFER_ADDR 	0x20000000
+//
+// Background cache (pre-rendered static screen layers) in spare SDRAM
+// between the frame buffers (0xC0000000 - ~0xC023DC00) and the GUI heap (0xC0600000)
+//
+#define BKG_CACHE_ADDR 		0xC0280000
+#define BKG_CACHE_SLOT_SIZE 0x00080000	// 512kB, one full 480x272 ARGB8888 frame
 
 /*********************************************************************
 *
@@ -422,7 +429,17 @@ static const U32 _aAddr[GUI_NUM_LAYERS] = {
 };
 
 static int _aPendingBuffer[2] = { -1, -1};
+static U32 _aPendingVsync[GUI_NUM_LAYERS];		// Vsync count when rendering of the pending buffer started
+static volatile U32 _VsyncCount;				// Incremented once per frame in the line event callback
+static U32 _FrameStartVsync;					// Vsync count at the start of the current render pass
+static volatile int _PacerDeferred;				// Deferred render already counted for the current pending swap
+static volatile int _PacerServiceDeferred;		// Deferred screen service already counted for the current pending swap
+static volatile int _PacerInputNew;				// Touch input stored since the last LCD_Pacer_TakeInput()
+static volatile int _PacerInputArmed;			// Touch input waiting for the first frame shown after it
+static volatile U32 _PacerInputTick;			// HAL_GetTick() of the oldest unanswered touch input
+static LCD_PacerStatsTypedef _PacerStats;
 static int _aBufferIndex[GUI_NUM_LAYERS];
+static int _aCacheLayer[LCD_BKG_CACHE_SLOTS];	// Layer whose buffer is stored in cache slot, -1 if slot is empty
 static int _axSize[GUI_NUM_LAYERS];
 static int _aySize[GUI_NUM_LAYERS];
 static int _aBytesPerPixels[GUI_NUM_LAYERS];
@@ -510,11 +527,14 @@ static U32 _GetPixelformat(int LayerIndex)
 */
 static void _DMA_ExecOperation(void)
 {
+    U32 Start = Profiler_Cycles();
+
     DMA2D->CR |= DMA2D_CR_START;					// Control Register (Start operation)
     while (DMA2D->CR & DMA2D_CR_START) 				// Wait until transfer is done
     {
         __WFI();									// Sleep until next interrupt
     }
+    Profiler_Dma2dAdd(Profiler_Cycles() - Start);
 }
 /*********************************************************************
 *
@@ -1240,9 +1260,27 @@ void HAL_LTDC_LineEvenCallback(LTDC_HandleTypeDef *hltdc)
             __HAL_LTDC_RELOAD_CONFIG(hltdc);					// Reload configuration
             GUI_MULTIBUF_ConfirmEx(i, _aPendingBuffer[i]);		// Tell emWin that buffer is used
             _aPendingBuffer[i] = -1;							// Clear pending buffer flag of layer
+            _PacerStats.shown++;
+            if ((_VsyncCount - _aPendingVsync[i]) > 1)			// Render plus wait took more than one refresh period
+            {
+                _PacerStats.late++;
+            }
+            if (_PacerInputArmed)								// First frame on glass after a touch
+            {
+                _PacerInputArmed = 0;
+                _PacerStats.input_latency_last = HAL_GetTick() - _PacerInputTick;
+                if (_PacerStats.input_latency_last > _PacerStats.input_latency_max)
+                {
+                    _PacerStats.input_latency_max = _PacerStats.input_latency_last;
+                }
+            }
+            _PacerDeferred = 0;
+            _PacerServiceDeferred = 0;
         }
     }
 
+    _VsyncCount++;
+    _PacerStats.vsync = _VsyncCount;
     HAL_LTDC_ProgramLineEvent(hltdc, 0);
 }
 
@@ -1482,6 +1520,11 @@ int LCD_X_DisplayDriver(unsigned LayerIndex, unsigned Cmd, void * p)
     {
         LCD_X_SHOWBUFFER_INFO * pShowBuffInfo;
         pShowBuffInfo = (LCD_X_SHOWBUFFER_INFO *)p;
+        if (_aPendingBuffer[LayerIndex] >= 0)					// Previous frame is replaced before it was ever shown
+        {
+            _PacerStats.skipped++;
+        }
+        _aPendingVsync[LayerIndex] = _FrameStartVsync;
         _aPendingBuffer[LayerIndex] = pShowBuffInfo->Index;
         break;
     }
@@ -1663,6 +1706,11 @@ void LCD_X_Config(void)
     LCD_SetVisEx(1, 1); // Layer 1 On
 #endif
 
+    for (i = 0; i < LCD_BKG_CACHE_SLOTS; i++)												// All background cache slots are empty after init
+    {
+        _aCacheLayer[i] = -1;
+    }
+
     for (i = 0; i < GUI_NUM_LAYERS; i++)													// Setting up VRam address and remember pixel size
     {
         LCD_SetVRAMAddrEx(i, (void *)(_aAddr[i]));								// Setting up VRam address
@@ -1697,11 +1745,219 @@ void LCD_X_Config(void)
 #endif
 }
 
+/*********************************************************************
+*
+*       LCD_BkgCache_Store
+*
+* Purpose:
+*   Copies the current drawing buffer of the given layer into a background
+*   cache slot in SDRAM using one DMA2D transfer. Called after the static
+*   part of a screen has been drawn, before any dynamic content.
+*
+* Return Value:
+*   0 - Ok, 1 - Invalid slot or layer
+*/
+int LCD_BkgCache_Store(int LayerIndex, int Slot)
+{
+    U32 BufferSize, AddrSrc, AddrDst;
 
+    if ((Slot < 0) || (Slot >= LCD_BKG_CACHE_SLOTS) || (LayerIndex < 0) || (LayerIndex >= GUI_NUM_LAYERS))
+    {
+        return 1;
+    }
 
+    BufferSize = _GetBufferSize(LayerIndex);
 
+    if (BufferSize > BKG_CACHE_SLOT_SIZE)
+    {
+        return 1;
+    }
 
+    AddrSrc = _aAddr[LayerIndex] + BufferSize * _aBufferIndex[LayerIndex];
+    AddrDst = BKG_CACHE_ADDR + BKG_CACHE_SLOT_SIZE * Slot;
+    _DMA_Copy(LayerIndex, (void *)AddrSrc, (void *)AddrDst, _axSize[LayerIndex], _aySize[LayerIndex], 0, 0);
+    _aCacheLayer[Slot] = LayerIndex;
+    return 0;
+}
 
+/*********************************************************************
+*
+*       LCD_BkgCache_Restore
+*
+* Purpose:
+*   Copies a previously stored background cache slot into the current
+*   drawing buffer of the given layer using one DMA2D transfer. Must be
+*   called inside GUI_MULTIBUF_BeginEx()/GUI_MULTIBUF_EndEx() of that
+*   layer so the blit goes to the back buffer.
+*
+* Return Value:
+*   0 - Ok, 1 - Slot is empty or was stored from another layer
+*/
+int LCD_BkgCache_Restore(int LayerIndex, int Slot)
+{
+    U32 BufferSize, AddrSrc, AddrDst;
 
+    if ((Slot < 0) || (Slot >= LCD_BKG_CACHE_SLOTS) || (_aCacheLayer[Slot] != LayerIndex))
+    {
+        return 1;
+    }
+
+    BufferSize = _GetBufferSize(LayerIndex);
+    AddrSrc = BKG_CACHE_ADDR + BKG_CACHE_SLOT_SIZE * Slot;
+    AddrDst = _aAddr[LayerIndex] + BufferSize * _aBufferIndex[LayerIndex];
+    _DMA_Copy(LayerIndex, (void *)AddrSrc, (void *)AddrDst, _axSize[LayerIndex], _aySize[LayerIndex], 0, 0);
+    return 0;
+}
+
+/*********************************************************************
+*
+*       LCD_BkgCache_Invalidate
+*
+* Purpose:
+*   Marks one cache slot as empty, or all slots if Slot is negative.
+*/
+void LCD_BkgCache_Invalidate(int Slot)
+{
+    int i;
+
+    for (i = 0; i < LCD_BKG_CACHE_SLOTS; i++)
+    {
+        if ((Slot < 0) || (Slot == i))
+        {
+            _aCacheLayer[i] = -1;
+        }
+    }
+}
+
+/*********************************************************************
+*
+*       LCD_Pacer_IsSwapPending
+*
+* Purpose:
+*   Returns 1 while a finished frame of any layer still waits for the
+*   next vertical sync. A frame rendered now would only replace it in
+*   the queue, so the caller should not start a new one.
+*/
+int LCD_Pacer_IsSwapPending(void)
+{
+    int i;
+
+    for (i = 0; i < GUI_NUM_LAYERS; i++)
+    {
+        if (_aPendingBuffer[i] >= 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*********************************************************************
+*
+*       LCD_Pacer_FrameBegin
+*
+* Purpose:
+*   Marks the start of a render pass. A frame queued during this pass
+*   counts as late if it reaches the display more than one refresh
+*   period after this point.
+*/
+void LCD_Pacer_FrameBegin(void)
+{
+    _FrameStartVsync = _VsyncCount;
+}
+
+/*********************************************************************
+*
+*       LCD_Pacer_Defer
+*
+* Purpose:
+*   Records that a due render was postponed because of a pending swap.
+*   Counted once per pending frame, no matter how often it is called.
+*/
+void LCD_Pacer_Defer(void)
+{
+    if (!_PacerDeferred)
+    {
+        _PacerDeferred = 1;
+        _PacerStats.deferred++;
+    }
+}
+
+/*********************************************************************
+*
+*       LCD_Pacer_DeferService
+*
+* Purpose:
+*   Records that the screen service pass was skipped because of a
+*   pending swap. The screen services draw directly between
+*   GUI_MULTIBUF_BeginEx() and GUI_MULTIBUF_EndEx(), so they would queue
+*   a frame behind the pending one. Counted once per pending frame.
+*/
+void LCD_Pacer_DeferService(void)
+{
+    if (!_PacerServiceDeferred)
+    {
+        _PacerServiceDeferred = 1;
+        _PacerStats.service_deferred++;
+    }
+}
+
+/*********************************************************************
+*
+*       LCD_Pacer_MarkInput
+*
+* Purpose:
+*   Called after a new touch state has been passed to emWin. Requests a
+*   render and starts the touch-to-display latency measurement, which
+*   ends with the next frame made visible.
+*/
+void LCD_Pacer_MarkInput(void)
+{
+    _PacerInputNew = 1;
+    if (!_PacerInputArmed)
+    {
+        _PacerInputTick = HAL_GetTick();
+        _PacerInputArmed = 1;
+    }
+}
+
+/*********************************************************************
+*
+*       LCD_Pacer_TakeInput
+*
+* Purpose:
+*   Returns 1 once for every batch of touch input since the last call.
+*/
+int LCD_Pacer_TakeInput(void)
+{
+    if (!_PacerInputNew)
+    {
+        return 0;
+    }
+    _PacerInputNew = 0;
+    return 1;
+}
+
+/*********************************************************************
+*
+*       LCD_Pacer_GetStats / LCD_Pacer_ResetStats
+*
+* Purpose:
+*   Snapshot and reset of the frame pacing counters.
+*/
+void LCD_Pacer_GetStats(LCD_PacerStatsTypedef *pStats)
+{
+    __disable_irq();
+    *pStats = _PacerStats;
+    __enable_irq();
+}
+
+void LCD_Pacer_ResetStats(void)
+{
+    __disable_irq();
+    memset(&_PacerStats, 0, sizeof(_PacerStats));
+    _PacerStats.vsync = _VsyncCount;
+    __enable_irq();
+}
 
 /************************ (C) COPYRIGHT JUBERA D.O.O Sarajevo ************************/
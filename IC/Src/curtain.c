@@ -21,6 +21,8 @@
 #include "display.h"
 #include "stm32746g_eeprom.h"
 #include "rs485.h"
+#include "timer_wheel.h"
+#include "devreg.h"
 
 /**
  * @brief Puna definicija glavne "runtime" strukture za jednu roletnu.
@@ -30,7 +32,7 @@ struct Curtain_s
     Curtain_EepromConfig_t config;  /**< Konfiguracioni podaci koji se cuvaju. */
     uint8_t  upDown;                /**< Trenutno eljeno stanje (STOP, UP, DOWN). */
     uint8_t  upDown_old;            /**< Prethodno stanje (za detekciju promjene). */
-    uint32_t upDownTimer;           /**< Vrijeme starta tajmera za kretanje. */
+    TimerWheel_Timer_t upDownTimer; /**< Tajmer za automatsko zaustavljanje kretanja. */
     bool     external_cmd;          /**< Fleg koji ukazuje da je komanda dola sa busa. */
 };
 
@@ -42,9 +44,10 @@ static Curtains_EepromData_t curtains_eeprom_data;
 
 /**
  * @brief Niz sa runtime podacima za sve roletne. Sakriven od ostatka programa.
- * @note  `static` - vidljiv samo u ovom fajlu.
+ * @note  `static` - vidljiv samo u ovom fajlu. Niz je u SDRAM-u
+ * (`.sdram_ram`, `UNINIT`), pa ga `Curtains_Init` prvo brise.
  */
-static struct Curtain_s curtains[CURTAINS_SIZE];
+static struct Curtain_s curtains[CURTAINS_SIZE] __attribute__((section(".sdram_ram")));
 
 /**
  * @brief Brojac stvarno konfigurisanih roletni.
@@ -52,10 +55,11 @@ static struct Curtain_s curtains[CURTAINS_SIZE];
  */
 static uint8_t curtains_count = 0;
 
-static void HandleCurtainMovement(Curtain_Handle* const handle);
+static void CurtainMoveExpired(void* arg);
 static void HandleCurtainDirectionChange(Curtain_Handle* const handle);
 static void Curtains_CountConfigured(void);
-static Curtain_Handle* FindCurtainByRelay(uint16_t relay);
+static void Curtain_ExternalEvent(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len);
+static void Curtains_Subscribe(void);
 
 /*============================================================================*/
 /* IMPLEMENTACIJA JAVNOG API-JA                                               */
@@ -65,6 +69,7 @@ static Curtain_Handle* FindCurtainByRelay(uint16_t relay);
 
 void Curtains_Init(void)
 {
+    memset(curtains, 0, sizeof(curtains));
     EE_ReadBuffer((uint8_t*)&curtains_eeprom_data, EE_CURTAINS, sizeof(Curtains_EepromData_t));
 
     if (curtains_eeprom_data.magic_number != EEPROM_MAGIC_NUMBER) {
@@ -85,11 +90,12 @@ void Curtains_Init(void)
         curtains[i].config = curtains_eeprom_data.curtains[i];
         curtains[i].upDown = CURTAIN_STOP;
         curtains[i].upDown_old = CURTAIN_STOP;
-        curtains[i].upDownTimer = 0;
+        TimerWheel_Stop(&curtains[i].upDownTimer);
         curtains[i].external_cmd = false;
     }
 
     Curtains_CountConfigured();
+    DevReg_Register(Curtains_Subscribe);
 }
 
 void Curtain_Service(void)
@@ -99,8 +105,6 @@ void Curtain_Service(void)
         Curtain_Handle* handle = &curtains[i];
         if(!Curtain_hasRelays(handle)) continue;
 
-        HandleCurtainMovement(handle);
-
         if (!handle->external_cmd) {
             HandleCurtainDirectionChange(handle);
         }
@@ -138,12 +142,14 @@ uint8_t Curtain_GetMoveTime(void) {
 
 void Curtain_setRelayUp(Curtain_Handle* const handle, uint16_t relay) {
     if(handle) handle->config.relayUp.tf = relay;
+    DevReg_Rebuild();
 }
 uint16_t Curtain_getRelayUp(const Curtain_Handle* const handle) {
     return handle ? handle->config.relayUp.tf : 0;
 }
 void Curtain_setRelayDown(Curtain_Handle* const handle, uint16_t relay) {
     if(handle) handle->config.relayDown.tf = relay;
+    DevReg_Rebuild();
 }
 uint16_t Curtain_getRelayDown(const Curtain_Handle* const handle) {
     return handle ? handle->config.relayDown.tf : 0;
@@ -214,8 +220,7 @@ void Curtain_Move(Curtain_Handle* const handle, const uint8_t direction)
     {
         handle->external_cmd = false;
         handle->upDown = direction;
-        handle->upDownTimer = HAL_GetTick();
-        if(!handle->upDownTimer) handle->upDownTimer = 1;
+        TimerWheel_Start(&handle->upDownTimer, Curtain_GetMoveTime() * 1000UL, CurtainMoveExpired, handle);
     }
 }
 
@@ -264,18 +269,6 @@ void Curtain_HandleTouchLogic(const uint8_t direction)
     }
 }
 
-void Curtain_Update_External(uint16_t relay, uint8_t state)
-{
-    Curtain_Handle* handle = FindCurtainByRelay(relay);
-    if(handle)
-    {
-        handle->upDown_old = state;
-        handle->upDown = state;
-        handle->upDownTimer = HAL_GetTick() ? HAL_GetTick() : 1;
-        handle->external_cmd = true;
-    }
-}
-
 // --- Grupa 6: Provjera Stanja ---
 
 bool Curtain_hasRelays(const Curtain_Handle* const handle) {
@@ -338,21 +331,33 @@ uint8_t Curtain_getNewDirection(const Curtain_Handle* const handle)
 /*============================================================================*/
 
 /**
- * @brief Pronalazi roletnu na osnovu Modbus adrese jednog od njenih releja.
- * @param relay Adresa releja.
- * @retval Curtain_Handle* Pointer na pronadenu roletnu, ili `NULL`.
+ * @brief Aurira stanje roletne na osnovu `JALOUSIE_SET` sa busa.
+ * @note  `DevReg_Handler_t`; registar poziva roletnu ciji je relej gore ili
+ * dolje na adresi iz okvira. `data[0]` je novo stanje (`CURTAIN_UP`,
+ * `CURTAIN_DOWN`, `CURTAIN_STOP`).
+ */
+static void Curtain_ExternalEvent(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len)
+{
+    if ((index >= CURTAINS_SIZE) || (len == 0)) return;
+    Curtain_Handle* handle = &curtains[index];
+    handle->upDown_old = data[0];
+    handle->upDown = data[0];
+    TimerWheel_Start(&handle->upDownTimer, Curtain_GetMoveTime() * 1000UL, CurtainMoveExpired, handle);
+    handle->external_cmd = true;
+}
+
+/**
+ * @brief Prijavljuje releje gore i dolje svih roletni u registar uredaja.
+ * @note  `DevReg_Builder_t`. Roletna sa istim relejem za oba smjera se
+ * upisuje jednom.
  */
-static Curtain_Handle* FindCurtainByRelay(uint16_t relay)
+static void Curtains_Subscribe(void)
 {
-    if (relay == 0) return NULL;
     for (uint8_t i = 0; i < CURTAINS_SIZE; i++)
     {
-        if ((curtains[i].config.relayUp.tf == relay) || (curtains[i].config.relayDown.tf == relay))
-        {
-            return &curtains[i];
-        }
+        DevReg_Subscribe(JALOUSIE_SET, curtains[i].config.relayUp.tf, Curtain_ExternalEvent, i);
+        DevReg_Subscribe(JALOUSIE_SET, curtains[i].config.relayDown.tf, Curtain_ExternalEvent, i);
     }
-    return NULL;
 }
 
 
@@ -372,15 +377,13 @@ static void Curtains_CountConfigured(void)
 
 
 /**
- * @brief Upravlja tajmerom za automatsko zaustavljanje roletne.
- * @param handle Pointer na instancu roletne.
+ * @brief Istek tajmera kretanja: automatsko zaustavljanje roletne.
+ * @note  Poziva ga `TimerWheel_Service()`; komandu salje `Curtain_Service`.
+ * @param arg Pointer na instancu roletne.
  */
-static void HandleCurtainMovement(Curtain_Handle* const handle)
+static void CurtainMoveExpired(void* arg)
 {
-    if (handle->upDownTimer != 0 && (HAL_GetTick() - handle->upDownTimer) >= (Curtain_GetMoveTime() * 1000))
-    {
-        Curtain_Stop(handle);
-    }
+    Curtain_Stop((Curtain_Handle*)arg);
 }
 
 /**
@@ -427,7 +430,7 @@ static void HandleCurtainDirectionChange(Curtain_Handle* const handle)
         // Auriranje internog stanja
         if(handle->upDown == CURTAIN_STOP) {
             handle->upDown_old = CURTAIN_STOP;
-            handle->upDownTimer = 0;
+            TimerWheel_Stop(&handle->upDownTimer);
             handle->external_cmd = false;
         } else {
             handle->upDown_old = handle->upDown;
@@ -7,8 +7,9 @@
  * @note
  * Ovaj fajl sadri privatnu, staticku `defroster` instancu, cineci je
  * nevidljivom za ostatak programa. Sva interakcija sa podacima se vri
- * preko `handle`-a koji se prosljeduje funkcijama. `Defroster_Service()`
- * periodicno poziva pomocne `Handle...` funkcije za obradu tajmera.
+ * preko `handle`-a koji se prosljeduje funkcijama. Ciklus i aktivno vrijeme
+ * su tajmeri u `timer_wheel` modulu; po isteku `TimerWheel_Service()` poziva
+ * pomocne `...Expired` funkcije.
  ******************************************************************************
  */
 
@@ -23,6 +24,7 @@
 #include "defroster.h"
 #include "display.h"
 #include "stm32746g_eeprom.h"
+#include "timer_wheel.h"
 
 /*============================================================================*/
 /* PRIVATNA DEFINICIJA STRUKTURE                                              */
@@ -38,8 +40,9 @@ struct Defroster_s
     Defroster_EepromConfig_t config;
 
     // Runtime varijable koje se ne cuvaju
-    uint32_t cycleTime_TimerStart;
-    uint32_t activeTime_TimerStart;
+    bool running;                       // Pokrenut sa `Defroster_On`
+    TimerWheel_Timer_t cycle_timer;     // Period ciklusa
+    TimerWheel_Timer_t active_timer;    // Aktivno vrijeme unutar ciklusa
 };
 
 /*============================================================================*/
@@ -56,8 +59,8 @@ static struct Defroster_s defroster;
 /*============================================================================*/
 /* PROTOTIPOVI PRIVATNIH POMOCNIH FUNKCIJA                                    */
 /*============================================================================*/
-static void HandleDefrosterCycle(Defroster_Handle* const handle);
-static void HandleDefrosterActiveTime(Defroster_Handle* const handle);
+static void DefrosterCycleExpired(void* arg);
+static void DefrosterActiveTimeExpired(void* arg);
 
 /*============================================================================*/
 /* IMPLEMENTACIJA JAVNOG API-JA                                               */
@@ -85,8 +88,9 @@ void Defroster_Init(Defroster_Handle* const handle)
         }
     }
     // Runtime varijable se uvijek resetuju na pocetku
-    handle->cycleTime_TimerStart = 0;
-    handle->activeTime_TimerStart = 0;
+    handle->running = false;
+    TimerWheel_Stop(&handle->cycle_timer);
+    TimerWheel_Stop(&handle->active_timer);
 }
 
 void Defroster_Save(Defroster_Handle* const handle)
@@ -99,7 +103,9 @@ void Defroster_Save(Defroster_Handle* const handle)
 
 void Defroster_SetDefault(Defroster_Handle* const handle)
 {
-    // Sigurnosno nuliranje cijele strukture
+    // Sigurnosno nuliranje cijele strukture (aktivni tajmeri se prvo skidaju iz tocka)
+    TimerWheel_Stop(&handle->cycle_timer);
+    TimerWheel_Stop(&handle->active_timer);
     memset(handle, 0, sizeof(struct Defroster_s));
     // Vrijednosti su vec 0, ali ih eksplicitno postavljamo radi citljivosti
     handle->config.cycleTime = 0;
@@ -107,34 +113,23 @@ void Defroster_SetDefault(Defroster_Handle* const handle)
     handle->config.pin = 0;
 }
 
-void Defroster_Service(Defroster_Handle* const handle)
-{
-    // Servis radi samo ako je u postavkama displeja odabran mod za odmrzivac
-    if (g_display_settings.selected_control_mode != MODE_DEFROSTER) {
-        return;
-    }
-
-    // I samo ako je odmrzivac globalno aktivan (ima pokrenut ciklicni tajmer)
-    if(Defroster_isActive(handle))
-    {
-        HandleDefrosterCycle(handle);
-        HandleDefrosterActiveTime(handle);
-    }
-}
-
 bool Defroster_isActive(const Defroster_Handle* const handle)
 {
-    // Odmrzivac se smatra aktivnim ako mu je pokrenut ciklicni tajmer.
-    return (handle->cycleTime_TimerStart != 0);
+    // Odmrzivac se smatra aktivnim od `Defroster_On` do `Defroster_Off`.
+    return handle->running;
 }
 
 void Defroster_On(Defroster_Handle* const handle)
 {
     if (handle->config.pin == 0) return; // Ne radi nita ako pin nije konfigurisan
 
-    uint32_t tick = HAL_GetTick();
-    handle->cycleTime_TimerStart = tick ? tick : 1;
-    handle->activeTime_TimerStart = tick ? tick : 1;
+    handle->running = true;
+    if (handle->config.cycleTime != 0) {
+        TimerWheel_Start(&handle->cycle_timer, handle->config.cycleTime * 60000UL, DefrosterCycleExpired, handle); // Minute u ms
+    }
+    if (handle->config.activeTime != 0) {
+        TimerWheel_Start(&handle->active_timer, handle->config.activeTime * 60000UL, DefrosterActiveTimeExpired, handle);
+    }
     SetPin(handle->config.pin, 1); // Postavlja pin na HIGH
 }
 
@@ -142,8 +137,9 @@ void Defroster_Off(Defroster_Handle* const handle)
 {
     if (handle->config.pin == 0) return;
 
-    handle->cycleTime_TimerStart = 0;
-    handle->activeTime_TimerStart = 0;
+    handle->running = false;
+    TimerWheel_Stop(&handle->cycle_timer);
+    TimerWheel_Stop(&handle->active_timer);
     SetPin(handle->config.pin, 0); // Postavlja pin na LOW
 }
 
@@ -195,43 +191,36 @@ uint8_t Defroster_getPin(const Defroster_Handle* const handle)
 /*============================================================================*/
 
 /**
- * @brief Upravlja ciklusom rada odmrzivaca.
- * @note  Ako je ciklicni tajmer istekao, ponovo ga pokrece, pokrece i tajmer
- * aktivnog vremena i ukljucuje grijac (podie pin na HIGH).
- * @param handle Pointer na instancu modula.
+ * @brief Istek ciklicnog tajmera.
+ * @note  Ciklus se uvijek ponovo pokrece. Ako je u postavkama displeja
+ * odabran mod za odmrzivac, pokrece se i tajmer aktivnog vremena i
+ * ukljucuje grijac (podie pin na HIGH); inace se ovaj ciklus preskace.
+ * @param arg Pointer na instancu modula.
  */
-static void HandleDefrosterCycle(Defroster_Handle* const handle)
+static void DefrosterCycleExpired(void* arg)
 {
-    // Ako ciklus nije podeen (vrijednost 0), ne radi nita.
-    if (handle->config.cycleTime == 0) return;
+    Defroster_Handle* const handle = (Defroster_Handle*)arg;
 
-    const uint32_t tick = HAL_GetTick();
-    if((tick - handle->cycleTime_TimerStart) >= (handle->config.cycleTime * 60000UL)) // Minute u ms
-    {
-        handle->cycleTime_TimerStart = tick ? tick : 1;
-        handle->activeTime_TimerStart = tick ? tick : 1;
-        SetPin(handle->config.pin, 1);
+    TimerWheel_Start(&handle->cycle_timer, handle->config.cycleTime * 60000UL, DefrosterCycleExpired, handle); // Minute u ms
+
+    if (g_display_settings.selected_control_mode != MODE_DEFROSTER) return;
+
+    if (handle->config.activeTime != 0) {
+        TimerWheel_Start(&handle->active_timer, handle->config.activeTime * 60000UL, DefrosterActiveTimeExpired, handle);
     }
+    SetPin(handle->config.pin, 1);
 }
 
 /**
- * @brief Upravlja aktivnim vremenom odmrzivaca.
- * @note  Ako je tajmer za aktivno vrijeme istekao, zaustavlja tajmer i
- * iskljucuje grijac (sputa pin na LOW).
- * @param handle Pointer na instancu modula.
+ * @brief Istek tajmera aktivnog vremena.
+ * @note  Iskljucuje grijac (sputa pin na LOW) ako je odabran mod za odmrzivac.
+ * @param arg Pointer na instancu modula.
  */
-static void HandleDefrosterActiveTime(Defroster_Handle* const handle)
+static void DefrosterActiveTimeExpired(void* arg)
 {
-    // Ako aktivno vrijeme nije podeeno (vrijednost 0), ne radi nita.
-    if (handle->config.activeTime == 0) return;
+    Defroster_Handle* const handle = (Defroster_Handle*)arg;
 
-    // Ako tajmer nije ni pokrenut, ne radi nita.
-    if (handle->activeTime_TimerStart == 0) return;
+    if (g_display_settings.selected_control_mode != MODE_DEFROSTER) return;
 
-    const uint32_t tick = HAL_GetTick();
-    if((tick - handle->activeTime_TimerStart) >= (handle->config.activeTime * 60000UL)) // Minute u ms
-    {
-        handle->activeTime_TimerStart = 0; // Zaustavi tajmer
-        SetPin(handle->config.pin, 0);
-    }
+    SetPin(handle->config.pin, 0);
 }
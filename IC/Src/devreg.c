@@ -0,0 +1,254 @@
+/**
+ ******************************************************************************
+ * @file    devreg.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija registra uređaja i rutiranja bus događaja.
+ *
+ * @note    Ključ je `DEVREG_KEY_USED | (tip << 16) | adresa`, pa je nula
+ * prazan slot (adresa 0 se ne upisuje). Početni slot daje multiplikativni
+ * heš (Knuth), a sudari se rješavaju linearnim probanjem. Slot pokazuje na
+ * prvu pretplatu ključa u bazenu pretplata, a pretplate istog ključa su
+ * povezane indeksom `next`. Broj ključeva je najviše polovina broja
+ * slotova, pa je i najgori niz probanja kratak. Brisanje pojedinačne
+ * pretplate ne postoji; promjena konfiguracije gradi cijelu tabelu, što je
+ * u glavnoj petlji reda mikrosekundi. Modul ne koristi HAL i prevodi se i
+ * u host build.
+ ******************************************************************************
+ */
+
+#if (__DEVREG_H__ != FW_BUILD)
+#error "devreg header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "devreg.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define DEVREG_KEY_USED                 0x80000000UL
+#define DEVREG_KEY(type, addr)          (DEVREG_KEY_USED | ((uint32_t)(type) << 16) | (uint32_t)(addr))
+#define DEVREG_HASH(key)                ((uint32_t)((key) * 2654435761U) >> (32U - DEVREG_SLOTS_LOG2))
+#define DEVREG_MASK                     (DEVREG_SLOTS - 1U)
+#define DEVREG_END                      0xFFU   ///< Kraj liste pretplata
+
+#if (DEVREG_MAX_ROUTES > (DEVREG_SLOTS / 2U)) || (DEVREG_MAX_ROUTES > DEVREG_END)
+#error "DEVREG_MAX_ROUTES mora biti najviše polovina DEVREG_SLOTS i manji od 255"
+#endif
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+/**
+ * @brief Jedan slot heš tabele.
+ */
+typedef struct
+{
+    uint32_t key;               /**< `DEVREG_KEY`, 0 = prazan slot. */
+    uint8_t  head;              /**< Prva pretplata ključa u `route`. */
+} DevReg_Slot_t;
+
+/**
+ * @brief Jedna pretplata.
+ */
+typedef struct
+{
+    DevReg_Handler_t handler;
+    uint16_t index;             /**< Indeks uređaja u nizu modula. */
+    uint8_t  next;              /**< Sljedeća pretplata istog ključa ili `DEVREG_END`. */
+} DevReg_Route_t;
+
+/**
+ * @brief Jedna od dvije tabele (aktivna i ona koja se gradi).
+ */
+typedef struct
+{
+    DevReg_Slot_t  slot[DEVREG_SLOTS];
+    DevReg_Route_t route[DEVREG_MAX_ROUTES];
+    uint16_t keys;
+    uint16_t routes;
+    uint16_t max_probe;
+} DevReg_Table_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static DevReg_Table_t devreg_table[2] __attribute__((section(".sdram_ram")));
+static DevReg_Table_t* volatile active;     ///< Čita `DevReg_Dispatch`, i iz prekida
+static DevReg_Table_t* building;            ///< Tabela koju puni `DevReg_Subscribe`, NULL van izgradnje
+static DevReg_Builder_t builders[DEVREG_MAX_BUILDERS];
+static uint8_t builders_count;
+static DevReg_Stats_t stats;
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Briše obje tabele i prijave modula.
+ * @note  Poziva se iz `main()` nakon `SDRAM_Init`, prije inicijalizacije
+ * modula uređaja.
+ */
+void DevReg_Init(void)
+{
+    memset(devreg_table, 0, sizeof(devreg_table));
+    memset(builders, 0, sizeof(builders));
+    memset(&stats, 0, sizeof(stats));
+    builders_count = 0;
+    building = NULL;
+    active = &devreg_table[0];
+}
+
+/**
+ * @brief Prijavljuje funkciju koja upisuje pretplate jednog modula i gradi tabelu.
+ * @param builder Funkcija modula; ponovna prijava iste funkcije samo gradi tabelu.
+ */
+void DevReg_Register(DevReg_Builder_t builder)
+{
+    if (builder == NULL) return;
+
+    bool known = false;
+    for (uint8_t i = 0; i < builders_count; i++)
+    {
+        if (builders[i] == builder) known = true;
+    }
+    if (!known && (builders_count < DEVREG_MAX_BUILDERS)) builders[builders_count++] = builder;
+    DevReg_Rebuild();
+}
+
+/**
+ * @brief Gradi tabelu iz trenutne konfiguracije svih prijavljenih modula.
+ * @note  Tabela se puni u neaktivnom baferu i aktivira jednim upisom
+ * pokazivača, pa `DevReg_Dispatch` iz prekida uvijek vidi cijelu tabelu.
+ * Poziva se samo iz glavne petlje.
+ */
+void DevReg_Rebuild(void)
+{
+    DevReg_Table_t* t = (active == &devreg_table[0]) ? &devreg_table[1] : &devreg_table[0];
+
+    memset(t, 0, sizeof(DevReg_Table_t));
+    stats.overflow = 0;
+    building = t;
+    for (uint8_t i = 0; i < builders_count; i++)
+    {
+        builders[i]();
+    }
+    building = NULL;
+
+    active = t;
+    stats.keys = t->keys;
+    stats.routes = t->routes;
+    stats.max_probe = t->max_probe;
+    stats.rebuilds++;
+}
+
+/**
+ * @brief Upisuje pretplatu u tabelu koja se gradi.
+ * @note  Smije se pozvati samo iz `DevReg_Builder_t` funkcije. Ista funkcija
+ * sa istim indeksom se za jedan ključ upisuje samo jednom (npr. roletna sa
+ * istim relejom za gore i dolje).
+ * @param type    Tip TinyFrame poruke (`LuxNET.h`).
+ * @param address TF adresa (0 se preskače).
+ * @param handler Funkcija koju `DevReg_Dispatch` poziva.
+ * @param index   Indeks uređaja u nizu modula.
+ * @retval bool   `false` ako pretplata nije upisana (duplikat, puna tabela ili
+ *                poziv van izgradnje).
+ */
+bool DevReg_Subscribe(uint8_t type, uint16_t address, DevReg_Handler_t handler, uint16_t index)
+{
+    DevReg_Table_t* t = building;
+    if ((t == NULL) || (address == 0U) || (handler == NULL)) return false;
+
+    uint32_t key = DEVREG_KEY(type, address);
+    uint32_t pos = DEVREG_HASH(key);
+    uint16_t probe = 1U;
+
+    while ((t->slot[pos].key != 0U) && (t->slot[pos].key != key))
+    {
+        pos = (pos + 1U) & DEVREG_MASK;
+        probe++;
+    }
+
+    uint8_t* link = NULL;
+    if (t->slot[pos].key == key)
+    {
+        // Ključ postoji: provjera duplikata i dolazak do kraja liste
+        link = &t->slot[pos].head;
+        while (*link != DEVREG_END)
+        {
+            const DevReg_Route_t* r = &t->route[*link];
+            if ((r->handler == handler) && (r->index == index)) return false;
+            link = &t->route[*link].next;
+        }
+    }
+
+    if (t->routes >= DEVREG_MAX_ROUTES)
+    {
+        stats.overflow++;
+        return false;
+    }
+
+    uint8_t n = (uint8_t)t->routes++;
+    t->route[n].handler = handler;
+    t->route[n].index = index;
+    t->route[n].next = DEVREG_END;
+
+    if (link)
+    {
+        *link = n;
+    }
+    else
+    {
+        t->slot[pos].key = key;
+        t->slot[pos].head = n;
+        t->keys++;
+        if (probe > t->max_probe) t->max_probe = probe;
+    }
+    return true;
+}
+
+/**
+ * @brief Prosljeđuje događaj svim pretplatnicima (tip, adresa).
+ * @note  O(1) u prosjeku; poziva se iz listenera (prekid).
+ * @param type    Tip TinyFrame poruke.
+ * @param address Adresa iz okvira.
+ * @param data    Podaci okvira iza adrese.
+ * @param len     Dužina `data`.
+ * @retval uint8_t Broj pozvanih pretplatnika.
+ */
+uint8_t DevReg_Dispatch(uint8_t type, uint16_t address, const uint8_t* data, uint8_t len)
+{
+    const DevReg_Table_t* t = active;
+    if ((t == NULL) || (address == 0U)) return 0;
+
+    uint32_t key = DEVREG_KEY(type, address);
+    uint32_t pos = DEVREG_HASH(key);
+
+    for (uint16_t n = 0; n < t->max_probe; n++)
+    {
+        if (t->slot[pos].key == key)
+        {
+            uint8_t count = 0;
+            for (uint8_t r = t->slot[pos].head; r != DEVREG_END; r = t->route[r].next)
+            {
+                t->route[r].handler(t->route[r].index, address, data, len);
+                count++;
+            }
+            return count;
+        }
+        if (t->slot[pos].key == 0U) break;
+        pos = (pos + 1U) & DEVREG_MASK;
+    }
+    return 0;
+}
+
+/**
+ * @brief Vraća stanje aktivne tabele.
+ */
+const DevReg_Stats_t* DevReg_GetStats(void)
+{
+    return &stats;
+}
@@ -89,6 +89,8 @@
 // --- Standardni i sistemski headeri ---
 #include "main.h"
 #include "display.h"
+#include "LCDConf.h"
+#include "profiler.h"
 #include "stm32746g_eeprom.h"
 
 // --- Headeri drugih modula (za pozivanje njihovih API-ja) ---
@@ -102,6 +104,8 @@
 #include "rs485.h"
 #include "gate.h"
 #include "scene.h"
+#include "history.h"
+#include "eventlog.h"
 #include "translations.h"
 
 /*============================================================================*/
@@ -111,7 +115,7 @@
 /** @name Vremenske konstante za GUI
  * @{
  */
-#define GUI_REFRESH_TIME                50U     ///< Svrha: Period osvježavanja GUI-ja. Vrijednost: 100 milisekundi (10 puta u sekundi).
+#define GUI_REFRESH_TIME                50U     ///< Svrha: Najduži razmak između dva `GUI_Exec` prolaza bez dodira. Vrijednost: 50 milisekundi.
 #define DATE_TIME_REFRESH_TIME          1000U   ///< Svrha: Period osvježavanja prikaza datuma i vremena. Vrijednost: 1000 milisekundi (svake sekunde).
 #define SETTINGS_MENU_ENABLE_TIME       3456U   ///< Svrha: Vrijeme držanja pritiska za ulazak u meni. Vrijednost: 3456 milisekundi (~3.5 sekunde).
 #define SETTINGS_MENU_TIMEOUT           59000U  ///< Svrha: Timeout za automatski izlazak iz menija. Vrijednost: 59000 milisekundi (59 sekundi).
@@ -133,6 +137,20 @@
 #define COLOR_BSIZE                     28      ///< Svrha: Veličina `clk_clrs` niza. Vrijednost: 28, mora odgovarati broju boja u nizu.
 /** @} */
 
+/** @name Slotovi keša statičkih pozadina ekrana u SDRAM-u (vidi `LCD_BkgCache_Store`)
+ * @{
+ */
+#define BKG_SLOT_THERMOSTAT             0       ///< Sloj 0: bitmapa termostata i hamburger meni.
+#define BKG_SLOT_LIGHTS                 1       ///< Sloj 1: hamburger meni i natpisi ispod/iznad ikonica svjetala.
+#define BKG_SLOT_SETTINGS_1             2       ///< Sloj 1: labele i linije prvog ekrana podešavanja.
+/** @} */
+
+/** @name Keš widgeta za ekrane podešavanja
+ * @{
+ */
+#define SETTINGS_PAGE_COUNT             (SCREEN_SETTINGS_9 - SCREEN_SETTINGS_1 + 1) ///< Broj stranica `SCREEN_SETTINGS_1`..`SCREEN_SETTINGS_9`.
+/** @} */
+
 /** @name Definicije za ikonice svjetala
  * @note Premješteno iz lights.h, privatno za display modul.
  * @{
@@ -194,8 +212,11 @@
  * @note Koriste se u petljama za kreiranje widgeta kao početna vrijednost.
  * @{
  */
-#define ID_CurtainsRelay                0x894   ///< Svrha: Početni ID za widgete zavjesa. Vrijednost: 0x894 (Heksadecimalni broj).
-#define ID_LightsModbusRelay            0x8B3   ///< Svrha: Početni ID za widgete svjetala. Vrijednost: 0x8B3 (Heksadecimalni broj).
+#define ID_CurtainsRelay                0x894   ///< Svrha: Početni ID za widgete zavjesa jedne stranice (`CURTAINS_PER_SETTINGS_PAGE` x 2). Vrijednost: 0x894 (Heksadecimalni broj).
+#define ID_LightsModbusRelay            0x8B3   ///< Svrha: Početni ID za widgete svjetla na stranici (`LIGHT_SETTINGS_WIDGETS`). Vrijednost: 0x8B3 (Heksadecimalni broj).
+#define CURTAINS_PER_SETTINGS_PAGE      4       ///< Svrha: Broj roletni na jednoj podstranici podešavanja.
+#define LIGHT_SETTINGS_WIDGETS          13      ///< Svrha: Broj widgeta podešavanja jednog svjetla.
+#define DEVICES_PER_PAGE                6       ///< Svrha: Broj ikonica na jednoj stranici mreže svjetala, kapija i scena (2 reda po 3).
 /** @} */
 
 /** @name ID-jevi za QR kodove
@@ -238,6 +259,29 @@ typedef enum
     SCENE_PICKER_MODE_WIZARD,   /**< Mod za "čarobnjaka": prikazuje samo neiskorištene izglede za kreiranje nove scene. */
     SCENE_PICKER_MODE_TIMER     /**< Mod za tajmer: prikazuje sve konfigurisane scene radi odabira akcije za alarm. */
 } eScenePickerMode;
+/**
+ * @brief Jedan unos u registru ekrana (`screen_ops`).
+ * @note  Bilo koji pokazivač može biti `NULL`. Ekrani koji se iscrtavaju
+ * kroz `shouldDrawScreen` fleg unutar svoje servisne funkcije nemaju
+ * `enter`, a ekrani bez vlastitih widgeta nemaju ni `exit`.
+ */
+typedef struct
+{
+    void (*enter)(void);        /**< Priprema ekran: kreira ili prikazuje widgete i iscrtava statički sadržaj. */
+    void (*exit)(void);         /**< Napuštanje ekrana: sakriva ili briše widgete. */
+    void (*service)(void);      /**< Poziva se iz `DISP_Service` u svakom prolazu dok je ekran aktivan. */
+    void (*invalidate)(void);   /**< Odbacuje keširane widgete, pa ih sljedeći `enter` kreira ispočetka. */
+} ScreenOps_t;
+/**
+ * @brief Keširana stranica podešavanja.
+ * @note  Svi widgeti jedne stranice su djeca jednog nevidljivog kontejner
+ * prozora, pa se cijela stranica sakriva, prikazuje i briše jednim pozivom.
+ */
+typedef struct
+{
+    WM_HWIN  hWin;              /**< Kontejner prozor stranice; 0 ako stranica još nije kreirana. */
+    uint32_t variant;           /**< Ključ sadržaja (podstranica, jezik...) za koji su widgeti kreirani. */
+} SettingsPage_t;
 /******************************************************************************
  * @brief       Struktura koja definiše kontekst za univerzalni numerički keypad.
  * @author      Gemini (po specifikaciji korisnika)
@@ -1403,6 +1447,30 @@ lights_and_gates_grid_layout =
     .row_height             = 130,  // Ranije hardkodirana vrijednost
     .text_icon_padding      = 2     // Ranije hardkodirana vrijednost
 };
+/**
+ ******************************************************************************
+ * @brief       Struktura sa konstantama za listanje stranica mreže ikonica
+ * (svjetla, kapije i scene).
+ * @note        Zona je u desnoj koloni, između hamburger menija (y < 80) i
+ * ikonice čarobnjaka, odnosno "Next" dugmeta (y >= 152), pa ne sijeće
+ * nijedan postojeći element. Indikator se iscrtava samo kada uređaja ima
+ * više nego što stane na jednu stranicu (`DEVICES_PER_PAGE`).
+ ******************************************************************************
+ */
+static const struct
+{
+    TouchZone_t zone;           /**< Zona dodira za prelazak na sljedeću stranicu. */
+    int16_t     text_y;         /**< Y pozicija teksta "n/m". */
+    int16_t     arrow_y;        /**< Y centar trougla. */
+    int16_t     arrow_size;     /**< Polovina visine trougla. */
+}
+grid_pager_layout =
+{
+    .zone       = { .x0 = 400, .y0 = 80, .x1 = 480, .y1 = 150 },
+    .text_y     = 86,
+    .arrow_y    = 128,
+    .arrow_size = 12
+};
 /**
  ******************************************************************************
  * @brief       Struktura koja sadrži konstante za raspored elemenata na
@@ -1754,6 +1822,20 @@ Display_EepromSettings_t g_display_settings;
  * ažurirati dinamičke podatke. Resetuje se na `0` prilikom napuštanja ekrana.
  */
 static uint8_t thermostatMenuState = 0;
+/**
+ * @brief Ključ sadržaja za svaki slot keša statičkih pozadina (`BKG_SLOT_xxx`).
+ * @note  Vrijednost `0` znači da slot nije popunjen. Ključ se računa iz svega
+ * što utiče na statički dio ekrana (jezik, boja menija, konfiguracija), pa se
+ * promjenom postavki keš automatski poništava bez eksplicitnog brisanja.
+ */
+static uint32_t bkg_cache_key[LCD_BKG_CACHE_SLOTS] = {0};
+/**
+ * @brief Keš widgeta za ekrane podešavanja, indeksiran sa `screen - SCREEN_SETTINGS_1`.
+ * @note  Pri prelasku između stranica kontejneri se samo sakrivaju i
+ * prikazuju, bez alokacije na GUI heap-u. Brišu se tek kada se izađe iz
+ * menija podešavanja (`DSP_SettingsPagesRelease`).
+ */
+static SettingsPage_t settings_page[SETTINGS_PAGE_COUNT] = {0};
 /**
  * @brief Fleg koji služi kao mehanizam za komunikaciju između modula.
  * @note Drugi moduli (npr. `defroster`, `ventilator`) pozivaju javnu funkciju `DISP_SignalDynamicIconUpdate()`
@@ -2047,7 +2129,7 @@ static uint8_t scene_edit_index = 0;
  */
 static uint32_t scene_press_timer_start = 0;
 /**
- * @brief Indeks slota (0-5) koji je korisnik pritisnuo na ekranu sa scenama.
+ * @brief Redni broj konfigurisane scene koju je korisnik pritisnuo na ekranu sa scenama.
  * @note  Čuva se prilikom pritiska, a koristi prilikom otpuštanja.
  * Vrijednost -1 označava da nijedan slot nije pritisnut.
  */
@@ -2058,6 +2140,14 @@ static int8_t scene_pressed_index = -1;
  * na jedan ekran. Vrijednost 0 je prva stranica.
  */
 static uint8_t scene_appearance_page = 0;
+/**
+ * @brief Trenutne stranice mreže na ekranima svjetala, kapija i scena.
+ * @note  Vrijednost 0 je prva stranica. Prije iscrtavanja se ograničavaju na
+ * postojeće stranice, a `Service_ReturnToFirst` ih vraća na prvu.
+ */
+static uint8_t lights_page = 0;
+static uint8_t gates_page = 0;
+static uint8_t scenes_page = 0;
 /**
  * @brief Globalni fleg unutar display modula koji prati da li je sistem u "Scene Wizard" modu.
  * @note  Ovaj fleg je ključan za kontekstualnu promjenu ponašanja ekrana.
@@ -2177,6 +2267,10 @@ static void DSP_KillSet6Scrn(void);
 static void DSP_KillSet7Scrn(void);
 static void DSP_KillSet8Scrn(void);
 static void DSP_KillSet9Scrn(void);
+static bool DSP_SettingsPageOpen(uint8_t page_screen, uint32_t variant, WM_HWIN* pParent);
+static WM_HWIN DSP_SettingsPageGet(uint8_t page_screen);
+static void DSP_SettingsPageHide(uint8_t page_screen);
+static void DSP_SettingsPagesRelease(void);
 static void DSP_InitSceneEditScreen(void);
 static void DSP_KillSceneEditScreen(void);
 static void DSP_KillLightSettingsScreen(void);
@@ -2248,6 +2342,8 @@ static void Service_SettingsTimerScreen(void);
 static void Service_AlarmActiveScreen(void);
 static void Service_GateSettingsScreen(void);
 static void Service_SettingsAlarmScreen(void);
+static void Service_ProfilerScreen(void);
+static void Service_HistoryScreen(void);
 
 /** @} */
 
@@ -2264,6 +2360,13 @@ static void PID_Hook(GUI_PID_STATE * pTS);
  * noćnog tajmera za svjetla, ažuriranje vremena i druge pozadinske zadatke.
  */
 static void Handle_PeriodicEvents(void);
+/**
+ * @brief Obrađuje gestove (dugi pritisak, swipe, dupli dodir) iz `TS_GetGesture`.
+ * @note Poziva se iz `DISP_Service` prije `Handle_PeriodicEvents`.
+ */
+static void Handle_GestureEvents(void);
+static void Handle_LongPressGesture(void);
+static void Handle_LongHoldGesture(void);
 /**
  * @brief Dispečer za događaje pritiska na ekran.
  * @note Poziva se iz `PID_Hook` kada je ekran pritisnut. Na osnovu trenutnog
@@ -2286,6 +2389,7 @@ static void HandlePress_SceneScreen(GUI_PID_STATE * pTS, uint8_t *click_flag);
 static void HandlePress_TimerScreen(GUI_PID_STATE * pTS, uint8_t *click_flag);
 static void HandlePress_GateScreen(GUI_PID_STATE * pTS, uint8_t *click_flag);
 static void HandlePress_GateSettingsScreen(GUI_PID_STATE* pTS, uint8_t* click_flag);
+static void HandlePress_HistoryScreen(GUI_PID_STATE* pTS, uint8_t* click_flag);
 
 /**
  * @brief Dispečer za događaje otpuštanja dodira sa ekrana.
@@ -2297,6 +2401,7 @@ static void HandleTouchReleaseEvent(GUI_PID_STATE * pTS);
 static void HandleRelease_MainScreenSwitch(GUI_PID_STATE * pTS);
 static void HandleRelease_SceneScreen(void);
 static void HandleRelease_AlarmIcon(void);
+static void SyncAlarmUiState(void);
 static void HandleRelease_TimerIcon(void);
 /** @} */
 /* Prototipovi novih funkcija za PIN tastaturu */
@@ -2343,6 +2448,132 @@ static void DISPDateTime(void);
  * @brief Iscrtava ikonu "hamburger" menija u gornjem desnom uglu.
  */
 static void DrawHamburgerMenu(uint8_t position);
+/**
+ * @brief Vraća broj stranica mreže ikonica za `total` uređaja.
+ * @param total Ukupan broj uređaja (svjetala, kapija ili scena).
+ * @retval uint8_t Broj stranica, najmanje 1.
+ */
+static uint8_t DISP_GridPageCount(uint8_t total)
+{
+    return (total > DEVICES_PER_PAGE) ? (uint8_t)((total + DEVICES_PER_PAGE - 1) / DEVICES_PER_PAGE) : 1;
+}
+/**
+ * @brief Ograničava stranicu na postojeće i vraća broj ikonica na njoj.
+ * @note  Broj uređaja se može smanjiti dok je ekran otvoren (podešavanja,
+ * konfiguracija preko RS485), pa se stranica tada svodi na posljednju.
+ * @param total Ukupan broj uređaja.
+ * @param page  Pokazivač na stranicu ekrana, po potrebi se ispravlja.
+ * @retval uint8_t Broj ikonica na stranici (0 do `DEVICES_PER_PAGE`).
+ */
+static uint8_t DISP_GridPageItems(uint8_t total, uint8_t* page)
+{
+    const uint8_t pages = DISP_GridPageCount(total);
+    if (*page >= pages) *page = pages - 1;
+
+    const uint8_t rest = total - (*page * DEVICES_PER_PAGE);
+    return (rest > DEVICES_PER_PAGE) ? DEVICES_PER_PAGE : rest;
+}
+/**
+ * @brief Vraća broj redova mreže (1 ili 2) za `items` ikonica na stranici.
+ */
+static uint8_t DISP_GridRows(uint8_t items)
+{
+    return (items > 3) ? 2 : 1;
+}
+/**
+ * @brief Vraća broj ikonica u redu `row` za `items` ikonica na stranici.
+ * @note  Raspored je isti kao ranije za cijeli ekran: 4 = 2+2, 5 = 3+2, 6 = 3+3.
+ */
+static uint8_t DISP_GridRowItems(uint8_t items, uint8_t row)
+{
+    if (items <= 3) return items;
+    if (items == 4) return 2;
+    if (items == 5) return (row > 0) ? 2 : 3;
+    return 3;
+}
+/**
+ * @brief Iscrtava indikator stranice "n/m" i trougao za sljedeću stranicu.
+ * @note  Ne iscrtava ništa ako postoji samo jedna stranica, pa ekrani sa do
+ * `DEVICES_PER_PAGE` uređaja izgledaju kao i ranije.
+ * @param page  Trenutna stranica (od 0).
+ * @param pages Ukupan broj stranica.
+ */
+static void DISP_DrawGridPager(uint8_t page, uint8_t pages)
+{
+    char buf[8];
+    const int s = grid_pager_layout.arrow_size;
+    const int x_center = (grid_pager_layout.zone.x0 + grid_pager_layout.zone.x1) / 2;
+    const GUI_POINT arrow[3] = { { 0, -s }, { 0, s }, { s, 0 } };
+
+    if (pages < 2) return;
+
+    sprintf(buf, "%u/%u", page + 1U, pages);
+    GUI_SetFont(&GUI_FontVerdana20_LAT);
+    GUI_SetColor(GUI_WHITE);
+    GUI_SetTextMode(GUI_TM_TRANS);
+    GUI_SetTextAlign(GUI_TA_HCENTER | GUI_TA_TOP);
+    GUI_DispStringAt(buf, x_center, grid_pager_layout.text_y);
+
+    GUI_SetColor(clk_clrs[g_display_settings.scrnsvr_clk_clr]);
+    GUI_FillPolygon(arrow, 3, x_center - (s / 2), grid_pager_layout.arrow_y);
+}
+/**
+ * @brief Provjerava dodir na zonu za listanje i prelazi na sljedeću stranicu.
+ * @note  Nakon posljednje stranice vraća se na prvu. Dodir ne pokreće nikakvu
+ * akciju na uređajima, samo traži ponovno iscrtavanje ekrana.
+ * @param pTS   Pokazivač na strukturu sa stanjem dodira.
+ * @param page  Pokazivač na stranicu ekrana.
+ * @param pages Ukupan broj stranica.
+ * @retval bool `true` ako je dodir obrađen kao listanje.
+ */
+static bool DISP_GridPagerPressed(const GUI_PID_STATE* pTS, uint8_t* page, uint8_t pages)
+{
+    if ((pages < 2) ||
+            (pTS->x < grid_pager_layout.zone.x0) || (pTS->x >= grid_pager_layout.zone.x1) ||
+            (pTS->y < grid_pager_layout.zone.y0) || (pTS->y >= grid_pager_layout.zone.y1))
+    {
+        return false;
+    }
+    *page = ((*page + 1U) < pages) ? (*page + 1U) : 0U;
+    shouldDrawScreen = 1;
+    return true;
+}
+/**
+ * @brief Vraća fizički indeks `ordinal`-te po redu konfigurisane scene.
+ * @param ordinal Redni broj među konfigurisanim scenama (od 0).
+ * @retval int8_t Indeks scene, ili -1 ako takva scena ne postoji.
+ */
+static int8_t DISP_SceneByOrdinal(uint8_t ordinal)
+{
+    for (uint8_t i = 0; i < SCENE_MAX_COUNT; i++) {
+        Scene_t* handle = Scene_GetInstance(i);
+        if (handle && handle->is_configured) {
+            if (ordinal == 0) return (int8_t)i;
+            ordinal--;
+        }
+    }
+    return -1;
+}
+/**
+ * @brief Računa ključ sadržaja statičke pozadine za zadati slot keša.
+ */
+static uint8_t DISP_GridPageCount(uint8_t total);
+static uint8_t DISP_GridPageItems(uint8_t total, uint8_t* page);
+static uint8_t DISP_GridRows(uint8_t items);
+static uint8_t DISP_GridRowItems(uint8_t items, uint8_t row);
+static void DISP_DrawGridPager(uint8_t page, uint8_t pages);
+static bool DISP_GridPagerPressed(const GUI_PID_STATE* pTS, uint8_t* page, uint8_t pages);
+static int8_t DISP_SceneByOrdinal(uint8_t ordinal);
+static uint32_t DISP_BkgCacheKey(uint8_t slot);
+/**
+ * @brief Vraća statičku pozadinu iz SDRAM keša jednim DMA2D prenosom.
+ * @retval bool `true` ako je pozadina vraćena, `false` ako je treba iscrtati.
+ */
+static bool DISP_BkgCacheRestore(uint8_t slot, uint8_t layer, uint32_t key);
+/**
+ * @brief Snima upravo iscrtanu statičku pozadinu u SDRAM keš.
+ */
+static void DISP_BkgCacheStore(uint8_t slot, uint8_t layer, uint32_t key);
 /**
  * @brief Detektuje i obrađuje dugi pritisak za ulazak u meni za podešavanja.
  * @param btn Fleg koji ukazuje na početak pritiska (postavljen u `PID_Hook`).
@@ -2368,6 +2599,61 @@ static int8_t control_mode_map_1[MODE_COUNT];
  */
 static int8_t control_mode_map_2[MODE_COUNT];
 
+/**
+ * @brief Prelazi sa trenutnog ekrana na `next` preko registra ekrana.
+ * @note  Poziva `exit` trenutnog i `enter` novog ekrana, pa postavlja `screen`.
+ */
+static void DISP_ChangeScreen(uint8_t next);
+/**
+ * @brief Vraća unos iz registra ekrana, ili `NULL` za nepoznat ekran.
+ */
+static const ScreenOps_t* DISP_GetScreenOps(uint8_t scr);
+/**
+ * @brief Registar ekrana, indeksiran vrijednošću `eScreen`.
+ * @note  Zamjenjuje veliki `switch` u `DISP_Service` i lanac `if/else`
+ * poziva `DSP_KillXxx` funkcija kod aktivacije screensavera. Novi ekran
+ * se dodaje jednim redom u ovu tabelu.
+ */
+static const ScreenOps_t screen_ops[SCREEN_HISTORY + 1] =
+{
+    [SCREEN_RESET_MENU_SWITCHES]    = { NULL,               NULL,                           Service_MainScreenSwitch,       NULL },
+    [SCREEN_MAIN]                   = { NULL,               NULL,                           Service_MainScreen,             NULL },
+    [SCREEN_SELECT_1]               = { NULL,               NULL,                           Service_SelectScreen1,          NULL },
+    [SCREEN_SELECT_2]               = { NULL,               NULL,                           Service_SelectScreen2,          NULL },
+    [SCREEN_SELECT_LAST]            = { NULL,               NULL,                           Service_SelectScreenLast,       NULL },
+    [SCREEN_THERMOSTAT]             = { NULL,               NULL,                           Service_ThermostatScreen,       NULL },
+    [SCREEN_LIGHTS]                 = { NULL,               NULL,                           Service_LightsScreen,           NULL },
+    [SCREEN_CURTAINS]               = { NULL,               NULL,                           Service_CurtainsScreen,         NULL },
+    [SCREEN_GATE]                   = { NULL,               NULL,                           Service_GateScreen,             NULL },
+    [SCREEN_GATE_SETTINGS]          = { NULL,               NULL,                           Service_GateSettingsScreen,     NULL },
+    [SCREEN_TIMER]                  = { NULL,               DSP_KillTimerScreen,            Service_TimerScreen,            NULL },
+    [SCREEN_SECURITY]               = { NULL,               NULL,                           Service_SecurityScreen,         NULL },
+    [SCREEN_SCENE]                  = { NULL,               NULL,                           Service_SceneScreen,            NULL },
+    [SCREEN_SCENE_EDIT]             = { NULL,               NULL,                           Service_SceneEditScreen,        NULL },
+    [SCREEN_SCENE_APPEARANCE]       = { NULL,               NULL,                           Service_SceneAppearanceScreen,  NULL },
+    [SCREEN_SCENE_WIZ_DEVICES]      = { NULL,               NULL,                           Service_SceneWizDevicesScreen,  NULL },
+    [SCREEN_LIGHT_SETTINGS]         = { NULL,               DSP_KillLightSettingsScreen,    Service_LightSettingsScreen,    NULL },
+    [SCREEN_QR_CODE]                = { NULL,               NULL,                           Service_QrCodeScreen,           NULL },
+    [SCREEN_CLEAN]                  = { NULL,               NULL,                           Service_CleanScreen,            NULL },
+    [SCREEN_NUMPAD]                 = { NULL,               DSP_KillNumpadScreen,           Service_NumpadScreen,           NULL },
+    [SCREEN_RETURN_TO_FIRST]        = { NULL,               NULL,                           Service_ReturnToFirst,          NULL },
+    [SCREEN_SETTINGS_ALARM]         = { NULL,               NULL,                           Service_SettingsAlarmScreen,    NULL },
+    [SCREEN_SETTINGS_1]             = { DSP_InitSet1Scrn,   DSP_KillSet1Scrn,               Service_SettingsScreen_1,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_2]             = { DSP_InitSet2Scrn,   DSP_KillSet2Scrn,               Service_SettingsScreen_2,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_3]             = { DSP_InitSet3Scrn,   DSP_KillSet3Scrn,               Service_SettingsScreen_3,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_4]             = { DSP_InitSet4Scrn,   DSP_KillSet4Scrn,               Service_SettingsScreen_4,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_5]             = { DSP_InitSet5Scrn,   DSP_KillSet5Scrn,               Service_SettingsScreen_5,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_6]             = { DSP_InitSet6Scrn,   DSP_KillSet6Scrn,               Service_SettingsScreen_6,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_7]             = { DSP_InitSet7Scrn,   DSP_KillSet7Scrn,               Service_SettingsScreen_7,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_8]             = { DSP_InitSet8Scrn,   DSP_KillSet8Scrn,               Service_SettingsScreen_8,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_9]             = { DSP_InitSet9Scrn,   DSP_KillSet9Scrn,               Service_SettingsScreen_9,       DSP_SettingsPagesRelease },
+    [SCREEN_SETTINGS_TIMER]         = { NULL,               NULL,                           Service_SettingsTimerScreen,    NULL },
+    [SCREEN_SETTINGS_DATETIME]      = { NULL,               DSP_KillSettingsDateTimeScreen, Service_SettingsDateTimeScreen, NULL },
+    [SCREEN_ALARM_ACTIVE]           = { NULL,               NULL,                           Service_AlarmActiveScreen,      NULL },
+    [SCREEN_PROFILER]               = { NULL,               NULL,                           Service_ProfilerScreen,         NULL },
+    [SCREEN_HISTORY]                = { NULL,               NULL,                           Service_HistoryScreen,          NULL },
+};
+
 static bool IsBusFwUpdateActive(void);
 /** @} */
 
@@ -2471,10 +2757,33 @@ void DISP_Service(void)
 {
     static uint32_t guitmr = 0;
 
-    // Ažuriranje GUI-ja i obrada TS-a u fiksnim intervalima
-    if ((HAL_GetTick() - guitmr) >= GUI_REFRESH_TIME) {
-        guitmr = HAL_GetTick();
-        GUI_Exec(); // Izvršava sve pending operacije iscrtavanja
+    // Dok dnevnik događaja programira ili briše QSPI, bitmape iz QSPI nisu
+    // čitljive (fontovi su u internom flash-u). Programiranje stranice traje
+    // do 5 ms, a brisanje podsektora oko 250 ms, najviše 800 ms, pa ga
+    // dnevnik pokreće dok je screensaver aktivan ili unaprijed (eventlog.c).
+    // Za to vrijeme čeka samo ono što crta bitmape: GUI_Exec, prolaz aktivnog
+    // ekrana, gestovi i ulaz u meni (otvaraju ekrane i odmah crtaju). Dodir i
+    // gestovi ostaju u redu i obrađuju se čim se QSPI vrati u mapiran režim.
+    const bool qspi_ready = !EventLog_IsFlashBusy();
+    const bool gui_due = ((HAL_GetTick() - guitmr) >= GUI_REFRESH_TIME);
+
+    // Pacer frejmova: dok završen frejm čeka vsync, novi se ne počinje jer
+    // bi ga samo prepisao u redu. Dodir pokreće obradu odmah, a periodični
+    // prolaz iscrtava samo ako postoji nevažeći prozor.
+    if (qspi_ready) {
+        LCD_Pacer_FrameBegin();
+        if (LCD_Pacer_IsSwapPending()) {
+            if (gui_due) LCD_Pacer_Defer();
+        } else if (LCD_Pacer_TakeInput() || gui_due) {
+            guitmr = HAL_GetTick();
+            Profiler_GuiExecBegin();
+            if (WM_GetNumInvalidWindows() || GUI_PID_IsPressed()) {
+                GUI_Exec(); // Obrada dodira i iscrtavanje nevažećih prozora
+            } else {
+                GUI_Exec1(); // Samo emWin tajmeri i poruke, bez iscrtavanja
+            }
+            Profiler_GuiExecEnd();
+        }
     }
 
     // Provjera i prikaz poruke o ažuriranju firmvera
@@ -2482,122 +2791,38 @@ void DISP_Service(void)
         return; // Ako je ažuriranje u toku, prekini dalje izvršavanje GUI logike
     }
 
-    // Glavni switch za upravljanje stanjima (ekranima)
-    switch (screen) {
-    case SCREEN_MAIN:
-        Service_MainScreen();
-        break;
-    case SCREEN_SELECT_1:
-        Service_SelectScreen1();
-        break;
-    case SCREEN_SELECT_2:
-        Service_SelectScreen2();
-        break;
-    case SCREEN_SCENE:
-        Service_SceneScreen();
-        break;
-    case SCREEN_SCENE_EDIT:
-        Service_SceneEditScreen();
-        break;
-    case SCREEN_SCENE_APPEARANCE:
-        Service_SceneAppearanceScreen();
-        break;
-    case SCREEN_SCENE_WIZ_DEVICES:
-        Service_SceneWizDevicesScreen();
-        break;
-    case SCREEN_SELECT_LAST:
-        Service_SelectScreenLast();
-        break;
-    case SCREEN_THERMOSTAT:
-        Service_ThermostatScreen();
-        break;
-    case SCREEN_ALARM_ACTIVE:
-        Service_AlarmActiveScreen();
-        break;
-    case SCREEN_RETURN_TO_FIRST:
-        Service_ReturnToFirst();
-        break;
-    case SCREEN_SETTINGS_1:
-        Service_SettingsScreen_1();
-        break;
-    case SCREEN_SETTINGS_2:
-        Service_SettingsScreen_2();
-        break;
-    case SCREEN_SETTINGS_3:
-        Service_SettingsScreen_3();
-        break;
-    case SCREEN_SETTINGS_4:
-        Service_SettingsScreen_4();
-        break;
-    case SCREEN_SETTINGS_5:
-        Service_SettingsScreen_5();
-        break;
-    case SCREEN_SETTINGS_6:
-        Service_SettingsScreen_6();
-        break;
-    case SCREEN_SETTINGS_7:
-        Service_SettingsScreen_7();
-        break;
-    case SCREEN_SETTINGS_8:
-        Service_SettingsScreen_8();
-        break;
-    case SCREEN_SETTINGS_9:
-        Service_SettingsScreen_9();
-        break;
-    case SCREEN_SETTINGS_ALARM:
-        Service_SettingsAlarmScreen();
-        break;
-    case SCREEN_CLEAN:
-        Service_CleanScreen();
-        break;
-    case SCREEN_NUMPAD:
-        Service_NumpadScreen();
-        break;
-    case SCREEN_LIGHTS:
-        Service_LightsScreen();
-        break;
-    case SCREEN_CURTAINS:
-        Service_CurtainsScreen();
-        break;
-    case SCREEN_GATE:
-        Service_GateScreen();
-        break;
-    case SCREEN_GATE_SETTINGS:
-        Service_GateSettingsScreen();
-        break;
-    case SCREEN_SECURITY:
-        Service_SecurityScreen();
-        break;
-    case SCREEN_TIMER:
-        Service_TimerScreen();
-        break;
-    case SCREEN_SETTINGS_TIMER:
-        Service_SettingsTimerScreen();
-        break;
-    case SCREEN_SETTINGS_DATETIME:
-        Service_SettingsDateTimeScreen();
-        break;
-    case SCREEN_QR_CODE:
-        Service_QrCodeScreen();
-        break;
-    case SCREEN_LIGHT_SETTINGS:
-        Service_LightSettingsScreen();
-        break;
-    case SCREEN_RESET_MENU_SWITCHES:
-        Service_MainScreenSwitch();
-        break;
-    default:
-        // U slučaju nepoznatog stanja, resetuj flegove menija
-        menu_lc = 0;
-        thermostatMenuState = 0;
-        break;
+    // Servisne funkcije ekrana crtaju direktno (GUI_MULTIBUF_BeginEx/EndEx),
+    // pa se dok završen frejm čeka vsync ni one ne pozivaju, kao ni GUI_Exec.
+    const bool render_ok = qspi_ready && !LCD_Pacer_IsSwapPending();
+    if (qspi_ready && !render_ok) LCD_Pacer_DeferService();
+
+    if (render_ok) {
+        // Servisna funkcija aktivnog ekrana iz registra, mjerena profilerom
+        Profiler_FrameBegin((uint8_t)screen, shouldDrawScreen != 0);
+        const ScreenOps_t* ops = DISP_GetScreenOps(screen);
+        if ((ops != NULL) && (ops->service != NULL)) {
+            ops->service();
+        } else {
+            // U slučaju nepoznatog stanja, resetuj flegove menija
+            menu_lc = 0;
+            thermostatMenuState = 0;
+        }
+        Profiler_FrameEnd();
+
+        // Gestovi prepoznati u TS_Service (dugi pritisak, swipe, dupli dodir)
+        Handle_GestureEvents();
     }
 
     // Upravljanje periodičnim događajima i tajmerima (npr. screensaver)
     Handle_PeriodicEvents();
 
+    // Izlaskom iz menija podešavanja oslobađaju se keširani widgeti stranica
+    if ((screen < SCREEN_SETTINGS_1) || (screen > SCREEN_SETTINGS_9)) {
+        DSP_SettingsPagesRelease();
+    }
+
     // Provjera da li treba ući u meni za podešavanja (dugi pritisak)
-    if (DISPMenuSettings(btnset) && (screen < SCREEN_SETTINGS_1)) {
+    if (render_ok && DISPMenuSettings(btnset) && (screen < SCREEN_SETTINGS_1)) {
         // Inicijalizuj prvi ekran podešavanja
         DSP_InitSet1Scrn();
         screen = SCREEN_SETTINGS_1;
@@ -3297,6 +3522,9 @@ static void ForceKillAllSettingsWidgets(void)
     WM_HWIN hWidget;
     uint16_t id_to_check;
 
+    // --- 0. Brisanje keširanih stranica podešavanja (zajedno sa svim widgetima) ---
+    DSP_SettingsPagesRelease();
+
     // --- 1. Uništavanje statičkih widgeta sa nove, pregledne liste ---
     for (uint16_t i = 0; i < (sizeof(settings_static_widget_ids) / sizeof(settings_static_widget_ids[0])); i++) {
         id_to_check = settings_static_widget_ids[i];
@@ -3307,7 +3535,7 @@ static void ForceKillAllSettingsWidgets(void)
 
     // --- 2. Uništavanje dinamičkih widgeta (petlje ostaju) ---
     // Zavjese
-    for (uint16_t i = 0; i < (CURTAINS_SIZE * 2); i++) {
+    for (uint16_t i = 0; i < (CURTAINS_PER_SETTINGS_PAGE * 2); i++) {
         id_to_check = ID_CurtainsRelay + i;
         if ((hWidget = WM_GetDialogItem(WM_GetDesktopWindow(), id_to_check))) {
             WM_DeleteWindow(hWidget);
@@ -3315,7 +3543,7 @@ static void ForceKillAllSettingsWidgets(void)
     }
 
     // Svjetla
-    for (uint16_t i = 0; i < (LIGHTS_MODBUS_SIZE * 13); i++) {
+    for (uint16_t i = 0; i < LIGHT_SETTINGS_WIDGETS; i++) {
         id_to_check = ID_LightsModbusRelay + i;
         if ((hWidget = WM_GetDialogItem(WM_GetDesktopWindow(), id_to_check))) {
             WM_DeleteWindow(hWidget);
@@ -3498,6 +3726,67 @@ static void DrawHamburgerMenu(uint8_t position)
     GUI_DrawLine(xStart, yStart + yGap, xStart + width, yStart + yGap);
     GUI_DrawLine(xStart, yStart + (yGap * 2), xStart + width, yStart + (yGap * 2));
 }
+/**
+ * @brief Računa ključ sadržaja statičke pozadine za zadati slot keša.
+ * @note  FNV-1a preko svih parametara koji mijenjaju izgled statičkog dijela
+ * ekrana. Ako se ključ razlikuje od snimljenog, slot se smatra nevažećim i
+ * pozadina se ponovo iscrtava i snima.
+ * @param slot Slot keša (`BKG_SLOT_xxx`).
+ * @retval uint32_t Ključ sadržaja, nikad `0`.
+ */
+static uint32_t DISP_BkgCacheKey(uint8_t slot)
+{
+    uint8_t buf[5 + DEVICES_PER_PAGE];
+    uint8_t len = 0;
+    uint32_t key = 2166136261UL;
+
+    buf[len++] = slot;
+    buf[len++] = g_display_settings.language;
+    buf[len++] = g_display_settings.scrnsvr_clk_clr;
+
+    if (slot == BKG_SLOT_LIGHTS) {
+        // Natpisi i indikator zavise od stranice, pa ključ pokriva samo nju
+        const uint8_t items = DISP_GridPageItems(LIGHTS_getCount(), &lights_page);
+        const uint8_t first = lights_page * DEVICES_PER_PAGE;
+        buf[len++] = LIGHTS_getCount();
+        buf[len++] = lights_page;
+        for (uint8_t i = 0; i < items; i++) {
+            buf[len++] = LIGHT_GetIconID(LIGHTS_GetInstance(first + i));
+        }
+    }
+
+    for (uint8_t i = 0; i < len; i++) {
+        key ^= buf[i];
+        key *= 16777619UL;
+    }
+    return key ? key : 1;
+}
+/**
+ * @brief Vraća statičku pozadinu iz SDRAM keša jednim DMA2D prenosom.
+ * @note  Mora se pozvati unutar `GUI_MULTIBUF_BeginEx(layer)` kako bi prenos
+ * išao u zadnji (back) bafer, nakon čega se crta samo dinamički sadržaj.
+ * @param slot  Slot keša (`BKG_SLOT_xxx`).
+ * @param layer GUI sloj (0 ili 1) iz kojeg je pozadina snimljena.
+ * @param key   Ključ sadržaja dobijen od `DISP_BkgCacheKey`.
+ * @retval bool `true` ako je pozadina vraćena, `false` ako je treba iscrtati.
+ */
+static bool DISP_BkgCacheRestore(uint8_t slot, uint8_t layer, uint32_t key)
+{
+    if (bkg_cache_key[slot] != key) return false;
+    return (LCD_BkgCache_Restore(layer, slot) == 0);
+}
+/**
+ * @brief Snima upravo iscrtanu statičku pozadinu u SDRAM keš.
+ * @note  Poziva se nakon iscrtavanja statičkog dijela, a prije bilo kakvog
+ * dinamičkog sadržaja, unutar iste `GUI_MULTIBUF` transakcije.
+ * @param slot  Slot keša (`BKG_SLOT_xxx`).
+ * @param layer GUI sloj (0 ili 1) koji se snima.
+ * @param key   Ključ sadržaja dobijen od `DISP_BkgCacheKey`.
+ */
+static void DISP_BkgCacheStore(uint8_t slot, uint8_t layer, uint32_t key)
+{
+    bkg_cache_key[slot] = (LCD_BkgCache_Store(layer, slot) == 0) ? key : 0;
+}
 /**
  * @brief Prikazuje datum i vrijeme na ekranu, i upravlja logikom screensavera.
  * @note Ažurira se svake sekunde i odgovorna je za aktivaciju/deaktivaciju
@@ -3527,8 +3816,7 @@ static void DISPDateTime(void)
 
     if (!IsRtcTimeValid()) return;
 
-    HAL_RTC_GetTime(&hrtc, &rtctm, RTC_FORMAT_BCD);
-    HAL_RTC_GetDate(&hrtc, &rtcdt, RTC_FORMAT_BCD);
+    Timer_GetWallClock(&rtctm, &rtcdt);
 
     // Logika za automatsko paljenje/gašenje screensaver-a
     if (g_display_settings.scrnsvr_ena_hour >= g_display_settings.scrnsvr_dis_hour) {
@@ -3690,6 +3978,100 @@ static uint8_t DISPMenuSettings(uint8_t btn)
 
     return (0U); // Dugi pritisak nije detektovan.
 }
+/**
+ * @brief Vraća unos iz registra ekrana.
+ * @param scr Vrijednost iz `eScreen`.
+ * @retval Pokazivač na unos, ili `NULL` ako ekran nije u registru.
+ */
+static const ScreenOps_t* DISP_GetScreenOps(uint8_t scr)
+{
+    if (scr >= (sizeof(screen_ops) / sizeof(screen_ops[0]))) return NULL;
+    return &screen_ops[scr];
+}
+/**
+ * @brief Prelazi sa trenutnog ekrana na `next`.
+ * @note  `exit` trenutnog ekrana se poziva prije `enter` novog, tako da
+ * novi ekran zatiče očišćen LCD i slobodne dijeljene handle-ove dugmadi.
+ */
+static void DISP_ChangeScreen(uint8_t next)
+{
+    const ScreenOps_t* ops = DISP_GetScreenOps(screen);
+    if ((ops != NULL) && (ops->exit != NULL)) ops->exit();
+
+    screen = next;
+
+    ops = DISP_GetScreenOps(next);
+    if ((ops != NULL) && (ops->enter != NULL)) ops->enter();
+}
+/**
+ * @brief Otvara kontejner stranice podešavanja.
+ * @note  Ako je stranica već kreirana za isti `variant`, kontejner se samo
+ * prikaže i funkcija vraća `false` - widgeti postoje i pozivalac postavlja
+ * samo njihove vrijednosti. U suprotnom se stari kontejner briše (zajedno
+ * sa svim widgetima), kreira se novi i funkcija vraća `true`.
+ * Dugmad `NEXT` i `SAVE` dijele globalne handle-ove sa ostalim stranicama,
+ * pa se kod ponovnog prikaza vežu za dugmad ove stranice.
+ * @param page_screen Ekran `SCREEN_SETTINGS_1`..`SCREEN_SETTINGS_9`.
+ * @param variant Ključ sadržaja stranice (podstranica, jezik...).
+ * @param pParent Izlaz: kontejner koji se koristi kao roditelj widgeta.
+ * @retval true ako pozivalac treba kreirati widgete.
+ */
+static bool DSP_SettingsPageOpen(uint8_t page_screen, uint32_t variant, WM_HWIN* pParent)
+{
+    SettingsPage_t* page = &settings_page[page_screen - SCREEN_SETTINGS_1];
+
+    if (page->hWin && (page->variant == variant)) {
+        WM_ShowWindow(page->hWin);
+        hBUTTON_Next = WM_GetDialogItem(page->hWin, ID_Next);
+        hBUTTON_Ok = WM_GetDialogItem(page->hWin, ID_Ok);
+        // Dugme pritisnuto pri izlasku ne smije odmah ponovo okinuti navigaciju
+        if (hBUTTON_Next) BUTTON_SetPressed(hBUTTON_Next, 0);
+        if (hBUTTON_Ok) BUTTON_SetPressed(hBUTTON_Ok, 0);
+        if (page_screen == SCREEN_SETTINGS_6) {
+            BUTTON_SetPressed(hBUTTON_SET_DEFAULTS, 0);
+            BUTTON_SetPressed(hBUTTON_SYSRESTART, 0);
+        }
+        *pParent = page->hWin;
+        return false;
+    }
+
+    if (page->hWin) WM_DeleteWindow(page->hWin);
+    page->hWin = WM_CreateWindow(0, 0, LCD_GetXSize(), LCD_GetYSize(), WM_CF_SHOW | WM_CF_HASTRANS, NULL, 0);
+    page->variant = variant;
+    *pParent = page->hWin;
+    return true;
+}
+/**
+ * @brief Vraća kontejner stranice podešavanja, ili 0 ako nije kreiran.
+ */
+static WM_HWIN DSP_SettingsPageGet(uint8_t page_screen)
+{
+    if ((page_screen < SCREEN_SETTINGS_1) || (page_screen > SCREEN_SETTINGS_9)) return 0;
+    return settings_page[page_screen - SCREEN_SETTINGS_1].hWin;
+}
+/**
+ * @brief Sakriva kontejner stranice podešavanja zajedno sa svim widgetima.
+ */
+static void DSP_SettingsPageHide(uint8_t page_screen)
+{
+    WM_HWIN hWin = DSP_SettingsPageGet(page_screen);
+    if (hWin) WM_HideWindow(hWin);
+}
+/**
+ * @brief Briše sve keširane stranice podešavanja.
+ * @note  Poziva se po izlasku iz menija podešavanja i iz
+ * `ForceKillAllSettingsWidgets`, pa GUI heap ne drži widgete ekrana
+ * koji nisu aktivni.
+ */
+static void DSP_SettingsPagesRelease(void)
+{
+    for (uint8_t i = 0; i < SETTINGS_PAGE_COUNT; i++) {
+        if (settings_page[i].hWin) {
+            WM_DeleteWindow(settings_page[i].hWin);
+            settings_page[i].hWin = 0;
+        }
+    }
+}
 /**
  * @brief Inicijalizuje prvi ekran podešavanja (kontrola termostata i ventilatora).
  * @note  Ova funkcija kreira sve potrebne GUI widgete, kao što su RADIO
@@ -3713,134 +4095,136 @@ static void DSP_InitSet1Scrn(void)
     GUI_Clear();
     GUI_MULTIBUF_BeginEx(1);
 
-    /**
-     * @brief Kreiranje widgeta za kontrolu termostata.
-     * @note  Pozicije, dimenzije i početne vrijednosti se uzimaju iz layout strukture
-     * i API funkcija termostat modula.
-     */
-    hThstControl = RADIO_CreateEx(settings_screen_1_layout.thst_control_pos.x, settings_screen_1_layout.thst_control_pos.y, settings_screen_1_layout.thst_control_pos.w, settings_screen_1_layout.thst_control_pos.h, 0, WM_CF_SHOW, 0, ID_ThstControl, 3, 20);
-    RADIO_SetTextColor(hThstControl, GUI_GREEN);
-    RADIO_SetText(hThstControl, "OFF", 0);
-    RADIO_SetText(hThstControl, "COOLING", 1);
-    RADIO_SetText(hThstControl, "HEATING", 2);
-    RADIO_SetValue(hThstControl, Thermostat_GetControlMode(pThst));
+    WM_HWIN hPage;
+    if (DSP_SettingsPageOpen(SCREEN_SETTINGS_1, 0, &hPage)) {
+        /**
+         * @brief Kreiranje widgeta za kontrolu termostata.
+         * @note  Pozicije, dimenzije i početne vrijednosti se uzimaju iz layout strukture
+         * i API funkcija termostat modula.
+         */
+        hThstControl = RADIO_CreateEx(settings_screen_1_layout.thst_control_pos.x, settings_screen_1_layout.thst_control_pos.y, settings_screen_1_layout.thst_control_pos.w, settings_screen_1_layout.thst_control_pos.h, hPage, WM_CF_SHOW, 0, ID_ThstControl, 3, 20);
+        RADIO_SetTextColor(hThstControl, GUI_GREEN);
+        RADIO_SetText(hThstControl, "OFF", 0);
+        RADIO_SetText(hThstControl, "COOLING", 1);
+        RADIO_SetText(hThstControl, "HEATING", 2);
 
-    hThstMaxSetPoint = SPINBOX_CreateEx(settings_screen_1_layout.thst_max_sp_pos.x, settings_screen_1_layout.thst_max_sp_pos.y, settings_screen_1_layout.thst_max_sp_pos.w, settings_screen_1_layout.thst_max_sp_pos.h, 0, WM_CF_SHOW, ID_MaxSetpoint, THST_SP_MIN, THST_SP_MAX);
-    SPINBOX_SetEdge(hThstMaxSetPoint, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hThstMaxSetPoint, Thermostat_Get_SP_Max(pThst));
+        hThstMaxSetPoint = SPINBOX_CreateEx(settings_screen_1_layout.thst_max_sp_pos.x, settings_screen_1_layout.thst_max_sp_pos.y, settings_screen_1_layout.thst_max_sp_pos.w, settings_screen_1_layout.thst_max_sp_pos.h, hPage, WM_CF_SHOW, ID_MaxSetpoint, THST_SP_MIN, THST_SP_MAX);
+        SPINBOX_SetEdge(hThstMaxSetPoint, SPINBOX_EDGE_CENTER);
 
-    hThstMinSetPoint = SPINBOX_CreateEx(settings_screen_1_layout.thst_min_sp_pos.x, settings_screen_1_layout.thst_min_sp_pos.y, settings_screen_1_layout.thst_min_sp_pos.w, settings_screen_1_layout.thst_min_sp_pos.h, 0, WM_CF_SHOW, ID_MinSetpoint, THST_SP_MIN, THST_SP_MAX);
-    SPINBOX_SetEdge(hThstMinSetPoint, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hThstMinSetPoint, Thermostat_Get_SP_Min(pThst));
+        hThstMinSetPoint = SPINBOX_CreateEx(settings_screen_1_layout.thst_min_sp_pos.x, settings_screen_1_layout.thst_min_sp_pos.y, settings_screen_1_layout.thst_min_sp_pos.w, settings_screen_1_layout.thst_min_sp_pos.h, hPage, WM_CF_SHOW, ID_MinSetpoint, THST_SP_MIN, THST_SP_MAX);
+        SPINBOX_SetEdge(hThstMinSetPoint, SPINBOX_EDGE_CENTER);
 
-    /**
-     * @brief Kreiranje widgeta za kontrolu ventilatora.
-     */
-    hFanControl = RADIO_CreateEx(settings_screen_1_layout.fan_control_pos.x, settings_screen_1_layout.fan_control_pos.y, settings_screen_1_layout.fan_control_pos.w, settings_screen_1_layout.fan_control_pos.h, 0, WM_CF_SHOW, 0, ID_FanControl, 2, 20);
-    RADIO_SetTextColor(hFanControl, GUI_GREEN);
-    RADIO_SetText(hFanControl, "ON / OFF", 0);
-    RADIO_SetText(hFanControl, "3 SPEED", 1);
-    RADIO_SetValue(hFanControl, Thermostat_GetFanControlMode(pThst));
+        /**
+         * @brief Kreiranje widgeta za kontrolu ventilatora.
+         */
+        hFanControl = RADIO_CreateEx(settings_screen_1_layout.fan_control_pos.x, settings_screen_1_layout.fan_control_pos.y, settings_screen_1_layout.fan_control_pos.w, settings_screen_1_layout.fan_control_pos.h, hPage, WM_CF_SHOW, 0, ID_FanControl, 2, 20);
+        RADIO_SetTextColor(hFanControl, GUI_GREEN);
+        RADIO_SetText(hFanControl, "ON / OFF", 0);
+        RADIO_SetText(hFanControl, "3 SPEED", 1);
 
-    hFanDiff = SPINBOX_CreateEx(settings_screen_1_layout.fan_diff_pos.x, settings_screen_1_layout.fan_diff_pos.y, settings_screen_1_layout.fan_diff_pos.w, settings_screen_1_layout.fan_diff_pos.h, 0, WM_CF_SHOW, ID_FanDiff, 0, 10);
-    SPINBOX_SetEdge(hFanDiff, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hFanDiff, Thermostat_GetFanDifference(pThst));
+        hFanDiff = SPINBOX_CreateEx(settings_screen_1_layout.fan_diff_pos.x, settings_screen_1_layout.fan_diff_pos.y, settings_screen_1_layout.fan_diff_pos.w, settings_screen_1_layout.fan_diff_pos.h, hPage, WM_CF_SHOW, ID_FanDiff, 0, 10);
+        SPINBOX_SetEdge(hFanDiff, SPINBOX_EDGE_CENTER);
 
-    hFanLowBand = SPINBOX_CreateEx(settings_screen_1_layout.fan_low_band_pos.x, settings_screen_1_layout.fan_low_band_pos.y, settings_screen_1_layout.fan_low_band_pos.w, settings_screen_1_layout.fan_low_band_pos.h, 0, WM_CF_SHOW, ID_FanLowBand, 0, 50);
-    SPINBOX_SetEdge(hFanLowBand, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hFanLowBand, Thermostat_GetFanLowBand(pThst));
+        hFanLowBand = SPINBOX_CreateEx(settings_screen_1_layout.fan_low_band_pos.x, settings_screen_1_layout.fan_low_band_pos.y, settings_screen_1_layout.fan_low_band_pos.w, settings_screen_1_layout.fan_low_band_pos.h, hPage, WM_CF_SHOW, ID_FanLowBand, 0, 50);
+        SPINBOX_SetEdge(hFanLowBand, SPINBOX_EDGE_CENTER);
 
-    hFanHiBand = SPINBOX_CreateEx(settings_screen_1_layout.fan_hi_band_pos.x, settings_screen_1_layout.fan_hi_band_pos.y, settings_screen_1_layout.fan_hi_band_pos.w, settings_screen_1_layout.fan_hi_band_pos.h, 0, WM_CF_SHOW, ID_FanHiBand, 0, 100);
-    SPINBOX_SetEdge(hFanHiBand, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hFanHiBand, Thermostat_GetFanHighBand(pThst));
+        hFanHiBand = SPINBOX_CreateEx(settings_screen_1_layout.fan_hi_band_pos.x, settings_screen_1_layout.fan_hi_band_pos.y, settings_screen_1_layout.fan_hi_band_pos.w, settings_screen_1_layout.fan_hi_band_pos.h, hPage, WM_CF_SHOW, ID_FanHiBand, 0, 100);
+        SPINBOX_SetEdge(hFanHiBand, SPINBOX_EDGE_CENTER);
 
-    /**
-     * @brief Kreiranje widgeta za grupni rad termostata.
-     */
-    hThstGroup = SPINBOX_CreateEx(settings_screen_1_layout.thst_group_pos.x, settings_screen_1_layout.thst_group_pos.y, settings_screen_1_layout.thst_group_pos.w, settings_screen_1_layout.thst_group_pos.h, 0, WM_CF_SHOW, ID_THST_GROUP, 0, 254);
-    SPINBOX_SetEdge(hThstGroup, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hThstGroup, Thermostat_GetGroup(pThst));
+        /**
+         * @brief Kreiranje widgeta za grupni rad termostata.
+         */
+        hThstGroup = SPINBOX_CreateEx(settings_screen_1_layout.thst_group_pos.x, settings_screen_1_layout.thst_group_pos.y, settings_screen_1_layout.thst_group_pos.w, settings_screen_1_layout.thst_group_pos.h, hPage, WM_CF_SHOW, ID_THST_GROUP, 0, 254);
+        SPINBOX_SetEdge(hThstGroup, SPINBOX_EDGE_CENTER);
 
-    // << ISPRAVKA: Dodat je 7. argument (ExFlags) sa vrijednošću 0. >>
-    hThstMaster = CHECKBOX_CreateEx(settings_screen_1_layout.thst_master_pos.x, settings_screen_1_layout.thst_master_pos.y, settings_screen_1_layout.thst_master_pos.w, settings_screen_1_layout.thst_master_pos.h, 0, WM_CF_SHOW, 0, ID_THST_MASTER);
-    CHECKBOX_SetTextColor(hThstMaster, GUI_GREEN);
-    CHECKBOX_SetText(hThstMaster, "Master");
-    CHECKBOX_SetState(hThstMaster, Thermostat_IsMaster(pThst));
+        // << ISPRAVKA: Dodat je 7. argument (ExFlags) sa vrijednošću 0. >>
+        hThstMaster = CHECKBOX_CreateEx(settings_screen_1_layout.thst_master_pos.x, settings_screen_1_layout.thst_master_pos.y, settings_screen_1_layout.thst_master_pos.w, settings_screen_1_layout.thst_master_pos.h, hPage, WM_CF_SHOW, 0, ID_THST_MASTER);
+        CHECKBOX_SetTextColor(hThstMaster, GUI_GREEN);
+        CHECKBOX_SetText(hThstMaster, "Master");
 
-    /**
-     * @brief Kreiranje navigacionih dugmadi.
-     */
-    hBUTTON_Next = BUTTON_CreateEx(settings_screen_1_layout.next_button_pos.x, settings_screen_1_layout.next_button_pos.y, settings_screen_1_layout.next_button_pos.w, settings_screen_1_layout.next_button_pos.h, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
-    hBUTTON_Ok = BUTTON_CreateEx(settings_screen_1_layout.save_button_pos.x, settings_screen_1_layout.save_button_pos.y, settings_screen_1_layout.save_button_pos.w, settings_screen_1_layout.save_button_pos.h, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
+        /**
+         * @brief Kreiranje navigacionih dugmadi.
+         */
+        hBUTTON_Next = BUTTON_CreateEx(settings_screen_1_layout.next_button_pos.x, settings_screen_1_layout.next_button_pos.y, settings_screen_1_layout.next_button_pos.w, settings_screen_1_layout.next_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
+        hBUTTON_Ok = BUTTON_CreateEx(settings_screen_1_layout.save_button_pos.x, settings_screen_1_layout.save_button_pos.y, settings_screen_1_layout.save_button_pos.w, settings_screen_1_layout.save_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    }
+
+    /** @brief Vrijednosti se učitavaju iz modela pri svakom ulasku na stranicu. */
+    RADIO_SetValue(hThstControl, Thermostat_GetControlMode(pThst));
+    SPINBOX_SetValue(hThstMaxSetPoint, Thermostat_Get_SP_Max(pThst));
+    SPINBOX_SetValue(hThstMinSetPoint, Thermostat_Get_SP_Min(pThst));
+    RADIO_SetValue(hFanControl, Thermostat_GetFanControlMode(pThst));
+    SPINBOX_SetValue(hFanDiff, Thermostat_GetFanDifference(pThst));
+    SPINBOX_SetValue(hFanLowBand, Thermostat_GetFanLowBand(pThst));
+    SPINBOX_SetValue(hFanHiBand, Thermostat_GetFanHighBand(pThst));
+    SPINBOX_SetValue(hThstGroup, Thermostat_GetGroup(pThst));
+    CHECKBOX_SetState(hThstMaster, Thermostat_IsMaster(pThst));
 
     /**
      * @brief Iscrtavanje tekstualnih labela i linija.
      * @note  Sve pozicije se dobijaju iz `settings_screen_1_layout` strukture.
+     * Labele se iscrtavaju samo pri prvom ulasku, a nakon toga se vraćaju
+     * iz SDRAM keša jednim DMA2D prenosom. Widgeti se iscrtavaju tek u
+     * `GUI_Exec`, pa u keš ulaze samo labele i linije.
      */
-    GUI_SetColor(GUI_WHITE);
-    GUI_SetFont(GUI_FONT_13_1);
-    GUI_SetTextAlign(GUI_TA_LEFT|GUI_TA_VCENTER);
+    const uint32_t bkg_key = DISP_BkgCacheKey(BKG_SLOT_SETTINGS_1);
+    if (!DISP_BkgCacheRestore(BKG_SLOT_SETTINGS_1, 1, bkg_key)) {
+        GUI_SetColor(GUI_WHITE);
+        GUI_SetFont(GUI_FONT_13_1);
+        GUI_SetTextAlign(GUI_TA_LEFT|GUI_TA_VCENTER);
 
-    GUI_GotoXY(settings_screen_1_layout.label_thst_max_sp[0].x, settings_screen_1_layout.label_thst_max_sp[0].y);
-    GUI_DispString("MAX. USER SETPOINT");
-    GUI_GotoXY(settings_screen_1_layout.label_thst_max_sp[1].x, settings_screen_1_layout.label_thst_max_sp[1].y);
-    GUI_DispString("TEMP. x1*C");
+        GUI_GotoXY(settings_screen_1_layout.label_thst_max_sp[0].x, settings_screen_1_layout.label_thst_max_sp[0].y);
+        GUI_DispString("MAX. USER SETPOINT");
+        GUI_GotoXY(settings_screen_1_layout.label_thst_max_sp[1].x, settings_screen_1_layout.label_thst_max_sp[1].y);
+        GUI_DispString("TEMP. x1*C");
 
-    GUI_GotoXY(settings_screen_1_layout.label_thst_min_sp[0].x, settings_screen_1_layout.label_thst_min_sp[0].y);
-    GUI_DispString("MIN. USER SETPOINT");
-    GUI_GotoXY(settings_screen_1_layout.label_thst_min_sp[1].x, settings_screen_1_layout.label_thst_min_sp[1].y);
-    GUI_DispString("TEMP. x1*C");
+        GUI_GotoXY(settings_screen_1_layout.label_thst_min_sp[0].x, settings_screen_1_layout.label_thst_min_sp[0].y);
+        GUI_DispString("MIN. USER SETPOINT");
+        GUI_GotoXY(settings_screen_1_layout.label_thst_min_sp[1].x, settings_screen_1_layout.label_thst_min_sp[1].y);
+        GUI_DispString("TEMP. x1*C");
 
-    GUI_GotoXY(settings_screen_1_layout.label_fan_diff[0].x, settings_screen_1_layout.label_fan_diff[0].y);
-    GUI_DispString("FAN SPEED DIFFERENCE");
-    GUI_GotoXY(settings_screen_1_layout.label_fan_diff[1].x, settings_screen_1_layout.label_fan_diff[1].y);
-    GUI_DispString("TEMP. x0.1*C");
+        GUI_GotoXY(settings_screen_1_layout.label_fan_diff[0].x, settings_screen_1_layout.label_fan_diff[0].y);
+        GUI_DispString("FAN SPEED DIFFERENCE");
+        GUI_GotoXY(settings_screen_1_layout.label_fan_diff[1].x, settings_screen_1_layout.label_fan_diff[1].y);
+        GUI_DispString("TEMP. x0.1*C");
 
-    GUI_GotoXY(settings_screen_1_layout.label_fan_low[0].x, settings_screen_1_layout.label_fan_low[0].y);
-    GUI_DispString("FAN LOW SPEED BAND");
-    GUI_GotoXY(settings_screen_1_layout.label_fan_low[1].x, settings_screen_1_layout.label_fan_low[1].y);
-    GUI_DispString("SETPOINT +/- x0.1*C");
+        GUI_GotoXY(settings_screen_1_layout.label_fan_low[0].x, settings_screen_1_layout.label_fan_low[0].y);
+        GUI_DispString("FAN LOW SPEED BAND");
+        GUI_GotoXY(settings_screen_1_layout.label_fan_low[1].x, settings_screen_1_layout.label_fan_low[1].y);
+        GUI_DispString("SETPOINT +/- x0.1*C");
 
-    GUI_GotoXY(settings_screen_1_layout.label_fan_hi[0].x, settings_screen_1_layout.label_fan_hi[0].y);
-    GUI_DispString("FAN HI SPEED BAND");
-    GUI_GotoXY(settings_screen_1_layout.label_fan_hi[1].x, settings_screen_1_layout.label_fan_hi[1].y);
-    GUI_DispString("SETPOINT +/- x0.1*C");
+        GUI_GotoXY(settings_screen_1_layout.label_fan_hi[0].x, settings_screen_1_layout.label_fan_hi[0].y);
+        GUI_DispString("FAN HI SPEED BAND");
+        GUI_GotoXY(settings_screen_1_layout.label_fan_hi[1].x, settings_screen_1_layout.label_fan_hi[1].y);
+        GUI_DispString("SETPOINT +/- x0.1*C");
 
-    GUI_GotoXY(settings_screen_1_layout.label_thst_ctrl_title.x, settings_screen_1_layout.label_thst_ctrl_title.y);
-    GUI_DispString("THERMOSTAT CONTROL MODE");
+        GUI_GotoXY(settings_screen_1_layout.label_thst_ctrl_title.x, settings_screen_1_layout.label_thst_ctrl_title.y);
+        GUI_DispString("THERMOSTAT CONTROL MODE");
 
-    GUI_GotoXY(settings_screen_1_layout.label_fan_ctrl_title.x, settings_screen_1_layout.label_fan_ctrl_title.y);
-    GUI_DispString("FAN SPEED CONTROL MODE");
+        GUI_GotoXY(settings_screen_1_layout.label_fan_ctrl_title.x, settings_screen_1_layout.label_fan_ctrl_title.y);
+        GUI_DispString("FAN SPEED CONTROL MODE");
 
-    GUI_GotoXY(settings_screen_1_layout.label_thst_group.x, settings_screen_1_layout.label_thst_group.y);
-    GUI_DispString("GROUP");
+        GUI_GotoXY(settings_screen_1_layout.label_thst_group.x, settings_screen_1_layout.label_thst_group.y);
+        GUI_DispString("GROUP");
 
-    GUI_DrawHLine(12, 5, 320);
-    GUI_DrawHLine(130, 5, 320);
+        GUI_DrawHLine(12, 5, 320);
+        GUI_DrawHLine(130, 5, 320);
+        DISP_BkgCacheStore(BKG_SLOT_SETTINGS_1, 1, bkg_key);
+    }
 
     GUI_MULTIBUF_EndEx(1);
 }
 
 /**
- * @brief Briše GUI widgete sa prvog ekrana podešavanja.
- * @note Ova funkcija se poziva pre prelaska na novi ekran kako bi se oslobodila
- * memorija i spriječili konflikti sa novim widgetima.
+ * @brief Sakriva GUI widgete sa prvog ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet1Scrn(void)
 {
-    WM_DeleteWindow(hThstControl);
-    WM_DeleteWindow(hFanControl);
-    WM_DeleteWindow(hThstMaxSetPoint);
-    WM_DeleteWindow(hThstMinSetPoint);
-    WM_DeleteWindow(hFanDiff);
-    WM_DeleteWindow(hFanLowBand);
-    WM_DeleteWindow(hFanHiBand);
-    WM_DeleteWindow(hThstGroup);
-    WM_DeleteWindow(hThstMaster);
-    WM_DeleteWindow(hBUTTON_Ok);
-    WM_DeleteWindow(hBUTTON_Next);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_1);
 }
 
 /**
@@ -3864,77 +4248,82 @@ static void DSP_InitSet2Scrn(void)
     HAL_RTC_GetDate(&hrtc, &rtcdt, RTC_FORMAT_BCD);
 
     /** @brief Kreiranje svih widgeta koristeći pozicije iz `settings_screen_2_layout`. */
-    hSPNBX_DisplayHighBrightness = SPINBOX_CreateEx(settings_screen_2_layout.high_brightness_pos.x, settings_screen_2_layout.high_brightness_pos.y, settings_screen_2_layout.high_brightness_pos.w, settings_screen_2_layout.high_brightness_pos.h, 0, WM_CF_SHOW, ID_DisplayHighBrightness, 1, 90);
-    SPINBOX_SetEdge(hSPNBX_DisplayHighBrightness, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_DisplayHighBrightness, g_display_settings.high_bcklght);
-
-    hSPNBX_DisplayLowBrightness = SPINBOX_CreateEx(settings_screen_2_layout.low_brightness_pos.x, settings_screen_2_layout.low_brightness_pos.y, settings_screen_2_layout.low_brightness_pos.w, settings_screen_2_layout.low_brightness_pos.h, 0, WM_CF_SHOW, ID_DisplayLowBrightness, 1, 90);
-    SPINBOX_SetEdge(hSPNBX_DisplayLowBrightness, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_DisplayLowBrightness, g_display_settings.low_bcklght);
+    WM_HWIN hPage;
+    if (DSP_SettingsPageOpen(SCREEN_SETTINGS_2, g_display_settings.language, &hPage)) {
+        hSPNBX_DisplayHighBrightness = SPINBOX_CreateEx(settings_screen_2_layout.high_brightness_pos.x, settings_screen_2_layout.high_brightness_pos.y, settings_screen_2_layout.high_brightness_pos.w, settings_screen_2_layout.high_brightness_pos.h, hPage, WM_CF_SHOW, ID_DisplayHighBrightness, 1, 90);
+        SPINBOX_SetEdge(hSPNBX_DisplayHighBrightness, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_ScrnsvrTimeout = SPINBOX_CreateEx(settings_screen_2_layout.scrnsvr_timeout_pos.x, settings_screen_2_layout.scrnsvr_timeout_pos.y, settings_screen_2_layout.scrnsvr_timeout_pos.w, settings_screen_2_layout.scrnsvr_timeout_pos.h, 0, WM_CF_SHOW, ID_ScrnsvrTimeout, 1, 240);
-    SPINBOX_SetEdge(hSPNBX_ScrnsvrTimeout, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_ScrnsvrTimeout, g_display_settings.scrnsvr_tout);
+        hSPNBX_DisplayLowBrightness = SPINBOX_CreateEx(settings_screen_2_layout.low_brightness_pos.x, settings_screen_2_layout.low_brightness_pos.y, settings_screen_2_layout.low_brightness_pos.w, settings_screen_2_layout.low_brightness_pos.h, hPage, WM_CF_SHOW, ID_DisplayLowBrightness, 1, 90);
+        SPINBOX_SetEdge(hSPNBX_DisplayLowBrightness, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_ScrnsvrEnableHour = SPINBOX_CreateEx(settings_screen_2_layout.scrnsvr_enable_hour_pos.x, settings_screen_2_layout.scrnsvr_enable_hour_pos.y, settings_screen_2_layout.scrnsvr_enable_hour_pos.w, settings_screen_2_layout.scrnsvr_enable_hour_pos.h, 0, WM_CF_SHOW, ID_ScrnsvrEnableHour, 0, 23);
-    SPINBOX_SetEdge(hSPNBX_ScrnsvrEnableHour, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_ScrnsvrEnableHour, g_display_settings.scrnsvr_ena_hour);
+        hSPNBX_ScrnsvrTimeout = SPINBOX_CreateEx(settings_screen_2_layout.scrnsvr_timeout_pos.x, settings_screen_2_layout.scrnsvr_timeout_pos.y, settings_screen_2_layout.scrnsvr_timeout_pos.w, settings_screen_2_layout.scrnsvr_timeout_pos.h, hPage, WM_CF_SHOW, ID_ScrnsvrTimeout, 1, 240);
+        SPINBOX_SetEdge(hSPNBX_ScrnsvrTimeout, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_ScrnsvrDisableHour = SPINBOX_CreateEx(settings_screen_2_layout.scrnsvr_disable_hour_pos.x, settings_screen_2_layout.scrnsvr_disable_hour_pos.y, settings_screen_2_layout.scrnsvr_disable_hour_pos.w, settings_screen_2_layout.scrnsvr_disable_hour_pos.h, 0, WM_CF_SHOW, ID_ScrnsvrDisableHour, 0, 23);
-    SPINBOX_SetEdge(hSPNBX_ScrnsvrDisableHour, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_ScrnsvrDisableHour, g_display_settings.scrnsvr_dis_hour);
+        hSPNBX_ScrnsvrEnableHour = SPINBOX_CreateEx(settings_screen_2_layout.scrnsvr_enable_hour_pos.x, settings_screen_2_layout.scrnsvr_enable_hour_pos.y, settings_screen_2_layout.scrnsvr_enable_hour_pos.w, settings_screen_2_layout.scrnsvr_enable_hour_pos.h, hPage, WM_CF_SHOW, ID_ScrnsvrEnableHour, 0, 23);
+        SPINBOX_SetEdge(hSPNBX_ScrnsvrEnableHour, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_Hour = SPINBOX_CreateEx(settings_screen_2_layout.hour_pos.x, settings_screen_2_layout.hour_pos.y, settings_screen_2_layout.hour_pos.w, settings_screen_2_layout.hour_pos.h, 0, WM_CF_SHOW, ID_Hour, 0, 23);
-    SPINBOX_SetEdge(hSPNBX_Hour, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_Hour, Bcd2Dec(rtctm.Hours));
+        hSPNBX_ScrnsvrDisableHour = SPINBOX_CreateEx(settings_screen_2_layout.scrnsvr_disable_hour_pos.x, settings_screen_2_layout.scrnsvr_disable_hour_pos.y, settings_screen_2_layout.scrnsvr_disable_hour_pos.w, settings_screen_2_layout.scrnsvr_disable_hour_pos.h, hPage, WM_CF_SHOW, ID_ScrnsvrDisableHour, 0, 23);
+        SPINBOX_SetEdge(hSPNBX_ScrnsvrDisableHour, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_Minute = SPINBOX_CreateEx(settings_screen_2_layout.minute_pos.x, settings_screen_2_layout.minute_pos.y, settings_screen_2_layout.minute_pos.w, settings_screen_2_layout.minute_pos.h, 0, WM_CF_SHOW, ID_Minute, 0, 59);
-    SPINBOX_SetEdge(hSPNBX_Minute, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_Minute, Bcd2Dec(rtctm.Minutes));
+        hSPNBX_Hour = SPINBOX_CreateEx(settings_screen_2_layout.hour_pos.x, settings_screen_2_layout.hour_pos.y, settings_screen_2_layout.hour_pos.w, settings_screen_2_layout.hour_pos.h, hPage, WM_CF_SHOW, ID_Hour, 0, 23);
+        SPINBOX_SetEdge(hSPNBX_Hour, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_Day = SPINBOX_CreateEx(settings_screen_2_layout.day_pos.x, settings_screen_2_layout.day_pos.y, settings_screen_2_layout.day_pos.w, settings_screen_2_layout.day_pos.h, 0, WM_CF_SHOW, ID_Day, 1, 31);
-    SPINBOX_SetEdge(hSPNBX_Day, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_Day, Bcd2Dec(rtcdt.Date));
+        hSPNBX_Minute = SPINBOX_CreateEx(settings_screen_2_layout.minute_pos.x, settings_screen_2_layout.minute_pos.y, settings_screen_2_layout.minute_pos.w, settings_screen_2_layout.minute_pos.h, hPage, WM_CF_SHOW, ID_Minute, 0, 59);
+        SPINBOX_SetEdge(hSPNBX_Minute, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_Month = SPINBOX_CreateEx(settings_screen_2_layout.month_pos.x, settings_screen_2_layout.month_pos.y, settings_screen_2_layout.month_pos.w, settings_screen_2_layout.month_pos.h, 0, WM_CF_SHOW, ID_Month, 1, 12);
-    SPINBOX_SetEdge(hSPNBX_Month, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_Month, Bcd2Dec(rtcdt.Month));
+        hSPNBX_Day = SPINBOX_CreateEx(settings_screen_2_layout.day_pos.x, settings_screen_2_layout.day_pos.y, settings_screen_2_layout.day_pos.w, settings_screen_2_layout.day_pos.h, hPage, WM_CF_SHOW, ID_Day, 1, 31);
+        SPINBOX_SetEdge(hSPNBX_Day, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_Year = SPINBOX_CreateEx(settings_screen_2_layout.year_pos.x, settings_screen_2_layout.year_pos.y, settings_screen_2_layout.year_pos.w, settings_screen_2_layout.year_pos.h, 0, WM_CF_SHOW, ID_Year, 2000, 2099);
-    SPINBOX_SetEdge(hSPNBX_Year, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_Year, (Bcd2Dec(rtcdt.Year) + 2000));
+        hSPNBX_Month = SPINBOX_CreateEx(settings_screen_2_layout.month_pos.x, settings_screen_2_layout.month_pos.y, settings_screen_2_layout.month_pos.w, settings_screen_2_layout.month_pos.h, hPage, WM_CF_SHOW, ID_Month, 1, 12);
+        SPINBOX_SetEdge(hSPNBX_Month, SPINBOX_EDGE_CENTER);
 
-    hSPNBX_ScrnsvrClockColour = SPINBOX_CreateEx(settings_screen_2_layout.scrnsvr_color_pos.x, settings_screen_2_layout.scrnsvr_color_pos.y, settings_screen_2_layout.scrnsvr_color_pos.w, settings_screen_2_layout.scrnsvr_color_pos.h, 0, WM_CF_SHOW, ID_ScrnsvrClkColour, 1, COLOR_BSIZE);
-    SPINBOX_SetEdge(hSPNBX_ScrnsvrClockColour, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSPNBX_ScrnsvrClockColour, g_display_settings.scrnsvr_clk_clr);
+        hSPNBX_Year = SPINBOX_CreateEx(settings_screen_2_layout.year_pos.x, settings_screen_2_layout.year_pos.y, settings_screen_2_layout.year_pos.w, settings_screen_2_layout.year_pos.h, hPage, WM_CF_SHOW, ID_Year, 2000, 2099);
+        SPINBOX_SetEdge(hSPNBX_Year, SPINBOX_EDGE_CENTER);
 
-    hCHKBX_ScrnsvrClock = CHECKBOX_CreateEx(settings_screen_2_layout.scrnsvr_checkbox_pos.x, settings_screen_2_layout.scrnsvr_checkbox_pos.y, settings_screen_2_layout.scrnsvr_checkbox_pos.w, settings_screen_2_layout.scrnsvr_checkbox_pos.h, 0, WM_CF_SHOW, 0, ID_ScrnsvrClock);
-    CHECKBOX_SetTextColor(hCHKBX_ScrnsvrClock, GUI_GREEN);
-    CHECKBOX_SetText(hCHKBX_ScrnsvrClock, "SCREENSAVER");
-    // << ISPRAVKA 3: Inicijalizacija se sada vrši iz EEPROM strukture `g_display_settings` >>
-    CHECKBOX_SetState(hCHKBX_ScrnsvrClock, g_display_settings.scrnsvr_on_off);
+        hSPNBX_ScrnsvrClockColour = SPINBOX_CreateEx(settings_screen_2_layout.scrnsvr_color_pos.x, settings_screen_2_layout.scrnsvr_color_pos.y, settings_screen_2_layout.scrnsvr_color_pos.w, settings_screen_2_layout.scrnsvr_color_pos.h, hPage, WM_CF_SHOW, ID_ScrnsvrClkColour, 1, COLOR_BSIZE);
+        SPINBOX_SetEdge(hSPNBX_ScrnsvrClockColour, SPINBOX_EDGE_CENTER);
 
-    hDRPDN_WeekDay = DROPDOWN_CreateEx(settings_screen_2_layout.weekday_dropdown_pos.x, settings_screen_2_layout.weekday_dropdown_pos.y, settings_screen_2_layout.weekday_dropdown_pos.w, settings_screen_2_layout.weekday_dropdown_pos.h, 0, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_WeekDay);
-    /** * @brief << ISPRAVKA: Logika za popunjavanje dropdown menija za dane u sedmici. >>
-     * @note  Petlja sada ispravno iterira 7 puta (za 7 dana) i dodaje stringove
-     * za trenutno odabrani jezik (`g_display_settings.language`).
-     */
-    for (int i = 0; i < 7; i++) {
-        DROPDOWN_AddString(hDRPDN_WeekDay, _acContent[g_display_settings.language][i]);
-    }
-    DROPDOWN_SetSel(hDRPDN_WeekDay, rtcdt.WeekDay - 1);
+        hCHKBX_ScrnsvrClock = CHECKBOX_CreateEx(settings_screen_2_layout.scrnsvr_checkbox_pos.x, settings_screen_2_layout.scrnsvr_checkbox_pos.y, settings_screen_2_layout.scrnsvr_checkbox_pos.w, settings_screen_2_layout.scrnsvr_checkbox_pos.h, hPage, WM_CF_SHOW, 0, ID_ScrnsvrClock);
+        CHECKBOX_SetTextColor(hCHKBX_ScrnsvrClock, GUI_GREEN);
+        CHECKBOX_SetText(hCHKBX_ScrnsvrClock, "SCREENSAVER");
 
-    hBUTTON_Next = BUTTON_CreateEx(settings_screen_2_layout.next_button_pos.x, settings_screen_2_layout.next_button_pos.y, settings_screen_2_layout.next_button_pos.w, settings_screen_2_layout.next_button_pos.h, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
-    hBUTTON_Ok = BUTTON_CreateEx(settings_screen_2_layout.save_button_pos.x, settings_screen_2_layout.save_button_pos.y, settings_screen_2_layout.save_button_pos.w, settings_screen_2_layout.save_button_pos.h, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
+        hDRPDN_WeekDay = DROPDOWN_CreateEx(settings_screen_2_layout.weekday_dropdown_pos.x, settings_screen_2_layout.weekday_dropdown_pos.y, settings_screen_2_layout.weekday_dropdown_pos.w, settings_screen_2_layout.weekday_dropdown_pos.h, hPage, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_WeekDay);
+        /** * @brief << ISPRAVKA: Logika za popunjavanje dropdown menija za dane u sedmici. >>
+         * @note  Petlja sada ispravno iterira 7 puta (za 7 dana) i dodaje stringove
+         * za trenutno odabrani jezik (`g_display_settings.language`).
+         */
+        for (int i = 0; i < 7; i++) {
+            DROPDOWN_AddString(hDRPDN_WeekDay, _acContent[g_display_settings.language][i]);
+        }
 
-    /** @brief Iscrtavanje labela, linija i pregleda boje, koristeći pozicije iz layout strukture. */
-    GUI_SetColor(clk_clrs[g_display_settings.scrnsvr_clk_clr]);
-    GUI_FillRect(settings_screen_2_layout.scrnsvr_color_preview_rect.x0, settings_screen_2_layout.scrnsvr_color_preview_rect.y0,
-                 settings_screen_2_layout.scrnsvr_color_preview_rect.x1, settings_screen_2_layout.scrnsvr_color_preview_rect.y1);
+        hBUTTON_Next = BUTTON_CreateEx(settings_screen_2_layout.next_button_pos.x, settings_screen_2_layout.next_button_pos.y, settings_screen_2_layout.next_button_pos.w, settings_screen_2_layout.next_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
+        hBUTTON_Ok = BUTTON_CreateEx(settings_screen_2_layout.save_button_pos.x, settings_screen_2_layout.save_button_pos.y, settings_screen_2_layout.save_button_pos.w, settings_screen_2_layout.save_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    }
 
-    GUI_SetColor(GUI_WHITE);
+    /** @brief Vrijednosti se učitavaju iz modela pri svakom ulasku na stranicu. */
+    SPINBOX_SetValue(hSPNBX_DisplayHighBrightness, g_display_settings.high_bcklght);
+    SPINBOX_SetValue(hSPNBX_DisplayLowBrightness, g_display_settings.low_bcklght);
+    SPINBOX_SetValue(hSPNBX_ScrnsvrTimeout, g_display_settings.scrnsvr_tout);
+    SPINBOX_SetValue(hSPNBX_ScrnsvrEnableHour, g_display_settings.scrnsvr_ena_hour);
+    SPINBOX_SetValue(hSPNBX_ScrnsvrDisableHour, g_display_settings.scrnsvr_dis_hour);
+    SPINBOX_SetValue(hSPNBX_Hour, Bcd2Dec(rtctm.Hours));
+    SPINBOX_SetValue(hSPNBX_Minute, Bcd2Dec(rtctm.Minutes));
+    SPINBOX_SetValue(hSPNBX_Day, Bcd2Dec(rtcdt.Date));
+    SPINBOX_SetValue(hSPNBX_Month, Bcd2Dec(rtcdt.Month));
+    SPINBOX_SetValue(hSPNBX_Year, (Bcd2Dec(rtcdt.Year) + 2000));
+    SPINBOX_SetValue(hSPNBX_ScrnsvrClockColour, g_display_settings.scrnsvr_clk_clr);
+    // << ISPRAVKA 3: Inicijalizacija se sada vrši iz EEPROM strukture `g_display_settings` >>
+    CHECKBOX_SetState(hCHKBX_ScrnsvrClock, g_display_settings.scrnsvr_on_off);
+    DROPDOWN_SetSel(hDRPDN_WeekDay, rtcdt.WeekDay - 1);
+
+    /** @brief Iscrtavanje labela, linija i pregleda boje, koristeći pozicije iz layout strukture. */
+    GUI_SetColor(clk_clrs[g_display_settings.scrnsvr_clk_clr]);
+    GUI_FillRect(settings_screen_2_layout.scrnsvr_color_preview_rect.x0, settings_screen_2_layout.scrnsvr_color_preview_rect.y0,
+                 settings_screen_2_layout.scrnsvr_color_preview_rect.x1, settings_screen_2_layout.scrnsvr_color_preview_rect.y1);
+
+    GUI_SetColor(GUI_WHITE);
     GUI_SetFont(GUI_FONT_13_1);
     GUI_SetTextAlign(GUI_TA_LEFT|GUI_TA_VCENTER);
 
@@ -3989,27 +4378,15 @@ static void DSP_InitSet2Scrn(void)
     GUI_MULTIBUF_EndEx(1);
 }
 /**
- * @brief Briše GUI widgete sa drugog ekrana podešavanja.
- * @note Briše sve widgete vezane za vrijeme, datum, screensaver i svjetlinu
- * ekrana.
+ * @brief Sakriva GUI widgete sa drugog ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet2Scrn(void)
 {
-    WM_DeleteWindow(hSPNBX_DisplayHighBrightness);
-    WM_DeleteWindow(hSPNBX_DisplayLowBrightness);
-    WM_DeleteWindow(hSPNBX_ScrnsvrDisableHour);
-    WM_DeleteWindow(hSPNBX_ScrnsvrClockColour);
-    WM_DeleteWindow(hSPNBX_ScrnsvrEnableHour);
-    WM_DeleteWindow(hSPNBX_ScrnsvrTimeout);
-    WM_DeleteWindow(hCHKBX_ScrnsvrClock);
-    WM_DeleteWindow(hSPNBX_Minute);
-    WM_DeleteWindow(hSPNBX_Month);
-    WM_DeleteWindow(hBUTTON_Next);
-    WM_DeleteWindow(hSPNBX_Hour);
-    WM_DeleteWindow(hSPNBX_Year);
-    WM_DeleteWindow(hDRPDN_WeekDay);
-    WM_DeleteWindow(hSPNBX_Day);
-    WM_DeleteWindow(hBUTTON_Ok);
+    // Otvorena lista bi ostala visiti iznad sljedećeg ekrana
+    DROPDOWN_Collapse(hDRPDN_WeekDay);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_2);
 }
 /**
  * @brief Inicijalizuje treći ekran podešavanja (ventilator i odmrzivač).
@@ -4030,49 +4407,53 @@ static void DSP_InitSet3Scrn(void)
     GUI_Clear();
     GUI_MULTIBUF_BeginEx(1);
 
+    WM_HWIN hPage;
+    if (DSP_SettingsPageOpen(SCREEN_SETTINGS_3, 0, &hPage)) {
+        /** @brief Kreiranje navigacionih dugmadi. */
+        hBUTTON_Next = BUTTON_CreateEx(settings_screen_3_layout.next_button_pos.x, settings_screen_3_layout.next_button_pos.y, settings_screen_3_layout.next_button_pos.w, settings_screen_3_layout.next_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
+        hBUTTON_Ok = BUTTON_CreateEx(settings_screen_3_layout.save_button_pos.x, settings_screen_3_layout.save_button_pos.y, settings_screen_3_layout.save_button_pos.w, settings_screen_3_layout.save_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
 
-    /** @brief Kreiranje navigacionih dugmadi. */
-    hBUTTON_Next = BUTTON_CreateEx(settings_screen_3_layout.next_button_pos.x, settings_screen_3_layout.next_button_pos.y, settings_screen_3_layout.next_button_pos.w, settings_screen_3_layout.next_button_pos.h, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
-    hBUTTON_Ok = BUTTON_CreateEx(settings_screen_3_layout.save_button_pos.x, settings_screen_3_layout.save_button_pos.y, settings_screen_3_layout.save_button_pos.w, settings_screen_3_layout.save_button_pos.h, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
+        /** @brief Kreiranje widgeta za postavke odmrzivača (Defroster). */
+        defroster_settingWidgets.cycleTime = SPINBOX_CreateEx(settings_screen_3_layout.defroster_cycle_time_pos.x, settings_screen_3_layout.defroster_cycle_time_pos.y, settings_screen_3_layout.defroster_cycle_time_pos.w, settings_screen_3_layout.defroster_cycle_time_pos.h, hPage, WM_CF_SHOW, ID_DEFROSTER_CYCLE_TIME, 0, 254);
+        SPINBOX_SetEdge(defroster_settingWidgets.cycleTime, SPINBOX_EDGE_CENTER);
 
-    /** @brief Kreiranje widgeta za postavke odmrzivača (Defroster). */
-    defroster_settingWidgets.cycleTime = SPINBOX_CreateEx(settings_screen_3_layout.defroster_cycle_time_pos.x, settings_screen_3_layout.defroster_cycle_time_pos.y, settings_screen_3_layout.defroster_cycle_time_pos.w, settings_screen_3_layout.defroster_cycle_time_pos.h, 0, WM_CF_SHOW, ID_DEFROSTER_CYCLE_TIME, 0, 254);
-    SPINBOX_SetEdge(defroster_settingWidgets.cycleTime, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(defroster_settingWidgets.cycleTime, Defroster_getCycleTime(defHandle));
+        defroster_settingWidgets.activeTime = SPINBOX_CreateEx(settings_screen_3_layout.defroster_active_time_pos.x, settings_screen_3_layout.defroster_active_time_pos.y, settings_screen_3_layout.defroster_active_time_pos.w, settings_screen_3_layout.defroster_active_time_pos.h, hPage, WM_CF_SHOW, ID_DEFROSTER_ACTIVE_TIME, 0, 254);
+        SPINBOX_SetEdge(defroster_settingWidgets.activeTime, SPINBOX_EDGE_CENTER);
 
-    defroster_settingWidgets.activeTime = SPINBOX_CreateEx(settings_screen_3_layout.defroster_active_time_pos.x, settings_screen_3_layout.defroster_active_time_pos.y, settings_screen_3_layout.defroster_active_time_pos.w, settings_screen_3_layout.defroster_active_time_pos.h, 0, WM_CF_SHOW, ID_DEFROSTER_ACTIVE_TIME, 0, 254);
-    SPINBOX_SetEdge(defroster_settingWidgets.activeTime, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(defroster_settingWidgets.activeTime, Defroster_getActiveTime(defHandle));
+        defroster_settingWidgets.pin = SPINBOX_CreateEx(settings_screen_3_layout.defroster_pin_pos.x, settings_screen_3_layout.defroster_pin_pos.y, settings_screen_3_layout.defroster_pin_pos.w, settings_screen_3_layout.defroster_pin_pos.h, hPage, WM_CF_SHOW, ID_DEFROSTER_PIN, 0, 6);
+        SPINBOX_SetEdge(defroster_settingWidgets.pin, SPINBOX_EDGE_CENTER);
 
-    defroster_settingWidgets.pin = SPINBOX_CreateEx(settings_screen_3_layout.defroster_pin_pos.x, settings_screen_3_layout.defroster_pin_pos.y, settings_screen_3_layout.defroster_pin_pos.w, settings_screen_3_layout.defroster_pin_pos.h, 0, WM_CF_SHOW, ID_DEFROSTER_PIN, 0, 6);
-    SPINBOX_SetEdge(defroster_settingWidgets.pin, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(defroster_settingWidgets.pin, Defroster_getPin(defHandle));
+        /** @brief Kreiranje widgeta za postavke ventilatora. */
+        hVentilatorRelay = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_relay_pos.x, settings_screen_3_layout.ventilator_relay_pos.y, settings_screen_3_layout.ventilator_relay_pos.w, settings_screen_3_layout.ventilator_relay_pos.h, hPage, WM_CF_SHOW, ID_VentilatorRelay, 0, 512);
+        SPINBOX_SetEdge(hVentilatorRelay, SPINBOX_EDGE_CENTER);
 
-    /** @brief Kreiranje widgeta za postavke ventilatora. */
-    hVentilatorRelay = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_relay_pos.x, settings_screen_3_layout.ventilator_relay_pos.y, settings_screen_3_layout.ventilator_relay_pos.w, settings_screen_3_layout.ventilator_relay_pos.h, 0, WM_CF_SHOW, ID_VentilatorRelay, 0, 512);
-    SPINBOX_SetEdge(hVentilatorRelay, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hVentilatorRelay, Ventilator_getRelay(ventHandle));
+        hVentilatorDelayOn = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_delay_on_pos.x, settings_screen_3_layout.ventilator_delay_on_pos.y, settings_screen_3_layout.ventilator_delay_on_pos.w, settings_screen_3_layout.ventilator_delay_on_pos.h, hPage, WM_CF_SHOW, ID_VentilatorDelayOn, 0, 255);
+        SPINBOX_SetEdge(hVentilatorDelayOn, SPINBOX_EDGE_CENTER);
 
-    hVentilatorDelayOn = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_delay_on_pos.x, settings_screen_3_layout.ventilator_delay_on_pos.y, settings_screen_3_layout.ventilator_delay_on_pos.w, settings_screen_3_layout.ventilator_delay_on_pos.h, 0, WM_CF_SHOW, ID_VentilatorDelayOn, 0, 255);
-    SPINBOX_SetEdge(hVentilatorDelayOn, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hVentilatorDelayOn, Ventilator_getDelayOnTime(ventHandle));
+        hVentilatorDelayOff = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_delay_off_pos.x, settings_screen_3_layout.ventilator_delay_off_pos.y, settings_screen_3_layout.ventilator_delay_off_pos.w, settings_screen_3_layout.ventilator_delay_off_pos.h, hPage, WM_CF_SHOW, ID_VentilatorDelayOff, 0, 255);
+        SPINBOX_SetEdge(hVentilatorDelayOff, SPINBOX_EDGE_CENTER);
 
-    hVentilatorDelayOff = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_delay_off_pos.x, settings_screen_3_layout.ventilator_delay_off_pos.y, settings_screen_3_layout.ventilator_delay_off_pos.w, settings_screen_3_layout.ventilator_delay_off_pos.h, 0, WM_CF_SHOW, ID_VentilatorDelayOff, 0, 255);
-    SPINBOX_SetEdge(hVentilatorDelayOff, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hVentilatorDelayOff, Ventilator_getDelayOffTime(ventHandle));
+        hVentilatorTriggerSource1 = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_trigger1_pos.x, settings_screen_3_layout.ventilator_trigger1_pos.y, settings_screen_3_layout.ventilator_trigger1_pos.w, settings_screen_3_layout.ventilator_trigger1_pos.h, hPage, WM_CF_SHOW, ID_VentilatorTriggerSource1, 0, LIGHTS_MODBUS_SIZE);
+        SPINBOX_SetEdge(hVentilatorTriggerSource1, SPINBOX_EDGE_CENTER);
 
-    hVentilatorTriggerSource1 = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_trigger1_pos.x, settings_screen_3_layout.ventilator_trigger1_pos.y, settings_screen_3_layout.ventilator_trigger1_pos.w, settings_screen_3_layout.ventilator_trigger1_pos.h, 0, WM_CF_SHOW, ID_VentilatorTriggerSource1, 0, 6);
-    SPINBOX_SetEdge(hVentilatorTriggerSource1, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hVentilatorTriggerSource1, Ventilator_getTriggerSource1(ventHandle));
+        hVentilatorTriggerSource2 = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_trigger2_pos.x, settings_screen_3_layout.ventilator_trigger2_pos.y, settings_screen_3_layout.ventilator_trigger2_pos.w, settings_screen_3_layout.ventilator_trigger2_pos.h, hPage, WM_CF_SHOW, ID_VentilatorTriggerSource2, 0, LIGHTS_MODBUS_SIZE);
+        SPINBOX_SetEdge(hVentilatorTriggerSource2, SPINBOX_EDGE_CENTER);
 
-    hVentilatorTriggerSource2 = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_trigger2_pos.x, settings_screen_3_layout.ventilator_trigger2_pos.y, settings_screen_3_layout.ventilator_trigger2_pos.w, settings_screen_3_layout.ventilator_trigger2_pos.h, 0, WM_CF_SHOW, ID_VentilatorTriggerSource2, 0, 6);
-    SPINBOX_SetEdge(hVentilatorTriggerSource2, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hVentilatorTriggerSource2, Ventilator_getTriggerSource2(ventHandle));
+        hVentilatorLocalPin = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_local_pin_pos.x, settings_screen_3_layout.ventilator_local_pin_pos.y, settings_screen_3_layout.ventilator_local_pin_pos.w, settings_screen_3_layout.ventilator_local_pin_pos.h, hPage, WM_CF_SHOW, ID_VentilatorLocalPin, 0, 32);
+        SPINBOX_SetEdge(hVentilatorLocalPin, SPINBOX_EDGE_CENTER);
+    }
 
-    hVentilatorLocalPin = SPINBOX_CreateEx(settings_screen_3_layout.ventilator_local_pin_pos.x, settings_screen_3_layout.ventilator_local_pin_pos.y, settings_screen_3_layout.ventilator_local_pin_pos.w, settings_screen_3_layout.ventilator_local_pin_pos.h, 0, WM_CF_SHOW, ID_VentilatorLocalPin, 0, 32);
-    SPINBOX_SetEdge(hVentilatorLocalPin, SPINBOX_EDGE_CENTER);
+    /** @brief Vrijednosti se učitavaju iz modela pri svakom ulasku na stranicu. */
+    SPINBOX_SetValue(defroster_settingWidgets.cycleTime, Defroster_getCycleTime(defHandle));
+    SPINBOX_SetValue(defroster_settingWidgets.activeTime, Defroster_getActiveTime(defHandle));
+    SPINBOX_SetValue(defroster_settingWidgets.pin, Defroster_getPin(defHandle));
+    SPINBOX_SetValue(hVentilatorRelay, Ventilator_getRelay(ventHandle));
+    SPINBOX_SetValue(hVentilatorDelayOn, Ventilator_getDelayOnTime(ventHandle));
+    SPINBOX_SetValue(hVentilatorDelayOff, Ventilator_getDelayOffTime(ventHandle));
+    SPINBOX_SetValue(hVentilatorTriggerSource1, Ventilator_getTriggerSource1(ventHandle));
+    SPINBOX_SetValue(hVentilatorTriggerSource2, Ventilator_getTriggerSource2(ventHandle));
     SPINBOX_SetValue(hVentilatorLocalPin, Ventilator_getLocalPin(ventHandle));
 
     /** @brief Iscrtavanje labela i linija. */
@@ -4136,22 +4517,13 @@ static void DSP_InitSet3Scrn(void)
     GUI_MULTIBUF_EndEx(1);
 }
 /**
- * @brief Briše GUI widgete sa trećeg ekrana podešavanja.
- * @note Briše sve widgete vezane za postavke ventilatora.
+ * @brief Sakriva GUI widgete sa trećeg ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet3Scrn(void)
 {
-    WM_DeleteWindow(defroster_settingWidgets.cycleTime);
-    WM_DeleteWindow(defroster_settingWidgets.activeTime);
-    WM_DeleteWindow(defroster_settingWidgets.pin);
-    WM_DeleteWindow(hVentilatorRelay);
-    WM_DeleteWindow(hVentilatorDelayOn);
-    WM_DeleteWindow(hVentilatorDelayOff);
-    WM_DeleteWindow(hVentilatorTriggerSource1);
-    WM_DeleteWindow(hVentilatorTriggerSource2);
-    WM_DeleteWindow(hVentilatorLocalPin);
-    WM_DeleteWindow(hBUTTON_Next);
-    WM_DeleteWindow(hBUTTON_Ok);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_3);
 }
 
 /**
@@ -4172,12 +4544,20 @@ static void DSP_InitSet4Scrn(void)
     GUI_Clear();
     GUI_MULTIBUF_BeginEx(1);
 
+    /**
+     * @brief Widgeti se kreiraju samo pri prvom ulasku na podstranicu.
+     * @note  `curtainSettingMenu` je ključ varijante, pa se kontejner
+     * ponovo gradi samo kada se promijeni podstranica zavjesa.
+     */
+    WM_HWIN hPage;
+    const bool create = DSP_SettingsPageOpen(SCREEN_SETTINGS_4, curtainSettingMenu, &hPage);
+
     /**
      * @brief Petlja za kreiranje widgeta.
      * @note  Iterira kroz 4 roletne relevantne za trenutnu stranicu menija
      * (`curtainSettingMenu`).
      */
-    for(uint8_t i = curtainSettingMenu * 4; i < (((CURTAINS_SIZE - (curtainSettingMenu * 4)) >= 4) ? ((curtainSettingMenu * 4) + 4) : CURTAINS_SIZE); i++) {
+    for(uint8_t i = curtainSettingMenu * CURTAINS_PER_SETTINGS_PAGE; i < (((CURTAINS_SIZE - (curtainSettingMenu * CURTAINS_PER_SETTINGS_PAGE)) >= CURTAINS_PER_SETTINGS_PAGE) ? ((curtainSettingMenu * CURTAINS_PER_SETTINGS_PAGE) + CURTAINS_PER_SETTINGS_PAGE) : CURTAINS_SIZE); i++) {
 
         /** @brief Dobijamo handle za roletnu po njenom fizičkom indeksu u nizu. */
         Curtain_Handle* handle = Curtain_GetInstanceByIndex(i);
@@ -4186,25 +4566,27 @@ static void DSP_InitSet4Scrn(void)
          * @brief Dinamičko izračunavanje pozicija za trenutnu roletnu u mreži.
          * @note  Ova logika postavlja widgete u dvije kolone i dva reda.
          */
-        int col = ((i % 4) < 2) ? 0 : 1; // 0 za prvu kolonu, 1 za drugu
-        int row = (i % 4) % 2;          // 0 za prvi red, 1 za drugi
+        int col = ((i % CURTAINS_PER_SETTINGS_PAGE) < 2) ? 0 : 1; // 0 za prvu kolonu, 1 za drugu
+        int row = (i % CURTAINS_PER_SETTINGS_PAGE) % 2;          // 0 za prvi red, 1 za drugi
         int x = settings_screen_4_layout.grid_start_pos.x + (col * settings_screen_4_layout.x_col_spacing);
         int y = settings_screen_4_layout.grid_start_pos.y + (row * settings_screen_4_layout.y_group_spacing);
 
-        /**
-         * @brief Kreiranje SPINBOX-a za relej "GORE".
-         * @note  Poziv `SPINBOX_CreateEx` ima 9 argumenata.
-         */
-        hCurtainsRelay[i * 2] = SPINBOX_CreateEx(x, y, settings_screen_4_layout.widget_width, settings_screen_4_layout.widget_height, 0, WM_CF_SHOW, ID_CurtainsRelay + (i * 2), 0, 512);
-        SPINBOX_SetEdge(hCurtainsRelay[i * 2], SPINBOX_EDGE_CENTER);
-        SPINBOX_SetValue(hCurtainsRelay[i * 2], Curtain_getRelayUp(handle));
+        if (create) {
+            /**
+             * @brief Kreiranje SPINBOX-a za relej "GORE".
+             * @note  Poziv `SPINBOX_CreateEx` ima 9 argumenata.
+             */
+            hCurtainsRelay[i * 2] = SPINBOX_CreateEx(x, y, settings_screen_4_layout.widget_width, settings_screen_4_layout.widget_height, hPage, WM_CF_SHOW, ID_CurtainsRelay + ((i % CURTAINS_PER_SETTINGS_PAGE) * 2), 0, 512);
+            SPINBOX_SetEdge(hCurtainsRelay[i * 2], SPINBOX_EDGE_CENTER);
 
-        /**
-         * @brief Kreiranje SPINBOX-a za relej "DOLJE".
-         * @note  Pozicija se računa na osnovu pozicije "GORE" widgeta i `y_row_spacing` konstante.
-         */
-        hCurtainsRelay[(i * 2) + 1] = SPINBOX_CreateEx(x, y + settings_screen_4_layout.y_row_spacing, settings_screen_4_layout.widget_width, settings_screen_4_layout.widget_height, 0, WM_CF_SHOW, ID_CurtainsRelay + (i * 2) + 1, 0, 512);
-        SPINBOX_SetEdge(hCurtainsRelay[(i * 2) + 1], SPINBOX_EDGE_CENTER);
+            /**
+             * @brief Kreiranje SPINBOX-a za relej "DOLJE".
+             * @note  Pozicija se računa na osnovu pozicije "GORE" widgeta i `y_row_spacing` konstante.
+             */
+            hCurtainsRelay[(i * 2) + 1] = SPINBOX_CreateEx(x, y + settings_screen_4_layout.y_row_spacing, settings_screen_4_layout.widget_width, settings_screen_4_layout.widget_height, hPage, WM_CF_SHOW, ID_CurtainsRelay + ((i % CURTAINS_PER_SETTINGS_PAGE) * 2) + 1, 0, 512);
+            SPINBOX_SetEdge(hCurtainsRelay[(i * 2) + 1], SPINBOX_EDGE_CENTER);
+        }
+        SPINBOX_SetValue(hCurtainsRelay[i * 2], Curtain_getRelayUp(handle));
         SPINBOX_SetValue(hCurtainsRelay[(i * 2) + 1], Curtain_getRelayDown(handle));
 
         /**
@@ -4234,31 +4616,23 @@ static void DSP_InitSet4Scrn(void)
      * @brief Kreiranje navigacionih dugmadi.
      * @note  Pozivi `BUTTON_CreateEx` imaju 8 argumenata.
      */
-    hBUTTON_Next = BUTTON_CreateEx(settings_screen_4_layout.next_button_pos.x, settings_screen_4_layout.next_button_pos.y, settings_screen_4_layout.next_button_pos.w, settings_screen_4_layout.next_button_pos.h, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
-    hBUTTON_Ok = BUTTON_CreateEx(settings_screen_4_layout.save_button_pos.x, settings_screen_4_layout.save_button_pos.y, settings_screen_4_layout.save_button_pos.w, settings_screen_4_layout.save_button_pos.h, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    if (create) {
+        hBUTTON_Next = BUTTON_CreateEx(settings_screen_4_layout.next_button_pos.x, settings_screen_4_layout.next_button_pos.y, settings_screen_4_layout.next_button_pos.w, settings_screen_4_layout.next_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
+        hBUTTON_Ok = BUTTON_CreateEx(settings_screen_4_layout.save_button_pos.x, settings_screen_4_layout.save_button_pos.y, settings_screen_4_layout.save_button_pos.w, settings_screen_4_layout.save_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    }
 
     GUI_MULTIBUF_EndEx(1);
 }
 /**
- * @brief Briše GUI widgete sa četvrtog ekrana podešavanja.
- * @note Briše dinamički kreirane widgete za zavjese na trenutnoj stranici.
+ * @brief Sakriva GUI widgete sa četvrtog ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet4Scrn(void)
 {
-    for(uint8_t i = curtainSettingMenu * 4; i < (((CURTAINS_SIZE - (curtainSettingMenu * 4)) >= 4) ? ((curtainSettingMenu * 4) + 4) : CURTAINS_SIZE); i++) {
-        if(hCurtainsRelay[i * 2]) { // Provjeri da li widget postoji
-            WM_DeleteWindow(hCurtainsRelay[i * 2]);
-            hCurtainsRelay[i * 2] = 0; // Resetuj handle
-        }
-        if(hCurtainsRelay[(i * 2) + 1]) { // Provjeri da li widget postoji
-            WM_DeleteWindow(hCurtainsRelay[(i * 2) + 1]);
-            hCurtainsRelay[(i * 2) + 1] = 0; // Resetuj handle
-        }
-    }
-    WM_DeleteWindow(hBUTTON_Next);
-    WM_DeleteWindow(hBUTTON_Ok);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_4);
 }
 
 /**
@@ -4295,73 +4669,76 @@ static void DSP_InitSet5Scrn(void)
     int16_t y = settings_screen_5_layout.start_y;
     int16_t y_step = settings_screen_5_layout.y_step;
 
-    // << ISPRAVKA 2: Promijenjen množilac za ID-jeve sa 12 na 16 radi izbjegavanja preklapanja >>
-    const int id_step = 16;
-
-    // << ISPRAVKA 1: Vraćena linija za kreiranje RELAY spinbox-a >>
-    lightsWidgets[light_index].relay = SPINBOX_CreateEx(x, y, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 0, 0, 512);
-
-    // << ISPRAVKA 1: Opseg za IconID je sada ispravan i nema duplirane linije >>
-    uint16_t max_icon_id = (sizeof(icon_mapping_table) / sizeof(IconMapping_t)) - 1;
-    lightsWidgets[light_index].iconID = SPINBOX_CreateEx(x, y + 1 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 1, 0, max_icon_id);
-
-    lightsWidgets[light_index].controllerID_on = SPINBOX_CreateEx(x, y + 2 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 2, 0, 512);
-    lightsWidgets[light_index].controllerID_on_delay  = SPINBOX_CreateEx(x, y + 3 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 3, 0, 255);
-    lightsWidgets[light_index].on_hour = SPINBOX_CreateEx(x, y + 4 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 4, -1, 23);
-    lightsWidgets[light_index].on_minute = SPINBOX_CreateEx(x, y + 5 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 5, 0, 59);
-
-    x = settings_screen_5_layout.col2_x;
-
-    lightsWidgets[light_index].offTime = SPINBOX_CreateEx(x, y, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 6, 0, 255);
-    lightsWidgets[light_index].communication_type = SPINBOX_CreateEx(x, y + 1 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 7, 1, 3);
-    lightsWidgets[light_index].local_pin = SPINBOX_CreateEx(x, y + 2 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 8, 0, 32);
-    lightsWidgets[light_index].sleep_time = SPINBOX_CreateEx(x, y + 3 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 9, 0, 255);
-    lightsWidgets[light_index].button_external = SPINBOX_CreateEx(x, y + 4 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_LightsModbusRelay + (light_index * id_step) + 10, 0, 3);
-
-    const WidgetRect_t* cb1_size = &settings_screen_5_layout.checkbox1_size;
-    lightsWidgets[light_index].tiedToMainLight = CHECKBOX_CreateEx(x, y + 5 * y_step, cb1_size->w, cb1_size->h, 0, WM_CF_SHOW, 0, ID_LightsModbusRelay + (light_index * id_step) + 11);
-
-    const WidgetRect_t* cb2_size = &settings_screen_5_layout.checkbox2_size;
-    lightsWidgets[light_index].rememberBrightness = CHECKBOX_CreateEx(x, y + 5 * y_step + 23, cb2_size->w, cb2_size->h, 0, WM_CF_SHOW, 0, ID_LightsModbusRelay + (light_index * id_step) + 12);
-
-    /** @brief Postavljanje početnih vrijednosti za sve kreirane widgete. */
-    SPINBOX_SetEdge(lightsWidgets[light_index].relay, SPINBOX_EDGE_CENTER);
+    // ID-jevi su relativni na stranicu: kontejner stranice uvijek nosi samo jedno svjetlo
+    WM_HWIN hPage;
+    if (DSP_SettingsPageOpen(SCREEN_SETTINGS_5, light_index, &hPage)) {
+        // << ISPRAVKA 1: Vraćena linija za kreiranje RELAY spinbox-a >>
+        lightsWidgets[light_index].relay = SPINBOX_CreateEx(x, y, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 0, 0, 512);
+
+        // << ISPRAVKA 1: Opseg za IconID je sada ispravan i nema duplirane linije >>
+        uint16_t max_icon_id = (sizeof(icon_mapping_table) / sizeof(IconMapping_t)) - 1;
+        lightsWidgets[light_index].iconID = SPINBOX_CreateEx(x, y + 1 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 1, 0, max_icon_id);
+
+        lightsWidgets[light_index].controllerID_on = SPINBOX_CreateEx(x, y + 2 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 2, 0, 512);
+        lightsWidgets[light_index].controllerID_on_delay  = SPINBOX_CreateEx(x, y + 3 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 3, 0, 255);
+        lightsWidgets[light_index].on_hour = SPINBOX_CreateEx(x, y + 4 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 4, -1, 23);
+        lightsWidgets[light_index].on_minute = SPINBOX_CreateEx(x, y + 5 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 5, 0, 59);
+
+        x = settings_screen_5_layout.col2_x;
+
+        lightsWidgets[light_index].offTime = SPINBOX_CreateEx(x, y, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 6, 0, 255);
+        lightsWidgets[light_index].communication_type = SPINBOX_CreateEx(x, y + 1 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 7, 1, 3);
+        lightsWidgets[light_index].local_pin = SPINBOX_CreateEx(x, y + 2 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 8, 0, 32);
+        lightsWidgets[light_index].sleep_time = SPINBOX_CreateEx(x, y + 3 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 9, 0, 255);
+        lightsWidgets[light_index].button_external = SPINBOX_CreateEx(x, y + 4 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_LightsModbusRelay + 10, 0, 3);
+
+        const WidgetRect_t* cb1_size = &settings_screen_5_layout.checkbox1_size;
+        lightsWidgets[light_index].tiedToMainLight = CHECKBOX_CreateEx(x, y + 5 * y_step, cb1_size->w, cb1_size->h, hPage, WM_CF_SHOW, 0, ID_LightsModbusRelay + 11);
+
+        const WidgetRect_t* cb2_size = &settings_screen_5_layout.checkbox2_size;
+        lightsWidgets[light_index].rememberBrightness = CHECKBOX_CreateEx(x, y + 5 * y_step + 23, cb2_size->w, cb2_size->h, hPage, WM_CF_SHOW, 0, ID_LightsModbusRelay + 12);
+
+        /** @brief Postavljanje izgleda za sve kreirane widgete. */
+        SPINBOX_SetEdge(lightsWidgets[light_index].relay, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].iconID, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].controllerID_on, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].controllerID_on_delay, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].on_hour, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].on_minute, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].offTime, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].communication_type, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].local_pin, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].sleep_time, SPINBOX_EDGE_CENTER);
+        SPINBOX_SetEdge(lightsWidgets[light_index].button_external, SPINBOX_EDGE_CENTER);
+
+        CHECKBOX_SetTextColor(lightsWidgets[light_index].tiedToMainLight, GUI_GREEN);
+        CHECKBOX_SetText(lightsWidgets[light_index].tiedToMainLight, "TIED TO MAIN LIGHT");
+
+        CHECKBOX_SetTextColor(lightsWidgets[light_index].rememberBrightness, GUI_GREEN);
+        CHECKBOX_SetText(lightsWidgets[light_index].rememberBrightness, "REMEMBER BRIGHTNESS");
+
+        /** @brief Kreiranje navigacionih dugmadi. */
+        hBUTTON_Next = BUTTON_CreateEx(settings_screen_5_layout.next_button_pos.x, settings_screen_5_layout.next_button_pos.y, settings_screen_5_layout.next_button_pos.w, settings_screen_5_layout.next_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
+        hBUTTON_Ok = BUTTON_CreateEx(settings_screen_5_layout.save_button_pos.x, settings_screen_5_layout.save_button_pos.y, settings_screen_5_layout.save_button_pos.w, settings_screen_5_layout.save_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    }
+
+    /** @brief Vrijednosti se učitavaju iz modela pri svakom ulasku na stranicu. */
     SPINBOX_SetValue(lightsWidgets[light_index].relay, LIGHT_GetRelay(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].iconID, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].iconID, LIGHT_GetIconID(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].controllerID_on, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].controllerID_on, LIGHT_GetControllerID(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].controllerID_on_delay, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].controllerID_on_delay, LIGHT_GetOnDelayTime(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].on_hour, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].on_hour, LIGHT_GetOnHour(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].on_minute, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].on_minute, LIGHT_GetOnMinute(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].offTime, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].offTime, LIGHT_GetOffTime(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].communication_type, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].communication_type, LIGHT_GetCommunicationType(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].local_pin, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].local_pin, LIGHT_GetLocalPin(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].sleep_time, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].sleep_time, LIGHT_GetSleepTime(handle));
-    SPINBOX_SetEdge(lightsWidgets[light_index].button_external, SPINBOX_EDGE_CENTER);
     SPINBOX_SetValue(lightsWidgets[light_index].button_external, LIGHT_GetButtonExternal(handle));
-
-    CHECKBOX_SetTextColor(lightsWidgets[light_index].tiedToMainLight, GUI_GREEN);
-    CHECKBOX_SetText(lightsWidgets[light_index].tiedToMainLight, "TIED TO MAIN LIGHT");
     CHECKBOX_SetState(lightsWidgets[light_index].tiedToMainLight, LIGHT_isTiedToMainLight(handle));
-
-    CHECKBOX_SetTextColor(lightsWidgets[light_index].rememberBrightness, GUI_GREEN);
-    CHECKBOX_SetText(lightsWidgets[light_index].rememberBrightness, "REMEMBER BRIGHTNESS");
     CHECKBOX_SetState(lightsWidgets[light_index].rememberBrightness, LIGHT_isBrightnessRemembered(handle));
 
-    /** @brief Kreiranje navigacionih dugmadi. */
-    hBUTTON_Next = BUTTON_CreateEx(settings_screen_5_layout.next_button_pos.x, settings_screen_5_layout.next_button_pos.y, settings_screen_5_layout.next_button_pos.w, settings_screen_5_layout.next_button_pos.h, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
-    hBUTTON_Ok = BUTTON_CreateEx(settings_screen_5_layout.save_button_pos.x, settings_screen_5_layout.save_button_pos.y, settings_screen_5_layout.save_button_pos.w, settings_screen_5_layout.save_button_pos.h, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
-
     /** @brief Iscrtavanje labela. */
     GUI_SetColor(GUI_WHITE);
     GUI_SetFont(GUI_FONT_13_1);
@@ -4445,32 +4822,13 @@ static void DSP_InitSet5Scrn(void)
     GUI_MULTIBUF_EndEx(1);
 }
 /**
- * @brief Briše GUI widgete sa petog ekrana podešavanja.
- * @note Briše dinamički kreirane widgete za svjetla na trenutnoj stranici.
+ * @brief Sakriva GUI widgete sa petog ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet5Scrn(void)
 {
-    // Računamo indeks svjetla čiji su widgeti trenutno na ekranu.
-    uint8_t i = lightsModbusSettingsMenu; // Ovdje ne treba množenje
-
-    // Brišemo svaki widget pojedinačno za taj specifični indeks.
-    WM_DeleteWindow(lightsWidgets[i].relay);
-    WM_DeleteWindow(lightsWidgets[i].iconID);
-    WM_DeleteWindow(lightsWidgets[i].controllerID_on);
-    WM_DeleteWindow(lightsWidgets[i].controllerID_on_delay);
-    WM_DeleteWindow(lightsWidgets[i].offTime);
-    WM_DeleteWindow(lightsWidgets[i].on_hour);
-    WM_DeleteWindow(lightsWidgets[i].on_minute);
-    WM_DeleteWindow(lightsWidgets[i].communication_type);
-    WM_DeleteWindow(lightsWidgets[i].local_pin);
-    WM_DeleteWindow(lightsWidgets[i].sleep_time);
-    WM_DeleteWindow(lightsWidgets[i].button_external);
-    WM_DeleteWindow(lightsWidgets[i].tiedToMainLight);
-    WM_DeleteWindow(lightsWidgets[i].rememberBrightness);
-
-    // Brišemo i zajedničke dugmiće.
-    WM_DeleteWindow(hBUTTON_Next);
-    WM_DeleteWindow(hBUTTON_Ok);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_5);
 }
 /**
  ******************************************************************************
@@ -4491,70 +4849,82 @@ static void DSP_InitSet6Scrn(void)
     GUI_Clear();
     GUI_MULTIBUF_BeginEx(1);
 
-    hDEV_ID = SPINBOX_CreateEx(settings_screen_6_layout.device_id_pos.x, settings_screen_6_layout.device_id_pos.y, settings_screen_6_layout.device_id_pos.w, settings_screen_6_layout.device_id_pos.h, 0, WM_CF_SHOW, ID_DEV_ID, 1, 254);
-    SPINBOX_SetEdge(hDEV_ID, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hDEV_ID, tfifa);
-
-    hCurtainsMoveTime = SPINBOX_CreateEx(settings_screen_6_layout.curtain_move_time_pos.x, settings_screen_6_layout.curtain_move_time_pos.y, settings_screen_6_layout.curtain_move_time_pos.w, settings_screen_6_layout.curtain_move_time_pos.h, 0, WM_CF_SHOW, ID_CurtainsMoveTime, 0, 60);
-    SPINBOX_SetEdge(hCurtainsMoveTime, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hCurtainsMoveTime, Curtain_GetMoveTime());
-
-    const WidgetRect_t* cb1_pos = &settings_screen_6_layout.leave_scrnsvr_checkbox_pos;
-    hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH = CHECKBOX_CreateEx(cb1_pos->x, cb1_pos->y, cb1_pos->w, cb1_pos->h, 0, WM_CF_SHOW, 0, ID_LEAVE_SCRNSVR_AFTER_TOUCH);
-    CHECKBOX_SetTextColor(hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH, GUI_GREEN);
-    CHECKBOX_SetText(hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH, "ONLY LEAVE SCRNSVR AFTER TOUCH");
-    CHECKBOX_SetState(hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH, g_display_settings.leave_scrnsvr_on_release);
-
-    const WidgetRect_t* cb2_pos = &settings_screen_6_layout.night_timer_checkbox_pos;
-    hCHKBX_LIGHT_NIGHT_TIMER = CHECKBOX_CreateEx(cb2_pos->x, cb2_pos->y, cb2_pos->w, cb2_pos->h, 0, WM_CF_SHOW, 0, ID_LIGHT_NIGHT_TIMER);
-    CHECKBOX_SetTextColor(hCHKBX_LIGHT_NIGHT_TIMER, GUI_GREEN);
-    CHECKBOX_SetText(hCHKBX_LIGHT_NIGHT_TIMER, "LIGHT OFF TIMER AFTER 20h");
-    CHECKBOX_SetState(hCHKBX_LIGHT_NIGHT_TIMER, g_display_settings.light_night_timer_enabled);
-
-    // ... ostatak funkcije ostaje nepromijenjen ...
-    const WidgetRect_t* lang_pos = &settings_screen_6_layout.language_dropdown_pos;
-    hDRPDN_Language = DROPDOWN_CreateEx(lang_pos->x, lang_pos->y, lang_pos->w, lang_pos->h, 0, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_LanguageSelect);
-    for (int i = 0; i < LANGUAGE_COUNT; i++) {
-        DROPDOWN_AddString(hDRPDN_Language, language_strings[TXT_LANGUAGE_NAME][i]);
-    }
-    DROPDOWN_SetSel(hDRPDN_Language, g_display_settings.language);
-    DROPDOWN_SetFont(hDRPDN_Language, GUI_FONT_16_1);
-    
-    hSelectControl_1 = DROPDOWN_CreateEx(settings_screen_6_layout.select_control_1_pos.x, settings_screen_6_layout.select_control_1_pos.y, settings_screen_6_layout.select_control_1_pos.w, settings_screen_6_layout.select_control_1_pos.h, 0, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_SELECT_CONTROL_1);
-    PopulateControlDropdown(hSelectControl_1, g_display_settings.selected_control_mode_2, control_mode_map_1, MODE_COUNT);
-    for (int i = 0; i < MODE_COUNT; i++) {
-        if (control_mode_map_1[i] == g_display_settings.selected_control_mode) {
-            DROPDOWN_SetSel(hSelectControl_1, i);
-            break;
+    /**
+     * @brief Sadržaj DROPDOWN-a za ikone zavisi od odabira u onom drugom,
+     * pa su oba odabrana moda dio ključa varijante stranice.
+     */
+    const uint32_t variant = ((uint32_t)g_display_settings.selected_control_mode << 16) |
+                             ((uint32_t)g_display_settings.selected_control_mode_2 << 8) |
+                             g_display_settings.language;
+    WM_HWIN hPage;
+    if (DSP_SettingsPageOpen(SCREEN_SETTINGS_6, variant, &hPage)) {
+        hDEV_ID = SPINBOX_CreateEx(settings_screen_6_layout.device_id_pos.x, settings_screen_6_layout.device_id_pos.y, settings_screen_6_layout.device_id_pos.w, settings_screen_6_layout.device_id_pos.h, hPage, WM_CF_SHOW, ID_DEV_ID, 1, 254);
+        SPINBOX_SetEdge(hDEV_ID, SPINBOX_EDGE_CENTER);
+
+        hCurtainsMoveTime = SPINBOX_CreateEx(settings_screen_6_layout.curtain_move_time_pos.x, settings_screen_6_layout.curtain_move_time_pos.y, settings_screen_6_layout.curtain_move_time_pos.w, settings_screen_6_layout.curtain_move_time_pos.h, hPage, WM_CF_SHOW, ID_CurtainsMoveTime, 0, 60);
+        SPINBOX_SetEdge(hCurtainsMoveTime, SPINBOX_EDGE_CENTER);
+
+        const WidgetRect_t* cb1_pos = &settings_screen_6_layout.leave_scrnsvr_checkbox_pos;
+        hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH = CHECKBOX_CreateEx(cb1_pos->x, cb1_pos->y, cb1_pos->w, cb1_pos->h, hPage, WM_CF_SHOW, 0, ID_LEAVE_SCRNSVR_AFTER_TOUCH);
+        CHECKBOX_SetTextColor(hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH, GUI_GREEN);
+        CHECKBOX_SetText(hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH, "ONLY LEAVE SCRNSVR AFTER TOUCH");
+
+        const WidgetRect_t* cb2_pos = &settings_screen_6_layout.night_timer_checkbox_pos;
+        hCHKBX_LIGHT_NIGHT_TIMER = CHECKBOX_CreateEx(cb2_pos->x, cb2_pos->y, cb2_pos->w, cb2_pos->h, hPage, WM_CF_SHOW, 0, ID_LIGHT_NIGHT_TIMER);
+        CHECKBOX_SetTextColor(hCHKBX_LIGHT_NIGHT_TIMER, GUI_GREEN);
+        CHECKBOX_SetText(hCHKBX_LIGHT_NIGHT_TIMER, "LIGHT OFF TIMER AFTER 20h");
+
+        // ... ostatak funkcije ostaje nepromijenjen ...
+        const WidgetRect_t* lang_pos = &settings_screen_6_layout.language_dropdown_pos;
+        hDRPDN_Language = DROPDOWN_CreateEx(lang_pos->x, lang_pos->y, lang_pos->w, lang_pos->h, hPage, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_LanguageSelect);
+        for (int i = 0; i < LANGUAGE_COUNT; i++) {
+            DROPDOWN_AddString(hDRPDN_Language, language_strings[TXT_LANGUAGE_NAME][i]);
+        }
+        DROPDOWN_SetFont(hDRPDN_Language, GUI_FONT_16_1);
+
+        hSelectControl_1 = DROPDOWN_CreateEx(settings_screen_6_layout.select_control_1_pos.x, settings_screen_6_layout.select_control_1_pos.y, settings_screen_6_layout.select_control_1_pos.w, settings_screen_6_layout.select_control_1_pos.h, hPage, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_SELECT_CONTROL_1);
+        PopulateControlDropdown(hSelectControl_1, g_display_settings.selected_control_mode_2, control_mode_map_1, MODE_COUNT);
+        for (int i = 0; i < MODE_COUNT; i++) {
+            if (control_mode_map_1[i] == g_display_settings.selected_control_mode) {
+                DROPDOWN_SetSel(hSelectControl_1, i);
+                break;
+            }
         }
-    }
-    DROPDOWN_SetFont(hSelectControl_1, GUI_FONT_16_1);
-    
-    hSelectControl_2 = DROPDOWN_CreateEx(settings_screen_6_layout.select_control_2_pos.x, settings_screen_6_layout.select_control_2_pos.y, settings_screen_6_layout.select_control_2_pos.w, settings_screen_6_layout.select_control_2_pos.h, 0, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_SELECT_CONTROL_2);
-    PopulateControlDropdown(hSelectControl_2, g_display_settings.selected_control_mode, control_mode_map_2, MODE_COUNT);
-    for (int i = 0; i < MODE_COUNT; i++) {
-        if (control_mode_map_2[i] == g_display_settings.selected_control_mode_2) {
-            DROPDOWN_SetSel(hSelectControl_2, i);
-            break;
+        DROPDOWN_SetFont(hSelectControl_1, GUI_FONT_16_1);
+
+        hSelectControl_2 = DROPDOWN_CreateEx(settings_screen_6_layout.select_control_2_pos.x, settings_screen_6_layout.select_control_2_pos.y, settings_screen_6_layout.select_control_2_pos.w, settings_screen_6_layout.select_control_2_pos.h, hPage, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_SELECT_CONTROL_2);
+        PopulateControlDropdown(hSelectControl_2, g_display_settings.selected_control_mode, control_mode_map_2, MODE_COUNT);
+        for (int i = 0; i < MODE_COUNT; i++) {
+            if (control_mode_map_2[i] == g_display_settings.selected_control_mode_2) {
+                DROPDOWN_SetSel(hSelectControl_2, i);
+                break;
+            }
         }
-    }
-    DROPDOWN_SetFont(hSelectControl_2, GUI_FONT_16_1);
+        DROPDOWN_SetFont(hSelectControl_2, GUI_FONT_16_1);
 
-    const WidgetRect_t* defaults_pos = &settings_screen_6_layout.set_defaults_button_pos;
-    hBUTTON_SET_DEFAULTS = BUTTON_CreateEx(defaults_pos->x, defaults_pos->y, defaults_pos->w, defaults_pos->h, 0, WM_CF_SHOW, 0, ID_SET_DEFAULTS);
-    BUTTON_SetText(hBUTTON_SET_DEFAULTS, "SET DEFAULTS");
+        const WidgetRect_t* defaults_pos = &settings_screen_6_layout.set_defaults_button_pos;
+        hBUTTON_SET_DEFAULTS = BUTTON_CreateEx(defaults_pos->x, defaults_pos->y, defaults_pos->w, defaults_pos->h, hPage, WM_CF_SHOW, 0, ID_SET_DEFAULTS);
+        BUTTON_SetText(hBUTTON_SET_DEFAULTS, "SET DEFAULTS");
 
-    const WidgetRect_t* restart_pos = &settings_screen_6_layout.restart_button_pos;
-    hBUTTON_SYSRESTART = BUTTON_CreateEx(restart_pos->x, restart_pos->y, restart_pos->w, restart_pos->h, 0, WM_CF_SHOW, 0, ID_SYSRESTART);
-    BUTTON_SetText(hBUTTON_SYSRESTART, "RESTART");
+        const WidgetRect_t* restart_pos = &settings_screen_6_layout.restart_button_pos;
+        hBUTTON_SYSRESTART = BUTTON_CreateEx(restart_pos->x, restart_pos->y, restart_pos->w, restart_pos->h, hPage, WM_CF_SHOW, 0, ID_SYSRESTART);
+        BUTTON_SetText(hBUTTON_SYSRESTART, "RESTART");
 
-    const WidgetRect_t* next_pos = &settings_screen_6_layout.next_button_pos;
-    hBUTTON_Next = BUTTON_CreateEx(next_pos->x, next_pos->y, next_pos->w, next_pos->h, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
+        const WidgetRect_t* next_pos = &settings_screen_6_layout.next_button_pos;
+        hBUTTON_Next = BUTTON_CreateEx(next_pos->x, next_pos->y, next_pos->w, next_pos->h, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
 
-    const WidgetRect_t* save_pos = &settings_screen_6_layout.save_button_pos;
-    hBUTTON_Ok = BUTTON_CreateEx(save_pos->x, save_pos->y, save_pos->w, save_pos->h, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
+        const WidgetRect_t* save_pos = &settings_screen_6_layout.save_button_pos;
+        hBUTTON_Ok = BUTTON_CreateEx(save_pos->x, save_pos->y, save_pos->w, save_pos->h, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    }
+
+    /** @brief Vrijednosti se učitavaju iz modela pri svakom ulasku na stranicu. */
+    SPINBOX_SetValue(hDEV_ID, tfifa);
+    SPINBOX_SetValue(hCurtainsMoveTime, Curtain_GetMoveTime());
+    CHECKBOX_SetState(hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH, g_display_settings.leave_scrnsvr_on_release);
+    CHECKBOX_SetState(hCHKBX_LIGHT_NIGHT_TIMER, g_display_settings.light_night_timer_enabled);
+    DROPDOWN_SetSel(hDRPDN_Language, g_display_settings.language);
 
     GUI_SetColor(GUI_WHITE);
     GUI_SetFont(GUI_FONT_13_1);
@@ -4577,22 +4947,17 @@ static void DSP_InitSet6Scrn(void)
     GUI_MULTIBUF_EndEx(1);
 }
 /**
- * @brief Briše GUI widgete sa šestog ekrana podešavanja.
- * @note Briše sve widgete vezane za Device ID, screensaver i navigaciju.
+ * @brief Sakriva GUI widgete sa šestog ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet6Scrn(void)
 {
-    if (WM_IsWindow(hSelectControl_1)) WM_DeleteWindow(hSelectControl_1);
-    if (WM_IsWindow(hSelectControl_2)) WM_DeleteWindow(hSelectControl_2);
-    WM_DeleteWindow(hDEV_ID);
-    WM_DeleteWindow(hCurtainsMoveTime);
-    WM_DeleteWindow(hCHKBX_ONLY_LEAVE_SCRNSVR_AFTER_TOUCH);
-    WM_DeleteWindow(hCHKBX_LIGHT_NIGHT_TIMER);
-    WM_DeleteWindow(hBUTTON_SET_DEFAULTS);
-    WM_DeleteWindow(hBUTTON_SYSRESTART);
-    WM_DeleteWindow(hDRPDN_Language);
-    WM_DeleteWindow(hBUTTON_Next);
-    WM_DeleteWindow(hBUTTON_Ok);
+    // Otvorena lista bi ostala visiti iznad sljedećeg ekrana
+    DROPDOWN_Collapse(hDRPDN_Language);
+    DROPDOWN_Collapse(hSelectControl_1);
+    DROPDOWN_Collapse(hSelectControl_2);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_6);
 }
 /**
  ******************************************************************************
@@ -4613,11 +4978,16 @@ static void DSP_InitSet7Scrn(void)
     GUI_Clear();
     GUI_MULTIBUF_BeginEx(1);
 
+    WM_HWIN hPage;
+    const bool create = DSP_SettingsPageOpen(SCREEN_SETTINGS_7, 0, &hPage);
+
     // --- Kreiranje Glavnog Checkbox-a ---
-    const WidgetRect_t* scenes_cb_pos = &settings_screen_7_layout.enable_scenes_checkbox_pos;
-    hCHKBX_EnableScenes = CHECKBOX_CreateEx(scenes_cb_pos->x, scenes_cb_pos->y, scenes_cb_pos->w, scenes_cb_pos->h, 0, WM_CF_SHOW, 0, ID_ENABLE_SCENES);
-    CHECKBOX_SetTextColor(hCHKBX_EnableScenes, GUI_GREEN);
-    CHECKBOX_SetText(hCHKBX_EnableScenes, "ENABLE SCENE"); // "Enable Scene"
+    if (create) {
+        const WidgetRect_t* scenes_cb_pos = &settings_screen_7_layout.enable_scenes_checkbox_pos;
+        hCHKBX_EnableScenes = CHECKBOX_CreateEx(scenes_cb_pos->x, scenes_cb_pos->y, scenes_cb_pos->w, scenes_cb_pos->h, hPage, WM_CF_SHOW, 0, ID_ENABLE_SCENES);
+        CHECKBOX_SetTextColor(hCHKBX_EnableScenes, GUI_GREEN);
+        CHECKBOX_SetText(hCHKBX_EnableScenes, "ENABLE SCENE"); // "Enable Scene"
+    }
     CHECKBOX_SetState(hCHKBX_EnableScenes, g_display_settings.scenes_enabled);
 
     // Naslov za sekciju okidača
@@ -4636,10 +5006,12 @@ static void DSP_InitSet7Scrn(void)
         int y = settings_screen_7_layout.grid_start_pos.y + (row * settings_screen_7_layout.y_spacing);
 
         // Kreiranje Spinbox-a
-        hSPNBX_SceneTriggers[i] = SPINBOX_CreateEx(x, y, settings_screen_7_layout.widget_width, settings_screen_7_layout.widget_height, 0, WM_CF_SHOW, ID_SCENE_TRIGGER_1 + i, 0, 512);
-        SPINBOX_SetEdge(hSPNBX_SceneTriggers[i], SPINBOX_EDGE_CENTER);
-        // TODO: Učitati snimljenu vrijednost iz EEPROM-a kada se definiše struktura za to
-        // SPINBOX_SetValue(hSPNBX_SceneTriggers[i], g_scene_settings.triggers[i]);
+        if (create) {
+            hSPNBX_SceneTriggers[i] = SPINBOX_CreateEx(x, y, settings_screen_7_layout.widget_width, settings_screen_7_layout.widget_height, hPage, WM_CF_SHOW, ID_SCENE_TRIGGER_1 + i, 0, 512);
+            SPINBOX_SetEdge(hSPNBX_SceneTriggers[i], SPINBOX_EDGE_CENTER);
+        }
+        // Vrijednost se učitava pri svakom ulasku, jer kontejner stranice preživljava navigaciju
+        SPINBOX_SetValue(hSPNBX_SceneTriggers[i], g_display_settings.scene_homecoming_triggers[i]);
 
         // Kreiranje Labele
         char label_buffer[20];
@@ -4650,40 +5022,23 @@ static void DSP_InitSet7Scrn(void)
     }
 
     // --- Kreiranje Navigacionih Dugmadi ---
-    hBUTTON_Next = BUTTON_CreateEx(settings_screen_7_layout.next_button_pos.x, settings_screen_7_layout.next_button_pos.y, settings_screen_7_layout.next_button_pos.w, settings_screen_7_layout.next_button_pos.h, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
-    hBUTTON_Ok = BUTTON_CreateEx(settings_screen_7_layout.save_button_pos.x, settings_screen_7_layout.save_button_pos.y, settings_screen_7_layout.save_button_pos.w, settings_screen_7_layout.save_button_pos.h, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    if (create) {
+        hBUTTON_Next = BUTTON_CreateEx(settings_screen_7_layout.next_button_pos.x, settings_screen_7_layout.next_button_pos.y, settings_screen_7_layout.next_button_pos.w, settings_screen_7_layout.next_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
+        hBUTTON_Ok = BUTTON_CreateEx(settings_screen_7_layout.save_button_pos.x, settings_screen_7_layout.save_button_pos.y, settings_screen_7_layout.save_button_pos.w, settings_screen_7_layout.save_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    }
 
     GUI_MULTIBUF_EndEx(1);
 }
 /**
- ******************************************************************************
- * @brief       Briše GUI widgete sa sedmog ekrana podešavanja (Scene Backend).
- * @author      Gemini & [Vaše Ime]
- * @note        Ova funkcija se poziva prilikom napuštanja ekrana
- * `SCREEN_SETTINGS_7` kako bi se oslobodila memorija i spriječili
- * konflikti sa widgetima na drugim ekranima. Uklanja sve
- * dinamički kreirane elemente.
- ******************************************************************************
+ * @brief Sakriva GUI widgete sa sedmog ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet7Scrn(void)
 {
-    // Brišemo checkbox za omogućavanje scena
-    WM_DeleteWindow(hCHKBX_EnableScenes);
-
-    // Brišemo svih 8 spinbox-ova za adrese okidača
-    for (uint8_t i = 0; i < SCENE_MAX_TRIGGERS; i++)
-    {
-        if (WM_IsWindow(hSPNBX_SceneTriggers[i])) // Sigurnosna provjera
-        {
-            WM_DeleteWindow(hSPNBX_SceneTriggers[i]);
-        }
-    }
-
-    // Brišemo navigacione dugmiće
-    WM_DeleteWindow(hBUTTON_Next);
-    WM_DeleteWindow(hBUTTON_Ok);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_7);
 }
 
 /**
@@ -4724,69 +5079,74 @@ static void DSP_InitSet8Scrn(void)
     int16_t y = settings_screen_8_layout.start_y;
     int16_t y_step = settings_screen_8_layout.y_step;
 
-    // === PRVA KOLONA WIDGETA ===
+    WM_HWIN hPage;
+    if (DSP_SettingsPageOpen(SCREEN_SETTINGS_8, 0, &hPage)) {
+        // === PRVA KOLONA WIDGETA ===
 
-    // 1. Spinbox za odabir kapije
-    hGateSelect = SPINBOX_CreateEx(x_col1, y, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_SELECT, 1, GATE_MAX_COUNT);
-    SPINBOX_SetEdge(hGateSelect, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateSelect, settings_gate_selected_index + 1);
+        // 1. Spinbox za odabir kapije
+        hGateSelect = SPINBOX_CreateEx(x_col1, y, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_SELECT, 1, GATE_MAX_COUNT);
+        SPINBOX_SetEdge(hGateSelect, SPINBOX_EDGE_CENTER);
 
-    // 2. Dropdown za Profil Kontrole
-    hGateType = DROPDOWN_CreateEx(x_col1, y + 1 * y_step, sb_size->w, 80, 0, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_GATE_TYPE);
-    for (int i = 0; i < Gate_GetProfileCount(); i++) {
-        DROPDOWN_AddString(hGateType, Gate_GetProfileNameByIndex(i));
-    }
-    DROPDOWN_SetSel(hGateType, Gate_GetControlType(handle));
-    DROPDOWN_SetFont(hGateType, GUI_FONT_16_1);
+        // 2. Dropdown za Profil Kontrole
+        hGateType = DROPDOWN_CreateEx(x_col1, y + 1 * y_step, sb_size->w, 80, hPage, WM_CF_SHOW, DROPDOWN_CF_AUTOSCROLLBAR, ID_GATE_TYPE);
+        for (int i = 0; i < Gate_GetProfileCount(); i++) {
+            DROPDOWN_AddString(hGateType, Gate_GetProfileNameByIndex(i));
+        }
+        DROPDOWN_SetFont(hGateType, GUI_FONT_16_1);
 
-    // 3. Spinbox za Izgled
-    uint16_t max_appearance_id = (sizeof(gate_appearance_mapping_table) / sizeof(IconMapping_t)) - 1;
-    hGateAppearance = SPINBOX_CreateEx(x_col1, y + 2 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_APPEARANCE, 0, max_appearance_id);
-    SPINBOX_SetEdge(hGateAppearance, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateAppearance, Gate_GetAppearanceId(handle));
+        // 3. Spinbox za Izgled
+        uint16_t max_appearance_id = (sizeof(gate_appearance_mapping_table) / sizeof(IconMapping_t)) - 1;
+        hGateAppearance = SPINBOX_CreateEx(x_col1, y + 2 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_APPEARANCE, 0, max_appearance_id);
+        SPINBOX_SetEdge(hGateAppearance, SPINBOX_EDGE_CENTER);
 
-    // 4. Spinbox za Relej Komanda 1
-    hGateParamSpinboxes[0] = SPINBOX_CreateEx(x_col1, y + 3 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_EDIT_RELAY_CMD1, 0, 512);
-    SPINBOX_SetEdge(hGateParamSpinboxes[0], SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateParamSpinboxes[0], Gate_GetRelayAddr(handle, 1));
+        // 4. Spinbox za Relej Komanda 1
+        hGateParamSpinboxes[0] = SPINBOX_CreateEx(x_col1, y + 3 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_EDIT_RELAY_CMD1, 0, 512);
+        SPINBOX_SetEdge(hGateParamSpinboxes[0], SPINBOX_EDGE_CENTER);
 
-    // 5. Spinbox za Relej Komanda 2
-    hGateParamSpinboxes[1] = SPINBOX_CreateEx(x_col1, y + 4 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_EDIT_RELAY_CMD2, 0, 512);
-    SPINBOX_SetEdge(hGateParamSpinboxes[1], SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateParamSpinboxes[1], Gate_GetRelayAddr(handle, 2));
+        // 5. Spinbox za Relej Komanda 2
+        hGateParamSpinboxes[1] = SPINBOX_CreateEx(x_col1, y + 4 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_EDIT_RELAY_CMD2, 0, 512);
+        SPINBOX_SetEdge(hGateParamSpinboxes[1], SPINBOX_EDGE_CENTER);
 
-    // 6. Spinbox za Relej Komanda 3
-    hGateParamSpinboxes[2] = SPINBOX_CreateEx(x_col1, y + 5 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_EDIT_RELAY_CMD3, 0, 512);
-    SPINBOX_SetEdge(hGateParamSpinboxes[2], SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateParamSpinboxes[2], Gate_GetRelayAddr(handle, 3));
+        // 6. Spinbox za Relej Komanda 3
+        hGateParamSpinboxes[2] = SPINBOX_CreateEx(x_col1, y + 5 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_EDIT_RELAY_CMD3, 0, 512);
+        SPINBOX_SetEdge(hGateParamSpinboxes[2], SPINBOX_EDGE_CENTER);
 
-    // === DRUGA KOLONA WIDGETA ===
+        // === DRUGA KOLONA WIDGETA ===
 
-    // 1. Spinbox za Senzor 1
-    hGateParamSpinboxes[3] = SPINBOX_CreateEx(x_col2, y, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_EDIT_FEEDBACK_1, 0, 512);
-    SPINBOX_SetEdge(hGateParamSpinboxes[3], SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateParamSpinboxes[3], Gate_GetFeedbackAddr(handle, 1));
+        // 1. Spinbox za Senzor 1
+        hGateParamSpinboxes[3] = SPINBOX_CreateEx(x_col2, y, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_EDIT_FEEDBACK_1, 0, 512);
+        SPINBOX_SetEdge(hGateParamSpinboxes[3], SPINBOX_EDGE_CENTER);
 
-    // 2. Spinbox za Senzor 2
-    hGateParamSpinboxes[4] = SPINBOX_CreateEx(x_col2, y + 1 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_EDIT_FEEDBACK_2, 0, 512);
-    SPINBOX_SetEdge(hGateParamSpinboxes[4], SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateParamSpinboxes[4], Gate_GetFeedbackAddr(handle, 2));
+        // 2. Spinbox za Senzor 2
+        hGateParamSpinboxes[4] = SPINBOX_CreateEx(x_col2, y + 1 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_EDIT_FEEDBACK_2, 0, 512);
+        SPINBOX_SetEdge(hGateParamSpinboxes[4], SPINBOX_EDGE_CENTER);
 
-    // 3. Spinbox za Tajmer Ciklusa
-    hGateParamSpinboxes[5] = SPINBOX_CreateEx(x_col2, y + 2 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_EDIT_CYCLE_TIMER, 0, 255);
-    SPINBOX_SetEdge(hGateParamSpinboxes[5], SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateParamSpinboxes[5], Gate_GetCycleTimer(handle));
+        // 3. Spinbox za Tajmer Ciklusa
+        hGateParamSpinboxes[5] = SPINBOX_CreateEx(x_col2, y + 2 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_EDIT_CYCLE_TIMER, 0, 255);
+        SPINBOX_SetEdge(hGateParamSpinboxes[5], SPINBOX_EDGE_CENTER);
 
-    // 4. Spinbox za Trajanje Impulsa
-    hGateParamSpinboxes[6] = SPINBOX_CreateEx(x_col2, y + 3 * y_step, sb_size->w, sb_size->h, 0, WM_CF_SHOW, ID_GATE_EDIT_PULSE_TIMER, 0, 50); // << IZMJENJEN OPSEG
-    SPINBOX_SetEdge(hGateParamSpinboxes[6], SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hGateParamSpinboxes[6], Gate_GetPulseTimer(handle) / 100); // << IZMIJENJENA VRIJEDNOST
+        // 4. Spinbox za Trajanje Impulsa
+        hGateParamSpinboxes[6] = SPINBOX_CreateEx(x_col2, y + 3 * y_step, sb_size->w, sb_size->h, hPage, WM_CF_SHOW, ID_GATE_EDIT_PULSE_TIMER, 0, 50); // << IZMJENJEN OPSEG
+        SPINBOX_SetEdge(hGateParamSpinboxes[6], SPINBOX_EDGE_CENTER);
 
-    // Kreiranje navigacionih dugmadi - identično kao na ekranu za svjetla
-    hBUTTON_Next = BUTTON_CreateEx(settings_screen_8_layout.next_button_pos.x, settings_screen_8_layout.next_button_pos.y, settings_screen_8_layout.next_button_pos.w, settings_screen_8_layout.next_button_pos.h, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
-    hBUTTON_Ok = BUTTON_CreateEx(settings_screen_8_layout.save_button_pos.x, settings_screen_8_layout.save_button_pos.y, settings_screen_8_layout.save_button_pos.w, settings_screen_8_layout.save_button_pos.h, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
+        // Kreiranje navigacionih dugmadi - identično kao na ekranu za svjetla
+        hBUTTON_Next = BUTTON_CreateEx(settings_screen_8_layout.next_button_pos.x, settings_screen_8_layout.next_button_pos.y, settings_screen_8_layout.next_button_pos.w, settings_screen_8_layout.next_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
+        hBUTTON_Ok = BUTTON_CreateEx(settings_screen_8_layout.save_button_pos.x, settings_screen_8_layout.save_button_pos.y, settings_screen_8_layout.save_button_pos.w, settings_screen_8_layout.save_button_pos.h, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    }
+
+    /** @brief Vrijednosti se učitavaju iz modela pri svakom ulasku na stranicu. */
+    SPINBOX_SetValue(hGateSelect, settings_gate_selected_index + 1);
+    DROPDOWN_SetSel(hGateType, Gate_GetControlType(handle));
+    SPINBOX_SetValue(hGateAppearance, Gate_GetAppearanceId(handle));
+    SPINBOX_SetValue(hGateParamSpinboxes[0], Gate_GetRelayAddr(handle, 1));
+    SPINBOX_SetValue(hGateParamSpinboxes[1], Gate_GetRelayAddr(handle, 2));
+    SPINBOX_SetValue(hGateParamSpinboxes[2], Gate_GetRelayAddr(handle, 3));
+    SPINBOX_SetValue(hGateParamSpinboxes[3], Gate_GetFeedbackAddr(handle, 1));
+    SPINBOX_SetValue(hGateParamSpinboxes[4], Gate_GetFeedbackAddr(handle, 2));
+    SPINBOX_SetValue(hGateParamSpinboxes[5], Gate_GetCycleTimer(handle));
+    SPINBOX_SetValue(hGateParamSpinboxes[6], Gate_GetPulseTimer(handle) / 100); // << IZMIJENJENA VRIJEDNOST
 
     // Iscrtavanje labela - identična logika poravnanja kao kod svjetala
     GUI_SetColor(GUI_WHITE);
@@ -4839,33 +5199,15 @@ static void DSP_InitSet8Scrn(void)
     GUI_MULTIBUF_EndEx(1);
 }
 /**
- ******************************************************************************
- * @brief       Uništava sve GUI widgete sa osmog ekrana podešavanja (Kapije).
- * @author      Gemini
- * @note        Ova funkcija se poziva prilikom napuštanja ekrana `SCREEN_SETTINGS_8`.
- * Njena uloga je da oslobodi sve resurse zauzete od strane widgeta,
- * čime se sprječava curenje memorije i osigurava čisto stanje za
- * iscrtavanje sljedećeg ekrana. Arhitektura je identična funkciji
- * `DSP_KillSet5Scrn` radi konzistentnosti.
- ******************************************************************************
+ * @brief Sakriva GUI widgete sa osmog ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet8Scrn(void)
 {
-    // Brisanje glavnih kontrola za odabir
-    if (WM_IsWindow(hGateSelect))     WM_DeleteWindow(hGateSelect);
-    if (WM_IsWindow(hGateType))       WM_DeleteWindow(hGateType);
-    if (WM_IsWindow(hGateAppearance)) WM_DeleteWindow(hGateAppearance);
-
-    // Brisanje niza Spinbox widgeta za parametre
-    for(int i = 0; i < 7; i++) {
-        if (WM_IsWindow(hGateParamSpinboxes[i])) {
-            WM_DeleteWindow(hGateParamSpinboxes[i]);
-        }
-    }
-
-    // Brisanje zajedničkih navigacionih dugmadi
-    if (WM_IsWindow(hBUTTON_Next)) WM_DeleteWindow(hBUTTON_Next);
-    if (WM_IsWindow(hBUTTON_Ok))   WM_DeleteWindow(hBUTTON_Ok);
+    // Otvorena lista bi ostala visiti iznad sljedećeg ekrana
+    DROPDOWN_Collapse(hGateType);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_8);
 }
 /**
  ******************************************************************************
@@ -4896,17 +5238,23 @@ static void DSP_InitSet9Scrn(void)
     const int16_t lbl_line1_off_y = 8;
     const int16_t lbl_line2_off_y = 20;
 
+    // Widgeti se kreiraju samo pri prvom ulasku; kasnije se dohvataju po ID-u iz kontejnera
+    WM_HWIN hPage;
+    const bool create = DSP_SettingsPageOpen(SCREEN_SETTINGS_9, 0, &hPage);
+
     // --- Kreiranje kontrola za Particije (koristi y_spacing) ---
     for (int i = 0; i < SECURITY_PARTITION_COUNT; i++) {
         int y_pos = y_start + i * y_spacing;
 
-        SPINBOX_Handle hRelay = SPINBOX_CreateEx(col1_x, y_pos, spin_w, spin_h, 0, WM_CF_SHOW, ID_ALARM_RELAY_P1 + i, 0, 512);
-        SPINBOX_SetEdge(hRelay, SPINBOX_EDGE_CENTER);
-        SPINBOX_SetValue(hRelay, Security_GetPartitionRelayAddr(i));
+        if (create) {
+            SPINBOX_Handle hRelay = SPINBOX_CreateEx(col1_x, y_pos, spin_w, spin_h, hPage, WM_CF_SHOW, ID_ALARM_RELAY_P1 + i, 0, 512);
+            SPINBOX_SetEdge(hRelay, SPINBOX_EDGE_CENTER);
 
-        SPINBOX_Handle hFb = SPINBOX_CreateEx(col2_x, y_pos, spin_w, spin_h, 0, WM_CF_SHOW, ID_ALARM_FB_P1 + i, 0, 512);
-        SPINBOX_SetEdge(hFb, SPINBOX_EDGE_CENTER);
-        SPINBOX_SetValue(hFb, Security_GetPartitionFeedbackAddr(i));
+            SPINBOX_Handle hFb = SPINBOX_CreateEx(col2_x, y_pos, spin_w, spin_h, hPage, WM_CF_SHOW, ID_ALARM_FB_P1 + i, 0, 512);
+            SPINBOX_SetEdge(hFb, SPINBOX_EDGE_CENTER);
+        }
+        SPINBOX_SetValue(WM_GetDialogItem(hPage, ID_ALARM_RELAY_P1 + i), Security_GetPartitionRelayAddr(i));
+        SPINBOX_SetValue(WM_GetDialogItem(hPage, ID_ALARM_FB_P1 + i), Security_GetPartitionFeedbackAddr(i));
 
         char buffer[20];
         sprintf(buffer, "Particija %d", i + 1);
@@ -4929,9 +5277,11 @@ static void DSP_InitSet9Scrn(void)
     int16_t y_current = y_start + SECURITY_PARTITION_COUNT * y_spacing;
 
     // 1. RED KONTROLA ISPOD PARTICIJA
-    SPINBOX_Handle hSilent = SPINBOX_CreateEx(col1_x, y_current, spin_w, spin_h, 0, WM_CF_SHOW, ID_ALARM_RELAY_SILENT, 0, 512);
-    SPINBOX_SetEdge(hSilent, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hSilent, Security_GetSilentAlarmAddr());
+    if (create) {
+        SPINBOX_Handle hSilent = SPINBOX_CreateEx(col1_x, y_current, spin_w, spin_h, hPage, WM_CF_SHOW, ID_ALARM_RELAY_SILENT, 0, 512);
+        SPINBOX_SetEdge(hSilent, SPINBOX_EDGE_CENTER);
+    }
+    SPINBOX_SetValue(WM_GetDialogItem(hPage, ID_ALARM_RELAY_SILENT), Security_GetSilentAlarmAddr());
     GUI_SetFont(GUI_FONT_13_1);
     GUI_SetColor(GUI_WHITE);
     GUI_SetTextAlign(GUI_TA_LEFT | GUI_TA_VCENTER);
@@ -4939,9 +5289,11 @@ static void DSP_InitSet9Scrn(void)
     GUI_SetTextAlign(GUI_TA_LEFT | GUI_TA_VCENTER);
     GUI_DispStringAt("(SOS)", col1_x + lbl_off_x, y_current + lbl_line2_off_y);
 
-    SPINBOX_Handle hStatusFb = SPINBOX_CreateEx(col2_x, y_current, spin_w, spin_h, 0, WM_CF_SHOW, ID_ALARM_FB_SYSTEM_STATUS, 0, 512);
-    SPINBOX_SetEdge(hStatusFb, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hStatusFb, Security_GetSystemStatusFeedbackAddr());
+    if (create) {
+        SPINBOX_Handle hStatusFb = SPINBOX_CreateEx(col2_x, y_current, spin_w, spin_h, hPage, WM_CF_SHOW, ID_ALARM_FB_SYSTEM_STATUS, 0, 512);
+        SPINBOX_SetEdge(hStatusFb, SPINBOX_EDGE_CENTER);
+    }
+    SPINBOX_SetValue(WM_GetDialogItem(hPage, ID_ALARM_FB_SYSTEM_STATUS), Security_GetSystemStatusFeedbackAddr());
     GUI_SetFont(GUI_FONT_13_1);
     GUI_SetColor(GUI_WHITE);
     GUI_SetTextAlign(GUI_TA_LEFT | GUI_TA_VCENTER);
@@ -4953,14 +5305,16 @@ static void DSP_InitSet9Scrn(void)
     y_current += y_spacing;
     
     // 2. RED KONTROLA ISPOD PARTICIJA
-    hCHKBX_EnableSecurity = CHECKBOX_CreateEx(col1_x, y_current, 240, 20, 0, WM_CF_SHOW, 0, ID_ENABLE_SECURITY_MODULE);
-    CHECKBOX_SetTextColor(hCHKBX_EnableSecurity, GUI_GREEN);
-    CHECKBOX_SetText(hCHKBX_EnableSecurity, "Enable Security Module");
-    CHECKBOX_SetState(hCHKBX_EnableSecurity, g_display_settings.security_module_enabled);
+    if (create) {
+        hCHKBX_EnableSecurity = CHECKBOX_CreateEx(col1_x, y_current, 240, 20, hPage, WM_CF_SHOW, 0, ID_ENABLE_SECURITY_MODULE);
+        CHECKBOX_SetTextColor(hCHKBX_EnableSecurity, GUI_GREEN);
+        CHECKBOX_SetText(hCHKBX_EnableSecurity, "Enable Security Module");
 
-    SPINBOX_Handle hPulse = SPINBOX_CreateEx(col2_x, y_current, spin_w, spin_h, 0, WM_CF_SHOW, ID_ALARM_PULSE_LENGTH, 0, 50);
-    SPINBOX_SetEdge(hPulse, SPINBOX_EDGE_CENTER);
-    SPINBOX_SetValue(hPulse, Security_GetPulseDuration() / 100);
+        SPINBOX_Handle hPulse = SPINBOX_CreateEx(col2_x, y_current, spin_w, spin_h, hPage, WM_CF_SHOW, ID_ALARM_PULSE_LENGTH, 0, 50);
+        SPINBOX_SetEdge(hPulse, SPINBOX_EDGE_CENTER);
+    }
+    CHECKBOX_SetState(hCHKBX_EnableSecurity, g_display_settings.security_module_enabled);
+    SPINBOX_SetValue(WM_GetDialogItem(hPage, ID_ALARM_PULSE_LENGTH), Security_GetPulseDuration() / 100);
     GUI_SetFont(GUI_FONT_13_1);
     GUI_SetColor(GUI_WHITE);
     GUI_SetTextAlign(GUI_TA_LEFT | GUI_TA_VCENTER);
@@ -4970,38 +5324,24 @@ static void DSP_InitSet9Scrn(void)
     // === KRAJ ISPRAVLJENOG DIJELA ===
 
     // Navigaciona dugmad ostaju na fiksnoj poziciji desno
-    hBUTTON_Next = BUTTON_CreateEx(410, 180, 60, 30, 0, WM_CF_SHOW, 0, ID_Next);
-    BUTTON_SetText(hBUTTON_Next, "NEXT");
-    hBUTTON_Ok = BUTTON_CreateEx(410, 230, 60, 30, 0, WM_CF_SHOW, 0, ID_Ok);
-    BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    if (create) {
+        hBUTTON_Next = BUTTON_CreateEx(410, 180, 60, 30, hPage, WM_CF_SHOW, 0, ID_Next);
+        BUTTON_SetText(hBUTTON_Next, "NEXT");
+        hBUTTON_Ok = BUTTON_CreateEx(410, 230, 60, 30, hPage, WM_CF_SHOW, 0, ID_Ok);
+        BUTTON_SetText(hBUTTON_Ok, "SAVE");
+    }
 
     GUI_MULTIBUF_EndEx(1);
 }
 
 /**
- ******************************************************************************
- * @brief       Briše GUI widgete sa devetog ekrana za podešavanja (Alarm).
- ******************************************************************************
+ * @brief Sakriva GUI widgete sa devetog ekrana podešavanja.
+ * @note Widgeti ostaju u kontejneru stranice i ponovo se prikazuju pri
+ * sljedećem ulasku, bez brisanja i ponovnog kreiranja.
  */
 static void DSP_KillSet9Scrn(void)
 {
-    // Brisanje svih widgeta kreiranih u DSP_InitSet9Scrn
-    for(int i = 0; i < SECURITY_PARTITION_COUNT; i++) {
-        WM_DeleteWindow(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_RELAY_P1 + i));
-        WM_DeleteWindow(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_FB_P1 + i));
-    }
-    
-    WM_DeleteWindow(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_RELAY_SILENT));
-    WM_DeleteWindow(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_FB_SYSTEM_STATUS));
-    WM_DeleteWindow(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_PULSE_LENGTH));
-    
-    if(WM_IsWindow(hCHKBX_EnableSecurity)) {
-        WM_DeleteWindow(hCHKBX_EnableSecurity);
-        hCHKBX_EnableSecurity = 0;
-    }
-
-    WM_DeleteWindow(hBUTTON_Next);
-    WM_DeleteWindow(hBUTTON_Ok);
+    DSP_SettingsPageHide(SCREEN_SETTINGS_9);
 }
 
 /**
@@ -5441,7 +5781,8 @@ static void DSP_KillSceneEditScreen(void)
  * @author      Gemini & [Vaše Ime]
  * @note        Funkcija je ažurirana da u `TIMER` modu više ne prikazuje
  * opciju "Nijedna", već koristi svih 6 slotova za prikaz
- * postojećih, konfigurisanih scena.
+ * postojećih, konfigurisanih scena. Ako ih ima više, prikazuje se
+ * stranica `scenes_page` sa indikatorom za listanje.
  ******************************************************************************
  */
 static void DSP_InitSceneAppearanceScreen(void)
@@ -5463,13 +5804,13 @@ static void DSP_InitSceneAppearanceScreen(void)
 
         // KORAK 1: Uklonjen kod za iscrtavanje opcije "Nijedna"
 
-        // KORAK 2: Iscrtaj sve konfigurisane scene, počevši od prvog slota
-        uint8_t display_index = 0; // Počinjemo od prvog slota
-        for (int i = 0; i < SCENE_MAX_COUNT; i++) {
-            Scene_t* scene_handle = Scene_GetInstance(i);
-            if (scene_handle && scene_handle->is_configured) {
-                if (display_index >= (scene_screen_layout.items_per_row * 2)) break; // Prekidamo ako smo popunili ekran
-
+        // KORAK 2: Iscrtaj konfigurisane scene sa trenutne stranice, počevši od prvog slota
+        const uint8_t scenes_on_page = DISP_GridPageItems(Scene_GetCount(), &scenes_page);
+        DISP_DrawGridPager(scenes_page, DISP_GridPageCount(Scene_GetCount()));
+        for (uint8_t display_index = 0; display_index < scenes_on_page; display_index++) {
+            int8_t scene_index = DISP_SceneByOrdinal((scenes_page * DEVICES_PER_PAGE) + display_index);
+            Scene_t* scene_handle = (scene_index >= 0) ? Scene_GetInstance(scene_index) : NULL;
+            if (scene_handle) {
                 const SceneAppearance_t* appearance = &scene_appearance_table[scene_handle->appearance_id];
                 int row = display_index / scene_screen_layout.items_per_row;
                 int col = display_index % scene_screen_layout.items_per_row;
@@ -5487,8 +5828,6 @@ static void DSP_InitSceneAppearanceScreen(void)
                 GUI_SetColor(GUI_ORANGE);
                 GUI_SetTextAlign(GUI_TA_HCENTER);
                 GUI_DispStringAt(lng(appearance->text_id), x_center, y_center + scene_screen_layout.text_y_offset);
-
-                display_index++;
             }
         }
     } else {
@@ -5973,99 +6312,14 @@ static void DSP_KillGateScreen(void)
  * @author      Gemini & [Vaše Ime]
  * @note        Ova funkcija je srž logike za pozadinske procese koji se ne
  * odnose direktno na trenutni ekran. Uključuje logiku
- * screensaver-a, tajmera za automatsko paljenje svjetala,
- * detekciju dugog pritiska i ažuriranje vremena. Refaktorisana
+ * screensaver-a, tajmera za automatsko paljenje svjetala
+ * i ažuriranje vremena. Dugi pritisak se obrađuje u
+ * `Handle_GestureEvents`. Refaktorisana
  * je da koristi isključivo javne API-je drugih modula.
  ******************************************************************************
  */
 static void Handle_PeriodicEvents(void)
 {
-    
-    if (scene_press_timer_start != 0 && (HAL_GetTick() - scene_press_timer_start) > LONG_PRESS_DURATION)
-    {
-        uint8_t configured_scenes_count = Scene_GetCount();
-
-        if (scene_pressed_index != -1 && scene_pressed_index < configured_scenes_count)
-        {
-            uint8_t scene_counter = 0;
-            for (int i = 0; i < SCENE_MAX_COUNT; i++)
-            {
-                Scene_t* temp_handle = Scene_GetInstance(i);
-                if (temp_handle && temp_handle->is_configured)
-                {
-                    if (scene_counter == scene_pressed_index)
-                    {
-                        scene_edit_index = i;
-                        break;
-                    }
-                    scene_counter++;
-                }
-            }
-
-            // --- ISPRAVNA NAVIGACIJA ---
-            DSP_KillSceneScreen();          // 1. Ubij stari ekran
-            DSP_InitSceneEditScreen();      // 2. Inicijalizuj novi ekran
-            screen = SCREEN_SCENE_EDIT;     // 3. Postavi novo stanje
-            shouldDrawScreen = 0;           // 4. Ne treba ponovo crtati
-
-            scene_press_timer_start = 0;
-            scene_pressed_index = -1;
-        }
-    }
-    
-    // === AŽURIRANI BLOK: DETEKCIJA DUGOG PRITISKA ZA KAPIJE ===
-    if (gate_press_timer_start != 0 && (HAL_GetTick() - gate_press_timer_start) > LONG_PRESS_DURATION)
-    {
-        // Dugi pritisak je detektovan.
-
-        // Sačuvaj indeks kapije za koju treba otvoriti panel.
-        gate_control_panel_index = gate_pressed_index;
-
-        // Resetuj tajmer i stanje pritiska da se akcija ne ponovi.
-        gate_press_timer_start = 0;
-        gate_pressed_index = -1;
-
-        // Pokreni tranziciju na novi ekran za podešavanja kapije
-        DSP_KillGateScreen();                  // 1. Ubij stari ekran (dashboard)
-        DSP_InitGateSettingsScreen();          // 2. Inicijalizuj novi ekran (podešavanja)
-        screen = SCREEN_GATE_SETTINGS;         // 3. Postavi novo stanje
-        shouldDrawScreen = 0;                  // 4. Ne treba ponovo crtati jer je Init to već uradio
-    }
-    // === KRAJ AŽURIRANOG BLOKA ===
-
-    // === KRAJ NOVOG BLOKA ===
-    if (rename_light_timer_start && (HAL_GetTick() - rename_light_timer_start) >= 2000)
-    {
-        rename_light_timer_start = 0; // Resetuj tajmer
-
-        LIGHT_Handle* handle = (light_selectedIndex < LIGHTS_MODBUS_SIZE) ? LIGHTS_GetInstance(light_selectedIndex) : NULL;
-        if(handle) {
-            // Pripremi kontekst za tastaturu
-            KeyboardContext_t kbd_context = {
-                .title = lng(TXT_ENTER_NEW_NAME),
-                .max_len = 20
-            };
-            strncpy(kbd_context.initial_value, LIGHT_GetCustomLabel(handle), sizeof(kbd_context.initial_value) - 1);
-
-            // Postavi "povratnu adresu"
-            keyboard_return_screen = screen;
-            // Kopiraj kontekst u globalnu varijablu
-            memcpy(&g_keyboard_context, &kbd_context, sizeof(KeyboardContext_t));
-            // Resetuj rezultat
-            memset(&g_keyboard_result, 0, sizeof(KeyboardResult_t));
-            keyboard_shift_active = false;
-
-            // Postavi novi ekran
-            screen = SCREEN_KEYBOARD_ALPHA;
-
-            // === FORSIRANO ISCRTAVANJE ODMAH ===
-            DSP_KillLightSettingsScreen();
-            DSP_InitKeyboardScreen();
-            // Postavi fleg da se izbjegne duplo iscrtavanje u DISP_Service
-            shouldDrawScreen = 0;
-        }
-        return; // Prekini dalje izvršavanje u ovoj funkciji
-    }
     // === "FAIL-SAFE" SKENER ZA DUHOVE (Ovaj dio ostaje nepromijenjen) ===
     static uint32_t ghost_widget_scan_timer = 0;
     if ((HAL_GetTick() - ghost_widget_scan_timer) >= GHOST_WIDGET_SCAN_INTERVAL) {
@@ -6082,7 +6336,7 @@ static void Handle_PeriodicEvents(void)
 
         // Refaktorisana petlja koja koristi novi API
         RTC_TimeTypeDef currentTime;
-        HAL_RTC_GetTime(&hrtc, &currentTime, RTC_FORMAT_BCD);
+        Timer_GetWallClock(&currentTime, NULL);
         uint8_t currentHour = Bcd2Dec(currentTime.Hours);
         uint8_t currentMinute = Bcd2Dec(currentTime.Minutes);
 
@@ -6104,43 +6358,6 @@ static void Handle_PeriodicEvents(void)
         }
     }
 
-    // === TAJMER ZA ULAZAK U MOD PODEŠAVANJA (Ovaj dio ostaje nepromijenjen) ===
-    if (light_settingsTimerStart && ((HAL_GetTick() - light_settingsTimerStart) >= (2 * 1000))) {
-        light_settingsTimerStart = 0;
-        light_settings_return_screen = screen;
-        screen = SCREEN_LIGHT_SETTINGS;
-        shouldDrawScreen = 1;
-    }
-
-    
-    // =======================================================================
-    // ===          FINALNI BLOK: Detekcija dugog pritiska za Alarm        ===
-    // =======================================================================
-    if (dynamic_icon_alarm_press_timer != 0 && (HAL_GetTick() - dynamic_icon_alarm_press_timer) > LONG_PRESS_DURATION)
-    {
-        // Dugi pritisak je detektovan.
-        dynamic_icon_alarm_press_timer = 0; // Resetuj tajmer da se akcija ne ponovi.
-        
-        // Pokreni tranziciju na ekran za PODEŠAVANJA alarma.
-        // DSP_Kill... se ne poziva ovdje jer prelazimo sa SELECT ekrana koji nema widgete.
-        DSP_InitSettingsAlarmScreen();
-        screen = SCREEN_SETTINGS_ALARM;
-        shouldDrawScreen = 0;
-    }
-
-    // =======================================================================
-    // ===          FINALNI BLOK: Detekcija dugog pritiska za Timer        ===
-    // =======================================================================
-    if (dynamic_icon_timer_press_timer != 0 && (HAL_GetTick() - dynamic_icon_timer_press_timer) > LONG_PRESS_DURATION)
-    {
-        // Dugi pritisak je detektovan.
-        dynamic_icon_timer_press_timer = 0; // Resetuj tajmer.
-        
-        // Pokreni tranziciju na ekran za PODEŠAVANJA tajmera.
-        Timer_Suppress();
-        screen = SCREEN_SETTINGS_TIMER;
-        shouldDrawScreen = 1;
-    }
     // === SCREENSAVER TAJMER ===
     if (!IsScrnsvrActiv()) {
         if ((HAL_GetTick() - scrnsvr_tmr) >= (uint32_t)(g_display_settings.scrnsvr_tout * 1000)) {
@@ -6182,20 +6399,9 @@ static void Handle_PeriodicEvents(void)
                 pin_change_state = PIN_CHANGE_IDLE; // Resetuj stanje promjene PIN-a
                 DSP_KillNumpadScreen();
             }
-            // =======================================================================
-            // ===        Originalna logika za ekrane podešavanja ostaje         ===
-            // =======================================================================
-            else if (screen == SCREEN_SETTINGS_1)       DSP_KillSet1Scrn();
-            else if (screen == SCREEN_SETTINGS_2)       DSP_KillSet2Scrn();
-            else if (screen == SCREEN_SETTINGS_3)       DSP_KillSet3Scrn();
-            else if (screen == SCREEN_SETTINGS_4)       DSP_KillSet4Scrn();
-            else if (screen == SCREEN_SETTINGS_5)       DSP_KillSet5Scrn();
-            else if (screen == SCREEN_SETTINGS_6)       DSP_KillSet6Scrn();
-            else if (screen == SCREEN_SETTINGS_7)       DSP_KillSet7Scrn();
-            else if (screen == SCREEN_LIGHT_SETTINGS)   DSP_KillLightSettingsScreen();
-            else if (screen == SCREEN_SETTINGS_DATETIME)DSP_KillSettingsDateTimeScreen();
             else if (screen == SCREEN_SETTINGS_TIMER)   DSP_KillSettingsTimerScreen(),Timer_Unsuppress();
-            else if (screen == SCREEN_TIMER)            DSP_KillTimerScreen();
+            // Ostali ekrani (podešavanja, datum/vrijeme, tajmer...) preko registra
+            else if (DISP_GetScreenOps(screen) && DISP_GetScreenOps(screen)->exit) DISP_GetScreenOps(screen)->exit();
 
             // Aktivacija screensaver-a (ostaje isto)
             DISPSetBrightnes(g_display_settings.low_bcklght);
@@ -6212,8 +6418,199 @@ static void Handle_PeriodicEvents(void)
             refresh_tmr = 0;
             if (!IsScrnsvrActiv()) MVUpdateSet();
         }
-        // Poziv za iscrtavanje sata (logika će biti dorađena kako smo diskutovali)
-        if (screen < SCREEN_SELECT_1) DISPDateTime();
+        // Poziv za iscrtavanje sata (logika će biti dorađena kako smo diskutovali)
+        if (screen < SCREEN_SELECT_1) DISPDateTime();
+    }
+}
+/**
+ ******************************************************************************
+ * @brief       Obrađuje gestove koje je prepoznao `TS_Service`.
+ * @note        Gestovi se prepoznaju iz niza očitanja touch kontrolera, pa
+ * dugi pritisak više ne zavisi od provjere tajmera u periodičnoj petlji.
+ * Tajmeri `..._press_timer_start` ostaju samo kao oznaka da je pritisak
+ * započeo na elementu koji podržava dugi pritisak; otpuštanje ih briše.
+ ******************************************************************************
+ */
+static void Handle_GestureEvents(void)
+{
+    TS_GestureTypeDef gesture;
+
+    while ((gesture = TS_GetGesture()) != TS_GESTURE_NONE)
+    {
+        switch (gesture)
+        {
+        case TS_GESTURE_LONG_PRESS:
+            Handle_LongPressGesture();
+            break;
+        case TS_GESTURE_LONG_HOLD:
+            Handle_LongHoldGesture();
+            break;
+        case TS_GESTURE_DOUBLE_TAP:
+            // Skriveni ulaz u dijagnostiku: dupli dodir na prvom ekranu podešavanja
+            if (screen == SCREEN_SETTINGS_1)
+            {
+                DSP_KillSet1Scrn();
+                GUI_SelectLayer(0);
+                GUI_Clear();
+                GUI_SelectLayer(1);
+                GUI_Clear();
+                screen = SCREEN_PROFILER;
+                shouldDrawScreen = 1;
+            }
+            // Grafici istorije: dupli dodir na ekranu termostata
+            else if ((screen == SCREEN_THERMOSTAT) && !is_in_scene_wizard_mode)
+            {
+                thermostatMenuState = 0;
+                GUI_SelectLayer(0);
+                GUI_Clear();
+                GUI_SelectLayer(1);
+                GUI_Clear();
+                screen = SCREEN_HISTORY;
+                shouldDrawScreen = 1;
+            }
+            break;
+        default:
+            // Swipe za sada ne koristi nijedan ekran.
+            break;
+        }
+    }
+}
+/**
+ ******************************************************************************
+ * @brief       Dugi pritisak (LONG_PRESS_DURATION) na scenu, kapiju ili
+ * dinamičku ikonicu alarma/tajmera.
+ ******************************************************************************
+ */
+static void Handle_LongPressGesture(void)
+{
+    if (scene_press_timer_start != 0)
+    {
+        uint8_t configured_scenes_count = Scene_GetCount();
+
+        if (scene_pressed_index != -1 && scene_pressed_index < configured_scenes_count)
+        {
+            uint8_t scene_counter = 0;
+            for (int i = 0; i < SCENE_MAX_COUNT; i++)
+            {
+                Scene_t* temp_handle = Scene_GetInstance(i);
+                if (temp_handle && temp_handle->is_configured)
+                {
+                    if (scene_counter == scene_pressed_index)
+                    {
+                        scene_edit_index = i;
+                        break;
+                    }
+                    scene_counter++;
+                }
+            }
+
+            // --- ISPRAVNA NAVIGACIJA ---
+            DSP_KillSceneScreen();          // 1. Ubij stari ekran
+            DSP_InitSceneEditScreen();      // 2. Inicijalizuj novi ekran
+            screen = SCREEN_SCENE_EDIT;     // 3. Postavi novo stanje
+            shouldDrawScreen = 0;           // 4. Ne treba ponovo crtati
+
+            scene_press_timer_start = 0;
+            scene_pressed_index = -1;
+        }
+    }
+
+    // === AŽURIRANI BLOK: DETEKCIJA DUGOG PRITISKA ZA KAPIJE ===
+    if (gate_press_timer_start != 0)
+    {
+        // Dugi pritisak je detektovan.
+
+        // Sačuvaj indeks kapije za koju treba otvoriti panel.
+        gate_control_panel_index = gate_pressed_index;
+
+        // Resetuj tajmer i stanje pritiska da se akcija ne ponovi.
+        gate_press_timer_start = 0;
+        gate_pressed_index = -1;
+
+        // Pokreni tranziciju na novi ekran za podešavanja kapije
+        DSP_KillGateScreen();                  // 1. Ubij stari ekran (dashboard)
+        DSP_InitGateSettingsScreen();          // 2. Inicijalizuj novi ekran (podešavanja)
+        screen = SCREEN_GATE_SETTINGS;         // 3. Postavi novo stanje
+        shouldDrawScreen = 0;                  // 4. Ne treba ponovo crtati jer je Init to već uradio
+    }
+    // === KRAJ AŽURIRANOG BLOKA ===
+
+    // =======================================================================
+    // ===          FINALNI BLOK: Detekcija dugog pritiska za Alarm        ===
+    // =======================================================================
+    if (dynamic_icon_alarm_press_timer != 0)
+    {
+        // Dugi pritisak je detektovan.
+        dynamic_icon_alarm_press_timer = 0; // Resetuj tajmer da se akcija ne ponovi.
+        
+        // Pokreni tranziciju na ekran za PODEŠAVANJA alarma.
+        // DSP_Kill... se ne poziva ovdje jer prelazimo sa SELECT ekrana koji nema widgete.
+        DSP_InitSettingsAlarmScreen();
+        screen = SCREEN_SETTINGS_ALARM;
+        shouldDrawScreen = 0;
+    }
+
+    // =======================================================================
+    // ===          FINALNI BLOK: Detekcija dugog pritiska za Timer        ===
+    // =======================================================================
+    if (dynamic_icon_timer_press_timer != 0)
+    {
+        // Dugi pritisak je detektovan.
+        dynamic_icon_timer_press_timer = 0; // Resetuj tajmer.
+        
+        // Pokreni tranziciju na ekran za PODEŠAVANJA tajmera.
+        Timer_Suppress();
+        screen = SCREEN_SETTINGS_TIMER;
+        shouldDrawScreen = 1;
+    }
+}
+/**
+ ******************************************************************************
+ * @brief       Produženi pritisak (2 s) za izmjenu naziva svjetla i ulazak u
+ * podešavanja svjetla.
+ ******************************************************************************
+ */
+static void Handle_LongHoldGesture(void)
+{
+    if (rename_light_timer_start)
+    {
+        rename_light_timer_start = 0; // Resetuj tajmer
+
+        LIGHT_Handle* handle = (light_selectedIndex < LIGHTS_MODBUS_SIZE) ? LIGHTS_GetInstance(light_selectedIndex) : NULL;
+        if(handle) {
+            // Pripremi kontekst za tastaturu
+            KeyboardContext_t kbd_context = {
+                .title = lng(TXT_ENTER_NEW_NAME),
+                .max_len = 20
+            };
+            strncpy(kbd_context.initial_value, LIGHT_GetCustomLabel(handle), sizeof(kbd_context.initial_value) - 1);
+
+            // Postavi "povratnu adresu"
+            keyboard_return_screen = screen;
+            // Kopiraj kontekst u globalnu varijablu
+            memcpy(&g_keyboard_context, &kbd_context, sizeof(KeyboardContext_t));
+            // Resetuj rezultat
+            memset(&g_keyboard_result, 0, sizeof(KeyboardResult_t));
+            keyboard_shift_active = false;
+
+            // Postavi novi ekran
+            screen = SCREEN_KEYBOARD_ALPHA;
+
+            // === FORSIRANO ISCRTAVANJE ODMAH ===
+            DSP_KillLightSettingsScreen();
+            DSP_InitKeyboardScreen();
+            // Postavi fleg da se izbjegne duplo iscrtavanje u DISP_Service
+            shouldDrawScreen = 0;
+        }
+        return; // Pritisak je potrošen, ne otvaraj i podešavanja svjetla
+    }
+
+    // === ULAZAK U MOD PODEŠAVANJA SVJETLA ===
+    if (light_settingsTimerStart) {
+        light_settingsTimerStart = 0;
+        light_settings_return_screen = screen;
+        screen = SCREEN_LIGHT_SETTINGS;
+        shouldDrawScreen = 1;
     }
 }
 /**
@@ -6315,6 +6712,16 @@ static void HandleTouchPressEvent(GUI_PID_STATE * pTS, uint8_t *click_flag)
     {
         HandlePress_TimerScreen(pTS, click_flag);
     }
+    else if(screen == SCREEN_HISTORY)
+    {
+        HandlePress_HistoryScreen(pTS, click_flag);
+    }
+    else if(screen == SCREEN_PROFILER)
+    {
+        // Bilo koji dodir zatvara dijagnostički ekran
+        *click_flag = 1;
+        screen = SCREEN_RETURN_TO_FIRST;
+    }
 }
 
 /**
@@ -6897,18 +7304,21 @@ static void HandlePress_LightsScreen(GUI_PID_STATE * pTS, uint8_t *click_flag)
     light_selectedIndex = LIGHTS_MODBUS_SIZE + 1;
     light_settingsTimerStart = 0;
 
-    // Logika za dinamički raspored i detekciju dodira.
-    int y = (LIGHTS_Rows_getCount() > 1) ? 10 : 86;
-    uint8_t lightsInRowSum = 0;
+    // Dodir na zonu za listanje samo mijenja stranicu mreže.
+    if (DISP_GridPagerPressed(pTS, &lights_page, DISP_GridPageCount(LIGHTS_getCount()))) {
+        *click_flag = 1;
+        return;
+    }
+
+    // Logika za dinamički raspored i detekciju dodira na prikazanoj stranici.
+    const uint8_t lights_on_page = DISP_GridPageItems(LIGHTS_getCount(), &lights_page);
+    const uint8_t rows = DISP_GridRows(lights_on_page);
+    int y = (rows > 1) ? 10 : 86;
+    uint8_t lightsInRowSum = lights_page * DEVICES_PER_PAGE;
 
     // Prolazimo kroz redove ikonica...
-    for(uint8_t row = 0; row < LIGHTS_Rows_getCount(); ++row) {
-        uint8_t lightsInRow = LIGHTS_getCount();
-        if(LIGHTS_getCount() > 3) {
-            if(LIGHTS_getCount() == 4) lightsInRow = 2;
-            else if(LIGHTS_getCount() == 5) lightsInRow = (row > 0) ? 2 : 3;
-            else lightsInRow = 3;
-        }
+    for(uint8_t row = 0; row < rows; ++row) {
+        uint8_t lightsInRow = DISP_GridRowItems(lights_on_page, row);
         uint8_t currentLightsMenuSpaceBetween = (400 - (80 * lightsInRow)) / (lightsInRow - 1 + 2);
 
         // ...i kroz ikonice u trenutnom redu.
@@ -7277,19 +7687,21 @@ static void HandlePress_SceneAppearanceScreen(GUI_PID_STATE* pTS, uint8_t* click
         /********************************************/
         /* MOD: ODABIR POSTOJEĆE SCENE ZA TAJMER    */
         /********************************************/
+        // Dodir na zonu za listanje samo mijenja stranicu, birač ostaje otvoren
+        if (DISP_GridPagerPressed(pTS, &scenes_page, DISP_GridPageCount(Scene_GetCount()))) {
+            DSP_InitSceneAppearanceScreen();
+            shouldDrawScreen = 0;
+            return;
+        }
+
         int row = (pTS->y - 10) / scene_screen_layout.slot_height;
         int col = pTS->x / scene_screen_layout.slot_width;
         int touched_display_index = row * scene_screen_layout.items_per_row + col;
 
-        uint8_t configured_scene_counter = 0;
-        for (int i = 0; i < SCENE_MAX_COUNT; i++) {
-            Scene_t* scene_handle = Scene_GetInstance(i);
-            if (scene_handle && scene_handle->is_configured) {
-                if (configured_scene_counter == touched_display_index) {
-                    timer_selected_scene_index = i; // Spremi stvarni fizički indeks scene
-                    break;
-                }
-                configured_scene_counter++;
+        if ((pTS->x < DRAWING_AREA_WIDTH) && (touched_display_index < DISP_GridPageItems(Scene_GetCount(), &scenes_page))) {
+            int8_t scene_index = DISP_SceneByOrdinal((scenes_page * DEVICES_PER_PAGE) + touched_display_index);
+            if (scene_index >= 0) {
+                timer_selected_scene_index = scene_index; // Spremi stvarni fizički indeks scene
             }
         }
 
@@ -7457,6 +7869,11 @@ static void HandlePress_SceneScreen(GUI_PID_STATE * pTS, uint8_t *click_flag)
         scene_pressed_index = configured_scenes_count; // Postavi indeks na poziciju čarobnjaka
         scene_press_timer_start = HAL_GetTick() ? HAL_GetTick() : 1;
     }
+    // --- Provjera dodira na zonu za listanje stranica ---
+    else if (DISP_GridPagerPressed(pTS, &scenes_page, DISP_GridPageCount(configured_scenes_count)))
+    {
+        *click_flag = 1;
+    }
     // --- Provjera dodira na Mrežu sa Scenama ---
     else if (pTS->x < DRAWING_AREA_WIDTH) // Osiguraj da dodir nije u zoni menija
     {
@@ -7464,10 +7881,10 @@ static void HandlePress_SceneScreen(GUI_PID_STATE * pTS, uint8_t *click_flag)
         int col = pTS->x / scene_screen_layout.slot_width;
         int touched_slot_index = row * scene_screen_layout.items_per_row + col;
 
-        if (touched_slot_index < configured_scenes_count)
+        if (touched_slot_index < DISP_GridPageItems(configured_scenes_count, &scenes_page))
         {
             *click_flag = 1;
-            scene_pressed_index = touched_slot_index;
+            scene_pressed_index = (scenes_page * DEVICES_PER_PAGE) + touched_slot_index;
             scene_press_timer_start = HAL_GetTick() ? HAL_GetTick() : 1;
         }
     }
@@ -7502,12 +7919,20 @@ static void HandlePress_GateSettingsScreen(GUI_PID_STATE* pTS, uint8_t* click_fl
 static void HandlePress_GateScreen(GUI_PID_STATE * pTS, uint8_t *click_flag)
 {
     uint8_t gate_count = Gate_GetCount();
+
+    // Dodir na zonu za listanje samo mijenja stranicu mreže
+    if (DISP_GridPagerPressed(pTS, &gates_page, DISP_GridPageCount(gate_count))) {
+        *click_flag = 1;
+        return;
+    }
+
     if (gate_count == 0 || pTS->x >= DRAWING_AREA_WIDTH) {
         return; // Nema šta da se pritisne ili je pritisak u zoni menija
     }
 
     // Koristimo istu logiku za raspored kao u Service_GateScreen
-    uint8_t rows = (gate_count > 3) ? 2 : 1;
+    const uint8_t gates_on_page = DISP_GridPageItems(gate_count, &gates_page);
+    uint8_t rows = DISP_GridRows(gates_on_page);
     int y_row_start = (rows > 1)
                       ? lights_and_gates_grid_layout.y_start_pos_multi_row
                       : lights_and_gates_grid_layout.y_start_pos_single_row;
@@ -7518,12 +7943,7 @@ static void HandlePress_GateScreen(GUI_PID_STATE * pTS, uint8_t *click_flag)
     if (row_touched >= rows) return;
 
     // Određivanje broja stavki u dodirnutom redu
-    uint8_t gatesInRow = gate_count;
-    if (gate_count > 3) {
-        if (gate_count == 4) gatesInRow = 2;
-        else if (gate_count == 5) gatesInRow = (row_touched > 0) ? 2 : 3;
-        else gatesInRow = 3;
-    }
+    uint8_t gatesInRow = DISP_GridRowItems(gates_on_page, row_touched);
 
     // Određivanje kolone na osnovu X koordinate
     uint8_t space_between = (400 - (80 * gatesInRow)) / (gatesInRow - 1 + 2);
@@ -7533,11 +7953,10 @@ static void HandlePress_GateScreen(GUI_PID_STATE * pTS, uint8_t *click_flag)
     // Izračunavanje finalnog indeksa
     uint8_t gatesInPreviousRows = 0;
     if (row_touched > 0) { // Ako je dodirnut drugi red
-        if (gate_count == 4) gatesInPreviousRows = 2;
-        else gatesInPreviousRows = 3;
+        gatesInPreviousRows = DISP_GridRowItems(gates_on_page, 0);
     }
 
-    int8_t touched_index = gatesInPreviousRows + col_touched;
+    int8_t touched_index = (int8_t)((gates_page * DEVICES_PER_PAGE) + gatesInPreviousRows + col_touched);
 
     if (touched_index < gate_count)
     {
@@ -9015,17 +9434,23 @@ static void Service_ThermostatScreen(void)
 
             GUI_MULTIBUF_BeginEx(0);
             GUI_SelectLayer(0);
-            GUI_SetColor(GUI_BLACK);
-            GUI_Clear();
-            // Iscrtavanje pozadinske bitmap slike termostata.
-            GUI_BMP_Draw(&thstat, 0, 0);
-            GUI_ClearRect(380, 0, 480, 100);
-            // Iscrtavanje hamburger meni ikonice u gornjem desnom uglu.
-            DrawHamburgerMenu(1);
-
-            // Čišćenje specifičnih dijelova ekrana za dinamičke vrijednosti.
-            GUI_ClearRect(350, 80, 480, 180);
-            GUI_ClearRect(310, 180, 420, 205);
+            // Dekodiranje BMP slike iz QSPI-ja je sporo, pa se pozadina iscrtava
+            // samo jednom, a svaki sljedeći ulazak je jedan DMA2D prenos iz SDRAM keša.
+            const uint32_t bkg_key = DISP_BkgCacheKey(BKG_SLOT_THERMOSTAT);
+            if (!DISP_BkgCacheRestore(BKG_SLOT_THERMOSTAT, 0, bkg_key)) {
+                GUI_SetColor(GUI_BLACK);
+                GUI_Clear();
+                // Iscrtavanje pozadinske bitmap slike termostata.
+                GUI_BMP_Draw(&thstat, 0, 0);
+                GUI_ClearRect(380, 0, 480, 100);
+                // Iscrtavanje hamburger meni ikonice u gornjem desnom uglu.
+                DrawHamburgerMenu(1);
+
+                // Čišćenje specifičnih dijelova ekrana za dinamičke vrijednosti.
+                GUI_ClearRect(350, 80, 480, 180);
+                GUI_ClearRect(310, 180, 420, 205);
+                DISP_BkgCacheStore(BKG_SLOT_THERMOSTAT, 0, bkg_key);
+            }
             GUI_MULTIBUF_EndEx(0);
 
             // Prebacivanje na drugi sloj za dinamičke elemente.
@@ -9102,8 +9527,7 @@ static void Service_ThermostatScreen(void)
                 if(IsRtcTimeValid()) {
                     RTC_TimeTypeDef rtctm_local;
                     RTC_DateTypeDef rtcdt_local;
-                    HAL_RTC_GetTime(&hrtc, &rtctm_local, RTC_FORMAT_BCD);
-                    HAL_RTC_GetDate(&hrtc, &rtcdt_local, RTC_FORMAT_BCD);
+                    Timer_GetWallClock(&rtctm_local, &rtcdt_local);
                     char dbuf_time[8];
                     HEX2STR(dbuf_time, &rtctm_local.Hours);
                     dbuf_time[2] = ':';
@@ -9173,6 +9597,9 @@ static void Service_ReturnToFirst(void)
     lightsModbusSettingsMenu = 0;
     light_selectedIndex = LIGHTS_MODBUS_SIZE + 1;
     lights_allSelected_hasRGB = false;
+    lights_page = 0;
+    gates_page = 0;
+    scenes_page = 0;
 
     // Postavi flag za ponovno iscrtavanje ekrana.
     shouldDrawScreen = 1;
@@ -9200,25 +9627,21 @@ static void Service_SceneScreen(void)
         DrawHamburgerMenu(1);
 
         uint8_t configured_scenes_count = Scene_GetCount();
-        uint8_t configured_scene_tracker = 0;
+
+        // Na ekranu je jedna stranica mreže (do DEVICES_PER_PAGE scena)
+        const uint8_t scenes_on_page = DISP_GridPageItems(configured_scenes_count, &scenes_page);
+        DISP_DrawGridPager(scenes_page, DISP_GridPageCount(configured_scenes_count));
 
         // --- Iscrtavanje postojećih, konfigurisanih scena u mreži ---
-        for (int i = 0; i < configured_scenes_count; i++)
+        for (int i = 0; i < scenes_on_page; i++)
         {
             const SceneAppearance_t* appearance = NULL;
 
-            // Pronađi i-tu po redu konfigurisanu scenu
-            for (int k = configured_scene_tracker; k < SCENE_MAX_COUNT; k++)
-            {
-                Scene_t* temp_handle = Scene_GetInstance(k);
-                if (temp_handle && temp_handle->is_configured)
-                {
-                    if (temp_handle->appearance_id < (sizeof(scene_appearance_table) / sizeof(SceneAppearance_t))) {
-                        appearance = &scene_appearance_table[temp_handle->appearance_id];
-                    }
-                    configured_scene_tracker = k + 1;
-                    break;
-                }
+            // Pronađi scenu po njenom rednom broju među konfigurisanim
+            int8_t scene_index = DISP_SceneByOrdinal((scenes_page * DEVICES_PER_PAGE) + i);
+            Scene_t* temp_handle = (scene_index >= 0) ? Scene_GetInstance(scene_index) : NULL;
+            if (temp_handle && (temp_handle->appearance_id < (sizeof(scene_appearance_table) / sizeof(SceneAppearance_t)))) {
+                appearance = &scene_appearance_table[temp_handle->appearance_id];
             }
 
             if (!appearance) continue;
@@ -9237,8 +9660,19 @@ static void Service_SceneScreen(void)
                 GUI_DrawBitmap(icon_to_draw, x_center - (icon_to_draw->XSize / 2), y_center - (icon_to_draw->YSize / 2));
             }
 
+            // Naziv posljednje aktivirane scene pokazuje ishod: u toku, primijenjena, greška
+            GUI_COLOR text_color = GUI_ORANGE;
+            if (scene_index == Scene_GetLastActivated()) {
+                switch (Scene_GetApplyStats(scene_index)->state) {
+                    case SCENE_APPLY_RUNNING:   text_color = GUI_YELLOW;    break;
+                    case SCENE_APPLY_DONE:      text_color = GUI_GREEN;     break;
+                    case SCENE_APPLY_FAILED:    text_color = GUI_RED;       break;
+                    default:                                                break;
+                }
+            }
+
             GUI_SetFont(&GUI_FontVerdana16_LAT);
-            GUI_SetColor(GUI_ORANGE);
+            GUI_SetColor(text_color);
             GUI_SetTextMode(GUI_TM_TRANS);
             GUI_SetTextAlign(GUI_TA_HCENTER);
             GUI_DispStringAt(lng(appearance->text_id), x_center, y_center + scene_screen_layout.text_y_offset);
@@ -9289,22 +9723,22 @@ static void Service_SceneEditLightsScreen(void)
         BUTTON_SetBitmap(hButtonWizNext, BUTTON_CI_UNPRESSED, &bmnext);
         BUTTON_SetBitmap(hButtonWizNext, BUTTON_CI_PRESSED, &bmnext);
 
-        // Kompletan, neizmijenjen kod za iscrtavanje ikonica svjetala
+        // Iscrtavanje ikonica svjetala, jedna stranica mreže kao na običnom ekranu
+        const uint8_t lights_on_page = DISP_GridPageItems(LIGHTS_getCount(), &lights_page);
+        const uint8_t first_light = lights_page * DEVICES_PER_PAGE;
+        const uint8_t rows = DISP_GridRows(lights_on_page);
+        DISP_DrawGridPager(lights_page, DISP_GridPageCount(LIGHTS_getCount()));
+
         const GUI_FONT* fontToUse = &GUI_FontVerdana20_LAT;
         const int text_padding = 10;
         bool downgrade_font = false;
-        for(uint8_t i = 0; i < LIGHTS_getCount(); ++i)
+        for(uint8_t i = 0; i < lights_on_page; ++i)
         {
-            uint8_t lights_total = LIGHTS_getCount();
-            uint8_t lights_in_this_row = 0;
-            if (lights_total <= 3) lights_in_this_row = lights_total;
-            else if (lights_total == 4) lights_in_this_row = 2;
-            else if (lights_total == 5) lights_in_this_row = 3;
-            else lights_in_this_row = 3;
+            uint8_t lights_in_this_row = DISP_GridRowItems(lights_on_page, 0);
 
             int max_width_per_icon = (DRAWING_AREA_WIDTH / lights_in_this_row) - text_padding;
 
-            LIGHT_Handle* handle = LIGHTS_GetInstance(i);
+            LIGHT_Handle* handle = LIGHTS_GetInstance(first_light + i);
             if (handle) {
                 uint16_t selection_index = LIGHT_GetIconID(handle);
                 if (selection_index < (sizeof(icon_mapping_table) / sizeof(IconMapping_t)))
@@ -9323,19 +9757,14 @@ static void Service_SceneEditLightsScreen(void)
         if (downgrade_font) {
             fontToUse = &GUI_FontVerdana16_LAT;
         }
-        int y_row_start = (LIGHTS_Rows_getCount() > 1) ? 10 : 86;
+        int y_row_start = (rows > 1) ? 10 : 86;
         const int y_row_height = 130;
         uint8_t lightsInRowSum = 0;
-        for(uint8_t row = 0; row < LIGHTS_Rows_getCount(); ++row) {
-            uint8_t lightsInRow = LIGHTS_getCount();
-            if(LIGHTS_getCount() > 3) {
-                if(LIGHTS_getCount() == 4) lightsInRow = 2;
-                else if(LIGHTS_getCount() == 5) lightsInRow = (row > 0) ? 2 : 3;
-                else lightsInRow = 3;
-            }
+        for(uint8_t row = 0; row < rows; ++row) {
+            uint8_t lightsInRow = DISP_GridRowItems(lights_on_page, row);
             uint8_t currentLightsMenuSpaceBetween = (400 - (80 * lightsInRow)) / (lightsInRow - 1 + 2);
             for(uint8_t idx_in_row = 0; idx_in_row < lightsInRow; ++idx_in_row) {
-                uint8_t absolute_light_index = lightsInRowSum + idx_in_row;
+                uint8_t absolute_light_index = first_light + lightsInRowSum + idx_in_row;
                 LIGHT_Handle* handle = LIGHTS_GetInstance(absolute_light_index);
                 if (handle) {
                     uint16_t selection_index = LIGHT_GetIconID(handle);
@@ -9424,8 +9853,21 @@ static void Service_LightsScreen(void)
         shouldDrawScreen = 0;
 
         GUI_MULTIBUF_BeginEx(1);
-        GUI_Clear();
-        DrawHamburgerMenu(1);
+
+        // Na ekranu je jedna stranica mreže (do DEVICES_PER_PAGE svjetala)
+        const uint8_t lights_on_page = DISP_GridPageItems(LIGHTS_getCount(), &lights_page);
+        const uint8_t first_light = lights_page * DEVICES_PER_PAGE;
+        const uint8_t rows = DISP_GridRows(lights_on_page);
+
+        // Statički dio ekrana (hamburger meni i natpisi) se vraća iz SDRAM keša
+        // jednim DMA2D prenosom, a iscrtava se samo kada se konfiguracija promijeni.
+        const uint32_t bkg_key = DISP_BkgCacheKey(BKG_SLOT_LIGHTS);
+        const bool draw_static = !DISP_BkgCacheRestore(BKG_SLOT_LIGHTS, 1, bkg_key);
+        if (draw_static) {
+            GUI_Clear();
+            DrawHamburgerMenu(1);
+            DISP_DrawGridPager(lights_page, DISP_GridPageCount(LIGHTS_getCount()));
+        }
 
         // =======================================================================
         // === FAZA 1: PRE-KALKULACIJA I ODABIR FONTA ZA CIJELI EKRAN ===
@@ -9434,20 +9876,15 @@ static void Service_LightsScreen(void)
         const int text_padding = 10; // Sigurnosni razmak u pikselima između tekstova susjednih ikonica
         bool downgrade_font = false;
 
-        // Petlja za PRE-KALKULACIJU (prolazimo kroz sve, ali ne iscrtavamo ništa)
-        for(uint8_t i = 0; i < LIGHTS_getCount(); ++i)
+        // Petlja za PRE-KALKULACIJU (prolazimo kroz svjetla stranice, ali ne iscrtavamo ništa)
+        for(uint8_t i = 0; i < lights_on_page; ++i)
         {
             // Izračunaj maksimalnu dozvoljenu širinu teksta na osnovu rasporeda
-            uint8_t lights_total = LIGHTS_getCount();
-            uint8_t lights_in_this_row = 0;
-            if (lights_total <= 3) lights_in_this_row = lights_total;
-            else if (lights_total == 4) lights_in_this_row = 2;
-            else if (lights_total == 5) lights_in_this_row = 3; // Pretpostavka za prvi red
-            else lights_in_this_row = 3;
+            uint8_t lights_in_this_row = DISP_GridRowItems(lights_on_page, 0); // Pretpostavka za prvi red
 
             int max_width_per_icon = (DRAWING_AREA_WIDTH / lights_in_this_row) - text_padding;
 
-            LIGHT_Handle* handle = LIGHTS_GetInstance(i);
+            LIGHT_Handle* handle = LIGHTS_GetInstance(first_light + i);
             if (handle) {
                 uint16_t selection_index = LIGHT_GetIconID(handle);
                 if (selection_index < (sizeof(icon_mapping_table) / sizeof(IconMapping_t)))
@@ -9474,65 +9911,69 @@ static void Service_LightsScreen(void)
         // =======================================================================
         // === FAZA 2: ISCRTAVANJE IKONICA SA KONAČNO ODABRANIM FONTOM ===
         // =======================================================================
-        int y_row_start = (LIGHTS_Rows_getCount() > 1)
-                          ? lights_and_gates_grid_layout.y_start_pos_multi_row
-                          : lights_and_gates_grid_layout.y_start_pos_single_row;
-
-        const int y_row_height = lights_and_gates_grid_layout.row_height;
-        uint8_t lightsInRowSum = 0;
-
-        for(uint8_t row = 0; row < LIGHTS_Rows_getCount(); ++row) {
-            uint8_t lightsInRow = LIGHTS_getCount();
-            if(LIGHTS_getCount() > 3) {
-                if(LIGHTS_getCount() == 4) lightsInRow = 2;
-                else if(LIGHTS_getCount() == 5) lightsInRow = (row > 0) ? 2 : 3;
-                else lightsInRow = 3;
-            }
-            uint8_t currentLightsMenuSpaceBetween = (400 - (80 * lightsInRow)) / (lightsInRow - 1 + 2);
-
-            for(uint8_t idx_in_row = 0; idx_in_row < lightsInRow; ++idx_in_row) {
-                uint8_t absolute_light_index = lightsInRowSum + idx_in_row;
-                LIGHT_Handle* handle = LIGHTS_GetInstance(absolute_light_index);
-                if (handle) {
-                    uint16_t selection_index = LIGHT_GetIconID(handle);
-                    if (selection_index < (sizeof(icon_mapping_table) / sizeof(IconMapping_t)))
-                    {
-                        const IconMapping_t* mapping = &icon_mapping_table[selection_index];
-                        GUI_CONST_STORAGE GUI_BITMAP* icon_to_draw = light_modbus_images[(mapping->visual_icon_id * 2) + LIGHT_isActive(handle)];
-
-                        // Postavljamo KONAČNO ODABRANI FONT za iscrtavanje
-                        GUI_SetFont(fontToUse);
-                        const int font_height = GUI_GetFontDistY();
-                        const int icon_height = icon_to_draw->YSize;
-                        const int icon_width = icon_to_draw->XSize;
-                        const int padding = lights_and_gates_grid_layout.text_icon_padding;
-                        const int total_block_height = font_height + padding + icon_height + padding + font_height;
-                        const int y_slot_center = y_row_start + (y_row_height / 2);
-                        const int y_block_start = y_slot_center - (total_block_height / 2);
-                        const int x_slot_start = (currentLightsMenuSpaceBetween * (idx_in_row + 1)) + (80 * idx_in_row);
-                        const int x_text_center = x_slot_start + 40;
+        // Prolaz 0 iscrtava statički dio (natpisi), prolaz 1 samo ikonice čije se stanje mijenja.
+        // Ako je statički dio već u SDRAM kešu, prolaz 0 se preskače.
+        for (uint8_t pass = draw_static ? 0 : 1; pass < 2; ++pass) {
+            int y_row_start = (rows > 1)
+                              ? lights_and_gates_grid_layout.y_start_pos_multi_row
+                              : lights_and_gates_grid_layout.y_start_pos_single_row;
 
-                        const int y_primary_text_pos = y_block_start;
-                        const int y_icon_pos = y_primary_text_pos + font_height + padding;
-                        const int y_secondary_text_pos = y_icon_pos + icon_height + padding;
+            const int y_row_height = lights_and_gates_grid_layout.row_height;
+            uint8_t lightsInRowSum = 0;
 
-                        GUI_SetTextMode(GUI_TM_TRANS);
-                        GUI_SetTextAlign(GUI_TA_HCENTER);
+            for(uint8_t row = 0; row < rows; ++row) {
+                uint8_t lightsInRow = DISP_GridRowItems(lights_on_page, row);
+                uint8_t currentLightsMenuSpaceBetween = (400 - (80 * lightsInRow)) / (lightsInRow - 1 + 2);
 
-                        GUI_SetColor(GUI_WHITE);
-                        GUI_DispStringAt(lng(mapping->primary_text_id), x_text_center, y_primary_text_pos);
+                for(uint8_t idx_in_row = 0; idx_in_row < lightsInRow; ++idx_in_row) {
+                    uint8_t absolute_light_index = first_light + lightsInRowSum + idx_in_row;
+                    LIGHT_Handle* handle = LIGHTS_GetInstance(absolute_light_index);
+                    if (handle) {
+                        uint16_t selection_index = LIGHT_GetIconID(handle);
+                        if (selection_index < (sizeof(icon_mapping_table) / sizeof(IconMapping_t)))
+                        {
+                            const IconMapping_t* mapping = &icon_mapping_table[selection_index];
+                            GUI_CONST_STORAGE GUI_BITMAP* icon_to_draw = light_modbus_images[(mapping->visual_icon_id * 2) + LIGHT_isActive(handle)];
+
+                            // Postavljamo KONAČNO ODABRANI FONT za iscrtavanje
+                            GUI_SetFont(fontToUse);
+                            const int font_height = GUI_GetFontDistY();
+                            const int icon_height = icon_to_draw->YSize;
+                            const int icon_width = icon_to_draw->XSize;
+                            const int padding = lights_and_gates_grid_layout.text_icon_padding;
+                            const int total_block_height = font_height + padding + icon_height + padding + font_height;
+                            const int y_slot_center = y_row_start + (y_row_height / 2);
+                            const int y_block_start = y_slot_center - (total_block_height / 2);
+                            const int x_slot_start = (currentLightsMenuSpaceBetween * (idx_in_row + 1)) + (80 * idx_in_row);
+                            const int x_text_center = x_slot_start + 40;
+
+                            const int y_primary_text_pos = y_block_start;
+                            const int y_icon_pos = y_primary_text_pos + font_height + padding;
+                            const int y_secondary_text_pos = y_icon_pos + icon_height + padding;
+
+                            if (pass == 0) {
+                                GUI_SetTextMode(GUI_TM_TRANS);
+                                GUI_SetTextAlign(GUI_TA_HCENTER);
 
-                        GUI_DrawBitmap(icon_to_draw, x_text_center - (icon_width / 2), y_icon_pos);
+                                GUI_SetColor(GUI_WHITE);
+                                GUI_DispStringAt(lng(mapping->primary_text_id), x_text_center, y_primary_text_pos);
 
-                        GUI_SetTextMode(GUI_TM_TRANS);
-                        GUI_SetTextAlign(GUI_TA_HCENTER);
-                        GUI_SetColor(GUI_ORANGE);
-                        GUI_DispStringAt(lng(mapping->secondary_text_id), x_text_center, y_secondary_text_pos);
+                                GUI_SetTextMode(GUI_TM_TRANS);
+                                GUI_SetTextAlign(GUI_TA_HCENTER);
+                                GUI_SetColor(GUI_ORANGE);
+                                GUI_DispStringAt(lng(mapping->secondary_text_id), x_text_center, y_secondary_text_pos);
+                            } else {
+                                GUI_DrawBitmap(icon_to_draw, x_text_center - (icon_width / 2), y_icon_pos);
+                            }
+                        }
                     }
                 }
+                lightsInRowSum += lightsInRow;
+                y_row_start += y_row_height;
+            }
+            if (pass == 0) {
+                DISP_BkgCacheStore(BKG_SLOT_LIGHTS, 1, bkg_key);
             }
-            lightsInRowSum += lightsInRow;
-            y_row_start += y_row_height;
         }
         GUI_MULTIBUF_EndEx(1);
     }
@@ -9877,6 +10318,304 @@ static void Service_QrCodeScreen(void)
     }
 }
 
+/**
+ ******************************************************************************
+ * @brief       Servisira skriveni dijagnostički ekran profilera iscrtavanja.
+ * @author      Gemini & [Vaše Ime]
+ * @note        Ulaz je dupli dodir na `SCREEN_SETTINGS_1`, izlaz bilo koji dodir.
+ * Jednom u sekundi ispisuje tabelu ekrana koji su imali frejmove:
+ * broj frejmova, broj punih iscrtavanja, prosječno i maksimalno
+ * trajanje `Service_XxxScreen`, prosječno DMA2D vrijeme i prosječno
+ * trajanje `GUI_Exec`. Sva vremena su u mikrosekundama.
+ ******************************************************************************
+ */
+static void Service_ProfilerScreen(void)
+{
+    static uint32_t profiler_refresh_tmr = 0;
+    char buf[80];
+    int y = 24;
+
+    if (!shouldDrawScreen && ((HAL_GetTick() - profiler_refresh_tmr) < 1000)) return;
+    shouldDrawScreen = 0;
+    profiler_refresh_tmr = HAL_GetTick();
+
+    GUI_MULTIBUF_BeginEx(1);
+    GUI_SetBkColor(GUI_BLACK);
+    GUI_Clear();
+    GUI_SetFont(GUI_FONT_13_1);
+    GUI_SetColor(GUI_ORANGE);
+    GUI_SetTextMode(GUI_TM_TRANS);
+    GUI_DispStringAt("EKR   FREJM  ISCRT   AVG us   MAX us   DMA us  EXEC us", 4, 4);
+    GUI_SetColor(GUI_WHITE);
+
+    for (uint8_t i = 0; (i < PROFILER_SCREEN_COUNT) && (y < (LCD_GetYSize() - 28)); i++)
+    {
+        const Profiler_ScreenStats_t* st = Profiler_GetScreenStats(i);
+        if ((st == NULL) || (st->frames == 0)) continue;
+
+        sprintf(buf, "%3u %8lu %6lu %8lu %8lu %8lu %8lu", i,
+                (unsigned long)st->frames, (unsigned long)st->redraws,
+                (unsigned long)Profiler_CyclesToUs(st->draw_cycles / st->frames),
+                (unsigned long)Profiler_CyclesToUs(st->draw_max),
+                (unsigned long)Profiler_CyclesToUs(st->dma_cycles / st->frames),
+                (unsigned long)(st->exec_count ? Profiler_CyclesToUs(st->exec_cycles / st->exec_count) : 0));
+        GUI_DispStringAt(buf, 4, y);
+        y += 14;
+    }
+
+    LCD_PacerStatsTypedef pacer;
+    LCD_Pacer_GetStats(&pacer);
+    sprintf(buf, "Prikazano %lu  Presk. %lu  Odgod. %lu/%lu  Kasni %lu  Dodir %lu/%lu ms",
+            (unsigned long)pacer.shown, (unsigned long)pacer.skipped,
+            (unsigned long)pacer.deferred, (unsigned long)pacer.service_deferred, (unsigned long)pacer.late,
+            (unsigned long)pacer.input_latency_last, (unsigned long)pacer.input_latency_max);
+    GUI_SetColor(GUI_GRAY);
+    GUI_DispStringAt(buf, 4, LCD_GetYSize() - 28);
+    sprintf(buf, "Zapisa u baferu: %u", Profiler_GetFrameCount());
+    GUI_DispStringAt(buf, 4, LCD_GetYSize() - 14);
+    GUI_MULTIBUF_EndEx(1);
+}
+
+/**
+ * @brief Prikazi ekrana istorije; dodir van hamburger zone prelazi na sljedeći.
+ */
+typedef enum
+{
+    HIST_VIEW_TEMP_24H = 0,
+    HIST_VIEW_TEMP_1H,
+    HIST_VIEW_TEMP_7D,
+    HIST_VIEW_FAN_24H,
+    HIST_VIEW_LIGHTS_24H,
+    HIST_VIEW_COUNT
+} HistoryView_e;
+
+#define HIST_CHART_X0                   36      ///< Lijeva ivica grafika
+#define HIST_CHART_Y0                   56      ///< Gornja ivica grafika
+#define HIST_CHART_W                    440     ///< Kolona (piksela) grafika
+#define HIST_CHART_H                    176
+#define HIST_REFRESH_MS                 (HIST_TIER0_PERIOD_S * 1000U)
+
+static const struct
+{
+    uint8_t     title;          ///< `TXT_xxx`
+    uint32_t    span_s;
+    const char* span_label;
+} history_views[HIST_VIEW_COUNT] =
+{
+    [HIST_VIEW_TEMP_24H]   = { TXT_THERMOSTAT, 86400U,  "24 h" },
+    [HIST_VIEW_TEMP_1H]    = { TXT_THERMOSTAT, 3600U,   "1 h"  },
+    [HIST_VIEW_TEMP_7D]    = { TXT_THERMOSTAT, 604800U, "7 d"  },
+    [HIST_VIEW_FAN_24H]    = { TXT_VENTILATOR, 86400U,  "24 h" },
+    [HIST_VIEW_LIGHTS_24H] = { TXT_LIGHTS,     86400U,  "24 h" },
+};
+
+static uint8_t history_view = HIST_VIEW_TEMP_24H;
+static History_Column_t history_cols[2][HIST_CHART_W];  ///< Glavni kanal i zadata temperatura / zbir svjetala
+
+/**
+ * @brief Ispisuje vrijednost u desetinkama kao "21.5".
+ */
+static void History_FormatTenths(char* buf, int32_t v)
+{
+    sprintf(buf, "%s%ld.%ld", (v < 0) ? "-" : "", (long)(labs(v) / 10), (long)(labs(v) % 10));
+}
+
+/**
+ * @brief Y koordinata vrijednosti `v` za skalu [lo, hi].
+ */
+static int History_ChartY(int32_t v, int32_t lo, int32_t hi)
+{
+    if (v < lo) v = lo;
+    if (v > hi) v = hi;
+    return HIST_CHART_Y0 + HIST_CHART_H - 1 - (int)(((v - lo) * (HIST_CHART_H - 1)) / (hi - lo));
+}
+
+/**
+ ******************************************************************************
+ * @brief       Servisira ekran sa graficima istorije mjerenja.
+ * @author      Gemini & [Vaše Ime]
+ * @note        Ulaz je dupli dodir na `SCREEN_THERMOSTAT`, povratak hamburger
+ * meni. Dodir bilo gdje drugo bira sljedeći prikaz: temperatura za 24 h,
+ * 1 h i 7 dana (opseg min/max po koloni i zadata temperatura), ventilator
+ * i svjetla za 24 h (prosjek po koloni). `History_Query` sažima interval
+ * u 440 kolona jednim prolazom kroz blokove, pa je iscrtavanje jedna
+ * vertikalna linija po koloni. Ekran se osvježava sa novim uzorkom nivoa 0.
+ ******************************************************************************
+ */
+static void Service_HistoryScreen(void)
+{
+    static uint32_t history_refresh_tmr = 0;
+    History_Summary_t sum, sum2;
+    char buf[96], v1[12], v2[12], v3[12];
+    int32_t lo, hi;
+
+    if (!shouldDrawScreen && ((HAL_GetTick() - history_refresh_tmr) < HIST_REFRESH_MS)) return;
+    shouldDrawScreen = 0;
+    history_refresh_tmr = HAL_GetTick();
+
+    const uint32_t span = history_views[history_view].span_s;
+    const uint32_t now = History_Now();
+    const uint32_t from = (now > span) ? (now - span) : 0U;
+    const uint32_t to = from + span;
+
+    memset(&sum2, 0, sizeof(sum2));
+    switch (history_view)
+    {
+    case HIST_VIEW_FAN_24H:
+        History_Query(HIST_CH_FAN, from, to, history_cols[0], HIST_CHART_W, &sum);
+        lo = 0;
+        hi = 30;
+        break;
+
+    case HIST_VIEW_LIGHTS_24H:
+        // Zbir sekundi uključenosti svih svjetala; skala je broj svjetala
+        memset(history_cols[1], 0, sizeof(history_cols[1]));
+        for (uint8_t i = 0; i < LIGHTS_MODBUS_SIZE; i++)
+        {
+            History_Query((uint8_t)(HIST_CH_LIGHT + i), from, to, history_cols[0], HIST_CHART_W, &sum);
+            for (uint16_t c = 0; c < HIST_CHART_W; c++)
+            {
+                history_cols[1][c].sum += history_cols[0][c].sum;
+                if (history_cols[0][c].count > history_cols[1][c].count) history_cols[1][c].count = history_cols[0][c].count;
+            }
+        }
+        lo = 0;
+        hi = 10;
+        for (uint8_t i = 0; i < LIGHTS_MODBUS_SIZE; i++)
+        {
+            if (LIGHT_GetRelay(LIGHTS_GetInstance(i)) != 0U) hi = (i + 1) * 10;
+        }
+        break;
+
+    default:
+        History_Query(HIST_CH_TEMP, from, to, history_cols[0], HIST_CHART_W, &sum);
+        History_Query(HIST_CH_SETPOINT, from, to, history_cols[1], HIST_CHART_W, &sum2);
+        lo = (sum.samples ? sum.min : 200);
+        hi = (sum.samples ? sum.max : 250);
+        if (sum2.samples && (sum2.min < lo)) lo = sum2.min;
+        if (sum2.samples && (sum2.max > hi)) hi = sum2.max;
+        lo = ((lo - 5) / 10) * 10;
+        hi = ((hi + 14) / 10) * 10;
+        if ((hi - lo) < 20) hi = lo + 20;
+        break;
+    }
+
+    GUI_MULTIBUF_BeginEx(1);
+    GUI_SetBkColor(GUI_BLACK);
+    GUI_Clear();
+    GUI_SetTextMode(GUI_TM_TRANS);
+    GUI_SetFont(GUI_FONT_20_1);
+    GUI_SetColor(GUI_ORANGE);
+    sprintf(buf, "%s  %s", lng(history_views[history_view].title), history_views[history_view].span_label);
+    GUI_DispStringAt(buf, 10, 12);
+    DrawHamburgerMenu(1);
+
+    // Mreža: četiri podjele po vrijednosti i po vremenu
+    GUI_SetFont(GUI_FONT_13_1);
+    for (uint8_t k = 0; k <= 4; k++)
+    {
+        int32_t v = lo + (((hi - lo) * k) / 4);
+        int y = History_ChartY(v, lo, hi);
+        GUI_SetColor(GUI_DARKGRAY);
+        GUI_DrawHLine(y, HIST_CHART_X0, HIST_CHART_X0 + HIST_CHART_W - 1);
+        GUI_DrawVLine(HIST_CHART_X0 + ((HIST_CHART_W - 1) * k) / 4, HIST_CHART_Y0, HIST_CHART_Y0 + HIST_CHART_H - 1);
+        GUI_SetColor(GUI_GRAY);
+        if (history_view == HIST_VIEW_LIGHTS_24H) sprintf(v1, "%ld", (long)(v / 10));
+        else History_FormatTenths(v1, v);
+        GUI_DispStringAt(v1, 2, y - 6);
+    }
+
+    // Podaci: jedna vertikalna linija po koloni
+    for (uint16_t c = 0; c < HIST_CHART_W; c++)
+    {
+        const int x = HIST_CHART_X0 + c;
+        const History_Column_t* col = &history_cols[0][c];
+
+        if (history_view == HIST_VIEW_LIGHTS_24H)
+        {
+            const History_Column_t* all = &history_cols[1][c];
+            if (all->count == 0) continue;
+            // Sekundi uključenosti / trajanje kolone = prosječan broj upaljenih svjetala
+            int32_t v = (all->sum * 10) / ((int32_t)all->count * (sum.period_s ? sum.period_s : HIST_TIER0_PERIOD_S));
+            GUI_SetColor(GUI_YELLOW);
+            GUI_DrawVLine(x, History_ChartY(v, lo, hi), HIST_CHART_Y0 + HIST_CHART_H - 1);
+            continue;
+        }
+        if (col->count == 0) continue;
+        if (history_view == HIST_VIEW_FAN_24H)
+        {
+            GUI_SetColor(GUI_LIGHTBLUE);
+            GUI_DrawVLine(x, History_ChartY(col->sum / col->count, lo, hi), HIST_CHART_Y0 + HIST_CHART_H - 1);
+            continue;
+        }
+        GUI_SetColor(GUI_ORANGE);
+        GUI_DrawVLine(x, History_ChartY(col->max, lo, hi), History_ChartY(col->min, lo, hi));
+        if (history_cols[1][c].count != 0)
+        {
+            GUI_SetColor(GUI_LIGHTGREEN);
+            GUI_DrawPixel(x, History_ChartY(history_cols[1][c].sum / history_cols[1][c].count, lo, hi));
+        }
+    }
+
+    // Sažetak intervala
+    GUI_SetColor(GUI_WHITE);
+    if (sum.samples == 0)
+    {
+        buf[0] = '\0';
+    }
+    else if (history_view == HIST_VIEW_LIGHTS_24H)
+    {
+        char* p = buf;
+        for (uint8_t i = 0; i < LIGHTS_MODBUS_SIZE; i++)
+        {
+            History_Summary_t ls;
+            if (LIGHT_GetRelay(LIGHTS_GetInstance(i)) == 0U) continue;
+            History_Query((uint8_t)(HIST_CH_LIGHT + i), from, to, history_cols[0], HIST_CHART_W, &ls);
+            History_FormatTenths(v1, ls.sum / 360);
+            p += sprintf(p, "%u: %s h   ", i + 1, v1);
+        }
+    }
+    else if (history_view == HIST_VIEW_FAN_24H)
+    {
+        History_FormatTenths(v1, sum.sum / (int32_t)sum.samples);
+        sprintf(buf, "avg %s", v1);
+    }
+    else
+    {
+        History_FormatTenths(v1, sum.min);
+        History_FormatTenths(v2, sum.max);
+        History_FormatTenths(v3, sum.sum / (int32_t)sum.samples);
+        sprintf(buf, "min %s   max %s   avg %s °C", v1, v2, v3);
+    }
+    GUI_DispStringAt(buf, HIST_CHART_X0, HIST_CHART_Y0 + HIST_CHART_H + 8);
+    sprintf(buf, "-%s", history_views[history_view].span_label);
+    GUI_SetColor(GUI_GRAY);
+    GUI_DispStringAt(buf, HIST_CHART_X0, HIST_CHART_Y0 + HIST_CHART_H + 24);
+    GUI_DispStringHCenterAt("0", HIST_CHART_X0 + HIST_CHART_W - 4, HIST_CHART_Y0 + HIST_CHART_H + 24);
+    GUI_MULTIBUF_EndEx(1);
+}
+
+/**
+ * @brief Obrada pritiska na ekranu istorije.
+ * @note  Hamburger zona vraća na termostat, ostatak ekrana bira sljedeći prikaz.
+ */
+static void HandlePress_HistoryScreen(GUI_PID_STATE* pTS, uint8_t* click_flag)
+{
+    *click_flag = 1;
+    if ((pTS->x >= global_layout.hamburger_menu_zone.x0) && (pTS->x < global_layout.hamburger_menu_zone.x1) &&
+            (pTS->y >= global_layout.hamburger_menu_zone.y0) && (pTS->y < global_layout.hamburger_menu_zone.y1))
+    {
+        GUI_SelectLayer(1);
+        GUI_Clear();
+        screen = SCREEN_THERMOSTAT;
+    }
+    else
+    {
+        history_view = (uint8_t)((history_view + 1U) % HIST_VIEW_COUNT);
+    }
+    shouldDrawScreen = 1;
+}
+
 /**
  ******************************************************************************
  * @brief       Servisira ekran za čišćenje ekrana (privremeno onemogućava dodir).
@@ -10042,17 +10781,14 @@ static void Service_SettingsScreen_1(void)
             THSTAT_Save(pThst);
         }
         thsta = 0;
-        DSP_KillSet1Scrn(); // Uništavanje widgeta trenutnog ekrana
-        screen = SCREEN_RETURN_TO_FIRST;
+        DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST); // Izlazak iz menija podešavanja
     } else if (BUTTON_IsPressed(hBUTTON_Next)) {
         // ISTA ISPRAVKA I ZA NEXT DUGME
         if (thsta) {
             THSTAT_Save(pThst);
         }
         thsta = 0;
-        DSP_KillSet1Scrn();
-        DSP_InitSet2Scrn(); // Inicijalizacija sljedećeg ekrana
-        screen = SCREEN_SETTINGS_2;
+        DISP_ChangeScreen(SCREEN_SETTINGS_2); // Inicijalizacija sljedećeg ekrana
     }
 }
 /**
@@ -10072,31 +10808,37 @@ static void Service_SettingsScreen_2(void)
         rtctm.Hours = Dec2Bcd(SPINBOX_GetValue(hSPNBX_Hour));
         HAL_RTC_SetTime(&hrtc, &rtctm, RTC_FORMAT_BCD);
         RtcTimeValidSet();
+        Timer_Resync();
     }
     if (rtctm.Minutes != Dec2Bcd(SPINBOX_GetValue(hSPNBX_Minute))) {
         rtctm.Minutes = Dec2Bcd(SPINBOX_GetValue(hSPNBX_Minute));
         HAL_RTC_SetTime(&hrtc, &rtctm, RTC_FORMAT_BCD);
         RtcTimeValidSet();
+        Timer_Resync();
     }
     if (rtcdt.Date != Dec2Bcd(SPINBOX_GetValue(hSPNBX_Day))) {
         rtcdt.Date = Dec2Bcd(SPINBOX_GetValue(hSPNBX_Day));
         HAL_RTC_SetDate(&hrtc, &rtcdt, RTC_FORMAT_BCD);
         RtcTimeValidSet();
+        Timer_Resync();
     }
     if (rtcdt.Month != Dec2Bcd(SPINBOX_GetValue(hSPNBX_Month))) {
         rtcdt.Month = Dec2Bcd(SPINBOX_GetValue(hSPNBX_Month));
         HAL_RTC_SetDate(&hrtc, &rtcdt, RTC_FORMAT_BCD);
         RtcTimeValidSet();
+        Timer_Resync();
     }
     if (rtcdt.Year != Dec2Bcd(SPINBOX_GetValue(hSPNBX_Year) - 2000)) {
         rtcdt.Year = Dec2Bcd(SPINBOX_GetValue(hSPNBX_Year) - 2000);
         HAL_RTC_SetDate(&hrtc, &rtcdt, RTC_FORMAT_BCD);
         RtcTimeValidSet();
+        Timer_Resync();
     }
     if (rtcdt.WeekDay != (DROPDOWN_GetSel(hDRPDN_WeekDay) + 1)) { // Poređenje sa Dec vrijednošću
         rtcdt.WeekDay = (DROPDOWN_GetSel(hDRPDN_WeekDay) + 1);
         HAL_RTC_SetDate(&hrtc, &rtcdt, RTC_FORMAT_BCD);
         RtcTimeValidSet();
+        Timer_Resync();
     }
 
     /**
@@ -10149,8 +10891,7 @@ static void Service_SettingsScreen_2(void)
 
         Display_Save();
         EE_WriteBuffer(&tfifa, EE_TFIFA, 1);
-        DSP_KillSet2Scrn();
-        screen = SCREEN_RETURN_TO_FIRST;
+        DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST);
     } else if (BUTTON_IsPressed(hBUTTON_Next)) {
         // Snimi sve promjene prije prelaska na sljedeći ekran
         Display_Save();
@@ -10164,9 +10905,7 @@ static void Service_SettingsScreen_2(void)
             lcsta = 0;
         }
 
-        DSP_KillSet2Scrn();
-        DSP_InitSet3Scrn();
-        screen = SCREEN_SETTINGS_3;
+        DISP_ChangeScreen(SCREEN_SETTINGS_3);
     }
 }
 /**
@@ -10226,8 +10965,7 @@ static void Service_SettingsScreen_3(void)
             Ventilator_Save(ventHandle);
             settingsChanged = 0;
         }
-        DSP_KillSet3Scrn();
-        screen = SCREEN_RETURN_TO_FIRST;
+        DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST);
     } else if (BUTTON_IsPressed(hBUTTON_Next)) {
         if(settingsChanged) {
             Display_Save();
@@ -10235,9 +10973,7 @@ static void Service_SettingsScreen_3(void)
             Ventilator_Save(ventHandle);
             settingsChanged = 0;
         }
-        DSP_KillSet3Scrn();
-        DSP_InitSet4Scrn();
-        screen = SCREEN_SETTINGS_4;
+        DISP_ChangeScreen(SCREEN_SETTINGS_4);
     }
 }
 
@@ -10249,7 +10985,7 @@ static void Service_SettingsScreen_3(void)
 static void Service_SettingsScreen_4(void)
 {
     // Ažuriranje postavki za zavjese unutar petlje.
-    for(uint8_t idx = curtainSettingMenu * 4; idx < (((CURTAINS_SIZE - (curtainSettingMenu * 4)) >= 4) ? ((curtainSettingMenu * 4) + 4) : CURTAINS_SIZE); idx++) {
+    for(uint8_t idx = curtainSettingMenu * CURTAINS_PER_SETTINGS_PAGE; idx < (((CURTAINS_SIZE - (curtainSettingMenu * CURTAINS_PER_SETTINGS_PAGE)) >= CURTAINS_PER_SETTINGS_PAGE) ? ((curtainSettingMenu * CURTAINS_PER_SETTINGS_PAGE) + CURTAINS_PER_SETTINGS_PAGE) : CURTAINS_SIZE); idx++) {
 
         // << ISPRAVKA: Dobijamo handle za roletnu po fizičkom indeksu. >>
         Curtain_Handle* handle = Curtain_GetInstanceByIndex(idx);
@@ -10268,11 +11004,10 @@ static void Service_SettingsScreen_4(void)
             Curtains_Save(); // Spremi sve postavke zavjesa u EEPROM.
             settingsChanged = 0;
         }
-        DSP_KillSet4Scrn();
-        screen = SCREEN_RETURN_TO_FIRST;
+        DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST);
     } else if (BUTTON_IsPressed(hBUTTON_Next)) {
         // Logika za prelazak na sljedeću stranicu podešavanja zavjesa ili na sljedeći ekran.
-        if((CURTAINS_SIZE - ((curtainSettingMenu + 1) * 4)) > 0) {
+        if((CURTAINS_SIZE - ((curtainSettingMenu + 1) * CURTAINS_PER_SETTINGS_PAGE)) > 0) {
             DSP_KillSet4Scrn();
             ++curtainSettingMenu;
             DSP_InitSet4Scrn();
@@ -10464,8 +11199,7 @@ static void Service_SettingsScreen_5(void)
 
         if (BUTTON_IsPressed(hBUTTON_Ok))
         {
-            DSP_KillSet5Scrn();
-            screen = SCREEN_RETURN_TO_FIRST;
+            DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST);
             shouldDrawScreen = 1;
         }
         else if (BUTTON_IsPressed(hBUTTON_Next))
@@ -10476,10 +11210,8 @@ static void Service_SettingsScreen_5(void)
                 ++lightsModbusSettingsMenu;
                 DSP_InitSet5Scrn();
             } else {
-                DSP_KillSet5Scrn();
                 lightsModbusSettingsMenu = 0;
-                DSP_InitSet6Scrn();
-                screen = SCREEN_SETTINGS_6;
+                DISP_ChangeScreen(SCREEN_SETTINGS_6);
             }
         }
     }
@@ -10573,8 +11305,7 @@ static void Service_SettingsScreen_6(void)
             Display_Save();
             settingsChanged = 0;
         }
-        DSP_KillSet6Scrn();
-        screen = SCREEN_RETURN_TO_FIRST;
+        DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST);
     }
     else if (BUTTON_IsPressed(hBUTTON_Next)) {
         if(settingsChanged) {
@@ -10583,9 +11314,7 @@ static void Service_SettingsScreen_6(void)
             Display_Save();
             settingsChanged = 0;
         }
-        DSP_KillSet6Scrn();
-        DSP_InitSet7Scrn();
-        screen = SCREEN_SETTINGS_7;
+        DISP_ChangeScreen(SCREEN_SETTINGS_7);
     }
 }
 /**
@@ -10630,8 +11359,7 @@ static void Service_SettingsScreen_7(void)
             Display_Save(); // Snimi sve promjene iz g_display_settings u EEPROM
             settingsChanged = 0;
         }
-        DSP_KillSet7Scrn();
-        screen = SCREEN_RETURN_TO_FIRST; // Vrati se na početni ekran
+        DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST); // Vrati se na početni ekran
     }
     else if (BUTTON_IsPressed(hBUTTON_Next)) // Dugme "NEXT"
     {
@@ -10640,9 +11368,7 @@ static void Service_SettingsScreen_7(void)
             Display_Save();
             settingsChanged = 0;
         }
-        DSP_KillSet7Scrn();
-        DSP_InitSet8Scrn();
-        screen = SCREEN_SETTINGS_8;
+        DISP_ChangeScreen(SCREEN_SETTINGS_8);
     }
 }
 
@@ -10771,8 +11497,7 @@ static void Service_SettingsScreen_8(void)
             Gate_Save();
             settingsChanged = 0;
         }
-        DSP_KillSet8Scrn();
-        screen = SCREEN_RETURN_TO_FIRST;
+        DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST);
         shouldDrawScreen = 1;
     }
     else if (BUTTON_IsPressed(hBUTTON_Next))
@@ -10781,9 +11506,7 @@ static void Service_SettingsScreen_8(void)
             Gate_Save();
             settingsChanged = 0;
         }
-        DSP_KillSet8Scrn();
-        DSP_InitSet9Scrn(); // Vracamo se na prvi ekran podesavanja, praveći puni krug
-        screen = SCREEN_SETTINGS_9;
+        DISP_ChangeScreen(SCREEN_SETTINGS_9); // Vracamo se na prvi ekran podesavanja, praveći puni krug
     }
 
     // Ako je bio zahtjev za ažuriranje, ponovo iscrtaj sve od nule
@@ -10805,29 +11528,29 @@ static void Service_SettingsScreen_9(void)
     // Provjera promjena na postavkama Particija
     for (int i = 0; i < SECURITY_PARTITION_COUNT; i++) {
         // Provjera releja za particiju 'i'
-        if (Security_GetPartitionRelayAddr(i) != SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_RELAY_P1 + i))) {
-            Security_SetPartitionRelayAddr(i, SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_RELAY_P1 + i)));
+        if (Security_GetPartitionRelayAddr(i) != SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_RELAY_P1 + i))) {
+            Security_SetPartitionRelayAddr(i, SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_RELAY_P1 + i)));
             settingsChanged = 1;
         }
         // Provjera feedback-a za particiju 'i'
-        if (Security_GetPartitionFeedbackAddr(i) != SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_FB_P1 + i))) {
-            Security_SetPartitionFeedbackAddr(i, SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_FB_P1 + i)));
+        if (Security_GetPartitionFeedbackAddr(i) != SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_FB_P1 + i))) {
+            Security_SetPartitionFeedbackAddr(i, SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_FB_P1 + i)));
             settingsChanged = 1;
         }
     }
     
     // Provjera promjena na zajedničkim postavkama
     // Za dužinu pulsa, vrijednost iz spinbox-a (0-50) se množi sa 100 da bi se dobile milisekunde (0-5000)
-    if (Security_GetPulseDuration() != (SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_PULSE_LENGTH)) * 100)) {
-        Security_SetPulseDuration(SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_PULSE_LENGTH)) * 100);
+    if (Security_GetPulseDuration() != (SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_PULSE_LENGTH)) * 100)) {
+        Security_SetPulseDuration(SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_PULSE_LENGTH)) * 100);
         settingsChanged = 1;
     }
-    if (Security_GetSystemStatusFeedbackAddr() != SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_FB_SYSTEM_STATUS))) {
-        Security_SetSystemStatusFeedbackAddr(SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_FB_SYSTEM_STATUS)));
+    if (Security_GetSystemStatusFeedbackAddr() != SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_FB_SYSTEM_STATUS))) {
+        Security_SetSystemStatusFeedbackAddr(SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_FB_SYSTEM_STATUS)));
         settingsChanged = 1;
     }
-    if (Security_GetSilentAlarmAddr() != SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_RELAY_SILENT))) {
-        Security_SetSilentAlarmAddr(SPINBOX_GetValue(WM_GetDialogItem(WM_GetDesktopWindow(), ID_ALARM_RELAY_SILENT)));
+    if (Security_GetSilentAlarmAddr() != SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_RELAY_SILENT))) {
+        Security_SetSilentAlarmAddr(SPINBOX_GetValue(WM_GetDialogItem(DSP_SettingsPageGet(SCREEN_SETTINGS_9), ID_ALARM_RELAY_SILENT)));
         settingsChanged = 1;
     }
     
@@ -10844,17 +11567,14 @@ static void Service_SettingsScreen_9(void)
             Display_Save();  // Snima opšte postavke (gdje se nalazi `security_module_enabled` fleg)
             settingsChanged = 0; 
         }
-        DSP_KillSet9Scrn();
-        screen = SCREEN_RETURN_TO_FIRST;
+        DISP_ChangeScreen(SCREEN_RETURN_TO_FIRST);
     } else if (BUTTON_IsPressed(hBUTTON_Next)) {
         if (settingsChanged) { 
             Security_Save(); 
             Display_Save();
             settingsChanged = 0; 
         }
-        DSP_KillSet9Scrn();
-        DSP_InitSet1Scrn(); // Vraća se na prvi ekran podešavanja, praveći puni krug
-        screen = SCREEN_SETTINGS_1;
+        DISP_ChangeScreen(SCREEN_SETTINGS_1); // Vraća se na prvi ekran podešavanja, praveći puni krug
     }
 }
 /**
@@ -11111,11 +11831,11 @@ static void Service_SceneWizDevicesScreen(void)
     if (lights_checked != lights_in_scene)
     {
         if (lights_checked) {
-            uint8_t temp_mask = 0;
+            uint32_t temp_mask = 0;
             for(int i=0; i < LIGHTS_MODBUS_SIZE; i++) {
                 LIGHT_Handle* l_handle = LIGHTS_GetInstance(i);
                 if (l_handle && LIGHT_GetRelay(l_handle) != 0) {
-                    temp_mask |= (1 << i);
+                    temp_mask |= (1UL << i);
                 }
             }
             scene_handle->lights_mask = temp_mask;
@@ -11129,11 +11849,11 @@ static void Service_SceneWizDevicesScreen(void)
     if (curtains_checked != curtains_in_scene)
     {
         if (curtains_checked) {
-            uint16_t temp_mask = 0;
+            uint32_t temp_mask = 0;
             for(int i=0; i < CURTAINS_SIZE; i++) {
                 Curtain_Handle* c_handle = Curtain_GetInstanceByIndex(i);
                 if (c_handle && Curtain_hasRelays(c_handle)) {
-                    temp_mask |= (1 << i);
+                    temp_mask |= (1UL << i);
                 }
             }
             scene_handle->curtains_mask = temp_mask;
@@ -11823,6 +12543,7 @@ static void Service_SettingsDateTimeScreen(void)
         HAL_RTC_SetTime(&hrtc, &new_time, RTC_FORMAT_BCD);
         HAL_RTC_SetDate(&hrtc, &new_date, RTC_FORMAT_BCD);
         RtcTimeValidSet();
+        Timer_Resync();
 
         initialized = false; // Reset za sljedeći ulazak na ekran
         DSP_KillSettingsDateTimeScreen();
@@ -11891,6 +12612,11 @@ static void Service_GateScreen(void)
             GUI_SetTextAlign(GUI_TA_HCENTER | GUI_TA_VCENTER);
             GUI_DispStringAt(lng(TXT_CONFIGURE_DEVICE_MSG), DRAWING_AREA_WIDTH / 2, LCD_GetYSize() / 2);
         } else {
+            // Na ekranu je jedna stranica mreže (do DEVICES_PER_PAGE kapija)
+            const uint8_t gates_on_page = DISP_GridPageItems(gate_count, &gates_page);
+            const uint8_t first_gate = gates_page * DEVICES_PER_PAGE;
+            DISP_DrawGridPager(gates_page, DISP_GridPageCount(gate_count));
+
             // =======================================================================
             // === FAZA 1: PRE-KALKULACIJA I ODABIR FONTA (identično kao kod svjetala) ===
             // =======================================================================
@@ -11898,17 +12624,12 @@ static void Service_GateScreen(void)
             const int text_padding = 10;
             bool downgrade_font = false;
 
-            for(uint8_t i = 0; i < gate_count; ++i) {
-                uint8_t gates_total = gate_count;
-                uint8_t gates_in_this_row = 0;
-                if (gates_total <= 3) gates_in_this_row = gates_total;
-                else if (gates_total == 4) gates_in_this_row = 2;
-                else if (gates_total == 5) gates_in_this_row = 3;
-                else gates_in_this_row = 3;
+            for(uint8_t i = 0; i < gates_on_page; ++i) {
+                uint8_t gates_in_this_row = DISP_GridRowItems(gates_on_page, 0);
 
                 int max_width_per_icon = (DRAWING_AREA_WIDTH / gates_in_this_row) - text_padding;
 
-                Gate_Handle* handle = Gate_GetInstance(i);
+                Gate_Handle* handle = Gate_GetInstance(first_gate + i);
                 if (handle) {
                     uint8_t appearance_id = Gate_GetAppearanceId(handle);
                     // === SIGURNOSNA PROVJERA #1 (Dio rješenja) ===
@@ -11931,7 +12652,7 @@ static void Service_GateScreen(void)
             // =======================================================================
             // === FAZA 2: ISCRTAVANJE IKONICA SA NOVOM LAYOUT STRUKTUROM ===
             // =======================================================================
-            uint8_t rows = (gate_count > 3) ? 2 : 1;
+            uint8_t rows = DISP_GridRows(gates_on_page);
             int y_row_start = (rows > 1)
                               ? lights_and_gates_grid_layout.y_start_pos_multi_row
                               : lights_and_gates_grid_layout.y_start_pos_single_row;
@@ -11940,16 +12661,11 @@ static void Service_GateScreen(void)
             uint8_t gatesInRowSum = 0;
 
             for(uint8_t row = 0; row < rows; ++row) {
-                uint8_t gatesInRow = gate_count;
-                if (gate_count > 3) {
-                    if (gate_count == 4) gatesInRow = 2;
-                    else if (gate_count == 5) gatesInRow = (row > 0) ? 2 : 3;
-                    else gatesInRow = 3;
-                }
+                uint8_t gatesInRow = DISP_GridRowItems(gates_on_page, row);
                 uint8_t currentGatesMenuSpaceBetween = (400 - (80 * gatesInRow)) / (gatesInRow - 1 + 2);
 
                 for(uint8_t idx_in_row = 0; idx_in_row < gatesInRow; ++idx_in_row) {
-                    uint8_t absolute_gate_index = gatesInRowSum + idx_in_row;
+                    uint8_t absolute_gate_index = first_gate + gatesInRowSum + idx_in_row;
                     if (absolute_gate_index >= gate_count) break;
 
                     Gate_Handle* handle = Gate_GetInstance(absolute_gate_index);
@@ -12212,6 +12928,26 @@ static void Service_GateSettingsScreen(void)
     }
 }
 
+/**
+ ******************************************************************************
+ * @brief       Usklađuje prikazano stanje alarma sa posljednjim poznatim stanjem.
+ * @author      Gemini & [Vaše Ime]
+ * @note        `Security_RefreshState` ne čeka odgovore, pa stanje stiže tek
+ * nakon otvaranja ekrana. Stabilno stanje prati modul, a prelazno
+ * (ARMING/DISARMING nakon unosa PIN-a) ostaje dok ga modul ne potvrdi.
+ ******************************************************************************
+ */
+static void SyncAlarmUiState(void)
+{
+    for (int i = 0; i <= SECURITY_PARTITION_COUNT; i++) {
+        bool armed = (i == 0) ? Security_IsAnyPartitionArmed() : Security_GetPartitionState(i - 1);
+        AlarmUIState_e target = armed ? ALARM_UI_STATE_ARMED : ALARM_UI_STATE_DISARMED;
+        if ((alarm_ui_state[i] == ALARM_UI_STATE_ARMING) && !armed) continue;
+        if ((alarm_ui_state[i] == ALARM_UI_STATE_DISARMING) && armed) continue;
+        alarm_ui_state[i] = target;
+    }
+}
+
 /**
  ******************************************************************************
  * @brief       Servisira glavni ekran za kontrolu Alarma (SCREEN_SECURITY).
@@ -12228,6 +12964,7 @@ static void Service_SecurityScreen(void)
         shouldDrawScreen = 0;
         
         Security_RefreshState();
+        SyncAlarmUiState();
         
 //        alarm_ui_state[0] = Security_IsAnyPartitionArmed() ? ALARM_UI_STATE_ARMED : ALARM_UI_STATE_DISARMED;
 //        for (int i = 0; i < SECURITY_PARTITION_COUNT; i++) {
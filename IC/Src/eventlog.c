@@ -0,0 +1,837 @@
+/**
+ ******************************************************************************
+ * @file    eventlog.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija trajnog dnevnika događaja u QSPI flash-u.
+ *
+ * @note    Segment prolazi kroz stanja: obrisan (`EVLOG_SEG_EMPTY`), sa
+ * zapisima (`EVLOG_SEG_DATA`), odbačen (`EVLOG_SEG_STALE`, zaglavlje u
+ * flash-u je još važeće) i za brisanje (`EVLOG_SEG_DIRTY`). Prije brisanja
+ * se zaglavlje odbačenog segmenta preprogramira nulama, pa ni nestanak
+ * napajanja usred brisanja ne može vratiti stari segment u lanac. Segment
+ * iza aktivnog (`spare`) se briše unaprijed, pa otvaranje novog segmenta
+ * traje koliko upis jednog zaglavlja. Brisanje drži QSPI oko 250 ms (najviše
+ * `N25Q128A_SUBSECTOR_ERASE_MAX_TIME`), a GUI za to vrijeme ne crta bitmape,
+ * pa se pokreće dok je screensaver aktivan, a bez njega tek kada aktivni
+ * segment pređe `EVLOG_ERASE_AHEAD_SLOT`; preostali slotovi i RAM bafer
+ * pokrivaju i najduže brisanje.
+ *
+ * QSPI se čita memorijski mapiran (`RT_EVLOG_ADDR`); u host build-u shim
+ * mapira simulirani flash na istu adresu. Modul koristi samo BSP funkcije
+ * `QSPI_xxx`, koje host shim zamjenjuje simulacijom sa prekidom napajanja.
+ ******************************************************************************
+ */
+
+#if (__EVENTLOG_H__ != FW_BUILD)
+#error "eventlog header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "eventlog.h"
+#include "display.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define EVLOG_RAM_MASK                  (EVLOG_RAM_RECORDS - 1U)
+#define EVLOG_NONE                      0xFFU           ///< Nema aktivnog segmenta
+#define EVLOG_MAGIC                     0x474F4C45UL    ///< "ELOG"
+#define EVLOG_CRC_LEN                   14U             ///< Bajtova zapisa i zaglavlja pod CRC-om
+#define EVLOG_PAGE_SLOTS                (QSPI_PAGE_SIZE / EVLOG_RECORD_SIZE)
+#define EVLOG_OP_TIMEOUT_MS             (2U * N25Q128A_SUBSECTOR_ERASE_MAX_TIME)
+#define EVLOG_ERASE_AHEAD_SLOT          (EVLOG_SLOTS / 2U) ///< Bez screensavera briše se tek od ovog slota aktivnog segmenta
+#define EVLOG_HEADER_SIZE               4U              ///< subcmd, broj traženih, ima još, broj zapisa
+#define EVLOG_STATUS_RECORD_SIZE        37U             ///< Veličina statusnog zapisa u bajtima
+#define EVLOG_READ_RECORD_SIZE          14U             ///< Zapis u odgovoru, bez CRC-a
+#define EVLOG_READ_MAX                  8U              ///< Najviše zapisa u jednom odgovoru
+
+#define EVLOG_SEG_ADDR(s)               (RT_EVLOG_ADDR + ((uint32_t)(s) * EVLOG_SEGMENT_SIZE))
+#define EVLOG_SLOT(s, slot)             ((const EventLog_Record_t*)(uintptr_t)(EVLOG_SEG_ADDR(s) + ((uint32_t)(slot) * EVLOG_RECORD_SIZE)))
+
+#ifndef EVLOG_CRITICAL
+#define EVLOG_CRITICAL                  1       ///< 0 u host build-u, gdje nema PRIMASK-a
+#endif
+
+#if ((EVLOG_RAM_RECORDS & EVLOG_RAM_MASK) != 0U)
+#error "EVLOG_RAM_RECORDS mora biti stepen broja 2"
+#endif
+
+#if (EVLOG_SEGMENTS < 3U) || (EVLOG_SEGMENTS >= EVLOG_NONE)
+#error "dnevnik treba najmanje 3 segmenta (aktivni, obrisan unaprijed i najstariji)"
+#endif
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+/**
+ * @brief Zaglavlje segmenta u slotu 0.
+ */
+typedef struct
+{
+    uint32_t magic;             /**< `EVLOG_MAGIC`. */
+    uint32_t number;            /**< Redni broj segmenta, raste sa svakim otvaranjem. */
+    uint32_t first_seq;         /**< Redni broj prvog zapisa segmenta. */
+    uint16_t reserved;          /**< 0xFFFF. */
+    uint16_t crc;               /**< CRC-16/CCITT prvih 14 bajtova. */
+} EventLog_Header_t;
+
+/**
+ * @brief Stanje segmenta u RAM-u.
+ */
+typedef enum
+{
+    EVLOG_SEG_DIRTY = 0,        /**< Sadržaj nepoznat, treba brisanje. */
+    EVLOG_SEG_STALE,            /**< Odbačen, ali zaglavlje u flash-u je važeće. */
+    EVLOG_SEG_EMPTY,            /**< Obrisan i provjeren. */
+    EVLOG_SEG_DATA              /**< U lancu segmenata sa zapisima. */
+} EventLog_SegState_e;
+
+/**
+ * @brief Operacija sa QSPI koja je u toku.
+ */
+typedef enum
+{
+    EVLOG_OP_NONE = 0,          /**< QSPI je memorijski mapiran. */
+    EVLOG_OP_RECORDS,           /**< Programiranje zapisa iz RAM bafera. */
+    EVLOG_OP_HEADER,            /**< Programiranje zaglavlja, otvaranje segmenta. */
+    EVLOG_OP_DISCARD,           /**< Poništavanje zaglavlja odbačenog segmenta nulama. */
+    EVLOG_OP_ERASE              /**< Brisanje segmenta. */
+} EventLog_Op_e;
+
+typedef struct
+{
+    uint32_t number;
+    uint32_t first_seq;
+    uint8_t  state;             /**< `EventLog_SegState_e`. */
+} EventLog_Segment_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static EventLog_Record_t evlog_ram[EVLOG_RAM_RECORDS];
+static volatile uint32_t ram_head;      ///< Zapisa potvrđenih u QSPI (mijenja samo glavna petlja)
+static volatile uint32_t ram_tail;      ///< Zapisa primljenih u RAM
+static volatile uint32_t next_seq;
+static EventLog_Segment_t seg[EVLOG_SEGMENTS];
+static uint8_t active;                  ///< Segment u koji se upisuje, `EVLOG_NONE` ako ga nema
+static uint8_t spare;                   ///< Sljedeći segment koji se otvara
+static uint8_t chain;                   ///< Segmenata sa zapisima, od `active` unazad
+static uint16_t write_slot;             ///< Sljedeći slobodan slot u `active`
+static uint32_t newest_number;          ///< Redni broj najnovijeg segmenta
+static volatile uint8_t op;             ///< `EventLog_Op_e`; čitanje QSPI samo dok je `EVLOG_OP_NONE`
+static uint8_t op_seg;
+static uint16_t op_count;               ///< Zapisa u `op_buf` za `EVLOG_OP_RECORDS`
+static uint32_t op_addr;
+static uint32_t op_len;
+static uint32_t op_tick;
+static EventLog_Record_t op_buf[EVLOG_PAGE_SLOTS];
+static uint32_t flush_tick;             ///< Posljednji upis zapisa ili prazan bafer
+static uint32_t lost_logged;            ///< `stats.lost` već zapisan kao `EVLOG_LOST`
+static bool forced;                     ///< `EventLog_Flush` u toku
+static volatile bool suspended;         ///< QSPI pripada FW agentu (`EventLog_Suspend`)
+static volatile bool op_flash;          ///< Flash izvršava `op`, QSPI nije mapiran
+static volatile bool in_service;        ///< Glavna petlja je u `EventLog_Service`
+static EventLog_Stats_t stats;
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Zabranjuje prekide (PRIMASK) oko upisa u RAM bafer i oko BSP poziva
+ * za QSPI, koje FW agent iz listenera ne smije zateći napola.
+ */
+static inline uint32_t EventLog_Lock(void)
+{
+#if EVLOG_CRITICAL
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+#else
+    return 0U;
+#endif
+}
+
+static inline void EventLog_Unlock(uint32_t primask)
+{
+#if EVLOG_CRITICAL
+    __set_PRIMASK(primask);
+#else
+    (void)primask;
+#endif
+}
+
+static uint8_t* EventLog_Put16(uint8_t* p, uint32_t value)
+{
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = (uint8_t)(value & 0xFFU);
+    return p;
+}
+
+static uint8_t* EventLog_Put32(uint8_t* p, uint32_t value)
+{
+    *p++ = (uint8_t)(value >> 24);
+    *p++ = (uint8_t)(value >> 16);
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = (uint8_t)(value & 0xFFU);
+    return p;
+}
+
+/**
+ * @brief CRC-16/CCITT (0x1021, početna vrijednost 0xFFFF), po 4 bita iz tabele.
+ * @note  Računa se i u `EventLog_Write` dok su prekidi zabranjeni.
+ */
+static uint16_t EventLog_Crc(const void* data, uint8_t len)
+{
+    static const uint16_t nibble[16] =
+    {
+        0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+        0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+    };
+    const uint8_t* p = (const uint8_t*)data;
+    uint16_t crc = 0xFFFFU;
+
+    while (len--)
+    {
+        crc = (uint16_t)((crc << 4) ^ nibble[(crc >> 12) ^ (*p >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ nibble[(crc >> 12) ^ (*p++ & 0x0FU)]);
+    }
+    return crc;
+}
+
+static bool EventLog_IsFilled(const void* data, uint32_t len, uint32_t word)
+{
+    const uint32_t* w = (const uint32_t*)data;
+
+    for (uint32_t i = 0U; i < (len / 4U); i++)
+    {
+        if (w[i] != word) return false;
+    }
+    return true;
+}
+
+static bool EventLog_Valid(const EventLog_Record_t* r)
+{
+    return !EventLog_IsFilled(r, EVLOG_RECORD_SIZE, 0xFFFFFFFFUL) && (r->crc == EventLog_Crc(r, EVLOG_CRC_LEN));
+}
+
+static bool EventLog_HeaderValid(const EventLog_Header_t* h)
+{
+    return (h->magic == EVLOG_MAGIC) && (h->crc == EventLog_Crc(h, EVLOG_CRC_LEN));
+}
+
+/**
+ * @brief Segment na mjestu `k` u lancu, 0 je najstariji.
+ */
+static uint8_t EventLog_ChainSeg(uint8_t k)
+{
+    return (uint8_t)((active + EVLOG_SEGMENTS + k + 1U - chain) % EVLOG_SEGMENTS);
+}
+
+static uint16_t EventLog_Used(uint8_t s)
+{
+    return (s == active) ? write_slot : (uint16_t)EVLOG_SLOTS;
+}
+
+/**
+ * @brief Prvi slot segmenta čiji važeći zapis ima redni broj >= `from`.
+ * @note  Binarna pretraga; neispravni slotovi (poluupisani zapisi) se
+ * preskaču udesno, a redni brojevi važećih zapisa u segmentu ne opadaju.
+ */
+static uint16_t EventLog_Seek(uint8_t s, uint32_t from)
+{
+    uint16_t lo = 1U;
+    uint16_t hi = EventLog_Used(s);
+
+    while (lo < hi)
+    {
+        uint16_t m = (uint16_t)((lo + hi) / 2U);
+        uint16_t v = m;
+        while ((v < hi) && !EventLog_Valid(EVLOG_SLOT(s, v))) v++;
+        if ((v < hi) && (EVLOG_SLOT(s, v)->seq < from)) lo = (uint16_t)(v + 1U);
+        else hi = m;
+    }
+    return lo;
+}
+
+/**
+ * @brief Da li se segment `spare` smije brisati u ovom prolazu.
+ * @note  Dok je screensaver aktivan niko ne gleda ekran, pa se briše odmah.
+ * Inače se brisanje odgađa do polovine aktivnog segmenta, kada i dalje ima
+ * dovoljno slotova da završi prije nego segment zatreba.
+ */
+static bool EventLog_EraseAllowed(void)
+{
+    if (forced || IsScrnsvrActiv()) return true;
+    return (active == EVLOG_NONE) || (write_slot >= EVLOG_ERASE_AHEAD_SLOT);
+}
+
+/**
+ * @brief Vraća QSPI u memorijski mapiran režim i provjerava završenu operaciju.
+ */
+static void EventLog_Finish(void)
+{
+    const EventLog_Record_t* slot0 = EVLOG_SLOT(op_seg, 0U);
+    uint32_t primask = EventLog_Lock();
+
+    if (QSPI_MemMapMode() != QSPI_OK)
+    {
+        MX_QSPI_Init();
+        QSPI_MemMapMode();
+    }
+    op_flash = false;
+    EventLog_Unlock(primask);
+    // Od ovdje je QSPI mapiran i FW agent smije prekinuti provjeru
+    QSPI_InvalidateCache(op_addr, op_len);
+
+    switch (op)
+    {
+    case EVLOG_OP_RECORDS:
+    {
+        // Potvrđeni su zapisi do prvog koji se ne poklapa; ostali idu u sljedeće slotove
+        uint16_t ok = 0U;
+        while ((ok < op_count) && (memcmp(EVLOG_SLOT(op_seg, write_slot + ok), &op_buf[ok], EVLOG_RECORD_SIZE) == 0)) ok++;
+        write_slot = (uint16_t)(write_slot + op_count);
+        ram_head += ok;
+        if (ok < op_count) stats.retries++;
+        flush_tick = HAL_GetTick();
+        break;
+    }
+
+    case EVLOG_OP_HEADER:
+        if (memcmp(slot0, op_buf, EVLOG_RECORD_SIZE) == 0)
+        {
+            const EventLog_Header_t* h = (const EventLog_Header_t*)op_buf;
+            seg[op_seg].state = EVLOG_SEG_DATA;
+            seg[op_seg].number = h->number;
+            seg[op_seg].first_seq = h->first_seq;
+            newest_number = h->number;
+            active = op_seg;
+            write_slot = 1U;
+            chain++;
+            spare = (uint8_t)((active + 1U) % EVLOG_SEGMENTS);
+            if (seg[spare].state == EVLOG_SEG_DATA)
+            {
+                // Najstariji segment se odbacuje da bi se obrisao unaprijed
+                seg[spare].state = EVLOG_SEG_STALE;
+                chain--;
+            }
+        }
+        else
+        {
+            seg[op_seg].state = EVLOG_SEG_DIRTY;
+            stats.retries++;
+        }
+        break;
+
+    case EVLOG_OP_DISCARD:
+        if (EventLog_IsFilled(slot0, EVLOG_RECORD_SIZE, 0UL)) seg[op_seg].state = EVLOG_SEG_DIRTY;
+        else stats.retries++;
+        break;
+
+    case EVLOG_OP_ERASE:
+        if (EventLog_IsFilled(slot0, EVLOG_SEGMENT_SIZE, 0xFFFFFFFFUL)) seg[op_seg].state = EVLOG_SEG_EMPTY;
+        else stats.retries++;
+        break;
+
+    default:
+        break;
+    }
+    op = EVLOG_OP_NONE;
+}
+
+/**
+ * @brief Pokreće programiranje ili brisanje i vraća se bez čekanja.
+ * @note  Cijela priprema i pokretanje su u kritičnoj sekciji: FW agent vidi
+ * ili mapiran QSPI bez operacije, ili pokrenutu operaciju (`op_flash`), a
+ * nakon `EventLog_Suspend` se nova operacija ne pokreće.
+ */
+static void EventLog_Start(uint8_t kind, uint8_t s)
+{
+    uint32_t addr = EVLOG_SEG_ADDR(s);
+    uint32_t len = EVLOG_RECORD_SIZE;
+    uint8_t res = QSPI_ERROR;
+    uint32_t primask = EventLog_Lock();
+
+    if (suspended && !forced)
+    {
+        EventLog_Unlock(primask);
+        return;
+    }
+
+    switch (kind)
+    {
+    case EVLOG_OP_RECORDS:
+    {
+        uint32_t pending = ram_tail - ram_head;
+        uint16_t room = (uint16_t)(EVLOG_PAGE_SLOTS - (write_slot % EVLOG_PAGE_SLOTS));
+        op_count = (uint16_t)((pending < room) ? pending : room);
+        for (uint16_t i = 0U; i < op_count; i++) op_buf[i] = evlog_ram[(ram_head + i) & EVLOG_RAM_MASK];
+        addr += (uint32_t)write_slot * EVLOG_RECORD_SIZE;
+        len = (uint32_t)op_count * EVLOG_RECORD_SIZE;
+        stats.programs++;
+        break;
+    }
+
+    case EVLOG_OP_HEADER:
+    {
+        EventLog_Header_t* h = (EventLog_Header_t*)op_buf;
+        h->magic = EVLOG_MAGIC;
+        h->number = newest_number + 1U;
+        h->first_seq = evlog_ram[ram_head & EVLOG_RAM_MASK].seq;
+        h->reserved = 0xFFFFU;
+        h->crc = EventLog_Crc(h, EVLOG_CRC_LEN);
+        stats.programs++;
+        break;
+    }
+
+    case EVLOG_OP_DISCARD:
+        memset(&op_buf[0], 0, sizeof(op_buf[0]));
+        stats.programs++;
+        break;
+
+    default:
+        len = EVLOG_SEGMENT_SIZE;
+        stats.erases++;
+        break;
+    }
+
+    op_seg = s;
+    op_addr = addr;
+    op_len = len;
+    op_tick = HAL_GetTick();
+    op = kind;      // od ovog trenutka GUI i čitanje ne diraju QSPI
+
+    if (QSPI_IndirectMode() == QSPI_OK)
+    {
+        if (kind == EVLOG_OP_ERASE) res = QSPI_EraseSubsectorStart(addr);
+        else res = QSPI_WritePageStart((uint8_t*)op_buf, addr, len);
+    }
+    op_flash = (res == QSPI_OK);
+    EventLog_Unlock(primask);
+    if (res != QSPI_OK) EventLog_Finish();  // provjera ne prolazi, ponavlja se u sljedećem prolazu
+}
+
+/**
+ * @brief Pokretanje nove operacije, ili provjera da li je završena ona u toku.
+ */
+static void EventLog_Step(void)
+{
+    if (op != EVLOG_OP_NONE)
+    {
+        uint32_t primask = EventLog_Lock();
+        uint8_t status = op_flash ? QSPI_GetStatus() : QSPI_OK;
+        bool busy = (status == QSPI_BUSY) || (status == QSPI_SUSPENDED);
+        if (busy && ((HAL_GetTick() - op_tick) >= EVLOG_OP_TIMEOUT_MS))
+        {
+            MX_QSPI_Init(); // reset memorije prekida operaciju, ishod odlučuje provjera
+            busy = false;
+        }
+        EventLog_Unlock(primask);
+        if (!busy) EventLog_Finish();
+        return;
+    }
+    if (!forced && suspended) return;
+
+    uint32_t lost = stats.lost;
+    if ((lost != lost_logged) && ((ram_tail - ram_head) < EVLOG_RAM_RECORDS) &&
+        EventLog_Write(EVLOG_LOST, 0U, lost - lost_logged)) lost_logged = lost;
+
+    uint32_t pending = ram_tail - ram_head;
+    bool room = (active != EVLOG_NONE) && (write_slot < EVLOG_SLOTS);
+
+    if (pending == 0U)
+    {
+        flush_tick = HAL_GetTick();
+    }
+    else if (room)
+    {
+        uint16_t page_room = (uint16_t)(EVLOG_PAGE_SLOTS - (write_slot % EVLOG_PAGE_SLOTS));
+        if (forced || (pending >= page_room) || ((HAL_GetTick() - flush_tick) >= EVLOG_FLUSH_DELAY_MS))
+        {
+            EventLog_Start(EVLOG_OP_RECORDS, active);
+            return;
+        }
+    }
+    else if (seg[spare].state == EVLOG_SEG_EMPTY)
+    {
+        EventLog_Start(EVLOG_OP_HEADER, spare);
+        return;
+    }
+
+    if (seg[spare].state == EVLOG_SEG_STALE) EventLog_Start(EVLOG_OP_DISCARD, spare);
+    else if ((seg[spare].state == EVLOG_SEG_DIRTY) && EventLog_EraseAllowed()) EventLog_Start(EVLOG_OP_ERASE, spare);
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Pronalazi lanac segmenata i mjesto nastavka upisa.
+ * @note  Poziva se iz `main()` nakon `QSPI_MemMapMode`, prije modula koji
+ * upisuju događaje. Najnoviji segment je onaj sa najvećim rednim brojem, a
+ * lanac čine segmenti iza njega unazad dok redni brojevi opadaju. Upis se
+ * nastavlja iza posljednjeg slota koji nije prazan, a redni broj iza
+ * najvećeg važećeg. Segment iza aktivnog se odmah odbacuje i briše.
+ */
+void EventLog_Init(void)
+{
+    memset(seg, 0, sizeof(seg));
+    memset(&stats, 0, sizeof(stats));
+    ram_head = 0U;
+    ram_tail = 0U;
+    next_seq = 1U;
+    active = EVLOG_NONE;
+    chain = 0U;
+    write_slot = EVLOG_SLOTS;
+    newest_number = 0U;
+    op = EVLOG_OP_NONE;
+    op_flash = false;
+    forced = false;
+    suspended = false;
+    in_service = false;
+    lost_logged = 0U;
+    flush_tick = HAL_GetTick();
+
+    for (uint8_t s = 0U; s < EVLOG_SEGMENTS; s++)
+    {
+        const EventLog_Header_t* h = (const EventLog_Header_t*)EVLOG_SLOT(s, 0U);
+        if (EventLog_HeaderValid(h))
+        {
+            seg[s].state = EVLOG_SEG_DATA;
+            seg[s].number = h->number;
+            seg[s].first_seq = h->first_seq;
+            if ((active == EVLOG_NONE) || (h->number > newest_number))
+            {
+                newest_number = h->number;
+                active = s;
+            }
+        }
+        else if (EventLog_IsFilled(h, EVLOG_SEGMENT_SIZE, 0xFFFFFFFFUL))
+        {
+            seg[s].state = EVLOG_SEG_EMPTY;
+        }
+    }
+
+    if (active == EVLOG_NONE)
+    {
+        spare = 0U;
+        return;
+    }
+
+    // Lanac unazad od najnovijeg; segmenti sa zaglavljem van lanca su zastarjeli
+    uint8_t prev = active;
+    chain = 1U;
+    while (chain < EVLOG_SEGMENTS)
+    {
+        uint8_t s = (uint8_t)((active + EVLOG_SEGMENTS - chain) % EVLOG_SEGMENTS);
+        if ((seg[s].state != EVLOG_SEG_DATA) || (seg[s].number >= seg[prev].number) ||
+            (seg[s].first_seq > seg[prev].first_seq)) break;
+        prev = s;
+        chain++;
+    }
+    for (uint8_t k = chain; k < EVLOG_SEGMENTS; k++)
+    {
+        uint8_t s = (uint8_t)((active + EVLOG_SEGMENTS - k) % EVLOG_SEGMENTS);
+        if (seg[s].state == EVLOG_SEG_DATA) seg[s].state = EVLOG_SEG_STALE;
+    }
+
+    // Nastavak iza posljednjeg zauzetog slota, i poluupisanog
+    while ((write_slot > 1U) && EventLog_IsFilled(EVLOG_SLOT(active, write_slot - 1U), EVLOG_RECORD_SIZE, 0xFFFFFFFFUL))
+    {
+        write_slot--;
+    }
+    next_seq = seg[active].first_seq;
+    for (uint16_t slot = 1U; slot < write_slot; slot++)
+    {
+        const EventLog_Record_t* r = EVLOG_SLOT(active, slot);
+        if (EventLog_Valid(r) && (r->seq >= next_seq)) next_seq = r->seq + 1U;
+    }
+
+    spare = (uint8_t)((active + 1U) % EVLOG_SEGMENTS);
+    if (seg[spare].state == EVLOG_SEG_DATA)
+    {
+        seg[spare].state = EVLOG_SEG_STALE;
+        chain--;
+    }
+}
+
+/**
+ * @brief Jedan korak upisa: provjera završene operacije ili pokretanje nove.
+ * @note  Zadatak planera (`TASK_IO_PERIOD`). Nikad ne čeka flash: zapisi se
+ * upisuju kada se skupi stranica ili nakon `EVLOG_FLUSH_DELAY_MS`, a
+ * segment iza aktivnog se briše unaprijed (`EventLog_EraseAllowed`). Između
+ * `EventLog_Suspend` i `EventLog_Resume` QSPI pripada FW agentu i dnevnik samo
+ * skuplja zapise u RAM-u.
+ */
+void EventLog_Service(void)
+{
+    bool outer = in_service;    // `EventLog_Flush` iz listenera može zateći glavnu petlju ovdje
+
+    in_service = true;
+    EventLog_Step();
+    in_service = outer;
+}
+
+/**
+ * @brief Upisuje događaj u RAM bafer.
+ * @note  Sigurno iz glavne petlje i iz listenera (prekid); kratko zabranjuje
+ * prekide. Kada je bafer pun zapis se odbacuje, a broj odbačenih se
+ * kasnije upiše kao `EVLOG_LOST`.
+ * @param code  `EventLog_Code_e`.
+ * @param arg   Argument (značenje po vrsti događaja).
+ * @param value Vrijednost (značenje po vrsti događaja).
+ * @retval bool `false` ako je bafer pun.
+ */
+bool EventLog_Write(uint8_t code, uint8_t arg, uint32_t value)
+{
+    EventLog_Record_t rec;
+    bool ok = false;
+
+    rec.time = HAL_GetTick() / 1000U;
+    rec.value = value;
+    rec.code = code;
+    rec.arg = arg;
+
+    uint32_t primask = EventLog_Lock();
+    if ((ram_tail - ram_head) < EVLOG_RAM_RECORDS)
+    {
+        rec.seq = next_seq++;
+        rec.crc = EventLog_Crc(&rec, EVLOG_CRC_LEN);
+        evlog_ram[ram_tail & EVLOG_RAM_MASK] = rec;
+        ram_tail++;
+        ok = true;
+    }
+    else
+    {
+        stats.lost++;
+    }
+    EventLog_Unlock(primask);
+    return ok;
+}
+
+/**
+ * @brief Upisuje sve zapise iz RAM-a u QSPI i čeka kraj.
+ * @note  Blokira; samo prije namjernog restarta (npr. nakon ažuriranja
+ * firmvera), kada zapisi iz RAM-a inače ne bi preživjeli.
+ * @param timeout_ms Najduže čekanje.
+ * @retval bool `true` ako su svi zapisi upisani.
+ */
+bool EventLog_Flush(uint32_t timeout_ms)
+{
+    uint32_t start = HAL_GetTick();
+
+    forced = true;
+    while (((ram_tail != ram_head) || (op != EVLOG_OP_NONE)) && ((HAL_GetTick() - start) < timeout_ms))
+    {
+        EventLog_Service();
+        if (op != EVLOG_OP_NONE) HAL_Delay(1);
+    }
+    forced = false;
+    return (ram_tail == ram_head);
+}
+
+/**
+ * @brief Da li je QSPI zauzet upisom dnevnika (nije memorijski mapiran).
+ * @note  Dok je `true` ne smiju se čitati bitmape i fontovi iz QSPI.
+ */
+bool EventLog_IsFlashBusy(void)
+{
+    return (op != EVLOG_OP_NONE);
+}
+
+/**
+ * @brief Predaje QSPI FW agentu: završava operaciju u toku i zadržava nove.
+ * @note  Poziva se iz listenera (prekid), prije prvog agentovog pristupa
+ * QSPI-u. BSP pozivi dnevnika su u kritičnim sekcijama, pa ih prekid nikad
+ * ne zatekne napola. Ako flash još programira ili briše, čeka se kraj
+ * (najviše do `EVLOG_OP_TIMEOUT_MS` od početka, zatim reset memorije), pa
+ * agentov `MX_QSPI_Init` ne prekida operaciju dnevnika. Provjeru završene
+ * operacije radi odmah, osim ako je prekid zatekao `EventLog_Service`; tada
+ * je dovršava glavna petlja. Do `EventLog_Resume` zapisi ostaju u RAM-u.
+ */
+void EventLog_Suspend(void)
+{
+    suspended = true;
+    if (op_flash)
+    {
+        uint8_t status = QSPI_GetStatus();
+        while (((status == QSPI_BUSY) || (status == QSPI_SUSPENDED)) && ((HAL_GetTick() - op_tick) < EVLOG_OP_TIMEOUT_MS))
+        {
+            HAL_Delay(1);
+            status = QSPI_GetStatus();
+        }
+        if ((status == QSPI_BUSY) || (status == QSPI_SUSPENDED)) MX_QSPI_Init();
+        op_flash = false;
+    }
+    if (!in_service && (op != EVLOG_OP_NONE)) EventLog_Finish();
+}
+
+/**
+ * @brief Vraća QSPI dnevniku nakon `EventLog_Suspend` (prekinuto ažuriranje).
+ * @note  Sigurno iz prekida; agent prije poziva vraća QSPI u mapiran režim.
+ */
+void EventLog_Resume(void)
+{
+    suspended = false;
+}
+
+/**
+ * @brief Čita zapise redom od prvog čiji je redni broj >= `from_seq`.
+ * @note  Početni segment se nalazi po prvim rednim brojevima segmenata u
+ * RAM-u, a slot binarnom pretragom u segmentu. Iza zapisa iz QSPI slijede
+ * zapisi koji još čekaju u RAM-u. Sigurno i iz listenera.
+ * @param from_seq Najmanji redni broj.
+ * @param records  Niz za zapise.
+ * @param count    Veličina niza.
+ * @retval Broj pročitanih zapisa; 0 i dok je QSPI zauzet (`EventLog_IsFlashBusy`).
+ */
+uint16_t EventLog_Read(uint32_t from_seq, EventLog_Record_t* records, uint16_t count)
+{
+    uint16_t n = 0U;
+    uint32_t want = from_seq;
+    uint32_t tail = ram_tail;
+
+    if ((op != EVLOG_OP_NONE) || (records == NULL)) return 0U;
+
+    if (chain != 0U)
+    {
+        uint8_t k = 0U;
+        for (uint8_t i = 1U; i < chain; i++)
+        {
+            if (seg[EventLog_ChainSeg(i)].first_seq <= from_seq) k = i;
+        }
+
+        uint16_t slot = EventLog_Seek(EventLog_ChainSeg(k), from_seq);
+        for (; (k < chain) && (n < count); k++, slot = 1U)
+        {
+            uint8_t s = EventLog_ChainSeg(k);
+            uint16_t used = EventLog_Used(s);
+            for (; (slot < used) && (n < count); slot++)
+            {
+                const EventLog_Record_t* r = EVLOG_SLOT(s, slot);
+                if (EventLog_Valid(r) && (r->seq >= want))
+                {
+                    records[n++] = *r;
+                    want = r->seq + 1U;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = ram_head; (i != tail) && (n < count); i++)
+    {
+        const EventLog_Record_t* r = &evlog_ram[i & EVLOG_RAM_MASK];
+        if (r->seq >= want)
+        {
+            records[n++] = *r;
+            want = r->seq + 1U;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Vraća stanje dnevnika.
+ */
+const EventLog_Stats_t* EventLog_GetStats(void)
+{
+    uint32_t head = ram_head;
+    uint32_t tail = ram_tail;
+
+    stats.next_seq = next_seq;
+    stats.pending = (uint16_t)(tail - head);
+    stats.durable_seq = (tail != head) ? evlog_ram[head & EVLOG_RAM_MASK].seq : stats.next_seq;
+    stats.first_seq = (chain != 0U) ? seg[EventLog_ChainSeg(0U)].first_seq : stats.durable_seq;
+    stats.write_slot = write_slot;
+    stats.segment = (active == EVLOG_NONE) ? (uint8_t)EVLOG_SEGMENTS : active;
+    stats.segments = chain;
+    return &stats;
+}
+
+/**
+ * @brief Pakuje stanje ili zapise u odgovor na `DIAG_GET`.
+ * @param subcmd   `DIAG_LOG_STATUS` ili `DIAG_LOG_READ`.
+ * @param count    Za `DIAG_LOG_READ` najviše zapisa, 0 = koliko stane.
+ * @param from_seq Za `DIAG_LOG_READ` najmanji redni broj.
+ * @param buf      Bafer za odgovor.
+ * @param size     Veličina bafera.
+ * @retval Dužina odgovora, 0 za nepoznatu pod-komandu i dok je QSPI zauzet
+ *         (klijent ponavlja upit).
+ * @note  Treći bajt zaglavlja je 1 ako iza posljednjeg poslanog ima još
+ * zapisa. Statusni zapis: prvi, sljedeći i potvrđeni redni broj, izgubljeni,
+ * programiranja, brisanja i ponavljanja (32 bita), zapisi u RAM-u i slot
+ * upisa (16 bita), aktivni segment, segmenata sa zapisima, broj segmenata i
+ * zapisa po segmentu (16 bita). Zapis: redni broj, vrijeme, vrijednost
+ * (32 bita), vrsta i argument. Klijent nastavlja od posljednjeg rednog
+ * broja + 1.
+ */
+uint16_t EventLog_Serialize(uint8_t subcmd, uint8_t count, uint32_t from_seq, uint8_t* buf, uint16_t size)
+{
+    uint8_t* p = buf + EVLOG_HEADER_SIZE;
+    uint8_t more = 0U;
+    uint8_t n = 0U;
+
+    if ((size < EVLOG_HEADER_SIZE + EVLOG_STATUS_RECORD_SIZE) || (op != EVLOG_OP_NONE)) return 0U;
+
+    switch (subcmd)
+    {
+    case DIAG_LOG_STATUS:
+    {
+        const EventLog_Stats_t* st = EventLog_GetStats();
+        p = EventLog_Put32(p, st->first_seq);
+        p = EventLog_Put32(p, st->next_seq);
+        p = EventLog_Put32(p, st->durable_seq);
+        p = EventLog_Put32(p, st->lost);
+        p = EventLog_Put32(p, st->programs);
+        p = EventLog_Put32(p, st->erases);
+        p = EventLog_Put32(p, st->retries);
+        p = EventLog_Put16(p, st->pending);
+        p = EventLog_Put16(p, st->write_slot);
+        *p++ = st->segment;
+        *p++ = st->segments;
+        *p++ = EVLOG_SEGMENTS;
+        p = EventLog_Put16(p, EVLOG_SLOTS - 1U);
+        n = 1U;
+        break;
+    }
+
+    case DIAG_LOG_READ:
+    {
+        EventLog_Record_t rec[EVLOG_READ_MAX + 1U];
+        uint16_t max = (uint16_t)((size - EVLOG_HEADER_SIZE) / EVLOG_READ_RECORD_SIZE);
+        if (max > EVLOG_READ_MAX) max = EVLOG_READ_MAX;
+        if ((count != 0U) && (count < max)) max = count;
+
+        uint16_t got = EventLog_Read(from_seq, rec, (uint16_t)(max + 1U));
+        if (got > max)
+        {
+            got = max;
+            more = 1U;
+        }
+        for (uint16_t i = 0U; i < got; i++)
+        {
+            p = EventLog_Put32(p, rec[i].seq);
+            p = EventLog_Put32(p, rec[i].time);
+            p = EventLog_Put32(p, rec[i].value);
+            *p++ = rec[i].code;
+            *p++ = rec[i].arg;
+        }
+        n = (uint8_t)got;
+        break;
+    }
+
+    default:
+        return 0U;
+    }
+
+    buf[0] = subcmd;
+    buf[1] = count;
+    buf[2] = more;
+    buf[3] = n;
+    return (uint16_t)(p - buf);
+}
@@ -0,0 +1,262 @@
+/**
+ ******************************************************************************
+ * @file    fancoil.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija PI/PID regulatora i relejnog samopodešavanja.
+ *
+ * @note    Regulator radi u smjeru zahtjeva: kod hlađenja se mjerenje i
+ * zadata vrijednost negiraju, pa je pozitivna greška uvijek "treba više
+ * snage". Sve veličine su cjelobrojne: temperature u desetinkama °C,
+ * zahtjev u promilima, a integrator u promilima << 8, da bi i mali
+ * doprinosi (mala greška, dugo Ti) ostali sačuvani.
+ ******************************************************************************
+ */
+
+#if (__FANCOIL_H__ != FW_BUILD)
+#error "fancoil header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "fancoil.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define FANC_SAMPLE_S                   (FANC_SAMPLE_MS / 1000U)
+#define FANC_INTEGRAL_SHIFT             8U
+#define FANC_INTEGRAL_MAX               ((int32_t)FANC_DEMAND_MAX << FANC_INTEGRAL_SHIFT)
+
+/**
+ * Tyreus-Luyben PI: Kp = Ku / 3,2, Ti = 2,2 * Pu, gdje je Ku = 4d / (pi * a)
+ * za relej amplitude d = FANC_DEMAND_MAX / 2 i amplitudu oscilacije a.
+ * Sa razlikom vrh-dno h = 2a (desetinke °C) i Kp u promilima po °C:
+ * Kp = 10 * 4 * (MAX / 2) * 2 / (pi * h * 3,2) = 40 * MAX / (10,053 * h).
+ */
+#define FANC_TL_KP_NUM                  (40UL * FANC_DEMAND_MAX * 1000UL)
+#define FANC_TL_KP_DEN                  10053UL
+#define FANC_TL_TI_NUM                  22U     ///< Ti = Pu * 22 / 10
+#define FANC_TL_TI_DEN                  10U
+
+#define FANC_KP_MIN                     10U
+#define FANC_KP_MAX                     4000U
+#define FANC_TI_MIN                     60U
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Završava relejni test i računa parametre.
+ */
+static void FanCoil_TuneFinish(FanCoil_t* fc)
+{
+    const uint32_t peak_to_peak = (uint32_t)fc->tune_amp_sum / FANC_TUNE_CYCLES;
+    const uint32_t period_s = (fc->tune_period_sum / FANC_TUNE_CYCLES) / 1000U;
+    uint32_t kp, ti;
+
+    if (peak_to_peak < (2U * FANC_TUNE_MIN_AMPLITUDE))
+    {
+        fc->tune = FANC_TUNE_FAILED;
+        return;
+    }
+
+    kp = FANC_TL_KP_NUM / (FANC_TL_KP_DEN * peak_to_peak);
+    ti = (period_s * FANC_TL_TI_NUM) / FANC_TL_TI_DEN;
+    if (kp < FANC_KP_MIN) kp = FANC_KP_MIN;
+    if (kp > FANC_KP_MAX) kp = FANC_KP_MAX;
+    if (ti < FANC_TI_MIN) ti = FANC_TI_MIN;
+    if (ti > 0xFFFFU) ti = 0xFFFFU;
+
+    fc->params.kp = (uint16_t)kp;
+    fc->params.ti = (uint16_t)ti;
+    fc->params.td = 0U;
+    fc->tune = FANC_TUNE_DONE;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Postavlja parametre i briše stanje regulatora.
+ * @param fc     Regulator.
+ * @param params Parametri (iz EEPROM-a ili podrazumijevani).
+ * @param now    `HAL_GetTick()`.
+ */
+void FanCoil_Init(FanCoil_t* fc, const FanCoil_Params_t* params, uint32_t now)
+{
+    memset(fc, 0, sizeof(FanCoil_t));
+    fc->params = *params;
+    FanCoil_Reset(fc, now);
+}
+
+/**
+ * @brief Briše integrator, derivaciju i stanje izlaza (promjena moda rada).
+ * @note  Parametri i rezultat samopodešavanja ostaju.
+ */
+void FanCoil_Reset(FanCoil_t* fc, uint32_t now)
+{
+    fc->integral = 0;
+    fc->deriv = 0;
+    fc->primed = false;
+    fc->demand = 0;
+    fc->boost = 0;
+    fc->speed_since = now - FANC_STAGE_DWELL_MS;    // Prvi stepen bez čekanja
+    fc->speed = 0U;
+    if (fc->tune == FANC_TUNE_RUNNING) fc->tune = FANC_TUNE_IDLE;
+}
+
+/**
+ * @brief Jedan korak regulatora, poziva se svakih `FANC_SAMPLE_MS`.
+ * @param sp      Zadata temperatura, desetinke °C.
+ * @param pv      Izmjerena temperatura, desetinke °C.
+ * @param heating true za grijanje, false za hlađenje.
+ * @param use_d   Uključuje D član (PID).
+ * @retval Zahtjev, 0..`FANC_DEMAND_MAX` promila.
+ */
+int16_t FanCoil_Update(FanCoil_t* fc, int16_t sp, int16_t pv, bool heating, bool use_d)
+{
+    const int32_t y = heating ? pv : -pv;
+    const int32_t e = (heating ? sp : -sp) - y;
+    const int32_t kp = fc->params.kp;
+    const int32_t p = (kp * e) / 10;
+    int32_t d = 0;
+    int32_t u;
+
+    if (use_d && (fc->params.td != 0U) && fc->primed)
+    {
+        // Derivacija mjerenja: rast temperature u smjeru zahtjeva smanjuje izlaz
+        const int32_t raw = -(kp * (int32_t)fc->params.td * (y - fc->last_pv)) / (10 * (int32_t)FANC_SAMPLE_S);
+        fc->deriv += (raw - fc->deriv) / (1 << FANC_DERIV_FILTER_SHIFT);
+        d = fc->deriv;
+    }
+    fc->last_pv = (int16_t)y;
+    fc->primed = true;
+
+    if (fc->params.ti != 0U)
+    {
+        const int32_t di = (int32_t)(((int64_t)kp * e * (int32_t)FANC_SAMPLE_S * (1 << FANC_INTEGRAL_SHIFT)) / (10 * (int32_t)fc->params.ti));
+        int32_t integral = fc->integral + di;
+
+        if (integral < 0) integral = 0;
+        if (integral > FANC_INTEGRAL_MAX) integral = FANC_INTEGRAL_MAX;
+        u = p + (integral >> FANC_INTEGRAL_SHIFT) + d;
+        // Anti-windup: integrator ne raste dalje u smjeru zasićenog izlaza
+        if (!(((u > FANC_DEMAND_MAX) && (di > 0)) || ((u < 0) && (di < 0)))) fc->integral = integral;
+    }
+
+    fc->boost = (int16_t)((p < 0) ? 0 : ((p > FANC_DEMAND_MAX) ? FANC_DEMAND_MAX : p));
+    u = p + (fc->integral >> FANC_INTEGRAL_SHIFT) + d;
+    if (u < 0) u = 0;
+    if (u > FANC_DEMAND_MAX) u = FANC_DEMAND_MAX;
+    fc->demand = (int16_t)u;
+    return fc->demand;
+}
+
+/**
+ * @brief Preslikava zahtjev na stepen ventilatora; ventil je otvoren za stepen > 0.
+ * @param demand    Zahtjev iz `FanCoil_Update`.
+ * @param max_speed 1 za ON/OFF ventilator, 3 za tri brzine.
+ * @param now       `HAL_GetTick()`; poziva se često (svakih 100 ms).
+ * @retval Stepen 0..`max_speed`.
+ * @note  Svaka promjena stepena, i otvaranje ili zatvaranje ventila, čeka
+ * `FANC_STAGE_DWELL_MS` od prethodne.
+ */
+uint8_t FanCoil_Output(FanCoil_t* fc, int16_t demand, uint8_t max_speed, uint32_t now)
+{
+    static const int16_t speed_on[4] = { 0, 0, FANC_SPEED2_ON, FANC_SPEED3_ON };
+    uint8_t target = fc->speed;
+
+    if (target == 0U)
+    {
+        if (demand >= FANC_VALVE_ON) target = 1U;
+    }
+    else if (demand < FANC_VALVE_OFF)
+    {
+        target = 0U;
+    }
+
+    if (target != 0U)
+    {
+        // Ventil otvoren: brzina po P članu, sa histerezom
+        while ((target < 3U) && (fc->boost >= speed_on[target + 1U])) target++;
+        while ((target > 1U) && (fc->boost < (speed_on[target] - FANC_SPEED_HYST))) target--;
+    }
+    if (target > max_speed) target = max_speed;
+
+    if ((target != fc->speed) && ((now - fc->speed_since) >= FANC_STAGE_DWELL_MS))
+    {
+        fc->speed = target;
+        fc->speed_since = now;
+    }
+    return fc->speed;
+}
+
+/**
+ * @brief Pokreće relejni test.
+ */
+void FanCoil_TuneStart(FanCoil_t* fc, uint32_t now)
+{
+    fc->tune = FANC_TUNE_RUNNING;
+    fc->relay_on = false;
+    fc->tune_switches = 0U;
+    fc->tune_start = now;
+    fc->tune_last_on = now;
+    fc->tune_period_sum = 0U;
+    fc->tune_amp_sum = 0;
+    fc->tune_max = INT16_MIN;
+    fc->tune_min = INT16_MAX;
+}
+
+/**
+ * @brief Korak relejnog testa, poziva se svakih `FANC_SAMPLE_MS` umjesto `FanCoil_Update`.
+ * @retval Zahtjev releja: 0 ili `FANC_DEMAND_MAX`.
+ * @note  Prvo uključenje pokreće test, prvi period služi za ustaljivanje, a
+ * sljedećih `FANC_TUNE_CYCLES` perioda (od uključenja do uključenja) se
+ * mjeri. Po završetku `tune` je `FANC_TUNE_DONE` sa novim `params`, ili
+ * `FANC_TUNE_FAILED` (premala amplituda ili isteklo vrijeme).
+ */
+int16_t FanCoil_TuneStep(FanCoil_t* fc, int16_t sp, int16_t pv, bool heating, uint32_t now)
+{
+    const int16_t y = heating ? pv : (int16_t)-pv;
+    const int16_t e = (int16_t)((heating ? sp : -sp) - y);
+
+    if (fc->tune != FANC_TUNE_RUNNING) return 0;
+    if ((now - fc->tune_start) >= FANC_TUNE_TIMEOUT_MS)
+    {
+        fc->tune = FANC_TUNE_FAILED;
+        fc->relay_on = false;
+        return 0;
+    }
+
+    if (y > fc->tune_max) fc->tune_max = y;
+    if (y < fc->tune_min) fc->tune_min = y;
+
+    if (!fc->relay_on && (e > FANC_TUNE_HYST))
+    {
+        fc->relay_on = true;
+        if (fc->tune_switches >= 2U)
+        {
+            fc->tune_period_sum += now - fc->tune_last_on;
+            fc->tune_amp_sum += fc->tune_max - fc->tune_min;
+        }
+        fc->tune_switches++;
+        fc->tune_last_on = now;
+        fc->tune_max = y;
+        fc->tune_min = y;
+        if (fc->tune_switches >= (FANC_TUNE_CYCLES + 2U))
+        {
+            fc->relay_on = false;
+            FanCoil_TuneFinish(fc);
+            return 0;
+        }
+    }
+    else if (fc->relay_on && (e < -FANC_TUNE_HYST))
+    {
+        fc->relay_on = false;
+    }
+    return fc->relay_on ? FANC_DEMAND_MAX : 0;
+}
@@ -19,6 +19,7 @@
 #include "rs485.h" // Potrebno za slanje ACK/NACK odgovora
 #include "stm32746g_qspi.h"
 #include "stm32746g_eeprom.h"
+#include "eventlog.h"
 
 //=============================================================================
 // Definicije Vremenskih Ograničenja (Timeouts) i Parametara
@@ -30,6 +31,13 @@
  */
 #define T_INACTIVITY_TIMEOUT 5000 // 5 sekundi
 
+/**
+ * @brief Najduže čekanje (u ms) da dnevnik događaja upiše zapise iz RAM-a
+ * prije restarta nakon uspješnog prijema.
+ * @note  Pokriva brisanje podsektora, zaglavlje i upis zapisa.
+ */
+#define T_EVLOG_FLUSH_TIMEOUT 1000
+
 /**
  * @brief Adresa u EEPROM-u gdje se upisuje marker za bootloader.
  * @note  Bootloader pri startu provjerava ovu lokaciju.
@@ -66,7 +74,8 @@ typedef enum {
     NACK_REASON_WRITE_FAILED,
     NACK_REASON_CRC_MISMATCH,
     NACK_REASON_UNEXPECTED_PACKET,
-    NACK_REASON_SIZE_MISMATCH
+    NACK_REASON_SIZE_MISMATCH,
+    NACK_REASON_TIMEOUT         // ne šalje se, samo razlog prekida u dnevniku događaja
 } FwUpdate_NackReason_e;
 
 /**
@@ -108,7 +117,7 @@ static uint32_t staging_qspi_addr;
 //=============================================================================
 static void HandleMessage_Idle(TinyFrame *tf, TF_Msg *msg);
 static void HandleMessage_Receiving(TinyFrame *tf, TF_Msg *msg);
-static void Agent_HandleFailure(void); // << NOVO
+static void Agent_HandleFailure(uint8_t reason); // << NOVO
 
 //=============================================================================
 // Implementacija Javnih Funkcija (API)
@@ -151,7 +160,7 @@ void FwUpdateAgent_Service(void)
         if ((HAL_GetTick() - agent.inactivityTimerStart) > T_INACTIVITY_TIMEOUT)
         {
             // Server predugo nije poslao paket. Prekidamo proces.
-            Agent_HandleFailure();
+            Agent_HandleFailure(NACK_REASON_TIMEOUT);
         }
     }
 }
@@ -219,11 +228,16 @@ bool FwUpdateAgent_IsActive(void)
  * @note        Ovo je ključna funkcija za robusnost. Kada se pozove, ona
  * briše potencijalno neispravne podatke iz QSPI memorije na
  * "staging" adresi, a zatim resetuje kompletan agent u početno
- * stanje pozivom `FwUpdateAgent_Init()`.
+ * stanje pozivom `FwUpdateAgent_Init()`. Razlog i broj primljenih
+ * bajtova se upisuju u dnevnik događaja, kojem se QSPI zatim vraća
+ * (`EventLog_Resume`).
+ * @param       reason Razlog prekida (`FwUpdate_NackReason_e`).
  ******************************************************************************
  */
-static void Agent_HandleFailure(void)
+static void Agent_HandleFailure(uint8_t reason)
 {
+    EventLog_Write(EVLOG_FW_UPDATE, reason, agent.bytesReceived);
+
     // Ako imamo validne informacije o firmveru (veličina i adresa), brišemo QSPI.
     if (staging_qspi_addr != 0 && agent.fwInfo.size > 0)
     {
@@ -234,6 +248,9 @@ static void Agent_HandleFailure(void)
         QSPI_MemMapMode();
     }
 
+    // QSPI je ponovo mapiran, dnevnik nastavlja upis iz RAM-a.
+    EventLog_Resume();
+
     // Vraćamo agenta na početne postavke, spreman je za novi pokušaj.
     FwUpdateAgent_Init();
 }
@@ -243,7 +260,8 @@ static void Agent_HandleFailure(void)
  * @brief       Handler za obradu poruka kada je Agent u IDLE stanju.
  * @author      Gemini & [Vaše Ime]
  * @note        U ovom stanju, jedina relevantna poruka je `SUB_CMD_START_REQUEST`.
- * Funkcija vrši sve pred-provjere (veličina, verzija), briše
+ * Funkcija vrši sve pred-provjere (veličina, verzija), preuzima QSPI
+ * od dnevnika događaja (`EventLog_Suspend`), briše
  * potreban segment QSPI memorije i ako je sve u redu, šalje ACK
  * i prelazi u `FSM_RECEIVING` stanje. U slučaju greške, poziva
  * `Agent_HandleFailure()` i šalje NACK.
@@ -266,10 +284,13 @@ static void HandleMessage_Idle(TinyFrame *tf, TF_Msg *msg)
     {
         uint8_t nack_response[] = {SUB_CMD_START_NACK, tfifa, NACK_REASON_INVALID_VERSION};
         TF_SendSimple(tf, FIRMWARE_UPDATE, nack_response, sizeof(nack_response));
+        EventLog_Write(EVLOG_FW_UPDATE, NACK_REASON_INVALID_VERSION, agent.fwInfo.size);
         // Ne pozivamo Agent_HandleFailure() jer još ništa nismo ni počeli raditi (npr. brisati memoriju)
         return;
     }
 
+    // Dnevnik završava upis ili brisanje u toku i do kraja prenosa ne dira QSPI
+    EventLog_Suspend();
     MX_QSPI_Init();
     if (QSPI_Erase(staging_qspi_addr, staging_qspi_addr + agent.fwInfo.size) != QSPI_OK)
     {
@@ -277,7 +298,7 @@ static void HandleMessage_Idle(TinyFrame *tf, TF_Msg *msg)
         QSPI_MemMapMode();
         uint8_t nack_response[] = {SUB_CMD_START_NACK, tfifa, NACK_REASON_ERASE_FAILED};
         TF_SendSimple(tf, FIRMWARE_UPDATE, nack_response, sizeof(nack_response));
-        Agent_HandleFailure(); // Greška, očisti i resetuj
+        Agent_HandleFailure(NACK_REASON_ERASE_FAILED); // Greška, očisti i resetuj
         return;
     }
     MX_QSPI_Init();
@@ -292,6 +313,7 @@ static void HandleMessage_Idle(TinyFrame *tf, TF_Msg *msg)
     TF_SendSimple(tf, FIRMWARE_UPDATE, ack_response, sizeof(ack_response));
 
     agent.currentState = FSM_RECEIVING;
+    EventLog_Write(EVLOG_FW_UPDATE, EVLOG_FW_START, agent.fwInfo.size);
 }
 
 /**
@@ -335,7 +357,7 @@ static void HandleMessage_Receiving(TinyFrame *tf, TF_Msg *msg)
                 TF_SendSimple(tf, FIRMWARE_UPDATE, ack_payload, sizeof(ack_payload));
             } else {
                 // Greška pri upisu u QSPI!
-                Agent_HandleFailure();
+                Agent_HandleFailure(NACK_REASON_WRITE_FAILED);
             }
             MX_QSPI_Init();
             QSPI_MemMapMode();
@@ -356,7 +378,7 @@ static void HandleMessage_Receiving(TinyFrame *tf, TF_Msg *msg)
         if (agent.bytesReceived != agent.fwInfo.size) {
             uint8_t nack_response[] = {SUB_CMD_FINISH_NACK, tfifa, NACK_REASON_SIZE_MISMATCH};
             TF_SendSimple(tf, FIRMWARE_UPDATE, nack_response, sizeof(nack_response));
-            Agent_HandleFailure();
+            Agent_HandleFailure(NACK_REASON_SIZE_MISMATCH);
             break;
         }
 
@@ -406,6 +428,9 @@ static void HandleMessage_Receiving(TinyFrame *tf, TF_Msg *msg)
 //                EE_WriteBuffer((uint8_t*)&receivedFwInfo, EE_BOOTLOADER_MARKER_ADDR, sizeof(FwInfoTypeDef));
             uint8_t ack_response[] = {SUB_CMD_FINISH_ACK, tfifa};
             TF_SendSimple(tf, FIRMWARE_UPDATE, ack_response, sizeof(ack_response));
+            // Zapisi iz RAM-a ne bi preživjeli restart
+            EventLog_Write(EVLOG_FW_UPDATE, EVLOG_FW_DONE, agent.bytesReceived);
+            EventLog_Flush(T_EVLOG_FLUSH_TIMEOUT);
             HAL_Delay(100);
             SYSRestart();
         }
@@ -414,7 +439,7 @@ static void HandleMessage_Receiving(TinyFrame *tf, TF_Msg *msg)
             // Greška se desila ili tokom rekonfiguracije ili tokom same CRC provjere.
             uint8_t nack_response[] = {SUB_CMD_FINISH_NACK, tfifa, NACK_REASON_CRC_MISMATCH};
             TF_SendSimple(tf, FIRMWARE_UPDATE, nack_response, sizeof(nack_response));
-            Agent_HandleFailure();
+            Agent_HandleFailure(NACK_REASON_CRC_MISMATCH);
         }
         break;
     }
@@ -24,6 +24,8 @@
 #include "display.h"
 #include "rs485.h"
 #include "stm32746g_eeprom.h"
+#include "timer_wheel.h"
+#include "devreg.h"
 
 /*============================================================================*/
 /* DEFINICIJA INTERNE "RUNTIME" STRUKTURE                                     */
@@ -48,6 +50,8 @@ struct Gate_s
     GateTimerType_e active_timer_type;
     /** @brief Vrijeme (HAL_GetTick()) kada je posljednji tajmer pokrenut. */
     uint32_t        timer_start_tick;
+    /** @brief Tajmer u točku tajmera; ističe na roku za `active_timer_type`. */
+    TimerWheel_Timer_t timer;
     /** @brief Index releja (1-4) za koji je vezan aktivni pulsni tajmer. */
     uint8_t         pulse_relay_index;
 };
@@ -59,9 +63,10 @@ struct Gate_s
 
 /**
  * @brief Glavni niz koji u RAM-u čuva kompletnu konfiguraciju i runtime stanje za sve kapije.
- * @note  Ovaj niz je statičan i vidljiv samo unutar ovog fajla.
+ * @note  Ovaj niz je statičan i vidljiv samo unutar ovog fajla. Niz je u
+ * SDRAM-u (`.sdram_ram`, `UNINIT`), pa ga `Gate_Init` prvo briše.
  */
-static struct Gate_s gates[GATE_MAX_COUNT];
+static struct Gate_s gates[GATE_MAX_COUNT] __attribute__((section(".sdram_ram")));
 
 /**
  ******************************************************************************
@@ -162,12 +167,17 @@ static const ProfilDeskriptor_t g_ControlProfileLibrary[] = {
 static void Gate_SendAction(Gate_Handle* handle, UI_Command_e command);
 static void Gate_SendRawCommand(Gate_Handle* handle, uint8_t relay_index, bool is_pulse);
 static void Gate_StopAllRelays(Gate_Handle* const handle);
-static Gate_Handle* Gate_FindByFeedbackSensor(uint16_t sensor_addr);
+static void Gate_SensorEvent(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len);
+static void Gate_Subscribe(void);
 static void Gate_SetDefault(Gate_Handle* const handle);
 static void Gate_Init_Single(uint8_t index);
 static void Gate_Save_Single(uint8_t index);
 static uint16_t Gate_GetRelayAddressByIndex(const Gate_Handle* handle, uint8_t index);
 static void HandleSensorEvent(Gate_Handle* handle, uint16_t sensor_addr, uint8_t state);
+static void Gate_StartTimer(Gate_Handle* handle, GateTimerType_e type);
+static void Gate_StopTimer(Gate_Handle* handle);
+static void Gate_ArmTimer(Gate_Handle* handle);
+static void Gate_TimerExpired(void* arg);
 
 /*============================================================================*/
 /* IMPLEMENTACIJA JAVNOG API-JA                                               */
@@ -187,10 +197,12 @@ static void HandleSensorEvent(Gate_Handle* handle, uint16_t sensor_addr, uint8_t
  */
 void Gate_Init(void)
 {
+    memset(gates, 0, sizeof(gates));
     for (uint8_t i = 0; i < GATE_MAX_COUNT; i++)
     {
         Gate_Init_Single(i);
     }
+    DevReg_Register(Gate_Subscribe);
 }
 
 /**
@@ -212,107 +224,6 @@ void Gate_Save(void)
     }
 }
 
-/**
- ******************************************************************************
- * @brief       Glavna servisna petlja za modul kapija (Univerzalna State Mašina).
- * @author      Gemini & [Vaše Ime]
- * @note        Poziva se periodično iz `main()`. Prolazi kroz sve
- * konfigurisane uređaje i upravlja njihovim stanjem na osnovu
- * aktivnih tajmera. Odgovorna je za gašenje pulsnih releja,
- * detekciju timeout-a ciklusa i upravljanje pješačkim modom.
- * @param       None
- * @retval      None
- ******************************************************************************
- */
-void Gate_Service(void)
-{
-    for (uint8_t i = 0; i < GATE_MAX_COUNT; i++)
-    {
-        Gate_Handle* handle = &gates[i];
-        if (handle->config.control_type == CONTROL_TYPE_NONE || handle->active_timer_type == GATE_TIMER_NONE) {
-            continue;
-        }
-        uint32_t now = HAL_GetTick();
-        uint32_t elapsed_ms = now - handle->timer_start_tick;
-        switch (handle->active_timer_type)
-        {
-            case GATE_TIMER_PULSE:
-            {
-                uint16_t pulse_duration_ms = handle->config.pulse_timer_ms;
-                if (pulse_duration_ms == 0) pulse_duration_ms = 500;
-
-                if (elapsed_ms >= pulse_duration_ms) {
-                    // 1. UVIJEK ugasi relej nakon pulsa
-                    uint16_t relay_addr = Gate_GetRelayAddressByIndex(handle, handle->pulse_relay_index);
-                    uint8_t buff[3] = { (relay_addr >> 8) & 0xFF, relay_addr & 0xFF, BINARY_OFF };
-                    AddCommand(&binaryQueue, BINARY_SET, buff, 3);
-                    handle->pulse_relay_index = 0;
-
-                    // 2. KONAČNA LOGIKA ZA BRAVU: VRAĆANJE NA ZATVORENO NAKON PULSA
-                    //    Ovaj blok ima najviši prioritet, rešavajući vizuelni povratak.
-                    if (handle->config.control_type == CONTROL_TYPE_SIMPLE_LOCK)
-                    {
-                        handle->current_state = GATE_STATE_CLOSED;
-                        handle->active_timer_type = GATE_TIMER_NONE;
-                        handle->timer_start_tick = 0;
-                        shouldDrawScreen = 1;
-                    }
-                    // 3. LOGIKA ZA RAMPU/KAPIJE (nastavi sa CYCLE tajmerom)
-                    else if (handle->current_state == GATE_STATE_OPENING || handle->current_state == GATE_STATE_CLOSING) 
-                    {
-                        handle->active_timer_type = GATE_TIMER_CYCLE; 
-                    }
-                    // 4. ZA SVE OSTALE SLUČAJEVE, ugasi tajmer
-                    else
-                    {
-                        handle->active_timer_type = GATE_TIMER_NONE;
-                        handle->timer_start_tick = 0;
-                    }
-                }
-                break;
-            }
-            case GATE_TIMER_PEDESTRIAN:
-            {
-                uint32_t ped_duration_ms = (uint32_t)handle->config.pedestrian_timer_s * 1000UL;
-                if (elapsed_ms >= ped_duration_ms) {
-                    Gate_TriggerStop(handle);
-                }
-                break;
-            }
-            case GATE_TIMER_CYCLE:
-            {
-                uint32_t cycle_duration_ms = (uint32_t)handle->config.cycle_timer_s * 1000UL;
-                if (cycle_duration_ms > 0 && elapsed_ms >= cycle_duration_ms) {
-                    
-                    // NOVA LOGIKA: Provjera timeout-a za bravu sa senzorom
-                    if (handle->current_state == GATE_STATE_OPEN && handle->config.control_type == CONTROL_TYPE_SIMPLE_LOCK) {
-                        // Vrijeme je isteklo, a senzor nije javio da je zatvoreno. Proglasi grešku.
-                        handle->current_state = GATE_STATE_FAULT;
-                        handle->active_timer_type = GATE_TIMER_NONE;
-                        handle->timer_start_tick = 0;
-                        shouldDrawScreen = 1; 
-                        break;
-                    }
-
-                    // Postojeća logika za kapije u pokretu
-                    if (handle->current_state == GATE_STATE_OPENING) {
-                        handle->current_state = GATE_STATE_OPEN;
-                    } else if (handle->current_state == GATE_STATE_CLOSING) {
-                        handle->current_state = GATE_STATE_CLOSED;
-                    }
-                    
-                    handle->active_timer_type = GATE_TIMER_NONE;
-                    handle->timer_start_tick = 0;
-                    shouldDrawScreen = 1;
-                }
-                break;
-            }
-            case GATE_TIMER_NONE:
-            default:
-                break;
-        }
-    }
-}
 /**
  ******************************************************************************
  * @brief       Vraća "handle" (pokazivač) na instancu uređaja.
@@ -416,31 +327,6 @@ void Gate_TriggerUnlock(Gate_Handle* handle)
     Gate_SendAction(handle, UI_COMMAND_UNLOCK);
 }
 
-/**
- ******************************************************************************
- * @brief       [NOVA IMPLEMENTACIJA] Procesira događaj sa magistrale.
- * @author      Gemini
- * @note        Ova funkcija je srce novog mehanizma. Njen jedini zadatak je da
- * utvrdi da li je pristigli događaj relevantan za ovaj modul. Ako jeste,
- * prosljeđuje ga internom handleru na obradu.
- ******************************************************************************
- */
-void GATE_BusEvent(uint16_t address, uint8_t command, uint8_t* data, uint8_t len)
-{
-    // Pronađi da li bilo koja kapija koristi ovu adresu kao senzor
-    Gate_Handle* handle = Gate_FindByFeedbackSensor(address);
-
-    if (handle != NULL)
-    {
-        // Jeste, ova adresa je relevantna.
-        // Pretpostavljamo da je stanje (ON/OFF) u prvom bajtu payload-a.
-        uint8_t state = (len > 0) ? data[0] : 0;
-        
-        // Proslijedi događaj na dalju obradu unutar modula
-        HandleSensorEvent(handle, address, state);
-    }
-    // Ako handle == NULL, događaj se ignoriše i funkcija se odmah završava.
-}
 /*============================================================================*/
 /* IMPLEMENTACIJA GETTERA I SETTERA                                           */
 /*============================================================================*/
@@ -580,6 +466,7 @@ uint16_t Gate_GetPulseTimer(const Gate_Handle* handle)
 void Gate_SetControlType(Gate_Handle* handle, GateControlType_e type) 
 { 
     if (handle) handle->config.control_type = type; 
+    DevReg_Rebuild();
 }
 void Gate_SetAppearanceId(Gate_Handle* handle, uint8_t id) 
 { 
@@ -605,6 +492,7 @@ void Gate_SetFeedbackAddr(Gate_Handle* handle, uint8_t sensor_index, uint16_t ad
         case 2: handle->config.feedback_input2.tf = addr; break;
         case 3: handle->config.feedback_input3.tf = addr; break;
     }
+    DevReg_Rebuild();
 }
 
 void Gate_SetCycleTimer(Gate_Handle* handle, uint8_t seconds) 
@@ -657,8 +545,7 @@ static void Gate_SendAction(Gate_Handle* handle, UI_Command_e command)
          Gate_StopAllRelays(handle);
     }
     
-    handle->active_timer_type = GATE_TIMER_NONE;
-    handle->timer_start_tick = 0;
+    Gate_StopTimer(handle);
 
      // ====================================================================
     // === KLJUČNA ISPRAVKA: Logika Brave je prva i nezavisna (BINARNA) ===
@@ -669,8 +556,7 @@ static void Gate_SendAction(Gate_Handle* handle, UI_Command_e command)
        
             // STANJE BRAVE: Otključano (samo dok traje puls)
             handle->current_state = GATE_STATE_OPEN;
-            handle->active_timer_type = GATE_TIMER_PULSE; // Koristi samo puls tajmer
-            handle->timer_start_tick = HAL_GetTick() ? HAL_GetTick() : 1;
+            Gate_StartTimer(handle, GATE_TIMER_PULSE); // Koristi samo puls tajmer
             shouldDrawScreen = 1;
 
             Gate_SendRawCommand(handle, akcija->target_relay_index, akcija->is_pulse);
@@ -690,15 +576,13 @@ static void Gate_SendAction(Gate_Handle* handle, UI_Command_e command)
         case UI_COMMAND_PEDESTRIAN:
             Gate_SetState(handle, GATE_STATE_OPENING);
             // ISPRAVKA: Pokretanje tajmera koji je nedostajao
-            handle->active_timer_type = GATE_TIMER_CYCLE;
-            handle->timer_start_tick = HAL_GetTick() ? HAL_GetTick() : 1;
+            Gate_StartTimer(handle, GATE_TIMER_CYCLE);
             break;
 
         case UI_COMMAND_CLOSE_CYCLE:
             Gate_SetState(handle, GATE_STATE_CLOSING);
             // ISPRAVKA: Pokretanje tajmera koji je nedostajao
-            handle->active_timer_type = GATE_TIMER_CYCLE;
-            handle->timer_start_tick = HAL_GetTick() ? HAL_GetTick() : 1;
+            Gate_StartTimer(handle, GATE_TIMER_CYCLE);
             break;
 
         case UI_COMMAND_SMART_STEP:
@@ -716,8 +600,7 @@ static void Gate_SendAction(Gate_Handle* handle, UI_Command_e command)
                 handle->current_state = GATE_STATE_PARTIALLY_OPEN;
             }
             // Za sve slučajeve S-S komande, pokreni tajmer ciklusa
-            handle->active_timer_type = GATE_TIMER_CYCLE;
-            handle->timer_start_tick = HAL_GetTick() ? HAL_GetTick() : 1;
+            Gate_StartTimer(handle, GATE_TIMER_CYCLE);
             break;
             
         case UI_COMMAND_STOP:
@@ -763,8 +646,7 @@ static void Gate_SendRawCommand(Gate_Handle* handle, uint8_t relay_index, bool i
     AddCommand(&binaryQueue, BINARY_SET, buff, 3);
     
     if (is_pulse) {
-        handle->active_timer_type = GATE_TIMER_PULSE;
-        handle->timer_start_tick = HAL_GetTick() ? HAL_GetTick() : 1;
+        Gate_StartTimer(handle, GATE_TIMER_PULSE);
         handle->pulse_relay_index = relay_index;
     }
 }
@@ -818,8 +700,8 @@ static uint16_t Gate_GetRelayAddressByIndex(const Gate_Handle* handle, uint8_t i
  * @brief       [POSTOJEĆA FUNKCIJA, SADA INTERNA] Obrađuje promjenu stanja senzora.
  * @author      Gemini & [Vaše Ime]
  * @note        Ova funkcija sadrži logiku za ažuriranje mašine stanja.
- * Poziva je `GATE_BusEvent` nakon što je potvrđeno da je događaj
- * relevantan za datu instancu (`handle`).
+ * Poziva je `Gate_SensorEvent` kada registar uređaja proslijedi
+ * `DIN_EVENT` sa adrese senzora ove instance (`handle`).
  ******************************************************************************
  */
 static void HandleSensorEvent(Gate_Handle* handle, uint16_t sensor_addr, uint8_t state)
@@ -833,8 +715,7 @@ static void HandleSensorEvent(Gate_Handle* handle, uint16_t sensor_addr, uint8_t
     {
         handle->current_state = GATE_STATE_OPEN;
         // Ako je kapija stigla na kraj, zaustavi sve tajmere i motore.
-        handle->active_timer_type = GATE_TIMER_NONE;
-        handle->timer_start_tick = 0;
+        Gate_StopTimer(handle);
         Gate_StopAllRelays(handle);
     }
     // Provjeravamo da li je aktiviran senzor za ZATVORENO.
@@ -842,8 +723,7 @@ static void HandleSensorEvent(Gate_Handle* handle, uint16_t sensor_addr, uint8_t
     {
         handle->current_state = GATE_STATE_CLOSED;
         // Ako je kapija stigla na kraj, zaustavi sve tajmere i motore.
-        handle->active_timer_type = GATE_TIMER_NONE;
-        handle->timer_start_tick = 0;
+        Gate_StopTimer(handle);
         Gate_StopAllRelays(handle);
     }
     
@@ -853,27 +733,35 @@ static void HandleSensorEvent(Gate_Handle* handle, uint16_t sensor_addr, uint8_t
 
 /**
  ******************************************************************************
- * @brief       Pronađi uređaj na osnovu adrese njegovog feedback senzora.
- * @param       sensor_addr Adresa aktiviranog senzora.
- * @retval      Gate_Handle* Pokazivač na pronađeni uređaj, ili NULL.
+ * @brief       Prima `DIN_EVENT` feedback senzora kapije.
+ * @note        `DevReg_Handler_t`; registar uređaja poziva samo kapije čiji je
+ * senzor na adresi iz okvira. `data[0]` je stanje ulaza (ON/OFF).
+ * @param       index Indeks kapije.
+ * @param       address Adresa aktiviranog senzora.
+ ******************************************************************************
+ */
+static void Gate_SensorEvent(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len)
+{
+    if (index >= GATE_MAX_COUNT) return;
+    HandleSensorEvent(&gates[index], address, (len > 0) ? data[0] : 0);
+}
+
+/**
+ ******************************************************************************
+ * @brief       Prijavljuje feedback senzore aktivnih uređaja u registar.
+ * @note        `DevReg_Builder_t`. Uređaji sa `CONTROL_TYPE_NONE` se
+ * preskaču, kao i u ranijoj linearnoj pretrazi.
  ******************************************************************************
  */
-static Gate_Handle* Gate_FindByFeedbackSensor(uint16_t sensor_addr)
+static void Gate_Subscribe(void)
 {
-    if (sensor_addr == 0) return NULL;
     for (uint8_t i = 0; i < GATE_MAX_COUNT; i++)
     {
-        if (gates[i].config.control_type != CONTROL_TYPE_NONE)
-        {
-            if (gates[i].config.feedback_input1.tf == sensor_addr ||
-                gates[i].config.feedback_input2.tf == sensor_addr ||
-                gates[i].config.feedback_input3.tf == sensor_addr)
-            {
-                return &gates[i];
-            }
-        }
+        if (gates[i].config.control_type == CONTROL_TYPE_NONE) continue;
+        DevReg_Subscribe(DIN_EVENT, gates[i].config.feedback_input1.tf, Gate_SensorEvent, i);
+        DevReg_Subscribe(DIN_EVENT, gates[i].config.feedback_input2.tf, Gate_SensorEvent, i);
+        DevReg_Subscribe(DIN_EVENT, gates[i].config.feedback_input3.tf, Gate_SensorEvent, i);
     }
-    return NULL;
 }
 
 /**
@@ -915,8 +803,7 @@ static void Gate_Init_Single(uint8_t index)
     
     // Inicijalizacija runtime varijabli
     handle->current_state = GATE_STATE_UNDEFINED;
-    handle->timer_start_tick = 0;
-    handle->active_timer_type = GATE_TIMER_NONE;
+    Gate_StopTimer(handle);
     handle->pulse_relay_index = 0;
 }
 
@@ -957,3 +844,158 @@ static void Gate_SetDefault(Gate_Handle* const handle)
     memset(&handle->config, 0, sizeof(Gate_EepromConfig_t));
     handle->config.control_type = CONTROL_TYPE_NONE;
 }
+
+/**
+ ******************************************************************************
+ * @brief       Pokreće tajmer datog tipa od trenutnog vremena.
+ * @author      Gemini & [Vaše Ime]
+ * @param       handle Pokazivač na instancu uređaja.
+ * @param       type Tip tajmera (`GATE_TIMER_NONE` zaustavlja tajmer).
+ ******************************************************************************
+ */
+static void Gate_StartTimer(Gate_Handle* handle, GateTimerType_e type)
+{
+    if (type == GATE_TIMER_NONE) {
+        Gate_StopTimer(handle);
+        return;
+    }
+    handle->active_timer_type = type;
+    handle->timer_start_tick = HAL_GetTick() ? HAL_GetTick() : 1;
+    Gate_ArmTimer(handle);
+}
+
+/**
+ ******************************************************************************
+ * @brief       Zaustavlja aktivni tajmer uređaja.
+ * @author      Gemini & [Vaše Ime]
+ * @param       handle Pokazivač na instancu uređaja.
+ ******************************************************************************
+ */
+static void Gate_StopTimer(Gate_Handle* handle)
+{
+    handle->active_timer_type = GATE_TIMER_NONE;
+    handle->timer_start_tick = 0;
+    TimerWheel_Stop(&handle->timer);
+}
+
+/**
+ ******************************************************************************
+ * @brief       Postavlja istek tajmera u točku prema `active_timer_type`.
+ * @author      Gemini & [Vaše Ime]
+ * @note        Rok se računa od `timer_start_tick`, pa prelazak iz pulsnog
+ * u tajmer ciklusa zadržava početak pulsa, kao i ranije. Tajmer
+ * ciklusa sa trajanjem 0 ostaje aktivan, ali nikad ne ističe.
+ * @param       handle Pokazivač na instancu uređaja.
+ ******************************************************************************
+ */
+static void Gate_ArmTimer(Gate_Handle* handle)
+{
+    uint32_t duration_ms = 0;
+    uint32_t elapsed_ms;
+
+    switch (handle->active_timer_type)
+    {
+        case GATE_TIMER_PULSE:
+            duration_ms = handle->config.pulse_timer_ms;
+            if (duration_ms == 0) duration_ms = 500;
+            break;
+        case GATE_TIMER_PEDESTRIAN:
+            duration_ms = (uint32_t)handle->config.pedestrian_timer_s * 1000UL;
+            break;
+        case GATE_TIMER_CYCLE:
+            duration_ms = (uint32_t)handle->config.cycle_timer_s * 1000UL;
+            break;
+        case GATE_TIMER_NONE:
+        default:
+            break;
+    }
+
+    if (duration_ms == 0) {
+        TimerWheel_Stop(&handle->timer);
+        return;
+    }
+    elapsed_ms = HAL_GetTick() - handle->timer_start_tick;
+    TimerWheel_Start(&handle->timer, (elapsed_ms >= duration_ms) ? 0 : (duration_ms - elapsed_ms), Gate_TimerExpired, handle);
+}
+
+/**
+ ******************************************************************************
+ * @brief       Istek tajmera jednog uređaja (Univerzalna State Mašina).
+ * @author      Gemini & [Vaše Ime]
+ * @note        Poziva ga `TimerWheel_Service()`. Odgovorna je za gašenje
+ * pulsnih releja, detekciju timeout-a ciklusa i upravljanje
+ * pješačkim modom.
+ * @param       arg Pokazivač na instancu uređaja.
+ ******************************************************************************
+ */
+static void Gate_TimerExpired(void* arg)
+{
+    Gate_Handle* handle = (Gate_Handle*)arg;
+
+    if (handle->config.control_type == CONTROL_TYPE_NONE) {
+        Gate_StopTimer(handle);
+        return;
+    }
+    switch (handle->active_timer_type)
+    {
+        case GATE_TIMER_PULSE:
+        {
+            // 1. UVIJEK ugasi relej nakon pulsa
+            uint16_t relay_addr = Gate_GetRelayAddressByIndex(handle, handle->pulse_relay_index);
+            uint8_t buff[3] = { (relay_addr >> 8) & 0xFF, relay_addr & 0xFF, BINARY_OFF };
+            AddCommand(&binaryQueue, BINARY_SET, buff, 3);
+            handle->pulse_relay_index = 0;
+
+            // 2. KONAČNA LOGIKA ZA BRAVU: VRAĆANJE NA ZATVORENO NAKON PULSA
+            //    Ovaj blok ima najviši prioritet, rešavajući vizuelni povratak.
+            if (handle->config.control_type == CONTROL_TYPE_SIMPLE_LOCK)
+            {
+                handle->current_state = GATE_STATE_CLOSED;
+                Gate_StopTimer(handle);
+                shouldDrawScreen = 1;
+            }
+            // 3. LOGIKA ZA RAMPU/KAPIJE (nastavi sa CYCLE tajmerom od početka pulsa)
+            else if (handle->current_state == GATE_STATE_OPENING || handle->current_state == GATE_STATE_CLOSING)
+            {
+                handle->active_timer_type = GATE_TIMER_CYCLE;
+                Gate_ArmTimer(handle);
+            }
+            // 4. ZA SVE OSTALE SLUČAJEVE, ugasi tajmer
+            else
+            {
+                Gate_StopTimer(handle);
+            }
+            break;
+        }
+        case GATE_TIMER_PEDESTRIAN:
+        {
+            Gate_TriggerStop(handle);
+            break;
+        }
+        case GATE_TIMER_CYCLE:
+        {
+            // NOVA LOGIKA: Provjera timeout-a za bravu sa senzorom
+            if (handle->current_state == GATE_STATE_OPEN && handle->config.control_type == CONTROL_TYPE_SIMPLE_LOCK) {
+                // Vrijeme je isteklo, a senzor nije javio da je zatvoreno. Proglasi grešku.
+                handle->current_state = GATE_STATE_FAULT;
+                Gate_StopTimer(handle);
+                shouldDrawScreen = 1;
+                break;
+            }
+
+            // Postojeća logika za kapije u pokretu
+            if (handle->current_state == GATE_STATE_OPENING) {
+                handle->current_state = GATE_STATE_OPEN;
+            } else if (handle->current_state == GATE_STATE_CLOSING) {
+                handle->current_state = GATE_STATE_CLOSED;
+            }
+
+            Gate_StopTimer(handle);
+            shouldDrawScreen = 1;
+            break;
+        }
+        case GATE_TIMER_NONE:
+        default:
+            break;
+    }
+}
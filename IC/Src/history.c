@@ -0,0 +1,500 @@
+/**
+ ******************************************************************************
+ * @file    history.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija istorije mjerenja (kružni nizovi delta blokova).
+ *
+ * @note    `History_Service` jednom u sekundi sabira trenutne vrijednosti,
+ * a svakih `HIST_TIER0_PERIOD_S` upisuje srednju vrijednost (temperatura,
+ * zadata temperatura, ventilator) ili broj sekundi uključenosti (svjetla).
+ * Razlika od prethodnog uzorka se kodira zigzag pa varint (7 bita po
+ * bajtu), tako da nepromijenjena vrijednost zauzima jedan bajt. Uzorak
+ * koji ne slijedi prethodni za tačno jedan period (npr. nakon zastoja
+ * petlje) počinje novi blok, pa je vrijeme svakog uzorka `start + i * period`.
+ *
+ * `DIAG_GET` listener čita blokove iz prekida dok ih glavna petlja puni.
+ * Upis zato prvo piše bajtove podataka, pa `used`, pa `count`, a
+ * serijalizacija prvo čita `count`: host dekodira `count` uzoraka i nikad
+ * ne čita bajtove koji još nisu upisani. Jedino blok koji se upravo
+ * ponovo počinje može stići nepotpun.
+ ******************************************************************************
+ */
+
+#if (__HISTORY_H__ != FW_BUILD)
+#error "history header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "history.h"
+#include "thermostat.h"
+#include "lights.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define HIST_CATCHUP_MAX                30U     ///< Najviše propuštenih sekundi koje servis nadoknađuje
+#define HIST_HEADER_SIZE                4U      ///< subcmd, stranica, ukupno stranica, broj zapisa
+#define HIST_STATUS_CHANNELS            16U     ///< Kanala po stranici `DIAG_HIST_STATUS`
+#define HIST_STATUS_PAGES               ((HIST_CHANNELS + HIST_STATUS_CHANNELS - 1U) / HIST_STATUS_CHANNELS)
+#define HIST_STATUS_RECORD_SIZE         (11U + (2U * HIST_TIERS) + (HIST_STATUS_CHANNELS * HIST_TIERS))
+#define HIST_BLOCK_RECORD_SIZE          (2U + HIST_BLOCK_SIZE)
+
+#if (HIST_BLOCKS > 255U) || (HIST_BLOCK_DATA > 255U)
+#error "HIST_BLOCKS i HIST_BLOCK_DATA moraju stati u jedan bajt"
+#endif
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+/**
+ * @brief Blok uzoraka; isti raspored se šalje preko `DIAG_HIST_READ`.
+ */
+typedef struct
+{
+    uint32_t start;             /**< Vrijeme prvog uzorka, s od uključenja. */
+    int16_t  base;              /**< Vrijednost prvog uzorka. */
+    volatile uint8_t count;     /**< Uzoraka u bloku, 0 = prazan blok. */
+    volatile uint8_t used;      /**< Bajtova u `data`. */
+    uint8_t  data[HIST_BLOCK_DATA];
+} History_Block_t;
+
+/**
+ * @brief Jedan nivo jednog kanala.
+ */
+typedef struct
+{
+    History_Block_t block[HIST_BLOCKS];
+    int16_t last;               /**< Posljednja upisana vrijednost. */
+    uint8_t head;               /**< Blok koji se puni. */
+    uint8_t filled;             /**< Blokova u upotrebi. */
+} History_Ring_t;
+
+/**
+ * @brief Grupa uzoraka jednog nivoa koja postaje uzorak sljedećeg.
+ */
+typedef struct
+{
+    int32_t  sum;
+    uint32_t start;
+    uint8_t  n;
+} History_Acc_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static History_Ring_t hist_ring[HIST_CHANNELS][HIST_TIERS] __attribute__((section(".sdram_ram")));
+static History_Acc_t hist_acc[HIST_CHANNELS][HIST_TIERS - 1U];
+static int32_t hist_second_sum[HIST_CHANNELS];  ///< Zbir sekundnih očitanja tekućeg perioda nivoa 0
+static uint8_t hist_second_n;
+static uint32_t hist_next_s;                    ///< Sljedeća sekunda koju servis očitava
+
+static const uint16_t hist_period[HIST_TIERS] = { HIST_TIER0_PERIOD_S, HIST_TIER1_PERIOD_S, HIST_TIER2_PERIOD_S };
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+static bool History_IsSum(uint8_t channel)
+{
+    return (channel >= HIST_CH_LIGHT);
+}
+
+static uint8_t History_Oldest(const History_Ring_t* r)
+{
+    return (uint8_t)((r->head + 1U + HIST_BLOCKS - r->filled) % HIST_BLOCKS);
+}
+
+/**
+ * @brief Vrijednost grupe od `n` uzoraka: zbir za svjetla, inače zaokružena srednja vrijednost.
+ */
+static int16_t History_Reduce(uint8_t channel, int32_t sum, uint8_t n)
+{
+    int32_t v = sum;
+
+    if (!History_IsSum(channel)) v = (sum + ((sum < 0) ? -(int32_t)(n / 2U) : (int32_t)(n / 2U))) / (int32_t)n;
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return (int16_t)v;
+}
+
+/**
+ * @brief Upisuje uzorak u jedan nivo; O(1).
+ */
+static void History_Append(History_Ring_t* r, uint8_t tier, int16_t value, uint32_t time_s)
+{
+    History_Block_t* b = &r->block[r->head];
+    uint8_t n = b->count;
+
+    if ((n != 0U) && (n < UINT8_MAX) && (time_s == (b->start + ((uint32_t)n * hist_period[tier]))))
+    {
+        int32_t delta = (int32_t)value - r->last;
+        uint32_t zz = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+        uint8_t enc[3];
+        uint8_t len = 0U;
+
+        do
+        {
+            enc[len] = (uint8_t)(zz & 0x7FU);
+            zz >>= 7;
+            if (zz != 0U) enc[len] |= 0x80U;
+            len++;
+        } while (zz != 0U);
+
+        if ((b->used + len) <= HIST_BLOCK_DATA)
+        {
+            memcpy(&b->data[b->used], enc, len);
+            b->used = (uint8_t)(b->used + len);
+            b->count = (uint8_t)(n + 1U);
+            r->last = value;
+            return;
+        }
+    }
+
+    // Novi blok: sljedeći u nizu, preko najstarijeg kada je niz pun
+    if (n != 0U)
+    {
+        r->head = (uint8_t)((r->head + 1U) % HIST_BLOCKS);
+        b = &r->block[r->head];
+    }
+    if (r->filled < HIST_BLOCKS) r->filled++;
+    b->count = 0U;
+    b->start = time_s;
+    b->base = value;
+    b->used = 0U;
+    b->count = 1U;
+    r->last = value;
+}
+
+/**
+ * @brief Čita jednu varint razliku iz bloka.
+ */
+static int32_t History_Decode(const History_Block_t* b, uint8_t* pos)
+{
+    uint32_t zz = 0U;
+    uint8_t shift = 0U;
+    uint8_t c;
+
+    do
+    {
+        c = b->data[(*pos)++];
+        zz |= (uint32_t)(c & 0x7FU) << shift;
+        shift = (uint8_t)(shift + 7U);
+    } while ((c & 0x80U) && (*pos < HIST_BLOCK_DATA));
+
+    return (int32_t)(zz >> 1) ^ -(int32_t)(zz & 1U);
+}
+
+/**
+ * @brief Najfiniji nivo koji pokriva `from_s`; inače onaj sa najstarijim uzorkom.
+ * @retval int8_t Nivo ili -1 ako kanal nema uzoraka.
+ */
+static int8_t History_SelectTier(uint8_t channel, uint32_t from_s)
+{
+    int8_t best = -1;
+    uint32_t best_start = 0U;
+
+    for (uint8_t t = 0U; t < HIST_TIERS; t++)
+    {
+        const History_Ring_t* r = &hist_ring[channel][t];
+        if (r->filled == 0U) continue;
+
+        uint32_t start = r->block[History_Oldest(r)].start;
+        if ((best < 0) || ((best_start > from_s) && (start < best_start)))
+        {
+            best = (int8_t)t;
+            best_start = start;
+        }
+    }
+    return best;
+}
+
+static uint8_t* History_Put16(uint8_t* p, uint32_t value)
+{
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = (uint8_t)(value & 0xFFU);
+    return p;
+}
+
+static uint8_t* History_Put32(uint8_t* p, uint32_t value)
+{
+    *p++ = (uint8_t)(value >> 24);
+    *p++ = (uint8_t)(value >> 16);
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = (uint8_t)(value & 0xFFU);
+    return p;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Briše sve nivoe i počinje sakupljanje od trenutne sekunde.
+ * @note  Poziva se iz `main()` nakon `SDRAM_Init`.
+ */
+void History_Init(void)
+{
+    memset(hist_ring, 0, sizeof(hist_ring));
+    memset(hist_acc, 0, sizeof(hist_acc));
+    memset(hist_second_sum, 0, sizeof(hist_second_sum));
+    hist_second_n = 0U;
+    hist_next_s = History_Now();
+}
+
+/**
+ * @brief Jednom u sekundi očitava termostat i svjetla; svakih
+ * `HIST_TIER0_PERIOD_S` upisuje uzorak svakog kanala.
+ * @note  Zadatak planera sa periodom `TASK_CLOCK_PERIOD`. Propuštene
+ * sekunde (do `HIST_CATCHUP_MAX`) se nadoknađuju trenutnim vrijednostima;
+ * duži zastoj odbacuje započeti period.
+ */
+void History_Service(void)
+{
+    uint32_t now = History_Now();
+    THERMOSTAT_TypeDef* pThst = Thermostat_GetInstance();
+    uint8_t steps = 0U;
+
+    if ((int32_t)(now - hist_next_s) > (int32_t)HIST_CATCHUP_MAX)
+    {
+        memset(hist_second_sum, 0, sizeof(hist_second_sum));
+        hist_second_n = 0U;
+        hist_next_s = now;
+    }
+
+    while (((int32_t)(now - hist_next_s) >= 0) && (steps < HIST_CATCHUP_MAX))
+    {
+        hist_second_sum[HIST_CH_TEMP] += Thermostat_GetMeasuredTemp(pThst);
+        hist_second_sum[HIST_CH_SETPOINT] += (int32_t)Thermostat_GetSetpoint(pThst) * 10;
+        hist_second_sum[HIST_CH_FAN] += (int32_t)Thermostat_GetFanSpeed(pThst) * 10;
+        for (uint8_t i = 0U; i < LIGHTS_MODBUS_SIZE; i++)
+        {
+            const LIGHT_Handle* light = LIGHTS_GetInstance(i);
+            if ((light != NULL) && LIGHT_isActive(light)) hist_second_sum[HIST_CH_LIGHT + i]++;
+        }
+        hist_next_s++;
+        steps++;
+
+        if (++hist_second_n >= HIST_TIER0_PERIOD_S)
+        {
+            uint32_t start = hist_next_s - HIST_TIER0_PERIOD_S;
+            for (uint8_t ch = 0U; ch < HIST_CHANNELS; ch++)
+            {
+                History_Push(ch, History_Reduce(ch, hist_second_sum[ch], HIST_TIER0_PERIOD_S), start);
+            }
+            memset(hist_second_sum, 0, sizeof(hist_second_sum));
+            hist_second_n = 0U;
+        }
+    }
+}
+
+/**
+ * @brief Upisuje uzorak nivoa 0 i prosljeđuje pune grupe višim nivoima.
+ * @param channel `History_Channel_e`.
+ * @param value   Vrijednost u jedinici kanala.
+ * @param time_s  Vrijeme uzorka (s); uzastopni uzorci se razlikuju za `HIST_TIER0_PERIOD_S`.
+ */
+void History_Push(uint8_t channel, int16_t value, uint32_t time_s)
+{
+    if (channel >= HIST_CHANNELS) return;
+
+    History_Append(&hist_ring[channel][0], 0U, value, time_s);
+
+    for (uint8_t t = 0U; t < (HIST_TIERS - 1U); t++)
+    {
+        History_Acc_t* acc = &hist_acc[channel][t];
+        uint8_t group = (uint8_t)(hist_period[t + 1U] / hist_period[t]);
+
+        // Grupa sa prazninom se ne sažima, počinje nova od ovog uzorka
+        if ((acc->n != 0U) && (time_s != (acc->start + ((uint32_t)acc->n * hist_period[t]))))
+        {
+            acc->n = 0U;
+        }
+        if (acc->n == 0U)
+        {
+            acc->sum = 0;
+            acc->start = time_s;
+        }
+        acc->sum += value;
+        if (++acc->n < group) return;
+
+        value = History_Reduce(channel, acc->sum, group);
+        time_s = acc->start;
+        acc->n = 0U;
+        History_Append(&hist_ring[channel][t + 1U], (uint8_t)(t + 1U), value, time_s);
+    }
+}
+
+/**
+ * @brief Trenutno vrijeme istorije, u sekundama od uključenja.
+ */
+uint32_t History_Now(void)
+{
+    return HAL_GetTick() / 1000U;
+}
+
+/**
+ * @brief Sažima interval [from_s, to_s) jednog kanala u `count` kolona.
+ * @note  Dekodira samo blokove koji se preklapaju sa intervalom, jednim
+ * prolazom; za 24 h iz nivoa 1 to je 1440 uzoraka.
+ * @param channel `History_Channel_e`.
+ * @param from_s  Početak intervala (s od uključenja).
+ * @param to_s    Kraj intervala, isključivo.
+ * @param columns Niz od `count` kolona; kolona bez uzoraka ima `count` 0.
+ * @param count   Broj kolona (širina grafika u pikselima).
+ * @param summary Sažetak cijelog intervala, može biti NULL.
+ * @retval uint16_t Broj kolona sa uzorcima.
+ */
+uint16_t History_Query(uint8_t channel, uint32_t from_s, uint32_t to_s,
+                       History_Column_t* columns, uint16_t count, History_Summary_t* summary)
+{
+    History_Summary_t s = { 0U, 0U, INT16_MAX, INT16_MIN, 0, 0U };
+    uint16_t filled = 0U;
+
+    for (uint16_t c = 0U; c < count; c++)
+    {
+        columns[c].min = INT16_MAX;
+        columns[c].max = INT16_MIN;
+        columns[c].sum = 0;
+        columns[c].count = 0U;
+    }
+
+    int8_t tier = ((channel < HIST_CHANNELS) && (to_s > from_s) && (count != 0U)) ? History_SelectTier(channel, from_s) : -1;
+    if (tier >= 0)
+    {
+        const History_Ring_t* r = &hist_ring[channel][tier];
+        uint32_t period = hist_period[tier];
+        uint32_t span = to_s - from_s;
+        uint8_t idx = History_Oldest(r);
+
+        s.tier = (uint8_t)tier;
+        s.period_s = (uint16_t)period;
+        for (uint8_t k = 0U; k < r->filled; k++, idx = (uint8_t)((idx + 1U) % HIST_BLOCKS))
+        {
+            const History_Block_t* b = &r->block[idx];
+            uint8_t n = b->count;
+            if (n == 0U) continue;
+            if (b->start >= to_s) break;
+            if ((b->start + ((uint32_t)(n - 1U) * period)) < from_s) continue;
+
+            int32_t v = b->base;
+            uint32_t t = b->start;
+            uint8_t pos = 0U;
+            for (uint8_t i = 0U; i < n; i++, t += period)
+            {
+                if (i != 0U) v += History_Decode(b, &pos);
+                if (t < from_s) continue;
+                if (t >= to_s) break;
+
+                History_Column_t* col = &columns[(uint32_t)(((uint64_t)(t - from_s) * count) / span)];
+                if (col->count == 0U) filled++;
+                if (v < col->min) col->min = (int16_t)v;
+                if (v > col->max) col->max = (int16_t)v;
+                col->sum += v;
+                col->count++;
+                if (v < s.min) s.min = (int16_t)v;
+                if (v > s.max) s.max = (int16_t)v;
+                s.sum += v;
+                s.samples++;
+            }
+        }
+    }
+
+    if (summary != NULL) *summary = s;
+    return filled;
+}
+
+/**
+ * @brief Period uzorka nivoa u sekundama, 0 za nepostojeći nivo.
+ */
+uint16_t History_GetPeriod(uint8_t tier)
+{
+    return (tier < HIST_TIERS) ? hist_period[tier] : 0U;
+}
+
+/**
+ * @brief Pakuje stanje ili jedan blok u odgovor na `DIAG_GET`.
+ * @param subcmd  `DIAG_HIST_STATUS` ili `DIAG_HIST_READ`.
+ * @param page    Grupa od `HIST_STATUS_CHANNELS` kanala za `DIAG_HIST_STATUS`,
+ *                redni broj bloka od najstarijeg za `DIAG_HIST_READ`.
+ * @param channel Kanal za `DIAG_HIST_READ`.
+ * @param tier    Nivo za `DIAG_HIST_READ`.
+ * @param buf     Bafer za odgovor.
+ * @param size    Veličina bafera.
+ * @retval Dužina odgovora, 0 za nepoznatu pod-komandu ili kanal.
+ * @note  Treći bajt zaglavlja je broj stranica (grupa kanala za status,
+ * blokova nivoa za čitanje). Statusni zapis: broj kanala, nivoa i blokova
+ * po nivou, veličina bloka, trenutno vrijeme (32 bita), broj svjetala
+ * (16 bita), period svakog nivoa (16 bita), prvi kanal stranice i broj
+ * popunjenih blokova za svaki nivo kanala stranice (najviše
+ * `HIST_STATUS_CHANNELS`, do `HIST_CHANNELS`). Zapis bloka: kanal,
+ * nivo, vrijeme prvog uzorka (32 bita), vrijednost prvog uzorka (16 bita),
+ * broj uzoraka, broj bajtova i bajtovi razlika.
+ */
+uint16_t History_Serialize(uint8_t subcmd, uint8_t page, uint8_t channel, uint8_t tier, uint8_t* buf, uint16_t size)
+{
+    uint8_t* p = buf + HIST_HEADER_SIZE;
+    uint8_t pages = 0U;
+    uint8_t n = 0U;
+
+    if (size < HIST_HEADER_SIZE + HIST_STATUS_RECORD_SIZE) return 0U;
+
+    switch (subcmd)
+    {
+    case DIAG_HIST_STATUS:
+    {
+        pages = HIST_STATUS_PAGES;
+        if (page >= pages) break;
+        uint8_t first = page * HIST_STATUS_CHANNELS;
+        uint8_t last = ((uint32_t)(HIST_CHANNELS - first) > HIST_STATUS_CHANNELS) ? (first + HIST_STATUS_CHANNELS) : HIST_CHANNELS;
+        *p++ = HIST_CHANNELS;
+        *p++ = HIST_TIERS;
+        *p++ = HIST_BLOCKS;
+        *p++ = HIST_BLOCK_SIZE;
+        p = History_Put32(p, History_Now());
+        p = History_Put16(p, LIGHTS_MODBUS_SIZE);
+        for (uint8_t t = 0U; t < HIST_TIERS; t++) p = History_Put16(p, hist_period[t]);
+        *p++ = first;
+        for (uint8_t ch = first; ch < last; ch++)
+        {
+            for (uint8_t t = 0U; t < HIST_TIERS; t++) *p++ = hist_ring[ch][t].filled;
+        }
+        n = 1U;
+        break;
+    }
+
+    case DIAG_HIST_READ:
+    {
+        if ((channel >= HIST_CHANNELS) || (tier >= HIST_TIERS)) return 0U;
+        const History_Ring_t* r = &hist_ring[channel][tier];
+        pages = r->filled;
+        if ((page < pages) && (size >= HIST_HEADER_SIZE + HIST_BLOCK_RECORD_SIZE))
+        {
+            const History_Block_t* b = &r->block[(History_Oldest(r) + page) % HIST_BLOCKS];
+            uint8_t cnt = b->count;
+            uint8_t used = b->used;
+            *p++ = channel;
+            *p++ = tier;
+            p = History_Put32(p, b->start);
+            p = History_Put16(p, (uint16_t)b->base);
+            *p++ = cnt;
+            *p++ = used;
+            memcpy(p, b->data, used);
+            p += used;
+            n = 1U;
+        }
+        break;
+    }
+
+    default:
+        return 0U;
+    }
+
+    buf[0] = subcmd;
+    buf[1] = page;
+    buf[2] = pages;
+    buf[3] = n;
+    return (uint16_t)(p - buf);
+}
@@ -12,10 +12,11 @@
  * programa.
  *
  * Glavna `LIGHT_Service()` funkcija periodicno poziva pomocne handlere za
- * obradu tajmera (on-delay, off-time), eksternih tastera i promjena
- * stanja koje treba poslati na RS485 bus.
+ * eksterne tastere i promjene stanja koje treba poslati na RS485 bus.
+ * Tajmeri (on-delay, off-time) su u tocku tajmera (`timer_wheel.h`) i
+ * pokrecu se samo pri promjeni stanja svjetla.
  *
- * Logika za "pametno snimanje" (`HandleDelayedSave`) se koristi da bi se
+ * Logika za "pametno snimanje" (`DelayedSaveExpired`) se koristi da bi se
  * smanjio broj upisa u EEPROM prilikom cestih promjena svjetline.
  *
  ******************************************************************************
@@ -33,6 +34,8 @@
 #include "display.h"          // Potrebno za 'screen' i 'shouldDrawScreen' varijable
 #include "rs485.h"            // Potrebno za AddCommand() i redove (npr. binaryQueue)
 #include "stm32746g_eeprom.h" // Potrebno za EE_... adrese i funkcije
+#include "timer_wheel.h"      // Potrebno za tajmere odlozenog paljenja i gasenja
+#include "devreg.h"           // Potrebno za prijem BINARY_SET/DIMMER_SET po adresi releja
 
 /*============================================================================*/
 /* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
@@ -100,29 +103,24 @@ struct LIGHT_s
     uint32_t  color_old;
 
     /**
-     * @brief Timestamp (`HAL_GetTick()`) kada je "auto-off" tajmer poceo.
-     * Vrijednost 0 znaci da tajmer nije aktivan.
+     * @brief "Auto-off" tajmer, pokrece se pri paljenju ako je `off_time` > 0.
+     * Po isteku `OffTimeTimerExpired` gasi svjetlo.
      */
-    uint32_t  off_timer_start;
-
-    /**
-     * @brief Timestamp (`HAL_GetTick()`) kada je "delayed-on" tajmer poceo.
-     * Vrijednost 0 znaci da tajmer nije aktivan.
-     */
-    uint32_t  on_delay_timer_start;
+    TimerWheel_Timer_t off_timer;
 
     /**
      * @brief "Prljavi" fleg. Ako je `true`, znaci da je dolo do promjene
      * u konfiguraciji koja jo nije snimljena u EEPROM.
      * Postavlja se u `LIGHT_SetBrightness` i `LIGHT_SetColor`, a provjerava
-     * u logici za pametno snimanje (`HandleDelayedSave`, `Handle_PeriodicEvents`).
+     * u logici za pametno snimanje (`DelayedSaveExpired`, `Handle_PeriodicEvents`).
      */
     bool      is_dirty_for_saving;
 
 };
 
-// Glavni niz sa podacima je sada STATIC i vidljiv samo unutar ovog fajla
-static LIGHT_Handle lights_modbus[LIGHTS_MODBUS_SIZE];
+// Glavni niz sa podacima je sada STATIC i vidljiv samo unutar ovog fajla.
+// Niz je u SDRAM-u (`.sdram_ram`, `UNINIT`), pa ga `LIGHTS_Init` prvo brise.
+static LIGHT_Handle lights_modbus[LIGHTS_MODBUS_SIZE] __attribute__((section(".sdram_ram")));
 
 /**
  * @brief Brojac stvarno konfigurisanih svjetala.
@@ -143,39 +141,40 @@ static uint8_t lights_count = 0;
  */
 static uint8_t lights_modbus_rows = 0;
 /**
- * @brief Timestamp (`HAL_GetTick()`) kada je "Nocni tajmer" pokrenut.
- * @namjena Slui kao pocetna tacka za odbrojavanje. Vrijednost `0` znaci da tajmer nije aktivan.
- * @kako_se_koristi Postavlja se u `display.c` kada se svjetlo upali nocu. Funkcija `HandleLightNightTimer()`
- * u `lights.c` je poredi sa trenutnim vremenom da vidi da li je isteklo
- * vrijeme za gaenje svjetala.
+ * @brief "Nocni tajmer" za gasenje svjetala vezanih za glavno svjetlo.
+ * @namjena Odbrojava `LIGHT_NIGHT_TIMER_DURATION` sekundi od pokretanja.
+ * @kako_se_koristi Pokrece se iz `display.c` kada se svjetlo upali nocu. Po isteku
+ * `NightTimerExpired()` gasi svjetla.
  * @scope static - Potpuno sakrivena unutar lights.c. Upravlja se preko API funkcija.
  */
-static uint32_t LightNightTimer_StartTime = 0;
+static TimerWheel_Timer_t light_night_timer;
 /**
- * @brief Timestamp (`HAL_GetTick()`) za odloeno snimanje u EEPROM.
+ * @brief Tajmer za odloeno snimanje u EEPROM.
  * @namjena Slui kao tajmer za zatitu EEPROM memorije od prevelikog broja upisa.
  * @kako_se_koristi Kada stigne eksterna komanda (npr. sa RS485) za promjenu svjetline, kod ne snima
- * odmah, vec samo pokrene ovaj tajmer. Funkcija `HandleDelayedSave()`
- * provjerava da li je prolo dovoljno vremena (npr. 5 sekundi) i tek onda
+ * odmah, vec samo (ponovo) pokrene ovaj tajmer. Tek kada istekne
+ * `BRIGHTNESS_SAVE_DELAY_MS` bez novih promjena, `DelayedSaveExpired()`
  * izvrava snimanje.
  * @scope `static` - Mehanizam je u potpunosti enkapsuliran unutar `lights.c`.
  */
-static uint32_t save_brightness_timer_start = 0;
+static TimerWheel_Timer_t save_brightness_timer;
 
 /*============================================================================*/
 /* PROTOTIPOVI PRIVATNIH POMOCNIH FUNKCIJA                                    */
 /*============================================================================*/
 static void HandleExternalButtonActivity(void);
-static void HandleOnDelayTimers(void);
-static void HandleOffTimeTimers(void);
-static void HandleLightNightTimer(void);
+static void OffTimeTimerExpired(void* arg);
+static void NightTimerExpired(void* arg);
 static void HandleLightStatusChanges(void);
-static void HandleDelayedSave(void);
+static void DelayedSaveExpired(void* arg);
 static void LIGHT_Calculate(void);
 static void DefragmentLights(void);
 static void LIGHT_Init_Single(LIGHT_Handle* const handle, const uint16_t addr);
 static void LIGHT_Save_Single(LIGHT_Handle* const handle, const uint16_t addr);
-static LIGHT_Handle* FindLightByRelayAddress(uint16_t address);
+static LIGHT_Handle* FindLightByRelayAddress(uint16_t index, uint16_t address);
+static void LIGHTS_ExternalState(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len);
+static void LIGHTS_ExternalBrightness(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len);
+static void LIGHTS_Subscribe(void);
 /*============================================================================*/
 /* IMPLEMENTACIJA JAVNOG API-JA                                               */
 /*============================================================================*/
@@ -186,30 +185,31 @@ static LIGHT_Handle* FindLightByRelayAddress(uint16_t address);
  * @brief Inicijalizuje `lights` modul.
  * @note Iterira kroz sve slotove za svjetla, poziva `LIGHT_Init_Single` za svaki
  * da bi ucitao konfiguraciju iz EEPROM-a, i na kraju poziva `LIGHT_Calculate`
- * da prebroji konfigurisana svjetla i pripremi ih za prikaz.
+ * da prebroji konfigurisana svjetla i pripremi ih za prikaz. Adrese releja
+ * se prijavljuju u registar uredaja (`devreg.h`) za `BINARY_SET` i
+ * `DIMMER_SET` sa busa.
  */
 void LIGHTS_Init(void)
 {
+    memset(lights_modbus, 0, sizeof(lights_modbus));
     for(uint8_t i = 0; i < LIGHTS_MODBUS_SIZE; i++) {
         uint16_t address = EE_LIGHTS_MODBUS + (i * sizeof(LIGHT_EepromConfig_t));
         LIGHT_Init_Single(&lights_modbus[i], address);
     }
     LIGHT_Calculate();
+    DevReg_Register(LIGHTS_Subscribe);
 }
 
 /**
  * @brief Glavna servisna petlja za `lights` modul.
  * @note Poziva se periodicno iz `main()` petlje. Odgovorna je za pozivanje
- * svih internih `Handle...` funkcija koje upravljaju tajmerima, eksternim
- * tasterima i slanjem komandi na bus.
+ * internih `Handle...` funkcija za eksterne tastere i slanje komandi na bus.
+ * Tajmere (on-delay, off-time, nocni tajmer, odlozeno snimanje) obraduje
+ * `TimerWheel_Service` preko `...Expired` funkcija.
  */
 void LIGHT_Service(void)
 {
     HandleExternalButtonActivity();
-    HandleOnDelayTimers();
-    HandleOffTimeTimers();
-    HandleLightNightTimer();
-    HandleDelayedSave();
     HandleLightStatusChanges();
 }
 
@@ -264,8 +264,12 @@ static void DefragmentLights(void)
     while (read_index < LIGHTS_MODBUS_SIZE) {
         if (lights_modbus[read_index].config.address.tf  != 0) {
             if (read_index > write_index) {
+                LIGHT_Handle* dst = &lights_modbus[write_index];
                 // Kopiraj cijelu strukturu sa `read_index` na `write_index`
-                memcpy(&lights_modbus[write_index], &lights_modbus[read_index], sizeof(LIGHT_Handle));
+                TimerWheel_Stop(&dst->off_timer);
+                memcpy(dst, &lights_modbus[read_index], sizeof(LIGHT_Handle));
+                // Aktivni tajmeri nastavljaju na novoj adresi
+                TimerWheel_Relocate(&dst->off_timer, dst);
 
                 // Obrii originalni slot nakon kopiranja
                 memset(&lights_modbus[read_index], 0, sizeof(LIGHT_Handle));
@@ -278,7 +282,8 @@ static void DefragmentLights(void)
 /**
  * @brief Snima konfiguraciju svih svjetala u EEPROM.
  * @note Iterira kroz sva svjetla i poziva privatnu `LIGHT_Save_Single` funkciju.
- * Nakon snimanja, ponovo poziva `LIGHT_Calculate`.
+ * Nakon snimanja, ponovo poziva `LIGHT_Calculate` i gradi registar uredaja,
+ * jer defragmentacija mijenja indekse svjetala.
  */
 void LIGHTS_Save(void)
 {
@@ -290,6 +295,7 @@ void LIGHTS_Save(void)
         LIGHT_Save_Single(&lights_modbus[i], address);
     }
     LIGHT_Calculate();
+    DevReg_Rebuild();
 }
 
 /**
@@ -299,10 +305,12 @@ void LIGHTS_Save(void)
 void LIGHTS_SetDefault(void)
 {
     for(uint8_t i = 0; i < LIGHTS_MODBUS_SIZE; i++) {
+        TimerWheel_Stop(&lights_modbus[i].off_timer);
         memset(&lights_modbus[i], 0, sizeof(LIGHT_Handle));
         lights_modbus[i].config.on_hour = -1;
         lights_modbus[i].config.communication_type = LIGHT_COM_BIN;
     }
+    DevReg_Rebuild();
 }
 
 // --- Grupa 3: Getteri i Setteri za Konfiguraciju ---
@@ -314,6 +322,7 @@ uint16_t  LIGHT_GetRelay(const LIGHT_Handle* const handle)
 void LIGHT_SetRelay(LIGHT_Handle* const handle, const uint16_t val)
 {
     handle->config.address.tf = val;
+    DevReg_Rebuild();
 }
 
 bool LIGHT_isTiedToMainLight(const LIGHT_Handle* const handle)
@@ -386,6 +395,7 @@ uint8_t LIGHT_GetCommunicationType(const LIGHT_Handle* const handle)
 void LIGHT_SetCommunicationType(LIGHT_Handle* const handle, uint8_t type)
 {
     handle->config.communication_type = type;
+    DevReg_Rebuild();
 }
 
 uint8_t LIGHT_GetLocalPin(const LIGHT_Handle* const handle)
@@ -506,13 +516,13 @@ void LIGHT_SetState(LIGHT_Handle* const handle, const bool state)
             handle->config.brightness = 100;
         }
         if (handle->config.off_time > 0) {
-            handle->off_timer_start = HAL_GetTick() ? HAL_GetTick() : 1;
+            TimerWheel_Start(&handle->off_timer, handle->config.off_time * 60000UL, OffTimeTimerExpired, handle);
         }
     } else { // Gasenje
         if (!LIGHT_isBrightnessRemembered(handle) && !LIGHT_isBinary(handle)) {
             handle->config.brightness = 0;
         }
-        handle->off_timer_start = 0;
+        TimerWheel_Stop(&handle->off_timer);
     }
     // Fizicka kontrola pina se uvijek izvrava nakon promjene logickog stanja
     if (handle->config.local_pin > 0 && handle->config.local_pin < 7) {
@@ -568,68 +578,25 @@ bool LIGHTS_isAnyLightOn(void)
     return false;
 }
 
-// --- Grupa 8: Funkcije za RS485 i eksterne module ---
-
-/**
- * @brief Aurira stanje svjetla na osnovu eksterne komande (npr. sa RS485).
- * @note Pronalazi svjetlo po Modbus adresi i postavlja mu novo stanje bez
- * pokretanja logike za slanje komande nazad na bus.
- * @param relay_address Modbus adresa svjetla.
- * @param state Novo stanje (1 za ON, 0 za OFF).
- */
-void LIGHTS_UpdateExternalState(uint16_t relay_address, uint8_t state)
-{
-    LIGHT_Handle* handle = FindLightByRelayAddress(relay_address);
-    if (handle) {
-        handle->value = state;
-        handle->old_value = state;
-    }
-}
-
-/**
- * @brief Aurira svjetlinu na osnovu eksterne komande.
- * @note Slicno kao `LIGHTS_UpdateExternalState`, ali za dimabilna svjetla.
- * @param relay_address Modbus adresa dimera.
- * @param brightness Nova vrijednost svjetline (0-100).
- */
-void LIGHTS_UpdateExternalBrightness(uint16_t relay_address, uint8_t brightness)
-{
-    LIGHT_Handle* handle = FindLightByRelayAddress(relay_address);
-    if (handle) {
-        handle->config.brightness = (brightness > 100) ? 100 : brightness;
-        handle->brightness_old = handle->config.brightness;
-        handle->value = (handle->config.brightness > 0) ? 1 : 0;
-        handle->old_value = handle->value;
-        if (LIGHT_isBrightnessRemembered(handle)) {
-            handle->is_dirty_for_saving = true;
-            save_brightness_timer_start = HAL_GetTick();
-        }
-    }
-}
-
-// --- Grupa 9: API za Nocni Tajmer ---
+// --- Grupa 8: API za Nocni Tajmer ---
 
 void LIGHTS_StartNightTimer(void)
 {
-    if (!LightNightTimer_StartTime) {
-        LightNightTimer_StartTime = HAL_GetTick() ? HAL_GetTick() : 1;
+    if (!TimerWheel_IsActive(&light_night_timer)) {
+        TimerWheel_Start(&light_night_timer, LIGHT_NIGHT_TIMER_DURATION * 1000UL, NightTimerExpired, NULL);
     }
 }
 void LIGHTS_StopNightTimer(void)
 {
-    LightNightTimer_StartTime = 0;
+    TimerWheel_Stop(&light_night_timer);
 }
 bool LIGHTS_IsNightTimerActive(void)
 {
-    return (LightNightTimer_StartTime != 0);
+    return TimerWheel_IsActive(&light_night_timer);
 }
 uint8_t LIGHTS_GetNightTimerCountdown(void)
 {
-    if (!LightNightTimer_StartTime) return 0;
-    uint32_t elapsed_ms = HAL_GetTick() - LightNightTimer_StartTime;
-    uint32_t total_ms = LIGHT_NIGHT_TIMER_DURATION * 1000;
-    if (elapsed_ms >= total_ms) return 0;
-    return (total_ms - elapsed_ms) / 1000;
+    return TimerWheel_Remaining(&light_night_timer) / 1000;
 }
 
 /*============================================================================*/
@@ -637,20 +604,70 @@ uint8_t LIGHTS_GetNightTimerCountdown(void)
 /*============================================================================*/
 
 /**
- * @brief Interna funkcija za pronalazak svjetla po Modbus adresi.
- * @param address Modbus adresa koja se trai.
- * @retval LIGHT_Handle* Pokazivac na pronadeno svjetlo, ili `NULL`.
+ * @brief Interna funkcija koja vraca svjetlo pretplate iz registra uredaja.
+ * @note Poziva se iz listenera, pa se adresa jos jednom provjerava: ako prekid
+ * stigne izmedu defragmentacije i nove izgradnje registra, stari indeks ne
+ * smije vratiti pogresno svjetlo.
+ * @param index Indeks svjetla iz pretplate.
+ * @param address Modbus adresa iz okvira.
+ * @retval LIGHT_Handle* Pokazivac na svjetlo, ili `NULL`.
+ */
+static LIGHT_Handle* FindLightByRelayAddress(uint16_t index, uint16_t address)
+{
+    if (index >= LIGHTS_MODBUS_SIZE) return NULL;
+    if (lights_modbus[index].config.address.tf != address) return NULL;
+    return &lights_modbus[index];
+}
+
+/**
+ * @brief Azurira stanje svjetla na osnovu `BINARY_SET` sa busa.
+ * @note `DevReg_Handler_t`; postavlja novo stanje bez pokretanja logike za
+ * slanje komande nazad na bus. `data[0]` je stanje (1 za ON, 0 za OFF).
  */
-static LIGHT_Handle* FindLightByRelayAddress(uint16_t address)
+static void LIGHTS_ExternalState(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len)
 {
+    LIGHT_Handle* handle = FindLightByRelayAddress(index, address);
+    if (handle && (len > 0)) {
+        handle->value = data[0];
+        handle->old_value = data[0];
+    }
+}
 
-    if (address == 0) return NULL;
-    for (int i = 0; i < lights_count; i++) {
-        if (lights_modbus[i].config.address.tf == address) {
-            return &lights_modbus[i];
+/**
+ * @brief Azurira svjetlinu na osnovu `DIMMER_SET` sa busa.
+ * @note `DevReg_Handler_t`; slicno kao `LIGHTS_ExternalState`, ali za
+ * dimabilna svjetla. `data[0]` je svjetlina (0-100).
+ */
+static void LIGHTS_ExternalBrightness(uint16_t index, uint16_t address, const uint8_t* data, uint8_t len)
+{
+    LIGHT_Handle* handle = FindLightByRelayAddress(index, address);
+    if (handle && (len > 0)) {
+        uint8_t brightness = data[0];
+        handle->config.brightness = (brightness > 100) ? 100 : brightness;
+        handle->brightness_old = handle->config.brightness;
+        handle->value = (handle->config.brightness > 0) ? 1 : 0;
+        handle->old_value = handle->value;
+        if (LIGHT_isBrightnessRemembered(handle)) {
+            handle->is_dirty_for_saving = true;
+            TimerWheel_Start(&save_brightness_timer, BRIGHTNESS_SAVE_DELAY_MS, DelayedSaveExpired, NULL);
+        }
+    }
+}
+
+/**
+ * @brief Prijavljuje adrese releja svih konfigurisanih svjetala u registar.
+ * @note `DevReg_Builder_t`; poziva je `DevReg_Rebuild`. Dimabilno svjetlo
+ * slusa `DIMMER_SET`, binarno i RGB `BINARY_SET`, iste tipove koje i salje.
+ */
+static void LIGHTS_Subscribe(void)
+{
+    for(uint8_t i = 0; i < LIGHTS_MODBUS_SIZE; i++) {
+        if (LIGHT_isDimmer(&lights_modbus[i])) {
+            DevReg_Subscribe(DIMMER_SET, lights_modbus[i].config.address.tf, LIGHTS_ExternalBrightness, i);
+        } else {
+            DevReg_Subscribe(BINARY_SET, lights_modbus[i].config.address.tf, LIGHTS_ExternalState, i);
         }
     }
-    return NULL;
 }
 
 /**
@@ -675,53 +692,31 @@ static void HandleExternalButtonActivity(void)
 }
 
 /**
- * @brief Interni handler koji upravlja tajmerima za odloeno paljenje.
- * @note Poziva se iz `LIGHT_Service()`.
+ * @brief Istek tajmera za automatsko gaenje jednog svjetla.
+ * @note Poziva ga `TimerWheel_Service()`.
+ * @param arg Pokazivac na instancu svjetla.
  */
-static void HandleOnDelayTimers(void)
+static void OffTimeTimerExpired(void* arg)
 {
-    for(uint8_t i = 0; i < lights_count; ++i) {
-        LIGHT_Handle* handle = &lights_modbus[i];
-        if(handle->on_delay_timer_start && (HAL_GetTick() - handle->on_delay_timer_start) >= (handle->config.controllerID_on_delay * 60000UL)) {
-            handle->on_delay_timer_start = 0;
-            LIGHT_SetState(handle, true);
-            if(screen == SCREEN_LIGHTS) shouldDrawScreen = 1;
-        }
-    }
+    LIGHT_Handle* handle = (LIGHT_Handle*)arg;
+    LIGHT_SetState(handle, false);
+    if(screen == SCREEN_LIGHTS) shouldDrawScreen = 1;
 }
 
 /**
- * @brief Interni handler koji upravlja tajmerima za automatsko gaenje.
- * @note Poziva se iz `LIGHT_Service()`.
+ * @brief Istek globalnog nocnog tajmera.
+ * @note Poziva ga `TimerWheel_Service()`.
  */
-static void HandleOffTimeTimers(void)
+static void NightTimerExpired(void* arg)
 {
+    (void)arg;
     for(uint8_t i = 0; i < lights_count; ++i) {
         LIGHT_Handle* handle = &lights_modbus[i];
-        if(handle->off_timer_start && (HAL_GetTick() - handle->off_timer_start) >= (handle->config.off_time * 60000UL)) {
-            handle->off_timer_start = 0;
+        if(LIGHT_isTiedToMainLight(handle) && LIGHT_isActive(handle)) {
             LIGHT_SetState(handle, false);
-            if(screen == SCREEN_LIGHTS) shouldDrawScreen = 1;
         }
     }
-}
-
-/**
- * @brief Interni handler koji upravlja globalnim nocnim tajmerom.
- * @note Poziva se iz `LIGHT_Service()`.
- */
-static void HandleLightNightTimer(void)
-{
-    if(LightNightTimer_StartTime && (HAL_GetTick() - LightNightTimer_StartTime) >= (LIGHT_NIGHT_TIMER_DURATION * 1000UL)) {
-        LightNightTimer_StartTime = 0;
-        for(uint8_t i = 0; i < lights_count; ++i) {
-            LIGHT_Handle* handle = &lights_modbus[i];
-            if(LIGHT_isTiedToMainLight(handle) && LIGHT_isActive(handle)) {
-                LIGHT_SetState(handle, false);
-            }
-        }
-        shouldDrawScreen = 1;
-    }
+    shouldDrawScreen = 1;
 }
 
 /**
@@ -781,24 +776,22 @@ static void HandleLightStatusChanges(void)
 }
 
 /**
- * @brief Interni handler koji upravlja odloenim snimanjem u EEPROM.
- * @note Poziva se iz `LIGHT_Service()`. titi EEPROM od precestog upisivanja.
+ * @brief Istek tajmera za odloeno snimanje u EEPROM.
+ * @note Poziva ga `TimerWheel_Service()`. titi EEPROM od precestog upisivanja.
  */
-static void HandleDelayedSave(void)
-{
-    if (save_brightness_timer_start && (HAL_GetTick() - save_brightness_timer_start) >= BRIGHTNESS_SAVE_DELAY_MS) {
-        save_brightness_timer_start = 0;
-        bool needs_saving = false;
-        for(uint8_t i = 0; i < lights_count; i++) {
-            if (lights_modbus[i].is_dirty_for_saving) {
-                needs_saving = true;
-                lights_modbus[i].is_dirty_for_saving = false;
-            }
-        }
-        if (needs_saving) {
-            LIGHTS_Save();
+static void DelayedSaveExpired(void* arg)
+{
+    bool needs_saving = false;
+    (void)arg;
+    for(uint8_t i = 0; i < lights_count; i++) {
+        if (lights_modbus[i].is_dirty_for_saving) {
+            needs_saving = true;
+            lights_modbus[i].is_dirty_for_saving = false;
         }
     }
+    if (needs_saving) {
+        LIGHTS_Save();
+    }
 }
 
 /**
@@ -832,8 +825,7 @@ static void LIGHT_Init_Single(LIGHT_Handle* const handle, const uint16_t addr)
     handle->brightness_old = handle->config.brightness;
     handle->color = 0;
     handle->color_old = 0;
-    handle->off_timer_start = 0;
-    handle->on_delay_timer_start = 0;
+    TimerWheel_Stop(&handle->off_timer);
     handle->is_dirty_for_saving = false;
 }
 
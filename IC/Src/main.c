@@ -35,6 +35,16 @@
 #include "rs485.h"
 #include "scene.h"
 #include "gate.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "timer_wheel.h"
+#include "devreg.h"
+#include "history.h"
+#include "eventlog.h"
+#include "trace.h"
+#include "watchdog.h"
+#include "ntc.h"
+#include "LCDConf.h"
 
 /* Constants -----------------------------------------------------------------*/
 /* Imported Type  ------------------------------------------------------------*/
@@ -48,6 +58,8 @@ RTC_HandleTypeDef hrtc;
 CRC_HandleTypeDef hcrc;
 ADC_HandleTypeDef hadc1;
 ADC_HandleTypeDef hadc3;
+DMA_HandleTypeDef hdma_adc3;
+TIM_HandleTypeDef htim6;
 TIM_HandleTypeDef htim9;
 I2C_HandleTypeDef hi2c4;
 I2C_HandleTypeDef hi2c3;
@@ -58,17 +70,32 @@ UART_HandleTypeDef huart1;
 UART_HandleTypeDef huart2;
 DMA2D_HandleTypeDef hdma2d;
 /* Private Define ------------------------------------------------------------*/
-#define TS_UPDATE_TIME			            20U     // 50ms touch screen update period
-#define AMBIENT_NTC_RREF                    10000U  // 10k NTC value of at 25 degrees
-#define AMBIENT_NTC_B_VALUE                 3977U   // NTC beta parameter
-#define AMBIENT_NTC_PULLUP                  10000U	// 10k pullup resistor
+#define TS_UPDATE_TIME			            20U     // 20ms touch screen update period (polling mod bez INT linije)
+#define TS_BURST_TIME                       5U      // 5ms period ocitavanja dok je prst na ekranu
+#define TS_GESTURE_SLOP                     20U     // dozvoljeni pomak prsta za tap/dugi pritisak (px)
+#define TS_SWIPE_MIN_DISTANCE               80U     // minimalni pomak za swipe (px)
+#define TS_SWIPE_MAX_TIME                   600U    // maksimalno trajanje swipe pokreta (ms)
+#define TS_TAP_MAX_TIME                     250U    // maksimalno trajanje kratkog dodira (ms)
+#define TS_DOUBLE_TAP_TIME                  300U    // maksimalni razmak izmedu dva dodira (ms)
+#define TS_LONG_PRESS_TIME                  1000U   // prag za dugi pritisak (ms), isto kao LONG_PRESS_DURATION u display.c
+#define TS_LONG_HOLD_TIME                   2000U   // prag za produzeni pritisak (ms)
+#define TS_GESTURE_QUEUE_SIZE               4U      // velicina reda prepoznatih gestova
 #define FANC_NTC_RREF                       2000U  	// 2k fancoil NTC value of at 25 degrees
 #define FANC_NTC_B_VALUE                    3977U   // NTC beta parameter
 #define FANC_NTC_PULLUP                     2200U	// 2k2 pullup resistor
-#define ADC_READOUT_PERIOD                  345     // ntc conversion rate
+#define ADC_READOUT_PERIOD                  1000U   // rezervni period ako DMA ne podigne SCHED_EVT_ADC (vidi ntc.h)
 #define SYSTEM_STARTUP_TIME                 8765U   // 8s application startup time
 #define LSE_RESTART_ATTEMPTS                10      // Broj pokuaja prije nego to predemo na LSI
 #define LSE_TIMEOUT                         2345    // Timeout za proveru stanja oscilatora (u milisekundama)
+#define TASK_FAST_PERIOD                    1U      // ekran, RS485, FW agent i buzzer: svaka milisekunda
+#define TASK_IO_PERIOD                      10U     // svjetla, roletne, kapije i scene
+#define TASK_HVAC_PERIOD                    100U    // termostat, odmrzivac i ventilator
+#define TASK_CLOCK_PERIOD                   1000U   // alarm tajmera i provjera LSE oscilatora
+#define TASK_BUDGET_FAST                    500U    // us: ADC, buzzer, tajmeri uredaja
+#define TASK_BUDGET_IO                      2000U   // us: I2C izlazi, touch, termostat
+#define TASK_BUDGET_EEPROM                  20000U  // us: zadaci koji mogu snimati u EEPROM
+#define TASK_BUDGET_GUI                     50000U  // us: puno iscrtavanje ekrana
+#define TASK_BUDGET_FLASH                   50000U  // us: FW agent (QSPI brisanje ide po sektorima)
 #define PCA9685_GENERAL_CALL_ACK			0x00U		// pca9685 general call address with ACK response
 #define PCA9685_LED_0_ON_L_REG_ADDRESS      0x06U
 #define PCA9685_PRE_SCALE_REG_ADDRESS       0xfeU
@@ -93,6 +120,26 @@ uint8_t pca9685_register[PCA9685_REGISTER_SIZE] = {0};
 // Definiemo globalni fleg i postavljamo ga na `false` kao pocetno stanje.
 bool g_high_precision_mode = false;
 volatile uint32_t g_last_fw_packet_timestamp = 0; // Definicija globalne varijable
+static volatile uint8_t ts_irq_pending = 0U;    // postavlja EXTI prekid FT5336 INT linije
+static uint8_t ts_irq_mode = 0U;                // 1 = INT linija konfigurisana, ocitavanje samo na dogadaj
+static uint8_t ts_irq_seen = 0U;                // 1 = barem jedan INT prekid primljen, linija potvrdena
+/**
+ * @brief Stanje prepoznavanja gestova za jedan dodir.
+ * @note  Puni se iz `TS_Service` pri svakom ocitavanju, a prepoznati gestovi
+ * se stavljaju u red iz kojeg ih `TS_GetGesture` vadi.
+ */
+static struct {
+    uint8_t active;         ///< 1 = prst je na ekranu
+    uint8_t moved;          ///< 1 = pomak veci od TS_GESTURE_SLOP od pocetne tacke
+    uint8_t hold_level;     ///< 0 = nista, 1 = LONG_PRESS prijavljen, 2 = LONG_HOLD prijavljen
+    uint16_t x0, y0;        ///< koordinate pocetka dodira
+    uint16_t x, y;          ///< posljednje koordinate dodira
+    uint32_t t0;            ///< HAL_GetTick() pocetka dodira
+    uint32_t tap_time;      ///< vrijeme posljednjeg kratkog dodira, 0 = nema
+    uint16_t tap_x, tap_y;  ///< koordinate posljednjeg kratkog dodira
+} ts_gesture;
+static TS_GestureTypeDef ts_gesture_queue[TS_GESTURE_QUEUE_SIZE];
+static uint8_t ts_gesture_head = 0U, ts_gesture_tail = 0U;
 char system_pin[8]; // << NOVO: Definicija globalne varijable
 /* Private Macro -------------------------------------------------------------*/
 #define VREFIN_CAL_ADDRESS          ((uint16_t*) (0x1FF0F44A))
@@ -111,6 +158,7 @@ static void CACHE_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_TIM9_Init(void);
 static void MX_ADC3_Init(void);
+static void MX_TIM6_Init(void);
 static void MX_UART_Init(void);
 static void MX_CRC_DeInit(void);
 static void MX_RTC_DeInit(void);
@@ -123,11 +171,40 @@ static void MX_UART_DeInit(void);
 static void CheckRTC_Clock(void);
 static void SystemClock_Config(void);
 static uint32_t RTC_GetUnixTimeStamp(RTC_t* data);
-static float ROOM_GetTemperature(uint16_t adc_value);
 static void PCA9685_Init(void);
 static void PCA9685_Reset(void);
 static void PCA9685_OutputUpdate(void);
 static void PCA9685_SetOutputFrequency(uint16_t frequency);
+static void TS_GesturePush(TS_GestureTypeDef gesture);
+static void TS_GestureUpdate(uint8_t pressed, uint16_t x, uint16_t y);
+static void THSTAT_Task(void);
+static void Ventilator_Task(void);
+/**
+ * @brief Tabela zadataka planera, redoslijedom stare glavne petlje.
+ * @note  Vremenske istekove uredaja (svjetla, roletne, kapije, ventilator,
+ * odmrzivac, scene) obraduje `TimerWheel_Service` svake milisekunde; period
+ * ostalih zadataka je samo najrjedji poziv koji im je dovoljan. Dogadaj pokrece zadatak odmah,
+ * bez cekanja na period. Izvrsavanje duze od budzeta (zadnja kolona) upisuje
+ * se u trajni log u RTC backup registrima (`watchdog.h`).
+ */
+static Sched_Task_t sched_tasks[] = {
+    SCHED_TASK(ADC3_Read,               ADC_READOUT_PERIOD, SCHED_EVT_ADC,      TASK_BUDGET_FAST),
+    SCHED_TASK(TS_Service,              TS_BURST_TIME,      SCHED_EVT_TOUCH,    TASK_BUDGET_IO),
+    SCHED_TASK(DISP_Service,            TASK_FAST_PERIOD,   SCHED_EVT_TOUCH,    TASK_BUDGET_GUI),
+    SCHED_TASK(Timer_Service,           TASK_CLOCK_PERIOD,  SCHED_EVT_RTC_ALARM, TASK_BUDGET_EEPROM),
+    SCHED_TASK(TimerWheel_Service,      TASK_FAST_PERIOD,   0U,                 TASK_BUDGET_IO),
+    SCHED_TASK(LIGHT_Service,           TASK_IO_PERIOD,     0U,                 TASK_BUDGET_IO),
+    SCHED_TASK(Curtain_Service,         TASK_IO_PERIOD,     0U,                 TASK_BUDGET_IO),
+    SCHED_TASK(THSTAT_Task,             TASK_HVAC_PERIOD,   0U,                 TASK_BUDGET_EEPROM),
+    SCHED_TASK(Ventilator_Task,         TASK_HVAC_PERIOD,   0U,                 TASK_BUDGET_IO),
+    SCHED_TASK(Scene_Service,           TASK_IO_PERIOD,     0U,                 TASK_BUDGET_IO),
+    SCHED_TASK(RS485_Service,           TASK_FAST_PERIOD,   SCHED_EVT_RS485_RX, TASK_BUDGET_EEPROM), // prvo sve obradi pa salji
+    SCHED_TASK(Buzzer_Service,          TASK_FAST_PERIOD,   0U,                 TASK_BUDGET_FAST),
+    SCHED_TASK(History_Service,         TASK_CLOCK_PERIOD,  0U,                 TASK_BUDGET_IO),
+    SCHED_TASK(EventLog_Service,        TASK_IO_PERIOD,     0U,                 TASK_BUDGET_IO), // samo pokrece upis ili brisanje QSPI, ne ceka
+    SCHED_TASK(CheckRTC_Clock,          TASK_CLOCK_PERIOD,  0U,                 TASK_BUDGET_IO), // provjera ispravnosti RTC oscilatora i prelazak na LSI
+    SCHED_TASK(FwUpdateAgent_Service,   TASK_FAST_PERIOD,   SCHED_EVT_RS485_RX, TASK_BUDGET_FLASH),
+};
 /* Program Code  -------------------------------------------------------------*/
 /**
   * @brief
@@ -148,25 +225,40 @@ int main(void)
     MX_IWDG_Init();
     MX_CRC_Init();
     MX_RTC_Init();
+    Watchdog_Init((uint8_t)rstsrc);
     MX_ADC3_Init();
+    MX_TIM6_Init();
     MX_TIM9_Init();
     MX_GPIO_Init();
     MX_QSPI_Init();
     QSPI_MemMapMode();
     SDRAM_Init();
     EE_Init();
-    TS_Init();
+    EE_MigrateLayout();     // jednom, prije Init funkcija modula koje citaju EEPROM
+#if (TS_USE_INT_PIN != 0)
+    if ((TS_Init() == TS_OK) && (BSP_TS_ITConfig() == TS_OK)) ts_irq_mode = 1U;
+#else
+    (void)TS_Init();  // INT linija nije potvrdena na semi, polling svakih TS_UPDATE_TIME
+#endif
     RAM_Init();
     MX_UART_Init();
+    TimerWheel_Init();
+    DevReg_Init();
+    History_Init();
+    EventLog_Init();
+    EventLog_Write(EVLOG_RESET, (uint8_t)rstsrc, 0U);
     RS485_Init();
     LIGHTS_Init();
     Curtains_Init();
     Gate_Init();
     Scene_Init(); 
     Defroster_Init(pDef);
+    Profiler_Init();
+    Trace_Init();
     DISP_Init();
     Buzzer_Init();
     THSTAT_Init(pThst);
+    NTC_Start(&hadc3);
     PCA9685_Reset();
     PCA9685_Init();
     if(pwminit) PCA9685_SetOutputFrequency(PWM_0_15_FREQUENCY_DEFAULT);
@@ -176,28 +268,25 @@ int main(void)
 #ifdef	USE_WATCHDOG
     HAL_IWDG_Refresh(&hiwdg);
 #endif
+    Sched_Init(sched_tasks, (uint8_t)(sizeof(sched_tasks) / sizeof(sched_tasks[0])));
     while(1) {
-        ADC3_Read();
-        TS_Service();
-        DISP_Service();
-        Timer_Service();
-        LIGHT_Service();
-        Curtain_Service();
-        THSTAT_Service(pThst);
-        Defroster_Service(pDef);
-        Ventilator_Service(pVen);
-        Gate_Service();
-        Scene_Service();
-        Timer_Service();
-        RS485_Service(); // prvo sve obradi pa alji
-        Buzzer_Service();
-        CheckRTC_Clock(); // provjera ispravnosti RTC oscilatora i prelazak na LSI
-        FwUpdateAgent_Service();
+        Sched_Run();
 #ifdef	USE_WATCHDOG
         HAL_IWDG_Refresh(&hiwdg);
 #endif        
     }
 }
+/**
+  * @brief  Omotaci servisa koji primaju handle, za tabelu zadataka planera
+  * @param
+  * @retval
+  */
+static void THSTAT_Task(void) {
+    THSTAT_Service(Thermostat_GetInstance());
+}
+static void Ventilator_Task(void) {
+    Ventilator_Service(Ventilator_GetInstance());
+}
 /**
   * @brief
   * @param
@@ -260,6 +349,17 @@ void RTC_GetDateTime(RTC_t* data, uint32_t format) {
     unix = RTC_GetUnixTimeStamp(data);
     data->unix = unix;
 }
+/**
+  * @brief  EXTI callback, FT5336 INT linija signalizira novi dogadaj dodira.
+  * @param  GPIO_Pin pin koji je generisao prekid
+  * @retval None
+  */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
+    if (GPIO_Pin == TS_INT_PIN) {
+        ts_irq_pending = 1U;
+        Sched_SetEvent(SCHED_EVT_TOUCH);
+    }
+}
 /**
   * @brief
   * @param
@@ -306,6 +406,8 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart) {
   */
 void HAL_RTC_MspInit(RTC_HandleTypeDef *hrtc) {
     __HAL_RCC_RTC_ENABLE();
+    HAL_NVIC_SetPriority(RTC_Alarm_IRQn, 2, 0); // Alarm A (tajmeri) i Alarm B (sekunda), vidi timer.c
+    HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
 }
 /**
   * @brief
@@ -313,6 +415,7 @@ void HAL_RTC_MspInit(RTC_HandleTypeDef *hrtc) {
   * @retval
   */
 void HAL_RTC_MspDeInit(RTC_HandleTypeDef *hrtc) {
+    HAL_NVIC_DisableIRQ(RTC_Alarm_IRQn);
     __HAL_RCC_RTC_DISABLE();
 }
 /**
@@ -323,18 +426,26 @@ void HAL_RTC_MspDeInit(RTC_HandleTypeDef *hrtc) {
 static void MX_IWDG_Init(void) {
 #ifdef	USE_WATCHDOG
     hiwdg.Instance = IWDG;
-    hiwdg.Init.Prescaler = IWDG_PRESCALER_256; //(1/(32000/32))*4095 = 4,095s
-    hiwdg.Init.Window = 4095;
-    hiwdg.Init.Reload = 4095;
+    hiwdg.Init.Prescaler = WATCHDOG_PRESCALER; // WATCHDOG_TIMEOUT_MS (32768 ms), najmanje WATCHDOG_TIMEOUT_MIN_MS (22310 ms)
+    hiwdg.Init.Window = WATCHDOG_RELOAD;
+    hiwdg.Init.Reload = WATCHDOG_RELOAD;
     if (HAL_IWDG_Init(&hiwdg) != HAL_OK) {
         SYSRestart();
     }
 #endif
 }
 /**
-  * @brief
-  * @param
-  * @retval
+  * @brief  Ocitava touch kontroler i prosljeduje stanje STemWin-u.
+  * @note   INT linija se koristi samo uz `TS_USE_INT_PIN` (stm32746g.h),
+  * dok se PG13 ne potvrdi na semi ostaje polling.
+  * Kad je FT5336 INT linija konfigurisana, I2C ocitavanje se radi samo
+  * nakon INT prekida ili dok je prst na ekranu (burst svakih TS_BURST_TIME ms),
+  * pa u mirovanju nema I2C saobracaja. Dok prvi INT prekid ne potvrdi liniju,
+  * i bez INT linije, ostaje stari polling svakih TS_UPDATE_TIME ms, pa
+  * pogresno mapiran INT pin ne usporava odziv na dodir.
+  * Svako ocitavanje puni prepoznavanje gestova (`TS_GetGesture`).
+  * @param  None
+  * @retval None
   */
 void TS_Service(void) {
 // Definicije za dinamicki treshold osjetljivosti na dodir
@@ -342,53 +453,161 @@ void TS_Service(void) {
 #define HIGH_PRECISION_THRESHOLD    2U  // Visoka osjetljivost (precizno za slajdere)
 
     uint16_t xDiff, yDiff;
+    uint32_t period;
     __IO TS_StateTypeDef  ts;
     static GUI_PID_STATE TS_State = {0};
     static uint32_t ts_update_tmr = 0U;
 
     if (IsDISPCleaningActiv()) return;
-    else if ((HAL_GetTick() - ts_update_tmr)  >= TS_UPDATE_TIME) {
-        ts_update_tmr = HAL_GetTick();
-        BSP_TS_GetState((TS_StateTypeDef *)&ts);
-        if((ts.touchX[0] >= LCD_GetXSize()) ||
-                (ts.touchY[0] >= LCD_GetYSize())) {
-            ts.touchX[0] = 0U;
-            ts.touchY[0] = 0U;
-            ts.touchDetected = 0U;
-        }
-        xDiff = (TS_State.x > ts.touchX[0]) ? (TS_State.x - ts.touchX[0]) : (ts.touchX[0] - TS_State.x);
-        yDiff = (TS_State.y > ts.touchY[0]) ? (TS_State.y - ts.touchY[0]) : (ts.touchY[0] - TS_State.y);
 
-        // =======================================================================
-        // === ZAMIJENITE `IF` USLOV OVOM LOGIKOM ===
+    if (!ts_irq_mode)                   period = TS_UPDATE_TIME;
+    else if (ts_gesture.active)         period = TS_BURST_TIME;
+    else if (!ts_irq_seen)              period = TS_UPDATE_TIME;    // INT pin jos nije potvrden
+    else                                period = 0xFFFFFFFFU;  // mirovanje, ceka se INT
 
-        // 1. Definiemo lokalnu varijablu za treshold.
-        uint8_t threshold;
+    if (ts_irq_pending) {
+        ts_irq_pending = 0U;
+        ts_irq_seen = 1U;
+    }
+    else if ((HAL_GetTick() - ts_update_tmr) < period) return;
+
+    ts_update_tmr = HAL_GetTick();
+    BSP_TS_GetState((TS_StateTypeDef *)&ts);
+    if (ts_irq_mode) BSP_TS_ITClear();
+    if((ts.touchX[0] >= LCD_GetXSize()) ||
+            (ts.touchY[0] >= LCD_GetYSize())) {
+        ts.touchX[0] = 0U;
+        ts.touchY[0] = 0U;
+        ts.touchDetected = 0U;
+    }
+    TS_GestureUpdate(ts.touchDetected, ts.touchX[0], ts.touchY[0]);
 
-        // 2. Provjeravamo globalni fleg i biramo vrijednost.
-        if (g_high_precision_mode) {
-            threshold = HIGH_PRECISION_THRESHOLD; // Koristi visoku preciznost
-        } else {
-            threshold = NORMAL_TOUCH_THRESHOLD;   // Koristi normalnu preciznost
+    xDiff = (TS_State.x > ts.touchX[0]) ? (TS_State.x - ts.touchX[0]) : (ts.touchX[0] - TS_State.x);
+    yDiff = (TS_State.y > ts.touchY[0]) ? (TS_State.y - ts.touchY[0]) : (ts.touchY[0] - TS_State.y);
+
+    // Biramo treshold prema globalnom flegu za visoku preciznost (slajderi).
+    uint8_t threshold = g_high_precision_mode ? HIGH_PRECISION_THRESHOLD : NORMAL_TOUCH_THRESHOLD;
+
+    if((TS_State.Pressed != ts.touchDetected) || (xDiff > threshold) || (yDiff > threshold)) {
+        TS_State.Pressed = ts.touchDetected;
+        TS_State.Layer = TS_LAYER;
+        if(ts.touchDetected) {
+            TS_State.x = ts.touchX[0];
+            TS_State.y = ts.touchY[0];
+            GUI_TOUCH_StoreStateEx(&TS_State);
         }
+        else {
+            GUI_TOUCH_StoreStateEx(&TS_State);
+            TS_State.x = 0;
+            TS_State.y = 0;
+        }
+        LCD_Pacer_MarkInput(); // DISP_Service odmah pokrece GUI_Exec, mjeri se kasnjenje do prikaza
+    }
+}
+/**
+  * @brief  Vadi sljedeci prepoznati gest iz reda.
+  * @note   Poziva se iz glavne petlje (DISP_Service), nikad iz prekida.
+  * @param  None
+  * @retval TS_GESTURE_NONE ako je red prazan, inace prepoznati gest
+  */
+TS_GestureTypeDef TS_GetGesture(void) {
+    TS_GestureTypeDef gesture;
+
+    if (ts_gesture_head == ts_gesture_tail) return TS_GESTURE_NONE;
+    gesture = ts_gesture_queue[ts_gesture_tail];
+    ts_gesture_tail = (ts_gesture_tail + 1U) % TS_GESTURE_QUEUE_SIZE;
+    return gesture;
+}
+/**
+  * @brief  Stavlja prepoznati gest u red, najstariji se odbacuje ako je red pun.
+  * @param  gesture prepoznati gest
+  * @retval None
+  */
+static void TS_GesturePush(TS_GestureTypeDef gesture) {
+    uint8_t next = (ts_gesture_head + 1U) % TS_GESTURE_QUEUE_SIZE;
 
-        // 3. Koristimo odabranu vrijednost u `if` uslovu.
-        if((TS_State.Pressed != ts.touchDetected) || (xDiff > threshold) || (yDiff > threshold)) {
-            // =======================================================================
-            TS_State.Pressed = ts.touchDetected;
-            TS_State.Layer = TS_LAYER;
-            if(ts.touchDetected) {
-                TS_State.x = ts.touchX[0];
-                TS_State.y = ts.touchY[0];
-                GUI_TOUCH_StoreStateEx(&TS_State);
+    if (next == ts_gesture_tail) {
+        ts_gesture_tail = (ts_gesture_tail + 1U) % TS_GESTURE_QUEUE_SIZE;
+    }
+    ts_gesture_queue[ts_gesture_head] = gesture;
+    ts_gesture_head = next;
+}
+/**
+  * @brief  Prepoznavanje gestova iz niza ocitanja jednog dodira.
+  * @note   Dugi pritisak se prijavljuje dok je prst jos na ekranu (nakon
+  * TS_LONG_PRESS_TIME i TS_LONG_HOLD_TIME), swipe i dupli dodir pri otpustanju.
+  * Pomak veci od TS_GESTURE_SLOP ponistava dugi pritisak i tap.
+  * @param  pressed 1 ako je prst na ekranu
+  * @param  x, y koordinate dodira (vazece samo kad je pressed)
+  * @retval None
+  */
+static void TS_GestureUpdate(uint8_t pressed, uint16_t x, uint16_t y) {
+    uint32_t now = HAL_GetTick();
+    uint32_t held;
+    int32_t dx, dy;
+    uint32_t adx, ady;
+
+    if (pressed) {
+        if (!ts_gesture.active) {
+            ts_gesture.active = 1U;
+            ts_gesture.moved = 0U;
+            ts_gesture.hold_level = 0U;
+            ts_gesture.x0 = x;
+            ts_gesture.y0 = y;
+            ts_gesture.t0 = now;
+        }
+        ts_gesture.x = x;
+        ts_gesture.y = y;
+        dx = (int32_t)x - ts_gesture.x0;
+        dy = (int32_t)y - ts_gesture.y0;
+        if ((abs(dx) > TS_GESTURE_SLOP) || (abs(dy) > TS_GESTURE_SLOP)) ts_gesture.moved = 1U;
+
+        if (!ts_gesture.moved) {
+            held = now - ts_gesture.t0;
+            if ((ts_gesture.hold_level == 0U) && (held >= TS_LONG_PRESS_TIME)) {
+                ts_gesture.hold_level = 1U;
+                TS_GesturePush(TS_GESTURE_LONG_PRESS);
             }
-            else {
-                GUI_TOUCH_StoreStateEx(&TS_State);
-                TS_State.x = 0;
-                TS_State.y = 0;
+            if ((ts_gesture.hold_level == 1U) && (held >= TS_LONG_HOLD_TIME)) {
+                ts_gesture.hold_level = 2U;
+                TS_GesturePush(TS_GESTURE_LONG_HOLD);
             }
         }
+        return;
+    }
+
+    if (!ts_gesture.active) return;
+    ts_gesture.active = 0U;
+    held = now - ts_gesture.t0;
+    dx = (int32_t)ts_gesture.x - ts_gesture.x0;
+    dy = (int32_t)ts_gesture.y - ts_gesture.y0;
+    adx = (uint32_t)abs(dx);
+    ady = (uint32_t)abs(dy);
+
+    if (ts_gesture.moved) {
+        ts_gesture.tap_time = 0U;
+        if (held > TS_SWIPE_MAX_TIME) return;
+        if ((adx >= ady) && (adx >= TS_SWIPE_MIN_DISTANCE)) {
+            TS_GesturePush((dx < 0) ? TS_GESTURE_SWIPE_LEFT : TS_GESTURE_SWIPE_RIGHT);
+        }
+        else if ((ady > adx) && (ady >= TS_SWIPE_MIN_DISTANCE)) {
+            TS_GesturePush((dy < 0) ? TS_GESTURE_SWIPE_UP : TS_GESTURE_SWIPE_DOWN);
+        }
     }
+    else if ((ts_gesture.hold_level == 0U) && (held <= TS_TAP_MAX_TIME)) {
+        if (ts_gesture.tap_time && ((ts_gesture.t0 - ts_gesture.tap_time) <= TS_DOUBLE_TAP_TIME) &&
+                (abs((int32_t)ts_gesture.x0 - ts_gesture.tap_x) <= TS_GESTURE_SLOP) &&
+                (abs((int32_t)ts_gesture.y0 - ts_gesture.tap_y) <= TS_GESTURE_SLOP)) {
+            ts_gesture.tap_time = 0U;
+            TS_GesturePush(TS_GESTURE_DOUBLE_TAP);
+        }
+        else {
+            ts_gesture.tap_time = now ? now : 1U;
+            ts_gesture.tap_x = ts_gesture.x0;
+            ts_gesture.tap_y = ts_gesture.y0;
+        }
+    }
+    else ts_gesture.tap_time = 0U;
 }
 /**
   * @brief  Inicijalizuje globalne sistemske varijable iz EEPROM-a.
@@ -855,76 +1074,33 @@ static void MX_CRC_DeInit(void) {
     HAL_CRC_DeInit(&hcrc);
 }
 /**
-  * @brief  Ocitava temperaturu sa NTC senzora i prosljeduje je termostat modulu.
-  * @note   Finalna, refaktorisana verzija. Sva originalna logika za filtriranje je
-  * sacuvana, dok je logika za odlucivanje (histereza) premjetena u termostat modul.
+  * @brief  Prosljeduje termostat modulu temperaturu sa NTC senzora.
+  * @note   Uzorkovanje, usrednjavanje i filtriranje rade TIM6, DMA i prekid
+  * DMA-a (ntc.c); ovdje se samo preuzima gotovo ocitanje kad ga DMA prijavi
+  * dogadajem SCHED_EVT_ADC. Logika za odlucivanje (histereza) je u termostat modulu.
   * @param  None
   * @retval None
   */
 static void ADC3_Read(void) {
-    // Dobijamo handle za termostat na pocetku.
     THERMOSTAT_TypeDef* pThst = Thermostat_GetInstance();
+    NTC_Sample_t ntc;
 
+    // Ocitanje se preuzima uvijek, da zastavica spremnosti ne ostane postavljena.
+    if (!NTC_Read(&ntc)) return;
     // Ako ovaj uredaj nije master, ne treba ni da mjeri temperaturu.
     if (!Thermostat_IsMaster(pThst)) return;
 
-    // Lokalne staticke varijable za filtriranje ocitanja (Vaa originalna logika).
-    static uint32_t adctmr = 0U;
-    static uint32_t sample_cnt = 0U;
-    static uint16_t sample_value[10] = {0};
-    static bool first_run = true;
-    static float filtered_temp = 0.0f;
-
-    // Provjera da li je vrijeme za novo ocitavanje.
-    if ((HAL_GetTick() - adctmr) >= ADC_READOUT_PERIOD) {
-        adctmr = HAL_GetTick();
-
-        // Inicijalizacija filtera pri prvom pokretanju (Vaa originalna logika).
-        if (first_run) {
-            first_run = false;
-            uint32_t tmp_init = 0;
-            for (uint8_t i = 0; i < 10; i++) {
-                HAL_ADC_Start(&hadc3);
-                HAL_ADC_PollForConversion(&hadc3, 10);
-                sample_value[i] = HAL_ADC_GetValue(&hadc3);
-                tmp_init += sample_value[i];
-            }
-            tmp_init /= 10;
-            filtered_temp = ROOM_GetTemperature(tmp_init);
-        }
-
-        // Uzimanje novog uzorka sa ADC-a i auriranje bafera za prosjek.
-        HAL_ADC_Start(&hadc3);
-        HAL_ADC_PollForConversion(&hadc3, 10);
-        sample_value[sample_cnt] = HAL_ADC_GetValue(&hadc3);
-        if (++sample_cnt > 9) sample_cnt = 0;
-
-        // Racunanje prosjeka zadnjih 10 uzoraka.
-        uint32_t tmp_avg = 0;
-        for (uint8_t t = 0; t < 10; t++) tmp_avg += sample_value[t];
-        tmp_avg /= 10;
-
-        // Provjera da li je NTC senzor (dis)konektovan.
-        if ((tmp_avg < 100) || (tmp_avg > 4000)) {
-            // NTC je diskonektovan. Obavijesti termostat modul o novom stanju.
-            Thermostat_SetNtcStatus(pThst, false, true);
-            // Javi termostatu da je temperatura 0. On ce interno obraditi tu informaciju.
-            Thermostat_SetMeasuredTemp(pThst, 0);
-        } else {
-            // NTC je konektovan. Obavijesti termostat modul.
-            Thermostat_SetNtcStatus(pThst, true, false);
-
-            // Primjena eksponencijalnog filtera za "peglanje" vrijednosti (Vaa originalna logika).
-            float new_temp = ROOM_GetTemperature(tmp_avg);
-            filtered_temp = (filtered_temp * 0.9f) + (new_temp * 0.1f);
-
-            // Konverzija u format koji termostat koristi (int16_t, vrijednost x10).
-            int16_t ntc_temp = filtered_temp * 10;
-
-            // JEDINI POSAO: Pozovi setter i proslijedi mu novu, filtriranu temperaturu.
-            // Termostat modul ce sam odluciti da li je promjena znacajna.
-            Thermostat_SetMeasuredTemp(pThst, ntc_temp);
-        }
+    if (ntc.open) {
+        // NTC je diskonektovan. Obavijesti termostat modul o novom stanju.
+        Thermostat_SetNtcStatus(pThst, false, true);
+        // Javi termostatu da je temperatura 0. On ce interno obraditi tu informaciju.
+        Thermostat_SetMeasuredTemp(pThst, 0);
+    } else {
+        // NTC je konektovan. Obavijesti termostat modul.
+        Thermostat_SetNtcStatus(pThst, true, false);
+        // Tabela daje direktno format koji termostat koristi (int16_t, vrijednost x10).
+        // Termostat modul ce sam odluciti da li je promjena znacajna.
+        Thermostat_SetMeasuredTemp(pThst, NTC_ToDeciCelsius(ntc.filtered));
     }
 }
 /**
@@ -945,6 +1121,26 @@ static void MX_ADC3_Init(void) {
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
 
+    /* ADC3 DMA: DMA2 Stream0, kanal 2, kruzni mod (bafer u ntc.c) */
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    hdma_adc3.Instance = DMA2_Stream0;
+    hdma_adc3.Init.Channel = DMA_CHANNEL_2;
+    hdma_adc3.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_adc3.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_adc3.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_adc3.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_adc3.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_adc3.Init.Mode = DMA_CIRCULAR;
+    hdma_adc3.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_adc3.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_adc3) != HAL_OK)
+    {
+        ErrorHandler(MAIN_FUNC, ADC_DRV);
+    }
+    __HAL_LINKDMA(&hadc3, DMA_Handle, hdma_adc3);
+    HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, 0xE, 0); // dva prekida na 128 ms, najnizi prioritet
+    HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+
     hadc3.Instance = ADC3;
     hadc3.Init.ClockPrescaler = ADC_CLOCK_SYNC_PCLK_DIV4;
     hadc3.Init.Resolution = ADC_RESOLUTION_12B;
@@ -952,10 +1148,11 @@ static void MX_ADC3_Init(void) {
     hadc3.Init.ContinuousConvMode = DISABLE;
     hadc3.Init.DiscontinuousConvMode = DISABLE;
     hadc3.Init.NbrOfDiscConversion = 0U;
-    hadc3.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE;
+    hadc3.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T6_TRGO;
+    hadc3.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
     hadc3.Init.DataAlign = ADC_DATAALIGN_RIGHT;
     hadc3.Init.NbrOfConversion = 1U;
-    hadc3.Init.DMAContinuousRequests = DISABLE;
+    hadc3.Init.DMAContinuousRequests = ENABLE;
     hadc3.Init.EOCSelection = ADC_EOC_SINGLE_CONV;
 
     if(HAL_ADC_Init(&hadc3) != HAL_OK)
@@ -965,16 +1162,45 @@ static void MX_ADC3_Init(void) {
 
     sConfig.Channel = ADC_CHANNEL_11;
     sConfig.Rank = ADC_REGULAR_RANK_1;
-    sConfig.SamplingTime = ADC_SAMPLETIME_15CYCLES;
+    sConfig.SamplingTime = ADC_SAMPLETIME_144CYCLES; // 10k izvor: duze uzorkovanje, vremena ima
     sConfig.Offset = 0U;
     HAL_ADC_ConfigChannel(&hadc3, &sConfig);
 }
+/**
+  * @brief  TIM6 okida ADC3 konverziju (TRGO na update) NTC_SAMPLE_RATE_HZ puta u sekundi
+  * @param
+  * @retval
+  */
+static void MX_TIM6_Init(void) {
+    TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+    __HAL_RCC_TIM6_CLK_ENABLE();
+    htim6.Instance = TIM6;
+    htim6.Init.Prescaler = ((2U * HAL_RCC_GetPCLK1Freq()) / 1000000U) - 1U; // 1 MHz (APB1 tajmeri idu na 2 x PCLK1)
+    htim6.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim6.Init.Period = (1000000U / NTC_SAMPLE_RATE_HZ) - 1U;
+    htim6.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim6) != HAL_OK)
+    {
+        ErrorHandler(MAIN_FUNC, ADC_DRV);
+    }
+    sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+    HAL_TIMEx_MasterConfigSynchronization(&htim6, &sMasterConfig);
+    HAL_TIM_Base_Start(&htim6);
+}
 /**
   * @brief
   * @param
   * @retval
   */
 static void MX_ADC3_DeInit(void) {
+    HAL_TIM_Base_Stop(&htim6);
+    HAL_TIM_Base_DeInit(&htim6);
+    __HAL_RCC_TIM6_CLK_DISABLE();
+    HAL_ADC_Stop_DMA(&hadc3);
+    HAL_NVIC_DisableIRQ(DMA2_Stream0_IRQn);
+    HAL_DMA_DeInit(&hdma_adc3);
     __HAL_RCC_ADC3_CLK_DISABLE();
     HAL_GPIO_DeInit(GPIOC, GPIO_PIN_1|GPIO_PIN_2|GPIO_PIN_3);
     HAL_ADC_DeInit(&hadc3);
@@ -1052,7 +1278,12 @@ static void MX_GPIO_Init(void) {
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
     HAL_GPIO_Init(GPIOG, &GPIO_InitStruct);
 
+#if (TS_USE_INT_PIN != 0)
+    // PG13 je pretpostavljena FT5336 INT linija, konfigurise je BSP_TS_ITConfig()
+    GPIO_InitStruct.Pin = GPIO_PIN_14;
+#else
     GPIO_InitStruct.Pin = GPIO_PIN_13|GPIO_PIN_14;
+#endif
     GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
@@ -1069,18 +1300,6 @@ static void MX_GPIO_DeInit(void) {
     HAL_GPIO_DeInit(GPIOD, GPIO_PIN_2|GPIO_PIN_4|GPIO_PIN_7|GPIO_PIN_11);
     HAL_GPIO_DeInit(GPIOG, GPIO_PIN_3|GPIO_PIN_13|GPIO_PIN_14);
 }
-/**
-  * @brief
-  * @param
-  * @retval
-  */
-static float ROOM_GetTemperature(uint16_t adc_value) {
-    float temperature;
-    float ntc_resistance;
-    ntc_resistance = (float) (AMBIENT_NTC_PULLUP * ((4095.0f / (4095.0f - adc_value)) - 1.0f));
-    temperature = ((AMBIENT_NTC_B_VALUE * 298.1f) /  (AMBIENT_NTC_B_VALUE + (298.1f * log(ntc_resistance / AMBIENT_NTC_RREF))) -273.1f);
-    return(temperature);
-}
 /**
   * @brief  periodicna provjera RTC oscilatora i prebacivanje na LSI u slucaju otkazivanja
   * @param
@@ -1092,9 +1311,9 @@ void CheckRTC_Clock(void) {
     // Provjeri da li je prolo dovoljno vremena za novu provjeru
     if ((HAL_GetTick() - lastCheckTime) >= LSE_TIMEOUT) {
         lastCheckTime = HAL_GetTick();  // Auriraj vrijeme posljednje provjere
-        // Provjeri trenutni broj sekundi RTC-a
+        // Provjeri trenutni broj sekundi RTC-a (kesirano vrijeme, osvjezava ga Timer_Service)
         RTC_TimeTypeDef sTime;
-        HAL_RTC_GetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
+        Timer_GetWallClock(&sTime, NULL);
 
         if (!LSE_Failed) {
 
@@ -1122,6 +1341,7 @@ void CheckRTC_Clock(void) {
                 // Resetuj RTC nakon prebacivanja
                 HAL_RTC_DeInit(&hrtc);
                 MX_RTC_Init();  // Ponovno inicijalizuj RTC sa LSI
+                Timer_Resync(); // DeInit je obrisao RTC alarme
             }
 
             // Auriraj posljednje sekundno ocitavanje
@@ -0,0 +1,175 @@
+/**
+ ******************************************************************************
+ * @file    ntc.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija DMA akvizicije i filtriranja NTC senzora.
+ *
+ * @note    DMA bafer je u DTCM RAM-u (sekcija `.dtcm_ram`), koji nije
+ * keširan, pa nije potrebno poništavanje D-keša prije čitanja polovine.
+ * Filter je cjelobrojan: akumulator drži izlaz pomnožen sa
+ * 2^`NTC_EMA_SHIFT`. Prvi ispravan blok, i prvi nakon ponovnog spajanja
+ * senzora, postavlja filter direktno na izmjerenu vrijednost. Prekid
+ * objavljuje očitanje pa tek onda uvećava brojač objava; `NTC_Read` kopira
+ * očitanje i ponavlja kopiranje ako se brojač u međuvremenu promijenio, pa
+ * ne mora zabranjivati prekide. Filter i konverzija ne koriste HAL i
+ * prevode se i u host build (`ic_ntc_filter --check`, `ic_ntc_table --check`).
+ ******************************************************************************
+ */
+
+#if (__NTC_H__ != FW_BUILD)
+#error "ntc header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "ntc.h"
+#include "scheduler.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#if (NTC_BLOCK_SAMPLES != (1U << (4U + NTC_OVERSAMPLE_SHIFT)))
+#error "NTC_BLOCK_SAMPLES mora biti 16 << NTC_OVERSAMPLE_SHIFT (rezultat x16)"
+#endif
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static uint16_t ntc_dma[2U * NTC_BLOCK_SAMPLES] __attribute__((section(".dtcm_ram")));
+static uint32_t ntc_acc;                ///< Izlaz filtera << NTC_EMA_SHIFT
+static bool ntc_seeded;                 ///< Filter ima početnu vrijednost
+static uint8_t ntc_blocks;              ///< Blokova od posljednje zastavice spremnosti
+static NTC_Sample_t ntc_work;           ///< Očitanje posljednjeg bloka
+static volatile NTC_Sample_t ntc_last;  ///< Posljednje objavljeno očitanje za `NTC_Read`
+static volatile uint32_t ntc_reports;   ///< Broj objava, uvećava se nakon upisa u `ntc_last`
+static uint32_t ntc_reports_read;       ///< Broj objava pri posljednjem `NTC_Read`
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Pokreće DMA u kružnom modu; konverzije okida TIM6.
+ * @param hadc ADC3, inicijalizovan sa `ADC_EXTERNALTRIGCONV_T6_TRGO` i DMA
+ * kanalom povezanim u `MX_ADC3_Init`.
+ */
+void NTC_Start(ADC_HandleTypeDef* hadc)
+{
+    NTC_FilterReset();
+    if (HAL_ADC_Start_DMA(hadc, (uint32_t*)ntc_dma, 2U * NTC_BLOCK_SAMPLES) != HAL_OK)
+    {
+        ErrorHandler(MAIN_FUNC, ADC_DRV);
+    }
+}
+
+/**
+ * @brief Preuzima novo očitanje.
+ * @param sample Odredište.
+ * @retval true ako je od prošlog poziva stiglo novo očitanje.
+ */
+bool NTC_Read(NTC_Sample_t* sample)
+{
+    uint32_t reports;
+
+    do
+    {
+        reports = ntc_reports;
+        sample->raw = ntc_last.raw;
+        sample->filtered = ntc_last.filtered;
+        sample->open = ntc_last.open;
+    } while (reports != ntc_reports);
+
+    if (reports == ntc_reports_read) return false;
+    ntc_reports_read = reports;
+    return true;
+}
+
+/**
+ * @brief Briše stanje filtera; sljedeći ispravan blok ga postavlja.
+ */
+void NTC_FilterReset(void)
+{
+    ntc_acc = 0U;
+    ntc_seeded = false;
+    ntc_blocks = 0U;
+    ntc_reports_read = ntc_reports;
+}
+
+/**
+ * @brief Obrađuje jedan blok uzoraka.
+ * @param samples 12-bitni uzorci.
+ * @param count   Broj uzoraka, `NTC_BLOCK_SAMPLES` za tačan faktor x16.
+ * @retval true kada je postavljena zastavica spremnosti.
+ */
+bool NTC_FilterBlock(const uint16_t* samples, uint16_t count)
+{
+    uint32_t sum = 0U;
+    uint16_t raw;
+    bool open;
+
+    for (uint16_t i = 0U; i < count; i++) sum += samples[i];
+    raw = (uint16_t)(sum >> NTC_OVERSAMPLE_SHIFT);
+    open = (raw < (NTC_OPEN_LOW * 16U)) || (raw > (NTC_OPEN_HIGH * 16U));
+
+    if (open)
+    {
+        ntc_seeded = false;
+    }
+    else if (!ntc_seeded)
+    {
+        ntc_acc = (uint32_t)raw << NTC_EMA_SHIFT;
+        ntc_seeded = true;
+    }
+    else
+    {
+        ntc_acc = ntc_acc - (ntc_acc >> NTC_EMA_SHIFT) + raw;
+    }
+
+    ntc_work.raw = raw;
+    ntc_work.filtered = (uint16_t)(ntc_acc >> NTC_EMA_SHIFT);
+    ntc_work.open = open;
+
+    if (++ntc_blocks < NTC_BLOCKS_PER_REPORT) return false;
+    ntc_blocks = 0U;
+    ntc_last.raw = ntc_work.raw;
+    ntc_last.filtered = ntc_work.filtered;
+    ntc_last.open = ntc_work.open;
+    ntc_reports++;
+    return true;
+}
+
+/**
+ * @brief Pretvara vrijednost x16 u temperaturu linearnom interpolacijom.
+ * @param adc_x16 Izlaz filtera (`NTC_Sample_t::filtered`).
+ * @retval Temperatura u desetinkama °C, između `NTC_TEMP_MIN` i `NTC_TEMP_MAX`.
+ */
+int16_t NTC_ToDeciCelsius(uint16_t adc_x16)
+{
+    const uint32_t index = (uint32_t)adc_x16 >> NTC_TABLE_SHIFT;
+    const int32_t frac = (int32_t)(adc_x16 & ((1UL << NTC_TABLE_SHIFT) - 1U));
+    const int32_t t0 = ntc_table[index];
+    const int32_t t1 = ntc_table[index + 1U];
+
+    // Aritmetički pomak udesno (ARM i GCC), zaokruženo na najbližu desetinku
+    return (int16_t)(t0 + (((t1 - t0) * frac + (1L << (NTC_TABLE_SHIFT - 1U))) >> NTC_TABLE_SHIFT));
+}
+
+/**
+ * @brief DMA je napunio prvu polovinu bafera.
+ */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
+{
+    if (hadc->Instance != ADC3) return;
+    if (NTC_FilterBlock(&ntc_dma[0], NTC_BLOCK_SAMPLES)) Sched_SetEvent(SCHED_EVT_ADC);
+}
+
+/**
+ * @brief DMA je napunio drugu polovinu bafera.
+ */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
+{
+    if (hadc->Instance != ADC3) return;
+    if (NTC_FilterBlock(&ntc_dma[NTC_BLOCK_SAMPLES], NTC_BLOCK_SAMPLES)) Sched_SetEvent(SCHED_EVT_ADC);
+}
@@ -0,0 +1,104 @@
+/**
+ ******************************************************************************
+ * @file    ntc_table.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Tabela konverzije NTC senzora (generisano, ne mijenjati ručno).
+ *
+ * @note    Generiše je `ic_ntc_table > IC/Src/ntc_table.c` iz parametara u
+ * `ntc.h`: R25 = 10000, B = 3977, otpornik djelitelja 10000. Stavka `i` je
+ * temperatura u desetinkama °C za vrijednost x16 jednaku `i << 6`.
+ ******************************************************************************
+ */
+
+#include "main.h"
+#include "ntc.h"
+
+const int16_t ntc_table[NTC_TABLE_SIZE] =
+{
+     1500,  1500,  1500,  1500,  1500,  1500,  1500,  1500,  1500,  1500,  1500,  1500,
+     1500,  1500,  1500,  1500,  1500,  1500,  1500,  1500,  1488,  1466,  1445,  1425,
+     1407,  1389,  1372,  1355,  1340,  1325,  1310,  1296,  1283,  1270,  1258,  1246,
+     1234,  1223,  1212,  1202,  1192,  1182,  1172,  1163,  1154,  1145,  1136,  1128,
+     1119,  1111,  1103,  1096,  1088,  1081,  1074,  1067,  1060,  1053,  1046,  1040,
+     1033,  1027,  1021,  1015,  1009,  1003,   998,   992,   986,   981,   976,   970,
+      965,   960,   955,   950,   945,   941,   936,   931,   927,   922,   918,   913,
+      909,   905,   900,   896,   892,   888,   884,   880,   876,   872,   868,   864,
+      861,   857,   853,   850,   846,   843,   839,   836,   832,   829,   825,   822,
+      819,   816,   812,   809,   806,   803,   800,   797,   794,   791,   788,   785,
+      782,   779,   776,   773,   770,   767,   764,   762,   759,   756,   754,   751,
+      748,   746,   743,   740,   738,   735,   733,   730,   728,   725,   723,   720,
+      718,   715,   713,   711,   708,   706,   704,   701,   699,   697,   695,   692,
+      690,   688,   686,   683,   681,   679,   677,   675,   673,   671,   668,   666,
+      664,   662,   660,   658,   656,   654,   652,   650,   648,   646,   644,   642,
+      640,   638,   637,   635,   633,   631,   629,   627,   625,   623,   622,   620,
+      618,   616,   614,   613,   611,   609,   607,   606,   604,   602,   600,   599,
+      597,   595,   594,   592,   590,   589,   587,   585,   584,   582,   580,   579,
+      577,   575,   574,   572,   571,   569,   567,   566,   564,   563,   561,   560,
+      558,   557,   555,   554,   552,   551,   549,   548,   546,   545,   543,   542,
+      540,   539,   537,   536,   534,   533,   531,   530,   529,   527,   526,   524,
+      523,   522,   520,   519,   517,   516,   515,   513,   512,   511,   509,   508,
+      507,   505,   504,   502,   501,   500,   499,   497,   496,   495,   493,   492,
+      491,   489,   488,   487,   486,   484,   483,   482,   480,   479,   478,   477,
+      475,   474,   473,   472,   470,   469,   468,   467,   466,   464,   463,   462,
+      461,   459,   458,   457,   456,   455,   453,   452,   451,   450,   449,   448,
+      446,   445,   444,   443,   442,   441,   439,   438,   437,   436,   435,   434,
+      433,   431,   430,   429,   428,   427,   426,   425,   424,   422,   421,   420,
+      419,   418,   417,   416,   415,   414,   413,   411,   410,   409,   408,   407,
+      406,   405,   404,   403,   402,   401,   400,   399,   397,   396,   395,   394,
+      393,   392,   391,   390,   389,   388,   387,   386,   385,   384,   383,   382,
+      381,   380,   379,   378,   377,   376,   375,   374,   373,   372,   371,   370,
+      369,   368,   367,   366,   365,   364,   363,   362,   361,   360,   359,   358,
+      357,   356,   355,   354,   353,   352,   351,   350,   349,   348,   347,   346,
+      345,   344,   343,   342,   341,   340,   339,   338,   337,   336,   335,   334,
+      333,   332,   331,   331,   330,   329,   328,   327,   326,   325,   324,   323,
+      322,   321,   320,   319,   318,   317,   316,   315,   315,   314,   313,   312,
+      311,   310,   309,   308,   307,   306,   305,   304,   303,   303,   302,   301,
+      300,   299,   298,   297,   296,   295,   294,   293,   293,   292,   291,   290,
+      289,   288,   287,   286,   285,   284,   283,   283,   282,   281,   280,   279,
+      278,   277,   276,   275,   275,   274,   273,   272,   271,   270,   269,   268,
+      267,   267,   266,   265,   264,   263,   262,   261,   260,   260,   259,   258,
+      257,   256,   255,   254,   253,   253,   252,   251,   250,   249,   248,   247,
+      246,   246,   245,   244,   243,   242,   241,   240,   239,   239,   238,   237,
+      236,   235,   234,   233,   233,   232,   231,   230,   229,   228,   227,   226,
+      226,   225,   224,   223,   222,   221,   220,   220,   219,   218,   217,   216,
+      215,   214,   214,   213,   212,   211,   210,   209,   208,   208,   207,   206,
+      205,   204,   203,   202,   202,   201,   200,   199,   198,   197,   196,   196,
+      195,   194,   193,   192,   191,   190,   190,   189,   188,   187,   186,   185,
+      185,   184,   183,   182,   181,   180,   179,   179,   178,   177,   176,   175,
+      174,   173,   173,   172,   171,   170,   169,   168,   167,   167,   166,   165,
+      164,   163,   162,   161,   161,   160,   159,   158,   157,   156,   155,   155,
+      154,   153,   152,   151,   150,   149,   149,   148,   147,   146,   145,   144,
+      143,   143,   142,   141,   140,   139,   138,   137,   136,   136,   135,   134,
+      133,   132,   131,   130,   130,   129,   128,   127,   126,   125,   124,   123,
+      123,   122,   121,   120,   119,   118,   117,   116,   116,   115,   114,   113,
+      112,   111,   110,   109,   109,   108,   107,   106,   105,   104,   103,   102,
+      101,   101,   100,    99,    98,    97,    96,    95,    94,    93,    93,    92,
+       91,    90,    89,    88,    87,    86,    85,    84,    83,    83,    82,    81,
+       80,    79,    78,    77,    76,    75,    74,    73,    73,    72,    71,    70,
+       69,    68,    67,    66,    65,    64,    63,    62,    61,    61,    60,    59,
+       58,    57,    56,    55,    54,    53,    52,    51,    50,    49,    48,    47,
+       46,    45,    44,    44,    43,    42,    41,    40,    39,    38,    37,    36,
+       35,    34,    33,    32,    31,    30,    29,    28,    27,    26,    25,    24,
+       23,    22,    21,    20,    19,    18,    17,    16,    15,    14,    13,    12,
+       11,    10,     9,     8,     7,     6,     5,     4,     3,     2,     1,     0,
+       -1,    -2,    -4,    -5,    -6,    -7,    -8,    -9,   -10,   -11,   -12,   -13,
+      -14,   -15,   -16,   -17,   -18,   -20,   -21,   -22,   -23,   -24,   -25,   -26,
+      -27,   -28,   -29,   -31,   -32,   -33,   -34,   -35,   -36,   -37,   -39,   -40,
+      -41,   -42,   -43,   -44,   -45,   -47,   -48,   -49,   -50,   -51,   -52,   -54,
+      -55,   -56,   -57,   -58,   -60,   -61,   -62,   -63,   -65,   -66,   -67,   -68,
+      -70,   -71,   -72,   -73,   -75,   -76,   -77,   -78,   -80,   -81,   -82,   -84,
+      -85,   -86,   -87,   -89,   -90,   -91,   -93,   -94,   -95,   -97,   -98,  -100,
+     -101,  -102,  -104,  -105,  -106,  -108,  -109,  -111,  -112,  -114,  -115,  -116,
+     -118,  -119,  -121,  -122,  -124,  -125,  -127,  -128,  -130,  -131,  -133,  -134,
+     -136,  -138,  -139,  -141,  -142,  -144,  -145,  -147,  -149,  -150,  -152,  -154,
+     -155,  -157,  -159,  -160,  -162,  -164,  -166,  -167,  -169,  -171,  -173,  -174,
+     -176,  -178,  -180,  -182,  -184,  -186,  -187,  -189,  -191,  -193,  -195,  -197,
+     -199,  -201,  -203,  -205,  -207,  -209,  -212,  -214,  -216,  -218,  -220,  -222,
+     -225,  -227,  -229,  -232,  -234,  -236,  -239,  -241,  -244,  -246,  -249,  -251,
+     -254,  -256,  -259,  -261,  -264,  -267,  -270,  -273,  -275,  -278,  -281,  -284,
+     -287,  -290,  -293,  -297,  -300,  -303,  -307,  -310,  -313,  -317,  -321,  -324,
+     -328,  -332,  -336,  -340,  -344,  -348,  -352,  -357,  -361,  -366,  -371,  -376,
+     -381,  -386,  -391,  -397,  -403,  -409,  -415,  -421,  -428,  -435,  -443,  -450,
+     -458,  -467,  -476,  -486,  -496,  -508,  -520,  -533,  -548,  -564,  -583,  -600,
+     -600,  -600,  -600,  -600,  -600
+};
@@ -0,0 +1,319 @@
+/**
+ ******************************************************************************
+ * @file    profiler.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija profilera iscrtavanja ekrana.
+ *
+ * @note    Mjerenje se radi DWT brojačem ciklusa (CYCCNT), pa je cijena jedne
+ * tačke mjerenja samo čitanje registra. `DISP_Service` otvara i zatvara
+ * frejm oko glavnog `switch (screen)` bloka i oko `GUI_Exec`, a `LCDConf.c`
+ * prijavljuje svako čekanje na DMA2D. Statistika se vodi po ekranu, a
+ * frejmovi koji traju duže od `PROFILER_RECORD_MIN_US` ili su puno
+ * iscrtavanje upisuju se u kružni bafer.
+ ******************************************************************************
+ */
+
+#if (__PROFILER_H__ != FW_BUILD)
+#error "profiler header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "profiler.h"
+#include "LCDConf.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define PROFILER_SCREENS_PER_PAGE       8U      ///< Broj zapisa ekrana u jednom RS485 odgovoru
+#define PROFILER_SCREEN_RECORD_SIZE     13U     ///< Veličina zapisa ekrana u bajtima
+#define PROFILER_FRAMES_PER_PAGE        9U      ///< Broj frejmova u jednom RS485 odgovoru
+#define PROFILER_FRAME_RECORD_SIZE      11U     ///< Veličina zapisa frejma u bajtima
+#define PROFILER_HEADER_SIZE            4U      ///< subcmd, stranica, ukupno, broj zapisa
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static Profiler_ScreenStats_t screen_stats[PROFILER_SCREEN_COUNT];
+static Profiler_Frame_t frame_ring[PROFILER_RING_SIZE];
+static uint8_t frame_head;              ///< Indeks sljedećeg upisa u kružni bafer
+static uint8_t frame_count;             ///< Broj validnih zapisa u baferu
+static uint32_t cycles_per_us = 1U;
+
+static volatile uint32_t dma_cycles;    ///< Ukupno DMA2D vrijeme od starta, raste monotono
+static uint32_t exec_start;             ///< CYCCNT na početku `GUI_Exec`
+static uint32_t exec_last;              ///< Trajanje posljednjeg `GUI_Exec` koji još nije pripisan frejmu
+static uint32_t exec_dma;               ///< DMA2D vrijeme tokom posljednjeg `GUI_Exec`
+static uint32_t exec_dma_start;
+static uint32_t frame_start;            ///< CYCCNT na početku frejma
+static uint32_t frame_dma_start;        ///< `dma_cycles` na početku frejma
+static uint8_t frame_screen;
+static bool frame_redraw;
+static volatile bool reset_request;     ///< `DIAG_PROFILER_RESET` iz prekida, briše se na početku frejma
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static uint16_t Profiler_Saturate16(uint32_t value)
+{
+    return (value > 0xFFFFU) ? 0xFFFFU : (uint16_t)value;
+}
+
+static uint8_t* Profiler_Put16(uint8_t* p, uint32_t value)
+{
+    uint16_t v = Profiler_Saturate16(value);
+    *p++ = (uint8_t)(v >> 8);
+    *p++ = (uint8_t)(v & 0xFFU);
+    return p;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Uključuje DWT brojač ciklusa i briše sva mjerenja.
+ */
+void Profiler_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(DWT_LAR_ACCESS_KEY)
+    DWT->LAR = DWT_LAR_ACCESS_KEY;
+#else
+    DWT->LAR = 0xC5ACCE55U;             // Cortex-M7 zahtijeva otključavanje DWT-a
+#endif
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    cycles_per_us = SystemCoreClock / 1000000U;
+    if (cycles_per_us == 0U) cycles_per_us = 1U;
+
+    Profiler_Reset();
+}
+
+/**
+ * @brief Briše statistiku svih ekrana i kružni bafer frejmova.
+ * @note  Zajedno sa njima se brišu i brojači pacera frejmova u `LCDConf.c`.
+ */
+void Profiler_Reset(void)
+{
+    memset(screen_stats, 0, sizeof(screen_stats));
+    memset(frame_ring, 0, sizeof(frame_ring));
+    frame_head = 0U;
+    frame_count = 0U;
+    exec_last = 0U;
+    exec_dma = 0U;
+    LCD_Pacer_ResetStats();
+}
+
+/**
+ * @brief Početak `GUI_Exec` poziva.
+ */
+void Profiler_GuiExecBegin(void)
+{
+    exec_start = Profiler_Cycles();
+    exec_dma_start = dma_cycles;
+}
+
+/**
+ * @brief Kraj `GUI_Exec` poziva, trajanje se pripisuje trenutnom ekranu.
+ * @note  `GUI_Exec` se u `DISP_Service` poziva prije `switch (screen)`,
+ * pa se njegovo trajanje čuva i upisuje u zapis sljedećeg frejma.
+ */
+void Profiler_GuiExecEnd(void)
+{
+    uint32_t elapsed = Profiler_Cycles() - exec_start;
+
+    exec_last = elapsed;
+    exec_dma = dma_cycles - exec_dma_start;
+}
+
+/**
+ * @brief Početak frejma, neposredno prije poziva `Service_XxxScreen`.
+ * @note  Ovdje se izvršava brisanje zatraženo sa `DIAG_PROFILER_RESET`,
+ * u glavnoj petlji, pa se statistika ne briše usred ažuriranja.
+ * @param screen Aktivni ekran (`eScreen`).
+ * @param redraw true ako je postavljen `shouldDrawScreen`.
+ */
+void Profiler_FrameBegin(uint8_t screen, bool redraw)
+{
+    if (reset_request) {
+        reset_request = false;
+        Profiler_Reset();
+    }
+    frame_screen = screen;
+    frame_redraw = redraw;
+    frame_dma_start = dma_cycles;
+    frame_start = Profiler_Cycles();
+}
+
+/**
+ * @brief Kraj frejma, ažurira statistiku ekrana i po potrebi kružni bafer.
+ */
+void Profiler_FrameEnd(void)
+{
+    uint32_t draw = Profiler_Cycles() - frame_start;
+    uint32_t dma = (dma_cycles - frame_dma_start) + exec_dma;
+    Profiler_ScreenStats_t* st;
+
+    if (frame_screen >= PROFILER_SCREEN_COUNT) return;
+    st = &screen_stats[frame_screen];
+
+    st->frames++;
+    if (frame_redraw) st->redraws++;
+    st->draw_cycles += draw;
+    if (draw > st->draw_max) st->draw_max = draw;
+    st->dma_cycles += dma;
+    if (exec_last) {
+        st->exec_count++;
+        st->exec_cycles += exec_last;
+        if (exec_last > st->exec_max) st->exec_max = exec_last;
+    }
+
+    if (frame_redraw || exec_last || (draw >= (PROFILER_RECORD_MIN_US * cycles_per_us))) {
+        Profiler_Frame_t* fr = &frame_ring[frame_head];
+        fr->tick = HAL_GetTick();
+        fr->screen = frame_screen;
+        fr->redraw = frame_redraw ? 1U : 0U;
+        fr->draw_us = Profiler_Saturate16(draw / cycles_per_us);
+        fr->dma_us = Profiler_Saturate16(dma / cycles_per_us);
+        fr->exec_us = Profiler_Saturate16(exec_last / cycles_per_us);
+        frame_head = (frame_head + 1U) % PROFILER_RING_SIZE;
+        if (frame_count < PROFILER_RING_SIZE) frame_count++;
+    }
+
+    exec_last = 0U;
+    exec_dma = 0U;
+}
+
+/**
+ * @brief Dodaje vrijeme jedne DMA2D operacije (poziva `LCDConf.c`).
+ * @param cycles Trajanje čekanja na završetak DMA2D prenosa u ciklusima.
+ */
+void Profiler_Dma2dAdd(uint32_t cycles)
+{
+    dma_cycles += cycles;
+}
+
+/**
+ * @brief Vraća statistiku za jedan ekran.
+ * @param screen Ekran (`eScreen`).
+ * @retval Pokazivač na statistiku ili NULL ako je indeks izvan opsega.
+ */
+const Profiler_ScreenStats_t* Profiler_GetScreenStats(uint8_t screen)
+{
+    if (screen >= PROFILER_SCREEN_COUNT) return NULL;
+    return &screen_stats[screen];
+}
+
+/**
+ * @brief Broj validnih zapisa u kružnom baferu frejmova.
+ */
+uint8_t Profiler_GetFrameCount(void)
+{
+    return frame_count;
+}
+
+/**
+ * @brief Vraća zapis iz kružnog bafera, 0 je najnoviji frejm.
+ * @param index Starost zapisa (0 = najnoviji).
+ * @retval Pokazivač na zapis ili NULL ako ne postoji.
+ */
+const Profiler_Frame_t* Profiler_GetFrame(uint8_t index)
+{
+    if (index >= frame_count) return NULL;
+    return &frame_ring[(frame_head + PROFILER_RING_SIZE - 1U - index) % PROFILER_RING_SIZE];
+}
+
+/**
+ * @brief Pretvara cikluse procesora u mikrosekunde.
+ */
+uint32_t Profiler_CyclesToUs(uint64_t cycles)
+{
+    return (uint32_t)(cycles / cycles_per_us);
+}
+
+/**
+ * @brief Puni RS485 odgovor na `DIAG_GET` zahtjev profilera.
+ * @note  Format odgovora: [subcmd, stranica, ukupno zapisa, broj zapisa u
+ * ovom odgovoru, zapisi...]. Sve vrijednosti su MSB first.
+ * - `DIAG_PROFILER_SCREENS` zapis (13 B): ekran, frejmovi, iscrtavanja,
+ *   prosječno i max crtanje (us), prosječno DMA2D (us), prosječno GUI_Exec (us).
+ * - `DIAG_PROFILER_FRAMES` zapis (11 B): tick (4 B), ekran, crtanje (us),
+ *   DMA2D (us), GUI_Exec (us); bit 7 bajta ekrana označava puno iscrtavanje.
+ * - `DIAG_PROFILER_RESET` traži brisanje mjerenja na početku sljedećeg
+ *   frejma i vraća samo zaglavlje (poziva se iz USART1 prekida).
+ * @param subcmd Pod-komanda (`DIAG_PROFILER_...`).
+ * @param page Stranica zapisa.
+ * @param buf Bafer za odgovor.
+ * @param size Veličina bafera.
+ * @retval Broj upisanih bajtova, 0 za nepoznatu pod-komandu.
+ */
+uint16_t Profiler_Serialize(uint8_t subcmd, uint8_t page, uint8_t* buf, uint16_t size)
+{
+    uint8_t* p = buf + PROFILER_HEADER_SIZE;
+    uint8_t total = 0U, n = 0U;
+    uint16_t skip;
+
+    if (size < PROFILER_HEADER_SIZE) return 0U;
+
+    switch (subcmd)
+    {
+    case DIAG_PROFILER_SCREENS:
+        skip = (uint16_t)page * PROFILER_SCREENS_PER_PAGE;
+        for (uint8_t i = 0U; i < PROFILER_SCREEN_COUNT; i++)
+        {
+            const Profiler_ScreenStats_t* st = &screen_stats[i];
+            if (st->frames == 0U) continue;
+            total++;
+            if (skip) {
+                skip--;
+                continue;
+            }
+            if ((n >= PROFILER_SCREENS_PER_PAGE) ||
+                    ((uint16_t)(p - buf) + PROFILER_SCREEN_RECORD_SIZE > size)) continue;
+            *p++ = i;
+            p = Profiler_Put16(p, st->frames);
+            p = Profiler_Put16(p, st->redraws);
+            p = Profiler_Put16(p, Profiler_CyclesToUs(st->draw_cycles / st->frames));
+            p = Profiler_Put16(p, Profiler_CyclesToUs(st->draw_max));
+            p = Profiler_Put16(p, Profiler_CyclesToUs(st->dma_cycles / st->frames));
+            p = Profiler_Put16(p, st->exec_count ? Profiler_CyclesToUs(st->exec_cycles / st->exec_count) : 0U);
+            n++;
+        }
+        break;
+
+    case DIAG_PROFILER_FRAMES:
+        total = frame_count;
+        for (uint16_t i = (uint16_t)page * PROFILER_FRAMES_PER_PAGE; (i < frame_count) && (n < PROFILER_FRAMES_PER_PAGE); i++)
+        {
+            const Profiler_Frame_t* fr = Profiler_GetFrame((uint8_t)i);
+            if ((uint16_t)(p - buf) + PROFILER_FRAME_RECORD_SIZE > size) break;
+            *p++ = (uint8_t)(fr->tick >> 24);
+            *p++ = (uint8_t)(fr->tick >> 16);
+            *p++ = (uint8_t)(fr->tick >> 8);
+            *p++ = (uint8_t)(fr->tick);
+            *p++ = fr->screen | (fr->redraw ? 0x80U : 0U);
+            p = Profiler_Put16(p, fr->draw_us);
+            p = Profiler_Put16(p, fr->dma_us);
+            p = Profiler_Put16(p, fr->exec_us);
+            n++;
+        }
+        break;
+
+    case DIAG_PROFILER_RESET:
+        reset_request = true;
+        break;
+
+    default:
+        return 0U;
+    }
+
+    buf[0] = subcmd;
+    buf[1] = page;
+    buf[2] = total;
+    buf[3] = n;
+    return (uint16_t)(p - buf);
+}
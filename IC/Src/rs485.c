@@ -17,6 +17,8 @@
 /*============================================================================*/
 #include "main.h" // Uvijek prvi
 #include "thermostat.h"
+#include "thermostat_sync.h"
+#include "devreg.h"
 #include "ventilator.h"
 #include "defroster.h"
 #include "curtain.h"
@@ -27,12 +29,25 @@
 #include "firmware_update_agent.h"
 #include "rs485.h"
 #include "gate.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "trace.h"
+#include "watchdog.h"
+#include "history.h"
+#include "eventlog.h"
 
 /* Imported Types  -----------------------------------------------------------*/
 /* Imported Variables --------------------------------------------------------*/
 /* Imported Functions    -----------------------------------------------------*/
 /* Private Typedef -----------------------------------------------------------*/
 static TinyFrame tfapp;
+// Upit stanja na cekanju (GetStateAsync)
+typedef struct {
+    GetStateCallback callback;
+    uint16_t address;
+    uint16_t index;
+    uint8_t commandType;
+} GetRequest;
 /* Private Define  -----------------------------------------------------------*/
 #define BIN_ACK_POZICIJA		3   // gdje ocekujem ACK bajt u baferu odgovora binarnog upita
 #define DIM_ACK_POZICIJA		3   // pozicija ACK bajta u odgovoru na komande dimeru
@@ -67,8 +82,18 @@ CommandQueue rgbwQueue = {0};
 CommandQueue curtainQueue = {0};
 CommandQueue thermoQueue = {0};
 static GetResponseBuffer getResponseBuffer;
+// Red upita bez blokiranja; na busu je uvijek najvise jedan upit na koji se ceka
+static GetRequest getQueue[GET_QUEUE_SIZE];
+static uint8_t getHead, getCount;
+static uint8_t getAttempt;              // broj slanja upita na celu reda, 0 = jos nije poslan
+static uint32_t getSentTime;            // vrijeme posljednjeg slanja upita na celu reda
+static volatile uint16_t getAddress;    // adresa ciji odgovor prihvata GET_ASYNC_Listener
+static GetResponseBuffer getAsyncBuffer;
+static CommandStats commandStats;
 /* Private macros   ----------------------------------------------------------*/
 /* Private Function Prototypes -----------------------------------------------*/
+static bool ServiceGetQueue(void);
+static void SendGetQueue(void);
 /* Program Code  -------------------------------------------------------------*/
 /**
   * @brief  staticka inline funkcija pauze 1~2ms za kanjenje odgovora za stabilne repeatere
@@ -84,8 +109,9 @@ static inline void delay_us(uint32_t us) {
 /**
  * @brief  Listener za dogadaje sa digitalnih ulaza (senzora).
  * @note   Ovaj listener je "glup". On ne zna ta je kapija. Samo prima
- * dogadaj i prosljeduje ga svim modulima koji bi mogli biti
- * zainteresovani za promjenu stanja nekog binarnog ulaza.
+ * dogadaj i preko registra uredaja (`devreg.h`) ga prosljeduje tacno onim
+ * modulima koji su prijavili adresu ulaza (kapije, alarm, ...). Novi
+ * pretplatnik se dodaje u modulu, ne ovdje.
  */
 TF_Result DIN_EVENT_Listener(TinyFrame *tf, TF_Msg *msg)
 {
@@ -96,11 +122,7 @@ TF_Result DIN_EVENT_Listener(TinyFrame *tf, TF_Msg *msg)
         uint16_t address = (msg->data[0] << 8) | msg->data[1];
         uint8_t state = msg->data[2];
 
-        // Obavijesti sve module o dogadaju
-        GATE_BusEvent(address, DIN_EVENT, &state, 1);
-        SECURITY_BusEvent(address, DIN_EVENT, &state, 1);
-//        LIGHTS_BusEvent(address, DIN_EVENT, &state, 1); // Svjetla mogu reagovati na PIR senzore
-        // ... poziv za svaki drugi modul ...
+        DevReg_Dispatch(DIN_EVENT, address, &state, 1);
     }
     
     return TF_STAY; // Sluaj dalje, ne odgovaraj
@@ -108,59 +130,40 @@ TF_Result DIN_EVENT_Listener(TinyFrame *tf, TF_Msg *msg)
 /**
  * @brief  Sluaoci (listener) za dolazne BINARY_SET komande sa RS485 bus-a.
  * @note   Kada primi poruku o promjeni stanja binarnog svjetla, ova funkcija
- * izvlaci adresu i novo stanje, te poziva javnu API funkciju
- * `LIGHTS_UpdateExternalState` da obavijesti `lights` modul.
+ * izvlaci adresu i novo stanje i preko registra uredaja ih prosljeduje
+ * svjetlima koja su prijavila tu adresu releja.
  */
 TF_Result BINARY_SET_Listener(TinyFrame *tf, TF_Msg *msg)
 {
     // Provjera da li je odgovor validan (sadri ACK)
     if (msg->data[BIN_ACK_POZICIJA] == ACK)
     {
-        // =======================================================================
-        // === POCETAK REFAKTORISANJA ===
-
-        // KORAK 1: Izvlacimo adresu i novo stanje iz primljene poruke.
         uint16_t adr = (uint16_t)(msg->data[0] << 8) | msg->data[1];
         uint8_t state = (msg->data[2] == BINARY_ON) ? 1 : 0;
 
-        // KORAK 2: Briemo kompletnu `for` petlju.
-        // Umjesto da `rs485` modul pretrauje svjetla, on samo poziva
-        // jednu javnu funkciju i prosljeduje joj adresu i stanje.
-        LIGHTS_UpdateExternalState(adr, state);
-
-        // === KRAJ REFAKTORISANJA ===
-        // =======================================================================
+        DevReg_Dispatch(BINARY_SET, adr, &state, 1);
     }
     return TF_STAY; // Ne odgovaramo na ovu poruku, samo je sluamo.
 }
 /**
  * @brief  Sluaoci (listener) za dolazne DIMMER_SET komande sa RS485 bus-a.
  * @note   Kada primi poruku o promjeni svjetline dimera, ova funkcija
- * izvlaci adresu i novu vrijednost, te poziva javnu API funkciju
- * `LIGHTS_UpdateExternalBrightness`.
+ * izvlaci adresu i novu vrijednost i preko registra uredaja ih prosljeduje
+ * dimabilnim svjetlima na toj adresi.
  */
 TF_Result DIMMER_SET_Listener(TinyFrame *tf, TF_Msg *msg)
 {
     // Provjera da li je odgovor validan (sadri ACK)
     if (msg->data[DIM_ACK_POZICIJA] == ACK)
     {
-        // =======================================================================
-        // === POCETAK REFAKTORISANJA ===
-
-        // KORAK 1: Izvlacimo adresu i novu vrijednost svjetline iz poruke.
         uint16_t adr = (uint16_t)(msg->data[0] << 8) | msg->data[1];
         uint8_t brightness = msg->data[2];
 
-        // KORAK 2: Validacija vrijednosti (0-100)
+        // Validacija vrijednosti (0-100)
         if (brightness <= 100)
         {
-            // KORAK 3: Briemo `for` petlju i pozivamo jednu javnu funkciju.
-            // `rs485` modul vie ne brine o tome koje je svjetlo na kojoj adresi.
-            LIGHTS_UpdateExternalBrightness(adr, brightness);
+            DevReg_Dispatch(DIMMER_SET, adr, &brightness, 1);
         }
-
-        // === KRAJ REFAKTORISANJA ===
-        // =======================================================================
     }
     return TF_STAY; // Ne odgovaramo na ovu poruku.
 }
@@ -175,10 +178,8 @@ TF_Result JALOUSIE_SET_Listener(TinyFrame *tf, TF_Msg *msg)
 {
     uint16_t adr = (uint16_t)(msg->data[0]<<8) | msg->data[1];  // sastavi adresu iz upita
     uint8_t dir = msg->data[2]; // smejr aluzine
-    // Pozivamo novu Curtain_Update_External funkciju koja ce sama pronaci
-    // odgovarajucu roletnu i aurirati njeno stanje.
-    // Vie ne moramo da prolazimo kroz petlju ovdje.
-    Curtain_Update_External(adr, dir);
+    // Registar uredaja prosljeduje smjer roletni ciji je relej na ovoj adresi.
+    DevReg_Dispatch(JALOUSIE_SET, adr, &dir, 1);
 
     return TF_STAY;
 }
@@ -354,6 +355,18 @@ TF_Result THERMOSTAT_INFO_Listener(TinyFrame *tf, TF_Msg *msg)
     return TF_STAY;
 }
 /**
+* @brief :  Sinhronizacija grupe termostata: broadcast okvir sa promijenjenim
+*           poljima i rednim brojem, bez odgovora. Ovdje se samo kopira u
+*           red, a primjenjuje ga ThstSync_Service u glavnoj petlji
+* @param :
+* @retval:  TF_STAY / ne odgovaraj na ovu poruku
+*/
+TF_Result THERMOSTAT_SYNC_Listener(TinyFrame *tf, TF_Msg *msg)
+{
+    ThstSync_Receive(msg->data, msg->len);
+    return TF_STAY;
+}
+/**
 * @brief :  Ako ovaj kontroler ima registrovan master termostat sa istim
 *           id kao iz poruke promjenice svoju strukturu, master termostat
 *           ce odgovoriti na ovaj paket i jo dodatno poslati info paket
@@ -393,6 +406,10 @@ TF_Result THERMOSTAT_SETUP_Listener(TinyFrame *tf, TF_Msg *msg)
         Thermostat_SetFanDifference(pThst, msg->data[12]);
         Thermostat_SetFanControlMode(pThst, msg->data[13]);
 
+        // Opcioni bajt 14: algoritam regulacije (FANC_ALGO_xxx). Stariji
+        // uredaji salju 14 bajtova pa algoritam ostaje nepromijenjen.
+        if (msg->len > 14U) Thermostat_SetControlAlgorithm(pThst, msg->data[14]);
+
         THSTAT_Save(pThst); // Sacuvaj sve nove promjene odjednom.
 
         resp[0] = msg->data[0];
@@ -472,6 +489,42 @@ TF_Result QR_REQUEST_Listener(TinyFrame *tf, TF_Msg *msg)
     return TF_STAY;
 }
 /**
+* @brief :  Dijagnosticki upit: [adresa, pod-komanda, stranica]
+*           (za DIAG_HIST_READ jos [kanal, nivo]; za DIAG_LOG_READ je
+*           stranica broj zapisa, a slijedi redni broj, 32 bita big-endian)
+*           Odgovara samo uredaj cija je tinyframe adresa u prvom bajtu,
+*           sadrzaj odgovora puni modul kojem pod-komanda pripada.
+* @param :
+* @retval:  TF_STAY
+*/
+TF_Result DIAG_GET_Listener(TinyFrame *tf, TF_Msg *msg)
+{
+    static uint8_t resp[120];
+    uint16_t len;
+
+    if ((msg->len < 3) || (msg->data[0] != tfifa)) return TF_STAY;
+
+    if (msg->data[1] >= DIAG_LOG_STATUS) len = EventLog_Serialize(msg->data[1], msg->data[2], (msg->len > 6) ?
+                                                                  (((uint32_t)msg->data[3] << 24) | ((uint32_t)msg->data[4] << 16) |
+                                                                   ((uint32_t)msg->data[5] << 8) | msg->data[6]) : 0, resp, sizeof(resp));
+    else if (msg->data[1] >= DIAG_HIST_STATUS) len = History_Serialize(msg->data[1], msg->data[2], (msg->len > 3) ? msg->data[3] : 0,
+                                                                  (msg->len > 4) ? msg->data[4] : 0, resp, sizeof(resp));
+    else if (msg->data[1] >= DIAG_WDG_LOG) len = Watchdog_Serialize(msg->data[1], msg->data[2], resp, sizeof(resp));
+    else if (msg->data[1] >= DIAG_TRACE_STATUS) len = Trace_Serialize(msg->data[1], msg->data[2], resp, sizeof(resp));
+    else if (msg->data[1] >= DIAG_SCHED_TASKS) len = Sched_Serialize(msg->data[1], msg->data[2], resp, sizeof(resp));
+    else len = Profiler_Serialize(msg->data[1], msg->data[2], resp, sizeof(resp));
+    if (len == 0)
+    {
+        resp[0] = msg->data[1];
+        resp[1] = NAK;
+        len = 2;
+    }
+    msg->data = resp;
+    msg->len = len;
+    TF_Respond(tf, msg);
+    return TF_STAY;
+}
+/**
 * @brief :  Koliko je sati ?
 * @param :
 * @retval:  TF_STAY
@@ -488,6 +541,7 @@ TF_Result TIME_INFO_Listener(TinyFrame *tf, TF_Msg *msg)
     HAL_RTC_SetTime(&hrtc, &rtctm, RTC_FORMAT_BCD);
     HAL_RTC_SetDate(&hrtc, &rtcdt, RTC_FORMAT_BCD);
     RtcTimeValidSet();
+    Timer_Resync();
     return TF_STAY;
 }
 /**
@@ -523,6 +577,33 @@ TF_Result GET_RESPONSE_Listener(TinyFrame *tf, TF_Msg *msg)
     return TF_CLOSE;
 }
 /**
+* @brief :  ID listener upita iz GetStateAsync
+* @param :
+* @retval:  samo kopira odgovor, povratnu funkciju poziva RS485_Service
+*/
+TF_Result GET_ASYNC_Listener(TinyFrame *tf, TF_Msg *msg)
+{
+    if ((msg->data == NULL) || (msg->len < 2) || (msg->len > sizeof(getAsyncBuffer.data))) return TF_CLOSE;
+    // odgovor nosi adresu: kasni odgovor na raniji upit se ne prihvata
+    if ((uint16_t)((msg->data[0] << 8) | msg->data[1]) != getAddress) return TF_CLOSE;
+
+    getAsyncBuffer.commandType = msg->type;
+    getAsyncBuffer.length = msg->len;
+    memcpy(getAsyncBuffer.data, msg->data, msg->len);
+    getAsyncBuffer.ready = true;
+    return TF_CLOSE;
+}
+/**
+* @brief :  Odredi adresat komande za trajni dnevnik
+* @param :  commandType tip komande, data i length sadrzaj komande
+* @retval:  adresa iz prva dva bajta; za THERMOSTAT_SYNC (broadcast) grupa termostata
+*/
+static uint32_t Command_Target(uint8_t commandType, const uint8_t *data, uint8_t length)
+{
+    if (commandType == THERMOSTAT_SYNC) return (length > THST_SYNC_POS_GROUP) ? data[THST_SYNC_POS_GROUP] : 0U;
+    return (length >= 2) ? (((uint32_t)data[0] << 8) | data[1]) : 0U;
+}
+/**
 * @brief :  Ubaci sljedecu komandu u red komandi na cekanju
 * @param :
 * @retval:  ne vraca nita samo izade ako je dug red treba proirit memoriju
@@ -534,6 +615,8 @@ bool AddCommand(CommandQueue *queue, uint8_t commandType, uint8_t *data, uint8_t
         // 1. Prebaci u "overflow buffer" i kasnije obradi
         // 2. Prepie najstariju komandu (ring buffer stil)
         // 3. Samo odbaci novu komandu
+        commandStats.dropped++;
+        EventLog_Write(EVLOG_BUS_DROP, commandType, Command_Target(commandType, data, length));
         return false; // vrati pozivaocu status
     }
 
@@ -563,8 +646,18 @@ void SendCommand(CommandQueue *queue)
     else if (cmd->commandType == THERMOSTAT_INFO)   ack_pozicija = THE_ACK_POZICIJA;
     else if (cmd->commandType == RGB_SET)           ack_pozicija = RGB_ACK_POZICIJA;
 
+    // Sinhronizacija grupe termostata je broadcast bez odgovora: jedno slanje
+    if (cmd->commandType == THERMOSTAT_SYNC) {
+        TF_SendSimple(&tfapp, cmd->commandType, cmd->data, cmd->length);
+        commandStats.sent++;
+        queue->head = (queue->head + 1) % COMMAND_QUEUE_SIZE;
+        queue->count--;
+        return;
+    }
+
     // Pokuaj ponovnog slanja komande
-    for (int pokusaj = 0; pokusaj < MAX_RETRIES; pokusaj++) {
+    int pokusaj;
+    for (pokusaj = 0; pokusaj < MAX_RETRIES; pokusaj++) {
 
         ack_flag = false; // Resetujemo flag prije slanja komande
 
@@ -580,6 +673,12 @@ void SendCommand(CommandQueue *queue)
 
         if (ack_flag) break; // Ako smo dobili odgovor, izlazimo iz petlje
     }
+    commandStats.sent++;
+    if (!ack_flag) commandStats.failed++;
+    // u trajni dnevnik: adresa je u prva dva bajta komande
+    uint32_t adresa = ((uint32_t)cmd->data[0] << 8) | cmd->data[1];
+    if (!ack_flag) EventLog_Write(EVLOG_BUS_FAIL, cmd->commandType, adresa);
+    else if (pokusaj > 0) EventLog_Write(EVLOG_BUS_RETRY, cmd->commandType, adresa | ((uint32_t)pokusaj << 16));
 
     // Ako je komanda zavrena (bilo zbog ACK-a ili timeouta), ukloni je iz reda
     queue->head = (queue->head + 1) % COMMAND_QUEUE_SIZE;
@@ -599,6 +698,9 @@ bool GetState(uint8_t commandType, uint16_t address, uint8_t *response)
     buf[0] = (address >> 8) & 0xFF;
     buf[1] = address & 0xFF;
 
+    // sacekaj odgovor na upit iz GetStateAsync da se odgovori ne sudare
+    while (ServiceGetQueue()) HAL_Delay(1);
+
     for (int attempt = 0; attempt < MAX_GET_RETRY; attempt++) {
         getResponseBuffer.ready = false;  // Resetujemo status odgovora
         getResponseBuffer.commandType = 0;
@@ -618,6 +720,41 @@ bool GetState(uint8_t commandType, uint16_t address, uint8_t *response)
     return false;  // Ako nakon svih pokuaja nema odgovora, vracamo false
 }
 /**
+* @brief :  ubaci upit stanja u red bez cekanja odgovora
+* @param :  callback se poziva iz RS485_Service kada odgovor stigne, sa
+*           index i podacima iza adrese; bez odgovora ni nakon MAX_GET_RETRY
+*           slanja se ne poziva. Poziva se samo iz glavne petlje.
+* @retval:  true = upit je u redu (ili je isti upit vec na cekanju) / false = red je pun
+*/
+bool GetStateAsync(uint8_t commandType, uint16_t address, GetStateCallback callback, uint16_t index)
+{
+    if ((callback == NULL) || (address == 0)) return false;
+
+    for (uint8_t i = 0; i < getCount; i++) {
+        GetRequest *req = &getQueue[(getHead + i) % GET_QUEUE_SIZE];
+        if ((req->commandType == commandType) && (req->address == address) &&
+            (req->callback == callback) && (req->index == index)) return true;
+    }
+    if (getCount >= GET_QUEUE_SIZE) return false;
+
+    GetRequest *req = &getQueue[(getHead + getCount) % GET_QUEUE_SIZE];
+    req->commandType = commandType;
+    req->address = address;
+    req->callback = callback;
+    req->index = index;
+    getCount++;
+    return true;
+}
+/**
+* @brief :  brojaci poslanih, nepotvrdenih i odbacenih komandi iz redova
+* @param :
+* @retval:  pokazivac na brojace, uvijek validan
+*/
+const CommandStats* GetCommandStats(void)
+{
+    return &commandStats;
+}
+/**
 * @brief :  init usart interface to rs485 9 bit receiving
 * @param :  and init state to receive packet control block
 * @retval:  wait to receive:
@@ -645,8 +782,10 @@ void RS485_Init(void)
         TF_AddTypeListener(&tfapp, THERMOSTAT_SET, THERMOSTAT_SET_Listener);
         TF_AddTypeListener(&tfapp, THERMOSTAT_INFO, THERMOSTAT_INFO_Listener);
         TF_AddTypeListener(&tfapp, THERMOSTAT_SETUP, THERMOSTAT_SETUP_Listener);
+        TF_AddTypeListener(&tfapp, THERMOSTAT_SYNC, THERMOSTAT_SYNC_Listener);
         TF_AddTypeListener(&tfapp, FIRMWARE_UPDATE, FIRMWARE_UPDATE_Listener);
         TF_AddTypeListener(&tfapp, DIN_EVENT, DIN_EVENT_Listener);
+        TF_AddTypeListener(&tfapp, DIAG_GET, DIAG_GET_Listener);
     }
     HAL_UART_Receive_IT(&huart1, &rec, 1);
 }
@@ -660,8 +799,6 @@ void RS485_Init(void)
 */
 void RS485_Service(void)
 {
-    THERMOSTAT_TypeDef* pThst = Thermostat_GetInstance();
-
     uint32_t now = HAL_GetTick();
 
     if (IsFwUpdateActiv())
@@ -674,12 +811,18 @@ void RS485_Service(void)
         }
         return;
     }
-    // alji komande na redu
-    SendCommand(&binaryQueue);
-    SendCommand(&dimmerQueue);
-    SendCommand(&rgbwQueue);
-    SendCommand(&curtainQueue);
-    SendCommand(&thermoQueue);
+    // dok odgovor na upit stanja jos moze stici ne saljemo nista drugo
+    if (!ServiceGetQueue())
+    {
+        // alji komande na redu
+        SendCommand(&binaryQueue);
+        SendCommand(&dimmerQueue);
+        SendCommand(&rgbwQueue);
+        SendCommand(&curtainQueue);
+        SendCommand(&thermoQueue);
+        // pa sljedeci upit stanja, odgovor obraduje neki od narednih prolaza
+        SendGetQueue();
+    }
     // spasinovi qr kod ako je na cekanju
     if(qr_save)
     {
@@ -695,10 +838,57 @@ void RS485_Service(void)
     if(th_info_delay && (now - th_info_delay) >=0 )
     {
         th_info_delay = 0;
-        Thermostat_SetInfoChanged(pThst, true);
+        ThstSync_RequestKeyframe(); // cijelo stanje grupi nakon SET/SETUP
     }
 
 }
+/**
+* @brief :  obradi upit na celu reda GetStateAsync: odgovor, istek ili novi pokusaj
+* @param :
+* @retval:  true = upit je poslan i odgovor jos moze stici, bus je zauzet
+*/
+static bool ServiceGetQueue(void)
+{
+    while (getCount != 0) {
+        GetRequest *req = &getQueue[getHead];
+
+        if (getAttempt == 0) return false;  // ceka slanje
+        if (getAsyncBuffer.ready) {
+            getAsyncBuffer.ready = false;
+            if (getAsyncBuffer.commandType == req->commandType)
+                req->callback(req->index, req->address, &getAsyncBuffer.data[2], getAsyncBuffer.length - 2);
+        } else if ((HAL_GetTick() - getSentTime) < RESPONSE_TIME) {
+            return true;
+        } else if (getAttempt < MAX_GET_RETRY) {
+            return false;  // istekao, SendGetQueue ga salje ponovo
+        }
+        // zavrsen (odgovor ili svi pokusaji bez odgovora), sljedeci upit
+        getHead = (getHead + 1) % GET_QUEUE_SIZE;
+        getCount--;
+        getAttempt = 0;
+    }
+    return false;
+}
+/**
+* @brief :  posalji upit na celu reda GetStateAsync i vrati se bez cekanja
+* @param :
+* @retval:
+*/
+static void SendGetQueue(void)
+{
+    if (getCount == 0) return;
+
+    GetRequest *req = &getQueue[getHead];
+    uint8_t buf[2];
+    buf[0] = (req->address >> 8) & 0xFF;
+    buf[1] = req->address & 0xFF;
+
+    getAddress = req->address;
+    getAsyncBuffer.ready = false;
+    getSentTime = HAL_GetTick();
+    getAttempt++;
+    TF_QuerySimple(&tfapp, req->commandType, buf, sizeof(buf), GET_ASYNC_Listener, RESPONSE_TIME);
+}
 /**
   * @brief
   * @param
@@ -721,6 +911,56 @@ void TF_WriteImpl(TinyFrame *tf, const uint8_t *buff, uint32_t len)
     HAL_UART_Transmit(&huart1,(uint8_t*)buff, len, RESP_TOUT);
     HAL_UART_Receive_IT(&huart1, &rec, 1);
 }
+#if (TF_CRC16_BACKEND == TF_CRC16_HW)
+/**
+  * @brief  Nastavlja TinyFrame CRC16 (0x8005, reflektovan) nad blokom u CRC periferiji.
+  * @note   Periferiju dijele i EEPROM moduli preko HAL_CRC_Calculate (32-bitni
+  *         polinom). Upis u INIT puni i DR (RM0385), pa se stanje prekinutog
+  *         racunanja ne moze vratiti. Zato se periferija koristi samo dok
+  *         hcrc nije zauzet (State/Lock), sve sa zabranjenim prekidima, a
+  *         inace TinyFrame racuna tabelom. Na kraju se vrate POL, CR i INIT;
+  *         sljedeci HAL_CRC_Calculate ionako pocinje sa RESET (DR = INIT).
+  *         Reflektovani CRC se u INIT upisuje i iz DR cita sa obrnutim bitima.
+  *         Isti redoslijed nad modelom registara provjerava tf_bench_hw
+  *         (Middlewares/TinyFrame/bench), pa se mijenja na oba mjesta.
+  * @param  cksum  Dosadasnja vrijednost CRC-a, nova ako je vraceno true
+  * @param  buf    Bajtovi koji se dodaju
+  * @param  len    Broj bajtova (TinyFrame salje samo blokove >= TF_CRC16_HW_MIN_LEN)
+  * @retval false ako je periferija zauzeta drugim racunanjem
+  */
+bool TF_CksumHwAdd(TF_CKSUM *cksum, const uint8_t *buf, uint32_t len)
+{
+    CRC_TypeDef *crc = hcrc.Instance;
+    uint32_t primask = __get_PRIMASK();
+    uint32_t cr, pol, init;
+
+    __disable_irq();
+    if ((hcrc.State != HAL_CRC_STATE_READY) || (hcrc.Lock != HAL_UNLOCKED))
+    {
+        __set_PRIMASK(primask);
+        return false;   // prekinut HAL_CRC_Calculate ili HAL_CRC_Init
+    }
+    cr = crc->CR;
+    pol = crc->POL;
+    init = crc->INIT;
+
+    crc->POL = 0x8005U;
+    crc->CR = CRC_CR_POLYSIZE_0 | CRC_CR_REV_IN_0;  // 16 bita, obrnuti biti svakog bajta
+    crc->INIT = __RBIT(*cksum) >> 16;
+    crc->CR |= CRC_CR_RESET;
+    while (len--)
+    {
+        *(__IO uint8_t*)&crc->DR = *buf++;
+    }
+    *cksum = (TF_CKSUM)(__RBIT(crc->DR & 0xFFFFU) >> 16);
+
+    crc->POL = pol;
+    crc->CR = cr;
+    crc->INIT = init;
+    __set_PRIMASK(primask);
+    return true;
+}
+#endif
 /**
   * @brief
   * @param
@@ -728,7 +968,12 @@ void TF_WriteImpl(TinyFrame *tf, const uint8_t *buff, uint32_t len)
   */
 void RS485_RxCpltCallback(void)
 {
+    uint32_t frames = tfapp.rx_frames;
+
     TF_AcceptChar(&tfapp, rec);
+    // budi planer samo kad je parser predao ispravan okvir listenerima,
+    // ne za bajtove suma na magistrali ni za okvire sa pogresnim CRC-om
+    if (tfapp.rx_frames != frames) Sched_SetEvent(SCHED_EVT_RS485_RX);
     HAL_UART_Receive_IT(&huart1, &rec, 1);
 }
 /**
@@ -10,6 +10,17 @@
  * aktiviranje scena (slanje komandi drugim modulima), memorisanje trenutnog
  * stanja sistema u scenu, kao i za upravljanje globalnim stanjem sistema
  * (npr. "Away Mode").
+ *
+ * Aktivacija scene je transakcija: `Scene_ExecuteComfortActions` poredi
+ * memorisana stanja sa trenutnim stanjem uređaja i u plan stavlja samo
+ * uređaje koje treba promijeniti. `Scene_Service` primjenjuje najviše
+ * `SCENE_STEPS_PER_PASS` uređaja po prolazu, i to samo dok su redovi
+ * komandi u `rs485` najviše do pola puni, pa aktivacija ne može prepuniti
+ * red. Komande i dalje šalju servisi svjetala i roletni (detekcija
+ * promjene), tako da se za jedan uređaj šalje najviše jedna komanda po
+ * atributu. Scena je završena kada su primijenjeni svi uređaji i kada su
+ * redovi prazni; ishod se određuje po brojačima komandi iz `rs485`
+ * (`GetCommandStats`) između početka i kraja transakcije.
  ******************************************************************************
  */
 
@@ -29,16 +40,28 @@
 #include "gate.h"
 #include "rs485.h"
 #include "stm32746g_eeprom.h"
+#include "timer_wheel.h"
+#include "eventlog.h"
 
 /*============================================================================*/
 /* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
 /*============================================================================*/
 
 /**
- * @brief Puna veličina bloka podataka za scene koji se čuva u EEPROM-u.
- * @note  Uključuje magični broj, niz scena i CRC.
+ * @brief Adresa zapisa jedne scene u EEPROM-u.
  */
-#define EE_SCENES_BLOCK_SIZE (sizeof(uint16_t) + sizeof(scenes) + sizeof(uint16_t))
+#define EE_SCENE_RECORD(index)  (EE_SCENES + ((index) * sizeof(Scene_EepromRecord_t)))
+
+/**
+ * @name Primjena scene (transakcija)
+ * @{
+ */
+#define SCENE_PLAN_SIZE         (LIGHTS_MODBUS_SIZE + CURTAINS_SIZE + 1U)  ///< Svjetla, roletne i termostat
+#define SCENE_STEPS_PER_PASS    4U                          ///< Najviše uređaja po prolazu `Scene_Service`
+#define SCENE_QUEUE_LIMIT       (COMMAND_QUEUE_SIZE / 2U)   ///< Novi uređaji samo dok je svaki red do pola pun
+#define SCENE_SETTLE_MS         200U                        ///< Dva prolaza najsporijeg servisa (termostat, 100 ms) da promjena postane komanda
+#define SCENE_APPLY_TIMEOUT_MS  15000U                      ///< Najduže trajanje aktivacije
+/** @} */
 
 
 /*============================================================================*/
@@ -48,9 +71,21 @@
 /**
  * @brief Statički niz koji u RAM-u čuva konfiguraciju i stanje za sve scene.
  * @note  Ovo je "jedinstveni izvor istine" za stanje scena tokom rada uređaja.
- * Inicijalizuje se iz EEPROM-a prilikom pokretanja sistema.
+ * Inicijalizuje se iz EEPROM-a prilikom pokretanja sistema. Niz je u
+ * SDRAM-u (`.sdram_ram`, `UNINIT`), pa ga `Scene_Init` prvo briše.
+ */
+static Scene_t scenes[SCENE_MAX_COUNT] __attribute__((section(".sdram_ram")));
+
+/**
+ * @brief CRC zapisa svake scene kakav je sada u EEPROM-u.
+ * @note  `Scene_Save` upisuje samo scene čiji se CRC razlikuje.
+ */
+static uint16_t scene_saved_crc[SCENE_MAX_COUNT];
+
+/**
+ * @brief Zapis scene za čitanje i upis; statički, jer je prevelik za stek.
  */
-static Scene_t scenes[SCENE_MAX_COUNT];
+static Scene_EepromRecord_t scene_record;
 
 /**
  * @brief Statička varijabla koja čuva trenutno globalno stanje sistema.
@@ -65,8 +100,9 @@ static SystemState_e system_state = SYSTEM_STATE_HOME;
  */
 typedef struct
 {
-    uint8_t  runtime_state; // Npr. STATE_IDLE, STATE_LEAVING_DELAY
-    uint32_t timer_start;   // Vrijeme početka tajmera (HAL_GetTick())
+    uint8_t  runtime_state;     // Npr. STATE_IDLE, STATE_LEAVING_DELAY
+    TimerWheel_Timer_t timer;   // Tajmer odgode "Odlazak" scene
+    Scene_ApplyStats_t apply;   // Ishod i mjerenja aktivacija
 } Scene_Runtime_t;
 
 /**
@@ -80,12 +116,58 @@ enum {
 /**
  * @brief Statički niz koji čuva runtime podatke za sve scene, paralelno sa `scenes` nizom.
  */
-static Scene_Runtime_t scene_runtime_data[SCENE_MAX_COUNT];
+static Scene_Runtime_t scene_runtime_data[SCENE_MAX_COUNT] __attribute__((section(".sdram_ram")));
+
+/**
+ * @brief Vrsta uređaja u planu primjene scene.
+ */
+enum {
+    SCENE_STEP_LIGHT,
+    SCENE_STEP_CURTAIN,
+    SCENE_STEP_THERMOSTAT
+};
+
+/**
+ * @brief Jedan uređaj čije stanje treba promijeniti.
+ */
+typedef struct
+{
+    uint8_t kind;               // SCENE_STEP_...
+    uint8_t index;              // Indeks svjetla ili roletne
+} Scene_Step_t;
+
+/**
+ * @brief Transakcija aktivacije scene; aktivna je najviše jedna.
+ */
+typedef struct
+{
+    Scene_Step_t step[SCENE_PLAN_SIZE];
+    uint8_t  count;             // Koraka u planu
+    uint8_t  next;              // Sljedeći korak za primjenu
+    int8_t   scene_index;       // Scena u primjeni, -1 = nema transakcije
+    uint32_t start_tick;
+    uint32_t last_step_tick;
+    CommandStats commands;      // Brojači `rs485` na početku transakcije
+} Scene_Transaction_t;
+
+static Scene_Transaction_t transaction = { .scene_index = -1 };
+
+/**
+ * @brief Posljednja aktivirana scena (za prikaz ishoda), -1 = nijedna.
+ */
+static int8_t last_activated = -1;
 /*============================================================================*/
 /* PROTOTIPOVI PRIVATNIH POMOCNIH FUNKCIJA                                    */
 /*============================================================================*/
-static void Scene_SetDefault(void);
+static void Scene_SetDefault(uint8_t scene_index);
+static uint16_t Scene_PackRecord(uint8_t scene_index);
 static void Scene_ExecuteComfortActions(uint8_t scene_index);
+static void Scene_LeavingDelayExpired(void* arg);
+static bool Scene_LightDiffers(const Scene_t* scene, uint8_t i);
+static void Scene_ApplyStep(const Scene_t* scene, const Scene_Step_t* step);
+static bool Scene_QueuesBelow(uint8_t limit);
+static void Scene_ServiceTransaction(void);
+static void Scene_FinishTransaction(bool timed_out);
 
 /*============================================================================*/
 /* IMPLEMENTACIJA JAVNOG API-JA                                               */
@@ -95,49 +177,15 @@ static void Scene_ExecuteComfortActions(uint8_t scene_index);
  * @brief       Glavna servisna petlja za modul scena.
  * @author      Gemini & [Vaše Ime]
  * @note        Ova funkcija se poziva periodično iz `main.c`. Njena uloga je da
- * izvršava dugotrajne ili periodične zadatke. Upravlja tajmerom za
- * odgodu "Odlazak" scene i logikom za simulaciju prisustva kada je
- * sistem u "Away" modu.
+ * izvršava dugotrajne ili periodične zadatke, trenutno logiku za
+ * simulaciju prisustva kada je sistem u "Away" modu, i da nastavi
+ * primjenu aktivirane scene (`Scene_ServiceTransaction`). Tajmer odgode
+ * "Odlazak" scene je u točku tajmera (`Scene_LeavingDelayExpired`).
  ******************************************************************************
  */
 void Scene_Service(void)
 {
-    // Prolazimo kroz sve scene da provjerimo da li neka ima aktivan tajmer
-    for (uint8_t i = 0; i < SCENE_MAX_COUNT; i++)
-    {
-        // Provjeravamo runtime stanje svake scene
-        switch (scene_runtime_data[i].runtime_state)
-        {
-            case SCENE_RUNTIME_STATE_LEAVING_DELAY:
-            {
-                Scene_t* target_scene = &scenes[i];
-                uint32_t delay_ms = (uint32_t)target_scene->exit_delay_s * 10000UL; // Vrijednost iz menija (npr. 6) * 10s
-
-                // Provjera da li je vrijeme odgode isteklo
-                if ((HAL_GetTick() - scene_runtime_data[i].timer_start) >= delay_ms)
-                {
-                    // Vrijeme je isteklo, izvrši "comfort" akcije (ugasi svjetla, itd.)
-                    Scene_ExecuteComfortActions(i);
-                    
-                    // Pošalji broadcast poruku da je pokrenut "Odlazak" događaj
-                    // TODO: Pozvati AddCommand za slanje SCENE_CONTROL poruke tipa SCENE_TYPE_LEAVING
-
-                    // Postavi globalno stanje sistema na "Away"
-                    Scene_SetSystemState(SYSTEM_STATE_AWAY_ACTIVE);
-                    
-                    // Vrati runtime stanje scene na IDLE
-                    scene_runtime_data[i].runtime_state = SCENE_RUNTIME_STATE_IDLE;
-                    scene_runtime_data[i].timer_start = 0;
-                }
-                break;
-            }
-
-            case SCENE_RUNTIME_STATE_IDLE:
-            default:
-                // Scena je neaktivna, ne radi ništa.
-                break;
-        }
-    }
+    Scene_ServiceTransaction();
 
     // --- Logika za Simulaciju Prisustva ---
     if (Scene_GetSystemState() == SYSTEM_STATE_AWAY_ACTIVE)
@@ -152,84 +200,66 @@ void Scene_Service(void)
  ******************************************************************************
  * @brief       Inicijalizuje modul za scene pri pokretanju sistema.
  * @author      Gemini & [Vaše Ime]
- * @note        Učitava kompletan blok podataka za sve scene iz EEPROM-a. Vrši
- * provjeru validnosti podataka pomoću magičnog broja i CRC-a. Ako
- * podaci nisu validni (npr. prvo pokretanje ili oštećeni podaci),
- * poziva `Scene_SetDefault()` da kreira jednu, defaultnu,
- * nekonfigurisanu scenu i odmah je snima u EEPROM.
+ * @note        Učitava zapis svake scene iz EEPROM-a i provjerava ga pomoću
+ * magičnog broja i CRC-a. Scena čiji zapis nije validan (npr. prvo
+ * pokretanje ili oštećeni podaci) postaje prazna, nekonfigurisana
+ * scena (`Scene_SetDefault()`) i odmah se snima u EEPROM.
  * @param       None
  * @retval      None
  ******************************************************************************
  */
 void Scene_Init(void)
 {
-    // KORISTIMO DIREKTNO DEFINISANI TIP IZ scene.h
-    Scene_EepromBlock_t eeprom_block;
-
-    // Učitaj cijeli blok iz EEPROM-a
-    EE_ReadBuffer((uint8_t*)&eeprom_block, EE_SCENES, sizeof(Scene_EepromBlock_t));
+    // Nizovi su u UNINIT SDRAM-u
+    memset(scenes, 0, sizeof(scenes));
+    memset(scene_runtime_data, 0, sizeof(scene_runtime_data));
 
-    // Provjeri validnost podataka
-    if (eeprom_block.magic_number != EEPROM_MAGIC_NUMBER)
-    {
-        // Podaci nisu validni (npr. prvo pokretanje), postavi defaultne vrijednosti
-        Scene_SetDefault();
-        Scene_Save(); // Odmah snimi ispravne defaultne vrijednosti u EEPROM
-    }
-    else
+    for (uint8_t i = 0; i < SCENE_MAX_COUNT; i++)
     {
-        uint16_t received_crc = eeprom_block.crc;
-        eeprom_block.crc = 0;
-        // Koristimo sizeof(Scene_EepromBlock_t) za tačan proračun
-        uint16_t calculated_crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&eeprom_block, sizeof(Scene_EepromBlock_t));
+        EE_ReadBuffer((uint8_t*)&scene_record, EE_SCENE_RECORD(i), sizeof(Scene_EepromRecord_t));
 
-        if (received_crc != calculated_crc)
+        uint16_t received_crc = scene_record.crc;
+        scene_record.crc = 0;
+        if ((scene_record.magic_number == EEPROM_MAGIC_NUMBER) &&
+            (received_crc == (uint16_t)HAL_CRC_Calculate(&hcrc, (uint32_t*)&scene_record, sizeof(Scene_EepromRecord_t))))
         {
-            // Podaci su oštećeni (CRC se ne poklapa), postavi defaultne vrijednosti
-            Scene_SetDefault();
-            Scene_Save();
+            // Zapis je validan, prekopiraj ga u radnu memoriju (RAM)
+            memcpy(&scenes[i], &scene_record.scene, sizeof(Scene_t));
+            scene_saved_crc[i] = received_crc;
         }
         else
         {
-            // Podaci su validni, prekopiraj ih u radnu memoriju (RAM)
-            memcpy(scenes, eeprom_block.scenes, sizeof(scenes));
+            // Zapis nije validan, scena postaje prazna i odmah se snima
+            Scene_SetDefault(i);
+            scene_saved_crc[i] = (uint16_t)~Scene_PackRecord(i);
         }
     }
+    Scene_Save();
 }
 
 /**
  ******************************************************************************
- * @brief       Snima trenutno stanje svih scena iz RAM-a u EEPROM.
+ * @brief       Snima izmijenjene scene iz RAM-a u EEPROM.
  * @author      Gemini & [Vaše Ime]
  * @note        Ova funkcija se poziva nakon svake promjene u konfiguraciji
- * scena (npr. nakon poziva `Scene_Memorize`). Ona priprema kompletan
- * memorijski blok tako što u lokalnu `Scene_EepromBlock_t` strukturu
- * upiše magični broj, prekopira podatke iz `scenes` niza, izračuna
- * CRC32 nad cijelim blokom i na kraju ga atomarno upiše u EEPROM.
- * Ovaj proces osigurava integritet i validnost podataka.
+ * scena (npr. nakon poziva `Scene_Memorize`). Za svaku scenu priprema
+ * zapis (magični broj, scena, CRC) i upisuje ga samo ako se CRC
+ * razlikuje od posljednjeg upisanog, pa izmjena jedne scene ne
+ * prepisuje sve ostale.
  * @param       None
  * @retval      None
  ******************************************************************************
  */
 void Scene_Save(void)
 {
-    // Kreiraj lokalnu instancu strukture koja odgovara EEPROM bloku.
-    Scene_EepromBlock_t block_to_save;
-
-    // KORAK 1: Postavi "potpis" (magični broj) za validaciju.
-    block_to_save.magic_number = EEPROM_MAGIC_NUMBER;
-
-    // KORAK 2: Prekopiraj trenutno stanje svih scena iz RAM-a u strukturu za snimanje.
-    memcpy(block_to_save.scenes, scenes, sizeof(scenes));
-
-    // KORAK 3: Pripremi za izračunavanje CRC-a tako što se CRC polje postavi na 0.
-    block_to_save.crc = 0;
-
-    // KORAK 4: Izračunaj CRC nad cijelim blokom (magični broj + podaci o scenama).
-    block_to_save.crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&block_to_save, sizeof(Scene_EepromBlock_t));
+    for (uint8_t i = 0; i < SCENE_MAX_COUNT; i++)
+    {
+        uint16_t crc = Scene_PackRecord(i);
+        if (crc == scene_saved_crc[i]) continue;
 
-    // KORAK 5: Snimi kompletan, pripremljen blok u EEPROM u jednoj operaciji.
-    EE_WriteBuffer((uint8_t*)&block_to_save, EE_SCENES, sizeof(Scene_EepromBlock_t));
+        EE_WriteBuffer((uint8_t*)&scene_record, EE_SCENE_RECORD(i), sizeof(Scene_EepromRecord_t));
+        scene_saved_crc[i] = crc;
+    }
 }
 /**
  ******************************************************************************
@@ -237,7 +267,7 @@ void Scene_Save(void)
  * @author      Gemini & [Vaše Ime]
  * @note        Verzija 2.1: Prošireno da podržava asinhrono izvršavanje za scene
  * sa odgodom (npr. "Odlazak"). Za takve scene, ova funkcija samo
- * pokreće mašinu stanja, a `Scene_Service` izvršava stvarne akcije
+ * pokreće mašinu stanja, a `Scene_LeavingDelayExpired` izvršava stvarne akcije
  * nakon isteka tajmera. Za ostale scene, akcija je trenutna.
  ******************************************************************************
  */
@@ -265,8 +295,10 @@ void Scene_Activate(uint8_t scene_index)
             // Za scenu "Odlazak", ne izvršavamo akcije odmah.
             // Samo pokrećemo mašinu stanja i tajmer za odgodu.
             scene_runtime_data[scene_index].runtime_state = SCENE_RUNTIME_STATE_LEAVING_DELAY;
-            scene_runtime_data[scene_index].timer_start = HAL_GetTick();
-            // Stvarne akcije će izvršiti `Scene_Service` nakon isteka vremena.
+            TimerWheel_Start(&scene_runtime_data[scene_index].timer,
+                             (uint32_t)target_scene->exit_delay_s * 10000UL, // Vrijednost iz menija (npr. 6) * 10s
+                             Scene_LeavingDelayExpired, &scene_runtime_data[scene_index]);
+            // Stvarne akcije će izvršiti `Scene_LeavingDelayExpired` nakon isteka vremena.
             return; // Važno: Prekidamo izvršavanje ovdje!
 
         case SCENE_TYPE_HOMECOMING:
@@ -297,14 +329,45 @@ void Scene_Activate(uint8_t scene_index)
     // Izvršavanje "comfort" akcija za sve scene koje nisu prekinute (sve osim LEAVING)
     Scene_ExecuteComfortActions(scene_index);
 }
+/**
+ ******************************************************************************
+ * @brief       Istek odgode "Odlazak" scene.
+ * @author      Gemini & [Vaše Ime]
+ * @note        Poziva ga `TimerWheel_Service()` kada istekne `exit_delay_s`
+ * pokrenut u `Scene_Activate`.
+ * @param       arg Pokazivač na runtime podatke scene u `scene_runtime_data`.
+ ******************************************************************************
+ */
+static void Scene_LeavingDelayExpired(void* arg)
+{
+    Scene_Runtime_t* runtime = (Scene_Runtime_t*)arg;
+    uint8_t scene_index = (uint8_t)(runtime - scene_runtime_data);
+
+    if (runtime->runtime_state != SCENE_RUNTIME_STATE_LEAVING_DELAY) return;
+
+    // Vrijeme je isteklo, izvrši "comfort" akcije (ugasi svjetla, itd.)
+    Scene_ExecuteComfortActions(scene_index);
+
+    // Pošalji broadcast poruku da je pokrenut "Odlazak" događaj
+    // TODO: Pozvati AddCommand za slanje SCENE_CONTROL poruke tipa SCENE_TYPE_LEAVING
+
+    // Postavi globalno stanje sistema na "Away"
+    Scene_SetSystemState(SYSTEM_STATE_AWAY_ACTIVE);
+
+    // Vrati runtime stanje scene na IDLE
+    runtime->runtime_state = SCENE_RUNTIME_STATE_IDLE;
+}
 /**
  ******************************************************************************
  * @brief       Izvršava "comfort" akcije za datu scenu.
  * @author      Gemini & [Vaše Ime]
- * @note        Ova pomoćna funkcija sadrži logiku za postavljanje stanja
+ * @note        Ova pomoćna funkcija pokreće transakciju za postavljanje stanja
  * svjetala, roletni i termostata na osnovu memorisanih vrijednosti
- * u strukturi scene. Kreirana je da bi se izbjeglo dupliranje koda
- * između `Scene_Activate` i `Scene_Service` funkcija.
+ * u strukturi scene. U plan ulaze samo uređaji čije se trenutno stanje
+ * razlikuje od memorisanog; prvi se primjenjuju odmah, a ostale
+ * primjenjuje `Scene_Service`. Nova aktivacija prekida nezavršenu
+ * transakciju (prekinuta aktivacija se ne broji). Poziva se iz
+ * `Scene_Activate` i `Scene_LeavingDelayExpired`.
  * @param       scene_index Indeks scene (0-5) čije akcije treba izvršiti.
  ******************************************************************************
  */
@@ -312,44 +375,65 @@ static void Scene_ExecuteComfortActions(uint8_t scene_index)
 {
     if (scene_index >= SCENE_MAX_COUNT) return;
     Scene_t* target_scene = &scenes[scene_index];
+    Scene_ApplyStats_t* stats = &scene_runtime_data[scene_index].apply;
+    uint8_t skipped = 0;
+
+    if ((transaction.scene_index >= 0) && (transaction.scene_index != (int8_t)scene_index)) {
+        scene_runtime_data[transaction.scene_index].apply.state = SCENE_APPLY_IDLE;
+    }
+    transaction.count = 0;
+    transaction.next = 0;
 
-    // Postavljanje stanja za SVJETLA
+    // Plan za SVJETLA
     for (uint8_t i = 0; i < LIGHTS_MODBUS_SIZE; i++)
     {
-        if (target_scene->lights_mask & (1 << i))
-        {
-            LIGHT_Handle* light_handle = LIGHTS_GetInstance(i);
-            if (light_handle)
-            {
-                LIGHT_SetState(light_handle, target_scene->light_values[i]);
-                LIGHT_SetBrightness(light_handle, target_scene->light_brightness[i]);
-                LIGHT_SetColor(light_handle, target_scene->light_colors[i]);
-            }
+        if (!(target_scene->lights_mask & (1UL << i))) continue;
+        LIGHT_Handle* light_handle = LIGHTS_GetInstance(i);
+        if (!light_handle || (LIGHT_GetRelay(light_handle) == 0)) continue;
+
+        if (Scene_LightDiffers(target_scene, i)) {
+            transaction.step[transaction.count++] = (Scene_Step_t){ SCENE_STEP_LIGHT, i };
+        } else {
+            skipped++;
         }
     }
 
-    // Postavljanje stanja za ROLETNE
+    // Plan za ROLETNE
     for (uint8_t i = 0; i < CURTAINS_SIZE; i++)
     {
-        if (target_scene->curtains_mask & (1 << i))
-        {
-            Curtain_Handle* curtain_handle = Curtain_GetInstanceByIndex(i);
-            if (curtain_handle)
-            {
-                Curtain_Move(curtain_handle, target_scene->curtain_states[i]);
-            }
+        if (!(target_scene->curtains_mask & (1UL << i))) continue;
+        Curtain_Handle* curtain_handle = Curtain_GetInstanceByIndex(i);
+        if (!curtain_handle || !Curtain_hasRelays(curtain_handle)) continue;
+
+        if (Curtain_getNewDirection(curtain_handle) != target_scene->curtain_states[i]) {
+            transaction.step[transaction.count++] = (Scene_Step_t){ SCENE_STEP_CURTAIN, i };
+        } else {
+            skipped++;
         }
     }
 
-    // Postavljanje stanja za TERMOSTAT
-    if (target_scene->thermostat_mask)
+    // Plan za TERMOSTAT
+    THERMOSTAT_TypeDef* thst_handle = Thermostat_GetInstance();
+    if (target_scene->thermostat_mask && thst_handle)
     {
-        THERMOSTAT_TypeDef* thst_handle = Thermostat_GetInstance();
-        if (thst_handle)
-        {
-            Thermostat_SP_Temp_Set(thst_handle, target_scene->thermostat_setpoint);
+        if (Thermostat_GetSetpoint(thst_handle) != target_scene->thermostat_setpoint) {
+            transaction.step[transaction.count++] = (Scene_Step_t){ SCENE_STEP_THERMOSTAT, 0 };
+        } else {
+            skipped++;
         }
     }
+
+    transaction.scene_index = (int8_t)scene_index;
+    transaction.start_tick = HAL_GetTick();
+    transaction.last_step_tick = transaction.start_tick;
+    transaction.commands = *GetCommandStats();
+    stats->state = SCENE_APPLY_RUNNING;
+    stats->devices = transaction.count;
+    stats->skipped = skipped;
+    last_activated = (int8_t)scene_index;
+    if (screen == SCREEN_SCENE) shouldDrawScreen = 1;
+
+    Scene_ServiceTransaction();
 }
 /**
  ******************************************************************************
@@ -388,7 +472,7 @@ void Scene_Memorize(uint8_t scene_index)
         if (light_handle && LIGHT_GetRelay(light_handle) != 0) // Provjera da li je svjetlo konfigurisano
         {
             // Postavi odgovarajući bit u maski
-            target_scene->lights_mask |= (1 << i);
+            target_scene->lights_mask |= (1UL << i);
             
             // Sačuvaj trenutne vrijednosti koristeći API funkcije
             target_scene->light_values[i] = LIGHT_isActive(light_handle);
@@ -404,7 +488,7 @@ void Scene_Memorize(uint8_t scene_index)
         if (curtain_handle && Curtain_hasRelays(curtain_handle)) // Provjera da li je roletna konfigurisana
         {
             // Postavi odgovarajući bit u maski
-            target_scene->curtains_mask |= (1 << i);
+            target_scene->curtains_mask |= (1UL << i);
             
             // Sačuvaj trenutno stanje (STOP, UP, ili DOWN)
             target_scene->curtain_states[i] = Curtain_getNewDirection(curtain_handle);
@@ -504,25 +588,203 @@ SystemState_e Scene_GetSystemState(void)
     return system_state;
 }
 
+/**
+ ******************************************************************************
+ * @brief       Vraća ishod i mjerenja aktivacija odabrane scene.
+ * @author      Gemini & [Vaše Ime]
+ * @note        `state` je `SCENE_APPLY_DONE` tek kada su sve komande scene
+ * poslane i potvrđene. `dropped` i `unacked` su brojači `rs485` za
+ * vrijeme transakcija scene, pa uključuju i komande drugih modula
+ * poslane u istom periodu.
+ * @param       scene_index Indeks scene (0-5).
+ * @retval      const Scene_ApplyStats_t* Mjerenja, ili NULL ako je indeks neispravan.
+ ******************************************************************************
+ */
+const Scene_ApplyStats_t* Scene_GetApplyStats(uint8_t scene_index)
+{
+    return (scene_index < SCENE_MAX_COUNT) ? &scene_runtime_data[scene_index].apply : NULL;
+}
+
+/**
+ ******************************************************************************
+ * @brief       Vraća indeks posljednje aktivirane scene.
+ * @author      Gemini & [Vaše Ime]
+ * @retval      int8_t Indeks scene (0-5), ili -1 ako nijedna nije aktivirana.
+ ******************************************************************************
+ */
+int8_t Scene_GetLastActivated(void)
+{
+    return last_activated;
+}
+
 
 /*============================================================================*/
 /* IMPLEMENTACIJA PRIVATNIH FUNKCIJA                                          */
 /*============================================================================*/
 
 /**
- * @brief  Postavlja scene na početno, fabričko stanje.
- * @note   Poziva se iz `Scene_Init()` kada podaci u EEPROM-u nisu validni.
- * Briše sve postojeće podatke i kreira jednu, defaultnu scenu koja
- * je označena kao nekonfigurisana (`is_configured = false`).
- * @param  None
+ * @brief  Postavlja scenu na početno, fabričko stanje.
+ * @note   Poziva se iz `Scene_Init()` kada zapis scene u EEPROM-u nije
+ * validan. Briše podatke scene i označava je kao nekonfigurisanu
+ * (`is_configured = false`).
+ * @param  scene_index Indeks scene.
  * @retval None
  */
-static void Scene_SetDefault(void)
+static void Scene_SetDefault(uint8_t scene_index)
 {
-    // Prvo obriši kompletan niz scena u RAM-u
-    memset(scenes, 0, sizeof(scenes));
+    memset(&scenes[scene_index], 0, sizeof(Scene_t));
+
+    scenes[scene_index].appearance_id = 0; // Pretpostavka da je ID=0 za "Wizzard" ili "Add" ikonicu
+    scenes[scene_index].is_configured = false; // Ključni fleg za UI logiku
+}
+
+/**
+ * @brief  Priprema `scene_record` za upis scene u EEPROM.
+ * @param  scene_index Indeks scene.
+ * @retval uint16_t CRC zapisa (upisan je i u `scene_record.crc`).
+ */
+static uint16_t Scene_PackRecord(uint8_t scene_index)
+{
+    scene_record.magic_number = EEPROM_MAGIC_NUMBER;
+    memcpy(&scene_record.scene, &scenes[scene_index], sizeof(Scene_t));
+    scene_record.crc = 0;
+    scene_record.crc = (uint16_t)HAL_CRC_Calculate(&hcrc, (uint32_t*)&scene_record, sizeof(Scene_EepromRecord_t));
+    return scene_record.crc;
+}
+
+/**
+ * @brief  Provjerava da li se svjetlo razlikuje od stanja memorisanog u sceni.
+ * @note   Poredi samo atribute koje tip svjetla šalje na bus: stanje za
+ * binarna, stanje i svjetlinu za dimere, stanje i boju za RGB svjetla.
+ * Upaljen dimer sa memorisanom svjetlinom 0 se pali na 100 %, kao u
+ * `LIGHT_SetState`.
+ * @param  scene Scena.
+ * @param  i     Indeks svjetla.
+ * @retval bool  `true` ako svjetlo treba promijeniti.
+ */
+static bool Scene_LightDiffers(const Scene_t* scene, uint8_t i)
+{
+    LIGHT_Handle* handle = LIGHTS_GetInstance(i);
+    bool on = (scene->light_values[i] != 0);
+
+    if (LIGHT_isActive(handle) != on) return true;
+    if (on && LIGHT_isDimmer(handle)) {
+        uint8_t brightness = scene->light_brightness[i] ? scene->light_brightness[i] : 100;
+        return LIGHT_GetBrightness(handle) != brightness;
+    }
+    if (LIGHT_isRGB(handle)) return LIGHT_GetColor(handle) != scene->light_colors[i];
+    return false;
+}
+
+/**
+ * @brief  Postavlja jedan uređaj iz plana na stanje iz scene.
+ * @note   Koristi samo setere potrebne za tip uređaja, pa detekcija promjene
+ * u servisu uređaja šalje najmanji skup komandi (npr. jedan `DIMMER_SET`
+ * sa novom svjetlinom umjesto posebnih komandi za stanje i svjetlinu).
+ * @param  scene Scena.
+ * @param  step  Korak plana.
+ */
+static void Scene_ApplyStep(const Scene_t* scene, const Scene_Step_t* step)
+{
+    switch (step->kind)
+    {
+        case SCENE_STEP_LIGHT:
+        {
+            LIGHT_Handle* handle = LIGHTS_GetInstance(step->index);
+            bool on = (scene->light_values[step->index] != 0);
+
+            if (LIGHT_isDimmer(handle) && on) {
+                uint8_t brightness = scene->light_brightness[step->index] ? scene->light_brightness[step->index] : 100;
+                if (!LIGHT_isActive(handle)) LIGHT_SetState(handle, true);
+                LIGHT_SetBrightness(handle, brightness);
+            } else if (LIGHT_isActive(handle) != on) {
+                LIGHT_SetState(handle, on);
+            }
+            if (LIGHT_isRGB(handle)) LIGHT_SetColor(handle, scene->light_colors[step->index]);
+            break;
+        }
+        case SCENE_STEP_CURTAIN:
+        {
+            Curtain_Handle* handle = Curtain_GetInstanceByIndex(step->index);
+            if (scene->curtain_states[step->index] == CURTAIN_STOP) Curtain_Stop(handle);
+            else Curtain_Move(handle, scene->curtain_states[step->index]);
+            break;
+        }
+        case SCENE_STEP_THERMOSTAT:
+        default:
+            Thermostat_SP_Temp_Set(Thermostat_GetInstance(), scene->thermostat_setpoint);
+            break;
+    }
+}
+
+/**
+ * @brief  Provjerava da li su svi redovi komandi koje pune svjetla, roletne i
+ * termostat ispod granice.
+ * @param  limit Najveći dozvoljeni broj komandi u redu (0 = red mora biti prazan).
+ */
+static bool Scene_QueuesBelow(uint8_t limit)
+{
+    return (binaryQueue.count <= limit) && (dimmerQueue.count <= limit) &&
+           (rgbwQueue.count <= limit) && (curtainQueue.count <= limit) &&
+           (thermoQueue.count <= limit);
+}
+
+/**
+ * @brief  Nastavlja aktivnu transakciju: primjenjuje sljedeće uređaje i
+ * provjerava da li je scena završena.
+ * @note   Poziva se iz `Scene_Service` i pri pokretanju transakcije.
+ */
+static void Scene_ServiceTransaction(void)
+{
+    if (transaction.scene_index < 0) return;
+
+    const Scene_t* scene = &scenes[transaction.scene_index];
+    uint32_t now = HAL_GetTick();
+
+    for (uint8_t n = 0; (n < SCENE_STEPS_PER_PASS) && (transaction.next < transaction.count); n++)
+    {
+        if (!Scene_QueuesBelow(SCENE_QUEUE_LIMIT)) break;
+        Scene_ApplyStep(scene, &transaction.step[transaction.next++]);
+        transaction.last_step_tick = now;
+    }
+
+    if ((now - transaction.start_tick) >= SCENE_APPLY_TIMEOUT_MS) {
+        Scene_FinishTransaction(true);
+        return;
+    }
+    if (transaction.next < transaction.count) return;
+    if ((transaction.count != 0) && ((now - transaction.last_step_tick) < SCENE_SETTLE_MS)) return;
+    if (!Scene_QueuesBelow(0)) return;
+
+    Scene_FinishTransaction(false);
+}
+
+/**
+ * @brief  Završava transakciju i upisuje ishod i mjerenja scene.
+ * @param  timed_out `true` ako scena nije primijenjena za `SCENE_APPLY_TIMEOUT_MS`.
+ */
+static void Scene_FinishTransaction(bool timed_out)
+{
+    Scene_ApplyStats_t* stats = &scene_runtime_data[transaction.scene_index].apply;
+    const CommandStats* now = GetCommandStats();
+    uint32_t dropped = now->dropped - transaction.commands.dropped;
+    uint32_t unacked = now->failed - transaction.commands.failed;
+
+    stats->last_ms = HAL_GetTick() - transaction.start_tick;
+    if (stats->last_ms > stats->max_ms) stats->max_ms = stats->last_ms;
+    stats->commands = (uint16_t)(now->sent - transaction.commands.sent);
+    stats->dropped += dropped;
+    stats->unacked += unacked;
+    stats->activations++;
+    if (timed_out || dropped || unacked) {
+        stats->state = SCENE_APPLY_FAILED;
+        stats->failures++;
+    } else {
+        stats->state = SCENE_APPLY_DONE;
+    }
+    EventLog_Write(EVLOG_SCENE, (uint8_t)transaction.scene_index, stats->commands |
+                   (((dropped + unacked) & 0x7FFFU) << 16) | ((stats->state == SCENE_APPLY_FAILED) ? (1UL << 31) : 0U));
 
-    // Konfiguriši prvu scenu kao defaultnu
-    scenes[0].appearance_id = 0; // Pretpostavka da je ID=0 za "Wizzard" ili "Add" ikonicu
-    scenes[0].is_configured = false; // Ključni fleg za UI logiku
+    transaction.scene_index = -1;
+    if (screen == SCREEN_SCENE) shouldDrawScreen = 1;
 }
@@ -0,0 +1,356 @@
+/**
+ ******************************************************************************
+ * @file    scheduler.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija kooperativnog planera servisa glavne petlje.
+ *
+ * @note    Jedan poziv `Sched_Run` je jedan prolaz kroz tabelu zadataka.
+ * Zadatak se izvršava ako mu je istekao period ili ako je od prošlog
+ * prolaza podignut događaj iz njegove maske. Periodični rok se pomjera za
+ * tačno jedan period, pa se kašnjenje ne nagomilava; ako zadatak zakasni
+ * više od cijelog perioda, propušteni periodi se broje i rok se poravnava
+ * na trenutno vrijeme. Prolaz u kojem ništa nije izvršeno završava se
+ * spavanjem na `__WFI` sa zabranjenim prekidima, tako da događaj koji
+ * stigne između provjere i spavanja odmah budi procesor. Trajanje
+ * izvršavanja i vrijeme spavanja mjere se DWT brojačem (`Profiler_Init`).
+ * Prije svakog zadatka se u RAM-u pamti koji se zadatak izvršava, a
+ * kraj prolaza javlja `Watchdog_Kick`; ako prolaz predugo traje, SysTick
+ * upisuje zadatak u RTC backup registar, pa log nakon IWDG reseta
+ * pokazuje zadatak koji je zaglavio.
+ ******************************************************************************
+ */
+
+#if (__SCHEDULER_H__ != FW_BUILD)
+#error "scheduler header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "trace.h"
+#include "watchdog.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define SCHED_TASKS_PER_PAGE            6U      ///< Broj zapisa zadataka u jednom RS485 odgovoru
+#define SCHED_TASK_RECORD_SIZE          19U     ///< Veličina zapisa zadatka u bajtima
+#define SCHED_SUMMARY_RECORD_SIZE       18U     ///< Veličina zbirnog zapisa u bajtima
+#define SCHED_HEADER_SIZE               4U      ///< subcmd, stranica, ukupno, broj zapisa (kao profiler)
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static Sched_Task_t* task_table;
+static uint8_t task_count;
+static volatile uint32_t sched_events;  ///< Događaji podignuti od posljednjeg prolaza
+
+static uint32_t pass_start;             ///< CYCCNT na početku posljednjeg prolaza
+static uint64_t total_cycles;           ///< Ukupno vrijeme od `Sched_ResetStats`
+static uint64_t idle_cycles;            ///< Od toga provedeno na `__WFI`
+static uint32_t passes;                 ///< Broj prolaza kroz tabelu
+static uint32_t sleeps;                 ///< Broj spavanja na `__WFI`
+static uint32_t event_passes;           ///< Prolaza sa bar jednim podignutim događajem
+static uint32_t pass_max;               ///< Najduži prolaz (razmak između osvježavanja IWDG-a)
+static uint32_t pass_tick;              ///< `HAL_GetTick()` na početku prolaza (za dugačke prolaze)
+static volatile bool reset_request;     ///< `DIAG_SCHED_RESET` iz prekida, briše se na početku prolaza
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static uint8_t* Sched_Put16(uint8_t* p, uint32_t value)
+{
+    uint16_t v = (value > 0xFFFFU) ? 0xFFFFU : (uint16_t)value;
+    *p++ = (uint8_t)(v >> 8);
+    *p++ = (uint8_t)(v & 0xFFU);
+    return p;
+}
+
+static uint8_t* Sched_Put32(uint8_t* p, uint32_t value)
+{
+    *p++ = (uint8_t)(value >> 24);
+    *p++ = (uint8_t)(value >> 16);
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = (uint8_t)(value & 0xFFU);
+    return p;
+}
+
+/**
+ * @brief Uzima i briše sve podignute događaje.
+ */
+static uint32_t Sched_TakeEvents(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t evt;
+
+    __disable_irq();
+    evt = sched_events;
+    sched_events = 0U;
+    __set_PRIMASK(primask);
+    return evt;
+}
+
+/**
+ * @brief Izvršava jedan zadatak i ažurira njegovu statistiku.
+ */
+static void Sched_Execute(uint8_t index, bool due)
+{
+    Sched_Task_t* t = &task_table[index];
+    uint32_t now = HAL_GetTick();
+    uint32_t start, cycles;
+
+    if (due)
+    {
+        uint32_t late = now - t->next_due;
+        if (late > t->late_max) t->late_max = late;
+        t->next_due += t->period;
+        if ((int32_t)(now - t->next_due) >= 0)
+        {
+            t->skipped += ((now - t->next_due) / t->period) + 1U;
+            t->next_due = now + t->period;
+        }
+    }
+    else
+    {
+        t->event_runs++;
+    }
+
+    Watchdog_Mark((uint8_t)(index + 1U));
+    TRACE_ENTER(TRACE_ID_TASK + index);
+    start = Profiler_Cycles();
+    t->fn();
+    cycles = Profiler_Cycles() - start;
+    TRACE_EXIT(TRACE_ID_TASK + index);
+
+    t->runs++;
+    t->exec_cycles += cycles;
+    if (cycles < t->exec_min) t->exec_min = cycles;
+    if (cycles > t->exec_max) t->exec_max = cycles;
+    if ((t->budget_cycles != 0U) && (cycles > t->budget_cycles))
+    {
+        t->overruns++;
+        Watchdog_TaskOverrun(index, Profiler_CyclesToUs(cycles));
+    }
+}
+
+/**
+ * @brief Spava do sljedećeg prekida ako u međuvremenu nije stigao događaj
+ * niti je otkucala nova milisekunda (tada je neki rok možda istekao).
+ */
+static void Sched_Idle(uint32_t tick)
+{
+    uint32_t start;
+
+    __disable_irq();
+    if ((sched_events == 0U) && (HAL_GetTick() == tick))
+    {
+        start = Profiler_Cycles();
+        __DSB();
+        __WFI();
+        idle_cycles += Profiler_Cycles() - start;
+        sleeps++;
+    }
+    __enable_irq();
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Postavlja tabelu zadataka; svi periodični zadaci su odmah na redu.
+ * @param tasks Tabela zadataka, mora postojati do kraja rada.
+ * @param count Broj zadataka u tabeli.
+ */
+void Sched_Init(Sched_Task_t* tasks, uint8_t count)
+{
+    uint32_t now = HAL_GetTick();
+
+    task_table = tasks;
+    task_count = count;
+    for (uint8_t i = 0U; i < task_count; i++)
+    {
+        task_table[i].next_due = now;
+        task_table[i].budget_cycles = task_table[i].budget * (SystemCoreClock / 1000000U);
+    }
+    sched_events = 0U;
+    pass_tick = now;
+    Watchdog_Mark(WATCHDOG_MARK_SCHED);
+    Watchdog_Kick();
+    // Debager ostaje povezan dok procesor spava na __WFI
+    HAL_DBGMCU_EnableDBGSleepMode();
+    Sched_ResetStats();
+}
+
+/**
+ * @brief Jedan prolaz planera: izvršava spremne zadatke ili spava.
+ * @note  Poziva se iz `while(1)` petlje u `main()`. Na početku prolaza
+ * izvršava brisanje statistike zatraženo sa `DIAG_SCHED_RESET`.
+ */
+void Sched_Run(void)
+{
+    uint32_t tick = HAL_GetTick();
+    uint32_t evt = Sched_TakeEvents();
+    uint32_t now, elapsed;
+    bool ran = false;
+
+    if (reset_request) {
+        reset_request = false;
+        Sched_ResetStats();
+    }
+    passes++;
+    if (evt != 0U) event_passes++;
+
+    for (uint8_t i = 0U; i < task_count; i++)
+    {
+        Sched_Task_t* t = &task_table[i];
+        bool due = (t->period != 0U) && ((int32_t)(HAL_GetTick() - t->next_due) >= 0);
+
+        if (due || ((evt & t->events) != 0U))
+        {
+            Sched_Execute(i, due);
+            ran = true;
+        }
+    }
+    if (ran) Watchdog_Mark(WATCHDOG_MARK_SCHED);
+    else Sched_Idle(tick);
+
+    // DWT se prelije nakon 20 s, pa se prolaz uporediv sa IWDG periodom mjeri u ms
+    elapsed = HAL_GetTick() - pass_tick;
+    if (elapsed > WATCHDOG_PASS_WARN_MS) Watchdog_PassOverrun(elapsed);
+    pass_tick += elapsed;
+    Watchdog_Kick();
+    now = Profiler_Cycles();
+    if ((now - pass_start) > pass_max) pass_max = now - pass_start;
+    total_cycles += now - pass_start;
+    pass_start = now;
+}
+
+/**
+ * @brief Podiže jedan ili više `SCHED_EVT_xxx` događaja.
+ * @note  Sigurno za poziv iz prekida i iz glavne petlje.
+ */
+void Sched_SetEvent(uint32_t events)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    sched_events |= events;
+    __set_PRIMASK(primask);
+}
+
+uint8_t Sched_GetTaskCount(void)
+{
+    return task_count;
+}
+
+const Sched_Task_t* Sched_GetTask(uint8_t index)
+{
+    return (index < task_count) ? &task_table[index] : NULL;
+}
+
+/**
+ * @brief Opterećenje procesora u promilima od posljednjeg brisanja statistike.
+ */
+uint16_t Sched_GetLoadPermille(void)
+{
+    if (total_cycles == 0U) return 0U;
+    return (uint16_t)(1000U - ((idle_cycles * 1000U) / total_cycles));
+}
+
+/**
+ * @brief Briše statistiku zadataka i mjerenje opterećenja; rokovi ostaju.
+ */
+void Sched_ResetStats(void)
+{
+    for (uint8_t i = 0U; i < task_count; i++)
+    {
+        Sched_Task_t* t = &task_table[i];
+        t->runs = 0U;
+        t->event_runs = 0U;
+        t->late_max = 0U;
+        t->skipped = 0U;
+        t->exec_cycles = 0U;
+        t->exec_min = UINT32_MAX;
+        t->exec_max = 0U;
+        t->overruns = 0U;
+    }
+    pass_start = Profiler_Cycles();
+    total_cycles = 0U;
+    idle_cycles = 0U;
+    passes = 0U;
+    sleeps = 0U;
+    event_passes = 0U;
+    pass_max = 0U;
+}
+
+/**
+ * @brief Pakuje statistiku planera u odgovor na `DIAG_GET`.
+ * @param subcmd `DIAG_SCHED_TASKS`, `DIAG_SCHED_SUMMARY` ili `DIAG_SCHED_RESET`.
+ * @param page   Stranica zapisa za `DIAG_SCHED_TASKS`.
+ * @param buf    Bafer za odgovor.
+ * @param size   Veličina bafera.
+ * @retval Dužina odgovora, 0 za nepoznatu pod-komandu.
+ * @note  Zaglavlje je isto kao kod profilera. Zapis zadatka: indeks,
+ * period (ms), broj izvršavanja (32 bita), izvršavanja na događaj,
+ * najveće kašnjenje (ms), propušteni periodi, najkraće, prosječno i
+ * najduže trajanje (us). Zbirni zapis: opterećenje (promili), broj
+ * prolaza, spavanja i prolaza sa događajem, najduži prolaz (us, 32 bita).
+ * 16-bitne vrijednosti su zasićene na 65535.
+ */
+uint16_t Sched_Serialize(uint8_t subcmd, uint8_t page, uint8_t* buf, uint16_t size)
+{
+    uint8_t* p = buf + SCHED_HEADER_SIZE;
+    uint8_t total = 0U, n = 0U;
+
+    if (size < SCHED_HEADER_SIZE) return 0U;
+
+    switch (subcmd)
+    {
+    case DIAG_SCHED_TASKS:
+        total = task_count;
+        for (uint16_t i = (uint16_t)page * SCHED_TASKS_PER_PAGE; (i < task_count) && (n < SCHED_TASKS_PER_PAGE); i++)
+        {
+            const Sched_Task_t* t = &task_table[i];
+            if ((uint16_t)(p - buf) + SCHED_TASK_RECORD_SIZE > size) break;
+            *p++ = (uint8_t)i;
+            p = Sched_Put16(p, t->period);
+            p = Sched_Put32(p, t->runs);
+            p = Sched_Put16(p, t->event_runs);
+            p = Sched_Put16(p, t->late_max);
+            p = Sched_Put16(p, t->skipped);
+            p = Sched_Put16(p, t->runs ? Profiler_CyclesToUs(t->exec_min) : 0U);
+            p = Sched_Put16(p, t->runs ? Profiler_CyclesToUs(t->exec_cycles / t->runs) : 0U);
+            p = Sched_Put16(p, Profiler_CyclesToUs(t->exec_max));
+            n++;
+        }
+        break;
+
+    case DIAG_SCHED_SUMMARY:
+        if (size < SCHED_HEADER_SIZE + SCHED_SUMMARY_RECORD_SIZE) return 0U;
+        total = 1U;
+        n = 1U;
+        p = Sched_Put16(p, Sched_GetLoadPermille());
+        p = Sched_Put32(p, passes);
+        p = Sched_Put32(p, sleeps);
+        p = Sched_Put32(p, event_passes);
+        p = Sched_Put32(p, Profiler_CyclesToUs(pass_max));
+        break;
+
+    case DIAG_SCHED_RESET:
+        reset_request = true;   // iz USART1 prekida: briše se na početku sljedećeg prolaza
+        break;
+
+    default:
+        return 0U;
+    }
+
+    buf[0] = subcmd;
+    buf[1] = page;
+    buf[2] = total;
+    buf[3] = n;
+    return (uint16_t)(p - buf);
+}
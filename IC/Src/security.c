@@ -22,6 +22,13 @@
 #include "security.h"
 #include "stm32746g_eeprom.h"
 #include "rs485.h"
+#include "devreg.h"
+#include "eventlog.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define SECURITY_SYSTEM_INDEX           SECURITY_PARTITION_COUNT    ///< Indeks pretplate za status sistema
 
 /*============================================================================*/
 /* PRIVATNE (STATIČKE) VARIJABLE                                              */
@@ -56,7 +63,8 @@ static const char* DEFAULT_PINS[SECURITY_USER_COUNT] = { "7891", "7892", "7893"
 /* PROTOTIPOVI PRIVATNIH POMOĆNIH FUNKCIJA                                    */
 /*============================================================================*/
 static void Execute_Command(uint8_t partition_index);
-static void HandleSensorEvent(uint16_t sensor_addr, uint8_t state);
+static void HandleSensorEvent(uint16_t index, uint16_t sensor_addr, const uint8_t* data, uint8_t len);
+static void Security_Subscribe(void);
 static void Security_Users_SetDefault(void);
 
 /*============================================================================*/
@@ -69,7 +77,7 @@ static void Security_Users_SetDefault(void);
  * @author      Gemini & [Vaše Ime]
  * @note        Funkcija učitava konfiguraciju iz EEPROM-a sa adrese `EE_SECURITY`,
  * provjerava njen integritet i postavlja fabričke vrijednosti ako je
- * to potrebno.
+ * to potrebno. Adrese feedback ulaza prijavljuje u registar uređaja.
  ******************************************************************************
  */
 void Security_Init(void)
@@ -88,6 +96,7 @@ void Security_Init(void)
             Security_Save();
         }
     }
+    DevReg_Register(Security_Subscribe);
     Security_RefreshState();
 }
 
@@ -132,6 +141,7 @@ void Security_SetDefault(void)
     for (int i = 0; i < SECURITY_PARTITION_COUNT; i++) {
         g_security_settings.partition_names[i][0] = '\0';
     }
+    DevReg_Rebuild();
 }
 
 // --- Geteri i Seteri za konfiguraciju alarma ---
@@ -187,6 +197,7 @@ uint16_t Security_GetPartitionFeedbackAddr(uint8_t p)
 void Security_SetPartitionFeedbackAddr(uint8_t p, uint16_t addr)
 {
     if (p < SECURITY_PARTITION_COUNT) g_security_settings.partition_feedback_addr[p] = addr;
+    DevReg_Rebuild();
 }
 
 /**
@@ -212,6 +223,7 @@ uint16_t Security_GetSystemStatusFeedbackAddr(void)
 void Security_SetSystemStatusFeedbackAddr(uint16_t addr)
 {
     g_security_settings.system_status_feedback_addr = addr;
+    DevReg_Rebuild();
 }
 
 /**
@@ -348,47 +360,23 @@ bool Security_GetSystemAlarmState(void)
     return system_is_in_alarm;
 }
 
-/**
- ******************************************************************************
- * @brief       Procesira događaj primljen sa RS485 bus-a.
- * @author      Gemini & [Vaše Ime]
- * @note        Ovu funkciju poziva isključivo `DIN_EVENT_Listener` iz `rs485.c`.
- * Brzo provjerava da li je adresa iz događaja relevantna za ovaj
- * modul i ako jeste, prosljeđuje ga na internu obradu.
- * @param       address Adresa izvora događaja.
- * @param       command Tip komande (očekuje se `DIN_EVENT`).
- * @param       data    Pokazivač na podatke iz poruke.
- * @param       len     Dužina podataka.
- ******************************************************************************
- */
-void SECURITY_BusEvent(uint16_t address, uint8_t command, uint8_t* data, uint8_t len)
-{
-    if (command != DIN_EVENT || address == 0) return;
-    bool is_relevant = false;
-    if (address == g_security_settings.system_status_feedback_addr) is_relevant = true;
-    else {
-        for (uint8_t i = 0; i < SECURITY_PARTITION_COUNT; i++) if (address == g_security_settings.partition_feedback_addr[i]) {
-                is_relevant = true;
-                break;
-            }
-    }
-    if (is_relevant) HandleSensorEvent(address, (len > 0) ? data[0] : 0);
-}
-
 /**
  ******************************************************************************
  * @brief       Eksplicitno osvježava sva interna stanja čitanjem sa bus-a.
  * @author      Gemini & [Vaše Ime]
- * @note        Koristi blokirajuću `GetState` funkciju sa `DIN_GET` komandom da
- * dohvati najsvježije podatke sa hardvera. Poziva je `display.c`
- * prije iscrtavanja kontrolnog ekrana.
+ * @note        Ne čeka odgovore: `DIN_GET` upiti za sve feedback ulaze idu u
+ * red `GetStateAsync`, a `rs485` ih šalje jedan za drugim iz glavne
+ * petlje. Svaki odgovor obrađuje `HandleSensorEvent`, kao `DIN_EVENT`,
+ * pa se ekran ponovo iscrtava čim stigne stanje koje se razlikuje od
+ * prikazanog. Upit koji je već na čekanju se ne ponavlja.
  ******************************************************************************
  */
 void Security_RefreshState(void)
 {
-    uint8_t response_data;
-    for(int i = 0; i < SECURITY_PARTITION_COUNT; ++i) if (g_security_settings.partition_feedback_addr[i] != 0 && GetState(DIN_GET, g_security_settings.partition_feedback_addr[i], &response_data)) partition_is_armed[i] = (response_data == 1);
-    if (g_security_settings.system_status_feedback_addr != 0 && GetState(DIN_GET, g_security_settings.system_status_feedback_addr, &response_data)) system_is_in_alarm = (response_data == 1);
+    for (uint8_t i = 0; i < SECURITY_PARTITION_COUNT; i++) {
+        GetStateAsync(DIN_GET, g_security_settings.partition_feedback_addr[i], HandleSensorEvent, i);
+    }
+    GetStateAsync(DIN_GET, g_security_settings.system_status_feedback_addr, HandleSensorEvent, SECURITY_SYSTEM_INDEX);
 }
 
 /**
@@ -473,29 +461,51 @@ bool Security_ValidateUserCode(const char* code)
  ******************************************************************************
  * @brief       Interna funkcija koja obrađuje promjenu stanja senzora.
  * @author      Gemini & [Vaše Ime]
- * @note        Ažurira `runtime` stanje (`partition_is_armed`, `system_is_in_alarm`)
- * i postavlja fleg za osvježavanje ekrana ako je potrebno.
+ * @note        `DevReg_Handler_t`; registar uređaja je poziva za `DIN_EVENT`
+ * sa prijavljenih feedback adresa, a `rs485` za odgovor na `DIN_GET`
+ * iz `Security_RefreshState`. Ažurira `runtime` stanje
+ * (`partition_is_armed`, `system_is_in_alarm`), upisuje promjenu u
+ * dnevnik događaja i postavlja fleg za osvježavanje ekrana ako je potrebno.
+ * @param       index       Indeks particije ili `SECURITY_SYSTEM_INDEX`.
  * @param       sensor_addr Adresa digitalnog ulaza koji je javio promjenu.
- * @param       state       Novo stanje ulaza (1 za ON, 0 za OFF).
+ * @param       data        `data[0]` je novo stanje ulaza (1 za ON, 0 za OFF).
+ * @param       len         Dužina `data`.
  ******************************************************************************
  */
-static void HandleSensorEvent(uint16_t sensor_addr, uint8_t state)
+static void HandleSensorEvent(uint16_t index, uint16_t sensor_addr, const uint8_t* data, uint8_t len)
 {
+    bool state = (len > 0) && (data[0] != 0);
     bool state_changed = false;
-    for(int i = 0; i < SECURITY_PARTITION_COUNT; ++i) if (g_security_settings.partition_feedback_addr[i] == sensor_addr) {
-            if (partition_is_armed[i] != (bool)state) {
-                partition_is_armed[i] = (bool)state;
-                state_changed = true;
-            }
-            break;
+    if (index < SECURITY_PARTITION_COUNT) {
+        if (partition_is_armed[index] != state) {
+            partition_is_armed[index] = state;
+            state_changed = true;
         }
-    if (g_security_settings.system_status_feedback_addr == sensor_addr) if (system_is_in_alarm != (bool)state) {
-            system_is_in_alarm = (bool)state;
+    } else if (index == SECURITY_SYSTEM_INDEX) {
+        if (system_is_in_alarm != state) {
+            system_is_in_alarm = state;
             state_changed = true;
         }
+    }
+    if (state_changed) EventLog_Write(EVLOG_SECURITY, (uint8_t)index, state);
     if (state_changed && (screen == SCREEN_SECURITY)) shouldDrawScreen = 1;
 }
 
+/**
+ ******************************************************************************
+ * @brief       Prijavljuje feedback ulaze particija i statusa sistema u registar.
+ * @author      Gemini & [Vaše Ime]
+ * @note        `DevReg_Builder_t`; poziva je `DevReg_Rebuild`.
+ ******************************************************************************
+ */
+static void Security_Subscribe(void)
+{
+    for (uint8_t i = 0; i < SECURITY_PARTITION_COUNT; i++) {
+        DevReg_Subscribe(DIN_EVENT, g_security_settings.partition_feedback_addr[i], HandleSensorEvent, i);
+    }
+    DevReg_Subscribe(DIN_EVENT, g_security_settings.system_status_feedback_addr, HandleSensorEvent, SECURITY_SYSTEM_INDEX);
+}
+
 /**
  ******************************************************************************
  * @brief       Interna funkcija koja formira i šalje komandu na RS485 bus.
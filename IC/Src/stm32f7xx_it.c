@@ -14,6 +14,8 @@
 #include "GUI.h"
 #include "main.h"
 #include "rs485.h"
+#include "trace.h"
+#include "watchdog.h"
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
@@ -24,6 +26,7 @@ extern TIM_HandleTypeDef htim3;
 extern UART_HandleTypeDef huart2;
 extern QSPI_HandleTypeDef hqspi;
 extern DMA2D_HandleTypeDef hdma2d;
+extern DMA_HandleTypeDef hdma_adc3;
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 void NMI_Handler(void) {
@@ -49,29 +52,62 @@ void DebugMon_Handler(void) {
 }
 
 void SysTick_Handler(void) {
+    TRACE_ENTER(TRACE_ID_SYSTICK);
     HAL_IncTick();
     OS_TimeMS++;
     RS485_Tick();
+    Watchdog_Tick();
+    TRACE_EXIT(TRACE_ID_SYSTICK);
 }
 
 void DMA2D_IRQHandler(void) {
+    TRACE_ENTER(TRACE_ID_DMA2D);
     HAL_DMA2D_IRQHandler(&hdma2d);
     DMA2D->IFCR = (U32)DMA2D_IFSR_CTCIF;
+    TRACE_EXIT(TRACE_ID_DMA2D);
 }
 
 void USART1_IRQHandler(void) {
+    TRACE_ENTER(TRACE_ID_USART1);
     HAL_UART_IRQHandler(&huart1);
+    TRACE_EXIT(TRACE_ID_USART1);
 }
 
 void USART2_IRQHandler(void) {
+    TRACE_ENTER(TRACE_ID_USART2);
     HAL_UART_IRQHandler(&huart2);
+    TRACE_EXIT(TRACE_ID_USART2);
 }
 
 void LTDC_IRQHandler(void) {
+    TRACE_ENTER(TRACE_ID_LTDC);
     HAL_LTDC_IRQHandler(&hltdc);
+    TRACE_EXIT(TRACE_ID_LTDC);
 }
 
+#if (TS_USE_INT_PIN != 0)
+void EXTI15_10_IRQHandler(void) {
+    TRACE_ENTER(TRACE_ID_EXTI_TOUCH);
+    HAL_GPIO_EXTI_IRQHandler(TS_INT_PIN);
+    TRACE_EXIT(TRACE_ID_EXTI_TOUCH);
+}
+#endif
+
 void QUADSPI_IRQHandler(void) {
+    TRACE_ENTER(TRACE_ID_QSPI);
     HAL_QSPI_IRQHandler(&hqspi);
+    TRACE_EXIT(TRACE_ID_QSPI);
+}
+
+void RTC_Alarm_IRQHandler(void) {
+    TRACE_ENTER(TRACE_ID_RTC_ALARM);
+    HAL_RTC_AlarmIRQHandler(&hrtc);
+    TRACE_EXIT(TRACE_ID_RTC_ALARM);
+}
+
+void DMA2_Stream0_IRQHandler(void) {
+    TRACE_ENTER(TRACE_ID_ADC_DMA);
+    HAL_DMA_IRQHandler(&hdma_adc3);
+    TRACE_EXIT(TRACE_ID_ADC_DMA);
 }
 /************************ (C) COPYRIGHT JUBERA D.O.O Sarajevo ************************/
@@ -26,6 +26,12 @@
 #include "curtain.h"
 #include "lights.h"
 #include "display.h"
+#include "gate.h"
+#include "scene.h"
+#include "timer.h"
+#include "security.h"
+#include "fancoil.h"
+#include "thermostat_sync.h"
 #include "stm32746g_eeprom.h" // Mapa ide nakon svih definicija
 #include "rs485.h"
 
@@ -49,6 +55,9 @@
 #define NTC_CONNECTED_FLAG          (1U << 0)
 #define NTC_ERROR_FLAG              (1U << 1)
 
+/* ctrl_mode vrijednost koja forsira ponovnu inicijalizaciju regulatora */
+#define THST_CTRL_MODE_NONE         0xFFU
+
 /*============================================================================*/
 /* PRIVATNA DEFINICIJA STRUKTURE                                              */
 /*============================================================================*/
@@ -62,6 +71,12 @@ struct THERMOSTAT_TypeDef_s {
     uint8_t  fan_speed;
     bool     hasInfoChanged;
     uint8_t  ntc_flags; // Zamjena za globalnu 'termfl' varijablu
+    // Regulator fan-coila (PI/PID/adaptivni):
+    THERMOSTAT_CtrlConfig_t ctrl; // Blok EE_THERMOSTAT_CTRL
+    FanCoil_t fc;
+    int16_t  ctrl_temp;         // Svako ocitanje, bez histereze prikaza
+    uint8_t  ctrl_mode;         // th_ctrl za koji je regulator inicijalizovan
+    uint32_t ctrl_tick;         // Posljednji korak regulatora
 };
 
 /*============================================================================*/
@@ -73,6 +88,112 @@ struct THERMOSTAT_TypeDef_s {
  */
 static THERMOSTAT_TypeDef thst;
 
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+/**
+ * @brief  Podrazumijevane postavke regulatora (bez naucenih parametara).
+ */
+static void Thermostat_CtrlDefault(THERMOSTAT_TypeDef* const handle)
+{
+    const FanCoil_Params_t params = { FANC_DEFAULT_KP, FANC_DEFAULT_TI, FANC_DEFAULT_TD };
+
+    memset(&handle->ctrl, 0, sizeof(THERMOSTAT_CtrlConfig_t));
+    handle->ctrl.algo = THST_CTRL_DEFAULT_ALGO;
+    handle->ctrl.params[THST_PARAMS_HEATING] = params;
+    handle->ctrl.params[THST_PARAMS_COOLING] = params;
+    handle->ctrl_mode = THST_CTRL_MODE_NONE;
+}
+
+/**
+ * @brief  Snima blok regulatora u EEPROM, sa CRC-om kao i glavni blok.
+ */
+static void Thermostat_CtrlSave(THERMOSTAT_TypeDef* const handle)
+{
+    handle->ctrl.magic_number = EEPROM_MAGIC_NUMBER;
+    handle->ctrl.crc = 0;
+    handle->ctrl.crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&handle->ctrl, sizeof(THERMOSTAT_CtrlConfig_t));
+    EE_WriteBuffer((uint8_t*)&handle->ctrl, EE_THERMOSTAT_CTRL, sizeof(THERMOSTAT_CtrlConfig_t));
+}
+
+/**
+ * @brief  Ucitava blok regulatora; neispravan blok zamjenjuje podrazumijevanim.
+ */
+static void Thermostat_CtrlLoad(THERMOSTAT_TypeDef* const handle)
+{
+    uint16_t received_crc;
+
+    EE_ReadBuffer((uint8_t*)&handle->ctrl, EE_THERMOSTAT_CTRL, sizeof(THERMOSTAT_CtrlConfig_t));
+    received_crc = handle->ctrl.crc;
+    handle->ctrl.crc = 0;
+    if ((handle->ctrl.magic_number != EEPROM_MAGIC_NUMBER)
+     || (received_crc != (uint16_t)HAL_CRC_Calculate(&hcrc, (uint32_t*)&handle->ctrl, sizeof(THERMOSTAT_CtrlConfig_t)))
+     || (handle->ctrl.algo >= FANC_ALGO_COUNT)) {
+        Thermostat_CtrlDefault(handle);
+        Thermostat_CtrlSave(handle);
+    }
+    handle->ctrl_mode = THST_CTRL_MODE_NONE;
+}
+
+/**
+ * @brief  Regulacija PI/PID/adaptivnim algoritmom (`ctrl.algo` != FANC_ALGO_BANDS).
+ * @note   Regulator racuna zahtjev svakih FANC_SAMPLE_MS iz `ctrl_temp`, a
+ * izlaz (brzina, ventil) se osvjezava u svakom pozivu, jer promjena stepena
+ * ceka FANC_STAGE_DWELL_MS od prethodne. Relejni test adaptivnog moda se pokrece kada za
+ * aktivni mod (grijanje/hladenje) jos nema naucenih parametara.
+ * @param  handle Pointer na instancu termostata.
+ * @param  temp_sp Zadata temperatura (x10).
+ * @retval None
+ */
+static void Thermostat_Regulate(THERMOSTAT_TypeDef* const handle, int16_t temp_sp)
+{
+    const uint32_t now = HAL_GetTick();
+    const bool heating = (handle->config.th_ctrl == THST_HEATING);
+    const uint8_t index = heating ? THST_PARAMS_HEATING : THST_PARAMS_COOLING;
+    const uint8_t max_speed = (handle->config.fan_ctrl == 0U) ? 1U : 3U;
+    FanCoil_t* const fc = &handle->fc;
+    const bool sample = ((now - handle->ctrl_tick) >= FANC_SAMPLE_MS);
+
+    if (handle->ctrl_mode != handle->config.th_ctrl) {
+        // Promjena moda ili algoritma: regulator krece od nule
+        handle->ctrl_mode = handle->config.th_ctrl;
+        FanCoil_Init(fc, &handle->ctrl.params[index], now);
+        handle->ctrl_tick = now - FANC_SAMPLE_MS;
+        if ((handle->ctrl.algo == FANC_ALGO_ADAPTIVE) && !(handle->ctrl.tuned & (1U << index))) {
+            FanCoil_TuneStart(fc, now);
+        }
+    }
+
+    if (handle->ntc_flags & NTC_ERROR_FLAG) {
+        handle->fan_speed = 0U;
+        return;
+    }
+    if (sample) handle->ctrl_tick = now;
+
+    if (fc->tune == FANC_TUNE_RUNNING) {
+        // Relejni test: puna snaga ili iskljuceno, bez histereze i zadrzavanja stepena
+        if (sample) FanCoil_TuneStep(fc, temp_sp, handle->ctrl_temp, heating, now);
+        handle->fan_speed = fc->relay_on ? max_speed : 0U;
+    } else {
+        if (sample) FanCoil_Update(fc, temp_sp, handle->ctrl_temp, heating, (handle->ctrl.algo == FANC_ALGO_PID));
+        handle->fan_speed = FanCoil_Output(fc, fc->demand, max_speed, now);
+    }
+
+    if (fc->tune == FANC_TUNE_DONE) {
+        handle->ctrl.params[index].kp = fc->params.kp;
+        handle->ctrl.params[index].ti = fc->params.ti;
+        handle->ctrl.tuned |= (uint8_t)(1U << index);
+        Thermostat_CtrlSave(handle);
+        fc->params.td = handle->ctrl.params[index].td;
+        fc->tune = FANC_TUNE_IDLE;
+        FanCoil_Reset(fc, now);
+    } else if (fc->tune == FANC_TUNE_FAILED) {
+        // Ostaju postojeci parametri; novi pokusaj pri sljedecem ukljucenju
+        fc->tune = FANC_TUNE_IDLE;
+        FanCoil_Reset(fc, now);
+    }
+}
+
 /*============================================================================*/
 /* IMPLEMENTACIJA JAVNIH FUNKCIJA                                             */
 /*============================================================================*/
@@ -111,6 +232,11 @@ void THSTAT_Init(THERMOSTAT_TypeDef* const handle)
     handle->fan_speed = 0;
     handle->th_state = 0;
     handle->ntc_flags = 0;
+    handle->ctrl_temp = 0;
+
+    // Blok regulatora je odvojen od glavnog i ima svoj CRC.
+    Thermostat_CtrlLoad(handle);
+    ThstSync_Init();
 
     // Postavljanje pocetnog moda rada.
     //Thermostat_SetControlMode(handle, 2); // Heating
@@ -129,6 +255,8 @@ void THSTAT_Save(THERMOSTAT_TypeDef* const handle)
     handle->config.crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&handle->config, sizeof(THERMOSTAT_EepromConfig_t));
     // KORAK 4: Snimanje cijelog bloka podataka u EEPROM na definisanu adresu.
     EE_WriteBuffer((uint8_t*)&handle->config, EE_THERMOSTAT, sizeof(THERMOSTAT_EepromConfig_t));
+    // KORAK 5: Isto za blok regulatora (algoritam i nauceni parametri).
+    Thermostat_CtrlSave(handle);
 }
 
 /**
@@ -150,6 +278,7 @@ void Thermostat_SetDefault(THERMOSTAT_TypeDef* const handle)
     handle->config.fan_diff = 10;
     handle->config.fan_loband = 10;
     handle->config.fan_hiband = 20;
+    Thermostat_CtrlDefault(handle);
 }
 /**
  * @brief  Glavna servisna petlja za termostat.
@@ -161,9 +290,6 @@ void Thermostat_SetDefault(THERMOSTAT_TypeDef* const handle)
  */
 void THSTAT_Service(THERMOSTAT_TypeDef* const handle)
 {
-    // Bafer za slanje podataka preko RS485. 15 bajtova je dovoljno za najvecu poruku.
-    uint8_t buf[15];
-
     // Provjera da li termostat radi samostalno (nije dio grupe).
     if (handle->config.group == 0)
     {
@@ -181,6 +307,7 @@ void THSTAT_Service(THERMOSTAT_TypeDef* const handle)
         if (handle->config.th_ctrl == 0) { // Zamjena za makro IsTempRegActiv()
             fan_pcnt = 0U;
             handle->fan_speed = 0U;
+            handle->ctrl_mode = THST_CTRL_MODE_NONE;
             // FanOff(); // Logika za fizicko gaenje ventilatora.
         }
         // Ako je regulator UKLJUCEN (hladenje ili grijanje).
@@ -188,8 +315,12 @@ void THSTAT_Service(THERMOSTAT_TypeDef* const handle)
         {
             temp_sp = (int16_t)((handle->config.sp_temp & 0x3FU) * 10);
 
+            // PI/PID/adaptivni regulator umjesto histereznih traka.
+            if (handle->ctrl.algo != FANC_ALGO_BANDS) {
+                Thermostat_Regulate(handle, temp_sp);
+            }
             // Logika za HLAENJE (mod 1).
-            if (handle->config.th_ctrl == 1) { // Zamjena za IsTempRegCooling()
+            else if (handle->config.th_ctrl == 1) { // Zamjena za IsTempRegCooling()
                 if      ((handle->fan_speed == 0U) && (handle->mv_temp > (temp_sp + handle->config.fan_loband)))                                                    handle->fan_speed = 1U;
                 else if ((handle->fan_speed == 1U) && (handle->mv_temp > (temp_sp + handle->config.fan_hiband)))                                                    handle->fan_speed = 2U;
                 else if ((handle->fan_speed == 1U) && (handle->mv_temp <= temp_sp))                                                                                  handle->fan_speed = 0U;
@@ -231,45 +362,20 @@ void THSTAT_Service(THERMOSTAT_TypeDef* const handle)
                 }
             }
         }
+
+        // Ventil fan-coila je otvoren dok radi bilo koja brzina ventilatora.
+        if (handle->th_state != ((old_fan_speed != 0U) ? 1U : 0U)) {
+            handle->th_state = (old_fan_speed != 0U) ? 1U : 0U;
+            handle->hasInfoChanged = true;
+        }
     } // Kraj `if (handle->config.group == 0)`
 
     // ============================================================================
-    // SLANJE INFO PAKETA NA RS485 BUS
+    // SINHRONIZACIJA GRUPE NA RS485 BUSU
     // ============================================================================
-    // Ako je ovaj termostat MASTER i ako je dolo do promjene...
-    if(handle->config.master && handle->hasInfoChanged)
-    {
-        buf[0] = handle->config.group;
-        buf[1] = handle->config.master;
-        buf[2] = handle->config.th_ctrl;
-        buf[3] = handle->th_state;
-        buf[4] = (handle->mv_temp >> 8) & 0xFF;
-        buf[5] = handle->mv_temp & 0xFF;
-        buf[6] = handle->config.sp_temp;
-        buf[7] = handle->config.sp_min;
-        buf[8] = handle->config.sp_max;
-        buf[9] = handle->config.sp_diff;
-        buf[10] = handle->fan_speed;
-        buf[11] = handle->config.fan_loband;
-        buf[12] = handle->config.fan_hiband;
-        buf[13] = handle->config.fan_diff;
-        buf[14] = handle->config.fan_ctrl;
-        // AddCommand(&thermoQueue, THERMOSTAT_INFO, buf, 15); // Otkomentarisati kada RS485 bude spreman
-        handle->hasInfoChanged = false; // Resetuj fleg nakon slanja
-    }
-    // Ako je ovaj termostat SLAVE i ako je dolo do promjene...
-    else if(!handle->config.master && handle->hasInfoChanged)
-    {
-        buf[0] = handle->config.group;
-        buf[1] = handle->config.master;
-        buf[2] = handle->config.th_ctrl;
-        buf[3] = handle->th_state;
-        buf[4] = (handle->mv_temp >> 8) & 0xFF;
-        buf[5] = handle->mv_temp & 0xFF;
-        buf[6] = handle->config.sp_temp;
-        // AddCommand(&thermoQueue, THERMOSTAT_INFO, buf, 7); // Otkomentarisati kada RS485 bude spreman
-        handle->hasInfoChanged = false; // Resetuj fleg nakon slanja
-    }
+    // Samo promijenjena polja, uz mrtvu zonu i najmanji razmak (thermostat_sync.h).
+    if (handle->config.group != 0U) ThstSync_Service(handle);
+    handle->hasInfoChanged = false;
 }
 
 // --- Grupa 2: Kontrola Zadate Temperature (Setpoint) ---
@@ -483,6 +589,9 @@ bool Thermostat_IsNtcError(THERMOSTAT_TypeDef* const handle)
  */
 void Thermostat_SetMeasuredTemp(THERMOSTAT_TypeDef* const handle, int16_t temp)
 {
+    // Regulator dobija svako ocitanje; histereza ispod je samo za prikaz i bus.
+    handle->ctrl_temp = temp;
+
     // Histereza je sada centralizovana unutar ovog modula.
     // Provjeravamo da li je apsolutna razlika izmedu stare i nove temperature
     // veca od 2 (to odgovara 0.2C, jer su vrijednosti pomnoene sa 10).
@@ -538,6 +647,56 @@ void Thermostat_SetGroup(THERMOSTAT_TypeDef* const handle, uint8_t value)
     handle->hasInfoChanged = true;
 }
 
+// --- Grupa 7: Regulator ventilatora i ventila ---
+uint8_t Thermostat_GetControlAlgorithm(THERMOSTAT_TypeDef* const handle)
+{
+    return handle->ctrl.algo;
+}
+
+void Thermostat_SetControlAlgorithm(THERMOSTAT_TypeDef* const handle, uint8_t algo)
+{
+    if ((algo < FANC_ALGO_COUNT) && (handle->ctrl.algo != algo)) {
+        handle->ctrl.algo = algo;
+        handle->ctrl_mode = THST_CTRL_MODE_NONE;
+        handle->fan_speed = 0U;
+        Thermostat_CtrlSave(handle);
+    }
+}
+
+void Thermostat_StartAutotune(THERMOSTAT_TypeDef* const handle)
+{
+    handle->ctrl.tuned = 0U;
+    handle->ctrl_mode = THST_CTRL_MODE_NONE;
+    Thermostat_CtrlSave(handle);
+}
+
+bool Thermostat_GetControlParams(THERMOSTAT_TypeDef* const handle, uint8_t mode, FanCoil_Params_t* params)
+{
+    const uint8_t index = (mode == THST_COOLING) ? THST_PARAMS_COOLING : THST_PARAMS_HEATING;
+
+    *params = handle->ctrl.params[index];
+    return ((handle->ctrl.tuned & (1U << index)) != 0U);
+}
+
+int16_t Thermostat_GetDemand(THERMOSTAT_TypeDef* const handle)
+{
+    return (handle->ctrl.algo == FANC_ALGO_BANDS) ? 0 : handle->fc.demand;
+}
+
+/**
+ * @brief  Stanje izlaza koje je objavio master grupe (clan grupe nema regulaciju).
+ */
+void Thermostat_SetGroupOutputs(THERMOSTAT_TypeDef* const handle, uint8_t fan_speed, uint8_t state)
+{
+    if (handle->config.group == 0U) return;
+    if (fan_speed > 3U) fan_speed = 3U;
+    if ((handle->fan_speed != fan_speed) || (handle->th_state != (state ? 1U : 0U))) {
+        handle->fan_speed = fan_speed;
+        handle->th_state = state ? 1U : 0U;
+        handle->hasInfoChanged = true;
+    }
+}
+
 void Thermostat_SetInfoChanged(THERMOSTAT_TypeDef* const handle, bool state)
 {
     handle->hasInfoChanged = state;
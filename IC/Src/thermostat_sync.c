@@ -0,0 +1,368 @@
+/**
+ ******************************************************************************
+ * @file    thermostat_sync.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija delta sinhronizacije grupe termostata.
+ *
+ * @note    Modul pamti posljednje stanje koje je grupa usaglasila (poslano
+ * ili primljeno od mastera) i u svakom prolazu ga poredi sa trenutnim
+ * stanjem termostata; razlika su polja sljedećeg okvira. Primljena polja
+ * se primjenjuju kroz settere termostata, a usaglašeno stanje se zatim
+ * uzima iz termostata, pa vrijednost koju je slave ograničio (npr. zadata
+ * izvan njegovih granica) ne izaziva odgovor. Okviri idu kroz `thermoQueue`
+ * i `SendCommand` ih šalje bez čekanja potvrde. Modul ne koristi HAL osim
+ * `HAL_GetTick` i prevodi se i u host build (`ic_bus_sim`).
+ ******************************************************************************
+ */
+
+#if (__THERMOSTAT_SYNC_H__ != FW_BUILD)
+#error "thermostat_sync header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "thermostat_sync.h"
+#include "rs485.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define THST_SYNC_ROLE_NONE             0xFFU   ///< Uloga nije poznata (nakon init-a)
+#define THST_SYNC_SLAVE_FIELDS          (THST_SYNC_F_SETPOINT | THST_SYNC_F_MODE)
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+/**
+ * @brief Stanje grupe koje se prenosi okvirom.
+ */
+typedef struct
+{
+    int16_t temp;
+    uint8_t setpoint;
+    uint8_t mode;
+    uint8_t fan;
+    uint8_t state;
+    uint8_t sp_min;
+    uint8_t sp_max;
+    uint8_t sp_diff;
+} ThstSync_View_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static ThstSync_View_t known;           ///< Posljednje usaglašeno stanje grupe
+static bool known_valid;
+static uint8_t role;                    ///< 1 = master, 0 = slave, `THST_SYNC_ROLE_NONE`
+static uint8_t group;                   ///< Grupa za koju važi `known`
+static uint8_t tx_seq;
+static uint8_t rx_seq;                  ///< Redni broj posljednjeg okvira mastera
+static bool rx_seq_valid;
+static uint32_t last_tx;
+static uint32_t last_key;
+static bool key_pending;                ///< Master: sljedeći okvir je ključni
+static bool request_pending;            ///< Slave: traži ključni okvir od mastera
+static uint32_t last_request;
+static uint8_t rx_buf[THST_SYNC_RX_SLOTS][THST_SYNC_FRAME_MAX];
+static uint8_t rx_len[THST_SYNC_RX_SLOTS];
+static volatile uint8_t rx_head;        ///< Upisuje listener (prekid)
+static volatile uint8_t rx_tail;        ///< Čita servis
+static ThstSync_Stats_t stats;
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+static void ThstSync_Snapshot(THERMOSTAT_TypeDef* const handle, ThstSync_View_t* v)
+{
+    v->temp = Thermostat_GetMeasuredTemp(handle);
+    v->setpoint = Thermostat_GetSetpoint(handle);
+    v->mode = Thermostat_GetControlMode(handle);
+    v->fan = Thermostat_GetFanSpeed(handle);
+    v->state = Thermostat_GetState(handle);
+    v->sp_min = Thermostat_Get_SP_Min(handle);
+    v->sp_max = Thermostat_Get_SP_Max(handle);
+    v->sp_diff = Thermostat_GetSetpointDifference(handle);
+}
+
+/**
+ * @brief Dužina okvira sa poljima iz `flags`.
+ */
+static uint16_t ThstSync_FrameLength(uint8_t flags)
+{
+    uint16_t len = THST_SYNC_HEADER_LEN;
+
+    if (flags & THST_SYNC_F_TEMP)     len += 2U;
+    if (flags & THST_SYNC_F_SETPOINT) len += 1U;
+    if (flags & THST_SYNC_F_MODE)     len += 1U;
+    if (flags & THST_SYNC_F_FAN)      len += 1U;
+    if (flags & THST_SYNC_F_STATE)    len += 1U;
+    if (flags & THST_SYNC_F_LIMITS)   len += 3U;
+    return len;
+}
+
+/**
+ * @brief Šalje okvir u red `thermoQueue`.
+ * @retval false ako je red pun (pokušava se u sljedećem prolazu).
+ */
+static bool ThstSync_Send(uint8_t flags, const ThstSync_View_t* v, uint32_t now)
+{
+    uint8_t buf[THST_SYNC_FRAME_MAX];
+    uint16_t pos = THST_SYNC_HEADER_LEN;
+
+    buf[THST_SYNC_POS_GROUP] = group;
+    buf[THST_SYNC_POS_SEQ] = tx_seq;
+    buf[THST_SYNC_POS_FLAGS] = flags;
+    if (flags & THST_SYNC_F_TEMP)
+    {
+        buf[pos++] = (uint8_t)((uint16_t)v->temp >> 8);
+        buf[pos++] = (uint8_t)v->temp;
+    }
+    if (flags & THST_SYNC_F_SETPOINT) buf[pos++] = v->setpoint;
+    if (flags & THST_SYNC_F_MODE)     buf[pos++] = v->mode;
+    if (flags & THST_SYNC_F_FAN)      buf[pos++] = v->fan;
+    if (flags & THST_SYNC_F_STATE)    buf[pos++] = v->state;
+    if (flags & THST_SYNC_F_LIMITS)
+    {
+        buf[pos++] = v->sp_min;
+        buf[pos++] = v->sp_max;
+        buf[pos++] = v->sp_diff;
+    }
+
+    if (!AddCommand(&thermoQueue, THERMOSTAT_SYNC, buf, (uint8_t)pos)) return false;
+    tx_seq++;
+    last_tx = now;
+    return true;
+}
+
+/**
+ * @brief Primjenjuje polja okvira mastera na termostat (slave).
+ */
+static void ThstSync_Apply(THERMOSTAT_TypeDef* const handle, uint8_t flags, const uint8_t* p)
+{
+    if (flags & THST_SYNC_F_TEMP)
+    {
+        Thermostat_SetMeasuredTemp(handle, (int16_t)((p[0] << 8) | p[1]));
+        p += 2;
+    }
+    // Granice se postavljaju prije zadate, koja se na njih ograničava
+    if (flags & THST_SYNC_F_LIMITS)
+    {
+        const uint8_t* limits = p;
+        if (flags & THST_SYNC_F_SETPOINT) limits++;
+        if (flags & THST_SYNC_F_MODE)     limits++;
+        if (flags & THST_SYNC_F_FAN)      limits++;
+        if (flags & THST_SYNC_F_STATE)    limits++;
+        Thermostat_Set_SP_Min(handle, limits[0]);
+        Thermostat_Set_SP_Max(handle, limits[1]);
+        Thermostat_SetSetpointDifference(handle, limits[2]);
+    }
+    if (flags & THST_SYNC_F_SETPOINT) Thermostat_SP_Temp_Set(handle, *p++);
+    if (flags & THST_SYNC_F_MODE)     Thermostat_SetControlMode(handle, *p++);
+    if (flags & (THST_SYNC_F_FAN | THST_SYNC_F_STATE))
+    {
+        uint8_t fan = Thermostat_GetFanSpeed(handle);
+        uint8_t state = Thermostat_GetState(handle);
+        if (flags & THST_SYNC_F_FAN)   fan = *p++;
+        if (flags & THST_SYNC_F_STATE) state = *p++;
+        Thermostat_SetGroupOutputs(handle, fan, state);
+    }
+}
+
+/**
+ * @brief Obrađuje jedan primljeni okvir vlastite grupe.
+ */
+static void ThstSync_Process(THERMOSTAT_TypeDef* const handle, const uint8_t* data, uint16_t len)
+{
+    const uint8_t flags = data[THST_SYNC_POS_FLAGS];
+    const uint8_t seq = data[THST_SYNC_POS_SEQ];
+    const uint8_t* fields = &data[THST_SYNC_HEADER_LEN];
+
+    if (len < ThstSync_FrameLength(flags)) return;
+    stats.rx_frames++;
+
+    if (!(flags & THST_SYNC_F_MASTER))
+    {
+        if (role != 1U) return; // Zahtjeve slave uređaja obrađuje samo master
+        if ((flags & THST_SYNC_FIELDS) == 0U)
+        {
+            key_pending = true;
+            return;
+        }
+        // Korisnička promjena na slave uređaju; master je objavljuje kao svoju
+        if (flags & THST_SYNC_F_TEMP) fields += 2;
+        if (flags & THST_SYNC_F_SETPOINT) Thermostat_SP_Temp_Set(handle, *fields++);
+        if (flags & THST_SYNC_F_MODE)     Thermostat_SetControlMode(handle, *fields);
+        return;
+    }
+
+    if (role == 1U)
+    {
+        // Drugi master u grupi: ovaj uređaj postaje slave, kao kod THERMOSTAT_INFO
+        Thermostat_SetMaster(handle, false);
+        THSTAT_Save(handle);
+        role = 0U;
+        key_pending = false;
+    }
+
+    if (rx_seq_valid && !(flags & THST_SYNC_F_KEY))
+    {
+        const uint8_t gap = (uint8_t)(seq - rx_seq - 1U);
+        if (seq == rx_seq) return; // Ponovljen okvir
+        if (gap != 0U)
+        {
+            stats.rx_lost += gap;
+            request_pending = true;
+            last_request = HAL_GetTick() - THST_SYNC_REQUEST_RETRY_MS;
+        }
+    }
+    rx_seq = seq;
+    rx_seq_valid = true;
+    if (flags & THST_SYNC_F_KEY) request_pending = false;
+
+    ThstSync_Apply(handle, flags, fields);
+    ThstSync_Snapshot(handle, &known);
+    known_valid = true;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Briše stanje sinhronizacije; prvi servis odlučuje prema ulozi.
+ */
+void ThstSync_Init(void)
+{
+    known_valid = false;
+    role = THST_SYNC_ROLE_NONE;
+    group = 0U;
+    rx_seq_valid = false;
+    key_pending = false;
+    request_pending = false;
+    last_tx = HAL_GetTick() - THST_SYNC_MIN_INTERVAL_MS;
+    last_key = last_tx;
+    rx_tail = rx_head;
+}
+
+/**
+ * @brief Primjenjuje primljene okvire i šalje delta ili ključni okvir.
+ * @note  Poziva se iz `THSTAT_Service` kada je termostat član grupe.
+ */
+void ThstSync_Service(THERMOSTAT_TypeDef* const handle)
+{
+    const uint32_t now = HAL_GetTick();
+    const uint8_t my_group = Thermostat_GetGroup(handle);
+    const uint8_t my_role = Thermostat_IsMaster(handle) ? 1U : 0U;
+    ThstSync_View_t cur;
+    uint8_t flags = 0U;
+
+    if ((my_group != group) || (my_role != role))
+    {
+        // Nova grupa ili uloga: master počinje ključnim okvirom, slave ga traži
+        group = my_group;
+        role = my_role;
+        known_valid = false;
+        rx_seq_valid = false;
+        key_pending = (role == 1U);
+        request_pending = (role == 0U);
+        last_request = now - THST_SYNC_REQUEST_RETRY_MS;
+    }
+
+    while (rx_tail != rx_head)
+    {
+        const uint8_t slot = rx_tail;
+        if (rx_buf[slot][THST_SYNC_POS_GROUP] == group) ThstSync_Process(handle, rx_buf[slot], rx_len[slot]);
+        rx_tail = (uint8_t)((slot + 1U) % THST_SYNC_RX_SLOTS);
+    }
+
+    if ((now - last_tx) < THST_SYNC_MIN_INTERVAL_MS) return;
+    ThstSync_Snapshot(handle, &cur);
+
+    if (role == 1U)
+    {
+        if (key_pending || !known_valid || ((now - last_key) >= THST_SYNC_KEYFRAME_MS))
+        {
+            if (!ThstSync_Send(THST_SYNC_F_MASTER | THST_SYNC_F_KEY | THST_SYNC_FIELDS, &cur, now)) return;
+            stats.tx_key++;
+            last_key = now;
+            key_pending = false;
+            known = cur;
+            known_valid = true;
+            return;
+        }
+        if (cur.setpoint != known.setpoint) flags |= THST_SYNC_F_SETPOINT;
+        if (cur.mode != known.mode)         flags |= THST_SYNC_F_MODE;
+        if (cur.fan != known.fan)           flags |= THST_SYNC_F_FAN;
+        if (cur.state != known.state)       flags |= THST_SYNC_F_STATE;
+        if ((cur.sp_min != known.sp_min) || (cur.sp_max != known.sp_max) || (cur.sp_diff != known.sp_diff))
+        {
+            flags |= THST_SYNC_F_LIMITS;
+        }
+        // Temperatura sama tek preko mrtve zone, a uz druga polja uvijek
+        if ((abs(cur.temp - known.temp) >= THST_SYNC_TEMP_DEADBAND) || ((flags != 0U) && (cur.temp != known.temp)))
+        {
+            flags |= THST_SYNC_F_TEMP;
+        }
+        // Bez promjena povremeno prazan okvir, da slave rano uoči izgubljen niz
+        if ((flags == 0U) && ((now - last_tx) < THST_SYNC_IDLE_MS)) return;
+        if (!ThstSync_Send(THST_SYNC_F_MASTER | flags, &cur, now)) return;
+        stats.tx_delta++;
+        // Ostala polja su u okviru čim se razlikuju; temperatura samo uz zastavicu
+        if (!(flags & THST_SYNC_F_TEMP)) cur.temp = known.temp;
+        known = cur;
+        return;
+    }
+
+    // Zahtjev se ponavlja dok ključni okvir ne stigne (zahtjev se može izgubiti u koliziji)
+    if (request_pending && ((now - last_request) >= THST_SYNC_REQUEST_RETRY_MS))
+    {
+        if (!ThstSync_Send(0U, &cur, now)) return;
+        stats.tx_request++;
+        last_request = now;
+        return;
+    }
+    if (!known_valid) return; // Bez stanja mastera slave nema šta da objavi
+    if (cur.setpoint != known.setpoint) flags |= THST_SYNC_F_SETPOINT;
+    if (cur.mode != known.mode)         flags |= THST_SYNC_F_MODE;
+    if (flags == 0U) return;
+    if (!ThstSync_Send(flags & THST_SYNC_SLAVE_FIELDS, &cur, now)) return;
+    stats.tx_delta++;
+    known.setpoint = cur.setpoint;
+    known.mode = cur.mode;
+}
+
+/**
+ * @brief Prima okvir `THERMOSTAT_SYNC` (poziva listener u prekidu).
+ * @note  Okvir se samo kopira u red; obrađuje ga `ThstSync_Service`.
+ */
+void ThstSync_Receive(const uint8_t* data, uint16_t len)
+{
+    const uint8_t slot = rx_head;
+    const uint8_t next = (uint8_t)((slot + 1U) % THST_SYNC_RX_SLOTS);
+
+    if ((len < THST_SYNC_HEADER_LEN) || (len > THST_SYNC_FRAME_MAX)) return;
+    if (next == rx_tail)
+    {
+        stats.rx_dropped++;
+        return;
+    }
+    memcpy(rx_buf[slot], data, len);
+    rx_len[slot] = (uint8_t)len;
+    rx_head = next;
+}
+
+/**
+ * @brief Master šalje ključni okvir čim istekne najmanji razmak.
+ */
+void ThstSync_RequestKeyframe(void)
+{
+    key_pending = true;
+}
+
+const ThstSync_Stats_t* ThstSync_GetStats(void)
+{
+    return &stats;
+}
@@ -6,9 +6,17 @@
  *
  * @note    Ovaj fajl sadrži kompletnu pozadinsku (backend) logiku.
  * Odgovoran je za čuvanje i čitanje konfiguracije alarma iz EEPROM-a,
- * te za provjeru vremena i aktivaciju definisanih akcija (zujalica, scene).
- * Modul je potpuno enkapsuliran i autonoman, koristeći jednu statičku
- * instancu za sve operacije.
+ * te za aktivaciju definisanih akcija (zujalica, scene) u zadato vrijeme.
+ * Modul je potpuno enkapsuliran i autonoman, koristeći statički niz
+ * instanci za sve operacije.
+ *
+ * Vrijeme se ne provjerava u svakom prolazu. `Timer_Schedule` iz svih
+ * aktivnih tajmera izračuna najbliži okidač (dan u sedmici, sat, minuta) i
+ * upiše ga u RTC Alarm A. Prekid alarma podiže `SCHED_EVT_RTC_ALARM`, pa se
+ * `Timer_Service` izvršava tek kada je okidač stvarno stigao. RTC Alarm B
+ * sa maskiranim svim poljima okida svake sekunde i služi za osvježavanje
+ * keširanog vremena (`Timer_GetWallClock`) koje koriste displej i ostali
+ * moduli umjesto da sami čitaju RTC.
  ******************************************************************************
  */
 
@@ -23,8 +31,18 @@
 #include "timer.h"
 #include "scene.h"
 #include "buzzer.h"
+#include "scheduler.h"
 #include "stm32746g_eeprom.h"
 
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define TIMER_MINUTES_PER_DAY           (24U * 60U)
+#define TIMER_CLOCK_REFRESH_MS          1000U   ///< Osvježavanje keša i bez Alarm B prekida (npr. RTC stoji)
+
+/** Adresa EEPROM bloka tajmera; tajmer 0 koristi blok `EE_TIMER` iz ranijih verzija. */
+#define TIMER_EE_ADDRESS(index)         (((index) == 0U) ? EE_TIMER : (EE_TIMER_EXT + (((index) - 1U) * sizeof(Timer_EepromConfig_t))))
+
 /*============================================================================*/
 /* PRIVATNA DEFINICIJA "RUNTIME" STRUKTURE                                    */
 /*============================================================================*/
@@ -42,12 +60,6 @@ typedef struct
      * @brief Struktura sa konfiguracionim podacima koji se čuvaju u EEPROM-u.
      */
     Timer_EepromConfig_t config;
-
-    /**
-     * @brief Interni "latch" fleg koji sprječava višestruko aktiviranje alarma unutar jedne minute.
-     * @note  Resetuje se na `false` svaki put kada se promijeni minuta na RTC-u.
-     */
-    bool hasTriggeredThisMinute;
 } Timer_Runtime_t;
 
 /*============================================================================*/
@@ -55,16 +67,146 @@ typedef struct
 /*============================================================================*/
 
 /**
- * @brief Jedina instanca tajmera u cijelom sistemu (Singleton pattern).
- * @note  Sve funkcije u ovom modulu implicitno rade sa ovom instancom.
+ * @brief Sve instance tajmera u sistemu.
+ * @note  Getteri i setteri implicitno rade sa instancom `timers[selected]`.
+ */
+static Timer_Runtime_t timers[TIMER_MAX_COUNT];
+static uint8_t selected = 0;
+
+/**
+ * @brief Keširano vrijeme i datum (BCD), osvježava ih `Timer_Service`.
+ */
+static RTC_TimeTypeDef clock_time;
+static RTC_DateTypeDef clock_date;
+static uint32_t clock_refresh_tick;
+
+/**
+ * @brief Flegovi koje postavljaju RTC prekidi, a obrađuje `Timer_Service`.
  */
-static Timer_Runtime_t timer;
+static volatile bool alarm_pending = false;
+static volatile bool clock_pending = false;
 
 /**
  * @brief Fleg koji privremeno zaustavlja izvršavanje alarmne logike.
  * @note  Postavlja se na `true` kada korisnik uđe u meni za podešavanje.
  */
 static bool is_suppressed = false;
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+
+/**
+ * @brief Čita RTC jednom i puni keš vremena i datuma.
+ */
+static void Timer_RefreshClock(void)
+{
+    HAL_RTC_GetTime(&hrtc, &clock_time, RTC_FORMAT_BCD);
+    HAL_RTC_GetDate(&hrtc, &clock_date, RTC_FORMAT_BCD); // otključava shadow registre
+    clock_refresh_tick = HAL_GetTick();
+}
+
+/**
+ * @brief Broj minuta od trenutnog vremena do sljedećeg okidanja tajmera.
+ * @param cfg     Konfiguracija tajmera.
+ * @param weekday Trenutni dan u sedmici (1 = ponedjeljak ... 7 = nedjelja).
+ * @param now_min Trenutna minuta u danu (0..1439).
+ * @retval Minute do okidanja (1..7 dana), 0 ako tajmer nikada ne okida.
+ */
+static uint32_t Timer_MinutesUntil(const Timer_EepromConfig_t* cfg, uint8_t weekday, uint32_t now_min)
+{
+    const uint32_t at_min = (cfg->hour * 60U) + cfg->minute;
+
+    if (!cfg->isActive || ((cfg->repeatMask & TIMER_EVERY_DAY) == 0U)) return 0U;
+
+    // Okidač je striktno u budućnosti; danas u istoj minuti ga već ne računamo
+    for (uint8_t d = 0U; d <= 7U; d++)
+    {
+        uint8_t day = (uint8_t)((weekday - 1U + d) % 7U);
+        if ((cfg->repeatMask & (1U << day)) != 0U)
+        {
+            uint32_t at = (d * TIMER_MINUTES_PER_DAY) + at_min;
+            if (at > now_min) return at - now_min;
+        }
+    }
+    return 0U;
+}
+
+/**
+ * @brief Programira RTC Alarm A na najbliži okidač svih aktivnih tajmera.
+ * @note  Ako nijedan tajmer nije aktivan ili vrijeme nije validno, Alarm A
+ * se gasi. Vrijeme se čita svježe, jer keš može kasniti do jedne sekunde
+ * (npr. `Timer_Save`), a alarm za već prošlu minutu okida tek za sedmicu.
+ */
+static void Timer_Schedule(void)
+{
+    RTC_AlarmTypeDef alarm = {0};
+    uint32_t now_min, until, next = 0U;
+    uint8_t weekday;
+
+    HAL_RTC_DeactivateAlarm(&hrtc, RTC_ALARM_A);
+    Timer_RefreshClock();
+
+    weekday = clock_date.WeekDay;
+    if (!IsRtcTimeValid() || (weekday < RTC_WEEKDAY_MONDAY) || (weekday > RTC_WEEKDAY_SUNDAY)) return;
+    now_min = (Bcd2Dec(clock_time.Hours) * 60U) + Bcd2Dec(clock_time.Minutes);
+
+    for (uint8_t i = 0U; i < TIMER_MAX_COUNT; i++)
+    {
+        uint32_t until = Timer_MinutesUntil(&timers[i].config, weekday, now_min);
+        if ((until != 0U) && ((next == 0U) || (until < next))) next = until;
+    }
+    if (next == 0U) return;
+
+    until = next;
+    next += now_min;
+    alarm.AlarmTime.Hours = (uint8_t)((next / 60U) % 24U);
+    alarm.AlarmTime.Minutes = (uint8_t)(next % 60U);
+    alarm.AlarmTime.Seconds = 0U;
+    alarm.AlarmMask = RTC_ALARMMASK_NONE;
+    alarm.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_ALL;
+    alarm.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_WEEKDAY;
+    alarm.AlarmDateWeekDay = (uint8_t)(((weekday - 1U + (next / TIMER_MINUTES_PER_DAY)) % 7U) + 1U);
+    alarm.Alarm = RTC_ALARM_A;
+    HAL_RTC_SetAlarm_IT(&hrtc, &alarm, RTC_FORMAT_BIN);
+
+    // Ako je minuta okidača nastupila dok se alarm programirao, Alarm A je
+    // propustio sekundu 00, pa se okidanje predaje `Timer_Service`.
+    Timer_RefreshClock();
+    if ((until == 1U) && (((Bcd2Dec(clock_time.Hours) * 60U) + Bcd2Dec(clock_time.Minutes)) != now_min)) {
+        alarm_pending = true;
+        Sched_SetEvent(SCHED_EVT_RTC_ALARM);
+    }
+}
+
+/**
+ * @brief Pokreće akcije svih tajmera čije je vrijeme upravo nastupilo.
+ */
+static void Timer_Fire(void)
+{
+    const uint8_t hour = Bcd2Dec(clock_time.Hours);
+    const uint8_t minute = Bcd2Dec(clock_time.Minutes);
+    const uint8_t day_of_week_mask = (1 << (clock_date.WeekDay - 1));
+
+    for (uint8_t i = 0U; i < TIMER_MAX_COUNT; i++)
+    {
+        const Timer_EepromConfig_t* cfg = &timers[i].config;
+
+        if (!cfg->isActive || (cfg->hour != hour) || (cfg->minute != minute)) continue;
+        if ((cfg->repeatMask & day_of_week_mask) == 0U) continue;
+
+        if (cfg->actionBuzzer) {
+            Buzzer_StartAlarm();
+            screen = SCREEN_ALARM_ACTIVE;
+            shouldDrawScreen = 1;
+        }
+
+        if (cfg->sceneIndexToTrigger != -1) {
+            Scene_Activate(cfg->sceneIndexToTrigger);
+        }
+    }
+}
+
 /*============================================================================*/
 /* IMPLEMENTACIJA JAVNOG API-JA                                               */
 /*============================================================================*/
@@ -84,23 +226,26 @@ static bool is_suppressed = false;
  */
 void Timer_Init(void)
 {
-    EE_ReadBuffer((uint8_t*)&timer.config, EE_TIMER, sizeof(Timer_EepromConfig_t));
-
-    if (timer.config.magic_number != EEPROM_MAGIC_NUMBER) {
-        Timer_SetDefault();
-        Timer_Save();
-    } else {
-        uint16_t received_crc = timer.config.crc;
-        timer.config.crc = 0;
-        uint16_t calculated_crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&timer.config, sizeof(Timer_EepromConfig_t));
+    for (selected = 0; selected < TIMER_MAX_COUNT; selected++)
+    {
+        EE_ReadBuffer((uint8_t*)&timers[selected].config, TIMER_EE_ADDRESS(selected), sizeof(Timer_EepromConfig_t));
 
-        if (received_crc != calculated_crc) {
+        if (timers[selected].config.magic_number != EEPROM_MAGIC_NUMBER) {
             Timer_SetDefault();
             Timer_Save();
+        } else {
+            uint16_t received_crc = timers[selected].config.crc;
+            timers[selected].config.crc = 0;
+            uint16_t calculated_crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&timers[selected].config, sizeof(Timer_EepromConfig_t));
+
+            if (received_crc != calculated_crc) {
+                Timer_SetDefault();
+                Timer_Save();
+            }
         }
     }
-    // Runtime varijable se uvijek resetuju na početku.
-    timer.hasTriggeredThisMinute = false;
+    selected = 0;
+    Timer_Resync();
 }
 
 /**
@@ -108,16 +253,18 @@ void Timer_Init(void)
  * @brief       Čuva trenutnu konfiguraciju tajmera u EEPROM.
  * @author      Gemini & [Vaše Ime]
  * @note        Prije upisa, izračunava novi CRC32 nad konfiguracijom.
+ * Nakon upisa ponovo programira RTC alarm za izmijenjene postavke.
  * @param       None
  * @retval      None
  ******************************************************************************
  */
 void Timer_Save(void)
 {
-    timer.config.magic_number = EEPROM_MAGIC_NUMBER;
-    timer.config.crc = 0;
-    timer.config.crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&timer.config, sizeof(Timer_EepromConfig_t));
-    EE_WriteBuffer((uint8_t*)&timer.config, EE_TIMER, sizeof(Timer_EepromConfig_t));
+    timers[selected].config.magic_number = EEPROM_MAGIC_NUMBER;
+    timers[selected].config.crc = 0;
+    timers[selected].config.crc = HAL_CRC_Calculate(&hcrc, (uint32_t*)&timers[selected].config, sizeof(Timer_EepromConfig_t));
+    EE_WriteBuffer((uint8_t*)&timers[selected].config, TIMER_EE_ADDRESS(selected), sizeof(Timer_EepromConfig_t));
+    Timer_Schedule();
 }
 
 /**
@@ -125,74 +272,151 @@ void Timer_Save(void)
  * @brief       Postavlja sve postavke tajmera na sigurne fabričke vrijednosti.
  * @author      Gemini & [Vaše Ime]
  * @note        Definiše početno stanje alarma (07:30, radnim danima, zujalica).
+ * Odnosi se na trenutno odabrani tajmer.
  * @param       None
  * @retval      None
  ******************************************************************************
  */
 void Timer_SetDefault(void)
 {
-    memset(&timer.config, 0, sizeof(Timer_EepromConfig_t));
-    timer.config.isActive = false;
-    timer.config.hour = 7;
-    timer.config.minute = 30;
-    timer.config.repeatMask = TIMER_WEEKDAYS;
-    timer.config.actionBuzzer = true;
-    timer.config.sceneIndexToTrigger = -1;
+    memset(&timers[selected].config, 0, sizeof(Timer_EepromConfig_t));
+    timers[selected].config.isActive = false;
+    timers[selected].config.hour = 7;
+    timers[selected].config.minute = 30;
+    timers[selected].config.repeatMask = TIMER_WEEKDAYS;
+    timers[selected].config.actionBuzzer = true;
+    timers[selected].config.sceneIndexToTrigger = -1;
 }
 
 /**
  ******************************************************************************
  * @brief       Glavna servisna petlja za tajmer.
  * @author      Gemini & [Vaše Ime]
- * @note        Poziva se iz `main()` petlje. Provjerava vrijeme i aktivira alarm.
+ * @note        Planer je poziva na `SCHED_EVT_RTC_ALARM` (Alarm A ili B) i
+ * rijetko periodično. RTC se čita samo kada je stigla nova sekunda ili
+ * kada Alarm B prekid izostane duže od `TIMER_CLOCK_REFRESH_MS`.
  * @param       None
  * @retval      None
  ******************************************************************************
  */
 void Timer_Service(void)
 {
-    static uint8_t last_checked_minute = 61;
+    bool refreshed = false;
 
-    if (is_suppressed) {
-        return; // Prekini izvršavanje ako je alarm pauziran
+    if (clock_pending || ((HAL_GetTick() - clock_refresh_tick) >= TIMER_CLOCK_REFRESH_MS)) {
+        clock_pending = false;
+        Timer_RefreshClock();
+        refreshed = true;
     }
-    
-    if (!timer.config.isActive || !IsRtcTimeValid()) {
+
+    if (!alarm_pending) {
         return;
     }
+    alarm_pending = false;
 
-    RTC_TimeTypeDef currentTime;
-    RTC_DateTypeDef currentDate;
-
-    HAL_RTC_GetTime(&hrtc, &currentTime, RTC_FORMAT_BIN);
-
-    if (currentTime.Minutes != last_checked_minute) {
-        timer.hasTriggeredThisMinute = false;
-        last_checked_minute = currentTime.Minutes;
+    if (!refreshed) {
+        Timer_RefreshClock(); // vrijeme tačno u trenutku alarma
     }
 
-    if (!timer.hasTriggeredThisMinute) {
-        if ((timer.config.hour == currentTime.Hours) && (timer.config.minute == currentTime.Minutes)) {
-            HAL_RTC_GetDate(&hrtc, &currentDate, RTC_FORMAT_BIN);
-            uint8_t day_of_week_mask = (1 << (currentDate.WeekDay - 1));
+    if (!is_suppressed && IsRtcTimeValid()) { // pauziran alarm preskače ovo okidanje
+        Timer_Fire();
+    }
+    Timer_Schedule();
+}
 
-            if (timer.config.repeatMask & day_of_week_mask) {
-                timer.hasTriggeredThisMinute = true;
+/**
+ ******************************************************************************
+ * @brief       Usklađuje keš vremena i RTC alarm nakon promjene vremena.
+ * @author      Gemini & [Vaše Ime]
+ * @note        Poziva se nakon svakog `HAL_RTC_SetTime`/`HAL_RTC_SetDate` i
+ * ponovne inicijalizacije RTC-a, jer programirani Alarm A više ne odgovara,
+ * a `HAL_RTC_DeInit` briše i sekundni Alarm B.
+ * @param       None
+ * @retval      None
+ ******************************************************************************
+ */
+void Timer_Resync(void)
+{
+    // Alarm B bez poređenja polja okida svake sekunde (osvježavanje keša).
+    RTC_AlarmTypeDef tick = {0};
+    tick.AlarmMask = RTC_ALARMMASK_ALL;
+    tick.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_ALL;
+    tick.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_DATE;
+    tick.AlarmDateWeekDay = 1;
+    tick.Alarm = RTC_ALARM_B;
+    HAL_RTC_SetAlarm_IT(&hrtc, &tick, RTC_FORMAT_BIN);
+
+    clock_pending = false;
+    alarm_pending = false;
+    Timer_Schedule();   // čita i keš vremena
+}
 
-                if (timer.config.actionBuzzer) {
-                    Buzzer_StartAlarm();
-                    screen = SCREEN_ALARM_ACTIVE;
-                    shouldDrawScreen = 1;
-                }
+/**
+ ******************************************************************************
+ * @brief       Vraća keširano vrijeme i datum u BCD formatu.
+ * @author      Gemini & [Vaše Ime]
+ * @note        Zamjena za `HAL_RTC_GetTime`/`HAL_RTC_GetDate` u kodu koji se
+ * izvršava često; vrijednost je stara najviše jednu sekundu.
+ * @param       time Odredište za vrijeme (može biti NULL).
+ * @param       date Odredište za datum (može biti NULL).
+ * @retval      None
+ ******************************************************************************
+ */
+void Timer_GetWallClock(RTC_TimeTypeDef* time, RTC_DateTypeDef* date)
+{
+    if (time != NULL) *time = clock_time;
+    if (date != NULL) *date = clock_date;
+}
 
-                if (timer.config.sceneIndexToTrigger != -1) {
-                    Scene_Activate(timer.config.sceneIndexToTrigger);
-                }
-            }
-        }
+/**
+ ******************************************************************************
+ * @brief       Bira tajmer nad kojim rade getteri, setteri i `Timer_Save`.
+ * @author      Gemini & [Vaše Ime]
+ * @param       index Indeks tajmera (0..TIMER_MAX_COUNT-1).
+ * @retval      None
+ ******************************************************************************
+ */
+void Timer_Select(uint8_t index)
+{
+    if (index < TIMER_MAX_COUNT) {
+        selected = index;
     }
 }
 
+/**
+ ******************************************************************************
+ * @brief Vraća indeks odabranog tajmera.
+ ******************************************************************************
+ */
+uint8_t Timer_GetSelected(void)
+{
+    return selected;
+}
+
+/**
+ ******************************************************************************
+ * @brief RTC Alarm A: stiglo je vrijeme okidanja nekog tajmera.
+ ******************************************************************************
+ */
+void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+    alarm_pending = true;
+    Sched_SetEvent(SCHED_EVT_RTC_ALARM);
+}
+
+/**
+ ******************************************************************************
+ * @brief RTC Alarm B: nova sekunda, keš vremena treba osvježiti.
+ ******************************************************************************
+ */
+void HAL_RTCEx_AlarmBEventCallback(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+    clock_pending = true;
+    Sched_SetEvent(SCHED_EVT_RTC_ALARM);
+}
+
 // --- Grupa 2: Getteri i Setteri za Konfiguraciju ---
 
 /**
@@ -201,7 +425,7 @@ void Timer_Service(void)
  ******************************************************************************
  */
 void Timer_SetState(bool isActive) {
-    timer.config.isActive = isActive;
+    timers[selected].config.isActive = isActive;
 }
 
 /**
@@ -210,7 +434,7 @@ void Timer_SetState(bool isActive) {
  ******************************************************************************
  */
 bool Timer_IsActive(void) {
-    return timer.config.isActive;
+    return timers[selected].config.isActive;
 }
 
 /**
@@ -220,7 +444,7 @@ bool Timer_IsActive(void) {
  */
 void Timer_SetHour(uint8_t hour) {
     if (hour < 24) {
-        timer.config.hour = hour;
+        timers[selected].config.hour = hour;
     }
 }
 
@@ -230,7 +454,7 @@ void Timer_SetHour(uint8_t hour) {
  ******************************************************************************
  */
 uint8_t Timer_GetHour(void) {
-    return timer.config.hour;
+    return timers[selected].config.hour;
 }
 
 /**
@@ -240,7 +464,7 @@ uint8_t Timer_GetHour(void) {
  */
 void Timer_SetMinute(uint8_t minute) {
     if (minute < 60) {
-        timer.config.minute = minute;
+        timers[selected].config.minute = minute;
     }
 }
 
@@ -250,7 +474,7 @@ void Timer_SetMinute(uint8_t minute) {
  ******************************************************************************
  */
 uint8_t Timer_GetMinute(void) {
-    return timer.config.minute;
+    return timers[selected].config.minute;
 }
 
 /**
@@ -259,7 +483,7 @@ uint8_t Timer_GetMinute(void) {
  ******************************************************************************
  */
 void Timer_SetRepeatMask(uint8_t mask) {
-    timer.config.repeatMask = mask & 0x7F;
+    timers[selected].config.repeatMask = mask & 0x7F;
 }
 
 /**
@@ -268,7 +492,7 @@ void Timer_SetRepeatMask(uint8_t mask) {
  ******************************************************************************
  */
 uint8_t Timer_GetRepeatMask(void) {
-    return timer.config.repeatMask;
+    return timers[selected].config.repeatMask;
 }
 
 /**
@@ -277,7 +501,7 @@ uint8_t Timer_GetRepeatMask(void) {
  ******************************************************************************
  */
 void Timer_SetActionBuzzer(bool enable) {
-    timer.config.actionBuzzer = enable;
+    timers[selected].config.actionBuzzer = enable;
 }
 
 /**
@@ -286,7 +510,7 @@ void Timer_SetActionBuzzer(bool enable) {
  ******************************************************************************
  */
 bool Timer_GetActionBuzzer(void) {
-    return timer.config.actionBuzzer;
+    return timers[selected].config.actionBuzzer;
 }
 
 /**
@@ -296,7 +520,7 @@ bool Timer_GetActionBuzzer(void) {
  */
 void Timer_SetSceneIndex(int8_t index) {
     if (index >= -1 && index < SCENE_MAX_COUNT) {
-        timer.config.sceneIndexToTrigger = index;
+        timers[selected].config.sceneIndexToTrigger = index;
     }
 }
 
@@ -306,11 +530,12 @@ void Timer_SetSceneIndex(int8_t index) {
  ******************************************************************************
  */
 int8_t Timer_GetSceneIndex(void) {
-    return timer.config.sceneIndexToTrigger;
+    return timers[selected].config.sceneIndexToTrigger;
 }
 
 /**
  * @brief Pauzira izvršavanje alarmne logike u Timer_Service.
+ * @note  Okidanje koje stigne dok je alarm pauziran se preskače.
  */
 void Timer_Suppress(void) {
     is_suppressed = true;
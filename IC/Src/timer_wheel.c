@@ -0,0 +1,268 @@
+/**
+ ******************************************************************************
+ * @file    timer_wheel.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija hijerarhijskog točka softverskih tajmera.
+ *
+ * @note    Rezolucija je 1 ms (`HAL_GetTick`). Prvi nivo ima 256 slotova
+ * po 1 ms, a četiri viša nivoa po 64 slota, svaki 64 puta grublji od
+ * prethodnog, pa zajedno pokrivaju cijeli 32-bitni opseg tick-a. Tajmer se
+ * upisuje u slot prema tome koliko je daleko njegov istek. Kada prvi nivo
+ * obiđe krug, tajmeri iz sljedećeg slota višeg nivoa se premještaju
+ * (kaskadiraju) niže, sve dok ne stignu u prvi nivo i isteknu. Slot je
+ * kružna lista sa glavom, pa se tajmer skida iz liste bez traženja.
+ ******************************************************************************
+ */
+
+#if (__TIMER_WHEEL_H__ != FW_BUILD)
+#error "timer wheel header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "timer_wheel.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define TW_ROOT_BITS                    8U
+#define TW_LEVEL_BITS                   6U
+#define TW_ROOT_SIZE                    (1UL << TW_ROOT_BITS)
+#define TW_LEVEL_SIZE                   (1UL << TW_LEVEL_BITS)
+#define TW_ROOT_MASK                    (TW_ROOT_SIZE - 1U)
+#define TW_LEVEL_MASK                   (TW_LEVEL_SIZE - 1U)
+#define TW_LEVELS                       4U      ///< Broj viših nivoa (8 + 4 * 6 = 32 bita)
+
+/** Indeks slota u višem nivou `n` (1..4) za dati tick. */
+#define TW_INDEX(tick, n)               (((tick) >> (TW_ROOT_BITS + ((n) - 1U) * TW_LEVEL_BITS)) & TW_LEVEL_MASK)
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static TimerWheel_Link_t wheel_root[TW_ROOT_SIZE];
+static TimerWheel_Link_t wheel_level[TW_LEVELS][TW_LEVEL_SIZE];
+static uint32_t wheel_base;             ///< Sljedeći tick koji `TimerWheel_Service` obrađuje
+static uint16_t active_count;           ///< Broj aktivnih tajmera
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static void TimerWheel_ListInit(TimerWheel_Link_t* head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+static void TimerWheel_ListAdd(TimerWheel_Link_t* head, TimerWheel_Link_t* link)
+{
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+static void TimerWheel_ListUnlink(TimerWheel_Link_t* link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
+}
+
+/**
+ * @brief Prebacuje cijelu listu slota `from` u praznu listu `to`.
+ */
+static void TimerWheel_ListTake(TimerWheel_Link_t* from, TimerWheel_Link_t* to)
+{
+    if (from->next == from)
+    {
+        TimerWheel_ListInit(to);
+        return;
+    }
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    TimerWheel_ListInit(from);
+}
+
+/**
+ * @brief Upisuje tajmer u slot prema udaljenosti isteka od `wheel_base`.
+ */
+static void TimerWheel_Insert(TimerWheel_Timer_t* timer)
+{
+    uint32_t expires = timer->expires;
+    uint32_t delta = expires - wheel_base;
+    TimerWheel_Link_t* head;
+
+    if ((int32_t)delta < 0)
+    {
+        head = &wheel_root[wheel_base & TW_ROOT_MASK];      // već istekao: sljedeći obrađeni tick
+    }
+    else if (delta < TW_ROOT_SIZE)
+    {
+        head = &wheel_root[expires & TW_ROOT_MASK];
+    }
+    else
+    {
+        uint8_t n = 1U;
+        while ((n < TW_LEVELS) && (delta >= (1UL << (TW_ROOT_BITS + n * TW_LEVEL_BITS)))) n++;
+        head = &wheel_level[n - 1U][TW_INDEX(expires, n)];
+    }
+    TimerWheel_ListAdd(head, &timer->link);
+}
+
+/**
+ * @brief Premješta tajmere iz jednog slota višeg nivoa u niže nivoe.
+ * @retval Indeks obrađenog slota; 0 znači da je i ovaj nivo obišao krug.
+ */
+static uint32_t TimerWheel_Cascade(uint8_t n)
+{
+    uint32_t index = TW_INDEX(wheel_base, n);
+    TimerWheel_Link_t list;
+
+    TimerWheel_ListTake(&wheel_level[n - 1U][index], &list);
+    while (list.next != &list)
+    {
+        TimerWheel_Timer_t* timer = (TimerWheel_Timer_t*)list.next;
+        TimerWheel_ListUnlink(&timer->link);
+        TimerWheel_Insert(timer);
+    }
+    return index;
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Prazni sve slotove; poziva se prije `Init` funkcija modula.
+ */
+void TimerWheel_Init(void)
+{
+    for (uint32_t i = 0U; i < TW_ROOT_SIZE; i++)
+    {
+        TimerWheel_ListInit(&wheel_root[i]);
+    }
+    for (uint32_t n = 0U; n < TW_LEVELS; n++)
+    {
+        for (uint32_t i = 0U; i < TW_LEVEL_SIZE; i++)
+        {
+            TimerWheel_ListInit(&wheel_level[n][i]);
+        }
+    }
+    wheel_base = HAL_GetTick();
+    active_count = 0U;
+}
+
+/**
+ * @brief Obrađuje sve tick-ove do `HAL_GetTick()` i poziva istekle tajmere.
+ * @note  Bez aktivnih tajmera samo pomjera `wheel_base`.
+ */
+void TimerWheel_Service(void)
+{
+    const uint32_t now = HAL_GetTick();
+
+    while ((int32_t)(now - wheel_base) >= 0)
+    {
+        TimerWheel_Link_t expired;
+        uint32_t index;
+
+        if (active_count == 0U)
+        {
+            wheel_base = now + 1U;
+            break;
+        }
+
+        index = wheel_base & TW_ROOT_MASK;
+        if (index == 0U)
+        {
+            for (uint8_t n = 1U; (n <= TW_LEVELS) && (TimerWheel_Cascade(n) == 0U); n++)
+            {
+            }
+        }
+
+        TimerWheel_ListTake(&wheel_root[index], &expired);
+        wheel_base++;
+
+        // Callback može pokrenuti ili zaustaviti bilo koji tajmer, pa i neki iz `expired`
+        while (expired.next != &expired)
+        {
+            TimerWheel_Timer_t* timer = (TimerWheel_Timer_t*)expired.next;
+            TimerWheel_ListUnlink(&timer->link);
+            active_count--;
+            if (timer->callback != NULL) timer->callback(timer->arg);
+        }
+    }
+}
+
+/**
+ * @brief (Ponovo) pokreće tajmer.
+ * @param timer      Tajmer; ako je već aktivan, prvo se zaustavlja.
+ * @param timeout_ms Vrijeme do isteka, najviše `TIMER_WHEEL_MAX_TIMEOUT`.
+ * @param callback   Funkcija koja se poziva po isteku.
+ * @param arg        Argument za `callback`.
+ */
+void TimerWheel_Start(TimerWheel_Timer_t* timer, uint32_t timeout_ms, TimerWheel_Callback_t callback, void* arg)
+{
+    if (timer == NULL) return;
+
+    TimerWheel_Stop(timer);
+    if (timeout_ms > TIMER_WHEEL_MAX_TIMEOUT) timeout_ms = TIMER_WHEEL_MAX_TIMEOUT;
+    timer->expires = HAL_GetTick() + timeout_ms;
+    timer->callback = callback;
+    timer->arg = arg;
+    TimerWheel_Insert(timer);
+    active_count++;
+}
+
+/**
+ * @brief Zaustavlja tajmer; za neaktivan tajmer ne radi ništa.
+ */
+void TimerWheel_Stop(TimerWheel_Timer_t* timer)
+{
+    if ((timer == NULL) || (timer->link.next == NULL)) return;
+
+    TimerWheel_ListUnlink(&timer->link);
+    active_count--;
+}
+
+/**
+ * @brief Preuzima mjesto u listi nakon što je struktura sa tajmerom kopirana.
+ * @note  Poziva se za kopiju odmah nakon `memcpy`, prije nego što se
+ * original obriše ili promijeni. Istek ostaje isti.
+ * @param timer Kopija tajmera na novoj adresi.
+ * @param arg   Novi argument za `callback` (npr. nova adresa handle-a).
+ */
+void TimerWheel_Relocate(TimerWheel_Timer_t* timer, void* arg)
+{
+    if ((timer == NULL) || (timer->link.next == NULL)) return;
+
+    timer->link.next->prev = &timer->link;
+    timer->link.prev->next = &timer->link;
+    timer->arg = arg;
+}
+
+bool TimerWheel_IsActive(const TimerWheel_Timer_t* timer)
+{
+    return (timer != NULL) && (timer->link.next != NULL);
+}
+
+/**
+ * @brief Preostalo vrijeme do isteka u ms, 0 za neaktivan ili istekao tajmer.
+ */
+uint32_t TimerWheel_Remaining(const TimerWheel_Timer_t* timer)
+{
+    uint32_t left;
+
+    if (!TimerWheel_IsActive(timer)) return 0U;
+    left = timer->expires - HAL_GetTick();
+    return ((int32_t)left > 0) ? left : 0U;
+}
+
+uint16_t TimerWheel_GetActiveCount(void)
+{
+    return active_count;
+}
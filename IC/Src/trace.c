@@ -0,0 +1,186 @@
+/**
+ ******************************************************************************
+ * @file    trace.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija kružnog bafera za praćenje prekida i zadataka.
+ *
+ * @note    Bafer je u DTCM RAM-u (sekcija `.dtcm_ram` u `db.sct`), pa upis
+ * iz prekida ne ide preko AXI magistrale koju dijele LTDC i DMA2D. Redni
+ * broj zapisa se uvećava LDREX/STREX petljom, a DWT se čita između njih:
+ * ako prekid upadne prije STREX-a, petlja se ponavlja, pa su vremenske
+ * oznake uvijek u redoslijedu zapisa. Čitanje preko RS485 prvo zamrzava
+ * bafer da se stranice ne bi mijenjale između dva zahtjeva.
+ ******************************************************************************
+ */
+
+#if (__TRACE_H__ != FW_BUILD)
+#error "trace header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "trace.h"
+#include "profiler.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define TRACE_RING_MASK                 (TRACE_RING_SIZE - 1U)
+#define TRACE_EVENTS_PER_PAGE           14U     ///< Broj zapisa u jednom RS485 odgovoru
+#define TRACE_EVENT_RECORD_SIZE         8U      ///< Veličina zapisa u bajtima
+#define TRACE_STATUS_RECORD_SIZE        11U     ///< Veličina statusnog zapisa u bajtima
+#define TRACE_HEADER_SIZE               4U      ///< subcmd, stranica, ukupno stranica, broj zapisa
+
+#if ((TRACE_RING_SIZE & TRACE_RING_MASK) != 0U)
+#error "TRACE_RING_SIZE mora biti stepen broja 2"
+#endif
+
+#ifdef USE_TRACE
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static Trace_Event_t trace_ring[TRACE_RING_SIZE] __attribute__((section(".dtcm_ram")));
+static volatile uint32_t trace_head;    ///< Ukupan broj rezervisanih zapisa
+static volatile bool trace_frozen;      ///< Upis zaustavljen dok se bafer čita
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static uint8_t* Trace_Put16(uint8_t* p, uint32_t value)
+{
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = (uint8_t)(value & 0xFFU);
+    return p;
+}
+
+static uint8_t* Trace_Put32(uint8_t* p, uint32_t value)
+{
+    *p++ = (uint8_t)(value >> 24);
+    *p++ = (uint8_t)(value >> 16);
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = (uint8_t)(value & 0xFFU);
+    return p;
+}
+
+static uint16_t Trace_GetCount(void)
+{
+    return (trace_head > TRACE_RING_SIZE) ? (uint16_t)TRACE_RING_SIZE : (uint16_t)trace_head;
+}
+#endif
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Briše bafer i pokreće praćenje.
+ * @note  Poziva se nakon `Profiler_Init`, koji uključuje DWT brojač.
+ */
+void Trace_Init(void)
+{
+#ifdef USE_TRACE
+    trace_frozen = true;
+    memset(trace_ring, 0, sizeof(trace_ring));
+    trace_head = 0U;
+    trace_frozen = false;
+#endif
+}
+
+#ifdef USE_TRACE
+/**
+ * @brief Upisuje jedan događaj; poziva se preko `TRACE_ENTER`/`TRACE_EXIT`.
+ * @note  Sigurno iz prekida bilo kog prioriteta i iz glavne petlje.
+ */
+void Trace_Record(uint8_t id, uint8_t kind)
+{
+    uint32_t idx, cycles;
+    Trace_Event_t* e;
+
+    if (trace_frozen) return;
+
+    do
+    {
+        idx = __LDREXW((volatile uint32_t*)&trace_head);
+        cycles = Profiler_Cycles();
+    } while (__STREXW(idx + 1U, (volatile uint32_t*)&trace_head) != 0U);
+
+    e = &trace_ring[idx & TRACE_RING_MASK];
+    e->cycles = cycles;
+    e->seq = (uint16_t)idx;
+    e->id = id;
+    e->kind = kind;
+}
+#endif
+
+/**
+ * @brief Pakuje sadržaj bafera u odgovor na `DIAG_GET`.
+ * @param subcmd `DIAG_TRACE_STATUS`, `DIAG_TRACE_READ` ili `DIAG_TRACE_RESET`.
+ * @param page   Stranica zapisa za `DIAG_TRACE_READ`.
+ * @param buf    Bafer za odgovor.
+ * @param size   Veličina bafera.
+ * @retval Dužina odgovora, 0 za nepoznatu pod-komandu ili bez `USE_TRACE`.
+ * @note  Za razliku od profilera, treći bajt zaglavlja je broj stranica.
+ * Statusni zapis: 1, broj zapisa u baferu, ukupno upisanih (32 bita),
+ * takt procesora u MHz, veličina bafera. Zapis događaja: DWT ciklusi
+ * (32 bita), redni broj (16 bita), izvor, vrsta. Zapisi idu od najstarijeg.
+ */
+uint16_t Trace_Serialize(uint8_t subcmd, uint8_t page, uint8_t* buf, uint16_t size)
+{
+#ifdef USE_TRACE
+    uint8_t* p = buf + TRACE_HEADER_SIZE;
+    uint16_t count = Trace_GetCount();
+    uint8_t pages = (uint8_t)((count + TRACE_EVENTS_PER_PAGE - 1U) / TRACE_EVENTS_PER_PAGE);
+    uint8_t n = 0U;
+
+    if (size < TRACE_HEADER_SIZE + TRACE_STATUS_RECORD_SIZE) return 0U;
+
+    switch (subcmd)
+    {
+    case DIAG_TRACE_STATUS:
+        trace_frozen = true;
+        *p++ = 1U;
+        p = Trace_Put16(p, count);
+        p = Trace_Put32(p, trace_head);
+        p = Trace_Put16(p, SystemCoreClock / 1000000U);
+        p = Trace_Put16(p, TRACE_RING_SIZE);
+        n = 1U;
+        break;
+
+    case DIAG_TRACE_READ:
+        trace_frozen = true;
+        for (uint16_t i = (uint16_t)page * TRACE_EVENTS_PER_PAGE; (i < count) && (n < TRACE_EVENTS_PER_PAGE); i++)
+        {
+            const Trace_Event_t* e = &trace_ring[(trace_head - count + i) & TRACE_RING_MASK];
+            if ((uint16_t)(p - buf) + TRACE_EVENT_RECORD_SIZE > size) break;
+            p = Trace_Put32(p, e->cycles);
+            p = Trace_Put16(p, e->seq);
+            *p++ = e->id;
+            *p++ = e->kind;
+            n++;
+        }
+        break;
+
+    case DIAG_TRACE_RESET:
+        Trace_Init();
+        pages = 0U;
+        break;
+
+    default:
+        return 0U;
+    }
+
+    buf[0] = subcmd;
+    buf[1] = page;
+    buf[2] = pages;
+    buf[3] = n;
+    return (uint16_t)(p - buf);
+#else
+    (void)subcmd;
+    (void)page;
+    (void)buf;
+    (void)size;
+    return 0U;
+#endif
+}
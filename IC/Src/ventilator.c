@@ -10,8 +10,8 @@
  *
  * Sva interakcija sa podacima se vri preko `handle`-a koji se prosljeduje
  * funkcijama. `Ventilator_Service()` periodicno poziva pomocne `Handle...`
- * funkcije za obradu tajmera, okidaca i promjena stanja koje treba poslati
- * na RS485 bus.
+ * funkcije za obradu okidaca i promjena stanja koje treba poslati na RS485
+ * bus. Tajmere odlozenog paljenja i gasenja obraduje `TimerWheel_Service()`.
  ******************************************************************************
  */
 
@@ -28,6 +28,7 @@
 #include "display.h"          // Potreban za g_display_settings i signaliziranje GUI-ju
 #include "stm32746g_eeprom.h" // Potreban za adrese i funkcije za upis/citanje
 #include "rs485.h"            // Potreban za slanje komandi na Modbus
+#include "timer_wheel.h"      // Potreban za tajmere odlozenog paljenja i gasenja
 
 /*============================================================================*/
 /* PRIVATNE DEFINICIJE I MAKROI                                               */
@@ -56,8 +57,8 @@ struct Ventilator_s {
     Ventilator_EepromConfig_t config; /**< Ugnijedena struktura sa podacima koji se cuvaju u EEPROM. */
 
     // --- Runtime podaci (ne cuvaju se trajno) ---
-    uint32_t delayOnTimerStart;     /**< Vrijeme (`HAL_GetTick()`) kada je poceo tajmer za odloeno paljenje. 0 = neaktivan. */
-    uint32_t delayOffTimerStart;    /**< Vrijeme (`HAL_GetTick()`) kada je poceo tajmer za odloeno gaenje. 0 = neaktivan. */
+    TimerWheel_Timer_t delayOnTimer;    /**< Tajmer za odloeno paljenje. */
+    TimerWheel_Timer_t delayOffTimer;   /**< Tajmer za odloeno gaenje. */
     uint8_t flags;                  /**< 8-bitni registar za razne flegove. Trenutno se koristi samo bit 0 za stanje ON/OFF. */
 };
 
@@ -74,8 +75,8 @@ static struct Ventilator_s ventilator;
 /*============================================================================*/
 /* PROTOTIPOVI PRIVATNIH POMOCNIH FUNKCIJA                                    */
 /*============================================================================*/
-static void HandleDelayOffTimer(Ventilator_Handle* const handle);
-static void HandleDelayOnTimer(Ventilator_Handle* const handle);
+static void DelayOffTimerExpired(void* arg);
+static void DelayOnTimerExpired(void* arg);
 static void HandleTriggerSources(Ventilator_Handle* const handle);
 static void HandleVentilatorStatusChanges(Ventilator_Handle* const handle);
 static bool Ventilator_isConfigured(const Ventilator_Handle* const handle);
@@ -126,8 +127,8 @@ void Ventilator_Init(Ventilator_Handle* const handle)
 
     // Inicijalizuj runtime varijable (one se ne cuvaju u EEPROM-u).
     handle->flags = 0;
-    handle->delayOnTimerStart = 0;
-    handle->delayOffTimerStart = 0;
+    TimerWheel_Stop(&handle->delayOnTimer);
+    TimerWheel_Stop(&handle->delayOffTimer);
 }
 
 /**
@@ -160,8 +161,6 @@ void Ventilator_Service(Ventilator_Handle* const handle)
     }
 
     // Pozovi privatne pomocne funkcije da obave posao.
-    HandleDelayOffTimer(handle);
-    HandleDelayOnTimer(handle);
     HandleTriggerSources(handle);
     HandleVentilatorStatusChanges(handle);
 
@@ -189,7 +188,9 @@ void Ventilator_Service(Ventilator_Handle* const handle)
 // << IZMJENA: Uklonjen 'static' da bi funkcija postala javna.
 void Ventilator_SetDefault(Ventilator_Handle* const handle)
 {
-    // KORAK 1: Sigurnosno nuliranje cijele strukture.
+    // KORAK 1: Sigurnosno nuliranje cijele strukture (aktivni tajmeri se prvo skidaju iz tocka).
+    TimerWheel_Stop(&handle->delayOnTimer);
+    TimerWheel_Stop(&handle->delayOffTimer);
     memset(handle, 0, sizeof(struct Ventilator_s));
 
     // KORAK 2: Eksplicitno postavljanje default vrijednosti.
@@ -203,8 +204,6 @@ void Ventilator_SetDefault(Ventilator_Handle* const handle)
     handle->config.local_pin = 0;
 
     // Runtime parametri se takoder resetuju.
-    handle->delayOnTimerStart = 0;
-    handle->delayOffTimerStart = 0;
     handle->flags = 0;
 }
 // --- Grupa 2: Getteri i Setteri za Konfiguraciju ---
@@ -259,25 +258,23 @@ void Ventilator_On(Ventilator_Handle* const handle, const bool useDelay)
     if(!Ventilator_isConfigured(handle)) return;
 
     // Ako stigne komanda za paljenje, poniti eventualni tajmer za gaenje.
-    handle->delayOffTimerStart = 0;
+    TimerWheel_Stop(&handle->delayOffTimer);
 
     if(useDelay && (handle->config.delayOnTime > 0))
     {
         // Ako je odloeno paljenje aktivno, samo pokreni tajmer.
-        handle->delayOnTimerStart = HAL_GetTick();
-        if(!handle->delayOnTimerStart) handle->delayOnTimerStart = 1; // Osiguraj da nije 0
+        TimerWheel_Start(&handle->delayOnTimer, handle->config.delayOnTime * VENTILATOR_TIMER_FACTOR, DelayOnTimerExpired, handle);
     }
     else
     {
         // Inace, odmah upali ventilator.
-        handle->delayOnTimerStart = 0; // Poniti tajmer za ukljucenje
+        TimerWheel_Stop(&handle->delayOnTimer); // Poniti tajmer za ukljucenje
         handle->flags |= VENTILATOR_FLAG_ACTIVE; // Postavi fleg za aktivnost
 
         // Ako je `delayOffTime` podeeno, pokreni tajmer za automatsko gaenje.
         if (handle->config.delayOffTime > 0)
         {
-            handle->delayOffTimerStart = HAL_GetTick();
-            if(!handle->delayOffTimerStart) handle->delayOffTimerStart = 1;
+            TimerWheel_Start(&handle->delayOffTimer, handle->config.delayOffTime * VENTILATOR_TIMER_FACTOR, DelayOffTimerExpired, handle);
         }
     }
 }
@@ -292,8 +289,8 @@ void Ventilator_Off(Ventilator_Handle* const handle)
 
     // Rucna komanda za iskljucenje ima najvii prioritet.
     // Ponitavamo sve tajmere i odmah gasimo ventilator.
-    handle->delayOnTimerStart = 0;
-    handle->delayOffTimerStart = 0;
+    TimerWheel_Stop(&handle->delayOnTimer);
+    TimerWheel_Stop(&handle->delayOffTimer);
     handle->flags &= ~VENTILATOR_FLAG_ACTIVE;
 }
 
@@ -323,31 +320,34 @@ static bool Ventilator_isConfigured(const Ventilator_Handle* const handle)
 }
 
 /**
- * @brief Provjerava i upravlja tajmerom za odloeno iskljucivanje.
- * @param handle Pointer na instancu ventilatora.
+ * @brief Istek tajmera za odloeno iskljucivanje.
+ * @note  Poziva ga `TimerWheel_Service()`. Kao i ranije, tajmer djeluje samo
+ * dok je ventilator konfigurisan i odabran u meniju.
+ * @param arg Pointer na instancu ventilatora.
  */
-static void HandleDelayOffTimer(Ventilator_Handle* const handle)
+static void DelayOffTimerExpired(void* arg)
 {
-    if(handle->delayOffTimerStart && ((HAL_GetTick() - handle->delayOffTimerStart) >= (handle->config.delayOffTime * VENTILATOR_TIMER_FACTOR)))
-    {
-        handle->flags &= ~VENTILATOR_FLAG_ACTIVE; // Ugasi ventilator
-        handle->delayOffTimerStart = 0;         // Resetuj tajmer
-        DISP_SignalDynamicIconUpdate();         // Obavijesti GUI da aurira ikonicu
-    }
+    Ventilator_Handle* const handle = (Ventilator_Handle*)arg;
+
+    if (!Ventilator_isConfigured(handle) || (g_display_settings.selected_control_mode != MODE_VENTILATOR)) return;
+
+    handle->flags &= ~VENTILATOR_FLAG_ACTIVE; // Ugasi ventilator
+    DISP_SignalDynamicIconUpdate();         // Obavijesti GUI da aurira ikonicu
 }
 
 /**
- * @brief Provjerava i upravlja tajmerom za odloeno ukljucivanje.
- * @param handle Pointer na instancu ventilatora.
+ * @brief Istek tajmera za odloeno ukljucivanje.
+ * @note  Poziva ga `TimerWheel_Service()`, uz iste uslove kao `DelayOffTimerExpired`.
+ * @param arg Pointer na instancu ventilatora.
  */
-static void HandleDelayOnTimer(Ventilator_Handle* const handle)
+static void DelayOnTimerExpired(void* arg)
 {
-    if(handle->delayOnTimerStart && ((HAL_GetTick() - handle->delayOnTimerStart) >= (handle->config.delayOnTime * VENTILATOR_TIMER_FACTOR)))
-    {
-        handle->flags |= VENTILATOR_FLAG_ACTIVE; // Upali ventilator
-        handle->delayOnTimerStart = 0;          // Resetuj tajmer
-        DISP_SignalDynamicIconUpdate();         // Obavijesti GUI da aurira ikonicu
-    }
+    Ventilator_Handle* const handle = (Ventilator_Handle*)arg;
+
+    if (!Ventilator_isConfigured(handle) || (g_display_settings.selected_control_mode != MODE_VENTILATOR)) return;
+
+    handle->flags |= VENTILATOR_FLAG_ACTIVE; // Upali ventilator
+    DISP_SignalDynamicIconUpdate();         // Obavijesti GUI da aurira ikonicu
 }
 
 /**
@@ -384,8 +384,7 @@ static void HandleTriggerSources(Ventilator_Handle* const handle)
         } else { // Stanje se promijenilo sa ON na OFF
             // Ne gasi se odmah, nego se pokrece tajmer za odloeno gaenje
             if (handle->config.delayOffTime > 0) {
-                handle->delayOffTimerStart = HAL_GetTick();
-                if (!handle->delayOffTimerStart) handle->delayOffTimerStart = 1;
+                TimerWheel_Start(&handle->delayOffTimer, handle->config.delayOffTime * VENTILATOR_TIMER_FACTOR, DelayOffTimerExpired, handle);
             }
         }
         old_trigger_state = current_trigger_state;
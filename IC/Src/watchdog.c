@@ -0,0 +1,243 @@
+/**
+ ******************************************************************************
+ * @file    watchdog.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Implementacija detektora izgladnjivanja IWDG-a.
+ *
+ * @note    Log zauzima RTC backup registre DR13..DR31 (DR1..DR5 koristi RTC,
+ * DR10..DR12 bootloader). DR13 je zaglavlje i broj IWDG reseta, DR14 tekući
+ * zadatak i zadatak koji se izvršavao pri posljednjem IWDG resetu, DR15
+ * prekoračenja prolaza planera, a DR16.. po jedan registar za svaki zadatak:
+ * broj prekoračenja budžeta (gornjih 16 bita) i najduže trajanje u
+ * jedinicama od 100 us (donjih 16 bita). Brojači su zasićeni na 65535.
+ *
+ * Tekući zadatak se pamti samo u RAM-u (`Watchdog_Mark` se poziva prije
+ * svakog zadatka). U DR14 ga upisuje `Watchdog_Tick` iz SysTick prekida,
+ * tek kada IWDG nije osvježen duže od `WATCHDOG_PASS_WARN_MS`, što je
+ * mnogo prije nego što IWDG može isteći.
+ ******************************************************************************
+ */
+
+#if (__WATCHDOG_H__ != FW_BUILD)
+#error "watchdog header version mismatch"
+#endif
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "main.h"
+#include "watchdog.h"
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define WDG_REG_HEADER                  RTC_BKP_DR13
+#define WDG_REG_MARK                    RTC_BKP_DR14
+#define WDG_REG_PASS                    RTC_BKP_DR15
+#define WDG_REG_TASK(i)                 (RTC_BKP_DR16 + (i))
+#define WDG_MAGIC                       0x5744U         ///< "WD" u gornjih 16 bita DR13
+#define WDG_WORST_UNIT_US               100U            ///< Jedinica najdužeg trajanja zadatka
+
+#define WDG_SUMMARY_RECORD_SIZE         7U      ///< Veličina zbirnog zapisa u bajtima
+#define WDG_TASK_RECORD_SIZE            5U      ///< Veličina zapisa zadatka u bajtima
+#define WDG_HEADER_SIZE                 4U      ///< subcmd, stranica, ukupno, broj zapisa (kao profiler)
+
+#if ((16U + WATCHDOG_LOG_TASKS) > RTC_BKP_NUMBER)     // DR16 + broj zadataka
+#error "WATCHDOG_LOG_TASKS ne stane u RTC backup registre"
+#endif
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static volatile uint8_t wdg_mark = WATCHDOG_MARK_INIT;  ///< Tekući zadatak (samo RAM)
+static volatile uint16_t wdg_saved = 0xFFFFU;           ///< Oznaka upisana u DR14, 0xFFFF = nije upisana od osvježavanja
+static volatile uint32_t wdg_kick_tick;                 ///< `HAL_GetTick` posljednjeg osvježavanja IWDG-a
+static volatile bool wdg_armed;                         ///< Backup domen je dostupan (`Watchdog_Init`)
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static uint8_t* Watchdog_Put16(uint8_t* p, uint32_t value)
+{
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = (uint8_t)(value & 0xFFU);
+    return p;
+}
+
+/**
+ * @brief Uvećava brojač u gornjih 16 bita i pamti najveću vrijednost u donjih.
+ */
+static void Watchdog_Accumulate(uint32_t reg, uint32_t value)
+{
+    uint32_t word = HAL_RTCEx_BKUPRead(&hrtc, reg);
+    uint32_t count = word >> 16;
+
+    if (value > 0xFFFFU) value = 0xFFFFU;
+    if (count < 0xFFFFU) count++;
+    if (value < (word & 0xFFFFU)) value = word & 0xFFFFU;
+    HAL_RTCEx_BKUPWrite(&hrtc, reg, (count << 16) | value);
+}
+
+/*============================================================================*/
+/* JAVNE FUNKCIJE                                                             */
+/*============================================================================*/
+
+/**
+ * @brief Provjerava log i bilježi IWDG reset ako je on uzrok pokretanja.
+ * @param reset_source Uzrok reseta iz `SaveResetSrc` (`IWDG_RESET`, ...).
+ * @note  Poziva se nakon `MX_RTC_Init`, jer je tada backup domen dostupan.
+ */
+void Watchdog_Init(uint8_t reset_source)
+{
+    uint32_t header = HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_HEADER);
+    uint32_t mark;
+
+    if ((header >> 16) != WDG_MAGIC)
+    {
+        Watchdog_Clear();
+        header = HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_HEADER);
+    }
+
+    mark = HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_MARK);
+    if (reset_source == IWDG_RESET)
+    {
+        if ((header & 0xFFFFU) < 0xFFFFU) header++;
+        HAL_RTCEx_BKUPWrite(&hrtc, WDG_REG_HEADER, header);
+        // Zadatak koji se izvršavao kada je IWDG istekao
+        mark = (mark & 0xFFU) << 8;
+    }
+    HAL_RTCEx_BKUPWrite(&hrtc, WDG_REG_MARK, (mark & 0xFF00U) | WATCHDOG_MARK_INIT);
+    wdg_saved = WATCHDOG_MARK_INIT;
+    wdg_armed = true;
+}
+
+/**
+ * @brief Briše cijeli log; oznaka tekućeg zadatka ostaje.
+ */
+void Watchdog_Clear(void)
+{
+    uint32_t mark = HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_MARK);
+
+    HAL_RTCEx_BKUPWrite(&hrtc, WDG_REG_HEADER, (uint32_t)WDG_MAGIC << 16);
+    HAL_RTCEx_BKUPWrite(&hrtc, WDG_REG_MARK, ((uint32_t)WATCHDOG_MARK_NONE << 8) | (mark & 0xFFU));
+    HAL_RTCEx_BKUPWrite(&hrtc, WDG_REG_PASS, 0U);
+    for (uint32_t i = 0U; i < WATCHDOG_LOG_TASKS; i++)
+    {
+        HAL_RTCEx_BKUPWrite(&hrtc, WDG_REG_TASK(i), 0U);
+    }
+}
+
+/**
+ * @brief Pamti šta se trenutno izvršava, samo u RAM-u.
+ * @param mark Indeks zadatka + 1 ili `WATCHDOG_MARK_SCHED`.
+ */
+void Watchdog_Mark(uint8_t mark)
+{
+    wdg_mark = mark;
+}
+
+/**
+ * @brief Prolaz planera je završen i IWDG će biti osvježen.
+ */
+void Watchdog_Kick(void)
+{
+    wdg_kick_tick = HAL_GetTick();
+    wdg_saved = 0xFFFFU;
+}
+
+/**
+ * @brief Rano upozorenje, poziva se iz SysTick prekida svake milisekunde.
+ * @note  Kada IWDG nije osvježen duže od `WATCHDOG_PASS_WARN_MS`, upisuje
+ * tekući zadatak u backup registar, jednom za svaku novu oznaku. Nakon
+ * IWDG reseta `Watchdog_Init` ga tako nalazi, a u normalnom radu se backup
+ * registar ne dira.
+ */
+void Watchdog_Tick(void)
+{
+    uint8_t mark = wdg_mark;
+    uint32_t word;
+
+    if (!wdg_armed || ((HAL_GetTick() - wdg_kick_tick) <= WATCHDOG_PASS_WARN_MS)) return;
+    if (wdg_saved == mark) return;
+    word = HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_MARK);
+    HAL_RTCEx_BKUPWrite(&hrtc, WDG_REG_MARK, (word & 0xFF00U) | mark);
+    wdg_saved = mark;
+}
+
+/**
+ * @brief Bilježi zadatak koji je prekoračio svoj budžet.
+ * @param index Indeks zadatka u tabeli planera.
+ * @param us    Trajanje izvršavanja.
+ */
+void Watchdog_TaskOverrun(uint8_t index, uint32_t us)
+{
+    if (index >= WATCHDOG_LOG_TASKS) return;
+    Watchdog_Accumulate(WDG_REG_TASK(index), (us + WDG_WORST_UNIT_US - 1U) / WDG_WORST_UNIT_US);
+}
+
+/**
+ * @brief Bilježi prolaz planera duži od `WATCHDOG_PASS_WARN_MS`.
+ */
+void Watchdog_PassOverrun(uint32_t ms)
+{
+    Watchdog_Accumulate(WDG_REG_PASS, ms);
+}
+
+/**
+ * @brief Pakuje log u odgovor na `DIAG_GET`.
+ * @param subcmd `DIAG_WDG_LOG` ili `DIAG_WDG_CLEAR`.
+ * @param page   Ne koristi se, log stane u jednu stranicu.
+ * @param buf    Bafer za odgovor.
+ * @param size   Veličina bafera.
+ * @retval Dužina odgovora, 0 za nepoznatu pod-komandu.
+ * @note  Zaglavlje je isto kao kod profilera: treći bajt je ukupan broj
+ * zapisa zadataka, četvrti broj zapisa u ovom odgovoru. Zbirni zapis: broj IWDG
+ * reseta, oznaka zadatka pri posljednjem IWDG resetu (indeks + 1,
+ * `WATCHDOG_MARK_xxx`), broj i najduži prolaz planera preko praga (ms).
+ * Zatim po jedan zapis za svaki zadatak sa prekoračenjem: indeks, broj
+ * prekoračenja, najduže trajanje (jedinice od 100 us).
+ */
+uint16_t Watchdog_Serialize(uint8_t subcmd, uint8_t page, uint8_t* buf, uint16_t size)
+{
+    uint8_t* p = buf + WDG_HEADER_SIZE;
+    uint8_t total = 0U;
+    uint8_t n = 0U;
+    uint32_t word;
+
+    if (size < WDG_HEADER_SIZE + WDG_SUMMARY_RECORD_SIZE) return 0U;
+
+    switch (subcmd)
+    {
+    case DIAG_WDG_LOG:
+        p = Watchdog_Put16(p, HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_HEADER) & 0xFFFFU);
+        *p++ = (uint8_t)(HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_MARK) >> 8);
+        word = HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_PASS);
+        p = Watchdog_Put16(p, word >> 16);
+        p = Watchdog_Put16(p, word & 0xFFFFU);
+        for (uint8_t i = 0U; i < WATCHDOG_LOG_TASKS; i++)
+        {
+            word = HAL_RTCEx_BKUPRead(&hrtc, WDG_REG_TASK(i));
+            if (word == 0U) continue;
+            total++;
+            if ((uint16_t)(p - buf) + WDG_TASK_RECORD_SIZE > size) continue;
+            *p++ = i;
+            p = Watchdog_Put16(p, word >> 16);
+            p = Watchdog_Put16(p, word & 0xFFFFU);
+            n++;
+        }
+        break;
+
+    case DIAG_WDG_CLEAR:
+        Watchdog_Clear();
+        break;
+
+    default:
+        return 0U;
+    }
+
+    buf[0] = subcmd;
+    buf[1] = page;
+    buf[2] = total;
+    buf[3] = n;
+    return (uint16_t)(p - buf);
+}
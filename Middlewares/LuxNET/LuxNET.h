@@ -39,6 +39,7 @@ typedef enum {
     THERMOSTAT_RESET    = 42,   // reinicijalizacija termostat aplikacije ne cijelog kontrolera, prinudni prolazak kroz init funkciju termostata
     THERMOSTAT_SETUP    = 43,   // cijela nova termostat struktura parametara....  treba definisat termostat strukturu
     THERMOSTAT_INFO     = 44,   // izmjerena nova temperature senzora, promjenjena zadana temeratura, termostat isključen.... treba definisat info strukturu
+    THERMOSTAT_SYNC     = 45,   // broadcast sinhronizacija grupe termostata: samo promijenjena polja, redni broj, bez odgovora (thermostat_sync.h)
     // ostavi prostora za dopune
     CUSTOM              = 48,
     QR_REQUEST			= 49,	// zahtjev za qr kod sa uSD kartice ili upis novog qr koda
@@ -48,6 +49,7 @@ typedef enum {
     CONTEROLLER_GET     = 53,   // uzmi cijelu strukturu kontrolera sve pinove sve registre
     CONTROLLER_SET      = 54,   // upiši cijelu strukturu kontrolera i reinicijalizuj 
     SCENE_CONTROL       = 55,   // Poruka za sinhronizaciju aktivacije scena između displeja.
+    DIAG_GET            = 56,   // dijagnostika uređaja: [adresa, pod-komanda, stranica], odgovor zavisi od pod-komande
     // ostavi prostora za dopune
     DIN_GET             = 60,   // expliicitan upit stanja digitalnog ulaza
     DIN_EVENT           = 61    // Poruka koju šalje modul sa ulazima kada detektuje promjenu stanja.
@@ -192,6 +192,12 @@ Rx and Tx. If you can't run the demos, the source files are still good as exampl
 #define TF_LEN_BYTES    2
 #define TF_TYPE_BYTES   1
 #define TF_CKSUM_TYPE TF_CKSUM_CRC16
+#ifndef TF_CRC16_BACKEND
+#define TF_CRC16_BACKEND TF_CRC16_HW    // CRC periferija, TF_CksumHwAdd() u rs485.c
+#endif
+#ifndef TF_CRITICAL
+#define TF_CRITICAL 1                   // PRIMASK oko izmjena listenera (SysTick, USART1 prekid, glavna petlja)
+#endif
 #define TF_USE_SOF_BYTE 1
 #define TF_SOF_BYTE     0x01
 typedef uint16_t TF_TICKS;
@@ -25,6 +25,28 @@
 #define TF_TRY(func) do { if(!(func)) return false; } while (0)
 
 
+// Listener tables are changed from three contexts: the main loop (TF_Query*),
+// TF_Tick() in SysTick and the parser in the UART RX interrupt. With TF_CRITICAL
+// (TF_Config.h) every change of the ID hash, the deadline list and the type
+// chains runs with interrupts off.
+#if TF_CRITICAL
+    static __inline uint32_t tf_lock(void){
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        return primask;
+    }
+    static __inline void tf_unlock(uint32_t primask){
+        __set_PRIMASK(primask);
+    }
+#else
+    static __inline uint32_t tf_lock(void){
+        return 0;
+    }
+    static __inline void tf_unlock(uint32_t primask){
+        (void) primask;
+    }
+#endif
+
 // Type-dependent masks for bit manipulation in the ID field
 #define TF_ID_MASK (TF_ID)(((TF_ID)1 << (sizeof(TF_ID)*8 - 1)) - 1)
 #define TF_ID_PEERBIT (TF_ID)((TF_ID)1 << ((sizeof(TF_ID)*8) - 1))
@@ -145,6 +167,58 @@
         return cksum; 
     }
 
+  #if TF_CRC16_BACKEND == TF_CRC16_SLICE8
+    /** crc16_slice[k][i]: CRC of byte i followed by k zero bytes; [0] is crc16_table */
+    static uint16_t crc16_slice[8][256];
+    static bool crc16_slice_ready;
+
+    static void crc16_slice_init(void){
+        uint32_t i, k;
+        uint16_t v;
+        if (crc16_slice_ready) return;
+        for (i = 0; i < 256; i++) {
+            crc16_slice[0][i] = crc16_table[i];
+        }
+        for (k = 1; k < 8; k++) {
+            for (i = 0; i < 256; i++) {
+                v = crc16_slice[k - 1][i];
+                crc16_slice[k][i] = (uint16_t) ((v >> 8) ^ crc16_table[v & 0xff]);
+            }
+        }
+        crc16_slice_ready = true;
+    }
+
+    /** Eight bytes per step; the first two are folded into the running CRC */
+    static TF_CKSUM TF_CksumAddBuf(TF_CKSUM cksum, const uint8_t *buf, uint32_t len){
+        uint16_t crc = cksum;
+        while (len >= 8) {
+            crc ^= (uint16_t) (buf[0] | (buf[1] << 8));
+            crc = crc16_slice[7][crc & 0xff] ^ crc16_slice[6][crc >> 8] ^
+                  crc16_slice[5][buf[2]] ^ crc16_slice[4][buf[3]] ^
+                  crc16_slice[3][buf[4]] ^ crc16_slice[2][buf[5]] ^
+                  crc16_slice[1][buf[6]] ^ crc16_slice[0][buf[7]];
+            buf += 8;
+            len -= 8;
+        }
+        while (len--) {
+            crc = (crc >> 8) ^ crc16_table[(crc ^ *buf++) & 0xff];
+        }
+        return crc;
+    }
+    #define TF_HAVE_CKSUM_ADD_BUF
+  #elif TF_CRC16_BACKEND == TF_CRC16_HW
+    static TF_CKSUM TF_CksumAddBuf(TF_CKSUM cksum, const uint8_t *buf, uint32_t len){
+        if ((len >= TF_CRC16_HW_MIN_LEN) && TF_CksumHwAdd(&cksum, buf, len)) {
+            return cksum;
+        }
+        while (len--) {
+            cksum = TF_CksumAdd(cksum, *buf++);
+        }
+        return cksum;
+    }
+    #define TF_HAVE_CKSUM_ADD_BUF
+  #endif
+
 #elif TF_CKSUM_TYPE == TF_CKSUM_CRC32	// nepotrebno - imamo hardwerski modul na STM32-u
 
     // TODO try to replace with an algorithm
@@ -204,9 +278,20 @@
     }
 #endif
 
+#ifndef TF_HAVE_CKSUM_ADD_BUF
+    /** Add a block of bytes (payload); byte by byte unless the checksum has a faster way */
+    static TF_CKSUM TF_CksumAddBuf(TF_CKSUM cksum, const uint8_t *buf, uint32_t len){
+        while (len--) {
+            cksum = TF_CksumAdd(cksum, *buf++);
+        }
+        return cksum;
+    }
+#endif
+
 #define CKSUM_RESET(cksum)     do { (cksum) = TF_CksumStart(); } while (0)
 #define CKSUM_ADD(cksum, byte) do { (cksum) = TF_CksumAdd((cksum), (byte)); } while (0)
 #define CKSUM_FINALIZE(cksum)  do { (cksum) = TF_CksumEnd((cksum)); } while (0)
+#define CKSUM_ADD_BUF(cksum, buf, len) do { (cksum) = TF_CksumAddBuf((cksum), (buf), (len)); } while (0)
 //endregion
 //region Init
 /** Init with a user-allocated buffer */
@@ -224,6 +309,9 @@ bool _TF_FN TF_InitStatic(TinyFrame *tf, TF_Peer peer_bit){
     tf->usertag = usertag;
     tf->userdata = userdata;
     tf->peer_bit = peer_bit;
+#if (TF_CKSUM_TYPE == TF_CKSUM_CRC16) && (TF_CRC16_BACKEND == TF_CRC16_SLICE8)
+    crc16_slice_init();
+#endif
     return true;
 }
 
@@ -252,9 +340,123 @@ void TF_DeInit(TinyFrame *tf){
 //	u kontroli za kucu, jer predstavlja bolnu tacku čijim otkazom
 //  prestaju i sve ostale ispravne funkcije sistema
 //
+// Listener lookup is O(1): ID listeners are found through an open-addressed
+// hash (linear probing, backward-shift removal), type listeners through a
+// table indexed by the low type byte with a chain of slots per entry, and
+// ID listener timeouts are kept in a list sorted by deadline, so TF_Tick()
+// only looks at its head. The helpers below expect tf_lock() to be held,
+// listener callbacks are always called with interrupts enabled.
+//
+
+#define TF_ID_HASH(id)      ((TF_COUNT)(((id) ^ ((id) >> 7)) & (TF_ID_HASH_SIZE - 1)))
+#define TF_ID_HASH_NEXT(i)  ((TF_COUNT)(((i) + 1) & (TF_ID_HASH_SIZE - 1)))
+#define TF_TYPE_INDEX(type) ((uint8_t)(type))
+/** True if tick value a comes before b (wrap-safe for timeouts below half the TF_TICKS range) */
+#define TF_TICKS_BEFORE(a, b) ((TF_TICKS)((a) - (b)) > (TF_TICKS)(((TF_TICKS)~(TF_TICKS)0) >> 1))
+
+/** Put ID listener slot i into the hash */
+static void _TF_FN id_hash_insert(TinyFrame *tf, TF_COUNT i){
+    TF_COUNT pos = TF_ID_HASH(tf->id_listeners[i].id);
+    while (tf->id_hash[pos] != 0) {
+        pos = TF_ID_HASH_NEXT(pos);
+    }
+    tf->id_hash[pos] = (TF_COUNT) (i + 1);
+}
+
+/** Remove ID listener slot i from the hash, moving back entries of its probe run */
+static void _TF_FN id_hash_remove(TinyFrame *tf, TF_COUNT i){
+    TF_COUNT pos = TF_ID_HASH(tf->id_listeners[i].id);
+    TF_COUNT next, home;
+    while (tf->id_hash[pos] != (TF_COUNT) (i + 1)) {
+        if (tf->id_hash[pos] == 0) return; // not in the hash
+        pos = TF_ID_HASH_NEXT(pos);
+    }
+    for (;;) {
+        next = pos;
+        do {
+            next = TF_ID_HASH_NEXT(next);
+            if (tf->id_hash[next] == 0) {
+                tf->id_hash[pos] = 0;
+                return;
+            }
+            home = TF_ID_HASH(tf->id_listeners[tf->id_hash[next] - 1].id);
+            // an entry whose home lies cyclically in (pos, next] must stay where it is
+        } while ((pos <= next) ? (pos < home && home <= next) : (pos < home || home <= next));
+        tf->id_hash[pos] = tf->id_hash[next];
+        pos = next;
+    }
+}
+
+/** Find the first live ID listener for the ID, returns slot + 1 or 0 */
+static TF_COUNT _TF_FN id_hash_find(TinyFrame *tf, TF_ID id){
+    TF_COUNT pos = TF_ID_HASH(id);
+    TF_COUNT s;
+    while ((s = tf->id_hash[pos]) != 0) {
+        if (tf->id_listeners[s - 1].id == id) return s;
+        pos = TF_ID_HASH_NEXT(pos);
+    }
+    return 0;
+}
+
+/** Insert ID listener slot i into the deadline list; new deadlines are usually the latest */
+static void _TF_FN timeout_insert(TinyFrame *tf, TF_COUNT i){
+    struct TF_IdListener_ *lst = &tf->id_listeners[i];
+    TF_COUNT prev = tf->timeout_tail;
+    while (prev != 0 && TF_TICKS_BEFORE(lst->deadline, tf->id_listeners[prev - 1].deadline)) {
+        prev = tf->id_listeners[prev - 1].tprev;
+    }
+    lst->tprev = prev;
+    lst->tnext = (prev != 0) ? tf->id_listeners[prev - 1].tnext : tf->timeout_head;
+    if (lst->tnext != 0) tf->id_listeners[lst->tnext - 1].tprev = (TF_COUNT) (i + 1);
+    else tf->timeout_tail = (TF_COUNT) (i + 1);
+    if (prev != 0) tf->id_listeners[prev - 1].tnext = (TF_COUNT) (i + 1);
+    else tf->timeout_head = (TF_COUNT) (i + 1);
+}
+
+/** Take ID listener slot i out of the deadline list (no-op if it has no timeout) */
+static void _TF_FN timeout_remove(TinyFrame *tf, TF_COUNT i){
+    struct TF_IdListener_ *lst = &tf->id_listeners[i];
+    if (lst->timeout_max == 0) return;
+    if (lst->tprev != 0) tf->id_listeners[lst->tprev - 1].tnext = lst->tnext;
+    else tf->timeout_head = lst->tnext;
+    if (lst->tnext != 0) tf->id_listeners[lst->tnext - 1].tprev = lst->tprev;
+    else tf->timeout_tail = lst->tprev;
+    lst->tprev = lst->tnext = 0;
+}
+
 /** Reset ID listener's timeout to the original value */
-static __inline void _TF_FN renew_id_listener(struct TF_IdListener_ *lst){
-    lst->timeout = lst->timeout_max;
+static void _TF_FN renew_id_listener(TinyFrame *tf, TF_COUNT i){
+    struct TF_IdListener_ *lst = &tf->id_listeners[i];
+    uint32_t primask;
+    if (lst->timeout_max == 0) return;
+    primask = tf_lock();
+    timeout_remove(tf, i);
+    lst->deadline = (TF_TICKS) (tf->ticks + lst->timeout_max);
+    timeout_insert(tf, i);
+    tf_unlock(primask);
+}
+
+/** Unlink ID listener slot i and free it, keeping what the cleanup call needs (lock held) */
+static bool _TF_FN detach_id_listener(TinyFrame *tf, TF_COUNT i, TF_Msg *msg, TF_Listener *fn){
+    struct TF_IdListener_ *lst = &tf->id_listeners[i];
+    if (lst->fn == NULL) return false;
+    // Unlink first, the callback may register a new listener for the same ID
+    id_hash_remove(tf, i);
+    timeout_remove(tf, i);
+    *fn = lst->fn;
+    msg->userdata = lst->userdata;
+    msg->userdata2 = lst->userdata2;
+    msg->data = NULL; // this is a signal that the listener should clean up
+    lst->fn = NULL; // Discard listener
+    return true;
+}
+
+/** Let the callback of a detached ID listener free any resources in userdata */
+static void _TF_FN notify_id_listener(TinyFrame *tf, TF_Msg *msg, TF_Listener fn){
+    // Make user clean up their data - only if not NULL
+    if (msg->userdata != NULL || msg->userdata2 != NULL) {
+        fn(tf, msg); // return value is ignored here - use TF_STAY or TF_CLOSE
+    }
 }
 //
 // postoji greška u ovoj funkciji, jer se pointeri na ->userdata bufere mogu promjeniti unutar 
@@ -262,35 +464,36 @@ static __inline void _TF_FN renew_id_listener(struct TF_IdListener_ *lst){
 // koja može uništit fajl ili registar adresiran pointerom....
 //
 /** Notify callback about ID listener's demise & let it free any resources in userdata */
-static void _TF_FN cleanup_id_listener(TinyFrame *tf, TF_COUNT i, struct TF_IdListener_ *lst){
+static void _TF_FN cleanup_id_listener(TinyFrame *tf, TF_COUNT i){
     TF_Msg msg;
-    if (lst->fn == NULL) return;
-    // Make user clean up their data - only if not NULL
-    if (lst->userdata != NULL || lst->userdata2 != NULL) {
-        msg.userdata = lst->userdata;
-        msg.userdata2 = lst->userdata2;
-        msg.data = NULL; // this is a signal that the listener should clean up
-        lst->fn(tf, &msg); // return value is ignored here - use TF_STAY or TF_CLOSE
-    }
-    lst->fn = NULL; // Discard listener
-    if (i == tf->count_id_lst - 1) {
-        tf->count_id_lst--;
-    }
+    TF_Listener fn;
+    uint32_t primask = tf_lock();
+    bool detached = detach_id_listener(tf, i, &msg, &fn);
+    tf_unlock(primask);
+    if (detached) notify_id_listener(tf, &msg, fn);
 }
 
 /** Clean up Type listener */
-static __inline void _TF_FN cleanup_type_listener(TinyFrame *tf, TF_COUNT i, struct TF_TypeListener_ *lst){
-    lst->fn = NULL; // Discard listener
-    if (i == tf->count_type_lst - 1) {
-        tf->count_type_lst--;
+static void _TF_FN cleanup_type_listener(TinyFrame *tf, TF_COUNT i){
+    struct TF_TypeListener_ *lst = &tf->type_listeners[i];
+    uint32_t primask = tf_lock();
+    TF_COUNT *link = &tf->type_index[TF_TYPE_INDEX(lst->type)];
+    while (*link != 0 && *link != (TF_COUNT) (i + 1)) {
+        link = &tf->type_listeners[*link - 1].next;
     }
+    if (*link != 0) *link = lst->next;
+    lst->next = 0;
+    lst->fn = NULL; // Discard listener
+    tf_unlock(primask);
 }
 /** Clean up Generic listener */
 static __inline void _TF_FN cleanup_generic_listener(TinyFrame *tf, TF_COUNT i, struct TF_GenericListener_ *lst){
+    uint32_t primask = tf_lock();
     lst->fn = NULL; // Discard listener
     if (i == tf->count_generic_lst - 1){
         tf->count_generic_lst--;
     }
+    tf_unlock(primask);
 }
 //
 //	za svaki poslani telegram otvarati po jedan ID listener dok god ima slobodne RAM memorije
@@ -301,6 +504,7 @@ static __inline void _TF_FN cleanup_generic_listener(TinyFrame *tf, TF_COUNT i,
 bool _TF_FN TF_AddIdListener(TinyFrame *tf, TF_Msg *msg, TF_Listener cb, TF_TICKS timeout){
     TF_COUNT i;
     struct TF_IdListener_ *lst;
+    uint32_t primask = tf_lock();
     for (i = 0; i < TF_MAX_ID_LST; i++){
         lst = &tf->id_listeners[i];
         // test for empty slot
@@ -309,13 +513,18 @@ bool _TF_FN TF_AddIdListener(TinyFrame *tf, TF_Msg *msg, TF_Listener cb, TF_TICK
             lst->id = msg->frame_id;
             lst->userdata = msg->userdata;
             lst->userdata2 = msg->userdata2;
-            lst->timeout_max = lst->timeout = timeout;
-            if (i >= tf->count_id_lst){
-                tf->count_id_lst = (TF_COUNT) (i + 1);
+            lst->timeout_max = timeout;
+            lst->tprev = lst->tnext = 0;
+            id_hash_insert(tf, i);
+            if (timeout != 0) {
+                lst->deadline = (TF_TICKS) (tf->ticks + timeout);
+                timeout_insert(tf, i);
             }
+            tf_unlock(primask);
             return true;
         }
     }
+    tf_unlock(primask);
     TF_Error("Failed to add ID listener");
     return false;
 }
@@ -328,19 +537,27 @@ bool _TF_FN TF_AddIdListener(TinyFrame *tf, TF_Msg *msg, TF_Listener cb, TF_TICK
 /** Add a new Type listener. Returns 1 on success. */
 bool _TF_FN TF_AddTypeListener(TinyFrame *tf, TF_TYPE frame_type, TF_Listener cb){
     TF_COUNT i;
+    TF_COUNT *link;
     struct TF_TypeListener_ *lst;
+    uint32_t primask = tf_lock();
     for (i = 0; i < TF_MAX_TYPE_LST; i++) {
         lst = &tf->type_listeners[i];
         // test for empty slot
         if (lst->fn == NULL) {
             lst->fn = cb;
             lst->type = frame_type;
-            if (i >= tf->count_type_lst) {
-                tf->count_type_lst = (TF_COUNT) (i + 1);
+            // keep the chain in slot order, same order the listeners used to be scanned in
+            link = &tf->type_index[TF_TYPE_INDEX(frame_type)];
+            while (*link != 0 && *link < (TF_COUNT) (i + 1)) {
+                link = &tf->type_listeners[*link - 1].next;
             }
+            lst->next = *link;
+            *link = (TF_COUNT) (i + 1);
+            tf_unlock(primask);
             return true;
         }
     }
+    tf_unlock(primask);
 
     TF_Error("Failed to add type listener");
     return false;
@@ -357,6 +574,7 @@ bool _TF_FN TF_AddTypeListener(TinyFrame *tf, TF_TYPE frame_type, TF_Listener cb
 bool _TF_FN TF_AddGenericListener(TinyFrame *tf, TF_Listener cb){
     TF_COUNT i;
     struct TF_GenericListener_ *lst;
+    uint32_t primask = tf_lock();
     for (i = 0; i < TF_MAX_GEN_LST; i++) {
         lst = &tf->generic_listeners[i];
         // test for empty slot
@@ -365,9 +583,11 @@ bool _TF_FN TF_AddGenericListener(TinyFrame *tf, TF_Listener cb){
             if (i >= tf->count_generic_lst) {
                 tf->count_generic_lst = (TF_COUNT) (i + 1);
             }
+            tf_unlock(primask);
             return true;
         }
     }
+    tf_unlock(primask);
 
     TF_Error("Failed to add generic listener");
     return false;
@@ -378,15 +598,16 @@ bool _TF_FN TF_AddGenericListener(TinyFrame *tf, TF_Listener cb){
 //
 /** Remove a ID listener by its frame ID. Returns 1 on success. */
 bool _TF_FN TF_RemoveIdListener(TinyFrame *tf, TF_ID frame_id){
-    TF_COUNT i;
-    struct TF_IdListener_ *lst;
-    for (i = 0; i < tf->count_id_lst; i++) {
-        lst = &tf->id_listeners[i];
-        // test if live & matching
-        if (lst->fn != NULL && lst->id == frame_id) {
-            cleanup_id_listener(tf, i, lst);
-            return true;
-        }
+    TF_Msg msg;
+    TF_Listener fn;
+    // find and unlink in one section, so that TF_Tick() can't free the slot in between
+    uint32_t primask = tf_lock();
+    TF_COUNT s = id_hash_find(tf, frame_id);
+    bool detached = (s != 0) && detach_id_listener(tf, (TF_COUNT) (s - 1), &msg, &fn);
+    tf_unlock(primask);
+    if (detached) {
+        notify_id_listener(tf, &msg, fn);
+        return true;
     }
 
     TF_Error("ID listener %d to remove not found", (int)frame_id);
@@ -395,16 +616,16 @@ bool _TF_FN TF_RemoveIdListener(TinyFrame *tf, TF_ID frame_id){
 
 /** Remove a type listener by its type. Returns 1 on success. */
 bool _TF_FN TF_RemoveTypeListener(TinyFrame *tf, TF_TYPE type){
-    TF_COUNT i;
-    struct TF_TypeListener_ *lst;
-    for (i = 0; i < tf->count_type_lst; i++) {
-        lst = &tf->type_listeners[i];
-        // test if live & matching
-        if (lst->fn != NULL    && lst->type == type) {
-            cleanup_type_listener(tf, i, lst);
+    TF_COUNT s;
+    uint32_t primask = tf_lock();
+    for (s = tf->type_index[TF_TYPE_INDEX(type)]; s != 0; s = tf->type_listeners[s - 1].next) {
+        if (tf->type_listeners[s - 1].type == type) {
+            cleanup_type_listener(tf, (TF_COUNT) (s - 1));
+            tf_unlock(primask);
             return true;
         }
     }
+    tf_unlock(primask);
 
     TF_Error("Type listener %d to remove not found", (int)type);
     return false;
@@ -430,12 +651,17 @@ bool _TF_FN TF_RemoveGenericListener(TinyFrame *tf, TF_Listener cb)
 
 /** Handle a message that was just collected & verified by the parser */
 static void _TF_FN TF_HandleReceivedMessage(TinyFrame *tf){
-    TF_COUNT i;
+    TF_COUNT i, s, next;
+    TF_Listener fn;
+    uint32_t primask;
+    bool live;
     struct TF_IdListener_ *ilst;
     struct TF_TypeListener_ *tlst;
     struct TF_GenericListener_ *glst;
     TF_Result res;
 
+    tf->rx_frames++;
+
     // Prepare message object
     TF_Msg msg;
     TF_ClearMsg(&msg);
@@ -447,45 +673,52 @@ static void _TF_FN TF_HandleReceivedMessage(TinyFrame *tf){
 
     // Any listener can consume the message, or let someone else handle it.
 
-    // The loop upper bounds are the highest currently used slot index
-    // (or close to it, depending on the order of listener removals).
+    // ID listeners first, walking the probe run of the ID. The walk runs with
+    // interrupts off (TF_Tick() may expire a listener and shift the run), the callback doesn't.
+    primask = tf_lock();
+    for (i = TF_ID_HASH(msg.frame_id); (s = tf->id_hash[i]) != 0; i = TF_ID_HASH_NEXT(i)) {
+        ilst = &tf->id_listeners[s - 1];
 
-    // ID listeners first
-    for (i = 0; i < tf->count_id_lst; i++) {
-        ilst = &tf->id_listeners[i];
-
-        if (ilst->fn && ilst->id == msg.frame_id) {
+        if (ilst->id == msg.frame_id) {
+            fn = ilst->fn;
             msg.userdata = ilst->userdata; // pass userdata pointer to the callback
             msg.userdata2 = ilst->userdata2;
-            res = ilst->fn(tf, &msg);
-            ilst->userdata = msg.userdata; // put it back (may have changed the pointer or set to NULL)
-            ilst->userdata2 = msg.userdata2; // put it back (may have changed the pointer or set to NULL)
+            tf_unlock(primask);
+            res = fn(tf, &msg);
+            primask = tf_lock();
+            // the listener may have expired in TF_Tick() while its callback ran
+            live = (ilst->fn == fn) && (ilst->id == msg.frame_id);
+            if (live) {
+                ilst->userdata = msg.userdata; // put it back (may have changed the pointer or set to NULL)
+                ilst->userdata2 = msg.userdata2; // put it back (may have changed the pointer or set to NULL)
+            }
 
             if (res != TF_NEXT) {
                 // if it's TF_CLOSE, we assume user already cleaned up userdata
-                if (res == TF_RENEW) {
-                    renew_id_listener(ilst);
+                if (live && res == TF_RENEW) {
+                    renew_id_listener(tf, (TF_COUNT) (s - 1));
                 }
-                else if (res == TF_CLOSE) {
-                    // Set userdata to NULL to avoid calling user for cleanup
-                    ilst->userdata = NULL;
-                    ilst->userdata2 = NULL;
-                    cleanup_id_listener(tf, i, ilst);
+                else if (live && res == TF_CLOSE) {
+                    // Unlink only, without calling user for cleanup
+                    (void) detach_id_listener(tf, (TF_COUNT) (s - 1), &msg, &fn);
                 }
+                tf_unlock(primask);
                 return;
             }
         }
     }
+    tf_unlock(primask);
     // clean up for the following listeners that don't use userdata (this avoids data from
     // an ID listener that returned TF_NEXT from leaking into Type and Generic listeners)
     msg.userdata = NULL;
     msg.userdata2 = NULL;
 
-    // Type listeners
-    for (i = 0; i < tf->count_type_lst; i++) {
-        tlst = &tf->type_listeners[i];
+    // Type listeners, only the chain of this type
+    for (s = tf->type_index[TF_TYPE_INDEX(msg.type)]; s != 0; s = next) {
+        tlst = &tf->type_listeners[s - 1];
+        next = tlst->next; // the callback may remove its own listener
 
-        if (tlst->fn && tlst->type == msg.type) {
+        if (tlst->type == msg.type) {
             res = tlst->fn(tf, &msg);
 
             if (res != TF_NEXT) {
@@ -493,7 +726,7 @@ static void _TF_FN TF_HandleReceivedMessage(TinyFrame *tf){
                 // TF_RENEW doesn't make sense here because type listeners don't expire = same as TF_STAY
 
                 if (res == TF_CLOSE) {
-                    cleanup_type_listener(tf, i, tlst);
+                    cleanup_type_listener(tf, (TF_COUNT) (s - 1));
                 }
                 return;
             }
@@ -527,16 +760,14 @@ static void _TF_FN TF_HandleReceivedMessage(TinyFrame *tf){
 
 /** Externally renew an ID listener */
 bool _TF_FN TF_RenewIdListener(TinyFrame *tf, TF_ID id){
-    TF_COUNT i;
-    struct TF_IdListener_ *lst;
-    for (i = 0; i < tf->count_id_lst; i++) {
-        lst = &tf->id_listeners[i];
-        // test if live & matching
-        if (lst->fn != NULL && lst->id == id) {
-            renew_id_listener(lst);
-            return true;
-        }
+    uint32_t primask = tf_lock();
+    TF_COUNT s = id_hash_find(tf, id);
+    if (s != 0) {
+        renew_id_listener(tf, (TF_COUNT) (s - 1));
+        tf_unlock(primask);
+        return true;
     }
+    tf_unlock(primask);
     TF_Error("Renew listener: not found (id %d)", (int)id);
     return false;
 }
@@ -673,7 +904,6 @@ void _TF_FN TF_AcceptChar(TinyFrame *tf, unsigned char c){
             if (tf->discard_data) {
                 tf->rxi++;
             } else {
-                CKSUM_ADD(tf->cksum, c);
                 tf->data[tf->rxi++] = c;
             }
 
@@ -683,6 +913,10 @@ void _TF_FN TF_AcceptChar(TinyFrame *tf, unsigned char c){
                     TF_HandleReceivedMessage(tf);
                     TF_ResetParser(tf);
                 #else
+                    // Payload checksum in one block once it's complete (discarded data is not checked)
+                    if (!tf->discard_data) {
+                        CKSUM_ADD_BUF(tf->cksum, tf->data, tf->len);
+                    }
                     // Enter DATA_CKSUM state
                     tf->state = TFState_DATA_CKSUM;
                     tf->rxi = 0;
@@ -808,17 +1042,9 @@ static __inline uint32_t _TF_FN TF_ComposeHead(TinyFrame *tf, uint8_t *outbuff,
  * @return nr of bytes in outbuff used
  */
 static __inline uint32_t _TF_FN TF_ComposeBody(uint8_t *outbuff,const uint8_t *data, TF_LEN data_len,TF_CKSUM *cksum){
-    TF_LEN i = 0;
-    uint8_t b = 0;
-    uint32_t pos = 0;
-
-    for (i = 0; i < data_len; i++) {
-        b = data[i];
-        outbuff[pos++] = b;
-        CKSUM_ADD(*cksum, b);
-    }
-
-    return pos;
+    memcpy(outbuff, data, data_len);
+    CKSUM_ADD_BUF(*cksum, data, data_len);
+    return data_len;
 }
 
 /**
@@ -1020,22 +1246,28 @@ void _TF_FN TF_Multipart_Close(TinyFrame *tf){
 /** Timebase hook - for timeouts */
 void _TF_FN TF_Tick(TinyFrame *tf){
     TF_COUNT i;
-    struct TF_IdListener_ *lst;
+    TF_Msg msg;
+    TF_Listener fn;
+    uint32_t primask;
 
     // increment parser timeout (timeout is handled when receiving next byte)
     if (tf->parser_timeout_ticks < TF_PARSER_TIMEOUT_TICKS) {
         tf->parser_timeout_ticks++;
     }
-    // decrement and expire ID listeners
-    for (i = 0; i < tf->count_id_lst; i++) {
-        lst = &tf->id_listeners[i];
-        if (!lst->fn || lst->timeout == 0) continue;
-        // count down...
-        if (--lst->timeout == 0) {
-            TF_Error("ID listener %d has expired", (int)lst->id);
-            // Listener has expired
-            cleanup_id_listener(tf, i, lst);
+    // expire ID listeners; the list is sorted by deadline, so stop at the first one still running
+    tf->ticks++;
+    for (;;) {
+        primask = tf_lock();
+        i = tf->timeout_head;
+        if (i == 0 || TF_TICKS_BEFORE(tf->ticks, tf->id_listeners[i - 1].deadline)) {
+            tf_unlock(primask);
+            break;
         }
+        TF_Error("ID listener %d has expired", (int)tf->id_listeners[i - 1].id);
+        // Listener has expired
+        (void) detach_id_listener(tf, (TF_COUNT) (i - 1), &msg, &fn);
+        tf_unlock(primask);
+        notify_id_listener(tf, &msg, fn);
     }
 }
 
@@ -27,8 +27,22 @@
 #define TF_CKSUM_CUSTOM16 2  // Custom 16-bit checksum
 #define TF_CKSUM_CUSTOM32 3  // Custom 32-bit checksum
 
+// Implementations of TF_CKSUM_CRC16, selected with TF_CRC16_BACKEND. All give the same result.
+#define TF_CRC16_TABLE  0 // one 256-entry table, byte by byte
+#define TF_CRC16_SLICE8 1 // slice-by-8 (8 tables of 256 entries built in RAM) for payload blocks
+#define TF_CRC16_HW     2 // payload blocks in TF_CksumHwAdd() (STM32 CRC peripheral), table for the rest
+
 #include "TF_Config.h"
 
+#ifndef TF_CRC16_BACKEND
+    #define TF_CRC16_BACKEND TF_CRC16_TABLE
+#endif
+
+// Shorter payload blocks are not worth the peripheral setup, they use the table
+#ifndef TF_CRC16_HW_MIN_LEN
+    #define TF_CRC16_HW_MIN_LEN 16
+#endif
+
 //region Resolve data types
 
 #if TF_LEN_BYTES == 1
@@ -79,6 +93,15 @@
 
 //endregion
 
+// Size of the open-addressed ID listener hash, power of two larger than TF_MAX_ID_LST
+#ifndef TF_ID_HASH_SIZE
+    #define TF_ID_HASH_SIZE 64
+#endif
+
+#if (TF_ID_HASH_SIZE & (TF_ID_HASH_SIZE - 1)) || (TF_ID_HASH_SIZE <= TF_MAX_ID_LST)
+    #error Bad value of TF_ID_HASH_SIZE, must be a power of two larger than TF_MAX_ID_LST
+#endif
+
 //---------------------------------------------------------------------------
 
 /** Peer bit enum (used for init) */
@@ -394,18 +417,23 @@ enum TF_State_ {
     TFState_DATA_CKSUM    //!< Wait for Checksum
 };
 
+// Listener links below are slot index + 1, 0 = end of list / empty.
+
 struct TF_IdListener_ {
     TF_ID id;
     TF_Listener fn;
-    TF_TICKS timeout;     // nr of ticks remaining to disable this listener
+    TF_TICKS deadline;    // value of TinyFrame::ticks at which the listener expires
     TF_TICKS timeout_max; // the original timeout is stored here (0 = no timeout)
     void *userdata;
     void *userdata2;
+    TF_COUNT tprev;       // neighbours in the deadline-ordered timeout list
+    TF_COUNT tnext;
 };
 
 struct TF_TypeListener_ {
     TF_TYPE type;
     TF_Listener fn;
+    TF_COUNT next;        // next listener in the same type_index chain (ascending slots)
 };
 
 struct TF_GenericListener_ {
@@ -437,6 +465,7 @@ struct TinyFrame_ {
     TF_CKSUM ref_cksum;     //!< Reference checksum read from the message
     TF_TYPE type;           //!< Collected message type number
     bool discard_data;      //!< Set if (len > TF_MAX_PAYLOAD) to read the frame, but ignore the data.
+    uint32_t rx_frames;     //!< Frames collected & verified (incremented before listener dispatch)
 
     /* Tx state */
     // Buffer for building frames
@@ -457,11 +486,16 @@ struct TinyFrame_ {
     struct TF_TypeListener_ type_listeners[TF_MAX_TYPE_LST];
     struct TF_GenericListener_ generic_listeners[TF_MAX_GEN_LST];
 
-    // Those counters are used to optimize look-up times.
-    // They point to the highest used slot number,
+    // Dispatch indexes, so that a received frame finds its listeners
+    // without scanning the slot arrays.
+    TF_COUNT id_hash[TF_ID_HASH_SIZE]; //!< Open-addressed (linear probing) ID -> slot
+    TF_COUNT type_index[256];          //!< Low type byte -> first slot of the chain
+    TF_COUNT timeout_head;             //!< ID listener with the earliest deadline
+    TF_COUNT timeout_tail;             //!< ID listener with the latest deadline
+    TF_TICKS ticks;                    //!< TF_Tick() counter, base for deadlines
+
+    // Points to the highest used generic slot number,
     // or close to it, depending on the removal order.
-    TF_COUNT count_id_lst;
-    TF_COUNT count_type_lst;
     TF_COUNT count_generic_lst;
 };
 
@@ -515,6 +549,22 @@ extern void TF_WriteImpl(TinyFrame *tf, const uint8_t *buff, uint32_t len);
 
 #endif
 
+#if (TF_CKSUM_TYPE == TF_CKSUM_CRC16) && (TF_CRC16_BACKEND == TF_CRC16_HW)
+
+    /**
+     * Continue a CRC16 (poly 0x8005, reflected, as TF_CKSUM_CRC16) over a block, in hardware
+     *
+     * ! Implement this in your application code !
+     *
+     * @param cksum - previous checksum value, updated on success
+     * @param buf - bytes to add
+     * @param len - count, at least TF_CRC16_HW_MIN_LEN
+     * @return false if the peripheral is busy with another calculation, the table is used then
+     */
+    extern bool TF_CksumHwAdd(TF_CKSUM *cksum, const uint8_t *buf, uint32_t len);
+
+#endif
+
 /** pointer to unsigned char */
 typedef unsigned char* pu8;
 
@@ -0,0 +1,20 @@
+/**
+ ******************************************************************************
+ * @file    main.h
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Zamjena za `IC/Inc/main.h` u TinyFrame benchmarku.
+ *
+ * @note    `TinyFrame.h` uključuje `main.h` aplikacije, ali `TinyFrame.c`
+ * iz njega ne koristi ništa. Ovaj fajl drži benchmark odvojenim od HAL-a
+ * i ostatka aplikacije, pa se prevodi bilo kojim host kompajlerom.
+ ******************************************************************************
+ */
+
+#ifndef __TF_BENCH_MAIN_H__
+#define __TF_BENCH_MAIN_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#endif // __TF_BENCH_MAIN_H__
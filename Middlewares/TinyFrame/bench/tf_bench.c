@@ -0,0 +1,691 @@
+/**
+ ******************************************************************************
+ * @file    tf_bench.c
+ * @author  Gemini & [Vaše Ime]
+ * @brief   Host benchmark za TinyFrame: parsiranje, slaganje okvira i
+ * raspodjelu poruka listenerima, sa provjerom regresije.
+ *
+ * @note    Prevodi `TinyFrame.c` sa konfiguracijom projekta (`TF_Config.h`:
+ * CRC16, 1-bajtni ID, 2-bajtni LEN, `TF_MAX_ID_LST`/`TF_MAX_TYPE_LST` = 20).
+ * Mjeri se:
+ * - `parse_pN`:    `TF_AcceptChar` za okvir sa N bajtova podataka (ns/okvir),
+ * - `compose_pN`:  `TF_Send` za okvir sa N bajtova podataka (ns/okvir),
+ * - `type_lstK`:   prijem praznog okvira kada je registrovano K type
+ *                  listenera, a okvir pogađa posljednji,
+ * - `id_lstK`:     isto za K ID listenera.
+ *
+ * Svaka mjera je najbolje od `TFB_REPEAT` ponavljanja, u CPU vremenu niti.
+ * Uz apsolutno vrijeme ispisuje se i cijena normalizovana kalibracionom
+ * petljom (obrada jednog bajta jednostavnim kontrolnim zbirom) izmjerenom
+ * neposredno prije svakog ponavljanja. Normalizovana cijena malo zavisi od
+ * mašine i opterećenja, pa se regresija provjerava nad njom. Cijeli skup
+ * mjera se vrti `TFB_RUNS` puta i uzima se medijan.
+ *
+ * Prije mjerenja se provjerava da podešeni `TF_CRC16_BACKEND` daje isti
+ * CRC16 kao referentni CRC-16/ARC računat bit po bit: za okvire svih dužina
+ * podataka 0..`TFB_CRC_MAX_LEN` porede se oba checksum-a iz `TF_Send`, a
+ * isti okvir mora proći kroz parser. Razlika prekida program sa izlazom 3.
+ *
+ * Sa `TF_CRC16_HW` (`tf_bench_hw`) `TF_CksumHwAdd` je prepisan iz `rs485.c`
+ * korak po korak, nad modelom CRC periferije (RM0385: POLYSIZE, REV_IN,
+ * REV_OUT, RESET, upis u INIT puni i DR) i `HAL_CRC_Calculate` sa
+ * konfiguracijom iz `MX_CRC_Init`. Dodatno se provjerava:
+ * - da CRC-32 poslije TinyFrame bloka u periferiji ostaje ispravan
+ *   (vraćeni POL, CR i INIT);
+ * - prekid `HAL_CRC_Calculate` slanjem okvira nakon svakog bajta: okvir
+ *   mora imati ispravan CRC16 (tabela umjesto zauzete periferije), a
+ *   prekinuti CRC-32 isti rezultat kao bez prekida.
+ *
+ * Upotreba:
+ * - `tf_bench`                       samo ispis
+ * - `tf_bench --check <fajl> [tol%]` greška (izlaz 1) ako je neka mjera
+ *                                    sporija od baseline-a za više od tol%
+ *                                    (podrazumijevano `TFB_DEFAULT_TOLERANCE`)
+ *                                    i za više od `TFB_MIN_DELTA`, jer su
+ *                                    kratke mjere relativno šumovite
+ * - `tf_bench --save <fajl>`         upisuje novi baseline
+ * - `tf_bench --crc`                 samo provjera CRC16 (izlaz 3 ako ne prođe)
+ ******************************************************************************
+ */
+
+#define _GNU_SOURCE
+
+/*============================================================================*/
+/* UKLJUCENI FAJLOVI (INCLUDES)                                               */
+/*============================================================================*/
+#include "TinyFrame.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*============================================================================*/
+/* PRIVATNE DEFINICIJE I MAKROI (INTERNI)                                     */
+/*============================================================================*/
+#define TFB_RUNS                        3U          ///< Prolaza kroz cijeli skup mjera, uzima se medijan
+#define TFB_REPEAT                      60U         ///< Broj ponavljanja, uzima se najbolje
+#define TFB_TARGET_NS                   2000000ULL  ///< Približno trajanje jednog ponavljanja
+#define TFB_CALIB_NS                    1000000ULL  ///< Trajanje kalibracije prije svakog ponavljanja
+#define TFB_DEFAULT_TOLERANCE           50.0        ///< Dozvoljeno pogoršanje, %
+#define TFB_MIN_DELTA                   10.0        ///< Najmanje apsolutno pogoršanje (norm) koje je regresija
+#define TFB_STREAM_SIZE                 (64U * 1024U)
+#define TFB_CALIB_SIZE                  4096U
+#define TFB_COMPOSE_BATCH               64U
+#define TFB_MAX_METRICS                 32U
+#define TFB_CRC_MAX_LEN                 300U        ///< Provjera CRC-a za sve dužine 0..N
+#define TFB_BASE_TYPE                   100U        ///< Prvi TF tip koji koristi benchmark
+#define TFB_ARRAY_LEN(a)                (sizeof(a) / sizeof((a)[0]))
+#define TFB_FRAME_LEN(len)              (7U + (len) + ((len) ? 2U : 0U)) ///< Zaglavlje sa CRC16 + podaci sa CRC16
+#define TFB_HW_CALC_LEN                 64U         ///< Bajtova u modelu `HAL_CRC_Calculate` koji se prekida
+#define TFB_HW_FRAME_LEN                32U         ///< Podaci okvira koji prekida (>= `TF_CRC16_HW_MIN_LEN`)
+#define TFB_NO_PREEMPT                  0xFFFFFFFFU
+
+// Bitovi CRC_CR (RM0385)
+#define TFB_CR_RESET                    0x01U
+#define TFB_CR_POLYSIZE_MSK             0x18U       ///< 00: 32, 01: 16, 10: 8, 11: 7 bita
+#define TFB_CR_POLYSIZE_16              0x08U
+#define TFB_CR_REV_IN_MSK               0x60U
+#define TFB_CR_REV_IN_BYTE              0x20U
+#define TFB_CR_REV_OUT                  0x80U
+
+/*============================================================================*/
+/* PRIVATNE STRUKTURE                                                         */
+/*============================================================================*/
+typedef struct
+{
+    char   name[24];
+    double ns;          ///< Najbolje vrijeme po operaciji
+    double norm;        ///< Medijan najboljih odnosa vremena i kalibracionog bajta
+    double runs[TFB_RUNS];
+    double bytes;       ///< Bajtova po operaciji (0 = nije propusnost)
+} TfbMetric_t;
+
+/**
+ * @brief Jedan krug mjerenja; vraća broj izvršenih operacija.
+ */
+typedef uint64_t (*TfbBody_t)(void* ctx);
+
+typedef struct
+{
+    TinyFrame tf;
+    uint32_t frames;    ///< Okvira u `stream`
+} TfbParseCtx_t;
+
+typedef struct
+{
+    TinyFrame tf;
+    uint16_t len;
+} TfbComposeCtx_t;
+
+/*============================================================================*/
+/* PRIVATNE VARIJABLE                                                         */
+/*============================================================================*/
+static const uint16_t payload_sizes[] = { 0U, 8U, 32U, 128U, 1024U };
+static const uint8_t listener_counts[] = { 1U, 5U, 10U, TF_MAX_TYPE_LST };
+
+static uint8_t payload[1024];
+static uint8_t stream[TFB_STREAM_SIZE];     ///< Snimljeni okviri za parsiranje
+static uint32_t stream_len;
+static bool capture;                        ///< `TF_WriteImpl` snima u `stream`
+static volatile uint32_t sink;              ///< Sprječava da kompajler izbaci rad
+static uint32_t received;
+static double calib_ns = 1e30;              ///< Najbolja kalibracija, samo za ispis
+static TfbMetric_t metrics[TFB_MAX_METRICS];
+static uint32_t metric_count;
+static uint32_t run;                        ///< Tekući prolaz, 0..`TFB_RUNS`-1
+
+#if (TF_CRC16_BACKEND == TF_CRC16_HW)
+/**
+ * @brief Model registara CRC periferije i stanja `hcrc` handle-a.
+ */
+static struct
+{
+    uint32_t dr, init, pol, cr;
+    bool busy;                              ///< `hcrc.State`/`Lock` zauzet (`HAL_CRC_Calculate` u toku)
+    uint32_t hw_used, hw_declined;          ///< Pozivi `TF_CksumHwAdd` sa i bez periferije
+} crc_model;
+#endif
+
+/*============================================================================*/
+/* PRIVATNE FUNKCIJE                                                          */
+/*============================================================================*/
+static uint64_t Tfb_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Izlaz svih TinyFrame instanci u benchmarku.
+ */
+void TF_WriteImpl(TinyFrame *tf, const uint8_t *buff, uint32_t len)
+{
+    (void)tf;
+    if (capture && ((stream_len + len) <= sizeof(stream)))
+    {
+        memcpy(&stream[stream_len], buff, len);
+        stream_len += len;
+    }
+    sink += len + buff[0];
+}
+
+static TF_Result Tfb_Listener(TinyFrame *tf, TF_Msg *msg)
+{
+    (void)tf;
+    received++;
+    sink += msg->len;
+    return TF_STAY;
+}
+
+/**
+ * @brief Snima `count` okvira tipa `type` i ID-a `id` (bez master bita) u `stream`.
+ */
+static void Tfb_Record(uint8_t type, uint8_t id, uint16_t len, uint32_t count)
+{
+    TinyFrame master;
+    TF_Msg msg;
+
+    TF_InitStatic(&master, TF_MASTER);
+    stream_len = 0U;
+    capture = true;
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        TF_ClearMsg(&msg);
+        master.next_id = id;
+        msg.type = type;
+        msg.data = payload;
+        msg.len = len;
+        TF_Send(&master, &msg);
+    }
+    capture = false;
+}
+
+/**
+ * @brief Referentni CRC-16/ARC (poli 0x8005 reflektovan, init 0), bit po bit.
+ */
+static uint16_t Tfb_Crc16Ref(const uint8_t* buf, uint32_t len)
+{
+    uint16_t crc = 0U;
+
+    while (len--)
+    {
+        crc ^= *buf++;
+        for (uint8_t b = 0U; b < 8U; b++) crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0xA001U) : (uint16_t)(crc >> 1);
+    }
+    return crc;
+}
+
+#if (TF_CRC16_BACKEND == TF_CRC16_HW)
+static uint32_t Tfb_Rbit32(uint32_t v)
+{
+    uint32_t r = 0U;
+
+    for (uint8_t b = 0U; b < 32U; b++, v >>= 1) r = (r << 1) | (v & 1U);
+    return r;
+}
+
+static uint32_t Tfb_CrcMask(void)
+{
+    switch (crc_model.cr & TFB_CR_POLYSIZE_MSK)
+    {
+    case 0x00U: return 0xFFFFFFFFU;
+    case TFB_CR_POLYSIZE_16: return 0xFFFFU;
+    case 0x10U: return 0xFFU;
+    default: return 0x7FU;
+    }
+}
+
+static void Tfb_CrcWritePol(uint32_t v)
+{
+    crc_model.pol = v;
+}
+
+static void Tfb_CrcWriteCr(uint32_t v)
+{
+    crc_model.cr = v & ~TFB_CR_RESET;       // RESET se sam briše
+    if (v & TFB_CR_RESET) crc_model.dr = crc_model.init & Tfb_CrcMask();
+}
+
+static void Tfb_CrcWriteInit(uint32_t v)
+{
+    crc_model.init = v;
+    crc_model.dr = v & Tfb_CrcMask();       // upis u INIT odmah puni i DR
+}
+
+/**
+ * @brief 8-bitni upis u DR: bajt ulazi od najvišeg bita registra, REV_IN ga obrće.
+ */
+static void Tfb_CrcWriteDr8(uint8_t byte)
+{
+    const uint32_t mask = Tfb_CrcMask();
+    const uint8_t bits = (mask == 0xFFFFFFFFU) ? 32U : (mask == 0xFFFFU) ? 16U : 8U;
+    uint32_t crc = crc_model.dr;
+
+    if (crc_model.cr & TFB_CR_REV_IN_MSK) byte = (uint8_t)(Tfb_Rbit32(byte) >> 24);
+    crc ^= (uint32_t)byte << (bits - 8U);
+    for (uint8_t b = 0U; b < 8U; b++)
+    {
+        crc = (crc & (1UL << (bits - 1U))) ? ((crc << 1) ^ crc_model.pol) : (crc << 1);
+    }
+    crc_model.dr = crc & mask;
+}
+
+static uint32_t Tfb_CrcReadDr(void)
+{
+    return (crc_model.cr & TFB_CR_REV_OUT) ? Tfb_Rbit32(crc_model.dr) : crc_model.dr;
+}
+
+/**
+ * @brief `MX_CRC_Init`: podrazumijevani polinom i INIT, bez obrtanja bita.
+ */
+static void Tfb_CrcInit(void)
+{
+    memset(&crc_model, 0, sizeof(crc_model));
+    Tfb_CrcWritePol(0x04C11DB7U);
+    Tfb_CrcWriteCr(0U);
+    Tfb_CrcWriteInit(0xFFFFFFFFU);
+}
+
+/**
+ * @brief Isti redoslijed kao `TF_CksumHwAdd` u `rs485.c`, nad modelom.
+ * @note  Zabranjeni prekidi iz `rs485.c` ovdje nisu potrebni: okvir se
+ * šalje samo iz `Tfb_HalCrcCalculate`, između dva bajta.
+ */
+bool TF_CksumHwAdd(TF_CKSUM *cksum, const uint8_t *buf, uint32_t len)
+{
+    uint32_t cr, pol, init;
+
+    if (crc_model.busy)
+    {
+        crc_model.hw_declined++;
+        return false;
+    }
+    cr = crc_model.cr;
+    pol = crc_model.pol;
+    init = crc_model.init;
+
+    Tfb_CrcWritePol(0x8005U);
+    Tfb_CrcWriteCr(TFB_CR_POLYSIZE_16 | TFB_CR_REV_IN_BYTE);
+    Tfb_CrcWriteInit(Tfb_Rbit32(*cksum) >> 16);
+    Tfb_CrcWriteCr(crc_model.cr | TFB_CR_RESET);
+    while (len--) Tfb_CrcWriteDr8(*buf++);
+    *cksum = (TF_CKSUM)(Tfb_Rbit32(Tfb_CrcReadDr() & 0xFFFFU) >> 16);
+
+    Tfb_CrcWritePol(pol);
+    Tfb_CrcWriteCr(cr);
+    Tfb_CrcWriteInit(init);
+    crc_model.hw_used++;
+    return true;
+}
+
+/**
+ * @brief Referentni CRC-32 iz `MX_CRC_Init` (poli 0x04C11DB7, init 0xFFFFFFFF), bit po bit.
+ */
+static uint32_t Tfb_Crc32Ref(const uint8_t* buf, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    while (len--)
+    {
+        crc ^= (uint32_t)(*buf++) << 24;
+        for (uint8_t b = 0U; b < 8U; b++) crc = (crc & 0x80000000U) ? ((crc << 1) ^ 0x04C11DB7U) : (crc << 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief Šalje okvir kao TinyFrame iz prekida i provjerava CRC16 njegovih podataka.
+ */
+static uint32_t Tfb_PreemptFrame(void)
+{
+    Tfb_Record(TFB_BASE_TYPE, 1U, TFB_HW_FRAME_LEN, 1U);
+    return (((stream[7U + TFB_HW_FRAME_LEN] << 8) | stream[8U + TFB_HW_FRAME_LEN]) != Tfb_Crc16Ref(payload, TFB_HW_FRAME_LEN)) ? 1U : 0U;
+}
+
+/**
+ * @brief `HAL_CRC_Calculate` (bajtovi), po želji prekinut okvirom prije bajta `preempt_at`.
+ */
+static uint32_t Tfb_HalCrcCalculate(const uint8_t* buf, uint32_t len, uint32_t preempt_at, uint32_t* errors)
+{
+    uint32_t result;
+
+    crc_model.busy = true;
+    Tfb_CrcWriteCr(crc_model.cr | TFB_CR_RESET);
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        if (i == preempt_at) *errors += Tfb_PreemptFrame();
+        Tfb_CrcWriteDr8(buf[i]);
+    }
+    result = Tfb_CrcReadDr();
+    crc_model.busy = false;
+    return result;
+}
+
+/**
+ * @brief CRC-32 poslije TinyFrame bloka u periferiji i prekid `HAL_CRC_Calculate`.
+ * @return Broj grešaka.
+ */
+static uint32_t Tfb_VerifyCrcHw(void)
+{
+    uint32_t errors = 0U;
+    static const uint8_t check[] = "123456789";
+    const uint32_t ref = Tfb_Crc32Ref(payload, TFB_HW_CALC_LEN);
+
+    if (Tfb_Crc32Ref(check, 9U) != 0x0376E6E7U) errors++;
+
+    // Periferija je slobodna: TinyFrame je koristi, CRC-32 poslije toga mora biti isti
+    errors += Tfb_PreemptFrame();
+    if (Tfb_HalCrcCalculate(payload, TFB_HW_CALC_LEN, TFB_NO_PREEMPT, &errors) != ref) errors++;
+
+    // Prekid nakon svakog bajta: TinyFrame računa tabelom, CRC-32 se nastavlja
+    crc_model.hw_declined = 0U;
+    for (uint32_t k = 0U; k < TFB_HW_CALC_LEN; k++)
+    {
+        if (Tfb_HalCrcCalculate(payload, TFB_HW_CALC_LEN, k, &errors) != ref) errors++;
+    }
+    if (crc_model.hw_declined != TFB_HW_CALC_LEN) errors++;
+    if (crc_model.hw_used == 0U) errors++;
+    return errors;
+}
+#endif
+
+/**
+ * @brief Provjerava CRC16 okvira iz `TF_Send` i prijem istih okvira.
+ * @return Broj grešaka.
+ */
+static uint32_t Tfb_VerifyCrc(void)
+{
+    TinyFrame slave;
+    uint32_t errors = 0U;
+    static const uint8_t check[] = "123456789";
+
+    if (Tfb_Crc16Ref(check, 9U) != 0xBB3DU) errors++;
+    TF_InitStatic(&slave, TF_SLAVE);
+    TF_AddTypeListener(&slave, TFB_BASE_TYPE, Tfb_Listener);
+    for (uint16_t len = 0U; len <= TFB_CRC_MAX_LEN; len++)
+    {
+        Tfb_Record(TFB_BASE_TYPE, (uint8_t)len, len, 1U);
+        if (((stream[5] << 8) | stream[6]) != Tfb_Crc16Ref(stream, 5U)) errors++;
+        if ((len > 0U) && (((stream[7U + len] << 8) | stream[8U + len]) != Tfb_Crc16Ref(payload, len))) errors++;
+        received = 0U;
+        for (uint32_t i = 0U; i < stream_len; i++) TF_AcceptChar(&slave, stream[i]);
+        if (received != 1U) errors++;
+    }
+    return errors;
+}
+
+/**
+ * @brief Kalibracija: ns po bajtu jednostavnog kontrolnog zbira, jedan krug.
+ */
+static double Tfb_CalibOnce(void)
+{
+    static uint8_t buf[TFB_CALIB_SIZE];
+    uint64_t t0 = Tfb_Now();
+    uint64_t bytes = 0U;
+    uint32_t acc = 0U;
+
+    if (buf[1] == 0U)
+    {
+        for (uint32_t i = 0U; i < sizeof(buf); i++) buf[i] = (uint8_t)(i * 13U + 1U);
+    }
+    do
+    {
+        for (uint32_t i = 0U; i < sizeof(buf); i++) acc = ((acc << 1) | (acc >> 31)) ^ buf[i];
+        bytes += sizeof(buf);
+    } while ((Tfb_Now() - t0) < TFB_CALIB_NS);
+    sink += acc;
+    return (double)(Tfb_Now() - t0) / (double)bytes;
+}
+
+/**
+ * @brief Mjeri `body` i dodaje mjeru `name`.
+ * @note  Svako ponavljanje ima svoju kalibraciju neposredno prije mjerenja,
+ * pa normalizovana cijena ne zavisi od trenutnog takta i opterećenja hosta.
+ */
+static void Tfb_Measure(const char* name, TfbBody_t body, void* ctx, double bytes)
+{
+    TfbMetric_t* m = &metrics[metric_count++];
+    double norm = 1e30;
+
+    if (run == 0U)
+    {
+        snprintf(m->name, sizeof(m->name), "%s", name);
+        m->ns = 1e30;
+        m->bytes = bytes;
+    }
+    for (uint32_t r = 0U; r < TFB_REPEAT; r++)
+    {
+        double cal = Tfb_CalibOnce();
+        uint64_t t0 = Tfb_Now();
+        uint64_t ops = 0U;
+        double ns;
+
+        do
+        {
+            ops += body(ctx);
+        } while ((Tfb_Now() - t0) < TFB_TARGET_NS);
+
+        ns = (double)(Tfb_Now() - t0) / (double)ops;
+        if (ns < m->ns) m->ns = ns;
+        if ((ns / cal) < norm) norm = ns / cal;
+        if (cal < calib_ns) calib_ns = cal;
+    }
+    m->runs[run] = norm;
+}
+
+static int Tfb_CompareDouble(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void Tfb_Median(void)
+{
+    for (uint32_t i = 0U; i < metric_count; i++)
+    {
+        qsort(metrics[i].runs, TFB_RUNS, sizeof(double), Tfb_CompareDouble);
+        metrics[i].norm = metrics[i].runs[TFB_RUNS / 2U];
+    }
+}
+
+/**
+ * @brief Jedan prolaz parsera kroz snimljeni `stream`.
+ */
+static uint64_t Tfb_ParseBody(void* ctx)
+{
+    TfbParseCtx_t* c = (TfbParseCtx_t*)ctx;
+
+    received = 0U;
+    for (uint32_t i = 0U; i < stream_len; i++) TF_AcceptChar(&c->tf, stream[i]);
+    if (received != c->frames)
+    {
+        fprintf(stderr, "parser: primljeno %lu od %lu okvira\n", (unsigned long)received, (unsigned long)c->frames);
+        exit(2);
+    }
+    return c->frames;
+}
+
+static uint64_t Tfb_ComposeBody(void* ctx)
+{
+    TfbComposeCtx_t* c = (TfbComposeCtx_t*)ctx;
+    TF_Msg msg;
+
+    for (uint32_t i = 0U; i < TFB_COMPOSE_BATCH; i++)
+    {
+        TF_ClearMsg(&msg);
+        msg.type = TFB_BASE_TYPE;
+        msg.data = payload;
+        msg.len = c->len;
+        TF_Send(&c->tf, &msg);
+    }
+    return TFB_COMPOSE_BATCH;
+}
+
+static void Tfb_BenchParse(void)
+{
+    static TfbParseCtx_t c;
+    char name[24];
+
+    for (uint32_t s = 0U; s < TFB_ARRAY_LEN(payload_sizes); s++)
+    {
+        uint16_t len = payload_sizes[s];
+
+        c.frames = sizeof(stream) / TFB_FRAME_LEN(len);
+        Tfb_Record(TFB_BASE_TYPE, 0U, len, c.frames);
+        TF_InitStatic(&c.tf, TF_SLAVE);
+        TF_AddTypeListener(&c.tf, TFB_BASE_TYPE, Tfb_Listener);
+
+        snprintf(name, sizeof(name), "parse_p%u", (unsigned)len);
+        Tfb_Measure(name, Tfb_ParseBody, &c, TFB_FRAME_LEN(len));
+    }
+}
+
+static void Tfb_BenchCompose(void)
+{
+    static TfbComposeCtx_t c;
+    char name[24];
+
+    for (uint32_t s = 0U; s < TFB_ARRAY_LEN(payload_sizes); s++)
+    {
+        c.len = payload_sizes[s];
+        TF_InitStatic(&c.tf, TF_MASTER);
+
+        snprintf(name, sizeof(name), "compose_p%u", (unsigned)c.len);
+        Tfb_Measure(name, Tfb_ComposeBody, &c, TFB_FRAME_LEN(c.len));
+    }
+}
+
+/**
+ * @brief Prazni okviri koji pogađaju posljednji od K listenera.
+ */
+static void Tfb_BenchDispatch(bool by_id)
+{
+    static TfbParseCtx_t c;
+    char name[24];
+
+    for (uint32_t k = 0U; k < TFB_ARRAY_LEN(listener_counts); k++)
+    {
+        uint8_t count = listener_counts[k];
+        TF_Msg msg;
+
+        TF_InitStatic(&c.tf, TF_SLAVE);
+        for (uint8_t i = 0U; i < count; i++)
+        {
+            if (by_id)
+            {
+                TF_ClearMsg(&msg);
+                msg.frame_id = (TF_ID)(0x80U | i);
+                TF_AddIdListener(&c.tf, &msg, Tfb_Listener, 0);
+            }
+            else
+            {
+                TF_AddTypeListener(&c.tf, (TF_TYPE)(TFB_BASE_TYPE + i), Tfb_Listener);
+            }
+        }
+        c.frames = sizeof(stream) / TFB_FRAME_LEN(0U);
+        Tfb_Record((uint8_t)(TFB_BASE_TYPE + (by_id ? 0U : (count - 1U))), (uint8_t)(by_id ? (count - 1U) : 0U), 0U, c.frames);
+
+        snprintf(name, sizeof(name), "%s%u", by_id ? "id_lst" : "type_lst", (unsigned)count);
+        Tfb_Measure(name, Tfb_ParseBody, &c, 0.0);
+    }
+}
+
+static void Tfb_Print(void)
+{
+    printf("Kalibracija: %.3f ns/bajt\n", calib_ns);
+    printf("%-14s %12s %12s %16s\n", "MJERA", "ns/op", "norm", "propusnost");
+    for (uint32_t i = 0U; i < metric_count; i++)
+    {
+        const TfbMetric_t* m = &metrics[i];
+        if (m->bytes > 0.0)
+        {
+            printf("%-14s %12.1f %12.2f %10.2f MB/s %9.0f okv/s\n", m->name, m->ns, m->norm,
+                   m->bytes * 1e3 / m->ns, 1e9 / m->ns);
+        }
+        else
+        {
+            printf("%-14s %12.1f %12.2f %10.0f okv/s\n", m->name, m->ns, m->norm, 1e9 / m->ns);
+        }
+    }
+}
+
+static int Tfb_Save(const char* path)
+{
+    FILE* f = fopen(path, "w");
+
+    if (f == NULL) return 2;
+    fprintf(f, "# tf_bench baseline: normalizovana cijena (ns/op / ns kalibracionog bajta)\n");
+    for (uint32_t i = 0U; i < metric_count; i++) fprintf(f, "%s %.2f\n", metrics[i].name, metrics[i].norm);
+    fclose(f);
+    return 0;
+}
+
+static int Tfb_Check(const char* path, double tolerance)
+{
+    char line[128];
+    char name[24];
+    double base;
+    int failed = 0;
+    FILE* f = fopen(path, "r");
+
+    if (f == NULL)
+    {
+        fprintf(stderr, "Baseline %s se ne može otvoriti\n", path);
+        return 2;
+    }
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        if ((line[0] == '#') || (sscanf(line, "%23s %lf", name, &base) != 2)) continue;
+        for (uint32_t i = 0U; i < metric_count; i++)
+        {
+            if (strcmp(metrics[i].name, name) != 0) continue;
+            double change = (metrics[i].norm / base - 1.0) * 100.0;
+            bool bad = (change > tolerance) && ((metrics[i].norm - base) > TFB_MIN_DELTA);
+            printf("%-14s baseline %8.2f sada %8.2f  %+6.1f %%%s\n", name, base, metrics[i].norm, change,
+                   bad ? "  REGRESIJA" : "");
+            failed |= bad;
+        }
+    }
+    fclose(f);
+    return failed;
+}
+
+/*============================================================================*/
+/* GLAVNI PROGRAM                                                             */
+/*============================================================================*/
+int main(int argc, char** argv)
+{
+    for (uint32_t i = 0U; i < sizeof(payload); i++) payload[i] = (uint8_t)(i * 7U + 3U);
+#if (TF_CRC16_BACKEND == TF_CRC16_HW)
+    Tfb_CrcInit();
+#endif
+    uint32_t crc_errors = Tfb_VerifyCrc();
+#if (TF_CRC16_BACKEND == TF_CRC16_HW)
+    uint32_t hw_errors = Tfb_VerifyCrcHw();
+    printf("CRC periferija (model): %lu blokova u periferiji, %lu tabelom dok je zauzeta: %s\n",
+           (unsigned long)crc_model.hw_used, (unsigned long)crc_model.hw_declined, hw_errors ? "GREŠKA" : "ispravan");
+    crc_errors += hw_errors;
+#endif
+    printf("CRC16 backend %d: %s\n", TF_CRC16_BACKEND, crc_errors ? "GREŠKA" : "ispravan");
+    if (crc_errors != 0U) return 3;
+    if ((argc > 1) && (strcmp(argv[1], "--crc") == 0)) return 0;
+
+    for (run = 0U; run < TFB_RUNS; run++)
+    {
+        metric_count = 0U;
+        Tfb_BenchParse();
+        Tfb_BenchCompose();
+        Tfb_BenchDispatch(false);
+        Tfb_BenchDispatch(true);
+    }
+    Tfb_Median();
+    Tfb_Print();
+
+    if ((argc > 2) && (strcmp(argv[1], "--save") == 0)) return Tfb_Save(argv[2]);
+    if ((argc > 2) && (strcmp(argv[1], "--check") == 0))
+    {
+        return Tfb_Check(argv[2], (argc > 3) ? strtod(argv[3], NULL) : TFB_DEFAULT_TOLERANCE);
+    }
+    return 0;
+}